@@ -20,12 +20,16 @@
 #endif // defined(ESP_PLATFORM)
 
 #include "asio/associated_allocator.hpp"
+#include "asio/associated_cancellation_slot.hpp"
 #include "asio/associated_executor.hpp"
 #include "asio/async_result.hpp"
 #include "asio/awaitable.hpp"
+#include "asio/basic_channel.hpp"
 #include "asio/basic_datagram_socket.hpp"
 #include "asio/basic_deadline_timer.hpp"
+#include "asio/basic_file.hpp"
 #include "asio/basic_io_object.hpp"
+#include "asio/basic_random_access_file.hpp"
 #include "asio/basic_raw_socket.hpp"
 #include "asio/basic_seq_packet_socket.hpp"
 #include "asio/basic_serial_port.hpp"
@@ -34,9 +38,11 @@
 #include "asio/basic_socket_acceptor.hpp"
 #include "asio/basic_socket_iostream.hpp"
 #include "asio/basic_socket_streambuf.hpp"
+#include "asio/basic_stream_file.hpp"
 #include "asio/basic_stream_socket.hpp"
 #include "asio/basic_streambuf.hpp"
 #include "asio/basic_waitable_timer.hpp"
+#include "asio/bind_cancellation_slot.hpp"
 #include "asio/bind_executor.hpp"
 #include "asio/buffer.hpp"
 #include "asio/buffered_read_stream_fwd.hpp"
@@ -46,7 +52,9 @@
 #include "asio/buffered_write_stream_fwd.hpp"
 #include "asio/buffered_write_stream.hpp"
 #include "asio/buffers_iterator.hpp"
+#include "asio/cancellation_signal.hpp"
 #include "asio/co_spawn.hpp"
+#include "asio/coarse_steady_timer.hpp"
 #include "asio/completion_condition.hpp"
 #include "asio/compose.hpp"
 #include "asio/connect.hpp"
@@ -60,6 +68,7 @@
 #include "asio/execution_context.hpp"
 #include "asio/executor.hpp"
 #include "asio/executor_work_guard.hpp"
+#include "asio/file_base.hpp"
 #include "asio/generic/basic_endpoint.hpp"
 #include "asio/generic/datagram_protocol.hpp"
 #include "asio/generic/raw_protocol.hpp"
@@ -84,6 +93,7 @@
 #include "asio/ip/network_v6.hpp"
 #include "asio/ip/bad_address_cast.hpp"
 #include "asio/ip/basic_endpoint.hpp"
+#include "asio/ip/basic_network_map.hpp"
 #include "asio/ip/basic_resolver.hpp"
 #include "asio/ip/basic_resolver_entry.hpp"
 #include "asio/ip/basic_resolver_iterator.hpp"
@@ -103,6 +113,9 @@
 #include "asio/local/basic_endpoint.hpp"
 #include "asio/local/connect_pair.hpp"
 #include "asio/local/datagram_protocol.hpp"
+#include "asio/local/fd_passing.hpp"
+#include "asio/local/shared_memory_channel.hpp"
+#include "asio/local/socket_dispatcher.hpp"
 #include "asio/local/stream_protocol.hpp"
 #include "asio/packaged_task.hpp"
 #include "asio/placeholders.hpp"
@@ -112,6 +125,7 @@
 #include "asio/posix/descriptor_base.hpp"
 #include "asio/posix/stream_descriptor.hpp"
 #include "asio/post.hpp"
+#include "asio/random_access_file.hpp"
 #include "asio/read.hpp"
 #include "asio/read_at.hpp"
 #include "asio/read_until.hpp"
@@ -122,6 +136,7 @@
 #include "asio/socket_base.hpp"
 #include "asio/steady_timer.hpp"
 #include "asio/strand.hpp"
+#include "asio/stream_file.hpp"
 #include "asio/streambuf.hpp"
 #include "asio/system_context.hpp"
 #include "asio/system_error.hpp"
@@ -131,6 +146,7 @@
 #include "asio/thread.hpp"
 #include "asio/thread_pool.hpp"
 #include "asio/time_traits.hpp"
+#include "asio/transfer.hpp"
 #include "asio/use_awaitable.hpp"
 #include "asio/use_future.hpp"
 #include "asio/uses_executor.hpp"
@@ -145,6 +161,7 @@
 #include "asio/windows/overlapped_ptr.hpp"
 #include "asio/windows/random_access_handle.hpp"
 #include "asio/windows/stream_handle.hpp"
+#include "asio/with_timeout.hpp"
 #include "asio/write.hpp"
 #include "asio/write_at.hpp"
 
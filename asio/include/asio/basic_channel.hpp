@@ -0,0 +1,537 @@
+//
+// basic_channel.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_BASIC_CHANNEL_HPP
+#define ASIO_BASIC_CHANNEL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include "asio/async_result.hpp"
+#include "asio/error.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/executor.hpp"
+#include "asio/detail/channel_buffer.hpp"
+#include "asio/detail/channel_op.hpp"
+#include "asio/detail/handler_tracking.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/op_queue.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Provides an asynchronous channel for passing messages between handlers.
+/**
+ * The basic_channel class template passes messages of type @c T from senders
+ * to receivers within a process. A channel may be used in place of posting
+ * function objects to a queue that is guarded by a strand or mutex, and
+ * supports any number of concurrent senders and receivers. Each message is
+ * delivered to exactly one receiver, in the order in which it was sent.
+ *
+ * A channel buffers up to a fixed number of messages. A send operation
+ * completes as soon as its message has been buffered or handed to a waiting
+ * receiver, and otherwise waits until a receiver makes room. A channel with a
+ * buffer size of zero hands each message directly from a sender to a
+ * receiver. A channel constructed with basic_channel::unbounded never makes a
+ * sender wait.
+ *
+ * A waiting operation holds its message within the operation object, and the
+ * buffer's storage is reused once it has grown, so that a channel in a steady
+ * state makes no memory allocation per message beyond that of the handlers.
+ *
+ * The completion handlers for a channel's operations are always posted to
+ * their associated executors, and are never invoked from within the
+ * operation that completes them. Like any other outstanding asynchronous
+ * operation, a waiting send or receive operation counts as work for the
+ * channel's I/O executor.
+ *
+ * The message type @c T must be default constructible and move constructible.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ *
+ * @par Example
+ * @code asio::basic_channel<std::string> channel(io_context, 64);
+ * ...
+ * channel.async_send("hello",
+ *     [](asio::error_code ec)
+ *     {
+ *       ...
+ *     });
+ * ...
+ * channel.async_receive(
+ *     [](asio::error_code ec, std::string message)
+ *     {
+ *       ...
+ *     }); @endcode
+ */
+template <typename T, typename Executor = executor>
+class basic_channel
+  : private asio::detail::noncopyable
+{
+public:
+  /// The type of the executor associated with the object.
+  typedef Executor executor_type;
+
+  /// The type of the messages carried by the channel.
+  typedef T value_type;
+
+  /// A buffer size that allows any number of messages to be buffered.
+  static const std::size_t unbounded = static_cast<std::size_t>(-1);
+
+  /// Construct a channel.
+  /**
+   * @param ex The I/O executor that the channel will use, by default, to
+   * dispatch handlers for any asynchronous operations performed on the
+   * channel.
+   *
+   * @param max_buffer_size The maximum number of messages that may be
+   * buffered in the channel.
+   */
+  explicit basic_channel(const executor_type& ex,
+      std::size_t max_buffer_size = 0)
+    : executor_(ex),
+      buffer_(max_buffer_size),
+      open_(true)
+  {
+  }
+
+  /// Construct a channel.
+  /**
+   * @param context An execution context which provides the I/O executor that
+   * the channel will use, by default, to dispatch handlers for any
+   * asynchronous operations performed on the channel.
+   *
+   * @param max_buffer_size The maximum number of messages that may be
+   * buffered in the channel.
+   */
+  template <typename ExecutionContext>
+  explicit basic_channel(ExecutionContext& context,
+      std::size_t max_buffer_size = 0,
+      typename enable_if<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      >::type* = 0)
+    : executor_(context.get_executor()),
+      buffer_(max_buffer_size),
+      open_(true)
+  {
+  }
+
+  /// Destructor.
+  /**
+   * Cancels any outstanding asynchronous operations, as if by calling
+   * @c cancel().
+   */
+  ~basic_channel()
+  {
+    cancel();
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() ASIO_NOEXCEPT
+  {
+    return executor_;
+  }
+
+  /// Get the maximum number of messages that may be buffered.
+  std::size_t max_buffer_size() const
+  {
+    return buffer_.max_size();
+  }
+
+  /// Determine whether the channel is open.
+  bool is_open() const
+  {
+    mutex_type::scoped_lock lock(mutex_);
+    return open_;
+  }
+
+  /// Determine whether a message can be received without waiting.
+  bool ready() const
+  {
+    mutex_type::scoped_lock lock(mutex_);
+    return !buffer_.empty() || !senders_.empty();
+  }
+
+  /// Close the channel.
+  /**
+   * After the channel is closed, send operations fail with the
+   * asio::error::broken_pipe error. Receive operations continue to
+   * deliver the messages that were buffered before the channel was closed,
+   * and then fail with the asio::error::eof error.
+   *
+   * Any waiting send operations complete with asio::error::broken_pipe,
+   * and any waiting receive operations complete with asio::error::eof.
+   */
+  void close()
+  {
+    asio::detail::op_queue<op> completed;
+    {
+      mutex_type::scoped_lock lock(mutex_);
+      open_ = false;
+      abort(senders_, asio::error::broken_pipe, completed);
+      abort(receivers_, asio::error::eof, completed);
+    }
+    complete(completed);
+  }
+
+  /// Cancel all asynchronous operations waiting on the channel.
+  /**
+   * This function causes all waiting send and receive operations to finish
+   * immediately, and the handlers for cancelled operations will be passed the
+   * asio::error::operation_aborted error. The messages of cancelled send
+   * operations are discarded.
+   */
+  void cancel()
+  {
+    asio::detail::op_queue<op> completed;
+    {
+      mutex_type::scoped_lock lock(mutex_);
+      abort(senders_, asio::error::operation_aborted, completed);
+      abort(receivers_, asio::error::operation_aborted, completed);
+    }
+    complete(completed);
+  }
+
+  /// Attempt to send a message without waiting.
+  /**
+   * @param value The message to be sent. The message is moved from only if
+   * the function succeeds.
+   *
+   * @returns @c true if the message was handed to a waiting receiver or
+   * buffered, otherwise @c false.
+   */
+  bool try_send(T& value)
+  {
+    op* receiver = 0;
+    {
+      mutex_type::scoped_lock lock(mutex_);
+      if (!open_)
+        return false;
+      if (!receivers_.empty())
+      {
+        receiver = receivers_.front();
+        receivers_.pop();
+        receiver->value_ = ASIO_MOVE_CAST(T)(value);
+      }
+      else if (!buffer_.full())
+        buffer_.push(value);
+      else
+        return false;
+    }
+    if (receiver)
+      receiver->complete();
+    return true;
+  }
+
+  /// Attempt to send a message without waiting.
+  /**
+   * @param value The message to be sent.
+   *
+   * @returns @c true if the message was handed to a waiting receiver or
+   * buffered, otherwise @c false.
+   */
+  bool try_send(T&& value)
+  {
+    return try_send(static_cast<T&>(value));
+  }
+
+  /// Attempt to receive a message without waiting.
+  /**
+   * @param value Set to the received message if the function succeeds.
+   *
+   * @returns @c true if a message was received, otherwise @c false.
+   */
+  bool try_receive(T& value)
+  {
+    op* sender = 0;
+    {
+      mutex_type::scoped_lock lock(mutex_);
+      if (!take(value, sender))
+        return false;
+    }
+    if (sender)
+      sender->complete();
+    return true;
+  }
+
+  /// Start an asynchronous operation to send a message.
+  /**
+   * This function is used to asynchronously send a message on the channel.
+   * The function call always returns immediately.
+   *
+   * @param value The message to be sent. The message is moved into the
+   * operation.
+   *
+   * @param handler The handler to be called when the send operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error // Result of operation.
+   * ); @endcode
+   * The operation completes when the message has been handed to a receiver
+   * or buffered. Regardless of whether the asynchronous operation completes
+   * immediately or not, the handler will not be invoked from within this
+   * function. On immediate completion, invocation of the handler will be
+   * performed in a manner equivalent to using asio::post().
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
+        SendHandler ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(SendHandler,
+      void (asio::error_code))
+  async_send(T value,
+      ASIO_MOVE_ARG(SendHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<SendHandler, void (asio::error_code)>(
+        initiate_async_send(this), handler, ASIO_MOVE_CAST(T)(value));
+  }
+
+  /// Start an asynchronous operation to receive a message.
+  /**
+   * This function is used to asynchronously receive a message from the
+   * channel. The function call always returns immediately.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   T value                                 // The received message.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code, T))
+        ReceiveHandler ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReceiveHandler,
+      void (asio::error_code, T))
+  async_receive(
+      ASIO_MOVE_ARG(ReceiveHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReceiveHandler, void (asio::error_code, T)>(
+        initiate_async_receive(this), handler);
+  }
+
+private:
+  typedef asio::detail::mutex mutex_type;
+  typedef asio::detail::channel_op<T> op;
+
+  // Take the next message from the buffer or from a waiting sender. If a
+  // waiting sender's message is moved into the buffer, the sender is returned
+  // so that it may be completed.
+  bool take(T& value, op*& sender)
+  {
+    if (!buffer_.empty())
+    {
+      value = ASIO_MOVE_CAST(T)(buffer_.front());
+      buffer_.pop();
+      if (!senders_.empty())
+      {
+        sender = senders_.front();
+        senders_.pop();
+        buffer_.push(sender->value_);
+      }
+      return true;
+    }
+
+    if (!senders_.empty())
+    {
+      sender = senders_.front();
+      senders_.pop();
+      value = ASIO_MOVE_CAST(T)(sender->value_);
+      return true;
+    }
+
+    return false;
+  }
+
+  // Match a new send operation against the channel's state.
+  void start_send_op(op* o)
+  {
+    asio::detail::op_queue<op> completed;
+    {
+      mutex_type::scoped_lock lock(mutex_);
+      if (!open_)
+        o->ec_ = asio::error::broken_pipe;
+      else if (!receivers_.empty())
+      {
+        op* receiver = receivers_.front();
+        receivers_.pop();
+        receiver->value_ = ASIO_MOVE_CAST(T)(o->value_);
+        completed.push(receiver);
+      }
+      else if (!buffer_.full())
+        buffer_.push(o->value_);
+      else
+      {
+        senders_.push(o);
+        return;
+      }
+      completed.push(o);
+    }
+    complete(completed);
+  }
+
+  // Match a new receive operation against the channel's state.
+  void start_receive_op(op* o)
+  {
+    asio::detail::op_queue<op> completed;
+    {
+      mutex_type::scoped_lock lock(mutex_);
+      op* sender = 0;
+      if (take(o->value_, sender))
+      {
+        if (sender)
+          completed.push(sender);
+      }
+      else if (!open_)
+        o->ec_ = asio::error::eof;
+      else
+      {
+        receivers_.push(o);
+        return;
+      }
+      completed.push(o);
+    }
+    complete(completed);
+  }
+
+  // Move all operations in a queue to the completed queue with an error.
+  static void abort(asio::detail::op_queue<op>& ops,
+      const asio::error_code& ec, asio::detail::op_queue<op>& completed)
+  {
+    while (op* o = ops.front())
+    {
+      ops.pop();
+      o->ec_ = ec;
+      completed.push(o);
+    }
+  }
+
+  // Post the handlers for completed operations. This is done outside the lock.
+  static void complete(asio::detail::op_queue<op>& completed)
+  {
+    while (op* o = completed.front())
+    {
+      completed.pop();
+      o->complete();
+    }
+  }
+
+  class initiate_async_send
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send(basic_channel* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename SendHandler>
+    void operator()(ASIO_MOVE_ARG(SendHandler) handler, T value) const
+    {
+      asio::detail::non_const_lvalue<SendHandler> handler2(handler);
+      typedef typename asio::detail::channel_send_op<T,
+        typename decay<SendHandler>::type, Executor>::type send_op;
+      typename send_op::ptr p = {
+        asio::detail::addressof(handler2.value),
+        send_op::ptr::allocate(handler2.value), 0 };
+      p.p = new (p.v) send_op(value, handler2.value, self_->executor_);
+
+      ASIO_HANDLER_CREATION((self_->executor_.context(),
+            *p.p, "channel", self_, 0, "async_send"));
+
+      self_->start_send_op(p.p);
+      p.v = p.p = 0;
+    }
+
+  private:
+    basic_channel* self_;
+  };
+
+  class initiate_async_receive
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive(basic_channel* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReceiveHandler>
+    void operator()(ASIO_MOVE_ARG(ReceiveHandler) handler) const
+    {
+      asio::detail::non_const_lvalue<ReceiveHandler> handler2(handler);
+      typedef typename asio::detail::channel_receive_op<T,
+        typename decay<ReceiveHandler>::type, Executor>::type receive_op;
+      typename receive_op::ptr p = {
+        asio::detail::addressof(handler2.value),
+        receive_op::ptr::allocate(handler2.value), 0 };
+      p.p = new (p.v) receive_op(handler2.value, self_->executor_);
+
+      ASIO_HANDLER_CREATION((self_->executor_.context(),
+            *p.p, "channel", self_, 0, "async_receive"));
+
+      self_->start_receive_op(p.p);
+      p.v = p.p = 0;
+    }
+
+  private:
+    basic_channel* self_;
+  };
+
+  Executor executor_;
+  mutable mutex_type mutex_;
+  asio::detail::channel_buffer<T> buffer_;
+  asio::detail::op_queue<op> senders_;
+  asio::detail::op_queue<op> receivers_;
+  bool open_;
+};
+
+template <typename T, typename Executor>
+const std::size_t basic_channel<T, Executor>::unbounded;
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_BASIC_CHANNEL_HPP
@@ -27,6 +27,7 @@
 #include "asio/detail/io_object_impl.hpp"
 #include "asio/detail/non_const_lvalue.hpp"
 #include "asio/detail/throw_error.hpp"
+#include "asio/detail/timeout_msec.hpp"
 #include "asio/detail/type_traits.hpp"
 #include "asio/error.hpp"
 #include "asio/execution_context.hpp"
@@ -653,6 +654,68 @@ public:
         impl_.get_implementation(), buffers, ec);
   }
 
+#if defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+  /// Write some data to the serial port, waiting for at most the given
+  /// duration.
+  /**
+   * This function is used to write data to the serial port. The function call
+   * will block until one or more bytes of the data has been written
+   * successfully, until the timeout expires, or until an error occurs. The
+   * port is waited on directly, without using the I/O executor.
+   *
+   * @param buffers One or more data buffers to be written to the serial port.
+   *
+   * @param timeout The longest time for which the call may block.
+   *
+   * @returns The number of bytes written.
+   *
+   * @throws asio::system_error Thrown on failure. An error code of
+   * asio::error::timed_out indicates that no data could be written before
+   * the timeout expired.
+   *
+   * @note On Windows, the port's timeouts are changed for the duration of the
+   * call, so it must not be used while an asynchronous operation is pending.
+   */
+  template <typename ConstBufferSequence, typename Rep, typename Period>
+  std::size_t write_some_for(const ConstBufferSequence& buffers,
+      const chrono::duration<Rep, Period>& timeout)
+  {
+    asio::error_code ec;
+    std::size_t s = impl_.get_service().write_some_for(
+        impl_.get_implementation(), buffers,
+        asio::detail::timeout_msec(timeout), ec);
+    asio::detail::throw_error(ec, "write_some_for");
+    return s;
+  }
+
+  /// Write some data to the serial port, waiting for at most the given
+  /// duration.
+  /**
+   * This function is used to write data to the serial port. The function call
+   * will block until one or more bytes of the data has been written
+   * successfully, until the timeout expires, or until an error occurs. The
+   * port is waited on directly, without using the I/O executor.
+   *
+   * @param buffers One or more data buffers to be written to the serial port.
+   *
+   * @param timeout The longest time for which the call may block.
+   *
+   * @param ec Set to indicate what error occurred, if any. An error code of
+   * asio::error::timed_out indicates that no data could be written before
+   * the timeout expired.
+   *
+   * @returns The number of bytes written. Returns 0 if an error occurred.
+   */
+  template <typename ConstBufferSequence, typename Rep, typename Period>
+  std::size_t write_some_for(const ConstBufferSequence& buffers,
+      const chrono::duration<Rep, Period>& timeout, asio::error_code& ec)
+  {
+    return impl_.get_service().write_some_for(
+        impl_.get_implementation(), buffers,
+        asio::detail::timeout_msec(timeout), ec);
+  }
+#endif // defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
   /// Start an asynchronous write.
   /**
    * This function is used to asynchronously write data to the serial port.
@@ -767,6 +830,68 @@ public:
         impl_.get_implementation(), buffers, ec);
   }
 
+#if defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+  /// Read some data from the serial port, waiting for at most the given
+  /// duration.
+  /**
+   * This function is used to read data from the serial port. The function
+   * call will block until one or more bytes of data has been read successfully,
+   * until the timeout expires, or until an error occurs. The port is waited on
+   * directly, without using the I/O executor.
+   *
+   * @param buffers One or more buffers into which the data will be read.
+   *
+   * @param timeout The longest time for which the call may block.
+   *
+   * @returns The number of bytes read.
+   *
+   * @throws asio::system_error Thrown on failure. An error code of
+   * asio::error::timed_out indicates that no data arrived before the
+   * timeout expired.
+   *
+   * @note On Windows, the port's timeouts are changed for the duration of the
+   * call, so it must not be used while an asynchronous operation is pending.
+   */
+  template <typename MutableBufferSequence, typename Rep, typename Period>
+  std::size_t read_some_for(const MutableBufferSequence& buffers,
+      const chrono::duration<Rep, Period>& timeout)
+  {
+    asio::error_code ec;
+    std::size_t s = impl_.get_service().read_some_for(
+        impl_.get_implementation(), buffers,
+        asio::detail::timeout_msec(timeout), ec);
+    asio::detail::throw_error(ec, "read_some_for");
+    return s;
+  }
+
+  /// Read some data from the serial port, waiting for at most the given
+  /// duration.
+  /**
+   * This function is used to read data from the serial port. The function
+   * call will block until one or more bytes of data has been read successfully,
+   * until the timeout expires, or until an error occurs. The port is waited on
+   * directly, without using the I/O executor.
+   *
+   * @param buffers One or more buffers into which the data will be read.
+   *
+   * @param timeout The longest time for which the call may block.
+   *
+   * @param ec Set to indicate what error occurred, if any. An error code of
+   * asio::error::timed_out indicates that no data arrived before the
+   * timeout expired.
+   *
+   * @returns The number of bytes read. Returns 0 if an error occurred.
+   */
+  template <typename MutableBufferSequence, typename Rep, typename Period>
+  std::size_t read_some_for(const MutableBufferSequence& buffers,
+      const chrono::duration<Rep, Period>& timeout, asio::error_code& ec)
+  {
+    return impl_.get_service().read_some_for(
+        impl_.get_implementation(), buffers,
+        asio::detail::timeout_msec(timeout), ec);
+  }
+#endif // defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
   /// Start an asynchronous read.
   /**
    * This function is used to asynchronously read data from the serial port.
@@ -22,6 +22,7 @@
 #include "asio/detail/handler_type_requirements.hpp"
 #include "asio/detail/non_const_lvalue.hpp"
 #include "asio/detail/throw_error.hpp"
+#include "asio/detail/timeout_msec.hpp"
 #include "asio/error.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -806,6 +807,69 @@ public:
         this->impl_.get_implementation(), buffers, 0, ec);
   }
 
+#if defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+  /// Write some data to the socket, waiting for at most the given duration.
+  /**
+   * This function is used to write data to the stream socket. The function call
+   * will block until one or more bytes of the data has been written
+   * successfully, until the timeout expires, or until an error occurs. The
+   * socket is polled directly, without using the I/O executor, and the
+   * timeout applies whether or not the socket is in non-blocking mode.
+   *
+   * @param buffers One or more data buffers to be written to the socket.
+   *
+   * @param timeout The longest time for which the call may block.
+   *
+   * @returns The number of bytes written.
+   *
+   * @throws asio::system_error Thrown on failure. An error code of
+   * asio::error::timed_out indicates that no data could be written before
+   * the timeout expired.
+   *
+   * @note The write_some_for operation may not transmit all of the data to the
+   * peer. Consider using the @ref write_for function if you need to ensure
+   * that all data is written before the blocking operation completes.
+   */
+  template <typename ConstBufferSequence, typename Rep, typename Period>
+  std::size_t write_some_for(const ConstBufferSequence& buffers,
+      const chrono::duration<Rep, Period>& timeout)
+  {
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().send_for(
+        this->impl_.get_implementation(), buffers, 0,
+        asio::detail::timeout_msec(timeout), ec);
+    asio::detail::throw_error(ec, "write_some_for");
+    return s;
+  }
+
+  /// Write some data to the socket, waiting for at most the given duration.
+  /**
+   * This function is used to write data to the stream socket. The function call
+   * will block until one or more bytes of the data has been written
+   * successfully, until the timeout expires, or until an error occurs. The
+   * socket is polled directly, without using the I/O executor, and the
+   * timeout applies whether or not the socket is in non-blocking mode.
+   *
+   * @param buffers One or more data buffers to be written to the socket.
+   *
+   * @param timeout The longest time for which the call may block.
+   *
+   * @param ec Set to indicate what error occurred, if any. An error code of
+   * asio::error::timed_out indicates that no data could be written before
+   * the timeout expired.
+   *
+   * @returns The number of bytes written. Returns 0 if an error occurred.
+   */
+  template <typename ConstBufferSequence, typename Rep, typename Period>
+  std::size_t write_some_for(const ConstBufferSequence& buffers,
+      const chrono::duration<Rep, Period>& timeout, asio::error_code& ec)
+  {
+    return this->impl_.get_service().send_for(
+        this->impl_.get_implementation(), buffers, 0,
+        asio::detail::timeout_msec(timeout), ec);
+  }
+#endif // defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
   /// Start an asynchronous write.
   /**
    * This function is used to asynchronously write data to the stream socket.
@@ -920,6 +984,77 @@ public:
         this->impl_.get_implementation(), buffers, 0, ec);
   }
 
+#if defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+  /// Read some data from the socket, waiting for at most the given duration.
+  /**
+   * This function is used to read data from the stream socket. The function
+   * call will block until one or more bytes of data has been read successfully,
+   * until the timeout expires, or until an error occurs. The socket is polled
+   * directly, without using the I/O executor, and the timeout applies whether
+   * or not the socket is in non-blocking mode.
+   *
+   * @param buffers One or more buffers into which the data will be read.
+   *
+   * @param timeout The longest time for which the call may block.
+   *
+   * @returns The number of bytes read.
+   *
+   * @throws asio::system_error Thrown on failure. An error code of
+   * asio::error::timed_out indicates that no data arrived before the
+   * timeout expired, and asio::error::eof indicates that the connection
+   * was closed by the peer.
+   *
+   * @note The read_some_for operation may not read all of the requested number
+   * of bytes. Consider using the @ref read_for function if you need to ensure
+   * that the requested amount of data is read before the blocking operation
+   * completes.
+   *
+   * @par Example
+   * @code
+   * std::size_t n = socket.read_some_for(
+   *     asio::buffer(data, size), std::chrono::seconds(5));
+   * @endcode
+   */
+  template <typename MutableBufferSequence, typename Rep, typename Period>
+  std::size_t read_some_for(const MutableBufferSequence& buffers,
+      const chrono::duration<Rep, Period>& timeout)
+  {
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().receive_for(
+        this->impl_.get_implementation(), buffers, 0,
+        asio::detail::timeout_msec(timeout), ec);
+    asio::detail::throw_error(ec, "read_some_for");
+    return s;
+  }
+
+  /// Read some data from the socket, waiting for at most the given duration.
+  /**
+   * This function is used to read data from the stream socket. The function
+   * call will block until one or more bytes of data has been read successfully,
+   * until the timeout expires, or until an error occurs. The socket is polled
+   * directly, without using the I/O executor, and the timeout applies whether
+   * or not the socket is in non-blocking mode.
+   *
+   * @param buffers One or more buffers into which the data will be read.
+   *
+   * @param timeout The longest time for which the call may block.
+   *
+   * @param ec Set to indicate what error occurred, if any. An error code of
+   * asio::error::timed_out indicates that no data arrived before the
+   * timeout expired.
+   *
+   * @returns The number of bytes read. Returns 0 if an error occurred.
+   */
+  template <typename MutableBufferSequence, typename Rep, typename Period>
+  std::size_t read_some_for(const MutableBufferSequence& buffers,
+      const chrono::duration<Rep, Period>& timeout, asio::error_code& ec)
+  {
+    return this->impl_.get_service().receive_for(
+        this->impl_.get_implementation(), buffers, 0,
+        asio::detail::timeout_msec(timeout), ec);
+  }
+#endif // defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
   /// Start an asynchronous read.
   /**
    * This function is used to asynchronously read data from the stream socket.
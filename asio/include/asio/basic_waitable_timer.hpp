@@ -575,6 +575,104 @@ public:
     return s;
   }
 
+  /// Set the timer's expiry time as an absolute time, keeping pending waits.
+  /**
+   * This function sets the expiry time. Unlike expires_at(), any pending
+   * asynchronous wait operations are not cancelled. Instead, they are moved to
+   * the new expiry time and will complete when it is reached.
+   *
+   * This is cheaper than calling expires_at() followed by async_wait(), as it
+   * avoids both the cancellation of the existing wait and the allocation of a
+   * new one. It is intended for inactivity timeouts that are pushed back each
+   * time activity occurs.
+   *
+   * @param expiry_time The expiry time to be used for the timer.
+   *
+   * @return The number of asynchronous operations that were rescheduled. If
+   * this is zero then the timer had no pending waits, and a new wait must be
+   * started using async_wait() if required.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @par Example
+   * @code
+   * void on_read(const asio::error_code& error)
+   * {
+   *   if (!error)
+   *   {
+   *     // Push back the idle timeout, restarting the wait only if the
+   *     // previous one has already completed.
+   *     if (idle_timer.reschedule_after(std::chrono::seconds(30)) == 0)
+   *       idle_timer.async_wait(on_idle);
+   *
+   *     ...
+   *   }
+   * }
+   * @endcode
+   */
+  std::size_t reschedule_at(const time_point& expiry_time)
+  {
+    asio::error_code ec;
+    std::size_t s = impl_.get_service().reschedule_at(
+        impl_.get_implementation(), expiry_time, ec);
+    asio::detail::throw_error(ec, "reschedule_at");
+    return s;
+  }
+
+  /// Set the timer's expiry time relative to now, keeping pending waits.
+  /**
+   * This function sets the expiry time. Unlike expires_after(), any pending
+   * asynchronous wait operations are not cancelled. Instead, they are moved to
+   * the new expiry time and will complete when it is reached.
+   *
+   * @param expiry_time The expiry time to be used for the timer.
+   *
+   * @return The number of asynchronous operations that were rescheduled. If
+   * this is zero then the timer had no pending waits, and a new wait must be
+   * started using async_wait() if required.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  std::size_t reschedule_after(const duration& expiry_time)
+  {
+    asio::error_code ec;
+    std::size_t s = impl_.get_service().reschedule_after(
+        impl_.get_implementation(), expiry_time, ec);
+    asio::detail::throw_error(ec, "reschedule_after");
+    return s;
+  }
+
+  /// Get the timer's slack.
+  /**
+   * This function may be used to obtain the amount by which an asynchronous
+   * wait on the timer may be delayed so that it can be coalesced with other
+   * timers.
+   */
+  duration slack() const
+  {
+    return impl_.get_service().slack(impl_.get_implementation());
+  }
+
+  /// Set the timer's slack.
+  /**
+   * This function sets the amount by which an asynchronous wait on the timer
+   * may be delayed. Asynchronous waits started after this call have their
+   * expiry time rounded up to the next multiple of the slack, measured from
+   * the clock's epoch. Timers that share a slack value are thereby snapped
+   * onto the same boundaries, allowing many of them to complete on a single
+   * wakeup of the underlying event demultiplexer.
+   *
+   * The slack does not affect the value returned by expiry(), nor the
+   * behaviour of wait(). A slack of zero, which is the default, disables
+   * coalescing.
+   *
+   * @param slack_time The slack to be used for the timer.
+   */
+  void slack(const duration& slack_time)
+  {
+    impl_.get_service().slack(impl_.get_implementation(), slack_time);
+  }
+
 #if !defined(ASIO_NO_DEPRECATED)
   /// (Deprecated: Use expiry().) Get the timer's expiry time relative to now.
   /**
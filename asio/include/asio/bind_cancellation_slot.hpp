@@ -0,0 +1,246 @@
+//
+// bind_cancellation_slot.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_BIND_CANCELLATION_SLOT_HPP
+#define ASIO_BIND_CANCELLATION_SLOT_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/associated_allocator.hpp"
+#include "asio/associated_cancellation_slot.hpp"
+#include "asio/associated_executor.hpp"
+#include "asio/async_result.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_cont_helpers.hpp"
+#include "asio/detail/handler_invoke_helpers.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/detail/variadic_templates.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// A call wrapper type to bind a cancellation slot of type @c CancellationSlot
+/// to an object of type @c T.
+template <typename T, typename CancellationSlot>
+class cancellation_slot_binder
+{
+public:
+  /// The type of the target object.
+  typedef T target_type;
+
+  /// The type of the associated cancellation slot.
+  typedef CancellationSlot cancellation_slot_type;
+
+  /// Construct a cancellation slot wrapper for the specified object.
+  /**
+   * This constructor is only valid if the type @c T is constructible from type
+   * @c U.
+   */
+  template <typename U>
+  cancellation_slot_binder(const cancellation_slot_type& s,
+      ASIO_MOVE_ARG(U) u)
+    : slot_(s),
+      target_(ASIO_MOVE_CAST(U)(u))
+  {
+  }
+
+  /// Copy constructor.
+  cancellation_slot_binder(const cancellation_slot_binder& other)
+    : slot_(other.slot_),
+      target_(other.target_)
+  {
+  }
+
+#if defined(ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
+  /// Move constructor.
+  cancellation_slot_binder(cancellation_slot_binder&& other)
+    : slot_(other.slot_),
+      target_(ASIO_MOVE_CAST(T)(other.target_))
+  {
+  }
+#endif // defined(ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
+
+  /// Obtain a reference to the target object.
+  target_type& get() ASIO_NOEXCEPT
+  {
+    return target_;
+  }
+
+  /// Obtain a reference to the target object.
+  const target_type& get() const ASIO_NOEXCEPT
+  {
+    return target_;
+  }
+
+  /// Obtain the associated cancellation slot.
+  cancellation_slot_type get_cancellation_slot() const ASIO_NOEXCEPT
+  {
+    return slot_;
+  }
+
+#if defined(GENERATING_DOCUMENTATION)
+
+  template <typename... Args> auto operator()(Args&& ...);
+
+#elif defined(ASIO_HAS_VARIADIC_TEMPLATES)
+
+  /// Forwarding function call operator.
+  template <typename... Args>
+  typename result_of<T(Args...)>::type operator()(
+      ASIO_MOVE_ARG(Args)... args)
+  {
+    return target_(ASIO_MOVE_CAST(Args)(args)...);
+  }
+
+#else // defined(ASIO_HAS_VARIADIC_TEMPLATES)
+
+  void operator()()
+  {
+    target_();
+  }
+
+#define ASIO_PRIVATE_BIND_CANCELLATION_SLOT_CALL_DEF(n) \
+  template <ASIO_VARIADIC_TPARAMS(n)> \
+  void operator()(ASIO_VARIADIC_MOVE_PARAMS(n)) \
+  { \
+    target_(ASIO_VARIADIC_MOVE_ARGS(n)); \
+  } \
+  /**/
+  ASIO_VARIADIC_GENERATE(ASIO_PRIVATE_BIND_CANCELLATION_SLOT_CALL_DEF)
+#undef ASIO_PRIVATE_BIND_CANCELLATION_SLOT_CALL_DEF
+
+#endif // defined(ASIO_HAS_VARIADIC_TEMPLATES)
+
+//private:
+  CancellationSlot slot_;
+  T target_;
+};
+
+/// Associate an object of type @c T with a cancellation slot of type
+/// @c CancellationSlot.
+/**
+ * The asynchronous operation that is passed the returned object installs a
+ * cancellation handler into the slot, so that emitting the slot's signal
+ * cancels that operation only.
+ */
+template <typename CancellationSlot, typename T>
+inline cancellation_slot_binder<typename decay<T>::type, CancellationSlot>
+bind_cancellation_slot(const CancellationSlot& s, ASIO_MOVE_ARG(T) t)
+{
+  return cancellation_slot_binder<typename decay<T>::type, CancellationSlot>(
+      s, ASIO_MOVE_CAST(T)(t));
+}
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <typename T, typename CancellationSlot>
+inline void* asio_handler_allocate(std::size_t size,
+    cancellation_slot_binder<T, CancellationSlot>* this_handler)
+{
+  return asio_handler_alloc_helpers::allocate(
+      size, this_handler->target_);
+}
+
+template <typename T, typename CancellationSlot>
+inline void asio_handler_deallocate(void* pointer, std::size_t size,
+    cancellation_slot_binder<T, CancellationSlot>* this_handler)
+{
+  asio_handler_alloc_helpers::deallocate(
+      pointer, size, this_handler->target_);
+}
+
+template <typename T, typename CancellationSlot>
+inline bool asio_handler_is_continuation(
+    cancellation_slot_binder<T, CancellationSlot>* this_handler)
+{
+  return asio_handler_cont_helpers::is_continuation(
+      this_handler->target_);
+}
+
+template <typename Function, typename T, typename CancellationSlot>
+inline void asio_handler_invoke(Function& function,
+    cancellation_slot_binder<T, CancellationSlot>* this_handler)
+{
+  asio_handler_invoke_helpers::invoke(
+      function, this_handler->target_);
+}
+
+template <typename Function, typename T, typename CancellationSlot>
+inline void asio_handler_invoke(const Function& function,
+    cancellation_slot_binder<T, CancellationSlot>* this_handler)
+{
+  asio_handler_invoke_helpers::invoke(
+      function, this_handler->target_);
+}
+
+template <typename T, typename CancellationSlot, typename Signature>
+class async_result<cancellation_slot_binder<T, CancellationSlot>, Signature>
+{
+public:
+  typedef cancellation_slot_binder<
+    typename async_result<T, Signature>::completion_handler_type,
+      CancellationSlot> completion_handler_type;
+
+  typedef typename async_result<T, Signature>::return_type return_type;
+
+  explicit async_result(cancellation_slot_binder<T, CancellationSlot>& b)
+    : target_(b.get())
+  {
+  }
+
+  return_type get()
+  {
+    return target_.get();
+  }
+
+private:
+  async_result(const async_result&) ASIO_DELETED;
+  async_result& operator=(const async_result&) ASIO_DELETED;
+
+  async_result<T, Signature> target_;
+};
+
+template <typename T, typename CancellationSlot, typename Allocator>
+struct associated_allocator<
+    cancellation_slot_binder<T, CancellationSlot>, Allocator>
+{
+  typedef typename associated_allocator<T, Allocator>::type type;
+
+  static type get(const cancellation_slot_binder<T, CancellationSlot>& b,
+      const Allocator& a = Allocator()) ASIO_NOEXCEPT
+  {
+    return associated_allocator<T, Allocator>::get(b.get(), a);
+  }
+};
+
+template <typename T, typename CancellationSlot, typename Executor>
+struct associated_executor<
+    cancellation_slot_binder<T, CancellationSlot>, Executor>
+{
+  typedef typename associated_executor<T, Executor>::type type;
+
+  static type get(const cancellation_slot_binder<T, CancellationSlot>& b,
+      const Executor& ex = Executor()) ASIO_NOEXCEPT
+  {
+    return associated_executor<T, Executor>::get(b.get(), ex);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_BIND_CANCELLATION_SLOT_HPP
@@ -20,6 +20,7 @@
 #include "asio/detail/variadic_templates.hpp"
 #include "asio/associated_executor.hpp"
 #include "asio/associated_allocator.hpp"
+#include "asio/associated_cancellation_slot.hpp"
 #include "asio/async_result.hpp"
 #include "asio/execution_context.hpp"
 #include "asio/is_executor.hpp"
@@ -559,6 +560,21 @@ struct associated_allocator<executor_binder<T, Executor>, Allocator>
   }
 };
 
+template <typename T, typename Executor, typename CancellationSlot>
+struct associated_cancellation_slot<
+    executor_binder<T, Executor>, CancellationSlot>
+{
+  typedef typename associated_cancellation_slot<
+    T, CancellationSlot>::type type;
+
+  static type get(const executor_binder<T, Executor>& b,
+      const CancellationSlot& s = CancellationSlot()) ASIO_NOEXCEPT
+  {
+    return associated_cancellation_slot<T,
+        CancellationSlot>::get(b.get(), s);
+  }
+};
+
 template <typename T, typename Executor, typename Executor1>
 struct associated_executor<executor_binder<T, Executor>, Executor1>
 {
@@ -0,0 +1,310 @@
+//
+// cancellation_signal.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_CANCELLATION_SIGNAL_HPP
+#define ASIO_CANCELLATION_SIGNAL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/detail/variadic_templates.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+class cancellation_handler_base
+{
+public:
+  virtual void call() = 0;
+  virtual std::pair<void*, std::size_t> destroy() ASIO_NOEXCEPT = 0;
+
+protected:
+  ~cancellation_handler_base() {}
+};
+
+template <typename Handler>
+class cancellation_handler
+  : public cancellation_handler_base
+{
+public:
+#if defined(ASIO_HAS_VARIADIC_TEMPLATES)
+  template <typename... Args>
+  cancellation_handler(std::size_t size, ASIO_MOVE_ARG(Args)... args)
+    : handler_(ASIO_MOVE_CAST(Args)(args)...),
+      size_(size)
+  {
+  }
+#else // defined(ASIO_HAS_VARIADIC_TEMPLATES)
+  explicit cancellation_handler(std::size_t size)
+    : handler_(),
+      size_(size)
+  {
+  }
+
+#define ASIO_PRIVATE_CANCELLATION_HANDLER_CTOR_DEF(n) \
+  template <ASIO_VARIADIC_TPARAMS(n)> \
+  cancellation_handler(std::size_t size, ASIO_VARIADIC_MOVE_PARAMS(n)) \
+    : handler_(ASIO_VARIADIC_MOVE_ARGS(n)), \
+      size_(size) \
+  { \
+  } \
+  /**/
+  ASIO_VARIADIC_GENERATE(ASIO_PRIVATE_CANCELLATION_HANDLER_CTOR_DEF)
+#undef ASIO_PRIVATE_CANCELLATION_HANDLER_CTOR_DEF
+#endif // defined(ASIO_HAS_VARIADIC_TEMPLATES)
+
+  void call()
+  {
+    handler_();
+  }
+
+  std::pair<void*, std::size_t> destroy() ASIO_NOEXCEPT
+  {
+    std::pair<void*, std::size_t> mem(this, size_);
+    this->cancellation_handler::~cancellation_handler();
+    return mem;
+  }
+
+  Handler& handler() ASIO_NOEXCEPT
+  {
+    return handler_;
+  }
+
+private:
+  ~cancellation_handler()
+  {
+  }
+
+  Handler handler_;
+  std::size_t size_;
+};
+
+} // namespace detail
+
+class cancellation_slot;
+
+/// A cancellation signal with a single slot.
+/**
+ * A cancellation signal is used to request that an asynchronous operation be
+ * cancelled. The operation's completion handler is associated with the
+ * signal's slot, for example by using bind_cancellation_slot(). When the
+ * operation is initiated it installs a cancellation handler into the slot,
+ * which is invoked by a subsequent call to emit().
+ *
+ * Only the operation associated with the slot is cancelled. Other operations
+ * on the same I/O object are unaffected, and the I/O object remains open.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe. A call to emit() must not be concurrent with
+ * the initiation of an operation that uses the signal's slot.
+ */
+class cancellation_signal
+  : private detail::noncopyable
+{
+public:
+  /// Construct a signal with no installed handler.
+  cancellation_signal()
+    : handler_(0)
+  {
+  }
+
+  /// Destructor destroys any installed handler.
+  ASIO_DECL ~cancellation_signal();
+
+  /// Emit the signal, invoking the slot's handler, if any.
+  /**
+   * If the operation that installed the handler has already completed, the
+   * emitted signal has no effect.
+   */
+  void emit()
+  {
+    if (handler_)
+      handler_->call();
+  }
+
+  /// Get the single slot associated with the signal.
+  /**
+   * The slot refers to the signal, which must outlive any operation that has
+   * been associated with the slot.
+   */
+  cancellation_slot slot() ASIO_NOEXCEPT;
+
+private:
+  detail::cancellation_handler_base* handler_;
+};
+
+/// A slot associated with a cancellation signal.
+/**
+ * Asynchronous operations obtain the slot associated with their completion
+ * handler using get_associated_cancellation_slot(), and install a
+ * cancellation handler into it using emplace(). A cancellation handler is a
+ * function object with the signature <tt>void()</tt>.
+ *
+ * Installing a handler destroys any handler previously installed in the slot.
+ * The slot reuses the memory of the previous handler when it is large enough,
+ * so that repeated operations using the same slot do not allocate memory.
+ */
+class cancellation_slot
+{
+public:
+  /// Construct a slot that is not connected to any signal.
+  ASIO_CONSTEXPR cancellation_slot()
+    : handler_(0)
+  {
+  }
+
+#if defined(ASIO_HAS_VARIADIC_TEMPLATES) || defined(GENERATING_DOCUMENTATION)
+  /// Install a cancellation handler into the slot, constructed from the
+  /// supplied arguments.
+  /**
+   * The slot must be connected to a signal.
+   *
+   * @returns A reference to the newly installed handler.
+   */
+  template <typename CancellationHandler, typename... Args>
+  CancellationHandler& emplace(ASIO_MOVE_ARG(Args)... args)
+  {
+    typedef detail::cancellation_handler<CancellationHandler>
+      cancellation_handler_type;
+    auto_delete_helper del = { prepare_memory(
+        sizeof(cancellation_handler_type)) };
+    cancellation_handler_type* handler_obj =
+      new (del.mem.first) cancellation_handler_type(
+        del.mem.second, ASIO_MOVE_CAST(Args)(args)...);
+    del.mem.first = 0;
+    *handler_ = handler_obj;
+    return handler_obj->handler();
+  }
+#else // defined(ASIO_HAS_VARIADIC_TEMPLATES)
+  template <typename CancellationHandler>
+  CancellationHandler& emplace()
+  {
+    typedef detail::cancellation_handler<CancellationHandler>
+      cancellation_handler_type;
+    auto_delete_helper del = { prepare_memory(
+        sizeof(cancellation_handler_type)) };
+    cancellation_handler_type* handler_obj =
+      new (del.mem.first) cancellation_handler_type(del.mem.second);
+    del.mem.first = 0;
+    *handler_ = handler_obj;
+    return handler_obj->handler();
+  }
+
+#define ASIO_PRIVATE_CANCELLATION_SLOT_EMPLACE_DEF(n) \
+  template <typename CancellationHandler, ASIO_VARIADIC_TPARAMS(n)> \
+  CancellationHandler& emplace(ASIO_VARIADIC_MOVE_PARAMS(n)) \
+  { \
+    typedef detail::cancellation_handler<CancellationHandler> \
+      cancellation_handler_type; \
+    auto_delete_helper del = { prepare_memory( \
+        sizeof(cancellation_handler_type)) }; \
+    cancellation_handler_type* handler_obj = \
+      new (del.mem.first) cancellation_handler_type( \
+        del.mem.second, ASIO_VARIADIC_MOVE_ARGS(n)); \
+    del.mem.first = 0; \
+    *handler_ = handler_obj; \
+    return handler_obj->handler(); \
+  } \
+  /**/
+  ASIO_VARIADIC_GENERATE(ASIO_PRIVATE_CANCELLATION_SLOT_EMPLACE_DEF)
+#undef ASIO_PRIVATE_CANCELLATION_SLOT_EMPLACE_DEF
+#endif // defined(ASIO_HAS_VARIADIC_TEMPLATES)
+
+  /// Install a cancellation handler into the slot.
+  /**
+   * The slot must be connected to a signal.
+   *
+   * @returns A reference to the newly installed handler.
+   */
+  template <typename CancellationHandler>
+  typename decay<CancellationHandler>::type& assign(
+      ASIO_MOVE_ARG(CancellationHandler) handler)
+  {
+    return this->emplace<typename decay<CancellationHandler>::type>(
+        ASIO_MOVE_CAST(CancellationHandler)(handler));
+  }
+
+  /// Destroy any handler installed in the slot.
+  ASIO_DECL void clear();
+
+  /// Determine whether the slot is connected to a signal.
+  ASIO_CONSTEXPR bool is_connected() const ASIO_NOEXCEPT
+  {
+    return handler_ != 0;
+  }
+
+  /// Determine whether a handler is installed in the slot.
+  ASIO_CONSTEXPR bool has_handler() const ASIO_NOEXCEPT
+  {
+    return handler_ != 0 && *handler_ != 0;
+  }
+
+  /// Compare two slots for equality.
+  friend ASIO_CONSTEXPR bool operator==(const cancellation_slot& lhs,
+      const cancellation_slot& rhs) ASIO_NOEXCEPT
+  {
+    return lhs.handler_ == rhs.handler_;
+  }
+
+  /// Compare two slots for inequality.
+  friend ASIO_CONSTEXPR bool operator!=(const cancellation_slot& lhs,
+      const cancellation_slot& rhs) ASIO_NOEXCEPT
+  {
+    return lhs.handler_ != rhs.handler_;
+  }
+
+private:
+  friend class cancellation_signal;
+
+  ASIO_CONSTEXPR cancellation_slot(int,
+      detail::cancellation_handler_base** handler)
+    : handler_(handler)
+  {
+  }
+
+  // Destroy the installed handler, if any, and return a block of memory that
+  // is large enough for the new handler.
+  ASIO_DECL std::pair<void*, std::size_t> prepare_memory(std::size_t size);
+
+  // Frees the memory if the new handler's constructor throws.
+  struct auto_delete_helper
+  {
+    std::pair<void*, std::size_t> mem;
+
+    ASIO_DECL ~auto_delete_helper();
+  };
+
+  detail::cancellation_handler_base** handler_;
+};
+
+inline cancellation_slot cancellation_signal::slot() ASIO_NOEXCEPT
+{
+  return cancellation_slot(0, &handler_);
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/impl/cancellation_signal.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_CANCELLATION_SIGNAL_HPP
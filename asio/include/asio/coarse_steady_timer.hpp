@@ -0,0 +1,45 @@
+//
+// coarse_steady_timer.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_COARSE_STEADY_TIMER_HPP
+#define ASIO_COARSE_STEADY_TIMER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
+#include "asio/basic_waitable_timer.hpp"
+#include "asio/detail/coarse_steady_clock.hpp"
+
+namespace asio {
+
+/// Typedef for a timer based on a coarse monotonic clock.
+/**
+ * This timer reads the current time using @c CLOCK_MONOTONIC_COARSE where the
+ * platform provides it, and falls back to the steady clock otherwise. Reading
+ * a coarse clock avoids accessing the hardware timer, making it cheaper both
+ * for the timer's own expires_after() calls and for the reactor's handling of
+ * the timer queue. In exchange, expiry is detected with the resolution of the
+ * kernel tick, typically between 1 and 10 milliseconds.
+ *
+ * This makes the timer suitable for keepalive, retransmission and inactivity
+ * timeouts that are frequently re-armed and do not require precise expiry.
+ */
+typedef basic_waitable_timer<detail::coarse_steady_clock> coarse_steady_timer;
+
+} // namespace asio
+
+#endif // defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_COARSE_STEADY_TIMER_HPP
@@ -17,6 +17,7 @@
 
 #include "asio/detail/config.hpp"
 #include <cstddef>
+#include "asio/error_code.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -25,7 +26,20 @@ namespace asio {
 namespace detail {
 
 // The default maximum number of bytes to transfer in a single operation.
+#if defined(ASIO_DEFAULT_MAX_TRANSFER_SIZE)
+enum default_max_transfer_size_t
+{
+  default_max_transfer_size = ASIO_DEFAULT_MAX_TRANSFER_SIZE
+};
+#else // defined(ASIO_DEFAULT_MAX_TRANSFER_SIZE)
 enum default_max_transfer_size_t { default_max_transfer_size = 65536 };
+#endif // defined(ASIO_DEFAULT_MAX_TRANSFER_SIZE)
+
+// The default upper limit for the adaptive transfer size.
+enum default_max_adaptive_transfer_size_t
+{
+  default_max_adaptive_transfer_size = default_max_transfer_size * 64
+};
 
 // Adapt result of old-style completion conditions (which had a bool result
 // where true indicated that the operation was complete).
@@ -97,6 +111,90 @@ private:
   std::size_t size_;
 };
 
+class transfer_adaptive_t
+{
+public:
+  typedef std::size_t result_type;
+
+  transfer_adaptive_t(std::size_t initial_size, std::size_t maximum_size)
+    : maximum_(maximum_size > 0 ? maximum_size : 1),
+      minimum_(initial_size > 0
+          ? (initial_size < maximum_ ? initial_size : maximum_)
+          : std::size_t(1)),
+      size_(minimum_),
+      total_(0),
+      short_steps_(0),
+      largest_short_step_(0)
+  {
+  }
+
+  template <typename Error>
+  std::size_t operator()(const Error& err, std::size_t bytes_transferred)
+  {
+    if (!!err)
+      return 0;
+
+    if (bytes_transferred > total_)
+    {
+      // An underlying operation that used the whole limit suggests the stream
+      // could have taken more, so the limit is doubled. A single short
+      // operation says little, as a read may simply have found less data
+      // waiting, so the limit only drops after consecutive operations have
+      // transferred less than half of it. It never drops below the initial
+      // size.
+      std::size_t n = bytes_transferred - total_;
+      if (n >= size_)
+      {
+        size_ = size_ < maximum_ / 2 ? size_ * 2 : maximum_;
+        short_steps_ = 0;
+        largest_short_step_ = 0;
+      }
+      else if (n < size_ / 2)
+      {
+        if (n > largest_short_step_)
+          largest_short_step_ = n;
+        if (++short_steps_ == max_short_steps)
+        {
+          size_ = largest_short_step_ > minimum_
+            ? largest_short_step_ : minimum_;
+          short_steps_ = 0;
+          largest_short_step_ = 0;
+        }
+      }
+      else
+      {
+        short_steps_ = 0;
+        largest_short_step_ = 0;
+      }
+    }
+
+    total_ = bytes_transferred;
+    return size_;
+  }
+
+private:
+  // The number of consecutive short operations after which the limit drops.
+  enum { max_short_steps = 2 };
+
+  std::size_t maximum_;
+  std::size_t minimum_;
+  std::size_t size_;
+  std::size_t total_;
+  std::size_t short_steps_;
+  std::size_t largest_short_step_;
+};
+
+// Get the initial adaptive transfer size from a socket buffer size option.
+template <typename Socket, typename Option>
+inline std::size_t adaptive_size_from_socket(const Socket& s, Option option)
+{
+  asio::error_code ec;
+  s.get_option(option, ec);
+  return !ec && option.value() > 0
+    ? static_cast<std::size_t>(option.value())
+    : std::size_t(default_max_transfer_size);
+}
+
 } // namespace detail
 
 /**
@@ -209,6 +307,100 @@ inline detail::transfer_exactly_t transfer_exactly(std::size_t size)
 }
 #endif
 
+/// Return a completion condition function object that indicates that a read or
+/// write operation should continue until all of the data has been transferred,
+/// or until an error occurs, adapting the size of each underlying operation
+/// to the stream.
+/**
+ * This function is used to create an object, of unspecified type, that meets
+ * CompletionCondition requirements.
+ *
+ * The first underlying operation transfers at most @c initial_size bytes.
+ * When an operation transfers as many bytes as were allowed, the limit for
+ * the next operation is doubled, up to @c maximum_size. When two consecutive
+ * operations each transfer less than half of the limit, the limit is reduced
+ * to the larger number of bytes that they transferred, but never below
+ * @c initial_size.
+ *
+ * The object holds state, so a separate object must be created for each read
+ * or write operation.
+ *
+ * @par Example
+ * Writing a large buffer, starting from the size of the socket's send buffer:
+ * @code
+ * asio::socket_base::send_buffer_size option;
+ * sock.get_option(option);
+ * asio::async_write(sock, asio::buffer(data),
+ *     asio::transfer_adaptive(option.value()), handler);
+ * @endcode
+ */
+#if defined(GENERATING_DOCUMENTATION)
+unspecified transfer_adaptive(
+    std::size_t initial_size = default_max_transfer_size,
+    std::size_t maximum_size = default_max_adaptive_transfer_size);
+#else
+inline detail::transfer_adaptive_t transfer_adaptive(
+    std::size_t initial_size = detail::default_max_transfer_size,
+    std::size_t maximum_size = detail::default_max_adaptive_transfer_size)
+{
+  return detail::transfer_adaptive_t(initial_size, maximum_size);
+}
+#endif
+
+/// Return a completion condition function object for writing to a socket,
+/// which adapts the size of each underlying operation starting from the size
+/// of the socket's send buffer.
+/**
+ * This function is equivalent to calling transfer_adaptive() with an
+ * @c initial_size obtained from the socket's
+ * asio::socket_base::send_buffer_size option. If the option cannot be
+ * read, @c default_max_transfer_size is used instead.
+ *
+ * @par Example
+ * @code
+ * asio::async_write(sock, asio::buffer(data),
+ *     asio::transfer_adaptive_send(sock), handler);
+ * @endcode
+ */
+#if defined(GENERATING_DOCUMENTATION)
+template <typename Socket>
+unspecified transfer_adaptive_send(const Socket& s,
+    std::size_t maximum_size = default_max_adaptive_transfer_size);
+#else
+template <typename Socket>
+inline detail::transfer_adaptive_t transfer_adaptive_send(const Socket& s,
+    std::size_t maximum_size = detail::default_max_adaptive_transfer_size)
+{
+  return detail::transfer_adaptive_t(
+      detail::adaptive_size_from_socket(s,
+        typename Socket::send_buffer_size()), maximum_size);
+}
+#endif
+
+/// Return a completion condition function object for reading from a socket,
+/// which adapts the size of each underlying operation starting from the size
+/// of the socket's receive buffer.
+/**
+ * This function is equivalent to calling transfer_adaptive() with an
+ * @c initial_size obtained from the socket's
+ * asio::socket_base::receive_buffer_size option. If the option cannot
+ * be read, @c default_max_transfer_size is used instead.
+ */
+#if defined(GENERATING_DOCUMENTATION)
+template <typename Socket>
+unspecified transfer_adaptive_receive(const Socket& s,
+    std::size_t maximum_size = default_max_adaptive_transfer_size);
+#else
+template <typename Socket>
+inline detail::transfer_adaptive_t transfer_adaptive_receive(const Socket& s,
+    std::size_t maximum_size = detail::default_max_adaptive_transfer_size)
+{
+  return detail::transfer_adaptive_t(
+      detail::adaptive_size_from_socket(s,
+        typename Socket::receive_buffer_size()), maximum_size);
+}
+#endif
+
 /*@}*/
 
 } // namespace asio
@@ -0,0 +1,107 @@
+//
+// detail/allocation_tracking.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_ALLOCATION_TRACKING_HPP
+#define ASIO_DETAIL_ALLOCATION_TRACKING_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_CUSTOM_ALLOCATION_TRACKING)
+# include ASIO_CUSTOM_ALLOCATION_TRACKING
+#elif defined(ASIO_ENABLE_ALLOCATION_TRACKING)
+# include <cstddef>
+# include "asio/detail/static_mutex.hpp"
+#endif // defined(ASIO_ENABLE_ALLOCATION_TRACKING)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+#if defined(ASIO_CUSTOM_ALLOCATION_TRACKING)
+
+// The user-specified header must define the following macro:
+// - ASIO_HEAP_ALLOCATION(args)
+
+# if !defined(ASIO_ENABLE_ALLOCATION_TRACKING)
+#  define ASIO_ENABLE_ALLOCATION_TRACKING 1
+# endif // !defined(ASIO_ENABLE_ALLOCATION_TRACKING)
+
+#elif defined(ASIO_ENABLE_ALLOCATION_TRACKING)
+
+// Counts the heap allocations made inside the library, keyed by the call site
+// that made them. Allocations satisfied from a recycled block, or from a
+// user-supplied allocator, are not counted. A site is identified by a string
+// literal naming the allocating component.
+class allocation_tracking
+{
+public:
+  // The maximum number of distinct sites that can be counted.
+  enum { max_sites = 32 };
+
+  // Record a heap allocation of the given size made at the named site.
+  ASIO_DECL static void allocated(const char* site, std::size_t size);
+
+  // Discard all counts.
+  ASIO_DECL static void reset();
+
+  // Get the number of heap allocations recorded since the last reset.
+  ASIO_DECL static std::size_t count();
+
+  // Get the number of heap allocations recorded at the named site.
+  ASIO_DECL static std::size_t count(const char* site);
+
+  // Write the counts for each site to stderr.
+  ASIO_DECL static void report();
+
+private:
+  struct site_count
+  {
+    const char* site;
+    std::size_t count;
+    std::size_t bytes;
+  };
+
+  struct tracking_state
+  {
+    static_mutex mutex_;
+    site_count sites_[max_sites];
+    std::size_t num_sites_;
+  };
+
+  ASIO_DECL static tracking_state* get_state();
+
+  // Initialise the state. Called once, by get_state().
+  ASIO_DECL static tracking_state* init_state();
+};
+
+# define ASIO_HEAP_ALLOCATION(args) \
+  asio::detail::allocation_tracking::allocated args
+
+#else // defined(ASIO_ENABLE_ALLOCATION_TRACKING)
+
+# define ASIO_HEAP_ALLOCATION(args) (void)0
+
+#endif // defined(ASIO_ENABLE_ALLOCATION_TRACKING)
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/allocation_tracking.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_DETAIL_ALLOCATION_TRACKING_HPP
@@ -0,0 +1,142 @@
+//
+// detail/channel_buffer.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_CHANNEL_BUFFER_HPP
+#define ASIO_DETAIL_CHANNEL_BUFFER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_MOVE)
+
+#include <cstddef>
+#include <new>
+#include "asio/detail/allocation_tracking.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A ring of buffered channel messages. Storage grows geometrically up to the
+// channel's limit and is then reused, so that a channel in a steady state
+// does not allocate memory per message.
+template <typename T>
+class channel_buffer
+  : private noncopyable
+{
+public:
+  // Constructor.
+  explicit channel_buffer(std::size_t max_size)
+    : data_(0),
+      capacity_(0),
+      head_(0),
+      size_(0),
+      max_size_(max_size)
+  {
+  }
+
+  // Destructor.
+  ~channel_buffer()
+  {
+    while (size_ > 0)
+      pop();
+    ::operator delete(data_);
+  }
+
+  // Whether the buffer holds no messages.
+  bool empty() const
+  {
+    return size_ == 0;
+  }
+
+  // Whether the buffer holds as many messages as the limit allows.
+  bool full() const
+  {
+    return size_ == max_size_;
+  }
+
+  // The number of buffered messages.
+  std::size_t size() const
+  {
+    return size_;
+  }
+
+  // The maximum number of buffered messages.
+  std::size_t max_size() const
+  {
+    return max_size_;
+  }
+
+  // Add a message to the back of the buffer, which must not be full.
+  void push(T& value)
+  {
+    if (size_ == capacity_)
+      grow();
+    new (data_ + (head_ + size_) % capacity_) T(ASIO_MOVE_CAST(T)(value));
+    ++size_;
+  }
+
+  // Get the message at the front of the buffer, which must not be empty.
+  T& front()
+  {
+    return data_[head_];
+  }
+
+  // Remove the message at the front of the buffer.
+  void pop()
+  {
+    data_[head_].~T();
+    head_ = (head_ + 1) % capacity_;
+    --size_;
+  }
+
+private:
+  void grow()
+  {
+    std::size_t new_capacity = capacity_ ? capacity_ * 2 : 16;
+    if (new_capacity > max_size_ || new_capacity < capacity_)
+      new_capacity = max_size_;
+
+    ASIO_HEAP_ALLOCATION(("channel_buffer", new_capacity * sizeof(T)));
+    T* new_data = static_cast<T*>(
+        ::operator new(new_capacity * sizeof(T)));
+    for (std::size_t i = 0; i < size_; ++i)
+    {
+      T& value = data_[(head_ + i) % capacity_];
+      new (new_data + i) T(ASIO_MOVE_CAST(T)(value));
+      value.~T();
+    }
+
+    ::operator delete(data_);
+    data_ = new_data;
+    capacity_ = new_capacity;
+    head_ = 0;
+  }
+
+  T* data_;
+  std::size_t capacity_;
+  std::size_t head_;
+  std::size_t size_;
+  std::size_t max_size_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_MOVE)
+
+#endif // ASIO_DETAIL_CHANNEL_BUFFER_HPP
@@ -0,0 +1,258 @@
+//
+// detail/channel_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_CHANNEL_OP_HPP
+#define ASIO_DETAIL_CHANNEL_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_MOVE)
+
+#include "asio/associated_allocator.hpp"
+#include "asio/associated_executor.hpp"
+#include "asio/error_code.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/executor_priority.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_cont_helpers.hpp"
+#include "asio/detail/handler_invoke_helpers.hpp"
+#include "asio/detail/handler_tracking.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/op_queue.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Base class for operations that wait on a channel. Each operation carries the
+// message being sent or received, so that a waiting sender or receiver needs
+// no storage beyond the operation itself. A function pointer is used instead
+// of virtual functions to avoid the associated overhead.
+template <typename T>
+class channel_op ASIO_INHERIT_TRACKED_HANDLER
+{
+public:
+  // Post the completion handler to its associated executor.
+  void complete()
+  {
+    func_(this, false);
+  }
+
+  // Destroy the operation without invoking the handler.
+  void destroy()
+  {
+    func_(this, true);
+  }
+
+  // The handler is dispatched through its associated executor, which applies
+  // its own priority, so the priority class is not stored.
+  int priority() const
+  {
+    return normal_priority;
+  }
+
+  void priority(int)
+  {
+  }
+
+  // The error code to be passed to the completion handler.
+  asio::error_code ec_;
+
+  // The message being sent or received.
+  T value_;
+
+protected:
+  typedef void (*func_type)(channel_op*, bool);
+
+  channel_op(func_type func)
+    : ec_(),
+      value_(),
+      next_(0),
+      func_(func)
+  {
+  }
+
+  channel_op(func_type func, T& value)
+    : ec_(),
+      value_(ASIO_MOVE_CAST(T)(value)),
+      next_(0),
+      func_(func)
+  {
+  }
+
+  // Prevents deletion through this type.
+  ~channel_op()
+  {
+  }
+
+private:
+  friend class op_queue_access;
+  channel_op* next_;
+  func_type func_;
+};
+
+// Shared implementation of the send and receive operations, which differ
+// only in the arguments passed to the handler.
+template <typename T, typename Handler, typename IoExecutor, typename Binder>
+class channel_handler_op : public channel_op<T>
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(channel_handler_op);
+
+  channel_handler_op(Handler& handler, const IoExecutor& io_ex)
+    : channel_op<T>(&channel_handler_op::do_complete),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      io_executor_(io_ex)
+  {
+    handler_work<Handler, IoExecutor>::start(handler_, io_executor_, *this);
+  }
+
+  channel_handler_op(T& value, Handler& handler, const IoExecutor& io_ex)
+    : channel_op<T>(&channel_handler_op::do_complete, value),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      io_executor_(io_ex)
+  {
+    handler_work<Handler, IoExecutor>::start(handler_, io_executor_, *this);
+  }
+
+  static void do_complete(channel_op<T>* base, bool destroy)
+  {
+    // Take ownership of the operation object.
+    channel_handler_op* o(static_cast<channel_handler_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+    handler_work<Handler, IoExecutor> w(o->handler_, o->io_executor_);
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    typename associated_executor<Handler, IoExecutor>::type ex(
+        asio::get_associated_executor(o->handler_, o->io_executor_));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the handler is posted. Even if we're not about to post the handler, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    Binder handler(0, ASIO_MOVE_CAST(Handler)(o->handler_), o->ec_,
+        ASIO_MOVE_CAST(T)(o->value_));
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // The handler is always posted, so that completing one side of a channel
+    // never runs the other side's handler on the same call stack.
+    if (!destroy)
+    {
+      typename associated_allocator<Handler>::type alloc(
+          asio::get_associated_allocator(handler.handler_));
+      ex.post(ASIO_MOVE_CAST(Binder)(handler), alloc);
+    }
+  }
+
+private:
+  Handler handler_;
+  IoExecutor io_executor_;
+};
+
+// Binds the result of a send operation, which does not pass the message.
+template <typename Handler, typename T>
+class channel_send_binder
+{
+public:
+  channel_send_binder(int, ASIO_MOVE_ARG(Handler) handler,
+      const asio::error_code& ec, ASIO_MOVE_ARG(T))
+    : handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      ec_(ec)
+  {
+  }
+
+  channel_send_binder(channel_send_binder&& other)
+    : handler_(ASIO_MOVE_CAST(Handler)(other.handler_)),
+      ec_(other.ec_)
+  {
+  }
+
+  void operator()()
+  {
+    handler_(static_cast<const asio::error_code&>(ec_));
+  }
+
+//private:
+  Handler handler_;
+  asio::error_code ec_;
+};
+
+template <typename Handler, typename T>
+inline void* asio_handler_allocate(std::size_t size,
+    channel_send_binder<Handler, T>* this_handler)
+{
+  return asio_handler_alloc_helpers::allocate(
+      size, this_handler->handler_);
+}
+
+template <typename Handler, typename T>
+inline void asio_handler_deallocate(void* pointer, std::size_t size,
+    channel_send_binder<Handler, T>* this_handler)
+{
+  asio_handler_alloc_helpers::deallocate(
+      pointer, size, this_handler->handler_);
+}
+
+template <typename Handler, typename T>
+inline bool asio_handler_is_continuation(
+    channel_send_binder<Handler, T>* this_handler)
+{
+  return asio_handler_cont_helpers::is_continuation(
+      this_handler->handler_);
+}
+
+template <typename Function, typename Handler, typename T>
+inline void asio_handler_invoke(Function& function,
+    channel_send_binder<Handler, T>* this_handler)
+{
+  asio_handler_invoke_helpers::invoke(
+      function, this_handler->handler_);
+}
+
+template <typename Function, typename Handler, typename T>
+inline void asio_handler_invoke(const Function& function,
+    channel_send_binder<Handler, T>* this_handler)
+{
+  asio_handler_invoke_helpers::invoke(
+      function, this_handler->handler_);
+}
+
+template <typename T, typename Handler, typename IoExecutor>
+struct channel_send_op
+{
+  typedef channel_handler_op<T, Handler, IoExecutor,
+    channel_send_binder<Handler, T> > type;
+};
+
+template <typename T, typename Handler, typename IoExecutor>
+struct channel_receive_op
+{
+  typedef channel_handler_op<T, Handler, IoExecutor,
+    move_binder2<Handler, asio::error_code, T> > type;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_MOVE)
+
+#endif // ASIO_DETAIL_CHANNEL_OP_HPP
@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/cstdint.hpp"
+#include "asio/detail/timer_coalescing.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -182,6 +183,38 @@ struct chrono_time_traits
   }
 };
 
+template <typename Clock, typename WaitTraits>
+struct timer_coalescing<chrono_time_traits<Clock, WaitTraits> >
+{
+  typedef typename chrono_time_traits<Clock, WaitTraits>::time_type time_type;
+  typedef typename chrono_time_traits<
+    Clock, WaitTraits>::duration_type duration_type;
+
+  // A slack that disables coalescing. A default-constructed duration is not
+  // guaranteed to be zero.
+  static duration_type no_slack()
+  {
+    return duration_type::zero();
+  }
+
+  // Round the time up to the next multiple of the slack.
+  static time_type round_up(const time_type& t, const duration_type& slack)
+  {
+    if (slack <= duration_type::zero())
+      return t;
+
+    duration_type r = t.time_since_epoch() % slack;
+    if (r == duration_type::zero())
+      return t;
+
+    duration_type d = (r > duration_type::zero()) ? slack - r : -r;
+    if (t >= time_type() && (time_type::max)() - t < d)
+      return t;
+
+    return t + d;
+  }
+};
+
 } // namespace detail
 } // namespace asio
 
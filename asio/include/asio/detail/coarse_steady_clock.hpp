@@ -0,0 +1,68 @@
+//
+// detail/coarse_steady_clock.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_COARSE_STEADY_CLOCK_HPP
+#define ASIO_DETAIL_COARSE_STEADY_CLOCK_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_CHRONO)
+
+#include "asio/detail/chrono.hpp"
+
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+# include <time.h>
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A monotonic clock that trades resolution for a cheaper now(). Where the
+// platform provides CLOCK_MONOTONIC_COARSE the time is the value cached by the
+// kernel at its last tick, and is read without accessing the hardware timer.
+// Otherwise the clock falls back to chrono::steady_clock.
+class coarse_steady_clock
+{
+public:
+  typedef chrono::nanoseconds duration;
+  typedef duration::rep rep;
+  typedef duration::period period;
+  typedef chrono::time_point<coarse_steady_clock> time_point;
+
+  ASIO_STATIC_CONSTANT(bool, is_steady = true);
+
+  static time_point now() ASIO_NOEXCEPT
+  {
+#if defined(CLOCK_MONOTONIC_COARSE)
+    timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    return time_point(duration(
+          static_cast<rep>(ts.tv_sec) * 1000000000 + ts.tv_nsec));
+#else // defined(CLOCK_MONOTONIC_COARSE)
+    return time_point(chrono::duration_cast<duration>(
+          chrono::steady_clock::now().time_since_epoch()));
+#endif // defined(CLOCK_MONOTONIC_COARSE)
+  }
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_CHRONO)
+
+#endif // ASIO_DETAIL_COARSE_STEADY_CLOCK_HPP
@@ -15,6 +15,24 @@
 # include "esp_asio_config.h"
 #endif // defined(ESP_PLATFORM)
 
+// Profile for small single-threaded targets. Threading support is disabled,
+// so that locks and events become no-ops, and internal pools, tables and
+// default transfer sizes are reduced. Each setting may be overridden.
+#if defined(ASIO_EMBEDDED_PROFILE)
+# if !defined(ASIO_DISABLE_THREADS)
+#  define ASIO_DISABLE_THREADS 1
+# endif // !defined(ASIO_DISABLE_THREADS)
+# if !defined(ASIO_STRAND_IMPLEMENTATIONS)
+#  define ASIO_STRAND_IMPLEMENTATIONS 7
+# endif // !defined(ASIO_STRAND_IMPLEMENTATIONS)
+# if !defined(ASIO_HASH_MAP_BUCKETS)
+#  define ASIO_HASH_MAP_BUCKETS 3, 13, 23, 53, 97
+# endif // !defined(ASIO_HASH_MAP_BUCKETS)
+# if !defined(ASIO_DEFAULT_MAX_TRANSFER_SIZE)
+#  define ASIO_DEFAULT_MAX_TRANSFER_SIZE 4096
+# endif // !defined(ASIO_DEFAULT_MAX_TRANSFER_SIZE)
+#endif // defined(ASIO_EMBEDDED_PROFILE)
+
 // boostify: non-boost code starts here
 #if !defined(ASIO_STANDALONE)
 # if !defined(ASIO_ENABLE_BOOST)
@@ -1100,6 +1118,24 @@
 # endif // !defined(ASIO_HAS_TIMERFD)
 #endif // defined(__linux__)
 
+// Linux: splice and sendfile.
+#if defined(__linux__)
+# if !defined(ASIO_HAS_SPLICE)
+#  if !defined(ASIO_DISABLE_SPLICE)
+#   if (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 9)
+#    define ASIO_HAS_SPLICE 1
+#   endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 9)
+#  endif // !defined(ASIO_DISABLE_SPLICE)
+# endif // !defined(ASIO_HAS_SPLICE)
+# if !defined(ASIO_HAS_SENDFILE)
+#  if !defined(ASIO_DISABLE_SENDFILE)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,33)
+#    define ASIO_HAS_SENDFILE 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,33)
+#  endif // !defined(ASIO_DISABLE_SENDFILE)
+# endif // !defined(ASIO_HAS_SENDFILE)
+#endif // defined(__linux__)
+
 // Mac OS X, FreeBSD, NetBSD, OpenBSD: kqueue.
 #if (defined(__MACH__) && defined(__APPLE__)) \
   || defined(__FreeBSD__) \
@@ -1192,6 +1228,21 @@
 # endif // !defined(ASIO_DISABLE_POSIX_STREAM_DESCRIPTOR)
 #endif // !defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
 
+// POSIX: regular files, with blocking I/O performed on a thread pool.
+#if !defined(ASIO_HAS_FILE)
+# if !defined(ASIO_DISABLE_FILE)
+#  if !defined(ASIO_WINDOWS) \
+  && !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(__CYGWIN__) \
+  && !defined(ESP_PLATFORM)
+#   define ASIO_HAS_FILE 1
+#  endif // !defined(ASIO_WINDOWS)
+         //   && !defined(ASIO_WINDOWS_RUNTIME)
+         //   && !defined(__CYGWIN__)
+         //   && !defined(ESP_PLATFORM)
+# endif // !defined(ASIO_DISABLE_FILE)
+#endif // !defined(ASIO_HAS_FILE)
+
 // UNIX domain sockets.
 #if !defined(ASIO_HAS_LOCAL_SOCKETS)
 # if !defined(ASIO_DISABLE_LOCAL_SOCKETS)
@@ -1205,6 +1256,23 @@
 # endif // !defined(ASIO_DISABLE_LOCAL_SOCKETS)
 #endif // !defined(ASIO_HAS_LOCAL_SOCKETS)
 
+// POSIX: message channels over a shared memory ring buffer.
+#if !defined(ASIO_HAS_SHARED_MEMORY_CHANNEL)
+# if !defined(ASIO_DISABLE_SHARED_MEMORY_CHANNEL)
+#  if !defined(ASIO_WINDOWS) \
+  && !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(__CYGWIN__) \
+  && !defined(ESP_PLATFORM) \
+  && defined(ASIO_HAS_STD_ATOMIC)
+#   define ASIO_HAS_SHARED_MEMORY_CHANNEL 1
+#  endif // !defined(ASIO_WINDOWS)
+         //   && !defined(ASIO_WINDOWS_RUNTIME)
+         //   && !defined(__CYGWIN__)
+         //   && !defined(ESP_PLATFORM)
+         //   && defined(ASIO_HAS_STD_ATOMIC)
+# endif // !defined(ASIO_DISABLE_SHARED_MEMORY_CHANNEL)
+#endif // !defined(ASIO_HAS_SHARED_MEMORY_CHANNEL)
+
 // Can use sigaction() instead of signal().
 #if !defined(ASIO_HAS_SIGACTION)
 # if !defined(ASIO_DISABLE_SIGACTION)
@@ -17,6 +17,7 @@
 
 #include "asio/detail/config.hpp"
 #include <cstddef>
+#include "asio/associated_cancellation_slot.hpp"
 #include "asio/error.hpp"
 #include "asio/execution_context.hpp"
 #include "asio/detail/bind_handler.hpp"
@@ -25,6 +26,7 @@
 #include "asio/detail/noncopyable.hpp"
 #include "asio/detail/socket_ops.hpp"
 #include "asio/detail/socket_types.hpp"
+#include "asio/detail/timer_coalescing.hpp"
 #include "asio/detail/timer_queue.hpp"
 #include "asio/detail/timer_queue_ptime.hpp"
 #include "asio/detail/timer_scheduler.hpp"
@@ -58,6 +60,7 @@ public:
     : private asio::detail::noncopyable
   {
     time_type expiry;
+    duration_type slack;
     bool might_have_pending_waits;
     typename timer_queue<Time_Traits>::per_timer_data timer_data;
   };
@@ -87,6 +90,7 @@ public:
   void construct(implementation_type& impl)
   {
     impl.expiry = time_type();
+    impl.slack = timer_coalescing<Time_Traits>::no_slack();
     impl.might_have_pending_waits = false;
   }
 
@@ -106,6 +110,9 @@ public:
     impl.expiry = other_impl.expiry;
     other_impl.expiry = time_type();
 
+    impl.slack = other_impl.slack;
+    other_impl.slack = timer_coalescing<Time_Traits>::no_slack();
+
     impl.might_have_pending_waits = other_impl.might_have_pending_waits;
     other_impl.might_have_pending_waits = false;
   }
@@ -125,6 +132,9 @@ public:
     impl.expiry = other_impl.expiry;
     other_impl.expiry = time_type();
 
+    impl.slack = other_impl.slack;
+    other_impl.slack = timer_coalescing<Time_Traits>::no_slack();
+
     impl.might_have_pending_waits = other_impl.might_have_pending_waits;
     other_impl.might_have_pending_waits = false;
   }
@@ -212,6 +222,49 @@ public:
         Time_Traits::add(Time_Traits::now(), expiry_time), ec);
   }
 
+  // Set the expiry time for the timer as an absolute time, moving any pending
+  // waits to the new expiry time rather than cancelling them.
+  std::size_t reschedule_at(implementation_type& impl,
+      const time_type& expiry_time, asio::error_code& ec)
+  {
+    impl.expiry = expiry_time;
+    ec = asio::error_code();
+
+    if (!impl.might_have_pending_waits)
+      return 0;
+
+    ASIO_HANDLER_OPERATION((scheduler_.context(),
+          "deadline_timer", &impl, 0, "reschedule"));
+
+    std::size_t count = scheduler_.reschedule_timer(timer_queue_,
+        timer_coalescing<Time_Traits>::round_up(impl.expiry, impl.slack),
+        impl.timer_data);
+    if (count == 0)
+      impl.might_have_pending_waits = false;
+    return count;
+  }
+
+  // Set the expiry time for the timer relative to now, moving any pending
+  // waits to the new expiry time rather than cancelling them.
+  std::size_t reschedule_after(implementation_type& impl,
+      const duration_type& expiry_time, asio::error_code& ec)
+  {
+    return reschedule_at(impl,
+        Time_Traits::add(Time_Traits::now(), expiry_time), ec);
+  }
+
+  // Get the slack used to coalesce the timer with other timers.
+  duration_type slack(const implementation_type& impl) const
+  {
+    return impl.slack;
+  }
+
+  // Set the slack used to coalesce the timer with other timers.
+  void slack(implementation_type& impl, const duration_type& slack_time)
+  {
+    impl.slack = slack_time;
+  }
+
   // Perform a blocking wait on the timer.
   void wait(implementation_type& impl, asio::error_code& ec)
   {
@@ -230,22 +283,56 @@ public:
   void async_wait(implementation_type& impl,
       Handler& handler, const IoExecutor& io_ex)
   {
+    typename associated_cancellation_slot<Handler>::type slot
+      = asio::get_associated_cancellation_slot(handler);
+
     // Allocate and construct an operation to wrap the handler.
     typedef wait_handler<Handler, IoExecutor> op;
     typename op::ptr p = { asio::detail::addressof(handler),
       op::ptr::allocate(handler), 0 };
     p.p = new (p.v) op(handler, io_ex);
 
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<op_cancellation>(this, &impl.timer_data);
+    }
+
     impl.might_have_pending_waits = true;
 
     ASIO_HANDLER_CREATION((scheduler_.context(),
           *p.p, "deadline_timer", &impl, 0, "async_wait"));
 
-    scheduler_.schedule_timer(timer_queue_, impl.expiry, impl.timer_data, p.p);
+    scheduler_.schedule_timer(timer_queue_,
+        timer_coalescing<Time_Traits>::round_up(impl.expiry, impl.slack),
+        impl.timer_data, p.p);
     p.v = p.p = 0;
   }
 
 private:
+  // Helper class used to implement per-operation cancellation.
+  class op_cancellation
+  {
+  public:
+    op_cancellation(deadline_timer_service* s,
+        typename timer_queue<Time_Traits>::per_timer_data* p)
+      : service_(s),
+        timer_data_(p)
+    {
+    }
+
+    void operator()()
+    {
+      service_->scheduler_.cancel_timer_by_key(
+          service_->timer_queue_, *timer_data_, this);
+    }
+
+  private:
+    deadline_timer_service* service_;
+    typename timer_queue<Time_Traits>::per_timer_data* timer_data_;
+  };
+
   // Helper function to wait given a duration type. The duration type should
   // either be of type boost::posix_time::time_duration, or implement the
   // required subset of its interface.
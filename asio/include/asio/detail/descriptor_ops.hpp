@@ -24,6 +24,7 @@
 #include <cstddef>
 #include "asio/error.hpp"
 #include "asio/error_code.hpp"
+#include "asio/detail/cstdint.hpp"
 #include "asio/detail/socket_types.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -62,6 +63,9 @@ inline ReturnType error_wrapper(ReturnType return_value,
 ASIO_DECL int open(const char* path, int flags,
     asio::error_code& ec);
 
+ASIO_DECL int open(const char* path, int flags,
+    unsigned mode, asio::error_code& ec);
+
 ASIO_DECL int close(int d, state_type& state,
     asio::error_code& ec);
 
@@ -76,6 +80,9 @@ typedef iovec buf;
 ASIO_DECL std::size_t sync_read(int d, state_type state, buf* bufs,
     std::size_t count, bool all_empty, asio::error_code& ec);
 
+ASIO_DECL std::size_t sync_read_for(int d, state_type state, buf* bufs,
+    std::size_t count, bool all_empty, int msec, asio::error_code& ec);
+
 ASIO_DECL bool non_blocking_read(int d, buf* bufs, std::size_t count,
     asio::error_code& ec, std::size_t& bytes_transferred);
 
@@ -83,10 +90,39 @@ ASIO_DECL std::size_t sync_write(int d, state_type state,
     const buf* bufs, std::size_t count, bool all_empty,
     asio::error_code& ec);
 
+ASIO_DECL std::size_t sync_write_for(int d, state_type state,
+    const buf* bufs, std::size_t count, bool all_empty,
+    int msec, asio::error_code& ec);
+
 ASIO_DECL bool non_blocking_write(int d,
     const buf* bufs, std::size_t count,
     asio::error_code& ec, std::size_t& bytes_transferred);
 
+ASIO_DECL std::size_t pread(int d, void* data, std::size_t size,
+    uint64_t offset, asio::error_code& ec);
+
+#if defined(ASIO_HAS_FILE)
+ASIO_DECL std::size_t sync_read_at(int d, uint64_t offset, buf* bufs,
+    std::size_t count, bool all_empty, asio::error_code& ec);
+
+ASIO_DECL std::size_t sync_write_at(int d, uint64_t offset,
+    const buf* bufs, std::size_t count, bool all_empty,
+    asio::error_code& ec);
+#endif // defined(ASIO_HAS_FILE)
+
+#if defined(ASIO_HAS_SPLICE)
+ASIO_DECL int pipe(int descriptors[2], asio::error_code& ec);
+
+ASIO_DECL bool non_blocking_splice(int in, int out, std::size_t size,
+    asio::error_code& ec, std::size_t& bytes_transferred);
+#endif // defined(ASIO_HAS_SPLICE)
+
+#if defined(ASIO_HAS_SENDFILE)
+ASIO_DECL bool non_blocking_sendfile(int out, int in, uint64_t& offset,
+    std::size_t size, asio::error_code& ec,
+    std::size_t& bytes_transferred);
+#endif // defined(ASIO_HAS_SENDFILE)
+
 ASIO_DECL int ioctl(int d, state_type& state, long cmd,
     ioctl_arg_type* arg, asio::error_code& ec);
 
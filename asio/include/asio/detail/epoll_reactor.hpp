@@ -52,6 +52,8 @@ public:
   enum op_types { read_op = 0, write_op = 1,
     connect_op = 1, except_op = 2, max_ops = 3 };
 
+  enum fork_modes { fork_eager = 0, fork_lazy = 1, fork_drop = 2 };
+
   // Per-descriptor queues.
   class descriptor_state : operation
   {
@@ -68,10 +70,12 @@ public:
     op_queue<reactor_op> op_queue_[max_ops];
     bool try_speculative_[max_ops];
     bool shutdown_;
+    unsigned int fork_generation_;
 
     ASIO_DECL descriptor_state(bool locking);
     void set_ready_events(uint32_t events) { task_result_ = events; }
     void add_ready_events(uint32_t events) { task_result_ |= events; }
+    ASIO_DECL void update_priority();
     ASIO_DECL operation* perform_io(uint32_t events);
     ASIO_DECL static void do_complete(
         void* owner, operation* base,
@@ -94,6 +98,12 @@ public:
   ASIO_DECL void notify_fork(
       asio::execution_context::fork_event fork_ev);
 
+  // Set how descriptors are re-registered following a fork.
+  void set_fork_mode(fork_modes mode)
+  {
+    fork_mode_ = mode;
+  }
+
   // Initialise the task.
   ASIO_DECL void init_task();
 
@@ -131,6 +141,12 @@ public:
   ASIO_DECL void cancel_ops(socket_type descriptor,
       per_descriptor_data& descriptor_data);
 
+  // Cancel the operation associated with the given cancellation key. The
+  // handler will be invoked with the operation_aborted error.
+  ASIO_DECL void cancel_ops_by_key(socket_type descriptor,
+      per_descriptor_data& descriptor_data,
+      int op_type, void* cancellation_key);
+
   // Cancel any operations that are running against the descriptor and remove
   // its registration from the reactor. The reactor resources associated with
   // the descriptor must be released by calling cleanup_descriptor_data.
@@ -170,6 +186,19 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data& timer,
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
 
+  // Cancel the timer operation associated with the given cancellation key.
+  template <typename Time_Traits>
+  void cancel_timer_by_key(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data& timer,
+      void* cancellation_key);
+
+  // Change the expiry time of the given timer without cancelling its pending
+  // operations. Returns the number of operations that remain pending.
+  template <typename Time_Traits>
+  std::size_t reschedule_timer(timer_queue<Time_Traits>& queue,
+      const typename Time_Traits::time_type& time,
+      typename timer_queue<Time_Traits>::per_timer_data& timer);
+
   // Move the timer operations associated with the given timer.
   template <typename Time_Traits>
   void move_timer(timer_queue<Time_Traits>& queue,
@@ -193,6 +222,11 @@ private:
   // Create the timerfd file descriptor. Does not throw.
   ASIO_DECL static int do_timerfd_create();
 
+  // Add a descriptor whose registration was deferred following a fork to the
+  // epoll set. Returns 0 on success, system error code on failure. Must be
+  // called with the descriptor's mutex held.
+  ASIO_DECL int reregister_descriptor(descriptor_state* descriptor_data);
+
   // Allocate a new descriptor state object.
   ASIO_DECL descriptor_state* allocate_descriptor_state();
 
@@ -217,6 +251,11 @@ private:
   // Get the timeout value for the timer descriptor. The return value is the
   // flag argument to be used when calling timerfd_settime.
   ASIO_DECL int get_timeout(itimerspec& ts);
+
+  // Convert a wait duration in microseconds into a timeout value for the timer
+  // descriptor. The return value is the flag argument to be used when calling
+  // timerfd_settime.
+  ASIO_DECL static int get_timeout(long usec, itimerspec& ts);
 #endif // defined(ASIO_HAS_TIMERFD)
 
   // The scheduler implementation used to post completions.
@@ -246,6 +285,13 @@ private:
   // Keep track of all registered descriptors.
   object_pool<descriptor_state> registered_descriptors_;
 
+  // How descriptors are re-registered following a fork.
+  fork_modes fork_mode_;
+
+  // Incremented each time registrations are deferred following a fork. A
+  // descriptor whose generation does not match is not in the epoll set.
+  unsigned int fork_generation_;
+
   // Helper class to do post-perform_io cleanup.
   struct perform_io_cleanup_on_block_exit;
   friend struct perform_io_cleanup_on_block_exit;
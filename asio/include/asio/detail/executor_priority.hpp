@@ -0,0 +1,50 @@
+//
+// detail/executor_priority.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_EXECUTOR_PRIORITY_HPP
+#define ASIO_DETAIL_EXECUTOR_PRIORITY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// The priority classes into which the scheduler sorts ready operations.
+enum
+{
+  low_priority = 0,
+  normal_priority = 1,
+  high_priority = 2,
+  priority_classes = 3
+};
+
+// Obtains the priority class in which operations associated with an executor
+// are queued. Executors that do not carry a priority use the normal class.
+template <typename Executor>
+struct executor_priority
+{
+  static int get(const Executor&) ASIO_NOEXCEPT
+  {
+    return normal_priority;
+  }
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_EXECUTOR_PRIORITY_HPP
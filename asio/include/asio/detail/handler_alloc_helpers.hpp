@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include "asio/detail/allocation_tracking.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/noncopyable.hpp"
 #include "asio/detail/recycling_allocator.hpp"
@@ -33,6 +34,7 @@ template <typename Handler>
 inline void* allocate(std::size_t s, Handler& h)
 {
 #if !defined(ASIO_HAS_HANDLER_HOOKS)
+  ASIO_HEAP_ALLOCATION(("handler", s));
   return ::operator new(s);
 #else
   using asio::asio_handler_allocate;
@@ -17,6 +17,7 @@
 
 #include "asio/detail/config.hpp"
 #include "asio/associated_executor.hpp"
+#include "asio/detail/executor_priority.hpp"
 #include "asio/detail/handler_invoke_helpers.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -51,10 +52,14 @@ public:
     ex.on_work_started();
   }
 
+  // Start work and queue the operation in the priority class of the handler's
+  // associated executor.
+  template <typename Operation>
   static void start(Handler& handler,
-      const IoExecutor& io_ex) ASIO_NOEXCEPT
+      const IoExecutor& io_ex, Operation& op) ASIO_NOEXCEPT
   {
     HandlerExecutor ex(asio::get_associated_executor(handler, io_ex));
+    op.priority(executor_priority<HandlerExecutor>::get(ex));
     ex.on_work_started();
     io_ex.on_work_started();
   }
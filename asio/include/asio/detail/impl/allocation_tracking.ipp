@@ -0,0 +1,134 @@
+//
+// detail/impl/allocation_tracking.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_ALLOCATION_TRACKING_IPP
+#define ASIO_DETAIL_IMPL_ALLOCATION_TRACKING_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_CUSTOM_ALLOCATION_TRACKING)
+
+// The allocation tracking implementation is provided by the user-specified
+// header.
+
+#elif defined(ASIO_ENABLE_ALLOCATION_TRACKING)
+
+#include <cstdio>
+#include <cstring>
+#include "asio/detail/allocation_tracking.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+allocation_tracking::tracking_state* allocation_tracking::get_state()
+{
+  static tracking_state* state = init_state();
+  return state;
+}
+
+allocation_tracking::tracking_state* allocation_tracking::init_state()
+{
+  static tracking_state state = { ASIO_STATIC_MUTEX_INIT, {}, 0 };
+  state.mutex_.init();
+  return &state;
+}
+
+void allocation_tracking::allocated(const char* site, std::size_t size)
+{
+  tracking_state* state = get_state();
+
+  static_mutex::scoped_lock lock(state->mutex_);
+  for (std::size_t i = 0; i < state->num_sites_; ++i)
+  {
+    site_count& s = state->sites_[i];
+    if (s.site == site || std::strcmp(s.site, site) == 0)
+    {
+      ++s.count;
+      s.bytes += size;
+      return;
+    }
+  }
+
+  // Sites beyond the maximum are counted together.
+  if (state->num_sites_ == max_sites)
+  {
+    site_count& s = state->sites_[max_sites - 1];
+    s.site = "other";
+    ++s.count;
+    s.bytes += size;
+    return;
+  }
+
+  site_count& s = state->sites_[state->num_sites_++];
+  s.site = site;
+  s.count = 1;
+  s.bytes = size;
+}
+
+void allocation_tracking::reset()
+{
+  tracking_state* state = get_state();
+
+  static_mutex::scoped_lock lock(state->mutex_);
+  state->num_sites_ = 0;
+}
+
+std::size_t allocation_tracking::count()
+{
+  tracking_state* state = get_state();
+
+  static_mutex::scoped_lock lock(state->mutex_);
+  std::size_t total = 0;
+  for (std::size_t i = 0; i < state->num_sites_; ++i)
+    total += state->sites_[i].count;
+  return total;
+}
+
+std::size_t allocation_tracking::count(const char* site)
+{
+  tracking_state* state = get_state();
+
+  static_mutex::scoped_lock lock(state->mutex_);
+  for (std::size_t i = 0; i < state->num_sites_; ++i)
+    if (std::strcmp(state->sites_[i].site, site) == 0)
+      return state->sites_[i].count;
+  return 0;
+}
+
+void allocation_tracking::report()
+{
+  using namespace std; // For fprintf.
+
+  tracking_state* state = get_state();
+
+  static_mutex::scoped_lock lock(state->mutex_);
+  for (std::size_t i = 0; i < state->num_sites_; ++i)
+  {
+    const site_count& s = state->sites_[i];
+    fprintf(stderr, "@asio|alloc|%.50s|%lu|%lu\n", s.site,
+        static_cast<unsigned long>(s.count),
+        static_cast<unsigned long>(s.bytes));
+  }
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_ENABLE_ALLOCATION_TRACKING)
+
+#endif // ASIO_DETAIL_IMPL_ALLOCATION_TRACKING_IPP
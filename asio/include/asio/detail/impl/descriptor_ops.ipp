@@ -18,12 +18,21 @@
 #include "asio/detail/config.hpp"
 #include <cerrno>
 #include "asio/detail/descriptor_ops.hpp"
+#include "asio/detail/socket_ops.hpp"
 #include "asio/error.hpp"
 
 #if !defined(ASIO_WINDOWS) \
   && !defined(ASIO_WINDOWS_RUNTIME) \
   && !defined(__CYGWIN__)
 
+#if defined(ASIO_HAS_SPLICE)
+# include <fcntl.h>
+#endif // defined(ASIO_HAS_SPLICE)
+
+#if defined(ASIO_HAS_SENDFILE)
+# include <sys/sendfile.h>
+#endif // defined(ASIO_HAS_SENDFILE)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -39,6 +48,16 @@ int open(const char* path, int flags, asio::error_code& ec)
   return result;
 }
 
+int open(const char* path, int flags,
+    unsigned mode, asio::error_code& ec)
+{
+  errno = 0;
+  int result = error_wrapper(::open(path, flags, mode), ec);
+  if (result >= 0)
+    ec = asio::error_code();
+  return result;
+}
+
 int close(int d, state_type& state, asio::error_code& ec)
 {
   int result = 0;
@@ -210,6 +229,85 @@ std::size_t sync_read(int d, state_type state, buf* bufs,
   }
 }
 
+// Wait for a descriptor to become ready for the given events, for no longer
+// than the given number of milliseconds.
+inline int poll_for(int d, short events, int msec, asio::error_code& ec)
+{
+  pollfd fds;
+  fds.fd = d;
+  fds.events = events;
+  fds.revents = 0;
+  errno = 0;
+  int result = error_wrapper(::poll(&fds, 1, msec < 0 ? 0 : msec), ec);
+  if (result == 0)
+    ec = asio::error::timed_out;
+  else if (result > 0)
+    ec = asio::error_code();
+  return result;
+}
+
+std::size_t sync_read_for(int d, state_type state, buf* bufs,
+    std::size_t count, bool all_empty, int msec, asio::error_code& ec)
+{
+  if (d == -1)
+  {
+    ec = asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // A request to read 0 bytes on a stream is a no-op.
+  if (all_empty)
+  {
+    ec = asio::error_code();
+    return 0;
+  }
+
+  // A descriptor in blocking mode is made non-blocking until the call
+  // returns, as a blocking read could not be bounded by the timeout.
+  if ((state & non_blocking) == 0)
+  {
+    if (!descriptor_ops::set_internal_non_blocking(d, state, true, ec))
+      return 0;
+    std::size_t bytes = descriptor_ops::sync_read_for(d, state,
+        bufs, count, all_empty, msec, ec);
+    asio::error_code ignored_ec;
+    descriptor_ops::set_internal_non_blocking(d, state, false, ignored_ec);
+    return bytes;
+  }
+
+  unsigned long start = socket_ops::monotonic_msec();
+
+  // Read some data.
+  for (;;)
+  {
+    errno = 0;
+    signed_size_type bytes = error_wrapper(::readv(
+          d, bufs, static_cast<int>(count)), ec);
+
+    // Check if operation succeeded.
+    if (bytes > 0)
+      return bytes;
+
+    // Check for EOF.
+    if (bytes == 0)
+    {
+      ec = asio::error::eof;
+      return 0;
+    }
+
+    // Operation failed.
+    if (ec != asio::error::would_block
+        && ec != asio::error::try_again)
+      return 0;
+
+    // Wait for descriptor to become ready, for no longer than the time that
+    // remains before the deadline.
+    if (descriptor_ops::poll_for(d, POLLIN,
+          socket_ops::remaining_msec(start, msec), ec) <= 0)
+      return 0;
+  }
+}
+
 bool non_blocking_read(int d, buf* bufs, std::size_t count,
     asio::error_code& ec, std::size_t& bytes_transferred)
 {
@@ -289,6 +387,61 @@ std::size_t sync_write(int d, state_type state, const buf* bufs,
   }
 }
 
+std::size_t sync_write_for(int d, state_type state, const buf* bufs,
+    std::size_t count, bool all_empty, int msec, asio::error_code& ec)
+{
+  if (d == -1)
+  {
+    ec = asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // A request to write 0 bytes to a stream is a no-op.
+  if (all_empty)
+  {
+    ec = asio::error_code();
+    return 0;
+  }
+
+  // A descriptor in blocking mode is made non-blocking until the call
+  // returns, as a blocking write could not be bounded by the timeout.
+  if ((state & non_blocking) == 0)
+  {
+    if (!descriptor_ops::set_internal_non_blocking(d, state, true, ec))
+      return 0;
+    std::size_t bytes = descriptor_ops::sync_write_for(d, state,
+        bufs, count, all_empty, msec, ec);
+    asio::error_code ignored_ec;
+    descriptor_ops::set_internal_non_blocking(d, state, false, ignored_ec);
+    return bytes;
+  }
+
+  unsigned long start = socket_ops::monotonic_msec();
+
+  // Write some data.
+  for (;;)
+  {
+    errno = 0;
+    signed_size_type bytes = error_wrapper(::writev(
+          d, bufs, static_cast<int>(count)), ec);
+
+    // Check if operation succeeded.
+    if (bytes > 0)
+      return bytes;
+
+    // Operation failed.
+    if (ec != asio::error::would_block
+        && ec != asio::error::try_again)
+      return 0;
+
+    // Wait for descriptor to become ready, for no longer than the time that
+    // remains before the deadline.
+    if (descriptor_ops::poll_for(d, POLLOUT,
+          socket_ops::remaining_msec(start, msec), ec) <= 0)
+      return 0;
+  }
+}
+
 bool non_blocking_write(int d, const buf* bufs, std::size_t count,
     asio::error_code& ec, std::size_t& bytes_transferred)
 {
@@ -321,6 +474,232 @@ bool non_blocking_write(int d, const buf* bufs, std::size_t count,
   }
 }
 
+std::size_t pread(int d, void* data, std::size_t size,
+    uint64_t offset, asio::error_code& ec)
+{
+  if (d == -1)
+  {
+    ec = asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // A request to read 0 bytes on a file is a no-op.
+  if (size == 0)
+  {
+    ec = asio::error_code();
+    return 0;
+  }
+
+  for (;;)
+  {
+    errno = 0;
+    signed_size_type bytes = error_wrapper(::pread(d, data, size,
+          static_cast<off_t>(offset)), ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check for EOF.
+    if (bytes == 0)
+    {
+      ec = asio::error::eof;
+      return 0;
+    }
+
+    if (bytes < 0)
+      return 0;
+
+    ec = asio::error_code();
+    return bytes;
+  }
+}
+
+#if defined(ASIO_HAS_FILE)
+
+std::size_t sync_read_at(int d, uint64_t offset, buf* bufs,
+    std::size_t count, bool all_empty, asio::error_code& ec)
+{
+  if (d == -1)
+  {
+    ec = asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // A request to read 0 bytes on a file is a no-op.
+  if (all_empty)
+  {
+    ec = asio::error_code();
+    return 0;
+  }
+
+  for (;;)
+  {
+    errno = 0;
+#if defined(__MACH__) && defined(__APPLE__)
+    // Older versions of Mac OS X do not have preadv, so only the first buffer
+    // is used. This is permitted as the operation may read fewer bytes.
+    signed_size_type bytes = error_wrapper(::pread(d, bufs[0].iov_base,
+          bufs[0].iov_len, static_cast<off_t>(offset)), ec);
+#else // defined(__MACH__) && defined(__APPLE__)
+    signed_size_type bytes = error_wrapper(::preadv(d, bufs,
+          static_cast<int>(count), static_cast<off_t>(offset)), ec);
+#endif // defined(__MACH__) && defined(__APPLE__)
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check for EOF.
+    if (bytes == 0)
+    {
+      ec = asio::error::eof;
+      return 0;
+    }
+
+    if (bytes < 0)
+      return 0;
+
+    ec = asio::error_code();
+    return bytes;
+  }
+}
+
+std::size_t sync_write_at(int d, uint64_t offset,
+    const buf* bufs, std::size_t count, bool all_empty,
+    asio::error_code& ec)
+{
+  if (d == -1)
+  {
+    ec = asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // A request to write 0 bytes to a file is a no-op.
+  if (all_empty)
+  {
+    ec = asio::error_code();
+    return 0;
+  }
+
+  for (;;)
+  {
+    errno = 0;
+#if defined(__MACH__) && defined(__APPLE__)
+    signed_size_type bytes = error_wrapper(::pwrite(d, bufs[0].iov_base,
+          bufs[0].iov_len, static_cast<off_t>(offset)), ec);
+#else // defined(__MACH__) && defined(__APPLE__)
+    signed_size_type bytes = error_wrapper(::pwritev(d, bufs,
+          static_cast<int>(count), static_cast<off_t>(offset)), ec);
+#endif // defined(__MACH__) && defined(__APPLE__)
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    if (bytes < 0)
+      return 0;
+
+    ec = asio::error_code();
+    return bytes;
+  }
+}
+
+#endif // defined(ASIO_HAS_FILE)
+
+#if defined(ASIO_HAS_SPLICE)
+
+int pipe(int descriptors[2], asio::error_code& ec)
+{
+  errno = 0;
+  int result = error_wrapper(
+      ::pipe2(descriptors, O_CLOEXEC | O_NONBLOCK), ec);
+  if (result == 0)
+    ec = asio::error_code();
+  return result;
+}
+
+bool non_blocking_splice(int in, int out, std::size_t size,
+    asio::error_code& ec, std::size_t& bytes_transferred)
+{
+  for (;;)
+  {
+    // Move some data.
+    errno = 0;
+    signed_size_type bytes = error_wrapper(::splice(in, 0, out, 0,
+          size, SPLICE_F_MOVE | SPLICE_F_NONBLOCK), ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      return false;
+
+    // Operation is complete.
+    if (bytes > 0)
+    {
+      ec = asio::error_code();
+      bytes_transferred = bytes;
+    }
+    else
+    {
+      if (bytes == 0)
+        ec = asio::error::eof;
+      bytes_transferred = 0;
+    }
+
+    return true;
+  }
+}
+
+#endif // defined(ASIO_HAS_SPLICE)
+
+#if defined(ASIO_HAS_SENDFILE)
+
+bool non_blocking_sendfile(int out, int in, uint64_t& offset,
+    std::size_t size, asio::error_code& ec,
+    std::size_t& bytes_transferred)
+{
+  for (;;)
+  {
+    // Send some data.
+    errno = 0;
+    off_t file_offset = static_cast<off_t>(offset);
+    signed_size_type bytes = error_wrapper(::sendfile(out, in,
+          &file_offset, size), ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      return false;
+
+    // Operation is complete.
+    if (bytes > 0)
+    {
+      ec = asio::error_code();
+      offset += bytes;
+      bytes_transferred = bytes;
+    }
+    else
+    {
+      if (bytes == 0)
+        ec = asio::error::eof;
+      bytes_transferred = 0;
+    }
+
+    return true;
+  }
+}
+
+#endif // defined(ASIO_HAS_SENDFILE)
+
 int ioctl(int d, state_type& state, long cmd,
     ioctl_arg_type* arg, asio::error_code& ec)
 {
@@ -35,7 +35,8 @@ dev_poll_reactor::dev_poll_reactor(asio::execution_context& ctx)
     mutex_(),
     dev_poll_fd_(do_dev_poll_create()),
     interrupter_(),
-    shutdown_(false)
+    shutdown_(false),
+    fork_mode_(fork_eager)
 {
   // Add the interrupter's descriptor to /dev/poll.
   ::pollfd ev = { 0, 0, 0 };
@@ -88,6 +89,22 @@ void dev_poll_reactor::notify_fork(
     ev.revents = 0;
     ::write(dev_poll_fd_, &ev, sizeof(ev));
 
+    // Descriptors are only registered while they have pending operations, so
+    // the lazy mode has nothing to defer. In the drop mode, the inherited
+    // operations are cancelled and their descriptors are not re-registered.
+    if (fork_mode_ == fork_drop)
+    {
+      op_queue<operation> ops;
+      for (int i = 0; i < max_ops; ++i)
+      {
+        reactor_op_queue<socket_type>::iterator iter = op_queue_[i].begin();
+        reactor_op_queue<socket_type>::iterator end = op_queue_[i].end();
+        while (iter != end)
+          op_queue_[i].cancel_operations(iter++, ops);
+      }
+      scheduler_.post_deferred_completions(ops);
+    }
+
     // Re-register all descriptors with /dev/poll. The changes will be written
     // to the /dev/poll descriptor the next time the reactor is run.
     for (int i = 0; i < max_ops; ++i)
@@ -201,6 +218,18 @@ void dev_poll_reactor::cancel_ops(socket_type descriptor,
   cancel_ops_unlocked(descriptor, asio::error::operation_aborted);
 }
 
+void dev_poll_reactor::cancel_ops_by_key(socket_type descriptor,
+    dev_poll_reactor::per_descriptor_data&, int op_type, void* cancellation_key)
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  op_queue<operation> ops;
+  bool need_interrupt = op_queue_[op_type].cancel_operations_by_key(
+      descriptor, ops, cancellation_key, asio::error::operation_aborted);
+  scheduler_.post_deferred_completions(ops);
+  if (need_interrupt)
+    interrupter_.interrupt();
+}
+
 void dev_poll_reactor::deregister_descriptor(socket_type descriptor,
     dev_poll_reactor::per_descriptor_data&, bool)
 {
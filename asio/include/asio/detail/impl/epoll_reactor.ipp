@@ -43,7 +43,9 @@ epoll_reactor::epoll_reactor(asio::execution_context& ctx)
     epoll_fd_(do_epoll_create()),
     timer_fd_(do_timerfd_create()),
     shutdown_(false),
-    registered_descriptors_mutex_(mutex_.enabled())
+    registered_descriptors_mutex_(mutex_.enabled()),
+    fork_mode_(fork_eager),
+    fork_generation_(0)
 {
   // Add the interrupter's descriptor to epoll.
   epoll_event ev = { 0, { 0 } };
@@ -124,11 +126,44 @@ void epoll_reactor::notify_fork(
 
     update_timeout();
 
-    // Re-register all descriptors with epoll.
+    // Re-register all descriptors with epoll. In the lazy and drop modes, a
+    // descriptor without pending operations is left out of the epoll set
+    // until the next operation is started on it. The generation check avoids
+    // writing to, and so copying, the pages holding those descriptors' state.
+    if (fork_mode_ != fork_eager)
+      ++fork_generation_;
+    op_queue<operation> ops;
     mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
     for (descriptor_state* state = registered_descriptors_.first();
         state != 0; state = state->next_)
     {
+      if (fork_mode_ != fork_eager)
+      {
+        if (state->shutdown_ || state->registered_events_ == 0)
+          continue;
+
+        bool has_pending_ops = false;
+        for (int i = 0; i < max_ops; ++i)
+        {
+          if (fork_mode_ == fork_drop)
+          {
+            while (reactor_op* op = state->op_queue_[i].front())
+            {
+              op->ec_ = asio::error::operation_aborted;
+              state->op_queue_[i].pop();
+              ops.push(op);
+            }
+          }
+          else if (!state->op_queue_[i].empty())
+            has_pending_ops = true;
+        }
+
+        if (!has_pending_ops)
+          continue;
+
+        state->fork_generation_ = fork_generation_;
+      }
+
       ev.events = state->registered_events_;
       ev.data.ptr = state;
       int result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, state->descriptor_, &ev);
@@ -139,6 +174,9 @@ void epoll_reactor::notify_fork(
         asio::detail::throw_error(ec, "epoll re-registration");
       }
     }
+    descriptors_lock.unlock();
+
+    scheduler_.post_deferred_completions(ops);
   }
 }
 
@@ -162,6 +200,7 @@ int epoll_reactor::register_descriptor(socket_type descriptor,
     descriptor_data->reactor_ = this;
     descriptor_data->descriptor_ = descriptor;
     descriptor_data->shutdown_ = false;
+    descriptor_data->fork_generation_ = fork_generation_;
     for (int i = 0; i < max_ops; ++i)
       descriptor_data->try_speculative_[i] = true;
   }
@@ -204,6 +243,7 @@ int epoll_reactor::register_internal_descriptor(
     descriptor_data->reactor_ = this;
     descriptor_data->descriptor_ = descriptor;
     descriptor_data->shutdown_ = false;
+    descriptor_data->fork_generation_ = fork_generation_;
     descriptor_data->op_queue_[op_type].push(op);
     for (int i = 0; i < max_ops; ++i)
       descriptor_data->try_speculative_[i] = true;
@@ -247,6 +287,17 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
     return;
   }
 
+  if (descriptor_data->fork_generation_ != fork_generation_)
+  {
+    if (int result = reregister_descriptor(descriptor_data))
+    {
+      op->ec_ = asio::error_code(result,
+          asio::error::get_system_category());
+      scheduler_.post_immediate_completion(op, is_continuation);
+      return;
+    }
+  }
+
   if (descriptor_data->op_queue_[op_type].empty())
   {
     if (allow_speculative
@@ -342,6 +393,35 @@ void epoll_reactor::cancel_ops(socket_type,
   scheduler_.post_deferred_completions(ops);
 }
 
+void epoll_reactor::cancel_ops_by_key(socket_type,
+    epoll_reactor::per_descriptor_data& descriptor_data,
+    int op_type, void* cancellation_key)
+{
+  if (!descriptor_data)
+    return;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  op_queue<operation> ops;
+  op_queue<reactor_op> other_ops;
+  while (reactor_op* op = descriptor_data->op_queue_[op_type].front())
+  {
+    descriptor_data->op_queue_[op_type].pop();
+    if (op->cancellation_key_ == cancellation_key)
+    {
+      op->ec_ = asio::error::operation_aborted;
+      ops.push(op);
+    }
+    else
+      other_ops.push(op);
+  }
+  descriptor_data->op_queue_[op_type].push(other_ops);
+
+  descriptor_lock.unlock();
+
+  scheduler_.post_deferred_completions(ops);
+}
+
 void epoll_reactor::deregister_descriptor(socket_type descriptor,
     epoll_reactor::per_descriptor_data& descriptor_data, bool closing)
 {
@@ -538,6 +618,7 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
       if (!ops.is_enqueued(descriptor_data))
       {
         descriptor_data->set_ready_events(events[i].events);
+        descriptor_data->update_priority();
         ops.push(descriptor_data);
       }
       else
@@ -550,17 +631,23 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
   if (check_timers)
   {
     mutex::scoped_lock common_lock(mutex_);
-    timer_queues_.get_ready_timers(ops);
 
 #if defined(ASIO_HAS_TIMERFD)
     if (timer_fd_ != -1)
     {
+      // Use a single reading of each timer queue's clock both to dequeue the
+      // ready timers and to rearm the timer descriptor.
       itimerspec new_timeout;
       itimerspec old_timeout;
-      int flags = get_timeout(new_timeout);
+      int flags = get_timeout(
+          timer_queues_.get_ready_timers_and_wait_duration_usec(
+            ops, 5 * 60 * 1000 * 1000), new_timeout);
       timerfd_settime(timer_fd_, flags, &new_timeout, &old_timeout);
+      return;
     }
 #endif // defined(ASIO_HAS_TIMERFD)
+
+    timer_queues_.get_ready_timers(ops);
   }
 }
 
@@ -621,6 +708,25 @@ int epoll_reactor::do_timerfd_create()
 #endif // defined(ASIO_HAS_TIMERFD)
 }
 
+int epoll_reactor::reregister_descriptor(
+    epoll_reactor::descriptor_state* descriptor_data)
+{
+  // Descriptors that are not supported by epoll were never in the set.
+  if (descriptor_data->registered_events_ != 0)
+  {
+    epoll_event ev = { 0, { 0 } };
+    ev.events = descriptor_data->registered_events_;
+    ev.data.ptr = descriptor_data;
+    int result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD,
+        descriptor_data->descriptor_, &ev);
+    if (result != 0 && errno != EEXIST)
+      return errno;
+  }
+
+  descriptor_data->fork_generation_ = fork_generation_;
+  return 0;
+}
+
 epoll_reactor::descriptor_state* epoll_reactor::allocate_descriptor_state()
 {
   mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
@@ -672,11 +778,16 @@ int epoll_reactor::get_timeout(int msec)
 
 #if defined(ASIO_HAS_TIMERFD)
 int epoll_reactor::get_timeout(itimerspec& ts)
+{
+  return get_timeout(
+      timer_queues_.wait_duration_usec(5 * 60 * 1000 * 1000), ts);
+}
+
+int epoll_reactor::get_timeout(long usec, itimerspec& ts)
 {
   ts.it_interval.tv_sec = 0;
   ts.it_interval.tv_nsec = 0;
 
-  long usec = timer_queues_.wait_duration_usec(5 * 60 * 1000 * 1000);
   ts.it_value.tv_sec = usec / 1000000;
   ts.it_value.tv_nsec = usec ? (usec % 1000000) * 1000 : 1;
 
@@ -723,6 +834,21 @@ epoll_reactor::descriptor_state::descriptor_state(bool locking)
 {
 }
 
+void epoll_reactor::descriptor_state::update_priority()
+{
+  // The first operation to complete is invoked directly from the descriptor
+  // state, so the descriptor state is queued in the highest priority class of
+  // the operations waiting on it. Otherwise a ready high priority operation
+  // would wait behind every normal handler that is already queued.
+  mutex::scoped_lock descriptor_lock(mutex_);
+  int highest = -1;
+  for (int j = 0; j < max_ops; ++j)
+    if (reactor_op* op = op_queue_[j].front())
+      if (op->priority() > highest)
+        highest = op->priority();
+  priority(highest < 0 ? static_cast<int>(normal_priority) : highest);
+}
+
 operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
 {
   mutex_.lock();
@@ -731,7 +857,9 @@ operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
 
   // Exception operations must be processed first to ensure that any
   // out-of-band data is read before normal data.
+  // The highest priority operation to complete is the one invoked directly.
   static const int flag[max_ops] = { EPOLLIN, EPOLLOUT, EPOLLPRI };
+  operation* first_op = 0;
   for (int j = max_ops - 1; j >= 0; --j)
   {
     if (events & (flag[j] | EPOLLERR | EPOLLHUP))
@@ -742,7 +870,15 @@ operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
         if (reactor_op::status status = op->perform())
         {
           op_queue_[j].pop();
-          io_cleanup.ops_.push(op);
+          if (first_op == 0)
+            first_op = op;
+          else if (op->priority() > first_op->priority())
+          {
+            io_cleanup.ops_.push(first_op);
+            first_op = op;
+          }
+          else
+            io_cleanup.ops_.push(op);
           if (status == reactor_op::done_and_exhausted)
           {
             try_speculative_[j] = false;
@@ -757,8 +893,7 @@ operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
 
   // The first operation will be returned for completion now. The others will
   // be posted for later by the io_cleanup object's destructor.
-  io_cleanup.first_op_ = io_cleanup.ops_.front();
-  io_cleanup.ops_.pop();
+  io_cleanup.first_op_ = first_op;
   return io_cleanup.first_op_;
 }
 
@@ -47,7 +47,8 @@ kqueue_reactor::kqueue_reactor(asio::execution_context& ctx)
     kqueue_fd_(do_kqueue_create()),
     interrupter_(),
     shutdown_(false),
-    registered_descriptors_mutex_(mutex_.enabled())
+    registered_descriptors_mutex_(mutex_.enabled()),
+    fork_mode_(fork_eager)
 {
   struct kevent events[1];
   ASIO_KQUEUE_EV_SET(&events[0], interrupter_.read_descriptor(),
@@ -107,11 +108,44 @@ void kqueue_reactor::notify_fork(
       asio::detail::throw_error(ec, "kqueue interrupter registration");
     }
 
-    // Re-register all descriptors with kqueue.
+    // Re-register all descriptors with kqueue. In the lazy and drop modes, a
+    // descriptor without pending operations has its kevent count reset so
+    // that its events are added when the next operation needs to wait.
+    op_queue<operation> ops;
     mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
     for (descriptor_state* state = registered_descriptors_.first();
         state != 0; state = state->next_)
     {
+      if (fork_mode_ != fork_eager)
+      {
+        mutex::scoped_lock descriptor_lock(state->mutex_);
+
+        if (state->shutdown_)
+          continue;
+
+        bool has_pending_ops = false;
+        for (int i = 0; i < max_ops; ++i)
+        {
+          if (fork_mode_ == fork_drop)
+          {
+            while (reactor_op* op = state->op_queue_[i].front())
+            {
+              op->ec_ = asio::error::operation_aborted;
+              state->op_queue_[i].pop();
+              ops.push(op);
+            }
+          }
+          else if (!state->op_queue_[i].empty())
+            has_pending_ops = true;
+        }
+
+        if (!has_pending_ops)
+        {
+          state->num_kevents_ = 0;
+          continue;
+        }
+      }
+
       if (state->num_kevents_ > 0)
       {
         ASIO_KQUEUE_EV_SET(&events[0], state->descriptor_,
@@ -126,6 +160,9 @@ void kqueue_reactor::notify_fork(
         }
       }
     }
+    descriptors_lock.unlock();
+
+    scheduler_.post_deferred_completions(ops);
   }
 }
 
@@ -282,6 +319,35 @@ void kqueue_reactor::cancel_ops(socket_type,
   scheduler_.post_deferred_completions(ops);
 }
 
+void kqueue_reactor::cancel_ops_by_key(socket_type,
+    kqueue_reactor::per_descriptor_data& descriptor_data,
+    int op_type, void* cancellation_key)
+{
+  if (!descriptor_data)
+    return;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  op_queue<operation> ops;
+  op_queue<reactor_op> other_ops;
+  while (reactor_op* op = descriptor_data->op_queue_[op_type].front())
+  {
+    descriptor_data->op_queue_[op_type].pop();
+    if (op->cancellation_key_ == cancellation_key)
+    {
+      op->ec_ = asio::error::operation_aborted;
+      ops.push(op);
+    }
+    else
+      other_ops.push(op);
+  }
+  descriptor_data->op_queue_[op_type].push(other_ops);
+
+  descriptor_lock.unlock();
+
+  scheduler_.post_deferred_completions(ops);
+}
+
 void kqueue_reactor::deregister_descriptor(socket_type descriptor,
     kqueue_reactor::per_descriptor_data& descriptor_data, bool closing)
 {
@@ -0,0 +1,664 @@
+//
+// detail/impl/posix_file_service.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_POSIX_FILE_SERVICE_IPP
+#define ASIO_DETAIL_IMPL_POSIX_FILE_SERVICE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_FILE)
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "asio/error.hpp"
+#include "asio/detail/posix_file_service.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+class posix_file_service::worker_function
+{
+public:
+  explicit worker_function(posix_file_service* service)
+    : service_(service)
+  {
+  }
+
+  void operator()()
+  {
+    service_->run_worker();
+  }
+
+private:
+  posix_file_service* service_;
+};
+
+posix_file_service::posix_file_service(execution_context& context)
+  : execution_context_service_base<posix_file_service>(context),
+    scheduler_(asio::use_service<scheduler>(context)),
+    in_flight_waiters_(0),
+    num_threads_(0),
+    idle_threads_(0),
+    stopped_(false),
+    shutdown_(false)
+{
+  for (std::size_t i = 0; i < max_threads; ++i)
+  {
+    in_flight_[i].descriptor_ = -1;
+    in_flight_[i].is_stream_ = false;
+  }
+}
+
+posix_file_service::~posix_file_service()
+{
+  stop_workers();
+}
+
+void posix_file_service::shutdown()
+{
+  stop_workers();
+
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  shutdown_ = true;
+  op_queue<operation> ops;
+  ops.push(queue_);
+  lock.unlock();
+
+  scheduler_.abandon_operations(ops);
+}
+
+void posix_file_service::notify_fork(execution_context::fork_event fork_ev)
+{
+  if (fork_ev == execution_context::fork_prepare)
+  {
+    stop_workers();
+  }
+  else
+  {
+    // Threads are restarted on demand, but any operations that were queued
+    // across the fork need a worker now.
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    stopped_ = false;
+    if (!queue_.empty())
+      maybe_start_worker();
+  }
+}
+
+void posix_file_service::construct(
+    posix_file_service::implementation_type& impl)
+{
+  impl.descriptor_ = -1;
+  impl.is_stream_ = false;
+  impl.next_read_offset_ = 0;
+  impl.read_ahead_size_ = 0;
+}
+
+void posix_file_service::move_construct(
+    posix_file_service::implementation_type& impl,
+    posix_file_service::implementation_type& other_impl)
+{
+  impl.descriptor_ = other_impl.descriptor_;
+  other_impl.descriptor_ = -1;
+
+  impl.is_stream_ = other_impl.is_stream_;
+  impl.next_read_offset_ = other_impl.next_read_offset_;
+  impl.read_ahead_size_ = other_impl.read_ahead_size_;
+}
+
+void posix_file_service::move_assign(
+    posix_file_service::implementation_type& impl,
+    posix_file_service& /*other_service*/,
+    posix_file_service::implementation_type& other_impl)
+{
+  asio::error_code ignored_ec;
+  close(impl, ignored_ec);
+
+  impl.descriptor_ = other_impl.descriptor_;
+  other_impl.descriptor_ = -1;
+
+  impl.is_stream_ = other_impl.is_stream_;
+  impl.next_read_offset_ = other_impl.next_read_offset_;
+  impl.read_ahead_size_ = other_impl.read_ahead_size_;
+}
+
+void posix_file_service::destroy(
+    posix_file_service::implementation_type& impl)
+{
+  asio::error_code ignored_ec;
+  close(impl, ignored_ec);
+}
+
+asio::error_code posix_file_service::open(
+    posix_file_service::implementation_type& impl,
+    const char* path, file_base::flags open_flags,
+    asio::error_code& ec)
+{
+  if (is_open(impl))
+  {
+    ec = asio::error::already_open;
+    return ec;
+  }
+
+  int fd = descriptor_ops::open(path,
+      static_cast<int>(open_flags), 0666, ec);
+  if (fd < 0)
+    return ec;
+
+  // We're done. Take ownership of the descriptor.
+  impl.descriptor_ = fd;
+  impl.next_read_offset_ = 0;
+  impl.read_ahead_size_ = 0;
+
+#if defined(POSIX_FADV_SEQUENTIAL)
+  // Stream files are read from start to end, so ask the kernel for a larger
+  // read-ahead window.
+  if (impl.is_stream_)
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif // defined(POSIX_FADV_SEQUENTIAL)
+
+  ec = asio::error_code();
+  return ec;
+}
+
+asio::error_code posix_file_service::assign(
+    posix_file_service::implementation_type& impl,
+    const native_handle_type& native_descriptor,
+    asio::error_code& ec)
+{
+  if (is_open(impl))
+  {
+    ec = asio::error::already_open;
+    return ec;
+  }
+
+  impl.descriptor_ = native_descriptor;
+  impl.next_read_offset_ = 0;
+  impl.read_ahead_size_ = 0;
+  ec = asio::error_code();
+  return ec;
+}
+
+asio::error_code posix_file_service::close(
+    posix_file_service::implementation_type& impl,
+    asio::error_code& ec)
+{
+  if (is_open(impl))
+  {
+    ASIO_HANDLER_OPERATION((scheduler_.context(),
+          "file", &impl, impl.descriptor_, "close"));
+
+    cancel_and_wait_ops(impl.descriptor_);
+
+    descriptor_ops::state_type state = 0;
+    descriptor_ops::close(impl.descriptor_, state, ec);
+    impl.descriptor_ = -1;
+  }
+  else
+  {
+    ec = asio::error_code();
+  }
+
+  return ec;
+}
+
+posix_file_service::native_handle_type posix_file_service::release(
+    posix_file_service::implementation_type& impl,
+    asio::error_code& ec)
+{
+  native_handle_type descriptor = impl.descriptor_;
+  if (is_open(impl))
+  {
+    ASIO_HANDLER_OPERATION((scheduler_.context(),
+          "file", &impl, impl.descriptor_, "release"));
+
+    cancel_and_wait_ops(impl.descriptor_);
+    impl.descriptor_ = -1;
+  }
+
+  ec = asio::error_code();
+  return descriptor;
+}
+
+asio::error_code posix_file_service::cancel(
+    posix_file_service::implementation_type& impl,
+    asio::error_code& ec)
+{
+  if (!is_open(impl))
+  {
+    ec = asio::error::bad_descriptor;
+    return ec;
+  }
+
+  ASIO_HANDLER_OPERATION((scheduler_.context(),
+        "file", &impl, impl.descriptor_, "cancel"));
+
+  cancel_ops(impl.descriptor_);
+  ec = asio::error_code();
+  return ec;
+}
+
+uint64_t posix_file_service::size(
+    const posix_file_service::implementation_type& impl,
+    asio::error_code& ec) const
+{
+  struct stat s;
+  errno = 0;
+  int result = descriptor_ops::error_wrapper(
+      ::fstat(native_handle(impl), &s), ec);
+  if (result != 0)
+    return 0;
+
+  ec = asio::error_code();
+  return static_cast<uint64_t>(s.st_size);
+}
+
+asio::error_code posix_file_service::resize(
+    posix_file_service::implementation_type& impl,
+    uint64_t n, asio::error_code& ec)
+{
+  errno = 0;
+  int result = descriptor_ops::error_wrapper(::ftruncate(
+        native_handle(impl), static_cast<off_t>(n)), ec);
+  if (result == 0)
+    ec = asio::error_code();
+  return ec;
+}
+
+asio::error_code posix_file_service::sync_all(
+    posix_file_service::implementation_type& impl,
+    asio::error_code& ec)
+{
+  errno = 0;
+  int result = descriptor_ops::error_wrapper(
+      ::fsync(native_handle(impl)), ec);
+  if (result == 0)
+    ec = asio::error_code();
+  return ec;
+}
+
+asio::error_code posix_file_service::sync_data(
+    posix_file_service::implementation_type& impl,
+    asio::error_code& ec)
+{
+  errno = 0;
+#if defined(_POSIX_SYNCHRONIZED_IO) && (_POSIX_SYNCHRONIZED_IO > 0)
+  int result = descriptor_ops::error_wrapper(
+      ::fdatasync(native_handle(impl)), ec);
+#else // defined(_POSIX_SYNCHRONIZED_IO) && (_POSIX_SYNCHRONIZED_IO > 0)
+  int result = descriptor_ops::error_wrapper(
+      ::fsync(native_handle(impl)), ec);
+#endif // defined(_POSIX_SYNCHRONIZED_IO) && (_POSIX_SYNCHRONIZED_IO > 0)
+  if (result == 0)
+    ec = asio::error_code();
+  return ec;
+}
+
+uint64_t posix_file_service::seek(
+    posix_file_service::implementation_type& impl, int64_t offset,
+    file_base::seek_basis whence, asio::error_code& ec)
+{
+  errno = 0;
+  off_t result = descriptor_ops::error_wrapper(::lseek(native_handle(impl),
+        static_cast<off_t>(offset), static_cast<int>(whence)), ec);
+  if (result < 0)
+    return 0;
+
+  ec = asio::error_code();
+  return static_cast<uint64_t>(result);
+}
+
+std::size_t posix_file_service::update_read_ahead(
+    posix_file_service::implementation_type& impl,
+    uint64_t offset, std::size_t size)
+{
+  // Grow the window while reads continue on from one another, in the same way
+  // as the kernel does for reads that use the file position.
+  if (offset == impl.next_read_offset_ && size > 0)
+  {
+    if (impl.read_ahead_size_ == 0)
+      impl.read_ahead_size_ = min_read_ahead;
+    else if (impl.read_ahead_size_ < max_read_ahead)
+      impl.read_ahead_size_ *= 2;
+  }
+  else
+  {
+    impl.read_ahead_size_ = 0;
+  }
+
+  impl.next_read_offset_ = offset + size;
+  return impl.read_ahead_size_;
+}
+
+void posix_file_service::advise_read_ahead(int descriptor,
+    uint64_t offset, std::size_t size)
+{
+#if defined(POSIX_FADV_WILLNEED)
+  if (size > 0)
+  {
+    ::posix_fadvise(descriptor, static_cast<off_t>(offset),
+        static_cast<off_t>(size), POSIX_FADV_WILLNEED);
+  }
+#else // defined(POSIX_FADV_WILLNEED)
+  (void)descriptor;
+  (void)offset;
+  (void)size;
+#endif // defined(POSIX_FADV_WILLNEED)
+}
+
+void posix_file_service::start_op(posix_file_op* op)
+{
+#if defined(ASIO_HAS_THREADS)
+  if (ASIO_CONCURRENCY_HINT_IS_LOCKING(SCHEDULER,
+        scheduler_.concurrency_hint()))
+  {
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    if (shutdown_)
+    {
+      lock.unlock();
+      scheduler_.post_immediate_completion(op, false);
+      return;
+    }
+
+    // Start a worker first, so that if it cannot be created the operation is
+    // neither queued nor counted as outstanding work.
+    if (!stopped_)
+      maybe_start_worker();
+
+    scheduler_.work_started();
+    queue_.push(op);
+    event_.unlock_and_signal_one(lock);
+    return;
+  }
+#endif // defined(ASIO_HAS_THREADS)
+
+  // Without threads, or without locking so that worker threads could post
+  // completions, the operation is performed in the calling thread.
+  perform_op(op);
+  scheduler_.post_immediate_completion(op, false);
+}
+
+void posix_file_service::cancel_ops(int descriptor)
+{
+  op_queue<operation> ops;
+  op_queue<posix_file_op> other_ops;
+
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  while (posix_file_op* op = queue_.front())
+  {
+    queue_.pop();
+    if (op->descriptor_ == descriptor)
+    {
+      op->ec_ = asio::error::operation_aborted;
+      ops.push(op);
+    }
+    else
+    {
+      other_ops.push(op);
+    }
+  }
+  queue_.push(other_ops);
+  lock.unlock();
+
+  scheduler_.post_deferred_completions(ops);
+}
+
+void posix_file_service::cancel_and_wait_ops(int descriptor)
+{
+  cancel_ops(descriptor);
+
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  while (is_in_flight(descriptor, false))
+  {
+    ++in_flight_waiters_;
+    in_flight_event_.clear(lock);
+    in_flight_event_.wait(lock);
+    --in_flight_waiters_;
+  }
+}
+
+void posix_file_service::run_worker()
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  for (;;)
+  {
+    op_queue<posix_file_op> batch;
+    while (!stopped_ && !dequeue_batch(batch))
+    {
+      ++idle_threads_;
+      event_.clear(lock);
+      event_.wait(lock);
+      --idle_threads_;
+    }
+
+    if (batch.empty())
+      return;
+
+    // Record the batch, so that its descriptor is not closed and no other
+    // stream operation on the file is started until it has finished.
+    std::size_t slot = 0;
+    while (in_flight_[slot].descriptor_ != -1)
+      ++slot;
+    in_flight_[slot].descriptor_ = batch.front()->descriptor_;
+    in_flight_[slot].is_stream_ = !batch.front()->is_positional_;
+
+    // Let another worker take any remaining operations.
+    if (!queue_.empty())
+      event_.unlock_and_signal_one(lock);
+    else
+      lock.unlock();
+
+    perform_batch(batch);
+
+    op_queue<operation> ops;
+    ops.push(batch);
+    scheduler_.post_deferred_completions(ops);
+
+    lock.lock();
+    in_flight_[slot].descriptor_ = -1;
+    in_flight_[slot].is_stream_ = false;
+    if (in_flight_waiters_ > 0)
+      in_flight_event_.signal_all(lock);
+  }
+}
+
+bool posix_file_service::dequeue_batch(op_queue<posix_file_op>& batch)
+{
+  // Find the first operation that may be started. An operation that uses the
+  // file position must wait for the file's previous one to finish. Skipping
+  // it leaves it at the front of any later operations on the same file, so
+  // that they are still performed in order.
+  posix_file_op* first = 0;
+  op_queue<posix_file_op> other_ops;
+  while (posix_file_op* op = queue_.front())
+  {
+    queue_.pop();
+    if (!first && (op->is_positional_ || !is_in_flight(op->descriptor_, true)))
+      first = op;
+    else
+      other_ops.push(op);
+  }
+  queue_.push(other_ops);
+
+  if (!first)
+    return false;
+
+  batch.push(first);
+
+  if (!first->is_positional_ || first->total_size_ == 0)
+    return true;
+
+  // Collect queued operations that continue on from the end of the batch.
+  uint64_t end = first->offset_ + first->total_size_;
+  std::size_t count = first->count_;
+  while (posix_file_op* op = queue_.front())
+  {
+    queue_.pop();
+    if (op->descriptor_ == first->descriptor_
+        && op->is_positional_
+        && op->is_write_ == first->is_write_
+        && op->offset_ == end
+        && op->total_size_ > 0
+        && count + op->count_ <= max_batch_buffers)
+    {
+      end += op->total_size_;
+      count += op->count_;
+      batch.push(op);
+    }
+    else
+    {
+      other_ops.push(op);
+    }
+  }
+  queue_.push(other_ops);
+  return true;
+}
+
+bool posix_file_service::is_in_flight(int descriptor, bool stream_only) const
+{
+  for (std::size_t i = 0; i < max_threads; ++i)
+    if (in_flight_[i].descriptor_ == descriptor
+        && (in_flight_[i].is_stream_ || !stream_only))
+      return true;
+  return false;
+}
+
+void posix_file_service::perform_op(posix_file_op* op)
+{
+  bool all_empty = (op->total_size_ == 0);
+  if (op->is_positional_)
+  {
+    if (op->is_write_)
+    {
+      op->bytes_transferred_ = descriptor_ops::sync_write_at(op->descriptor_,
+          op->offset_, op->bufs_, op->count_, all_empty, op->ec_);
+    }
+    else
+    {
+      op->bytes_transferred_ = descriptor_ops::sync_read_at(op->descriptor_,
+          op->offset_, op->bufs_, op->count_, all_empty, op->ec_);
+      if (op->bytes_transferred_ > 0)
+      {
+        advise_read_ahead(op->descriptor_,
+            op->offset_ + op->bytes_transferred_, op->read_ahead_);
+      }
+    }
+  }
+  else
+  {
+    if (op->is_write_)
+    {
+      op->bytes_transferred_ = descriptor_ops::sync_write(op->descriptor_,
+          0, op->bufs_, op->count_, all_empty, op->ec_);
+    }
+    else
+    {
+      op->bytes_transferred_ = descriptor_ops::sync_read(op->descriptor_,
+          0, op->bufs_, op->count_, all_empty, op->ec_);
+    }
+  }
+}
+
+void posix_file_service::perform_batch(op_queue<posix_file_op>& batch)
+{
+  posix_file_op* first = batch.front();
+  if (op_queue_access::next(first) == 0)
+  {
+    perform_op(first);
+    return;
+  }
+
+  // Gather the buffers of all operations into a single vectored call.
+  descriptor_ops::buf bufs[max_batch_buffers];
+  std::size_t count = 0;
+  std::size_t read_ahead = 0;
+  for (posix_file_op* op = first; op; op = op_queue_access::next(op))
+  {
+    for (std::size_t i = 0; i < op->count_; ++i)
+      bufs[count++] = op->bufs_[i];
+    if (op->read_ahead_ > read_ahead)
+      read_ahead = op->read_ahead_;
+  }
+
+  asio::error_code ec;
+  std::size_t n;
+  if (first->is_write_)
+  {
+    n = descriptor_ops::sync_write_at(first->descriptor_,
+        first->offset_, bufs, count, false, ec);
+  }
+  else
+  {
+    n = descriptor_ops::sync_read_at(first->descriptor_,
+        first->offset_, bufs, count, false, ec);
+    if (n > 0)
+      advise_read_ahead(first->descriptor_, first->offset_ + n, read_ahead);
+  }
+
+  // Share the result out between the operations in order. An error applies to
+  // every operation in the batch. Operations that were not reached by a short
+  // transfer are performed on their own, so that they see the correct result.
+  for (posix_file_op* op = first; op; op = op_queue_access::next(op))
+  {
+    if (ec)
+    {
+      op->ec_ = ec;
+      op->bytes_transferred_ = 0;
+    }
+    else if (n > 0)
+    {
+      op->ec_ = asio::error_code();
+      op->bytes_transferred_ = n < op->total_size_ ? n : op->total_size_;
+      n -= op->bytes_transferred_;
+    }
+    else
+    {
+      perform_op(op);
+    }
+  }
+}
+
+void posix_file_service::maybe_start_worker()
+{
+  if (idle_threads_ == 0 && num_threads_ < max_threads)
+  {
+    threads_.create_thread(worker_function(this));
+    ++num_threads_;
+  }
+}
+
+void posix_file_service::stop_workers()
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  stopped_ = true;
+  event_.signal_all(lock);
+  lock.unlock();
+
+  threads_.join();
+
+  lock.lock();
+  num_threads_ = 0;
+  idle_threads_ = 0;
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_FILE)
+
+#endif // ASIO_DETAIL_IMPL_POSIX_FILE_SERVICE_IPP
@@ -61,7 +61,8 @@ select_reactor::select_reactor(asio::execution_context& ctx)
     stop_thread_(false),
     thread_(0),
 #endif // defined(ASIO_HAS_IOCP)
-    shutdown_(false)
+    shutdown_(false),
+    fork_mode_(fork_eager)
 {
 #if defined(ASIO_HAS_IOCP)
   asio::detail::signal_blocker sb;
@@ -107,7 +108,27 @@ void select_reactor::notify_fork(
     asio::execution_context::fork_event fork_ev)
 {
   if (fork_ev == asio::execution_context::fork_child)
+  {
     interrupter_.recreate();
+
+    // Descriptors are only passed to select while they have pending
+    // operations, so there are no registrations to restore. In the drop mode,
+    // the inherited operations are cancelled.
+    if (fork_mode_ == fork_drop)
+    {
+      asio::detail::mutex::scoped_lock lock(mutex_);
+      op_queue<operation> ops;
+      for (int i = 0; i < max_ops; ++i)
+      {
+        reactor_op_queue<socket_type>::iterator iter = op_queue_[i].begin();
+        reactor_op_queue<socket_type>::iterator end = op_queue_[i].end();
+        while (iter != end)
+          op_queue_[i].cancel_operations(iter++, ops);
+      }
+      lock.unlock();
+      scheduler_.post_deferred_completions(ops);
+    }
+  }
 }
 
 void select_reactor::init_task()
@@ -164,6 +185,18 @@ void select_reactor::cancel_ops(socket_type descriptor,
   cancel_ops_unlocked(descriptor, asio::error::operation_aborted);
 }
 
+void select_reactor::cancel_ops_by_key(socket_type descriptor,
+    select_reactor::per_descriptor_data&, int op_type, void* cancellation_key)
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  op_queue<operation> ops;
+  bool need_interrupt = op_queue_[op_type].cancel_operations_by_key(
+      descriptor, ops, cancellation_key, asio::error::operation_aborted);
+  scheduler_.post_deferred_completions(ops);
+  if (need_interrupt)
+    interrupter_.interrupt();
+}
+
 void select_reactor::deregister_descriptor(socket_type descriptor,
     select_reactor::per_descriptor_data&, bool)
 {
@@ -33,6 +33,10 @@
 # include <string>
 #endif // defined(ASIO_WINDOWS_RUNTIME)
 
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+# include <time.h>
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
 #if defined(ASIO_WINDOWS) || defined(__CYGWIN__) \
   || defined(__MACH__) && defined(__APPLE__)
 # if defined(ASIO_HAS_PTHREADS)
@@ -835,6 +839,77 @@ size_t sync_recv(socket_type s, state_type state, buf* bufs,
   }
 }
 
+size_t sync_recv_for(socket_type s, state_type state, buf* bufs,
+    size_t count, int flags, bool all_empty, int msec, asio::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // A request to read 0 bytes on a stream is a no-op.
+  if (all_empty && (state & stream_oriented))
+  {
+    ec = asio::error_code();
+    return 0;
+  }
+
+  // The read must not block, as it could not then be bounded by the timeout.
+  // Where possible this is requested for the call alone. Otherwise a socket
+  // in blocking mode is made non-blocking until the call returns.
+#if defined(MSG_DONTWAIT)
+  flags |= MSG_DONTWAIT;
+#else // defined(MSG_DONTWAIT)
+  if ((state & non_blocking) == 0)
+  {
+    if (!socket_ops::set_internal_non_blocking(s, state, true, ec))
+      return 0;
+    size_t bytes = socket_ops::sync_recv_for(s, state,
+        bufs, count, flags, all_empty, msec, ec);
+    asio::error_code ignored_ec;
+    socket_ops::set_internal_non_blocking(s, state, false, ignored_ec);
+    return bytes;
+  }
+#endif // defined(MSG_DONTWAIT)
+
+  unsigned long start = socket_ops::monotonic_msec();
+
+  // Read some data.
+  for (;;)
+  {
+    signed_size_type bytes = socket_ops::recv(s, bufs, count, flags, ec);
+
+    // Check if operation succeeded.
+    if (bytes > 0)
+      return bytes;
+
+    // Check for EOF.
+    if ((state & stream_oriented) && bytes == 0)
+    {
+      ec = asio::error::eof;
+      return 0;
+    }
+
+    // Operation failed.
+    if (ec != asio::error::would_block
+        && ec != asio::error::try_again)
+      return 0;
+
+    // Wait for socket to become ready, for no longer than the time that
+    // remains before the deadline.
+    int result = socket_ops::poll_read(s, 0,
+        socket_ops::remaining_msec(start, msec), ec);
+    if (result < 0)
+      return 0;
+    if (result == 0)
+    {
+      ec = asio::error::timed_out;
+      return 0;
+    }
+  }
+}
+
 #if defined(ASIO_HAS_IOCP)
 
 void complete_iocp_recv(state_type state,
@@ -1228,6 +1303,70 @@ size_t sync_send(socket_type s, state_type state, const buf* bufs,
   }
 }
 
+size_t sync_send_for(socket_type s, state_type state, const buf* bufs,
+    size_t count, int flags, bool all_empty, int msec, asio::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // A request to write 0 bytes to a stream is a no-op.
+  if (all_empty && (state & stream_oriented))
+  {
+    ec = asio::error_code();
+    return 0;
+  }
+
+  // The write must not block, as it could not then be bounded by the timeout.
+  // Where possible this is requested for the call alone. Otherwise a socket
+  // in blocking mode is made non-blocking until the call returns.
+#if defined(MSG_DONTWAIT)
+  flags |= MSG_DONTWAIT;
+#else // defined(MSG_DONTWAIT)
+  if ((state & non_blocking) == 0)
+  {
+    if (!socket_ops::set_internal_non_blocking(s, state, true, ec))
+      return 0;
+    size_t bytes = socket_ops::sync_send_for(s, state,
+        bufs, count, flags, all_empty, msec, ec);
+    asio::error_code ignored_ec;
+    socket_ops::set_internal_non_blocking(s, state, false, ignored_ec);
+    return bytes;
+  }
+#endif // defined(MSG_DONTWAIT)
+
+  unsigned long start = socket_ops::monotonic_msec();
+
+  // Write some data.
+  for (;;)
+  {
+    signed_size_type bytes = socket_ops::send(s, bufs, count, flags, ec);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+      return bytes;
+
+    // Operation failed.
+    if (ec != asio::error::would_block
+        && ec != asio::error::try_again)
+      return 0;
+
+    // Wait for socket to become ready, for no longer than the time that
+    // remains before the deadline.
+    int result = socket_ops::poll_write(s, 0,
+        socket_ops::remaining_msec(start, msec), ec);
+    if (result < 0)
+      return 0;
+    if (result == 0)
+    {
+      ec = asio::error::timed_out;
+      return 0;
+    }
+  }
+}
+
 #if defined(ASIO_HAS_IOCP)
 
 void complete_iocp_send(
@@ -1389,6 +1528,98 @@ bool non_blocking_sendto(socket_type s,
 
 #endif // !defined(ASIO_HAS_IOCP)
 
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+
+signed_size_type send_with_fds(socket_type s, const buf* bufs, size_t count,
+    const int* fds, size_t fd_count, int flags, asio::error_code& ec)
+{
+  if (fd_count > max_fds_per_message)
+  {
+    ec = asio::error::invalid_argument;
+    return socket_error_retval;
+  }
+
+  union
+  {
+    cmsghdr header;
+    char buffer[CMSG_SPACE(sizeof(int) * max_fds_per_message)];
+  } control;
+
+  clear_last_error();
+  msghdr msg = msghdr();
+  msg.msg_iov = const_cast<buf*>(bufs);
+  msg.msg_iovlen = static_cast<int>(count);
+  if (fd_count > 0)
+  {
+    msg.msg_control = control.buffer;
+    msg.msg_controllen = CMSG_SPACE(sizeof(int) * fd_count);
+    std::memset(control.buffer, 0, msg.msg_controllen);
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * fd_count);
+    std::memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * fd_count);
+  }
+#if defined(__linux__)
+  flags |= MSG_NOSIGNAL;
+#endif // defined(__linux__)
+  signed_size_type result = error_wrapper(::sendmsg(s, &msg, flags), ec);
+  if (result >= 0)
+    ec = asio::error_code();
+  return result;
+}
+
+signed_size_type recv_with_fds(socket_type s, buf* bufs, size_t count,
+    int* fds, size_t& fd_count, int flags, asio::error_code& ec)
+{
+  union
+  {
+    cmsghdr header;
+    char buffer[CMSG_SPACE(sizeof(int) * max_fds_per_message)];
+  } control;
+
+  clear_last_error();
+  fd_count = 0;
+  msghdr msg = msghdr();
+  msg.msg_iov = bufs;
+  msg.msg_iovlen = static_cast<int>(count);
+  msg.msg_control = control.buffer;
+  msg.msg_controllen = sizeof(control.buffer);
+#if defined(MSG_CMSG_CLOEXEC)
+  flags |= MSG_CMSG_CLOEXEC;
+#endif // defined(MSG_CMSG_CLOEXEC)
+  signed_size_type result = error_wrapper(::recvmsg(s, &msg, flags), ec);
+  if (result < 0)
+    return result;
+
+  // The kernel discards any descriptors that do not fit in the control buffer,
+  // so a truncated set is not handed to the caller. Every descriptor that the
+  // caller does not receive must be closed here, or it would leak.
+  const bool truncated = (msg.msg_flags & MSG_CTRUNC) != 0;
+  ec = truncated ? asio::error::message_size : asio::error_code();
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != 0;
+      cmsg = CMSG_NXTHDR(&msg, cmsg))
+  {
+    if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+    {
+      size_t n = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+      for (size_t i = 0; i < n; ++i)
+      {
+        int fd;
+        std::memcpy(&fd, CMSG_DATA(cmsg) + sizeof(int) * i, sizeof(int));
+        if (!truncated && fd_count < max_fds_per_message)
+          fds[fd_count++] = fd;
+        else
+          ::close(fd);
+      }
+    }
+  }
+
+  return result;
+}
+
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+
 socket_type socket(int af, int type, int protocol,
     asio::error_code& ec)
 {
@@ -1802,6 +2033,35 @@ int select(int nfds, fd_set* readfds, fd_set* writefds,
 #endif
 }
 
+unsigned long monotonic_msec()
+{
+#if defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+  return static_cast<unsigned long>(::GetTickCount());
+#elif defined(CLOCK_MONOTONIC)
+  timespec ts;
+  ::clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<unsigned long>(ts.tv_sec) * 1000
+    + static_cast<unsigned long>(ts.tv_nsec / 1000000);
+#else // defined(CLOCK_MONOTONIC)
+  timeval tv;
+  ::gettimeofday(&tv, 0);
+  return static_cast<unsigned long>(tv.tv_sec) * 1000
+    + static_cast<unsigned long>(tv.tv_usec / 1000);
+#endif // defined(CLOCK_MONOTONIC)
+}
+
+int remaining_msec(unsigned long start, int msec)
+{
+  if (msec <= 0)
+    return 0;
+
+  // The subtraction is unsigned, so that it is correct when the clock wraps.
+  unsigned long elapsed = socket_ops::monotonic_msec() - start;
+  if (elapsed >= static_cast<unsigned long>(msec))
+    return 0;
+  return msec - static_cast<int>(elapsed);
+}
+
 int poll_read(socket_type s, state_type state,
     int msec, asio::error_code& ec)
 {
@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include "asio/detail/allocation_tracking.hpp"
 #include "asio/detail/strand_executor_service.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -52,6 +53,7 @@ void strand_executor_service::shutdown()
 strand_executor_service::implementation_type
 strand_executor_service::create_implementation()
 {
+  ASIO_HEAP_ALLOCATION(("strand", sizeof(strand_impl)));
   implementation_type new_impl(new strand_impl);
   new_impl->locked_ = false;
   new_impl->shutdown_ = false;
@@ -65,7 +67,10 @@ strand_executor_service::create_implementation()
   mutex_index ^= salt + 0x9e3779b9 + (mutex_index << 6) + (mutex_index >> 2);
   mutex_index = mutex_index % num_mutexes;
   if (!mutexes_[mutex_index].get())
+  {
+    ASIO_HEAP_ALLOCATION(("strand", sizeof(mutex)));
     mutexes_[mutex_index].reset(new mutex);
+  }
   new_impl->mutex_ = mutexes_[mutex_index].get();
 
   // Insert implementation into linked list of all implementations.
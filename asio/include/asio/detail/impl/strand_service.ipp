@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include "asio/detail/allocation_tracking.hpp"
 #include "asio/detail/call_stack.hpp"
 #include "asio/detail/strand_service.hpp"
 
@@ -80,7 +81,10 @@ void strand_service::construct(strand_service::implementation_type& impl)
   index = index % num_implementations;
 
   if (!implementations_[index].get())
+  {
+    ASIO_HEAP_ALLOCATION(("strand", sizeof(strand_impl)));
     implementations_[index].reset(new strand_impl);
+  }
   impl = implementations_[index].get();
 }
 
@@ -63,6 +63,13 @@ void timer_queue<time_traits<boost::posix_time::ptime> >::get_ready_timers(
   impl_.get_ready_timers(ops);
 }
 
+long timer_queue<time_traits<boost::posix_time::ptime> >::
+get_ready_timers_and_wait_duration_usec(
+    op_queue<operation>& ops, long max_duration)
+{
+  return impl_.get_ready_timers_and_wait_duration_usec(ops, max_duration);
+}
+
 void timer_queue<time_traits<boost::posix_time::ptime> >::get_all_timers(
     op_queue<operation>& ops)
 {
@@ -75,6 +82,19 @@ std::size_t timer_queue<time_traits<boost::posix_time::ptime> >::cancel_timer(
   return impl_.cancel_timer(timer, ops, max_cancelled);
 }
 
+void timer_queue<time_traits<boost::posix_time::ptime> >::cancel_timer_by_key(
+    per_timer_data& timer, op_queue<operation>& ops, void* cancellation_key)
+{
+  impl_.cancel_timer_by_key(timer, ops, cancellation_key);
+}
+
+std::size_t
+timer_queue<time_traits<boost::posix_time::ptime> >::reschedule_timer(
+    const time_type& time, per_timer_data& timer, bool& earliest)
+{
+  return impl_.reschedule_timer(time, timer, earliest);
+}
+
 void timer_queue<time_traits<boost::posix_time::ptime> >::move_timer(
     per_timer_data& target, per_timer_data& source)
 {
@@ -87,6 +87,16 @@ void timer_queue_set::get_ready_timers(op_queue<operation>& ops)
     p->get_ready_timers(ops);
 }
 
+long timer_queue_set::get_ready_timers_and_wait_duration_usec(
+    op_queue<operation>& ops, long max_duration)
+{
+  long min_duration = max_duration;
+  for (timer_queue_base* p = first_; p; p = p->next_)
+    min_duration = p->get_ready_timers_and_wait_duration_usec(
+        ops, min_duration);
+  return min_duration;
+}
+
 void timer_queue_set::get_all_timers(op_queue<operation>& ops)
 {
   for (timer_queue_base* p = first_; p; p = p->next_)
@@ -182,6 +182,44 @@ asio::error_code win_iocp_serial_port_service::do_get_option(
   return load(option, dcb, ec);
 }
 
+asio::error_code win_iocp_serial_port_service::do_set_timeouts(
+    win_iocp_serial_port_service::implementation_type& impl,
+    int msec, asio::error_code& ec)
+{
+  ::COMMTIMEOUTS timeouts;
+  if (msec < 0)
+  {
+    // The defaults set when the port is opened.
+    timeouts.ReadIntervalTimeout = 1;
+    timeouts.ReadTotalTimeoutMultiplier = 0;
+    timeouts.ReadTotalTimeoutConstant = 0;
+    timeouts.WriteTotalTimeoutMultiplier = 0;
+    timeouts.WriteTotalTimeoutConstant = 0;
+  }
+  else
+  {
+    // Reads return as soon as any bytes are available, or wait for up to the
+    // constant for the first byte. A zero write constant would mean no limit.
+    DWORD constant = msec > 0 ? static_cast<DWORD>(msec) : 1;
+    timeouts.ReadIntervalTimeout = MAXDWORD;
+    timeouts.ReadTotalTimeoutMultiplier = MAXDWORD;
+    timeouts.ReadTotalTimeoutConstant = constant;
+    timeouts.WriteTotalTimeoutMultiplier = 0;
+    timeouts.WriteTotalTimeoutConstant = constant;
+  }
+
+  if (!::SetCommTimeouts(handle_service_.native_handle(impl), &timeouts))
+  {
+    DWORD last_error = ::GetLastError();
+    ec = asio::error_code(last_error,
+        asio::error::get_system_category());
+    return ec;
+  }
+
+  ec = asio::error_code();
+  return ec;
+}
+
 } // namespace detail
 } // namespace asio
 
@@ -60,6 +60,8 @@ public:
   enum op_types { read_op = 0, write_op = 1,
     connect_op = 1, except_op = 2, max_ops = 3 };
 
+  enum fork_modes { fork_eager = 0, fork_lazy = 1, fork_drop = 2 };
+
   // Per-descriptor queues.
   struct descriptor_state
   {
@@ -94,6 +96,12 @@ public:
   ASIO_DECL void notify_fork(
       asio::execution_context::fork_event fork_ev);
 
+  // Set how descriptors are re-registered following a fork.
+  void set_fork_mode(fork_modes mode)
+  {
+    fork_mode_ = mode;
+  }
+
   // Initialise the task.
   ASIO_DECL void init_task();
 
@@ -131,6 +139,12 @@ public:
   ASIO_DECL void cancel_ops(socket_type descriptor,
       per_descriptor_data& descriptor_data);
 
+  // Cancel the operation associated with the given cancellation key. The
+  // handler will be invoked with the operation_aborted error.
+  ASIO_DECL void cancel_ops_by_key(socket_type descriptor,
+      per_descriptor_data& descriptor_data,
+      int op_type, void* cancellation_key);
+
   // Cancel any operations that are running against the descriptor and remove
   // its registration from the reactor. The reactor resources associated with
   // the descriptor must be released by calling cleanup_descriptor_data.
@@ -170,6 +184,19 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data& timer,
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
 
+  // Cancel the timer operation associated with the given cancellation key.
+  template <typename Time_Traits>
+  void cancel_timer_by_key(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data& timer,
+      void* cancellation_key);
+
+  // Change the expiry time of the given timer without cancelling its pending
+  // operations. Returns the number of operations that remain pending.
+  template <typename Time_Traits>
+  std::size_t reschedule_timer(timer_queue<Time_Traits>& queue,
+      const typename Time_Traits::time_type& time,
+      typename timer_queue<Time_Traits>::per_timer_data& timer);
+
   // Move the timer operations associated with the given timer.
   template <typename Time_Traits>
   void move_timer(timer_queue<Time_Traits>& queue,
@@ -225,6 +252,9 @@ private:
 
   // Keep track of all registered descriptors.
   object_pool<descriptor_state> registered_descriptors_;
+
+  // How descriptors are re-registered following a fork.
+  fork_modes fork_mode_;
 };
 
 } // namespace detail
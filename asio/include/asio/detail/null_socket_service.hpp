@@ -270,6 +270,16 @@ public:
     return 0;
   }
 
+  // Send the given data to the peer, waiting for no longer than the given
+  // number of milliseconds.
+  template <typename ConstBufferSequence>
+  std::size_t send_for(implementation_type&, const ConstBufferSequence&,
+      socket_base::message_flags, int, asio::error_code& ec)
+  {
+    ec = asio::error::operation_not_supported;
+    return 0;
+  }
+
   // Start an asynchronous send. The data being sent must be valid for the
   // lifetime of the asynchronous operation.
   template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
@@ -310,6 +320,16 @@ public:
     return 0;
   }
 
+  // Receive some data from the peer, waiting for no longer than the given
+  // number of milliseconds.
+  template <typename MutableBufferSequence>
+  std::size_t receive_for(implementation_type&, const MutableBufferSequence&,
+      socket_base::message_flags, int, asio::error_code& ec)
+  {
+    ec = asio::error::operation_not_supported;
+    return 0;
+  }
+
   // Start an asynchronous receive. The buffer for the data being received
   // must be valid for the lifetime of the asynchronous operation.
   template <typename MutableBufferSequence,
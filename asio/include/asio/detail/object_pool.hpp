@@ -15,6 +15,7 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include "asio/detail/allocation_tracking.hpp"
 #include "asio/detail/noncopyable.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -31,12 +32,14 @@ public:
   template <typename Object>
   static Object* create()
   {
+    ASIO_HEAP_ALLOCATION(("object_pool", sizeof(Object)));
     return new Object;
   }
 
   template <typename Object, typename Arg>
   static Object* create(Arg arg)
   {
+    ASIO_HEAP_ALLOCATION(("object_pool", sizeof(Object)));
     return new Object(arg);
   }
 
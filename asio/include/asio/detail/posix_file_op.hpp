@@ -0,0 +1,154 @@
+//
+// detail/posix_file_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_POSIX_FILE_OP_HPP
+#define ASIO_DETAIL_POSIX_FILE_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_FILE)
+
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/descriptor_ops.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/operation.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Base class for file operations that are performed by the file service's
+// worker threads.
+class posix_file_op
+  : public operation
+{
+public:
+  // The error code to be passed to the completion handler.
+  asio::error_code ec_;
+
+  // The number of bytes transferred, to be passed to the completion handler.
+  std::size_t bytes_transferred_;
+
+  // The descriptor on which the operation is to be performed.
+  int descriptor_;
+
+  // Whether the operation writes to the file.
+  bool is_write_;
+
+  // Whether the operation uses the given offset rather than the file position.
+  bool is_positional_;
+
+  // The offset at which a positional operation starts.
+  uint64_t offset_;
+
+  // The number of bytes beyond the end of a read to advise the kernel of.
+  std::size_t read_ahead_;
+
+  // The buffers to be transferred.
+  descriptor_ops::buf* bufs_;
+  std::size_t count_;
+  std::size_t total_size_;
+
+protected:
+  posix_file_op(func_type complete_func, int descriptor, bool is_write,
+      bool is_positional, uint64_t offset, std::size_t read_ahead)
+    : operation(complete_func),
+      bytes_transferred_(0),
+      descriptor_(descriptor),
+      is_write_(is_write),
+      is_positional_(is_positional),
+      offset_(offset),
+      read_ahead_(read_ahead),
+      bufs_(0),
+      count_(0),
+      total_size_(0)
+  {
+  }
+};
+
+template <typename Buffer, typename BufferSequence,
+    typename Handler, typename IoExecutor>
+class posix_file_io_op : public posix_file_op
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(posix_file_io_op);
+
+  posix_file_io_op(int descriptor, bool is_positional, uint64_t offset,
+      std::size_t read_ahead, const BufferSequence& buffers,
+      Handler& handler, const IoExecutor& io_ex)
+    : posix_file_op(&posix_file_io_op::do_complete, descriptor,
+        is_same<Buffer, asio::const_buffer>::value,
+        is_positional, offset, read_ahead),
+      buffers_(buffers),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      io_executor_(io_ex)
+  {
+    bufs_ = buffers_.buffers();
+    count_ = buffers_.count();
+    total_size_ = buffers_.total_size();
+    handler_work<Handler, IoExecutor>::start(handler_, io_executor_, *this);
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    posix_file_io_op* o(static_cast<posix_file_io_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+    handler_work<Handler, IoExecutor> w(o->handler_, o->io_executor_);
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  buffer_sequence_adapter<Buffer, BufferSequence> buffers_;
+  Handler handler_;
+  IoExecutor io_executor_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_FILE)
+
+#endif // ASIO_DETAIL_POSIX_FILE_OP_HPP
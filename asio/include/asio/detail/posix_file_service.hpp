@@ -0,0 +1,424 @@
+//
+// detail/posix_file_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_POSIX_FILE_SERVICE_HPP
+#define ASIO_DETAIL_POSIX_FILE_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_FILE)
+
+#include "asio/buffer.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/file_base.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/descriptor_ops.hpp"
+#include "asio/detail/event.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/op_queue.hpp"
+#include "asio/detail/posix_file_op.hpp"
+#include "asio/detail/scheduler.hpp"
+#include "asio/detail/thread_group.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Performs blocking file I/O on a small, bounded pool of worker threads, so
+// that reads and writes on regular files never block the threads running the
+// io_context. Positional operations on the same file that are queued behind
+// one another, and which cover adjacent ranges, are combined into a single
+// vectored system call. Operations that use the file position are performed
+// one at a time for each file, in the order in which they were started. When
+// threads are disabled, operations are performed in the calling thread.
+class posix_file_service :
+  public execution_context_service_base<posix_file_service>
+{
+public:
+  // The native type of a file.
+  typedef int native_handle_type;
+
+  // The implementation type of the file.
+  class implementation_type
+    : private asio::detail::noncopyable
+  {
+  public:
+    // Default constructor.
+    implementation_type()
+      : descriptor_(-1),
+        is_stream_(false),
+        next_read_offset_(0),
+        read_ahead_size_(0)
+    {
+    }
+
+  private:
+    // Only this service will have access to the internal values.
+    friend class posix_file_service;
+
+    // The native file descriptor.
+    int descriptor_;
+
+    // Whether the file is accessed as a stream, using the file position.
+    bool is_stream_;
+
+    // The offset that would follow on from the last positional read.
+    uint64_t next_read_offset_;
+
+    // The current read-ahead window for sequential positional reads.
+    std::size_t read_ahead_size_;
+  };
+
+  // Constructor.
+  ASIO_DECL posix_file_service(execution_context& context);
+
+  // Destructor.
+  ASIO_DECL ~posix_file_service();
+
+  // Destroy all user-defined handler objects owned by the service.
+  ASIO_DECL void shutdown();
+
+  // Perform any fork-related housekeeping.
+  ASIO_DECL void notify_fork(execution_context::fork_event fork_ev);
+
+  // Construct a new file implementation.
+  ASIO_DECL void construct(implementation_type& impl);
+
+  // Move-construct a new file implementation.
+  ASIO_DECL void move_construct(implementation_type& impl,
+      implementation_type& other_impl);
+
+  // Move-assign from another file implementation.
+  ASIO_DECL void move_assign(implementation_type& impl,
+      posix_file_service& other_service,
+      implementation_type& other_impl);
+
+  // Destroy a file implementation.
+  ASIO_DECL void destroy(implementation_type& impl);
+
+  // Set whether the implementation is stream-oriented.
+  void set_is_stream(implementation_type& impl, bool is_stream)
+  {
+    impl.is_stream_ = is_stream;
+  }
+
+  // Open the file using the specified path name.
+  ASIO_DECL asio::error_code open(implementation_type& impl,
+      const char* path, file_base::flags open_flags,
+      asio::error_code& ec);
+
+  // Assign a native descriptor to a file implementation.
+  ASIO_DECL asio::error_code assign(implementation_type& impl,
+      const native_handle_type& native_descriptor,
+      asio::error_code& ec);
+
+  // Determine whether the file is open.
+  bool is_open(const implementation_type& impl) const
+  {
+    return impl.descriptor_ != -1;
+  }
+
+  // Destroy a file implementation.
+  ASIO_DECL asio::error_code close(implementation_type& impl,
+      asio::error_code& ec);
+
+  // Get the native file representation.
+  native_handle_type native_handle(const implementation_type& impl) const
+  {
+    return impl.descriptor_;
+  }
+
+  // Release ownership of the native file representation.
+  ASIO_DECL native_handle_type release(implementation_type& impl,
+      asio::error_code& ec);
+
+  // Cancel all operations associated with the file that have not yet started.
+  ASIO_DECL asio::error_code cancel(implementation_type& impl,
+      asio::error_code& ec);
+
+  // Get the size of the file.
+  ASIO_DECL uint64_t size(const implementation_type& impl,
+      asio::error_code& ec) const;
+
+  // Alter the size of the file.
+  ASIO_DECL asio::error_code resize(implementation_type& impl,
+      uint64_t n, asio::error_code& ec);
+
+  // Synchronise the file to disk.
+  ASIO_DECL asio::error_code sync_all(implementation_type& impl,
+      asio::error_code& ec);
+
+  // Synchronise the file data to disk.
+  ASIO_DECL asio::error_code sync_data(implementation_type& impl,
+      asio::error_code& ec);
+
+  // Seek to a position in the file.
+  ASIO_DECL uint64_t seek(implementation_type& impl, int64_t offset,
+      file_base::seek_basis whence, asio::error_code& ec);
+
+  // Write the given data. Returns the number of bytes written.
+  template <typename ConstBufferSequence>
+  size_t write_some(implementation_type& impl,
+      const ConstBufferSequence& buffers, asio::error_code& ec)
+  {
+    buffer_sequence_adapter<asio::const_buffer,
+        ConstBufferSequence> bufs(buffers);
+
+    return descriptor_ops::sync_write(impl.descriptor_, 0,
+        bufs.buffers(), bufs.count(), bufs.all_empty(), ec);
+  }
+
+  // Start an asynchronous write. The data being written must be valid for the
+  // lifetime of the asynchronous operation.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_write_some(implementation_type& impl,
+      const ConstBufferSequence& buffers,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    start_io_op<asio::const_buffer>(impl, false, 0,
+        buffers, handler, io_ex, "async_write_some");
+  }
+
+  // Write the given data at the specified offset. Returns the number of bytes
+  // written.
+  template <typename ConstBufferSequence>
+  size_t write_some_at(implementation_type& impl, uint64_t offset,
+      const ConstBufferSequence& buffers, asio::error_code& ec)
+  {
+    buffer_sequence_adapter<asio::const_buffer,
+        ConstBufferSequence> bufs(buffers);
+
+    return descriptor_ops::sync_write_at(impl.descriptor_, offset,
+        bufs.buffers(), bufs.count(), bufs.all_empty(), ec);
+  }
+
+  // Start an asynchronous write at the specified offset. The data being
+  // written must be valid for the lifetime of the asynchronous operation.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_write_some_at(implementation_type& impl,
+      uint64_t offset, const ConstBufferSequence& buffers,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    start_io_op<asio::const_buffer>(impl, true, offset,
+        buffers, handler, io_ex, "async_write_some_at");
+  }
+
+  // Read some data. Returns the number of bytes read.
+  template <typename MutableBufferSequence>
+  size_t read_some(implementation_type& impl,
+      const MutableBufferSequence& buffers, asio::error_code& ec)
+  {
+    buffer_sequence_adapter<asio::mutable_buffer,
+        MutableBufferSequence> bufs(buffers);
+
+    return descriptor_ops::sync_read(impl.descriptor_, 0,
+        bufs.buffers(), bufs.count(), bufs.all_empty(), ec);
+  }
+
+  // Start an asynchronous read. The buffer for the data being read must be
+  // valid for the lifetime of the asynchronous operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_read_some(implementation_type& impl,
+      const MutableBufferSequence& buffers,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    start_io_op<asio::mutable_buffer>(impl, false, 0,
+        buffers, handler, io_ex, "async_read_some");
+  }
+
+  // Read some data at the specified offset. Returns the number of bytes read.
+  template <typename MutableBufferSequence>
+  size_t read_some_at(implementation_type& impl, uint64_t offset,
+      const MutableBufferSequence& buffers, asio::error_code& ec)
+  {
+    buffer_sequence_adapter<asio::mutable_buffer,
+        MutableBufferSequence> bufs(buffers);
+
+    std::size_t read_ahead = update_read_ahead(impl, offset,
+        bufs.total_size());
+    std::size_t n = descriptor_ops::sync_read_at(impl.descriptor_, offset,
+        bufs.buffers(), bufs.count(), bufs.all_empty(), ec);
+    if (n > 0)
+      advise_read_ahead(impl.descriptor_, offset + n, read_ahead);
+    return n;
+  }
+
+  // Start an asynchronous read at the specified offset. The buffer for the
+  // data being read must be valid for the lifetime of the asynchronous
+  // operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_read_some_at(implementation_type& impl,
+      uint64_t offset, const MutableBufferSequence& buffers,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    start_io_op<asio::mutable_buffer>(impl, true, offset,
+        buffers, handler, io_ex, "async_read_some_at");
+  }
+
+private:
+  // Allocate an operation and start it.
+  template <typename Buffer, typename BufferSequence,
+      typename Handler, typename IoExecutor>
+  void start_io_op(implementation_type& impl, bool is_positional,
+      uint64_t offset, const BufferSequence& buffers, Handler& handler,
+      const IoExecutor& io_ex, const char* name)
+  {
+    bool is_write = is_same<Buffer, asio::const_buffer>::value;
+    std::size_t read_ahead = 0;
+    if (is_positional && !is_write)
+    {
+      read_ahead = update_read_ahead(impl, offset,
+          buffer_size(buffers));
+    }
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef posix_file_io_op<Buffer, BufferSequence, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(impl.descriptor_, is_positional,
+        offset, read_ahead, buffers, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((scheduler_.context(),
+          *p.p, "file", &impl, impl.descriptor_, name));
+    (void)name;
+
+    start_op(p.p);
+    p.v = p.p = 0;
+  }
+
+  // Update the read-ahead state for a positional read, returning the number
+  // of bytes that should be read ahead once the read completes.
+  ASIO_DECL static std::size_t update_read_ahead(implementation_type& impl,
+      uint64_t offset, std::size_t size);
+
+  // Advise the kernel that a range of the file will be read soon.
+  ASIO_DECL static void advise_read_ahead(int descriptor,
+      uint64_t offset, std::size_t size);
+
+  // Queue an operation to be performed by a worker thread.
+  ASIO_DECL void start_op(posix_file_op* op);
+
+  // Remove queued operations for the given descriptor, so that they complete
+  // with operation_aborted.
+  ASIO_DECL void cancel_ops(int descriptor);
+
+  // Remove queued operations for the given descriptor, and wait for any that
+  // a worker thread is performing to finish, so that the descriptor may be
+  // closed or released.
+  ASIO_DECL void cancel_and_wait_ops(int descriptor);
+
+  // Run the loop of a worker thread.
+  ASIO_DECL void run_worker();
+
+  // Take the first operation from the queue that may be started now, together
+  // with any queued operations that may be performed with it as a single
+  // system call. Returns false if there is no such operation.
+  ASIO_DECL bool dequeue_batch(op_queue<posix_file_op>& batch);
+
+  // Determine whether a worker thread is performing an operation on the given
+  // descriptor. If stream_only is true, only operations that use the file
+  // position are considered.
+  ASIO_DECL bool is_in_flight(int descriptor, bool stream_only) const;
+
+  // Perform a single operation.
+  ASIO_DECL static void perform_op(posix_file_op* op);
+
+  // Perform a batch of operations.
+  ASIO_DECL static void perform_batch(op_queue<posix_file_op>& batch);
+
+  // Start a worker thread if all current threads are busy and the pool is not
+  // at its limit.
+  ASIO_DECL void maybe_start_worker();
+
+  // Stop and join all worker threads.
+  ASIO_DECL void stop_workers();
+
+  // Helper class used as the function run by each worker thread.
+  class worker_function;
+
+  // The maximum number of worker threads.
+  enum { max_threads = 4 };
+
+  // The maximum number of buffers that may be combined into one system call.
+  enum { max_batch_buffers = buffer_sequence_adapter_base::max_buffers };
+
+  // The initial and maximum read-ahead window for sequential reads.
+  enum { min_read_ahead = 64 * 1024, max_read_ahead = 1024 * 1024 };
+
+  // The scheduler used to post completions.
+  scheduler& scheduler_;
+
+  // Mutex to protect access to internal data.
+  asio::detail::mutex mutex_;
+
+  // Event used to wake worker threads.
+  asio::detail::event event_;
+
+  // Operations waiting to be performed.
+  op_queue<posix_file_op> queue_;
+
+  // A batch of operations being performed by a worker thread.
+  struct in_flight_batch
+  {
+    // The descriptor, or -1 if the slot is not in use.
+    int descriptor_;
+
+    // Whether the batch uses the file position.
+    bool is_stream_;
+  };
+
+  // The batches being performed, with one slot for each worker thread.
+  in_flight_batch in_flight_[max_threads];
+
+  // Event used to wake threads waiting for a batch to finish.
+  asio::detail::event in_flight_event_;
+
+  // The number of threads waiting for a batch to finish.
+  std::size_t in_flight_waiters_;
+
+  // The worker threads.
+  thread_group threads_;
+
+  // The number of worker threads.
+  std::size_t num_threads_;
+
+  // The number of worker threads waiting for work.
+  std::size_t idle_threads_;
+
+  // Whether the worker threads have been asked to exit.
+  bool stopped_;
+
+  // Whether the service has been shut down.
+  bool shutdown_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/posix_file_service.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // defined(ASIO_HAS_FILE)
+
+#endif // ASIO_DETAIL_POSIX_FILE_SERVICE_HPP
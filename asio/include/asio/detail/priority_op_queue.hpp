@@ -0,0 +1,125 @@
+//
+// detail/priority_op_queue.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_PRIORITY_OP_QUEUE_HPP
+#define ASIO_DETAIL_PRIORITY_OP_QUEUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/executor_priority.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/op_queue.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A queue of operations with one FIFO queue per priority class. Operations are
+// taken from the highest priority class that is not empty. To prevent
+// starvation, a lower class that has been passed over aging_limit times in a
+// row is served next.
+template <typename Operation>
+class priority_op_queue
+  : private noncopyable
+{
+public:
+  // The number of times a non-empty class may be passed over.
+  enum { aging_limit = 16 };
+
+  // Constructor.
+  priority_op_queue()
+  {
+    for (int i = 0; i < priority_classes; ++i)
+      passed_over_[i] = 0;
+  }
+
+  // Get the operation at the front of the queue.
+  Operation* front()
+  {
+    return queues_[select()].front();
+  }
+
+  // Pop an operation from the front of the queue.
+  void pop()
+  {
+    int selected = select();
+    queues_[selected].pop();
+    for (int i = 0; i < selected; ++i)
+      if (!queues_[i].empty())
+        ++passed_over_[i];
+    passed_over_[selected] = 0;
+  }
+
+  // Push an operation on to the back of the queue for its priority class.
+  void push(Operation* h)
+  {
+    queues_[h->priority()].push(h);
+  }
+
+  // Push all operations from another queue on to the back of the queue. The
+  // source queue may contain operations of a derived type.
+  template <typename OtherOperation>
+  void push(op_queue<OtherOperation>& q)
+  {
+    while (OtherOperation* h = q.front())
+    {
+      q.pop();
+      queues_[h->priority()].push(h);
+    }
+  }
+
+  // Whether the queue is empty.
+  bool empty() const
+  {
+    for (int i = 0; i < priority_classes; ++i)
+      if (!queues_[i].empty())
+        return false;
+    return true;
+  }
+
+private:
+  // Determine the class from which the next operation is taken. Returns the
+  // normal class if the queue is empty.
+  int select() const
+  {
+    int selected = normal_priority;
+    for (int i = priority_classes - 1; i >= 0; --i)
+    {
+      if (!queues_[i].empty())
+      {
+        selected = i;
+        break;
+      }
+    }
+
+    for (int i = 0; i < selected; ++i)
+      if (passed_over_[i] >= aging_limit && !queues_[i].empty())
+        return i;
+
+    return selected;
+  }
+
+  // The queues for each priority class.
+  op_queue<Operation> queues_[priority_classes];
+
+  // The number of consecutive times each class was passed over.
+  int passed_over_[priority_classes];
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_PRIORITY_OP_QUEUE_HPP
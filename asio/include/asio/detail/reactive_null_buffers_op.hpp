@@ -39,7 +39,7 @@ public:
       handler_(ASIO_MOVE_CAST(Handler)(handler)),
       io_executor_(io_ex)
   {
-    handler_work<Handler, IoExecutor>::start(handler_, io_executor_);
+    handler_work<Handler, IoExecutor>::start(handler_, io_executor_, *this);
   }
 
   static status do_perform(reactor_op*)
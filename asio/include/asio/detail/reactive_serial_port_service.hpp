@@ -153,6 +153,15 @@ public:
     return descriptor_service_.write_some(impl, buffers, ec);
   }
 
+  // Write the given data, waiting for no longer than the given number of
+  // milliseconds. Returns the number of bytes sent.
+  template <typename ConstBufferSequence>
+  size_t write_some_for(implementation_type& impl,
+      const ConstBufferSequence& buffers, int msec, asio::error_code& ec)
+  {
+    return descriptor_service_.write_some_for(impl, buffers, msec, ec);
+  }
+
   // Start an asynchronous write. The data being written must be valid for the
   // lifetime of the asynchronous operation.
   template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
@@ -171,6 +180,15 @@ public:
     return descriptor_service_.read_some(impl, buffers, ec);
   }
 
+  // Read some data, waiting for no longer than the given number of
+  // milliseconds. Returns the number of bytes received.
+  template <typename MutableBufferSequence>
+  size_t read_some_for(implementation_type& impl,
+      const MutableBufferSequence& buffers, int msec, asio::error_code& ec)
+  {
+    return descriptor_service_.read_some_for(impl, buffers, msec, ec);
+  }
+
   // Start an asynchronous read. The buffer for the data being received must be
   // valid for the lifetime of the asynchronous operation.
   template <typename MutableBufferSequence,
@@ -33,6 +33,10 @@ public:
   // The number of bytes transferred, to be passed to the completion handler.
   std::size_t bytes_transferred_;
 
+  // The address of the handler installed for per-operation cancellation, used
+  // as a key to find the operation when the cancellation signal is emitted.
+  void* cancellation_key_;
+
   // Status returned by perform function. May be used to decide whether it is
   // worth performing more operations on the descriptor immediately.
   enum status { not_done, done, done_and_exhausted };
@@ -49,6 +53,7 @@ protected:
   reactor_op(perform_func_type perform_func, func_type complete_func)
     : operation(complete_func),
       bytes_transferred_(0),
+      cancellation_key_(0),
       perform_func_(perform_func)
   {
   }
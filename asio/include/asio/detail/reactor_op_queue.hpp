@@ -100,6 +100,39 @@ public:
     return this->cancel_operations(operations_.find(descriptor), ops, ec);
   }
 
+  // Cancel the operation associated with the descriptor that has the given
+  // cancellation key. Returns true if an operation was cancelled, in which
+  // case the reactor's event demultiplexing function may need to be
+  // interrupted and restarted.
+  bool cancel_operations_by_key(Descriptor descriptor,
+      op_queue<operation>& ops, void* cancellation_key,
+      const asio::error_code& ec =
+        asio::error::operation_aborted)
+  {
+    bool result = false;
+    iterator i = operations_.find(descriptor);
+    if (i != operations_.end())
+    {
+      op_queue<reactor_op> other_ops;
+      while (reactor_op* op = i->second.front())
+      {
+        i->second.pop();
+        if (op->cancellation_key_ == cancellation_key)
+        {
+          op->ec_ = ec;
+          ops.push(op);
+          result = true;
+        }
+        else
+          other_ops.push(op);
+      }
+      i->second.push(other_ops);
+      if (i->second.empty())
+        operations_.erase(i);
+    }
+    return result;
+  }
+
   // Whether there are no operations in the queue.
   bool empty() const
   {
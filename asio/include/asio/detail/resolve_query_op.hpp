@@ -64,7 +64,7 @@ public:
       io_executor_(io_ex),
       addrinfo_(0)
   {
-    handler_work<Handler, IoExecutor>::start(handler_, io_executor_);
+    handler_work<Handler, IoExecutor>::start(handler_, io_executor_, *this);
   }
 
   ~resolve_query_op()
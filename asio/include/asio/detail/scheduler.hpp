@@ -23,6 +23,7 @@
 #include "asio/detail/conditionally_enabled_event.hpp"
 #include "asio/detail/conditionally_enabled_mutex.hpp"
 #include "asio/detail/op_queue.hpp"
+#include "asio/detail/priority_op_queue.hpp"
 #include "asio/detail/reactor_fwd.hpp"
 #include "asio/detail/scheduler_operation.hpp"
 #include "asio/detail/thread.hpp"
@@ -196,8 +197,9 @@ private:
   // The count of unfinished work.
   atomic_count outstanding_work_;
 
-  // The queue of handlers that are ready to be delivered.
-  op_queue<operation> op_queue_;
+  // The queue of handlers that are ready to be delivered, ordered by priority
+  // class.
+  priority_op_queue<operation> op_queue_;
 
   // Flag to indicate that the dispatcher has been stopped.
   bool stopped_;
@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/error_code.hpp"
+#include "asio/detail/executor_priority.hpp"
 #include "asio/detail/handler_tracking.hpp"
 #include "asio/detail/op_queue.hpp"
 
@@ -44,6 +45,18 @@ public:
     func_(0, this, asio::error_code(), 0);
   }
 
+  // Get the priority class in which the operation is queued for completion.
+  int priority() const
+  {
+    return priority_;
+  }
+
+  // Set the priority class in which the operation is queued for completion.
+  void priority(int p)
+  {
+    priority_ = p;
+  }
+
 protected:
   typedef void (*func_type)(void*,
       scheduler_operation*,
@@ -52,7 +65,8 @@ protected:
   scheduler_operation(func_type func)
     : next_(0),
       func_(func),
-      task_result_(0)
+      task_result_(0),
+      priority_(normal_priority)
   {
   }
 
@@ -68,6 +82,8 @@ private:
 protected:
   friend class scheduler;
   unsigned int task_result_; // Passed into bytes transferred.
+private:
+  int priority_;
 };
 
 } // namespace detail
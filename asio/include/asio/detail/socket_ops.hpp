@@ -142,6 +142,9 @@ ASIO_DECL signed_size_type recv(socket_type s, buf* bufs,
 ASIO_DECL size_t sync_recv(socket_type s, state_type state, buf* bufs,
     size_t count, int flags, bool all_empty, asio::error_code& ec);
 
+ASIO_DECL size_t sync_recv_for(socket_type s, state_type state, buf* bufs,
+    size_t count, int flags, bool all_empty, int msec, asio::error_code& ec);
+
 #if defined(ASIO_HAS_IOCP)
 
 ASIO_DECL void complete_iocp_recv(state_type state,
@@ -208,6 +211,10 @@ ASIO_DECL size_t sync_send(socket_type s, state_type state,
     const buf* bufs, size_t count, int flags,
     bool all_empty, asio::error_code& ec);
 
+ASIO_DECL size_t sync_send_for(socket_type s, state_type state,
+    const buf* bufs, size_t count, int flags,
+    bool all_empty, int msec, asio::error_code& ec);
+
 #if defined(ASIO_HAS_IOCP)
 
 ASIO_DECL void complete_iocp_send(
@@ -239,6 +246,23 @@ ASIO_DECL bool non_blocking_sendto(socket_type s,
 
 #endif // !defined(ASIO_HAS_IOCP)
 
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+
+// The largest number of descriptors that may be passed in a single message.
+const size_t max_fds_per_message = 253;
+
+ASIO_DECL signed_size_type send_with_fds(socket_type s, const buf* bufs,
+    size_t count, const int* fds, size_t fd_count, int flags,
+    asio::error_code& ec);
+
+// Receives data and up to max_fds_per_message descriptors. If the control
+// message is truncated, the descriptors are closed rather than returned.
+ASIO_DECL signed_size_type recv_with_fds(socket_type s, buf* bufs,
+    size_t count, int* fds, size_t& fd_count, int flags,
+    asio::error_code& ec);
+
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+
 ASIO_DECL socket_type socket(int af, int type, int protocol,
     asio::error_code& ec);
 
@@ -262,6 +286,14 @@ ASIO_DECL int ioctl(socket_type s, state_type& state,
 ASIO_DECL int select(int nfds, fd_set* readfds, fd_set* writefds,
     fd_set* exceptfds, timeval* timeout, asio::error_code& ec);
 
+// Get the time in milliseconds from a monotonic clock. The value wraps
+// around, so only the difference between two values is meaningful.
+ASIO_DECL unsigned long monotonic_msec();
+
+// Get the number of milliseconds that remain of a timeout that began at the
+// given time. Returns 0 if the timeout has expired.
+ASIO_DECL int remaining_msec(unsigned long start, int msec);
+
 ASIO_DECL int poll_read(socket_type s,
     state_type state, int msec, asio::error_code& ec);
 
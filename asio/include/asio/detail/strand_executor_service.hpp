@@ -116,7 +116,11 @@ private:
   mutex mutex_;
 
   // Number of mutexes shared between all strand objects.
+#if defined(ASIO_STRAND_IMPLEMENTATIONS)
+  enum { num_mutexes = ASIO_STRAND_IMPLEMENTATIONS };
+#else // defined(ASIO_STRAND_IMPLEMENTATIONS)
   enum { num_mutexes = 193 };
+#endif // defined(ASIO_STRAND_IMPLEMENTATIONS)
 
   // Pool of mutexes.
   scoped_ptr<mutex> mutexes_[num_mutexes];
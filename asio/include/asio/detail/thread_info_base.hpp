@@ -17,6 +17,7 @@
 
 #include <climits>
 #include <cstddef>
+#include "asio/detail/allocation_tracking.hpp"
 #include "asio/detail/noncopyable.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -28,19 +29,54 @@ class thread_info_base
   : private noncopyable
 {
 public:
+  // Handler memory is cached in two slots, so that an operation can be
+  // started from within a handler while another operation's memory is still
+  // held, as happens when a strand reschedules itself.
   struct default_tag
   {
-    enum { mem_index = 0 };
+    enum
+    {
+      cache_size = 2,
+      chunk_size = 4,
+      begin_mem_index = 0,
+      end_mem_index = cache_size
+    };
   };
 
   struct awaitable_frame_tag
   {
-    enum { mem_index = 1 };
+    enum
+    {
+      cache_size = 1,
+      chunk_size = 4,
+      begin_mem_index = default_tag::end_mem_index,
+      end_mem_index = begin_mem_index + cache_size
+    };
   };
 
   struct executor_function_tag
   {
-    enum { mem_index = 2 };
+    enum
+    {
+      cache_size = 1,
+      chunk_size = 4,
+      begin_mem_index = awaitable_frame_tag::end_mem_index,
+      end_mem_index = begin_mem_index + cache_size
+    };
+  };
+
+  // The copy buffer used by async_transfer is cached in larger chunks, so
+  // that a transfer started from a completion handler reuses the buffer that
+  // the previous transfer released.
+  struct transfer_buffer_tag
+  {
+    enum
+    {
+      cache_size = 1,
+      chunk_size = 1024,
+      begin_mem_index = executor_function_tag::end_mem_index,
+      end_mem_index = begin_mem_index + cache_size
+    };
   };
 
   thread_info_base()
@@ -71,23 +107,43 @@ public:
   static void* allocate(Purpose, thread_info_base* this_thread,
       std::size_t size)
   {
+    const std::size_t chunk_size = Purpose::chunk_size;
     std::size_t chunks = (size + chunk_size - 1) / chunk_size;
 
-    if (this_thread && this_thread->reusable_memory_[Purpose::mem_index])
+    if (this_thread)
     {
-      void* const pointer = this_thread->reusable_memory_[Purpose::mem_index];
-      this_thread->reusable_memory_[Purpose::mem_index] = 0;
-
-      unsigned char* const mem = static_cast<unsigned char*>(pointer);
-      if (static_cast<std::size_t>(mem[0]) >= chunks)
+      // Use the first cached block that is large enough.
+      for (int mem_index = Purpose::begin_mem_index;
+          mem_index < Purpose::end_mem_index; ++mem_index)
       {
-        mem[size] = mem[0];
-        return pointer;
+        if (this_thread->reusable_memory_[mem_index])
+        {
+          void* const pointer = this_thread->reusable_memory_[mem_index];
+          unsigned char* const mem = static_cast<unsigned char*>(pointer);
+          if (static_cast<std::size_t>(mem[0]) >= chunks)
+          {
+            this_thread->reusable_memory_[mem_index] = 0;
+            mem[size] = mem[0];
+            return pointer;
+          }
+        }
       }
 
-      ::operator delete(pointer);
+      // Otherwise free a cached block so that the new one can take its place.
+      for (int mem_index = Purpose::begin_mem_index;
+          mem_index < Purpose::end_mem_index; ++mem_index)
+      {
+        if (this_thread->reusable_memory_[mem_index])
+        {
+          void* const pointer = this_thread->reusable_memory_[mem_index];
+          this_thread->reusable_memory_[mem_index] = 0;
+          ::operator delete(pointer);
+          break;
+        }
+      }
     }
 
+    ASIO_HEAP_ALLOCATION((tracking_site(Purpose()), chunks * chunk_size + 1));
     void* const pointer = ::operator new(chunks * chunk_size + 1);
     unsigned char* const mem = static_cast<unsigned char*>(pointer);
     mem[size] = (chunks <= UCHAR_MAX) ? static_cast<unsigned char>(chunks) : 0;
@@ -98,14 +154,21 @@ public:
   static void deallocate(Purpose, thread_info_base* this_thread,
       void* pointer, std::size_t size)
   {
-    if (size <= chunk_size * UCHAR_MAX)
+    if (size <= static_cast<std::size_t>(Purpose::chunk_size) * UCHAR_MAX)
     {
-      if (this_thread && this_thread->reusable_memory_[Purpose::mem_index] == 0)
+      if (this_thread)
       {
-        unsigned char* const mem = static_cast<unsigned char*>(pointer);
-        mem[0] = mem[size];
-        this_thread->reusable_memory_[Purpose::mem_index] = pointer;
-        return;
+        for (int mem_index = Purpose::begin_mem_index;
+            mem_index < Purpose::end_mem_index; ++mem_index)
+        {
+          if (this_thread->reusable_memory_[mem_index] == 0)
+          {
+            unsigned char* const mem = static_cast<unsigned char*>(pointer);
+            mem[0] = mem[size];
+            this_thread->reusable_memory_[mem_index] = pointer;
+            return;
+          }
+        }
       }
     }
 
@@ -113,8 +176,22 @@ public:
   }
 
 private:
-  enum { chunk_size = 4 };
-  enum { max_mem_index = 3 };
+  // The names under which heap allocations are tracked for each purpose.
+  static const char* tracking_site(default_tag) { return "handler"; }
+  static const char* tracking_site(awaitable_frame_tag)
+  {
+    return "awaitable_frame";
+  }
+  static const char* tracking_site(executor_function_tag)
+  {
+    return "executor_function";
+  }
+  static const char* tracking_site(transfer_buffer_tag)
+  {
+    return "transfer_buffer";
+  }
+
+  enum { max_mem_index = transfer_buffer_tag::end_mem_index };
   void* reusable_memory_[max_mem_index];
 };
 
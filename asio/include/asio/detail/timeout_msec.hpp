@@ -0,0 +1,60 @@
+//
+// detail/timeout_msec.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_TIMEOUT_MSEC_HPP
+#define ASIO_DETAIL_TIMEOUT_MSEC_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_CHRONO)
+
+#include <limits>
+#include "asio/detail/chrono.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Convert a timeout for a synchronous operation to the number of milliseconds
+// passed to poll. The timeout is rounded up, so that a wait is never shorter
+// than requested, and is limited to the range of an int.
+template <typename Rep, typename Period>
+int timeout_msec(const chrono::duration<Rep, Period>& timeout)
+{
+  typedef chrono::duration<Rep, Period> duration_type;
+
+  if (timeout <= duration_type::zero())
+    return 0;
+
+  const int max_msec = (std::numeric_limits<int>::max)();
+  if (timeout >= chrono::duration_cast<duration_type>(
+        chrono::milliseconds(max_msec)))
+    return max_msec;
+
+  chrono::milliseconds msec =
+    chrono::duration_cast<chrono::milliseconds>(timeout);
+  if (msec < timeout)
+    ++msec;
+  return static_cast<int>(msec.count());
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_CHRONO)
+
+#endif // ASIO_DETAIL_TIMEOUT_MSEC_HPP
@@ -0,0 +1,52 @@
+//
+// detail/timer_coalescing.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_TIMER_COALESCING_HPP
+#define ASIO_DETAIL_TIMER_COALESCING_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Snaps timer expiry times onto a grid of the given slack, so that timers with
+// nearby expiry times are dequeued by a single reactor wakeup. The default
+// implementation leaves the expiry time untouched, and is specialised for time
+// traits that support the required arithmetic.
+template <typename Time_Traits>
+struct timer_coalescing
+{
+  // A slack that disables coalescing.
+  static typename Time_Traits::duration_type no_slack()
+  {
+    return typename Time_Traits::duration_type();
+  }
+
+  // Round the time up to the next multiple of the slack.
+  static typename Time_Traits::time_type round_up(
+      const typename Time_Traits::time_type& t,
+      const typename Time_Traits::duration_type&)
+  {
+    return t;
+  }
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_TIMER_COALESCING_HPP
@@ -18,6 +18,7 @@
 #include "asio/detail/config.hpp"
 #include <cstddef>
 #include <vector>
+#include "asio/detail/allocation_tracking.hpp"
 #include "asio/detail/cstdint.hpp"
 #include "asio/detail/date_time_fwd.hpp"
 #include "asio/detail/limits.hpp"
@@ -92,6 +93,8 @@ public:
         // first since push_back() can throw due to allocation failure.
         timer.heap_index_ = heap_.size();
         heap_entry entry = { time, &timer };
+        if (heap_.size() == heap_.capacity())
+          ASIO_HEAP_ALLOCATION(("timer_queue", sizeof(entry)));
         heap_.push_back(entry);
         up_heap(heap_.size() - 1);
       }
@@ -145,15 +148,27 @@ public:
   virtual void get_ready_timers(op_queue<operation>& ops)
   {
     if (!heap_.empty())
-    {
-      const time_type now = Time_Traits::now();
-      while (!heap_.empty() && !Time_Traits::less_than(now, heap_[0].time_))
-      {
-        per_timer_data* timer = heap_[0].timer_;
-        ops.push(timer->op_queue_);
-        remove_timer(*timer);
-      }
-    }
+      get_ready_timers(Time_Traits::now(), ops);
+  }
+
+  // Dequeue all timers not later than the current time, and get the time for
+  // the timer that is then earliest in the queue.
+  virtual long get_ready_timers_and_wait_duration_usec(
+      op_queue<operation>& ops, long max_duration)
+  {
+    if (heap_.empty())
+      return max_duration;
+
+    const time_type now = Time_Traits::now();
+    get_ready_timers(now, ops);
+
+    if (heap_.empty())
+      return max_duration;
+
+    return this->to_usec(
+        Time_Traits::to_posix_duration(
+          Time_Traits::subtract(heap_[0].time_, now)),
+        max_duration);
   }
 
   // Dequeue all timers.
@@ -192,6 +207,79 @@ public:
     return num_cancelled;
   }
 
+  // Cancel and dequeue the operation for the given timer that has the given
+  // cancellation key.
+  void cancel_timer_by_key(per_timer_data& timer,
+      op_queue<operation>& ops, void* cancellation_key)
+  {
+    if (timer.prev_ != 0 || &timer == timers_)
+    {
+      op_queue<wait_op> other_ops;
+      while (wait_op* op = timer.op_queue_.front())
+      {
+        timer.op_queue_.pop();
+        if (op->cancellation_key_ == cancellation_key)
+        {
+          op->ec_ = asio::error::operation_aborted;
+          ops.push(op);
+        }
+        else
+          other_ops.push(op);
+      }
+      timer.op_queue_.push(other_ops);
+      if (timer.op_queue_.empty())
+        remove_timer(timer);
+    }
+  }
+
+  // Change the expiry time of a timer without cancelling its operations.
+  // Returns the number of operations that remain pending on the timer. The
+  // earliest flag is set to true if the timer was, or has become, the earliest
+  // in the queue, in which case the reactor's event demultiplexing function
+  // call may need to be interrupted and restarted.
+  std::size_t reschedule_timer(const time_type& time,
+      per_timer_data& timer, bool& earliest)
+  {
+    earliest = false;
+    if (timer.prev_ == 0 && &timer != timers_)
+      return 0;
+
+    std::size_t index = timer.heap_index_;
+    earliest = (index == 0);
+    if (this->is_positive_infinity(time))
+    {
+      // No heap entry is required for timers that never expire.
+      remove_from_heap(timer);
+    }
+    else if (index < heap_.size())
+    {
+      // Adjust the existing heap entry in place.
+      heap_[index].time_ = time;
+      if (index > 0 && Time_Traits::less_than(
+            heap_[index].time_, heap_[(index - 1) / 2].time_))
+        up_heap(index);
+      else
+        down_heap(index);
+    }
+    else
+    {
+      // The timer previously never expired and now needs a heap entry.
+      timer.heap_index_ = heap_.size();
+      heap_entry entry = { time, &timer };
+      if (heap_.size() == heap_.capacity())
+        ASIO_HEAP_ALLOCATION(("timer_queue", sizeof(entry)));
+      heap_.push_back(entry);
+      up_heap(heap_.size() - 1);
+    }
+    earliest = earliest || timer.heap_index_ == 0;
+
+    std::size_t num_pending = 0;
+    for (wait_op* op = timer.op_queue_.front();
+        op; op = op_queue_access::next(op))
+      ++num_pending;
+    return num_pending;
+  }
+
   // Move operations from one timer to another, empty timer.
   void move_timer(per_timer_data& target, per_timer_data& source)
   {
@@ -216,6 +304,17 @@ public:
   }
 
 private:
+  // Dequeue all timers not later than the specified time.
+  void get_ready_timers(const time_type& now, op_queue<operation>& ops)
+  {
+    while (!heap_.empty() && !Time_Traits::less_than(now, heap_[0].time_))
+    {
+      per_timer_data* timer = heap_[0].timer_;
+      ops.push(timer->op_queue_);
+      remove_timer(*timer);
+    }
+  }
+
   // Move the item at the given index up the heap to its correct position.
   void up_heap(std::size_t index)
   {
@@ -260,7 +359,22 @@ private:
   // Remove a timer from the heap and list of timers.
   void remove_timer(per_timer_data& timer)
   {
-    // Remove the timer from the heap.
+    remove_from_heap(timer);
+
+    // Remove the timer from the linked list of active timers.
+    if (timers_ == &timer)
+      timers_ = timer.next_;
+    if (timer.prev_)
+      timer.prev_->next_ = timer.next_;
+    if (timer.next_)
+      timer.next_->prev_= timer.prev_;
+    timer.next_ = 0;
+    timer.prev_ = 0;
+  }
+
+  // Remove a timer from the heap only.
+  void remove_from_heap(per_timer_data& timer)
+  {
     std::size_t index = timer.heap_index_;
     if (!heap_.empty() && index < heap_.size())
     {
@@ -281,16 +395,6 @@ private:
           down_heap(index);
       }
     }
-
-    // Remove the timer from the linked list of active timers.
-    if (timers_ == &timer)
-      timers_ = timer.next_;
-    if (timer.prev_)
-      timer.prev_->next_ = timer.next_;
-    if (timer.next_)
-      timer.next_->prev_= timer.prev_;
-    timer.next_ = 0;
-    timer.prev_ = 0;
   }
 
   // Determine if the specified absolute time is positive infinity.
@@ -47,6 +47,14 @@ public:
   // Dequeue all ready timers.
   virtual void get_ready_timers(op_queue<operation>& ops) = 0;
 
+  // Dequeue all ready timers and get the time to wait until the next timer,
+  // reading the clock only once. This suits a reactor that rearms its timer
+  // at the point where it collects the ready timers, as the epoll reactor
+  // does with a timerfd. Reactors that compute a timeout before blocking and
+  // collect the ready timers afterwards must read the clock at both points.
+  virtual long get_ready_timers_and_wait_duration_usec(
+      op_queue<operation>& ops, long max_duration) = 0;
+
   // Dequeue all timers.
   virtual void get_all_timers(op_queue<operation>& ops) = 0;
 
@@ -69,6 +69,11 @@ public:
   // Dequeue all timers not later than the current time.
   ASIO_DECL virtual void get_ready_timers(op_queue<operation>& ops);
 
+  // Dequeue all timers not later than the current time, and get the time for
+  // the timer that is then earliest in the queue.
+  ASIO_DECL virtual long get_ready_timers_and_wait_duration_usec(
+      op_queue<operation>& ops, long max_duration);
+
   // Dequeue all timers.
   ASIO_DECL virtual void get_all_timers(op_queue<operation>& ops);
 
@@ -77,6 +82,14 @@ public:
       per_timer_data& timer, op_queue<operation>& ops,
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
 
+  // Cancel and dequeue the operation with the given cancellation key.
+  ASIO_DECL void cancel_timer_by_key(per_timer_data& timer,
+      op_queue<operation>& ops, void* cancellation_key);
+
+  // Change the expiry time of a timer without cancelling its operations.
+  ASIO_DECL std::size_t reschedule_timer(const time_type& time,
+      per_timer_data& timer, bool& earliest);
+
   // Move operations from one timer to another, empty timer.
   ASIO_DECL void move_timer(per_timer_data& target,
       per_timer_data& source);
@@ -47,6 +47,10 @@ public:
   // Dequeue all ready timers.
   ASIO_DECL void get_ready_timers(op_queue<operation>& ops);
 
+  // Dequeue all ready timers and get the wait duration in microseconds.
+  ASIO_DECL long get_ready_timers_and_wait_duration_usec(
+      op_queue<operation>& ops, long max_duration);
+
   // Dequeue all timers.
   ASIO_DECL void get_all_timers(op_queue<operation>& ops);
 
@@ -39,7 +39,7 @@ public:
       handler_(ASIO_MOVE_CAST(Handler)(h)),
       io_executor_(ex)
   {
-    handler_work<Handler, IoExecutor>::start(handler_, io_executor_);
+    handler_work<Handler, IoExecutor>::start(handler_, io_executor_, *this);
   }
 
   static void do_complete(void* owner, operation* base,
@@ -30,9 +30,14 @@ public:
   // The error code to be passed to the completion handler.
   asio::error_code ec_;
 
+  // The address of the handler installed for per-operation cancellation, used
+  // as a key to find the operation when the cancellation signal is emitted.
+  void* cancellation_key_;
+
 protected:
   wait_op(func_type func)
-    : operation(func)
+    : operation(func),
+      cancellation_key_(0)
   {
   }
 };
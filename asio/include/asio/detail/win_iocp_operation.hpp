@@ -19,6 +19,7 @@
 
 #if defined(ASIO_HAS_IOCP)
 
+#include "asio/detail/executor_priority.hpp"
 #include "asio/detail/handler_tracking.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/socket_types.hpp"
@@ -51,6 +52,17 @@ public:
     func_(0, this, asio::error_code(), 0);
   }
 
+  // Completion ports deliver operations in the order in which they complete,
+  // so priority classes are not supported.
+  int priority() const
+  {
+    return normal_priority;
+  }
+
+  void priority(int)
+  {
+  }
+
 protected:
   typedef void (*func_type)(
       void*, win_iocp_operation*,
@@ -23,6 +23,7 @@
 #include <string>
 #include "asio/error.hpp"
 #include "asio/execution_context.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
 #include "asio/detail/win_iocp_handle_service.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -148,6 +149,27 @@ public:
     return handle_service_.write_some(impl, buffers, ec);
   }
 
+  // Write the given data, waiting for no longer than the given number of
+  // milliseconds. Returns the number of bytes sent.
+  template <typename ConstBufferSequence>
+  size_t write_some_for(implementation_type& impl,
+      const ConstBufferSequence& buffers, int msec, asio::error_code& ec)
+  {
+    if (buffer_sequence_adapter<asio::const_buffer,
+          ConstBufferSequence>::first(buffers).size() == 0)
+      return handle_service_.write_some(impl, buffers, ec);
+
+    if (do_set_timeouts(impl, msec, ec))
+      return 0;
+    size_t bytes_transferred = handle_service_.write_some(impl, buffers, ec);
+    asio::error_code restore_ec;
+    do_set_timeouts(impl, -1, restore_ec);
+
+    if (bytes_transferred == 0 && !ec)
+      ec = asio::error::timed_out;
+    return bytes_transferred;
+  }
+
   // Start an asynchronous write. The data being written must be valid for the
   // lifetime of the asynchronous operation.
   template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
@@ -166,6 +188,27 @@ public:
     return handle_service_.read_some(impl, buffers, ec);
   }
 
+  // Read some data, waiting for no longer than the given number of
+  // milliseconds. Returns the number of bytes received.
+  template <typename MutableBufferSequence>
+  size_t read_some_for(implementation_type& impl,
+      const MutableBufferSequence& buffers, int msec, asio::error_code& ec)
+  {
+    if (buffer_sequence_adapter<asio::mutable_buffer,
+          MutableBufferSequence>::first(buffers).size() == 0)
+      return handle_service_.read_some(impl, buffers, ec);
+
+    if (do_set_timeouts(impl, msec, ec))
+      return 0;
+    size_t bytes_transferred = handle_service_.read_some(impl, buffers, ec);
+    asio::error_code restore_ec;
+    do_set_timeouts(impl, -1, restore_ec);
+
+    if (bytes_transferred == 0 && !ec)
+      ec = asio::error::timed_out;
+    return bytes_transferred;
+  }
+
   // Start an asynchronous read. The buffer for the data being received must be
   // valid for the lifetime of the asynchronous operation.
   template <typename MutableBufferSequence,
@@ -214,6 +257,11 @@ private:
       const implementation_type& impl, load_function_type load,
       void* option, asio::error_code& ec) const;
 
+  // Helper function to bound reads and writes to the given number of
+  // milliseconds, or to restore the default timeouts if it is negative.
+  ASIO_DECL asio::error_code do_set_timeouts(implementation_type& impl,
+      int msec, asio::error_code& ec);
+
   // The implementation used for initiating asynchronous operations.
   win_iocp_handle_service handle_service_;
 };
@@ -258,6 +258,20 @@ public:
         bufs.buffers(), bufs.count(), flags, bufs.all_empty(), ec);
   }
 
+  // Send the given data to the peer, waiting for no longer than the given
+  // number of milliseconds.
+  template <typename ConstBufferSequence>
+  size_t send_for(base_implementation_type& impl,
+      const ConstBufferSequence& buffers, socket_base::message_flags flags,
+      int msec, asio::error_code& ec)
+  {
+    buffer_sequence_adapter<asio::const_buffer,
+        ConstBufferSequence> bufs(buffers);
+
+    return socket_ops::sync_send_for(impl.socket_, impl.state_,
+        bufs.buffers(), bufs.count(), flags, bufs.all_empty(), msec, ec);
+  }
+
   // Wait until data can be sent without blocking.
   size_t send(base_implementation_type& impl, const null_buffers&,
       socket_base::message_flags, asio::error_code& ec)
@@ -325,6 +339,20 @@ public:
         bufs.buffers(), bufs.count(), flags, bufs.all_empty(), ec);
   }
 
+  // Receive some data from the peer, waiting for no longer than the given
+  // number of milliseconds. Returns the number of bytes received.
+  template <typename MutableBufferSequence>
+  size_t receive_for(base_implementation_type& impl,
+      const MutableBufferSequence& buffers, socket_base::message_flags flags,
+      int msec, asio::error_code& ec)
+  {
+    buffer_sequence_adapter<asio::mutable_buffer,
+        MutableBufferSequence> bufs(buffers);
+
+    return socket_ops::sync_recv_for(impl.socket_, impl.state_,
+        bufs.buffers(), bufs.count(), flags, bufs.all_empty(), msec, ec);
+  }
+
   // Wait until data can be received without blocking.
   size_t receive(base_implementation_type& impl, const null_buffers&,
       socket_base::message_flags, asio::error_code& ec)
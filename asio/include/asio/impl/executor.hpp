@@ -16,11 +16,13 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include "asio/detail/allocation_tracking.hpp"
 #include "asio/detail/atomic_count.hpp"
 #include "asio/detail/executor_function.hpp"
 #include "asio/detail/global.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/recycling_allocator.hpp"
+#include "asio/detail/type_traits.hpp"
 #include "asio/executor.hpp"
 #include "asio/system_executor.hpp"
 
@@ -81,7 +83,8 @@ class executor::function
 public:
   template <typename F, typename Alloc>
   explicit function(const F& f, const Alloc&)
-    : impl_(new impl<F>(f))
+    : impl_((ASIO_HEAP_ALLOCATION(("executor_function", sizeof(impl<F>))),
+          new impl<F>(f)))
   {
   }
 
@@ -132,6 +135,9 @@ public:
 
   static impl_base* create(const Executor& e, Allocator a = Allocator())
   {
+    if (is_same<Allocator, std::allocator<void> >::value)
+      ASIO_HEAP_ALLOCATION(("executor", sizeof(impl)));
+
     raw_mem mem(a);
     impl* p = new (mem.ptr_) impl(e, a);
     mem.ptr_ = 0;
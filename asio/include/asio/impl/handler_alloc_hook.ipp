@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include "asio/detail/allocation_tracking.hpp"
 #include "asio/detail/thread_context.hpp"
 #include "asio/detail/thread_info_base.hpp"
 #include "asio/handler_alloc_hook.hpp"
@@ -30,6 +31,7 @@ void* asio_handler_allocate(std::size_t size, ...)
   return detail::thread_info_base::allocate(
       detail::thread_context::thread_call_stack::top(), size);
 #else // !defined(ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
+  ASIO_HEAP_ALLOCATION(("handler", size));
   return ::operator new(size);
 #endif // !defined(ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
 }
@@ -67,7 +67,13 @@ namespace asio {
 inline io_context::executor_type
 io_context::get_executor() ASIO_NOEXCEPT
 {
-  return executor_type(*this);
+  return executor_type(*this, detail::normal_priority);
+}
+
+inline io_context::executor_type
+io_context::get_executor(priority_type priority) ASIO_NOEXCEPT
+{
+  return executor_type(*this, priority);
 }
 
 #if defined(ASIO_HAS_CHRONO)
@@ -267,6 +273,7 @@ void io_context::executor_type::dispatch(
   typedef detail::executor_op<function_type, Allocator, detail::operation> op;
   typename op::ptr p = { detail::addressof(a), op::ptr::allocate(a), 0 };
   p.p = new (p.v) op(ASIO_MOVE_CAST(Function)(f), a);
+  p.p->priority(priority_);
 
   ASIO_HANDLER_CREATION((this->context(), *p.p,
         "io_context", &this->context(), 0, "dispatch"));
@@ -285,6 +292,7 @@ void io_context::executor_type::post(
   typedef detail::executor_op<function_type, Allocator, detail::operation> op;
   typename op::ptr p = { detail::addressof(a), op::ptr::allocate(a), 0 };
   p.p = new (p.v) op(ASIO_MOVE_CAST(Function)(f), a);
+  p.p->priority(priority_);
 
   ASIO_HANDLER_CREATION((this->context(), *p.p,
         "io_context", &this->context(), 0, "post"));
@@ -303,6 +311,7 @@ void io_context::executor_type::defer(
   typedef detail::executor_op<function_type, Allocator, detail::operation> op;
   typename op::ptr p = { detail::addressof(a), op::ptr::allocate(a), 0 };
   p.p = new (p.v) op(ASIO_MOVE_CAST(Function)(f), a);
+  p.p->priority(priority_);
 
   ASIO_HANDLER_CREATION((this->context(), *p.p,
         "io_context", &this->context(), 0, "defer"));
@@ -26,6 +26,7 @@
 #if defined(ASIO_HAS_IOCP)
 # include "asio/detail/win_iocp_io_context.hpp"
 #else
+# include "asio/detail/reactor.hpp"
 # include "asio/detail/scheduler.hpp"
 #endif
 
@@ -131,6 +132,16 @@ void io_context::restart()
   impl_.restart();
 }
 
+void io_context::set_fork_mode(io_context::fork_mode mode)
+{
+#if defined(ASIO_HAS_IOCP) || defined(ASIO_WINDOWS_RUNTIME)
+  (void)mode;
+#else
+  asio::use_service<detail::reactor>(*this).set_fork_mode(
+      static_cast<detail::reactor::fork_modes>(mode));
+#endif
+}
+
 io_context::service::service(asio::io_context& owner)
   : execution_context::service(owner)
 {
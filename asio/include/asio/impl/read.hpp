@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include "asio/associated_allocator.hpp"
+#include "asio/associated_cancellation_slot.hpp"
 #include "asio/associated_executor.hpp"
 #include "asio/buffer.hpp"
 #include "asio/completion_condition.hpp"
@@ -31,6 +32,7 @@
 #include "asio/detail/handler_type_requirements.hpp"
 #include "asio/detail/non_const_lvalue.hpp"
 #include "asio/detail/throw_error.hpp"
+#include "asio/detail/timeout_msec.hpp"
 #include "asio/error.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -110,6 +112,67 @@ inline std::size_t read(SyncReadStream& s, const MutableBufferSequence& buffers,
   return bytes_transferred;
 }
 
+#if defined(ASIO_HAS_CHRONO)
+
+namespace detail
+{
+  template <typename SyncReadStream, typename MutableBufferSequence,
+      typename MutableBufferIterator>
+  std::size_t read_buffer_sequence_for(SyncReadStream& s,
+      const MutableBufferSequence& buffers, const MutableBufferIterator&,
+      int msec, asio::error_code& ec)
+  {
+    ec = asio::error_code();
+    asio::detail::consuming_buffers<mutable_buffer,
+        MutableBufferSequence, MutableBufferIterator> tmp(buffers);
+    const chrono::steady_clock::time_point deadline =
+      chrono::steady_clock::now() + chrono::milliseconds(msec);
+    chrono::steady_clock::duration remaining = chrono::milliseconds(msec);
+    while (!tmp.empty())
+    {
+      tmp.consume(s.read_some_for(
+            tmp.prepare(default_max_transfer_size), remaining, ec));
+      if (ec)
+        break;
+      remaining = deadline - chrono::steady_clock::now();
+      if (remaining < chrono::steady_clock::duration::zero())
+        remaining = chrono::steady_clock::duration::zero();
+    }
+    return tmp.total_consumed();
+  }
+} // namespace detail
+
+template <typename SyncReadStream, typename MutableBufferSequence,
+    typename Rep, typename Period>
+inline std::size_t read_for(SyncReadStream& s, const MutableBufferSequence& buffers,
+    const chrono::duration<Rep, Period>& timeout,
+    typename enable_if<
+      is_mutable_buffer_sequence<MutableBufferSequence>::value
+    >::type*)
+{
+  asio::error_code ec;
+  std::size_t bytes_transferred = detail::read_buffer_sequence_for(s,
+      buffers, asio::buffer_sequence_begin(buffers),
+      detail::timeout_msec(timeout), ec);
+  asio::detail::throw_error(ec, "read_for");
+  return bytes_transferred;
+}
+
+template <typename SyncReadStream, typename MutableBufferSequence,
+    typename Rep, typename Period>
+inline std::size_t read_for(SyncReadStream& s, const MutableBufferSequence& buffers,
+    const chrono::duration<Rep, Period>& timeout, asio::error_code& ec,
+    typename enable_if<
+      is_mutable_buffer_sequence<MutableBufferSequence>::value
+    >::type*)
+{
+  return detail::read_buffer_sequence_for(s, buffers,
+      asio::buffer_sequence_begin(buffers),
+      detail::timeout_msec(timeout), ec);
+}
+
+#endif // defined(ASIO_HAS_CHRONO)
+
 #if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
 
 template <typename SyncReadStream, typename DynamicBuffer_v1,
@@ -511,6 +574,27 @@ struct associated_allocator<
   }
 };
 
+template <typename AsyncReadStream, typename MutableBufferSequence,
+    typename MutableBufferIterator, typename CompletionCondition,
+    typename ReadHandler, typename CancellationSlot>
+struct associated_cancellation_slot<
+    detail::read_op<AsyncReadStream, MutableBufferSequence,
+      MutableBufferIterator, CompletionCondition, ReadHandler>,
+    CancellationSlot>
+{
+  typedef typename associated_cancellation_slot<
+    ReadHandler, CancellationSlot>::type type;
+
+  static type get(
+      const detail::read_op<AsyncReadStream, MutableBufferSequence,
+        MutableBufferIterator, CompletionCondition, ReadHandler>& h,
+      const CancellationSlot& s = CancellationSlot()) ASIO_NOEXCEPT
+  {
+    return associated_cancellation_slot<ReadHandler,
+        CancellationSlot>::get(h.handler_, s);
+  }
+};
+
 template <typename AsyncReadStream, typename MutableBufferSequence,
     typename MutableBufferIterator, typename CompletionCondition,
     typename ReadHandler, typename Executor>
@@ -771,6 +855,27 @@ struct associated_allocator<
   }
 };
 
+template <typename AsyncReadStream, typename DynamicBuffer_v1,
+    typename CompletionCondition, typename ReadHandler,
+    typename CancellationSlot>
+struct associated_cancellation_slot<
+    detail::read_dynbuf_v1_op<AsyncReadStream,
+      DynamicBuffer_v1, CompletionCondition, ReadHandler>,
+    CancellationSlot>
+{
+  typedef typename associated_cancellation_slot<
+    ReadHandler, CancellationSlot>::type type;
+
+  static type get(
+      const detail::read_dynbuf_v1_op<AsyncReadStream,
+        DynamicBuffer_v1, CompletionCondition, ReadHandler>& h,
+      const CancellationSlot& s = CancellationSlot()) ASIO_NOEXCEPT
+  {
+    return associated_cancellation_slot<ReadHandler,
+        CancellationSlot>::get(h.handler_, s);
+  }
+};
+
 template <typename AsyncReadStream, typename DynamicBuffer_v1,
     typename CompletionCondition, typename ReadHandler, typename Executor>
 struct associated_executor<
@@ -1076,6 +1181,27 @@ struct associated_allocator<
   }
 };
 
+template <typename AsyncReadStream, typename DynamicBuffer_v2,
+    typename CompletionCondition, typename ReadHandler,
+    typename CancellationSlot>
+struct associated_cancellation_slot<
+    detail::read_dynbuf_v2_op<AsyncReadStream,
+      DynamicBuffer_v2, CompletionCondition, ReadHandler>,
+    CancellationSlot>
+{
+  typedef typename associated_cancellation_slot<
+    ReadHandler, CancellationSlot>::type type;
+
+  static type get(
+      const detail::read_dynbuf_v2_op<AsyncReadStream,
+        DynamicBuffer_v2, CompletionCondition, ReadHandler>& h,
+      const CancellationSlot& s = CancellationSlot()) ASIO_NOEXCEPT
+  {
+    return associated_cancellation_slot<ReadHandler,
+        CancellationSlot>::get(h.handler_, s);
+  }
+};
+
 template <typename AsyncReadStream, typename DynamicBuffer_v2,
     typename CompletionCondition, typename ReadHandler, typename Executor>
 struct associated_executor<
@@ -23,6 +23,7 @@
 #include "asio/associated_executor.hpp"
 #include "asio/buffer.hpp"
 #include "asio/buffers_iterator.hpp"
+#include "asio/completion_condition.hpp"
 #include "asio/detail/bind_handler.hpp"
 #include "asio/detail/handler_alloc_helpers.hpp"
 #include "asio/detail/handler_cont_helpers.hpp"
@@ -135,7 +136,8 @@ std::size_t read_until(SyncReadStream& s,
     // Need more data.
     std::size_t bytes_to_read = std::min<std::size_t>(
           std::max<std::size_t>(512, b.capacity() - b.size()),
-          std::min<std::size_t>(65536, b.max_size() - b.size()));
+          std::min<std::size_t>(detail::default_max_transfer_size,
+            b.max_size() - b.size()));
     b.commit(s.read_some(b.prepare(bytes_to_read), ec));
     if (ec)
       return 0;
@@ -214,7 +216,8 @@ std::size_t read_until(SyncReadStream& s,
     // Need more data.
     std::size_t bytes_to_read = std::min<std::size_t>(
           std::max<std::size_t>(512, b.capacity() - b.size()),
-          std::min<std::size_t>(65536, b.max_size() - b.size()));
+          std::min<std::size_t>(detail::default_max_transfer_size,
+            b.max_size() - b.size()));
     b.commit(s.read_some(b.prepare(bytes_to_read), ec));
     if (ec)
       return 0;
@@ -298,7 +301,8 @@ std::size_t read_until(SyncReadStream& s,
     // Need more data.
     std::size_t bytes_to_read = std::min<std::size_t>(
           std::max<std::size_t>(512, b.capacity() - b.size()),
-          std::min<std::size_t>(65536, b.max_size() - b.size()));
+          std::min<std::size_t>(detail::default_max_transfer_size,
+            b.max_size() - b.size()));
     b.commit(s.read_some(b.prepare(bytes_to_read), ec));
     if (ec)
       return 0;
@@ -380,7 +384,8 @@ std::size_t read_until(SyncReadStream& s,
     // Need more data.
     std::size_t bytes_to_read = std::min<std::size_t>(
           std::max<std::size_t>(512, b.capacity() - b.size()),
-          std::min<std::size_t>(65536, b.max_size() - b.size()));
+          std::min<std::size_t>(detail::default_max_transfer_size,
+            b.max_size() - b.size()));
     b.commit(s.read_some(b.prepare(bytes_to_read), ec));
     if (ec)
       return 0;
@@ -519,7 +524,8 @@ std::size_t read_until(SyncReadStream& s, DynamicBuffer_v2 buffers,
     // Need more data.
     std::size_t bytes_to_read = std::min<std::size_t>(
           std::max<std::size_t>(512, b.capacity() - b.size()),
-          std::min<std::size_t>(65536, b.max_size() - b.size()));
+          std::min<std::size_t>(detail::default_max_transfer_size,
+            b.max_size() - b.size()));
     std::size_t pos = b.size();
     b.grow(bytes_to_read);
     std::size_t bytes_transferred = s.read_some(b.data(pos, bytes_to_read), ec);
@@ -597,7 +603,8 @@ std::size_t read_until(SyncReadStream& s, DynamicBuffer_v2 buffers,
     // Need more data.
     std::size_t bytes_to_read = std::min<std::size_t>(
           std::max<std::size_t>(512, b.capacity() - b.size()),
-          std::min<std::size_t>(65536, b.max_size() - b.size()));
+          std::min<std::size_t>(detail::default_max_transfer_size,
+            b.max_size() - b.size()));
     std::size_t pos = b.size();
     b.grow(bytes_to_read);
     std::size_t bytes_transferred = s.read_some(b.data(pos, bytes_to_read), ec);
@@ -680,7 +687,8 @@ std::size_t read_until(SyncReadStream& s, DynamicBuffer_v2 buffers,
     // Need more data.
     std::size_t bytes_to_read = std::min<std::size_t>(
           std::max<std::size_t>(512, b.capacity() - b.size()),
-          std::min<std::size_t>(65536, b.max_size() - b.size()));
+          std::min<std::size_t>(detail::default_max_transfer_size,
+            b.max_size() - b.size()));
     std::size_t pos = b.size();
     b.grow(bytes_to_read);
     std::size_t bytes_transferred = s.read_some(b.data(pos, bytes_to_read), ec);
@@ -761,7 +769,8 @@ std::size_t read_until(SyncReadStream& s, DynamicBuffer_v2 buffers,
     // Need more data.
     std::size_t bytes_to_read = std::min<std::size_t>(
           std::max<std::size_t>(512, b.capacity() - b.size()),
-          std::min<std::size_t>(65536, b.max_size() - b.size()));
+          std::min<std::size_t>(detail::default_max_transfer_size,
+            b.max_size() - b.size()));
     std::size_t pos = b.size();
     b.grow(bytes_to_read);
     std::size_t bytes_transferred = s.read_some(b.data(pos, bytes_to_read), ec);
@@ -861,7 +870,7 @@ namespace detail
               bytes_to_read = std::min<std::size_t>(
                     std::max<std::size_t>(512,
                       buffers_.capacity() - buffers_.size()),
-                    std::min<std::size_t>(65536,
+                    std::min<std::size_t>(detail::default_max_transfer_size,
                       buffers_.max_size() - buffers_.size()));
             }
           }
@@ -1145,7 +1154,7 @@ namespace detail
               bytes_to_read = std::min<std::size_t>(
                     std::max<std::size_t>(512,
                       buffers_.capacity() - buffers_.size()),
-                    std::min<std::size_t>(65536,
+                    std::min<std::size_t>(detail::default_max_transfer_size,
                       buffers_.max_size() - buffers_.size()));
             }
           }
@@ -1437,7 +1446,7 @@ namespace detail
               bytes_to_read = std::min<std::size_t>(
                     std::max<std::size_t>(512,
                       buffers_.capacity() - buffers_.size()),
-                    std::min<std::size_t>(65536,
+                    std::min<std::size_t>(detail::default_max_transfer_size,
                       buffers_.max_size() - buffers_.size()));
             }
           }
@@ -1722,7 +1731,7 @@ namespace detail
               bytes_to_read = std::min<std::size_t>(
                     std::max<std::size_t>(512,
                       buffers_.capacity() - buffers_.size()),
-                    std::min<std::size_t>(65536,
+                    std::min<std::size_t>(detail::default_max_transfer_size,
                       buffers_.max_size() - buffers_.size()));
             }
           }
@@ -2069,7 +2078,7 @@ namespace detail
               bytes_to_read_ = std::min<std::size_t>(
                     std::max<std::size_t>(512,
                       buffers_.capacity() - buffers_.size()),
-                    std::min<std::size_t>(65536,
+                    std::min<std::size_t>(detail::default_max_transfer_size,
                       buffers_.max_size() - buffers_.size()));
             }
           }
@@ -2358,7 +2367,7 @@ namespace detail
               bytes_to_read_ = std::min<std::size_t>(
                     std::max<std::size_t>(512,
                       buffers_.capacity() - buffers_.size()),
-                    std::min<std::size_t>(65536,
+                    std::min<std::size_t>(detail::default_max_transfer_size,
                       buffers_.max_size() - buffers_.size()));
             }
           }
@@ -2657,7 +2666,7 @@ namespace detail
               bytes_to_read_ = std::min<std::size_t>(
                     std::max<std::size_t>(512,
                       buffers_.capacity() - buffers_.size()),
-                    std::min<std::size_t>(65536,
+                    std::min<std::size_t>(detail::default_max_transfer_size,
                       buffers_.max_size() - buffers_.size()));
             }
           }
@@ -2948,7 +2957,7 @@ namespace detail
               bytes_to_read_ = std::min<std::size_t>(
                     std::max<std::size_t>(512,
                       buffers_.capacity() - buffers_.size()),
-                    std::min<std::size_t>(65536,
+                    std::min<std::size_t>(detail::default_max_transfer_size,
                       buffers_.max_size() - buffers_.size()));
             }
           }
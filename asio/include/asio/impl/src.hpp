@@ -19,6 +19,7 @@
 # error Do not compile Asio library source with ASIO_HEADER_ONLY defined
 #endif
 
+#include "asio/impl/cancellation_signal.ipp"
 #include "asio/impl/error.ipp"
 #include "asio/impl/error_code.ipp"
 #include "asio/impl/execution_context.ipp"
@@ -28,6 +29,7 @@
 #include "asio/impl/serial_port_base.ipp"
 #include "asio/impl/system_context.ipp"
 #include "asio/impl/thread_pool.ipp"
+#include "asio/detail/impl/allocation_tracking.ipp"
 #include "asio/detail/impl/buffer_sequence_adapter.ipp"
 #include "asio/detail/impl/descriptor_ops.ipp"
 #include "asio/detail/impl/dev_poll_reactor.ipp"
@@ -38,6 +40,7 @@
 #include "asio/detail/impl/null_event.ipp"
 #include "asio/detail/impl/pipe_select_interrupter.ipp"
 #include "asio/detail/impl/posix_event.ipp"
+#include "asio/detail/impl/posix_file_service.ipp"
 #include "asio/detail/impl/posix_mutex.ipp"
 #include "asio/detail/impl/posix_thread.ipp"
 #include "asio/detail/impl/posix_tss_ptr.ipp"
@@ -76,7 +79,9 @@
 #include "asio/ip/impl/host_name.ipp"
 #include "asio/ip/impl/network_v4.ipp"
 #include "asio/ip/impl/network_v6.ipp"
+#include "asio/ip/detail/impl/address_chars.ipp"
 #include "asio/ip/detail/impl/endpoint.ipp"
 #include "asio/local/detail/impl/endpoint.ipp"
+#include "asio/local/detail/impl/shared_ring.ipp"
 
 #endif // ASIO_IMPL_SRC_HPP
@@ -0,0 +1,1001 @@
+//
+// impl/transfer.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_TRANSFER_HPP
+#define ASIO_IMPL_TRANSFER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/associated_allocator.hpp"
+#include "asio/associated_executor.hpp"
+#include "asio/basic_stream_socket.hpp"
+#include "asio/buffer.hpp"
+#include "asio/completion_condition.hpp"
+#include "asio/post.hpp"
+#include "asio/write.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_cont_helpers.hpp"
+#include "asio/detail/handler_invoke_helpers.hpp"
+#include "asio/detail/handler_type_requirements.hpp"
+#include "asio/detail/limits.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/thread_context.hpp"
+#include "asio/detail/thread_info_base.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/posix/basic_stream_descriptor.hpp"
+
+#if !defined(ASIO_WINDOWS) \
+  && !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(__CYGWIN__)
+# include "asio/detail/descriptor_ops.hpp"
+#endif // !defined(ASIO_WINDOWS)
+       //   && !defined(ASIO_WINDOWS_RUNTIME)
+       //   && !defined(__CYGWIN__)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+namespace detail
+{
+  // Determines whether a stream type is a native descriptor that may be used
+  // directly with the splice and sendfile system calls.
+  template <typename Stream>
+  struct is_native_transfer_stream : false_type {};
+
+#if defined(ASIO_HAS_SPLICE) || defined(ASIO_HAS_SENDFILE)
+  template <typename Protocol, typename Executor>
+  struct is_native_transfer_stream<basic_stream_socket<Protocol, Executor> >
+    : true_type {};
+
+# if defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+  template <typename Executor>
+  struct is_native_transfer_stream<posix::basic_stream_descriptor<Executor> >
+    : true_type {};
+# endif // defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+#endif // defined(ASIO_HAS_SPLICE) || defined(ASIO_HAS_SENDFILE)
+
+  // Reads the data to be transferred from a stream.
+  template <typename AsyncReadStream>
+  class stream_transfer_source
+  {
+  public:
+    explicit stream_transfer_source(AsyncReadStream& stream)
+      : stream_(stream)
+    {
+    }
+
+    template <typename Executor, typename Handler>
+    void async_read_some(const mutable_buffer& buffer,
+        const Executor&, ASIO_MOVE_ARG(Handler) handler)
+    {
+      stream_.async_read_some(buffer, ASIO_MOVE_CAST(Handler)(handler));
+    }
+
+  private:
+    AsyncReadStream& stream_;
+  };
+
+#if !defined(ASIO_WINDOWS) \
+  && !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(__CYGWIN__)
+  // Reads the data to be transferred from a range of a regular file. Reads
+  // from a regular file do not block for long, and so are performed inline.
+  class file_transfer_source
+  {
+  public:
+    file_transfer_source(int file, uint64_t offset)
+      : file_(file),
+        offset_(offset)
+    {
+    }
+
+    template <typename Executor, typename Handler>
+    void async_read_some(const mutable_buffer& buffer,
+        const Executor& ex, ASIO_MOVE_ARG(Handler) handler)
+    {
+      asio::error_code ec;
+      std::size_t n = descriptor_ops::pread(file_,
+          buffer.data(), buffer.size(), offset_, ec);
+      offset_ += n;
+      asio::post(ex, detail::bind_handler(
+            ASIO_MOVE_CAST(Handler)(handler), ec, n));
+    }
+
+  private:
+    int file_;
+    uint64_t offset_;
+  };
+#endif // !defined(ASIO_WINDOWS)
+       //   && !defined(ASIO_WINDOWS_RUNTIME)
+       //   && !defined(__CYGWIN__)
+
+  // The buffer through which copied data passes. The memory is recycled
+  // through the calling thread's cache, so that back-to-back transfers on an
+  // io_context thread do not each allocate a new buffer.
+  class transfer_buffer
+    : private noncopyable
+  {
+  public:
+    explicit transfer_buffer(std::size_t size)
+      : data_(thread_info_base::allocate(
+            thread_info_base::transfer_buffer_tag(),
+            thread_context::thread_call_stack::top(), size)),
+        size_(size)
+    {
+    }
+
+    ~transfer_buffer()
+    {
+      thread_info_base::deallocate(thread_info_base::transfer_buffer_tag(),
+          thread_context::thread_call_stack::top(), data_, size_);
+    }
+
+    void* data() const
+    {
+      return data_;
+    }
+
+    std::size_t size() const
+    {
+      return size_;
+    }
+
+  private:
+    void* data_;
+    std::size_t size_;
+  };
+
+  // Transfers data by reading it into a buffer and then writing it out.
+  template <typename Source, typename AsyncWriteStream,
+      typename TransferHandler>
+  class copy_transfer_op
+  {
+  public:
+    copy_transfer_op(const Source& from, AsyncWriteStream& to,
+        std::size_t max_size, TransferHandler& handler)
+      : from_(from),
+        to_(to),
+        remaining_(max_size),
+        total_transferred_(0),
+        writing_(false),
+        buffer_(new transfer_buffer(
+              max_size < std::size_t(default_max_transfer_size)
+                ? max_size : std::size_t(default_max_transfer_size))),
+        start_(0),
+        handler_(ASIO_MOVE_CAST(TransferHandler)(handler))
+    {
+    }
+
+#if defined(ASIO_HAS_MOVE)
+    copy_transfer_op(const copy_transfer_op& other)
+      : from_(other.from_),
+        to_(other.to_),
+        remaining_(other.remaining_),
+        total_transferred_(other.total_transferred_),
+        writing_(other.writing_),
+        buffer_(other.buffer_),
+        start_(other.start_),
+        handler_(other.handler_)
+    {
+    }
+
+    copy_transfer_op(copy_transfer_op&& other)
+      : from_(other.from_),
+        to_(other.to_),
+        remaining_(other.remaining_),
+        total_transferred_(other.total_transferred_),
+        writing_(other.writing_),
+        buffer_(ASIO_MOVE_CAST(shared_ptr<transfer_buffer>)(other.buffer_)),
+        start_(other.start_),
+        handler_(ASIO_MOVE_CAST(TransferHandler)(other.handler_))
+    {
+    }
+#endif // defined(ASIO_HAS_MOVE)
+
+    void operator()(const asio::error_code& ec,
+        std::size_t bytes_transferred, int start = 0)
+    {
+      switch (start_ = start)
+      {
+        case 1:
+        for (;;)
+        {
+          {
+            writing_ = false;
+            std::size_t n = remaining_ < buffer_->size()
+              ? remaining_ : buffer_->size();
+            from_.async_read_some(asio::buffer(buffer_->data(), n),
+                to_.get_executor(),
+                ASIO_MOVE_CAST(copy_transfer_op)(*this));
+          }
+          return; default:
+          if (!writing_)
+          {
+            if (ec || bytes_transferred == 0)
+              break;
+            remaining_ -= bytes_transferred;
+            writing_ = true;
+            asio::async_write(to_,
+                asio::buffer(buffer_->data(), bytes_transferred),
+                ASIO_MOVE_CAST(copy_transfer_op)(*this));
+            return;
+          }
+          total_transferred_ += bytes_transferred;
+          if (ec || remaining_ == 0)
+            break;
+        }
+
+        buffer_.reset();
+        handler_(ec, static_cast<const std::size_t&>(total_transferred_));
+      }
+    }
+
+  //private:
+    Source from_;
+    AsyncWriteStream& to_;
+    std::size_t remaining_;
+    std::size_t total_transferred_;
+    bool writing_;
+    shared_ptr<transfer_buffer> buffer_;
+    int start_;
+    TransferHandler handler_;
+  };
+
+  template <typename Source, typename AsyncWriteStream,
+      typename TransferHandler>
+  inline void* asio_handler_allocate(std::size_t size,
+      copy_transfer_op<Source, AsyncWriteStream,
+        TransferHandler>* this_handler)
+  {
+    return asio_handler_alloc_helpers::allocate(
+        size, this_handler->handler_);
+  }
+
+  template <typename Source, typename AsyncWriteStream,
+      typename TransferHandler>
+  inline void asio_handler_deallocate(void* pointer, std::size_t size,
+      copy_transfer_op<Source, AsyncWriteStream,
+        TransferHandler>* this_handler)
+  {
+    asio_handler_alloc_helpers::deallocate(
+        pointer, size, this_handler->handler_);
+  }
+
+  template <typename Source, typename AsyncWriteStream,
+      typename TransferHandler>
+  inline bool asio_handler_is_continuation(
+      copy_transfer_op<Source, AsyncWriteStream,
+        TransferHandler>* this_handler)
+  {
+    return this_handler->start_ == 0 ? true
+      : asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename Function, typename Source,
+      typename AsyncWriteStream, typename TransferHandler>
+  inline void asio_handler_invoke(Function& function,
+      copy_transfer_op<Source, AsyncWriteStream,
+        TransferHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename Function, typename Source,
+      typename AsyncWriteStream, typename TransferHandler>
+  inline void asio_handler_invoke(const Function& function,
+      copy_transfer_op<Source, AsyncWriteStream,
+        TransferHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+#if defined(ASIO_HAS_SPLICE)
+  // Owns the pipe through which spliced data is moved.
+  class transfer_pipe
+    : private noncopyable
+  {
+  public:
+    transfer_pipe()
+    {
+      descriptors_[0] = -1;
+      descriptors_[1] = -1;
+    }
+
+    ~transfer_pipe()
+    {
+      descriptor_ops::state_type state = 0;
+      asio::error_code ignored_ec;
+      if (descriptors_[0] != -1)
+        descriptor_ops::close(descriptors_[0], state, ignored_ec);
+      if (descriptors_[1] != -1)
+        descriptor_ops::close(descriptors_[1], state, ignored_ec);
+    }
+
+    void open(asio::error_code& ec)
+    {
+      descriptor_ops::pipe(descriptors_, ec);
+    }
+
+    int read_descriptor() const
+    {
+      return descriptors_[0];
+    }
+
+    int write_descriptor() const
+    {
+      return descriptors_[1];
+    }
+
+  private:
+    int descriptors_[2];
+  };
+
+  // Transfers data between native descriptors without copying it through
+  // user space, by splicing it into a pipe and then out again.
+  template <typename AsyncReadStream, typename AsyncWriteStream,
+      typename TransferHandler>
+  class splice_transfer_op
+  {
+  public:
+    splice_transfer_op(AsyncReadStream& from, AsyncWriteStream& to,
+        std::size_t max_size, const shared_ptr<transfer_pipe>& pipe,
+        bool from_non_blocking, bool to_non_blocking,
+        TransferHandler& handler)
+      : from_(from),
+        to_(to),
+        remaining_(max_size),
+        in_pipe_(0),
+        total_transferred_(0),
+        pipe_(pipe),
+        from_non_blocking_(from_non_blocking),
+        to_non_blocking_(to_non_blocking),
+        start_(0),
+        handler_(ASIO_MOVE_CAST(TransferHandler)(handler))
+    {
+    }
+
+#if defined(ASIO_HAS_MOVE)
+    splice_transfer_op(const splice_transfer_op& other)
+      : from_(other.from_),
+        to_(other.to_),
+        remaining_(other.remaining_),
+        in_pipe_(other.in_pipe_),
+        total_transferred_(other.total_transferred_),
+        pipe_(other.pipe_),
+        from_non_blocking_(other.from_non_blocking_),
+        to_non_blocking_(other.to_non_blocking_),
+        start_(other.start_),
+        handler_(other.handler_)
+    {
+    }
+
+    splice_transfer_op(splice_transfer_op&& other)
+      : from_(other.from_),
+        to_(other.to_),
+        remaining_(other.remaining_),
+        in_pipe_(other.in_pipe_),
+        total_transferred_(other.total_transferred_),
+        pipe_(ASIO_MOVE_CAST(shared_ptr<transfer_pipe>)(other.pipe_)),
+        from_non_blocking_(other.from_non_blocking_),
+        to_non_blocking_(other.to_non_blocking_),
+        start_(other.start_),
+        handler_(ASIO_MOVE_CAST(TransferHandler)(other.handler_))
+    {
+    }
+#endif // defined(ASIO_HAS_MOVE)
+
+    void operator()(asio::error_code ec, int start = 0)
+    {
+      if ((start_ = start) == 1)
+      {
+        // Always start with a wait so that the handler is not invoked from
+        // within the initiating function.
+        from_.async_wait(AsyncReadStream::wait_read,
+            ASIO_MOVE_CAST(splice_transfer_op)(*this));
+        return;
+      }
+
+      while (!ec)
+      {
+        std::size_t n = 0;
+        if (in_pipe_ > 0)
+        {
+          // Drain the pipe into the destination.
+          if (!descriptor_ops::non_blocking_splice(pipe_->read_descriptor(),
+                to_.native_handle(), in_pipe_, ec, n))
+          {
+            to_.async_wait(AsyncWriteStream::wait_write,
+                ASIO_MOVE_CAST(splice_transfer_op)(*this));
+            return;
+          }
+          in_pipe_ -= n;
+          total_transferred_ += n;
+        }
+        else if (remaining_ > 0)
+        {
+          // Fill the pipe from the source. The pipe is always empty here, so
+          // the only reason this can fail to make progress is the source.
+          const std::size_t limit = default_max_transfer_size;
+          std::size_t max_size = remaining_ < limit ? remaining_ : limit;
+          if (!descriptor_ops::non_blocking_splice(from_.native_handle(),
+                pipe_->write_descriptor(), max_size, ec, n))
+          {
+            from_.async_wait(AsyncReadStream::wait_read,
+                ASIO_MOVE_CAST(splice_transfer_op)(*this));
+            return;
+          }
+          in_pipe_ += n;
+          remaining_ -= n;
+        }
+        else
+        {
+          break;
+        }
+      }
+
+      // Return both streams to the mode they were in before the transfer.
+      pipe_.reset();
+      asio::error_code ignored_ec;
+      from_.native_non_blocking(from_non_blocking_, ignored_ec);
+      to_.native_non_blocking(to_non_blocking_, ignored_ec);
+      handler_(ec, static_cast<const std::size_t&>(total_transferred_));
+    }
+
+  //private:
+    AsyncReadStream& from_;
+    AsyncWriteStream& to_;
+    std::size_t remaining_;
+    std::size_t in_pipe_;
+    std::size_t total_transferred_;
+    shared_ptr<transfer_pipe> pipe_;
+    bool from_non_blocking_;
+    bool to_non_blocking_;
+    int start_;
+    TransferHandler handler_;
+  };
+
+  template <typename AsyncReadStream, typename AsyncWriteStream,
+      typename TransferHandler>
+  inline void* asio_handler_allocate(std::size_t size,
+      splice_transfer_op<AsyncReadStream, AsyncWriteStream,
+        TransferHandler>* this_handler)
+  {
+    return asio_handler_alloc_helpers::allocate(
+        size, this_handler->handler_);
+  }
+
+  template <typename AsyncReadStream, typename AsyncWriteStream,
+      typename TransferHandler>
+  inline void asio_handler_deallocate(void* pointer, std::size_t size,
+      splice_transfer_op<AsyncReadStream, AsyncWriteStream,
+        TransferHandler>* this_handler)
+  {
+    asio_handler_alloc_helpers::deallocate(
+        pointer, size, this_handler->handler_);
+  }
+
+  template <typename AsyncReadStream, typename AsyncWriteStream,
+      typename TransferHandler>
+  inline bool asio_handler_is_continuation(
+      splice_transfer_op<AsyncReadStream, AsyncWriteStream,
+        TransferHandler>* this_handler)
+  {
+    return this_handler->start_ == 0 ? true
+      : asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename Function, typename AsyncReadStream,
+      typename AsyncWriteStream, typename TransferHandler>
+  inline void asio_handler_invoke(Function& function,
+      splice_transfer_op<AsyncReadStream, AsyncWriteStream,
+        TransferHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename Function, typename AsyncReadStream,
+      typename AsyncWriteStream, typename TransferHandler>
+  inline void asio_handler_invoke(const Function& function,
+      splice_transfer_op<AsyncReadStream, AsyncWriteStream,
+        TransferHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename AsyncReadStream, typename AsyncWriteStream,
+      typename TransferHandler>
+  inline void start_transfer_op(AsyncReadStream& from,
+      AsyncWriteStream& to, std::size_t max_size,
+      TransferHandler& handler, true_type)
+  {
+    asio::error_code ec;
+    shared_ptr<transfer_pipe> pipe(new transfer_pipe);
+    pipe->open(ec);
+
+    // Remember the current modes so that they can be restored when the
+    // transfer completes.
+    const bool from_non_blocking = from.native_non_blocking();
+    const bool to_non_blocking = to.native_non_blocking();
+    if (!ec)
+      from.native_non_blocking(true, ec);
+    if (!ec)
+      to.native_non_blocking(true, ec);
+
+    if (ec)
+    {
+      asio::error_code ignored_ec;
+      from.native_non_blocking(from_non_blocking, ignored_ec);
+      to.native_non_blocking(to_non_blocking, ignored_ec);
+      asio::post(to.get_executor(), detail::bind_handler(
+            ASIO_MOVE_CAST(TransferHandler)(handler), ec, std::size_t(0)));
+      return;
+    }
+
+    detail::splice_transfer_op<AsyncReadStream,
+      AsyncWriteStream, TransferHandler>(
+        from, to, max_size, pipe, from_non_blocking,
+        to_non_blocking, handler)(asio::error_code(), 1);
+  }
+#endif // defined(ASIO_HAS_SPLICE)
+
+  template <typename AsyncReadStream, typename AsyncWriteStream,
+      typename TransferHandler>
+  inline void start_transfer_op(AsyncReadStream& from,
+      AsyncWriteStream& to, std::size_t max_size,
+      TransferHandler& handler, false_type)
+  {
+    detail::copy_transfer_op<stream_transfer_source<AsyncReadStream>,
+      AsyncWriteStream, TransferHandler>(
+        stream_transfer_source<AsyncReadStream>(from),
+        to, max_size, handler)(asio::error_code(), 0, 1);
+  }
+
+  template <typename AsyncReadStream, typename AsyncWriteStream>
+  class initiate_async_transfer
+  {
+  public:
+    typedef typename AsyncWriteStream::executor_type executor_type;
+
+    initiate_async_transfer(AsyncReadStream& from, AsyncWriteStream& to)
+      : from_(from),
+        to_(to)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return to_.get_executor();
+    }
+
+    template <typename TransferHandler>
+    void operator()(ASIO_MOVE_ARG(TransferHandler) handler,
+        std::size_t max_size) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(TransferHandler, handler) type_check;
+
+      non_const_lvalue<TransferHandler> handler2(handler);
+#if defined(ASIO_HAS_SPLICE)
+      start_transfer_op(from_, to_, max_size, handler2.value,
+          integral_constant<bool,
+            is_native_transfer_stream<AsyncReadStream>::value
+              && is_native_transfer_stream<AsyncWriteStream>::value>());
+#else // defined(ASIO_HAS_SPLICE)
+      start_transfer_op(from_, to_, max_size, handler2.value, false_type());
+#endif // defined(ASIO_HAS_SPLICE)
+    }
+
+  private:
+    AsyncReadStream& from_;
+    AsyncWriteStream& to_;
+  };
+
+#if !defined(ASIO_WINDOWS) \
+  && !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(__CYGWIN__)
+
+#if defined(ASIO_HAS_SENDFILE)
+  // Writes a range of a file to a native descriptor using sendfile.
+  template <typename AsyncWriteStream, typename TransferHandler>
+  class sendfile_op
+  {
+  public:
+    sendfile_op(AsyncWriteStream& to, int file, uint64_t offset,
+        std::size_t size, bool to_non_blocking, TransferHandler& handler)
+      : to_(to),
+        file_(file),
+        offset_(offset),
+        remaining_(size),
+        total_transferred_(0),
+        to_non_blocking_(to_non_blocking),
+        start_(0),
+        handler_(ASIO_MOVE_CAST(TransferHandler)(handler))
+    {
+    }
+
+#if defined(ASIO_HAS_MOVE)
+    sendfile_op(const sendfile_op& other)
+      : to_(other.to_),
+        file_(other.file_),
+        offset_(other.offset_),
+        remaining_(other.remaining_),
+        total_transferred_(other.total_transferred_),
+        to_non_blocking_(other.to_non_blocking_),
+        start_(other.start_),
+        handler_(other.handler_)
+    {
+    }
+
+    sendfile_op(sendfile_op&& other)
+      : to_(other.to_),
+        file_(other.file_),
+        offset_(other.offset_),
+        remaining_(other.remaining_),
+        total_transferred_(other.total_transferred_),
+        to_non_blocking_(other.to_non_blocking_),
+        start_(other.start_),
+        handler_(ASIO_MOVE_CAST(TransferHandler)(other.handler_))
+    {
+    }
+#endif // defined(ASIO_HAS_MOVE)
+
+    void operator()(asio::error_code ec, int start = 0)
+    {
+      if ((start_ = start) == 1)
+      {
+        // Always start with a wait so that the handler is not invoked from
+        // within the initiating function.
+        to_.async_wait(AsyncWriteStream::wait_write,
+            ASIO_MOVE_CAST(sendfile_op)(*this));
+        return;
+      }
+
+      while (!ec && remaining_ > 0)
+      {
+        // Limit each call to the largest size Linux will send at once.
+        std::size_t n = 0;
+        std::size_t max_size = remaining_ < 0x7ffff000
+          ? remaining_ : 0x7ffff000;
+        if (!descriptor_ops::non_blocking_sendfile(to_.native_handle(),
+              file_, offset_, max_size, ec, n))
+        {
+          to_.async_wait(AsyncWriteStream::wait_write,
+              ASIO_MOVE_CAST(sendfile_op)(*this));
+          return;
+        }
+        remaining_ -= n;
+        total_transferred_ += n;
+      }
+
+      // Return the stream to the mode it was in before the transfer.
+      asio::error_code ignored_ec;
+      to_.native_non_blocking(to_non_blocking_, ignored_ec);
+      handler_(ec, static_cast<const std::size_t&>(total_transferred_));
+    }
+
+  //private:
+    AsyncWriteStream& to_;
+    int file_;
+    uint64_t offset_;
+    std::size_t remaining_;
+    std::size_t total_transferred_;
+    bool to_non_blocking_;
+    int start_;
+    TransferHandler handler_;
+  };
+
+  template <typename AsyncWriteStream, typename TransferHandler>
+  inline void* asio_handler_allocate(std::size_t size,
+      sendfile_op<AsyncWriteStream, TransferHandler>* this_handler)
+  {
+    return asio_handler_alloc_helpers::allocate(
+        size, this_handler->handler_);
+  }
+
+  template <typename AsyncWriteStream, typename TransferHandler>
+  inline void asio_handler_deallocate(void* pointer, std::size_t size,
+      sendfile_op<AsyncWriteStream, TransferHandler>* this_handler)
+  {
+    asio_handler_alloc_helpers::deallocate(
+        pointer, size, this_handler->handler_);
+  }
+
+  template <typename AsyncWriteStream, typename TransferHandler>
+  inline bool asio_handler_is_continuation(
+      sendfile_op<AsyncWriteStream, TransferHandler>* this_handler)
+  {
+    return this_handler->start_ == 0 ? true
+      : asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename Function, typename AsyncWriteStream,
+      typename TransferHandler>
+  inline void asio_handler_invoke(Function& function,
+      sendfile_op<AsyncWriteStream, TransferHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename Function, typename AsyncWriteStream,
+      typename TransferHandler>
+  inline void asio_handler_invoke(const Function& function,
+      sendfile_op<AsyncWriteStream, TransferHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename AsyncWriteStream, typename TransferHandler>
+  inline void start_sendfile_op(AsyncWriteStream& to, int file,
+      uint64_t offset, std::size_t size,
+      TransferHandler& handler, true_type)
+  {
+    asio::error_code ec;
+    const bool to_non_blocking = to.native_non_blocking();
+    to.native_non_blocking(true, ec);
+    if (ec)
+    {
+      asio::post(to.get_executor(), detail::bind_handler(
+            ASIO_MOVE_CAST(TransferHandler)(handler), ec, std::size_t(0)));
+      return;
+    }
+
+    detail::sendfile_op<AsyncWriteStream, TransferHandler>(
+        to, file, offset, size, to_non_blocking,
+        handler)(asio::error_code(), 1);
+  }
+#endif // defined(ASIO_HAS_SENDFILE)
+
+  template <typename AsyncWriteStream, typename TransferHandler>
+  inline void start_sendfile_op(AsyncWriteStream& to, int file,
+      uint64_t offset, std::size_t size,
+      TransferHandler& handler, false_type)
+  {
+    detail::copy_transfer_op<file_transfer_source,
+      AsyncWriteStream, TransferHandler>(
+        file_transfer_source(file, offset),
+        to, size, handler)(asio::error_code(), 0, 1);
+  }
+
+  template <typename AsyncWriteStream>
+  class initiate_async_sendfile
+  {
+  public:
+    typedef typename AsyncWriteStream::executor_type executor_type;
+
+    explicit initiate_async_sendfile(AsyncWriteStream& to)
+      : to_(to)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return to_.get_executor();
+    }
+
+    template <typename TransferHandler>
+    void operator()(ASIO_MOVE_ARG(TransferHandler) handler,
+        int file, uint64_t offset, std::size_t size) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(TransferHandler, handler) type_check;
+
+      non_const_lvalue<TransferHandler> handler2(handler);
+#if defined(ASIO_HAS_SENDFILE)
+      start_sendfile_op(to_, file, offset, size, handler2.value,
+          is_native_transfer_stream<AsyncWriteStream>());
+#else // defined(ASIO_HAS_SENDFILE)
+      start_sendfile_op(to_, file, offset, size,
+          handler2.value, false_type());
+#endif // defined(ASIO_HAS_SENDFILE)
+    }
+
+  private:
+    AsyncWriteStream& to_;
+  };
+
+#endif // !defined(ASIO_WINDOWS)
+       //   && !defined(ASIO_WINDOWS_RUNTIME)
+       //   && !defined(__CYGWIN__)
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <typename Source, typename AsyncWriteStream,
+    typename TransferHandler, typename Allocator>
+struct associated_allocator<
+    detail::copy_transfer_op<Source, AsyncWriteStream, TransferHandler>,
+    Allocator>
+{
+  typedef typename associated_allocator<TransferHandler, Allocator>::type type;
+
+  static type get(
+      const detail::copy_transfer_op<Source,
+        AsyncWriteStream, TransferHandler>& h,
+      const Allocator& a = Allocator()) ASIO_NOEXCEPT
+  {
+    return associated_allocator<TransferHandler, Allocator>::get(
+        h.handler_, a);
+  }
+};
+
+template <typename Source, typename AsyncWriteStream,
+    typename TransferHandler, typename Executor>
+struct associated_executor<
+    detail::copy_transfer_op<Source, AsyncWriteStream, TransferHandler>,
+    Executor>
+{
+  typedef typename associated_executor<TransferHandler, Executor>::type type;
+
+  static type get(
+      const detail::copy_transfer_op<Source,
+        AsyncWriteStream, TransferHandler>& h,
+      const Executor& ex = Executor()) ASIO_NOEXCEPT
+  {
+    return associated_executor<TransferHandler, Executor>::get(
+        h.handler_, ex);
+  }
+};
+
+#if defined(ASIO_HAS_SPLICE)
+
+template <typename AsyncReadStream, typename AsyncWriteStream,
+    typename TransferHandler, typename Allocator>
+struct associated_allocator<
+    detail::splice_transfer_op<AsyncReadStream,
+      AsyncWriteStream, TransferHandler>,
+    Allocator>
+{
+  typedef typename associated_allocator<TransferHandler, Allocator>::type type;
+
+  static type get(
+      const detail::splice_transfer_op<AsyncReadStream,
+        AsyncWriteStream, TransferHandler>& h,
+      const Allocator& a = Allocator()) ASIO_NOEXCEPT
+  {
+    return associated_allocator<TransferHandler, Allocator>::get(
+        h.handler_, a);
+  }
+};
+
+template <typename AsyncReadStream, typename AsyncWriteStream,
+    typename TransferHandler, typename Executor>
+struct associated_executor<
+    detail::splice_transfer_op<AsyncReadStream,
+      AsyncWriteStream, TransferHandler>,
+    Executor>
+{
+  typedef typename associated_executor<TransferHandler, Executor>::type type;
+
+  static type get(
+      const detail::splice_transfer_op<AsyncReadStream,
+        AsyncWriteStream, TransferHandler>& h,
+      const Executor& ex = Executor()) ASIO_NOEXCEPT
+  {
+    return associated_executor<TransferHandler, Executor>::get(
+        h.handler_, ex);
+  }
+};
+
+#endif // defined(ASIO_HAS_SPLICE)
+
+#if defined(ASIO_HAS_SENDFILE)
+
+template <typename AsyncWriteStream,
+    typename TransferHandler, typename Allocator>
+struct associated_allocator<
+    detail::sendfile_op<AsyncWriteStream, TransferHandler>,
+    Allocator>
+{
+  typedef typename associated_allocator<TransferHandler, Allocator>::type type;
+
+  static type get(
+      const detail::sendfile_op<AsyncWriteStream, TransferHandler>& h,
+      const Allocator& a = Allocator()) ASIO_NOEXCEPT
+  {
+    return associated_allocator<TransferHandler, Allocator>::get(
+        h.handler_, a);
+  }
+};
+
+template <typename AsyncWriteStream,
+    typename TransferHandler, typename Executor>
+struct associated_executor<
+    detail::sendfile_op<AsyncWriteStream, TransferHandler>,
+    Executor>
+{
+  typedef typename associated_executor<TransferHandler, Executor>::type type;
+
+  static type get(
+      const detail::sendfile_op<AsyncWriteStream, TransferHandler>& h,
+      const Executor& ex = Executor()) ASIO_NOEXCEPT
+  {
+    return associated_executor<TransferHandler, Executor>::get(
+        h.handler_, ex);
+  }
+};
+
+#endif // defined(ASIO_HAS_SENDFILE)
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+template <typename AsyncReadStream, typename AsyncWriteStream,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) TransferHandler>
+inline ASIO_INITFN_AUTO_RESULT_TYPE(TransferHandler,
+    void (asio::error_code, std::size_t))
+async_transfer(AsyncReadStream& from, AsyncWriteStream& to,
+    std::size_t max_size, ASIO_MOVE_ARG(TransferHandler) handler)
+{
+  return async_initiate<TransferHandler,
+    void (asio::error_code, std::size_t)>(
+      detail::initiate_async_transfer<AsyncReadStream,
+        AsyncWriteStream>(from, to), handler, max_size);
+}
+
+template <typename AsyncReadStream, typename AsyncWriteStream,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) TransferHandler>
+inline ASIO_INITFN_AUTO_RESULT_TYPE(TransferHandler,
+    void (asio::error_code, std::size_t))
+async_transfer(AsyncReadStream& from, AsyncWriteStream& to,
+    ASIO_MOVE_ARG(TransferHandler) handler)
+{
+  return async_initiate<TransferHandler,
+    void (asio::error_code, std::size_t)>(
+      detail::initiate_async_transfer<AsyncReadStream,
+        AsyncWriteStream>(from, to), handler,
+      (std::numeric_limits<std::size_t>::max)());
+}
+
+#if !defined(ASIO_WINDOWS) \
+  && !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(__CYGWIN__)
+
+template <typename AsyncWriteStream,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) TransferHandler>
+inline ASIO_INITFN_AUTO_RESULT_TYPE(TransferHandler,
+    void (asio::error_code, std::size_t))
+async_sendfile(AsyncWriteStream& to, int file,
+    uint64_t offset, std::size_t size,
+    ASIO_MOVE_ARG(TransferHandler) handler)
+{
+  return async_initiate<TransferHandler,
+    void (asio::error_code, std::size_t)>(
+      detail::initiate_async_sendfile<AsyncWriteStream>(to),
+      handler, file, offset, size);
+}
+
+#endif // !defined(ASIO_WINDOWS)
+       //   && !defined(ASIO_WINDOWS_RUNTIME)
+       //   && !defined(__CYGWIN__)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_TRANSFER_HPP
@@ -0,0 +1,552 @@
+//
+// impl/with_timeout.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_WITH_TIMEOUT_HPP
+#define ASIO_IMPL_WITH_TIMEOUT_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/associated_allocator.hpp"
+#include "asio/associated_cancellation_slot.hpp"
+#include "asio/associated_executor.hpp"
+#include "asio/async_result.hpp"
+#include "asio/basic_waitable_timer.hpp"
+#include "asio/bind_executor.hpp"
+#include "asio/cancellation_signal.hpp"
+#include "asio/error.hpp"
+#include "asio/detail/atomic_count.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_cont_helpers.hpp"
+#include "asio/detail/handler_invoke_helpers.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/recycling_allocator.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/detail/variadic_templates.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// State shared between the operation's completion handler and the timer. The
+// mutex orders the timer's expiry against the operation's completion, so that
+// the signal is never emitted once the operation's handler has been invoked.
+template <typename IoExecutor>
+class with_timeout_state
+  : private noncopyable
+{
+public:
+  typedef basic_waitable_timer<chrono::steady_clock,
+    wait_traits<chrono::steady_clock>, IoExecutor> timer_type;
+
+  static with_timeout_state* create(const IoExecutor& ex)
+  {
+    recycling_allocator<with_timeout_state> alloc;
+    with_timeout_state* p = alloc.allocate(1);
+    try
+    {
+      return new (p) with_timeout_state(ex);
+    }
+    catch (...)
+    {
+      alloc.deallocate(p, 1);
+      throw;
+    }
+  }
+
+  void add_ref()
+  {
+    ++ref_count_;
+  }
+
+  void release()
+  {
+    if (--ref_count_ == 0)
+    {
+      recycling_allocator<with_timeout_state> alloc;
+      this->~with_timeout_state();
+      alloc.deallocate(this, 1);
+    }
+  }
+
+  cancellation_slot slot() ASIO_NOEXCEPT
+  {
+    return signal_.slot();
+  }
+
+  // Start the timer, unless the operation has already completed.
+  template <typename Handler>
+  void start_timer(const chrono::steady_clock::duration& timeout,
+      ASIO_MOVE_ARG(Handler) handler)
+  {
+    mutex::scoped_lock lock(mutex_);
+    if (!completed_)
+    {
+      timer_.expires_after(timeout);
+      timer_.async_wait(ASIO_MOVE_CAST(Handler)(handler));
+      timer_started_ = true;
+    }
+  }
+
+  // Called by the timer's handler when the timeout expires.
+  void expire()
+  {
+    mutex::scoped_lock lock(mutex_);
+    if (!completed_)
+    {
+      expired_ = true;
+      signal_.emit();
+    }
+  }
+
+  // Called by the operation's handler to stop the timer and translate the
+  // cancellation caused by the timeout into a timed_out error.
+  asio::error_code complete(const asio::error_code& ec)
+  {
+    mutex::scoped_lock lock(mutex_);
+    completed_ = true;
+    signal_.slot().clear();
+    if (timer_started_)
+      timer_.cancel();
+    if (expired_ && ec == asio::error::operation_aborted)
+      return asio::error::timed_out;
+    return ec;
+  }
+
+private:
+  explicit with_timeout_state(const IoExecutor& ex)
+    : timer_(ex),
+      ref_count_(1),
+      timer_started_(false),
+      completed_(false),
+      expired_(false)
+  {
+  }
+
+  ~with_timeout_state()
+  {
+  }
+
+  mutex mutex_;
+  timer_type timer_;
+  cancellation_signal signal_;
+  atomic_count ref_count_;
+  bool timer_started_;
+  bool completed_;
+  bool expired_;
+};
+
+// Holds a counted reference to the shared state.
+template <typename IoExecutor>
+class with_timeout_state_ptr
+{
+public:
+  explicit with_timeout_state_ptr(with_timeout_state<IoExecutor>* state)
+    : state_(state)
+  {
+  }
+
+  with_timeout_state_ptr(const with_timeout_state_ptr& other)
+    : state_(other.state_)
+  {
+    if (state_)
+      state_->add_ref();
+  }
+
+#if defined(ASIO_HAS_MOVE)
+  with_timeout_state_ptr(with_timeout_state_ptr&& other)
+    : state_(other.state_)
+  {
+    other.state_ = 0;
+  }
+#endif // defined(ASIO_HAS_MOVE)
+
+  ~with_timeout_state_ptr()
+  {
+    reset();
+  }
+
+  with_timeout_state<IoExecutor>* get() const
+  {
+    return state_;
+  }
+
+  void reset()
+  {
+    if (state_)
+    {
+      state_->release();
+      state_ = 0;
+    }
+  }
+
+private:
+  with_timeout_state_ptr& operator=(const with_timeout_state_ptr&);
+
+  with_timeout_state<IoExecutor>* state_;
+};
+
+// Completion handler for the timer.
+template <typename IoExecutor>
+class with_timeout_timer_handler
+{
+public:
+  explicit with_timeout_timer_handler(with_timeout_state<IoExecutor>* state)
+    : state_(state)
+  {
+  }
+
+  void operator()(const asio::error_code& ec)
+  {
+    if (!ec)
+      state_.get()->expire();
+    state_.reset();
+  }
+
+private:
+  with_timeout_state_ptr<IoExecutor> state_;
+};
+
+// Class to adapt a with_timeout_t as a completion handler.
+template <typename Handler, typename IoExecutor>
+class with_timeout_handler
+{
+public:
+  typedef void result_type;
+
+  template <typename TimedHandler>
+  with_timeout_handler(with_timeout_state<IoExecutor>* state,
+      ASIO_MOVE_ARG(TimedHandler) h)
+    : state_(state),
+      handler_(ASIO_MOVE_CAST(TimedHandler)(h))
+  {
+  }
+
+  void operator()()
+  {
+    complete(asio::error_code());
+    handler_();
+  }
+
+#if defined(ASIO_HAS_VARIADIC_TEMPLATES)
+
+  template <typename Arg, typename... Args>
+  typename enable_if<
+    !is_same<typename decay<Arg>::type, asio::error_code>::value
+  >::type
+  operator()(ASIO_MOVE_ARG(Arg) arg, ASIO_MOVE_ARG(Args)... args)
+  {
+    complete(asio::error_code());
+    handler_(ASIO_MOVE_CAST(Arg)(arg),
+        ASIO_MOVE_CAST(Args)(args)...);
+  }
+
+  template <typename... Args>
+  void operator()(const asio::error_code& ec,
+      ASIO_MOVE_ARG(Args)... args)
+  {
+    handler_(complete(ec), ASIO_MOVE_CAST(Args)(args)...);
+  }
+
+#else // defined(ASIO_HAS_VARIADIC_TEMPLATES)
+
+  template <typename Arg>
+  typename enable_if<
+    !is_same<typename decay<Arg>::type, asio::error_code>::value
+  >::type
+  operator()(ASIO_MOVE_ARG(Arg) arg)
+  {
+    complete(asio::error_code());
+    handler_(ASIO_MOVE_CAST(Arg)(arg));
+  }
+
+  void operator()(const asio::error_code& ec)
+  {
+    handler_(complete(ec));
+  }
+
+#define ASIO_PRIVATE_WITH_TIMEOUT_DEF(n) \
+  template <typename Arg, ASIO_VARIADIC_TPARAMS(n)> \
+  typename enable_if< \
+    !is_same<typename decay<Arg>::type, asio::error_code>::value \
+  >::type \
+  operator()(ASIO_MOVE_ARG(Arg) arg, ASIO_VARIADIC_MOVE_PARAMS(n)) \
+  { \
+    complete(asio::error_code()); \
+    handler_(ASIO_MOVE_CAST(Arg)(arg), \
+        ASIO_VARIADIC_MOVE_ARGS(n)); \
+  } \
+  \
+  template <ASIO_VARIADIC_TPARAMS(n)> \
+  void operator()(const asio::error_code& ec, \
+      ASIO_VARIADIC_MOVE_PARAMS(n)) \
+  { \
+    handler_(complete(ec), ASIO_VARIADIC_MOVE_ARGS(n)); \
+  } \
+  /**/
+  ASIO_VARIADIC_GENERATE(ASIO_PRIVATE_WITH_TIMEOUT_DEF)
+#undef ASIO_PRIVATE_WITH_TIMEOUT_DEF
+
+#endif // defined(ASIO_HAS_VARIADIC_TEMPLATES)
+
+  asio::error_code complete(const asio::error_code& ec)
+  {
+    asio::error_code result = state_.get()->complete(ec);
+    state_.reset();
+    return result;
+  }
+
+//private:
+  with_timeout_state_ptr<IoExecutor> state_;
+  Handler handler_;
+};
+
+template <typename Handler, typename IoExecutor>
+inline void* asio_handler_allocate(std::size_t size,
+    with_timeout_handler<Handler, IoExecutor>* this_handler)
+{
+  return asio_handler_alloc_helpers::allocate(
+      size, this_handler->handler_);
+}
+
+template <typename Handler, typename IoExecutor>
+inline void asio_handler_deallocate(void* pointer, std::size_t size,
+    with_timeout_handler<Handler, IoExecutor>* this_handler)
+{
+  asio_handler_alloc_helpers::deallocate(
+      pointer, size, this_handler->handler_);
+}
+
+template <typename Handler, typename IoExecutor>
+inline bool asio_handler_is_continuation(
+    with_timeout_handler<Handler, IoExecutor>* this_handler)
+{
+  return asio_handler_cont_helpers::is_continuation(
+        this_handler->handler_);
+}
+
+template <typename Function, typename Handler, typename IoExecutor>
+inline void asio_handler_invoke(Function& function,
+    with_timeout_handler<Handler, IoExecutor>* this_handler)
+{
+  asio_handler_invoke_helpers::invoke(
+      function, this_handler->handler_);
+}
+
+template <typename Function, typename Handler, typename IoExecutor>
+inline void asio_handler_invoke(const Function& function,
+    with_timeout_handler<Handler, IoExecutor>* this_handler)
+{
+  asio_handler_invoke_helpers::invoke(
+      function, this_handler->handler_);
+}
+
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <typename CompletionToken, typename Signature>
+struct async_result<with_timeout_t<CompletionToken>, Signature>
+{
+  typedef typename async_result<CompletionToken, Signature>::return_type
+    return_type;
+
+  template <typename Initiation>
+  struct init_wrapper
+  {
+    typedef typename associated_executor<Initiation>::type io_executor_type;
+    typedef detail::with_timeout_state<io_executor_type> state_type;
+    typedef detail::with_timeout_state_ptr<io_executor_type> state_ptr;
+
+    template <typename Init>
+    init_wrapper(const chrono::steady_clock::duration& timeout,
+        ASIO_MOVE_ARG(Init) init)
+      : timeout_(timeout),
+        initiation_(ASIO_MOVE_CAST(Init)(init))
+    {
+    }
+
+    // The timer is started after the operation has been initiated, so that it
+    // cannot expire before the operation has installed its cancellation
+    // handler. The timer's handler runs on the completion handler's executor.
+    template <typename Executor>
+    void start_timer(state_type* state, const Executor& ex) const
+    {
+      state->add_ref();
+      state->start_timer(timeout_, asio::bind_executor(ex,
+            detail::with_timeout_timer_handler<io_executor_type>(state)));
+    }
+
+#if defined(ASIO_HAS_VARIADIC_TEMPLATES)
+
+    template <typename Handler, typename... Args>
+    void operator()(
+        ASIO_MOVE_ARG(Handler) handler,
+        ASIO_MOVE_ARG(Args)... args)
+    {
+      typedef typename decay<Handler>::type handler_type;
+      io_executor_type io_ex = (get_associated_executor)(initiation_);
+      typename associated_executor<handler_type, io_executor_type>::type
+        handler_ex = (get_associated_executor)(handler, io_ex);
+      state_ptr state(state_type::create(io_ex));
+      state.get()->add_ref();
+      ASIO_MOVE_CAST(Initiation)(initiation_)(
+          detail::with_timeout_handler<handler_type, io_executor_type>(
+            state.get(), ASIO_MOVE_CAST(Handler)(handler)),
+          ASIO_MOVE_CAST(Args)(args)...);
+      start_timer(state.get(), handler_ex);
+    }
+
+#else // defined(ASIO_HAS_VARIADIC_TEMPLATES)
+
+    template <typename Handler>
+    void operator()(
+        ASIO_MOVE_ARG(Handler) handler) const
+    {
+      typedef typename decay<Handler>::type handler_type;
+      io_executor_type io_ex = (get_associated_executor)(initiation_);
+      typename associated_executor<handler_type, io_executor_type>::type
+        handler_ex = (get_associated_executor)(handler, io_ex);
+      state_ptr state(state_type::create(io_ex));
+      state.get()->add_ref();
+      ASIO_MOVE_CAST(Initiation)(initiation_)(
+          detail::with_timeout_handler<handler_type, io_executor_type>(
+            state.get(), ASIO_MOVE_CAST(Handler)(handler)));
+      start_timer(state.get(), handler_ex);
+    }
+
+#define ASIO_PRIVATE_INIT_WRAPPER_DEF(n) \
+    template <typename Handler, ASIO_VARIADIC_TPARAMS(n)> \
+    void operator()( \
+        ASIO_MOVE_ARG(Handler) handler, \
+        ASIO_VARIADIC_MOVE_PARAMS(n)) const \
+    { \
+      typedef typename decay<Handler>::type handler_type; \
+      io_executor_type io_ex = (get_associated_executor)(initiation_); \
+      typename associated_executor<handler_type, io_executor_type>::type \
+        handler_ex = (get_associated_executor)(handler, io_ex); \
+      state_ptr state(state_type::create(io_ex)); \
+      state.get()->add_ref(); \
+      ASIO_MOVE_CAST(Initiation)(initiation_)( \
+          detail::with_timeout_handler<handler_type, io_executor_type>( \
+            state.get(), ASIO_MOVE_CAST(Handler)(handler)), \
+          ASIO_VARIADIC_MOVE_ARGS(n)); \
+      start_timer(state.get(), handler_ex); \
+    } \
+    /**/
+    ASIO_VARIADIC_GENERATE(ASIO_PRIVATE_INIT_WRAPPER_DEF)
+#undef ASIO_PRIVATE_INIT_WRAPPER_DEF
+
+#endif // defined(ASIO_HAS_VARIADIC_TEMPLATES)
+
+    chrono::steady_clock::duration timeout_;
+    Initiation initiation_;
+  };
+
+#if defined(ASIO_HAS_VARIADIC_TEMPLATES)
+
+  template <typename Initiation, typename RawCompletionToken, typename... Args>
+  static return_type initiate(
+      ASIO_MOVE_ARG(Initiation) initiation,
+      ASIO_MOVE_ARG(RawCompletionToken) token,
+      ASIO_MOVE_ARG(Args)... args)
+  {
+    return async_initiate<CompletionToken, Signature>(
+        init_wrapper<typename decay<Initiation>::type>(
+          token.timeout_, ASIO_MOVE_CAST(Initiation)(initiation)),
+        token.token_, ASIO_MOVE_CAST(Args)(args)...);
+  }
+
+#else // defined(ASIO_HAS_VARIADIC_TEMPLATES)
+
+  template <typename Initiation, typename RawCompletionToken>
+  static return_type initiate(
+      ASIO_MOVE_ARG(Initiation) initiation,
+      ASIO_MOVE_ARG(RawCompletionToken) token)
+  {
+    return async_initiate<CompletionToken, Signature>(
+        init_wrapper<typename decay<Initiation>::type>(
+          token.timeout_, ASIO_MOVE_CAST(Initiation)(initiation)),
+        token.token_);
+  }
+
+#define ASIO_PRIVATE_INITIATE_DEF(n) \
+  template <typename Initiation, typename RawCompletionToken, \
+      ASIO_VARIADIC_TPARAMS(n)> \
+  static return_type initiate( \
+      ASIO_MOVE_ARG(Initiation) initiation, \
+      ASIO_MOVE_ARG(RawCompletionToken) token, \
+      ASIO_VARIADIC_MOVE_PARAMS(n)) \
+  { \
+    return async_initiate<CompletionToken, Signature>( \
+        init_wrapper<typename decay<Initiation>::type>( \
+          token.timeout_, ASIO_MOVE_CAST(Initiation)(initiation)), \
+        token.token_, ASIO_VARIADIC_MOVE_ARGS(n)); \
+  } \
+  /**/
+  ASIO_VARIADIC_GENERATE(ASIO_PRIVATE_INITIATE_DEF)
+#undef ASIO_PRIVATE_INITIATE_DEF
+
+#endif // defined(ASIO_HAS_VARIADIC_TEMPLATES)
+};
+
+template <typename Handler, typename IoExecutor, typename Executor>
+struct associated_executor<
+    detail::with_timeout_handler<Handler, IoExecutor>, Executor>
+{
+  typedef typename associated_executor<Handler, Executor>::type type;
+
+  static type get(
+      const detail::with_timeout_handler<Handler, IoExecutor>& h,
+      const Executor& ex = Executor()) ASIO_NOEXCEPT
+  {
+    return associated_executor<Handler, Executor>::get(h.handler_, ex);
+  }
+};
+
+template <typename Handler, typename IoExecutor, typename Allocator>
+struct associated_allocator<
+    detail::with_timeout_handler<Handler, IoExecutor>, Allocator>
+{
+  typedef typename associated_allocator<Handler, Allocator>::type type;
+
+  static type get(
+      const detail::with_timeout_handler<Handler, IoExecutor>& h,
+      const Allocator& a = Allocator()) ASIO_NOEXCEPT
+  {
+    return associated_allocator<Handler, Allocator>::get(h.handler_, a);
+  }
+};
+
+template <typename Handler, typename IoExecutor, typename CancellationSlot>
+struct associated_cancellation_slot<
+    detail::with_timeout_handler<Handler, IoExecutor>, CancellationSlot>
+{
+  typedef cancellation_slot type;
+
+  static type get(
+      const detail::with_timeout_handler<Handler, IoExecutor>& h,
+      const CancellationSlot& = CancellationSlot()) ASIO_NOEXCEPT
+  {
+    return h.state_.get() ? h.state_.get()->slot() : cancellation_slot();
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_WITH_TIMEOUT_HPP
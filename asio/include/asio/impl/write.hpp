@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/associated_allocator.hpp"
+#include "asio/associated_cancellation_slot.hpp"
 #include "asio/associated_executor.hpp"
 #include "asio/buffer.hpp"
 #include "asio/completion_condition.hpp"
@@ -30,6 +31,7 @@
 #include "asio/detail/handler_type_requirements.hpp"
 #include "asio/detail/non_const_lvalue.hpp"
 #include "asio/detail/throw_error.hpp"
+#include "asio/detail/timeout_msec.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -108,6 +110,67 @@ inline std::size_t write(SyncWriteStream& s, const ConstBufferSequence& buffers,
   return bytes_transferred;
 }
 
+#if defined(ASIO_HAS_CHRONO)
+
+namespace detail
+{
+  template <typename SyncWriteStream, typename ConstBufferSequence,
+      typename ConstBufferIterator>
+  std::size_t write_buffer_sequence_for(SyncWriteStream& s,
+      const ConstBufferSequence& buffers, const ConstBufferIterator&,
+      int msec, asio::error_code& ec)
+  {
+    ec = asio::error_code();
+    asio::detail::consuming_buffers<const_buffer,
+        ConstBufferSequence, ConstBufferIterator> tmp(buffers);
+    const chrono::steady_clock::time_point deadline =
+      chrono::steady_clock::now() + chrono::milliseconds(msec);
+    chrono::steady_clock::duration remaining = chrono::milliseconds(msec);
+    while (!tmp.empty())
+    {
+      tmp.consume(s.write_some_for(
+            tmp.prepare(default_max_transfer_size), remaining, ec));
+      if (ec)
+        break;
+      remaining = deadline - chrono::steady_clock::now();
+      if (remaining < chrono::steady_clock::duration::zero())
+        remaining = chrono::steady_clock::duration::zero();
+    }
+    return tmp.total_consumed();
+  }
+} // namespace detail
+
+template <typename SyncWriteStream, typename ConstBufferSequence,
+    typename Rep, typename Period>
+inline std::size_t write_for(SyncWriteStream& s, const ConstBufferSequence& buffers,
+    const chrono::duration<Rep, Period>& timeout,
+    typename enable_if<
+      is_const_buffer_sequence<ConstBufferSequence>::value
+    >::type*)
+{
+  asio::error_code ec;
+  std::size_t bytes_transferred = detail::write_buffer_sequence_for(s,
+      buffers, asio::buffer_sequence_begin(buffers),
+      detail::timeout_msec(timeout), ec);
+  asio::detail::throw_error(ec, "write_for");
+  return bytes_transferred;
+}
+
+template <typename SyncWriteStream, typename ConstBufferSequence,
+    typename Rep, typename Period>
+inline std::size_t write_for(SyncWriteStream& s, const ConstBufferSequence& buffers,
+    const chrono::duration<Rep, Period>& timeout, asio::error_code& ec,
+    typename enable_if<
+      is_const_buffer_sequence<ConstBufferSequence>::value
+    >::type*)
+{
+  return detail::write_buffer_sequence_for(s, buffers,
+      asio::buffer_sequence_begin(buffers),
+      detail::timeout_msec(timeout), ec);
+}
+
+#endif // defined(ASIO_HAS_CHRONO)
+
 #if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
 
 template <typename SyncWriteStream, typename DynamicBuffer_v1,
@@ -476,6 +539,27 @@ struct associated_allocator<
   }
 };
 
+template <typename AsyncWriteStream, typename ConstBufferSequence,
+    typename ConstBufferIterator, typename CompletionCondition,
+    typename WriteHandler, typename CancellationSlot>
+struct associated_cancellation_slot<
+    detail::write_op<AsyncWriteStream, ConstBufferSequence,
+      ConstBufferIterator, CompletionCondition, WriteHandler>,
+    CancellationSlot>
+{
+  typedef typename associated_cancellation_slot<
+    WriteHandler, CancellationSlot>::type type;
+
+  static type get(
+      const detail::write_op<AsyncWriteStream, ConstBufferSequence,
+        ConstBufferIterator, CompletionCondition, WriteHandler>& h,
+      const CancellationSlot& s = CancellationSlot()) ASIO_NOEXCEPT
+  {
+    return associated_cancellation_slot<WriteHandler,
+        CancellationSlot>::get(h.handler_, s);
+  }
+};
+
 template <typename AsyncWriteStream, typename ConstBufferSequence,
     typename ConstBufferIterator, typename CompletionCondition,
     typename WriteHandler, typename Executor>
@@ -710,6 +794,27 @@ struct associated_allocator<
   }
 };
 
+template <typename AsyncWriteStream, typename DynamicBuffer_v1,
+    typename CompletionCondition, typename WriteHandler,
+    typename CancellationSlot>
+struct associated_cancellation_slot<
+    detail::write_dynbuf_v1_op<AsyncWriteStream,
+      DynamicBuffer_v1, CompletionCondition, WriteHandler>,
+    CancellationSlot>
+{
+  typedef typename associated_cancellation_slot<
+    WriteHandler, CancellationSlot>::type type;
+
+  static type get(
+      const detail::write_dynbuf_v1_op<AsyncWriteStream,
+        DynamicBuffer_v1, CompletionCondition, WriteHandler>& h,
+      const CancellationSlot& s = CancellationSlot()) ASIO_NOEXCEPT
+  {
+    return associated_cancellation_slot<WriteHandler,
+        CancellationSlot>::get(h.handler_, s);
+  }
+};
+
 template <typename AsyncWriteStream, typename DynamicBuffer_v1,
     typename CompletionCondition, typename WriteHandler, typename Executor>
 struct associated_executor<
@@ -980,6 +1085,27 @@ struct associated_allocator<
   }
 };
 
+template <typename AsyncWriteStream, typename DynamicBuffer_v2,
+    typename CompletionCondition, typename WriteHandler,
+    typename CancellationSlot>
+struct associated_cancellation_slot<
+    detail::write_dynbuf_v2_op<AsyncWriteStream,
+      DynamicBuffer_v2, CompletionCondition, WriteHandler>,
+    CancellationSlot>
+{
+  typedef typename associated_cancellation_slot<
+    WriteHandler, CancellationSlot>::type type;
+
+  static type get(
+      const detail::write_dynbuf_v2_op<AsyncWriteStream,
+        DynamicBuffer_v2, CompletionCondition, WriteHandler>& h,
+      const CancellationSlot& s = CancellationSlot()) ASIO_NOEXCEPT
+  {
+    return associated_cancellation_slot<WriteHandler,
+        CancellationSlot>::get(h.handler_, s);
+  }
+};
+
 template <typename AsyncWriteStream, typename DynamicBuffer_v2,
     typename CompletionCondition, typename WriteHandler, typename Executor>
 struct associated_executor<
@@ -20,6 +20,7 @@
 #include <stdexcept>
 #include <typeinfo>
 #include "asio/async_result.hpp"
+#include "asio/detail/executor_priority.hpp"
 #include "asio/detail/noncopyable.hpp"
 #include "asio/detail/wrapped_handler.hpp"
 #include "asio/error_code.hpp"
@@ -202,6 +203,53 @@ public:
   /// The type used to count the number of handlers executed by the context.
   typedef std::size_t count_type;
 
+  /// Determines how descriptor registrations are restored in a child process.
+  /**
+   * The selected mode is applied when notify_fork() is called with the
+   * execution_context::fork_child event.
+   */
+  enum fork_mode
+  {
+    /// Re-register every descriptor with the reactor as part of the
+    /// notify_fork() call. This is the default.
+    fork_reregister_eagerly,
+
+    /// Re-register a descriptor only when an asynchronous operation is next
+    /// started on it. Descriptors that have operations pending at the time of
+    /// the fork are still re-registered as part of the notify_fork() call.
+    fork_reregister_lazily,
+
+    /// Discard all inherited registrations. Operations that were pending at
+    /// the time of the fork are cancelled and their handlers are invoked with
+    /// the asio::error::operation_aborted error. A descriptor that is used
+    /// again is re-registered when an asynchronous operation is started on it.
+    fork_drop_registrations
+  };
+
+  /// Priority classes for handlers executed by the io_context.
+  /**
+   * A handler's priority class is that of its associated executor, which may
+   * be obtained by calling get_executor() with the required priority. Handlers
+   * that are ready to run are taken from the highest priority class that has
+   * any, so that high priority handlers overtake normal and low priority ones
+   * already queued. To avoid starvation, a lower priority class is served
+   * after it has been passed over a fixed number of times in a row.
+   *
+   * The completion of an asynchronous operation is queued in the priority
+   * class of the completion handler's associated executor.
+   */
+  enum priority_type
+  {
+    /// Handlers that run when no normal or high priority handlers are ready.
+    low_priority = detail::low_priority,
+
+    /// The priority class of executors obtained without a priority.
+    normal_priority = detail::normal_priority,
+
+    /// Handlers that run ahead of all normal and low priority handlers.
+    high_priority = detail::high_priority
+  };
+
   /// Constructor.
   ASIO_DECL io_context();
 
@@ -251,6 +299,9 @@ public:
   /// Obtains the executor associated with the io_context.
   executor_type get_executor() ASIO_NOEXCEPT;
 
+  /// Obtains an executor that runs handlers in the given priority class.
+  executor_type get_executor(priority_type priority) ASIO_NOEXCEPT;
+
   /// Run the io_context object's event processing loop.
   /**
    * The run() function blocks until all work has finished and there are no
@@ -494,6 +545,30 @@ public:
    */
   ASIO_DECL void restart();
 
+  /// Set how descriptor registrations are restored following a fork.
+  /**
+   * By default, calling notify_fork() with the execution_context::fork_child
+   * event re-registers every descriptor associated with the io_context. When
+   * a process forks many children from a parent that owns a large number of
+   * sockets, that cost is paid by every child before it can do any work. This
+   * function allows the child to defer, or entirely avoid, that work.
+   *
+   * @param mode The mode to be used by subsequent calls to notify_fork().
+   *
+   * @par Example
+   * @code io_context.set_fork_mode(asio::io_context::fork_reregister_lazily);
+   * io_context.notify_fork(asio::io_context::fork_prepare);
+   * if (fork() == 0)
+   * {
+   *   io_context.notify_fork(asio::io_context::fork_child);
+   *   ...
+   * } @endcode
+   *
+   * @note This function has no effect on platforms that do not use a reactor
+   * to demultiplex descriptor readiness.
+   */
+  ASIO_DECL void set_fork_mode(fork_mode mode);
+
 #if !defined(ASIO_NO_DEPRECATED)
   /// (Deprecated: Use restart().) Reset the io_context in preparation for a
   /// subsequent run() invocation.
@@ -701,34 +776,49 @@ public:
    */
   bool running_in_this_thread() const ASIO_NOEXCEPT;
 
+  /// Obtain the priority class in which the executor queues functions.
+  priority_type priority() const ASIO_NOEXCEPT
+  {
+    return static_cast<priority_type>(priority_);
+  }
+
   /// Compare two executors for equality.
   /**
-   * Two executors are equal if they refer to the same underlying io_context.
+   * Two executors are equal if they refer to the same underlying io_context
+   * and have the same priority.
    */
   friend bool operator==(const executor_type& a,
       const executor_type& b) ASIO_NOEXCEPT
   {
-    return &a.io_context_ == &b.io_context_;
+    return &a.io_context_ == &b.io_context_ && a.priority_ == b.priority_;
   }
 
   /// Compare two executors for inequality.
   /**
-   * Two executors are equal if they refer to the same underlying io_context.
+   * Two executors are equal if they refer to the same underlying io_context
+   * and have the same priority.
    */
   friend bool operator!=(const executor_type& a,
       const executor_type& b) ASIO_NOEXCEPT
   {
-    return &a.io_context_ != &b.io_context_;
+    return !(a == b);
   }
 
 private:
   friend class io_context;
 
   // Constructor.
-  explicit executor_type(io_context& i) : io_context_(i) {}
+  executor_type(io_context& i, int priority)
+    : io_context_(i),
+      priority_(priority)
+  {
+  }
 
   // The underlying io_context.
   io_context& io_context_;
+
+  // The priority class in which functions are queued.
+  int priority_;
 };
 
 #if !defined(ASIO_NO_DEPRECATED)
@@ -833,6 +923,15 @@ protected:
 
 namespace detail {
 
+template <>
+struct executor_priority<io_context::executor_type>
+{
+  static int get(const io_context::executor_type& ex) ASIO_NOEXCEPT
+  {
+    return ex.priority();
+  }
+};
+
 // Special service base class to keep classes header-file only.
 template <typename Type>
 class service_base
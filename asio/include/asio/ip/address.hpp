@@ -99,9 +99,54 @@ public:
   /// Get the address as an IP version 6 address.
   ASIO_DECL asio::ip::address_v6 to_v6() const;
 
+#if defined(GENERATING_DOCUMENTATION)
+  /// The maximum number of characters written by to_chars().
+  static const std::size_t max_chars = implementation_defined;
+#else
+  ASIO_STATIC_CONSTANT(std::size_t, max_chars = address_v6::max_chars);
+#endif
+
   /// Get the address as a string.
   ASIO_DECL std::string to_string() const;
 
+  /// Write the address to a range of characters.
+  /**
+   * Unlike to_string(), this function does not allocate memory. The
+   * characters written are not followed by a null terminator.
+   *
+   * @param first The beginning of the range to which the address is written.
+   *
+   * @param last The end of the range. A range of @c max_chars characters is
+   * always large enough.
+   *
+   * @returns A pointer one past the last character written.
+   *
+   * @throws asio::system_error Thrown if the range is too small.
+   *
+   * @sa address_v4::to_chars(), address_v6::to_chars()
+   */
+  ASIO_DECL char* to_chars(char* first, char* last) const;
+
+  /// Write the address to a range of characters.
+  /**
+   * Unlike to_string(), this function does not allocate memory. The
+   * characters written are not followed by a null terminator.
+   *
+   * @param first The beginning of the range to which the address is written.
+   *
+   * @param last The end of the range. A range of @c max_chars characters is
+   * always large enough.
+   *
+   * @param ec Set to asio::error::no_buffer_space if the range is too small.
+   *
+   * @returns A pointer one past the last character written, or @c first if
+   * an error occurred.
+   *
+   * @sa address_v4::to_chars(), address_v6::to_chars()
+   */
+  ASIO_DECL char* to_chars(char* first, char* last,
+      asio::error_code& ec) const ASIO_NOEXCEPT;
+
 #if !defined(ASIO_NO_DEPRECATED)
   /// (Deprecated: Use other overload.) Get the address as a string.
   ASIO_DECL std::string to_string(asio::error_code& ec) const;
@@ -214,6 +259,27 @@ ASIO_DECL address make_address(const std::string& str);
 ASIO_DECL address make_address(const std::string& str,
     asio::error_code& ec) ASIO_NOEXCEPT;
 
+/// Create an address from a range of characters holding an IPv4 address in
+/// dotted decimal form, or an IPv6 address in hexadecimal notation.
+/**
+ * The whole range must hold the address. Unlike the other overloads, this
+ * function does not allocate memory or call into the operating system.
+ *
+ * @relates address
+ */
+ASIO_DECL address make_address(const char* first, const char* last);
+
+/// Create an address from a range of characters holding an IPv4 address in
+/// dotted decimal form, or an IPv6 address in hexadecimal notation.
+/**
+ * The whole range must hold the address. Unlike the other overloads, this
+ * function does not allocate memory or call into the operating system.
+ *
+ * @relates address
+ */
+ASIO_DECL address make_address(const char* first, const char* last,
+    asio::error_code& ec) ASIO_NOEXCEPT;
+
 #if defined(ASIO_HAS_STRING_VIEW) \
   || defined(GENERATING_DOCUMENTATION)
 
@@ -112,9 +112,50 @@ public:
   ASIO_DECL unsigned long to_ulong() const;
 #endif // !defined(ASIO_NO_DEPRECATED)
 
+#if defined(GENERATING_DOCUMENTATION)
+  /// The maximum number of characters written by to_chars().
+  static const std::size_t max_chars = implementation_defined;
+#else
+  ASIO_STATIC_CONSTANT(std::size_t, max_chars = 15);
+#endif
+
   /// Get the address as a string in dotted decimal format.
   ASIO_DECL std::string to_string() const;
 
+  /// Write the address to a range of characters in dotted decimal format.
+  /**
+   * Unlike to_string(), this function does not allocate memory. The
+   * characters written are not followed by a null terminator.
+   *
+   * @param first The beginning of the range to which the address is written.
+   *
+   * @param last The end of the range. A range of @c max_chars characters is
+   * always large enough.
+   *
+   * @returns A pointer one past the last character written.
+   *
+   * @throws asio::system_error Thrown if the range is too small.
+   */
+  ASIO_DECL char* to_chars(char* first, char* last) const;
+
+  /// Write the address to a range of characters in dotted decimal format.
+  /**
+   * Unlike to_string(), this function does not allocate memory. The
+   * characters written are not followed by a null terminator.
+   *
+   * @param first The beginning of the range to which the address is written.
+   *
+   * @param last The end of the range. A range of @c max_chars characters is
+   * always large enough.
+   *
+   * @param ec Set to asio::error::no_buffer_space if the range is too small.
+   *
+   * @returns A pointer one past the last character written, or @c first if
+   * an error occurred.
+   */
+  ASIO_DECL char* to_chars(char* first, char* last,
+      asio::error_code& ec) const ASIO_NOEXCEPT;
+
 #if !defined(ASIO_NO_DEPRECATED)
   /// (Deprecated: Use other overload.) Get the address as a string in dotted
   /// decimal format.
@@ -283,6 +324,25 @@ ASIO_DECL address_v4 make_address_v4(const std::string& str);
 ASIO_DECL address_v4 make_address_v4(const std::string& str,
     asio::error_code& ec) ASIO_NOEXCEPT;
 
+/// Create an IPv4 address from a range of characters in dotted decimal form.
+/**
+ * The whole range must hold the address. Unlike the other overloads, this
+ * function does not allocate memory or call into the operating system.
+ *
+ * @relates address_v4
+ */
+ASIO_DECL address_v4 make_address_v4(const char* first, const char* last);
+
+/// Create an IPv4 address from a range of characters in dotted decimal form.
+/**
+ * The whole range must hold the address. Unlike the other overloads, this
+ * function does not allocate memory or call into the operating system.
+ *
+ * @relates address_v4
+ */
+ASIO_DECL address_v4 make_address_v4(const char* first, const char* last,
+    asio::error_code& ec) ASIO_NOEXCEPT;
+
 #if defined(ASIO_HAS_STRING_VIEW) \
   || defined(GENERATING_DOCUMENTATION)
 
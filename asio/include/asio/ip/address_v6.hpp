@@ -103,9 +103,56 @@ public:
   /// Get the address in bytes, in network byte order.
   ASIO_DECL bytes_type to_bytes() const ASIO_NOEXCEPT;
 
+#if defined(GENERATING_DOCUMENTATION)
+  /// The maximum number of characters written by to_chars().
+  static const std::size_t max_chars = implementation_defined;
+#else
+  ASIO_STATIC_CONSTANT(std::size_t, max_chars = 66);
+#endif
+
   /// Get the address as a string.
   ASIO_DECL std::string to_string() const;
 
+  /// Write the address to a range of characters.
+  /**
+   * The address is written in the form recommended by RFC 5952. A non-zero
+   * scope ID is always written as a number, whereas to_string() may write
+   * the name of the interface. Unlike to_string(), this function does not
+   * allocate memory. The characters written are not followed by a null
+   * terminator.
+   *
+   * @param first The beginning of the range to which the address is written.
+   *
+   * @param last The end of the range. A range of @c max_chars characters is
+   * always large enough.
+   *
+   * @returns A pointer one past the last character written.
+   *
+   * @throws asio::system_error Thrown if the range is too small.
+   */
+  ASIO_DECL char* to_chars(char* first, char* last) const;
+
+  /// Write the address to a range of characters.
+  /**
+   * The address is written in the form recommended by RFC 5952. A non-zero
+   * scope ID is always written as a number, whereas to_string() may write
+   * the name of the interface. Unlike to_string(), this function does not
+   * allocate memory. The characters written are not followed by a null
+   * terminator.
+   *
+   * @param first The beginning of the range to which the address is written.
+   *
+   * @param last The end of the range. A range of @c max_chars characters is
+   * always large enough.
+   *
+   * @param ec Set to asio::error::no_buffer_space if the range is too small.
+   *
+   * @returns A pointer one past the last character written, or @c first if
+   * an error occurred.
+   */
+  ASIO_DECL char* to_chars(char* first, char* last,
+      asio::error_code& ec) const ASIO_NOEXCEPT;
+
 #if !defined(ASIO_NO_DEPRECATED)
   /// (Deprecated: Use other overload.) Get the address as a string.
   ASIO_DECL std::string to_string(asio::error_code& ec) const;
@@ -271,6 +318,27 @@ ASIO_DECL address_v6 make_address_v6(const std::string& str);
 ASIO_DECL address_v6 make_address_v6(const std::string& str,
     asio::error_code& ec) ASIO_NOEXCEPT;
 
+/// Create an IPv6 address from a range of characters.
+/**
+ * The whole range must hold the address. A scope ID, if present, must be a
+ * number. Unlike the other overloads, this function does not allocate memory
+ * or call into the operating system.
+ *
+ * @relates address_v6
+ */
+ASIO_DECL address_v6 make_address_v6(const char* first, const char* last);
+
+/// Create an IPv6 address from a range of characters.
+/**
+ * The whole range must hold the address. A scope ID, if present, must be a
+ * number. Unlike the other overloads, this function does not allocate memory
+ * or call into the operating system.
+ *
+ * @relates address_v6
+ */
+ASIO_DECL address_v6 make_address_v6(const char* first, const char* last,
+    asio::error_code& ec) ASIO_NOEXCEPT;
+
 #if defined(ASIO_HAS_STRING_VIEW) \
   || defined(GENERATING_DOCUMENTATION)
 
@@ -16,6 +16,8 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/error.hpp"
 #include "asio/ip/address.hpp"
 #include "asio/ip/detail/endpoint.hpp"
 
@@ -186,6 +188,70 @@ public:
     impl_.address(addr);
   }
 
+#if defined(GENERATING_DOCUMENTATION)
+  /// The maximum number of characters written by to_chars().
+  static const std::size_t max_chars = implementation_defined;
+#else
+  ASIO_STATIC_CONSTANT(std::size_t,
+      max_chars = asio::ip::address::max_chars + 8);
+#endif
+
+  /// Write the endpoint to a range of characters.
+  /**
+   * An IPv4 endpoint is written as the address followed by a colon and the
+   * port number. The address of an IPv6 endpoint is enclosed in square
+   * brackets. Unlike the stream insertion operator, this function does not
+   * allocate memory. The characters written are not followed by a null
+   * terminator.
+   *
+   * @param first The beginning of the range to which the endpoint is written.
+   *
+   * @param last The end of the range. A range of @c max_chars characters is
+   * always large enough.
+   *
+   * @returns A pointer one past the last character written.
+   *
+   * @throws asio::system_error Thrown if the range is too small.
+   */
+  char* to_chars(char* first, char* last) const
+  {
+    asio::error_code ec;
+    char* result = to_chars(first, last, ec);
+    asio::detail::throw_error(ec);
+    return result;
+  }
+
+  /// Write the endpoint to a range of characters.
+  /**
+   * An IPv4 endpoint is written as the address followed by a colon and the
+   * port number. The address of an IPv6 endpoint is enclosed in square
+   * brackets. Unlike the stream insertion operator, this function does not
+   * allocate memory. The characters written are not followed by a null
+   * terminator.
+   *
+   * @param first The beginning of the range to which the endpoint is written.
+   *
+   * @param last The end of the range. A range of @c max_chars characters is
+   * always large enough.
+   *
+   * @param ec Set to asio::error::no_buffer_space if the range is too small.
+   *
+   * @returns A pointer one past the last character written, or @c first if
+   * an error occurred.
+   */
+  char* to_chars(char* first, char* last,
+      asio::error_code& ec) const ASIO_NOEXCEPT
+  {
+    char* result = impl_.to_chars(first, last);
+    if (result == 0)
+    {
+      ec = asio::error::no_buffer_space;
+      return first;
+    }
+    ec = asio::error_code();
+    return result;
+  }
+
   /// Compare two endpoints for equality.
   friend bool operator==(const basic_endpoint<InternetProtocol>& e1,
       const basic_endpoint<InternetProtocol>& e2) ASIO_NOEXCEPT
@@ -0,0 +1,315 @@
+//
+// ip/basic_network_map.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IP_BASIC_NETWORK_MAP_HPP
+#define ASIO_IP_BASIC_NETWORK_MAP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "asio/detail/cstdint.hpp"
+#include "asio/ip/network_v4.hpp"
+#include "asio/ip/network_v6.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+namespace detail {
+
+template <typename Network> struct network_map_traits;
+
+template <> struct network_map_traits<network_v4>
+{
+  typedef address_v4 address_type;
+  typedef address_v4::bytes_type bytes_type;
+  enum { address_bits = 32 };
+
+  static network_v4 canonical(const network_v4& net)
+  {
+    return net.canonical();
+  }
+
+  static bytes_type key(const network_v4& net)
+  {
+    return net.network().to_bytes();
+  }
+};
+
+template <> struct network_map_traits<network_v6>
+{
+  typedef address_v6 address_type;
+  typedef address_v6::bytes_type bytes_type;
+  enum { address_bits = 128 };
+
+  static network_v6 canonical(const network_v6& net)
+  {
+    return net.canonical();
+  }
+
+  static bytes_type key(const network_v6& net)
+  {
+    return net.network().to_bytes();
+  }
+};
+
+} // namespace detail
+
+/// Maps IP networks to values and finds the longest matching network for an
+/// address.
+/**
+ * The basic_network_map class template associates values with networks of
+ * type network_v4 or network_v6, and finds the most specific network that
+ * contains a given address. This is the longest prefix match used by routing
+ * tables and access control lists.
+ *
+ * The networks are held in a multibit trie that consumes four bits of the
+ * address at each level. Each network is recorded on the level holding its
+ * last bits, and is also expanded into all of the slots it covers there. A
+ * lookup therefore visits at most 8 nodes for IPv4 or 32 nodes for IPv6,
+ * regardless of the number of networks, and does not allocate memory. The
+ * nodes are stored contiguously and are referred to by index, so a map may be
+ * copied cheaply and used as an immutable snapshot.
+ *
+ * Each node occupies 248 bytes, holding three arrays of @c uint32_t with 16,
+ * 16 and 30 elements. Adding a network creates the nodes on its path that do
+ * not already exist, which is at most 7 nodes (1736 bytes) for IPv4 or 31
+ * nodes (7688 bytes) for IPv6. Networks that share leading bits share nodes,
+ * so the cost per network is usually much lower.
+ *
+ * Host bits in a network's address are ignored, so that @c 10.1.2.3/8 and
+ * @c 10.0.0.0/8 refer to the same network.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe for concurrent calls to const member functions.
+ * Unsafe if any thread calls a non-const member function.
+ *
+ * @par Example
+ * A map may be rebuilt and then published to reader threads. Readers take a
+ * short lock to copy the pointer to the current map, and then perform their
+ * lookups on that snapshot without holding the lock:
+ * @code
+ * typedef asio::ip::basic_network_map<asio::ip::network_v4, int> map_type;
+ * std::mutex mutex;
+ * std::shared_ptr<const map_type> current;
+ *
+ * // Writer. The old map is released after the lock is dropped.
+ * std::shared_ptr<const map_type> next = std::make_shared<map_type>(
+ *     rules.begin(), rules.end());
+ * {
+ *   std::lock_guard<std::mutex> lock(mutex);
+ *   current.swap(next);
+ * }
+ *
+ * // Readers.
+ * std::shared_ptr<const map_type> snapshot;
+ * {
+ *   std::lock_guard<std::mutex> lock(mutex);
+ *   snapshot = current;
+ * }
+ * if (const map_type::value_type* match = snapshot->lookup(addr))
+ *   apply(match->second);
+ * @endcode
+ */
+template <typename Network, typename T>
+class basic_network_map
+{
+private:
+  typedef detail::network_map_traits<Network> traits_type;
+
+public:
+  /// The type of the networks used as keys.
+  typedef Network network_type;
+
+  /// The type of the addresses that are looked up.
+  typedef typename traits_type::address_type address_type;
+
+  /// The type of the values associated with networks.
+  typedef T mapped_type;
+
+  /// The type of a network together with its value.
+  typedef std::pair<Network, T> value_type;
+
+  /// The type of an iterator over the entries.
+  typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+  /// Construct an empty map.
+  basic_network_map()
+    : nodes_(1),
+      default_entry_(0)
+  {
+  }
+
+  /// Construct a map from a range of network and value pairs.
+  /**
+   * This is equivalent to constructing an empty map and then calling insert()
+   * with the range.
+   */
+  template <typename Iterator>
+  basic_network_map(Iterator first, Iterator last)
+    : nodes_(1),
+      default_entry_(0)
+  {
+    insert(first, last);
+  }
+
+  /// Associate a value with a network.
+  /**
+   * @returns @c true if the network was added, or @c false if it was already
+   * present, in which case its value is replaced.
+   *
+   * @note Iterators and pointers to entries are invalidated.
+   */
+  bool insert(const network_type& net, const mapped_type& value);
+
+  /// Insert a range of network and value pairs.
+  /**
+   * The pairs are sorted by network before they are inserted, so that the
+   * nodes for neighbouring networks are adjacent in memory. When a network
+   * occurs more than once in the range, the last value is used.
+   *
+   * @note Iterators and pointers to entries are invalidated.
+   */
+  template <typename Iterator>
+  void insert(Iterator first, Iterator last);
+
+  /// Remove a network from the map.
+  /**
+   * @returns @c true if the network was removed, or @c false if it was not
+   * present.
+   *
+   * @note Iterators and pointers to entries are invalidated, and the last
+   * entry takes the place of the one that is removed.
+   */
+  bool erase(const network_type& net);
+
+  /// Find the entry for exactly the given network.
+  /**
+   * @returns A pointer to the entry, or a null pointer if the network is not
+   * present.
+   */
+  const value_type* find(const network_type& net) const;
+
+  /// Find the entry for the longest network that contains an address.
+  /**
+   * @returns A pointer to the entry, or a null pointer if no network in the
+   * map contains the address.
+   */
+  const value_type* lookup(const address_type& addr) const;
+
+  /// Get the number of networks in the map.
+  std::size_t size() const
+  {
+    return entries_.size();
+  }
+
+  /// Determine whether the map is empty.
+  bool empty() const
+  {
+    return entries_.empty();
+  }
+
+  /// Get an iterator to the first entry. Entries are in insertion order,
+  /// except that erase() moves the last entry into the gap it leaves.
+  const_iterator begin() const
+  {
+    return entries_.begin();
+  }
+
+  /// Get an iterator past the last entry.
+  const_iterator end() const
+  {
+    return entries_.end();
+  }
+
+  /// Remove all networks from the map.
+  void clear()
+  {
+    entries_.clear();
+    nodes_.assign(1, node());
+    default_entry_ = 0;
+  }
+
+private:
+  typedef typename traits_type::bytes_type bytes_type;
+
+  // The number of address bits consumed at each level of the trie.
+  enum { stride = 4, fanout = 1 << stride };
+
+  // The maximum depth of the trie.
+  enum { max_depth = traits_type::address_bits / stride };
+
+  // A level of the trie. The prefix array records the networks whose last
+  // bits are on this level, indexed by prefix(). Each slot's entry is the
+  // longest of these networks that covers the slot. The entry and child
+  // indexes are one-based, so that zero means none. The root node is never a
+  // child.
+  struct node
+  {
+    asio::uint32_t entry[fanout];
+    asio::uint32_t child[fanout];
+    asio::uint32_t prefix[2 * fanout - 2];
+  };
+
+  // Get the bits of the key that select a slot at the given depth.
+  static unsigned int slot(const bytes_type& key, std::size_t depth)
+  {
+    return (key[depth / 2] >> ((depth & 1) ? 0 : stride)) & (fanout - 1);
+  }
+
+  // Get the index in a node's prefix array of the network with the given
+  // number of bits on that level, whose first covered slot is given.
+  static std::size_t prefix(std::size_t bits, unsigned int first_slot)
+  {
+    return (std::size_t(1) << bits) - 2 + (first_slot >> (stride - bits));
+  }
+
+  // Get the index of the node at the given depth on the path to a key.
+  // Returns nodes_.size() if there is no such node.
+  std::size_t find_node(const bytes_type& key, std::size_t depth) const;
+
+  // Get the index of the node at the given depth on the path to a key,
+  // creating it and its parents as needed.
+  std::size_t make_node(const bytes_type& key, std::size_t depth);
+
+  // Recompute the entries of a range of slots from the node's networks.
+  static void update_slots(node& n, unsigned int first_slot,
+      unsigned int slot_count);
+
+  // Remove an entry, moving the last entry into its place.
+  void remove_entry(std::size_t entry);
+
+  // Orders networks by address and then by prefix length.
+  static bool key_less(const value_type& a, const value_type& b);
+
+  // The entries.
+  std::vector<value_type> entries_;
+
+  // The nodes of the trie, starting with the root.
+  std::vector<node> nodes_;
+
+  // The one-based index of the entry for the zero-length prefix, if any.
+  std::size_t default_entry_;
+};
+
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/ip/impl/basic_network_map.hpp"
+
+#endif // ASIO_IP_BASIC_NETWORK_MAP_HPP
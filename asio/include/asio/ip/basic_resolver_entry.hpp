@@ -16,7 +16,10 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <cstddef>
 #include <string>
+#include "asio/detail/allocation_tracking.hpp"
+#include "asio/detail/memory.hpp"
 #include "asio/detail/string_view.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -45,6 +48,7 @@ public:
 
   /// Default constructor.
   basic_resolver_entry()
+    : service_offset_(0)
   {
   }
 
@@ -52,8 +56,9 @@ public:
   basic_resolver_entry(const endpoint_type& ep,
       ASIO_STRING_VIEW_PARAM host, ASIO_STRING_VIEW_PARAM service)
     : endpoint_(ep),
-      host_name_(static_cast<std::string>(host)),
-      service_name_(static_cast<std::string>(service))
+      names_(make_names(host.data(), host.size(),
+            service.data(), service.size())),
+      service_offset_(host.size() + 1)
   {
   }
 
@@ -72,7 +77,8 @@ public:
   /// Get the host name associated with the entry.
   std::string host_name() const
   {
-    return host_name_;
+    return names_ ? std::string(names_->data(), service_offset_ - 1)
+      : std::string();
   }
 
   /// Get the host name associated with the entry.
@@ -80,14 +86,16 @@ public:
   std::basic_string<char, std::char_traits<char>, Allocator> host_name(
       const Allocator& alloc = Allocator()) const
   {
-    return std::basic_string<char, std::char_traits<char>, Allocator>(
-        host_name_.c_str(), alloc);
+    return names_
+      ? std::basic_string<char, std::char_traits<char>, Allocator>(
+          names_->data(), service_offset_ - 1, alloc)
+      : std::basic_string<char, std::char_traits<char>, Allocator>(alloc);
   }
 
   /// Get the service name associated with the entry.
   std::string service_name() const
   {
-    return service_name_;
+    return names_ ? names_->substr(service_offset_) : std::string();
   }
 
   /// Get the service name associated with the entry.
@@ -95,14 +103,48 @@ public:
   std::basic_string<char, std::char_traits<char>, Allocator> service_name(
       const Allocator& alloc = Allocator()) const
   {
-    return std::basic_string<char, std::char_traits<char>, Allocator>(
-        service_name_.c_str(), alloc);
+    return names_
+      ? std::basic_string<char, std::char_traits<char>, Allocator>(
+          names_->data() + service_offset_,
+          names_->size() - service_offset_, alloc)
+      : std::basic_string<char, std::char_traits<char>, Allocator>(alloc);
   }
 
 private:
+  template <typename> friend class basic_resolver_results;
+
+  // The host name and service name, stored together as "host\0service" so
+  // that a single string may be shared by all entries of a results range.
+  typedef asio::detail::shared_ptr<const std::string> names_ptr_type;
+
+  // Construct with specified endpoint and shared names.
+  basic_resolver_entry(const endpoint_type& ep,
+      const names_ptr_type& names, std::size_t service_offset)
+    : endpoint_(ep),
+      names_(names),
+      service_offset_(service_offset)
+  {
+  }
+
+  // Create the shared names. Returns null if both names are empty.
+  static names_ptr_type make_names(const char* host, std::size_t host_size,
+      const char* service, std::size_t service_size)
+  {
+    if (host_size == 0 && service_size == 0)
+      return names_ptr_type();
+    ASIO_HEAP_ALLOCATION(("resolver_entry", host_size + 1 + service_size));
+    std::string names;
+    names.reserve(host_size + 1 + service_size);
+    names.append(host, host_size);
+    names.push_back('\0');
+    names.append(service, service_size);
+    return asio::detail::make_shared<const std::string>(
+        ASIO_MOVE_CAST(std::string)(names));
+  }
+
   endpoint_type endpoint_;
-  std::string host_name_;
-  std::string service_name_;
+  names_ptr_type names_;
+  std::size_t service_offset_;
 };
 
 } // namespace ip
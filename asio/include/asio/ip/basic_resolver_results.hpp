@@ -18,6 +18,8 @@
 #include "asio/detail/config.hpp"
 #include <cstddef>
 #include <cstring>
+#include "asio/detail/allocation_tracking.hpp"
+#include "asio/detail/memory.hpp"
 #include "asio/detail/socket_ops.hpp"
 #include "asio/detail/socket_types.hpp"
 #include "asio/ip/basic_resolver_iterator.hpp"
@@ -129,11 +131,23 @@ public:
     if (!address_info)
       return results;
 
-    std::string actual_host_name = host_name;
+    const char* actual_host_name = host_name.c_str();
+    std::size_t actual_host_size = host_name.size();
     if (address_info->ai_canonname)
+    {
       actual_host_name = address_info->ai_canonname;
+      actual_host_size = std::strlen(actual_host_name);
+    }
 
-    results.values_.reset(new values_type);
+    std::size_t count = 0;
+    for (asio::detail::addrinfo_type* ai = address_info; ai; ai = ai->ai_next)
+      if (ai->ai_family == ASIO_OS_DEF(AF_INET)
+          || ai->ai_family == ASIO_OS_DEF(AF_INET6))
+        ++count;
+
+    results.allocate(count);
+    names_ptr_type names = value_type::make_names(actual_host_name,
+        actual_host_size, service_name.data(), service_name.size());
 
     while (address_info)
     {
@@ -146,8 +160,7 @@ public:
         memcpy(endpoint.data(), address_info->ai_addr,
             address_info->ai_addrlen);
         results.values_->push_back(
-            basic_resolver_entry<InternetProtocol>(endpoint,
-              actual_host_name, service_name));
+            value_type(endpoint, names, actual_host_size + 1));
       }
       address_info = address_info->ai_next;
     }
@@ -160,7 +173,7 @@ public:
       const std::string& host_name, const std::string& service_name)
   {
     basic_resolver_results results;
-    results.values_.reset(new values_type);
+    results.allocate(1);
     results.values_->push_back(
         basic_resolver_entry<InternetProtocol>(
           endpoint, host_name, service_name));
@@ -176,12 +189,13 @@ public:
     basic_resolver_results results;
     if (begin != end)
     {
-      results.values_.reset(new values_type);
+      results.allocate(0);
+      names_ptr_type names = value_type::make_names(host_name.data(),
+          host_name.size(), service_name.data(), service_name.size());
       for (EndpointIterator ep_iter = begin; ep_iter != end; ++ep_iter)
       {
         results.values_->push_back(
-            basic_resolver_entry<InternetProtocol>(
-              *ep_iter, host_name, service_name));
+            value_type(*ep_iter, names, host_name.size() + 1));
       }
     }
     return results;
@@ -198,7 +212,9 @@ public:
     basic_resolver_results results;
     if (endpoints->Size)
     {
-      results.values_.reset(new values_type);
+      results.allocate(endpoints->Size);
+      names_ptr_type names = value_type::make_names(host_name.data(),
+          host_name.size(), service_name.data(), service_name.size());
       for (unsigned int i = 0; i < endpoints->Size; ++i)
       {
         auto pair = endpoints->GetAt(i);
@@ -214,14 +230,14 @@ public:
           continue;
 
         results.values_->push_back(
-            basic_resolver_entry<InternetProtocol>(
+            value_type(
               typename InternetProtocol::endpoint(
                 ip::make_address(
                   asio::detail::winrt_utils::string(
                     pair->RemoteHostName->CanonicalName)),
                 asio::detail::winrt_utils::integer(
                   pair->RemoteServiceName)),
-              host_name, service_name));
+              names, host_name.size() + 1));
       }
     }
     return results;
@@ -301,6 +317,19 @@ public:
 
 private:
   typedef std::vector<basic_resolver_entry<InternetProtocol> > values_type;
+  typedef typename value_type::names_ptr_type names_ptr_type;
+
+#if !defined(GENERATING_DOCUMENTATION)
+  // Allocate the entries, with the vector and its shared count in a single
+  // block, and with space reserved for the given number of entries.
+  void allocate(std::size_t count)
+  {
+    ASIO_HEAP_ALLOCATION(("resolver_results",
+          sizeof(values_type) + count * sizeof(value_type)));
+    this->values_ = asio::detail::make_shared<values_type>();
+    this->values_->reserve(count);
+  }
+#endif // !defined(GENERATING_DOCUMENTATION)
 };
 
 } // namespace ip
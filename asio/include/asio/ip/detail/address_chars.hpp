@@ -0,0 +1,68 @@
+//
+// ip/detail/address_chars.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IP_DETAIL_ADDRESS_CHARS_HPP
+#define ASIO_IP_DETAIL_ADDRESS_CHARS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+namespace detail {
+
+// Conversions between addresses and their textual forms that neither
+// allocate memory nor call into the operating system. Addresses are given as
+// bytes in network order.
+
+// The longest dotted decimal IPv4 address, "255.255.255.255".
+enum { max_address_v4_chars = 15 };
+
+// The longest IPv6 address, an IPv4-mapped address in mixed notation,
+// followed by a '%' and the decimal scope ID.
+enum { max_address_v6_chars = 45 + 1 + 20 };
+
+// Write an IPv4 address in dotted decimal form. Returns a pointer past the
+// last character written, or 0 if the range is too small.
+ASIO_DECL char* address_v4_to_chars(const unsigned char* bytes,
+    char* first, char* last) ASIO_NOEXCEPT;
+
+// Parse a dotted decimal IPv4 address that occupies the whole range. Returns
+// false if the range does not hold a valid address.
+ASIO_DECL bool address_v4_from_chars(const char* first,
+    const char* last, unsigned char* bytes) ASIO_NOEXCEPT;
+
+// Write an IPv6 address in the form recommended by RFC 5952, followed by the
+// scope ID in decimal if it is non-zero. Returns a pointer past the last
+// character written, or 0 if the range is too small.
+ASIO_DECL char* address_v6_to_chars(const unsigned char* bytes,
+    unsigned long scope_id, char* first, char* last) ASIO_NOEXCEPT;
+
+// Parse an IPv6 address, with an optional decimal scope ID, that occupies the
+// whole range. Returns false if the range does not hold a valid address.
+ASIO_DECL bool address_v6_from_chars(const char* first, const char* last,
+    unsigned char* bytes, unsigned long& scope_id) ASIO_NOEXCEPT;
+
+} // namespace detail
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/ip/detail/impl/address_chars.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_IP_DETAIL_ADDRESS_CHARS_HPP
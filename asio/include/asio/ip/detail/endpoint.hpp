@@ -113,6 +113,10 @@ public:
     return data_.base.sa_family == ASIO_OS_DEF(AF_INET);
   }
 
+  // Write the endpoint to a range of characters. Returns a pointer past the
+  // last character written, or 0 if the range is too small.
+  ASIO_DECL char* to_chars(char* first, char* last) const ASIO_NOEXCEPT;
+
 #if !defined(ASIO_NO_IOSTREAM)
   // Convert to a string.
   ASIO_DECL std::string to_string() const;
@@ -0,0 +1,332 @@
+//
+// ip/detail/impl/address_chars.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IP_DETAIL_IMPL_ADDRESS_CHARS_IPP
+#define ASIO_IP_DETAIL_IMPL_ADDRESS_CHARS_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstring>
+#include "asio/ip/detail/address_chars.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+namespace detail {
+
+// Write a value from 0 to 255 in decimal, without leading zeros.
+inline char* write_decimal_octet(unsigned int value, char* p)
+{
+  if (value >= 100)
+  {
+    *p++ = static_cast<char>('0' + value / 100);
+    value %= 100;
+    *p++ = static_cast<char>('0' + value / 10);
+  }
+  else if (value >= 10)
+  {
+    *p++ = static_cast<char>('0' + value / 10);
+  }
+  *p++ = static_cast<char>('0' + value % 10);
+  return p;
+}
+
+// Write a value from 0 to 0xFFFF in lower case hexadecimal, without leading
+// zeros.
+inline char* write_hex_word(unsigned int value, char* p)
+{
+  static const char digits[] = "0123456789abcdef";
+  if (value >= 0x1000)
+    *p++ = digits[value >> 12];
+  if (value >= 0x100)
+    *p++ = digits[(value >> 8) & 0xF];
+  if (value >= 0x10)
+    *p++ = digits[(value >> 4) & 0xF];
+  *p++ = digits[value & 0xF];
+  return p;
+}
+
+// Returns the value of a hexadecimal digit, or 16 if it is not one.
+inline unsigned int hex_digit_value(char c)
+{
+  unsigned int d = static_cast<unsigned char>(c) - '0';
+  if (d < 10)
+    return d;
+  d = (static_cast<unsigned char>(c) | 0x20) - 'a';
+  return d < 6 ? d + 10 : 16;
+}
+
+// Copy characters formatted in a temporary buffer into the output range.
+inline char* copy_to_range(const char* buf, std::size_t length,
+    char* first, char* last)
+{
+  if (static_cast<std::size_t>(last - first) < length)
+    return 0;
+  std::memcpy(first, buf, length);
+  return first + length;
+}
+
+// Write an IPv4 address in dotted decimal form.
+inline char* write_address_v4(const unsigned char* bytes, char* p)
+{
+  p = write_decimal_octet(bytes[0], p);
+  *p++ = '.';
+  p = write_decimal_octet(bytes[1], p);
+  *p++ = '.';
+  p = write_decimal_octet(bytes[2], p);
+  *p++ = '.';
+  return write_decimal_octet(bytes[3], p);
+}
+
+char* address_v4_to_chars(const unsigned char* bytes,
+    char* first, char* last) ASIO_NOEXCEPT
+{
+  // Write directly to the output when it is large enough for any address.
+  if (last - first >= max_address_v4_chars)
+    return write_address_v4(bytes, first);
+
+  char buf[max_address_v4_chars];
+  char* end = write_address_v4(bytes, buf);
+  return copy_to_range(buf, end - buf, first, last);
+}
+
+bool address_v4_from_chars(const char* first,
+    const char* last, unsigned char* bytes) ASIO_NOEXCEPT
+{
+  const char* p = first;
+  for (int i = 0; i < 4; ++i)
+  {
+    if (i != 0)
+    {
+      if (p == last || *p != '.')
+        return false;
+      ++p;
+    }
+
+    if (p == last)
+      return false;
+    unsigned int value = static_cast<unsigned char>(*p) - '0';
+    if (value > 9)
+      return false;
+    ++p;
+
+    // Up to two more digits, unless the first digit is a zero. As with
+    // inet_pton, leading zeros are not accepted.
+    if (value != 0)
+    {
+      for (int j = 0; j < 2 && p != last; ++j, ++p)
+      {
+        unsigned int d = static_cast<unsigned char>(*p) - '0';
+        if (d > 9)
+          break;
+        value = value * 10 + d;
+      }
+    }
+
+    if (value > 255)
+      return false;
+    bytes[i] = static_cast<unsigned char>(value);
+  }
+
+  return p == last;
+}
+
+// Write an IPv6 address, followed by the scope ID if it is non-zero.
+inline char* write_address_v6(const unsigned char* bytes,
+    unsigned long scope_id, char* p)
+{
+  unsigned int words[8];
+  for (int i = 0; i < 8; ++i)
+    words[i] = (static_cast<unsigned int>(bytes[i * 2]) << 8)
+      | bytes[i * 2 + 1];
+
+  // Find the first of the longest runs of at least two zero words.
+  int best_base = -1, best_length = 1;
+  for (int i = 0; i < 8; )
+  {
+    if (words[i] == 0)
+    {
+      int base = i;
+      while (i < 8 && words[i] == 0)
+        ++i;
+      if (i - base > best_length)
+        best_base = base, best_length = i - base;
+    }
+    else
+    {
+      ++i;
+    }
+  }
+
+  for (int i = 0; i < 8; ++i)
+  {
+    if (best_base >= 0 && i >= best_base && i < best_base + best_length)
+    {
+      if (i == best_base)
+        *p++ = ':';
+      continue;
+    }
+
+    if (i != 0)
+      *p++ = ':';
+
+    // IPv4-compatible and IPv4-mapped addresses end in dotted decimal form.
+    if (i == 6 && best_base == 0 && (best_length == 6
+          || (best_length == 5 && words[5] == 0xFFFF)))
+    {
+      p = write_address_v4(bytes + 12, p);
+      break;
+    }
+
+    p = write_hex_word(words[i], p);
+  }
+
+  if (best_base >= 0 && best_base + best_length == 8)
+    *p++ = ':';
+
+  if (scope_id != 0)
+  {
+    char digits[20];
+    int n = 0;
+    do digits[n++] = static_cast<char>('0' + scope_id % 10);
+    while ((scope_id /= 10) != 0);
+    *p++ = '%';
+    while (n > 0)
+      *p++ = digits[--n];
+  }
+
+  return p;
+}
+
+char* address_v6_to_chars(const unsigned char* bytes,
+    unsigned long scope_id, char* first, char* last) ASIO_NOEXCEPT
+{
+  // Write directly to the output when it is large enough for any address.
+  if (last - first >= max_address_v6_chars)
+    return write_address_v6(bytes, scope_id, first);
+
+  char buf[max_address_v6_chars];
+  char* end = write_address_v6(bytes, scope_id, buf);
+  return copy_to_range(buf, end - buf, first, last);
+}
+
+bool address_v6_from_chars(const char* first, const char* last,
+    unsigned char* bytes, unsigned long& scope_id) ASIO_NOEXCEPT
+{
+  // Split off and parse the scope ID.
+  const char* end = first;
+  while (end != last && *end != '%')
+    ++end;
+  unsigned long scope = 0;
+  if (end != last)
+  {
+    const char* p = end + 1;
+    if (p == last)
+      return false;
+    for (; p != last; ++p)
+    {
+      unsigned int d = static_cast<unsigned char>(*p) - '0';
+      if (d > 9 || scope > (0xFFFFFFFFUL - d) / 10)
+        return false;
+      scope = scope * 10 + d;
+    }
+  }
+
+  unsigned int words[8];
+  int count = 0;
+  int gap = -1;
+  const char* p = first;
+
+  if (p != end && *p == ':')
+  {
+    if (end - p < 2 || p[1] != ':')
+      return false;
+    gap = 0;
+    p += 2;
+  }
+
+  while (p != end)
+  {
+    if (count == 8)
+      return false;
+
+    const char* start = p;
+    unsigned int value = 0;
+    for (unsigned int d; p != end && p - start < 4
+        && (d = hex_digit_value(*p)) < 16; ++p)
+      value = (value << 4) | d;
+    if (p == start)
+      return false;
+
+    // A trailing IPv4 address in dotted decimal form fills two words.
+    if (p != end && *p == '.')
+    {
+      unsigned char v4_bytes[4];
+      if (count > 6 || !address_v4_from_chars(start, end, v4_bytes))
+        return false;
+      words[count++] = (static_cast<unsigned int>(v4_bytes[0]) << 8)
+        | v4_bytes[1];
+      words[count++] = (static_cast<unsigned int>(v4_bytes[2]) << 8)
+        | v4_bytes[3];
+      p = end;
+      break;
+    }
+
+    words[count++] = value;
+    if (p == end)
+      break;
+    if (*p != ':' || ++p == end)
+      return false;
+    if (*p == ':')
+    {
+      if (gap >= 0)
+        return false;
+      gap = count;
+      ++p;
+    }
+  }
+
+  if (gap < 0)
+  {
+    if (count != 8)
+      return false;
+  }
+  else
+  {
+    // The "::" must stand for at least one zero word.
+    if (count == 8)
+      return false;
+    int moved = count - gap;
+    for (int i = 0; i < moved; ++i)
+      words[7 - i] = words[count - 1 - i];
+    for (int i = gap; i < 8 - moved; ++i)
+      words[i] = 0;
+  }
+
+  for (int i = 0; i < 8; ++i)
+  {
+    bytes[i * 2] = static_cast<unsigned char>(words[i] >> 8);
+    bytes[i * 2 + 1] = static_cast<unsigned char>(words[i] & 0xFF);
+  }
+  scope_id = scope;
+  return true;
+}
+
+} // namespace detail
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IP_DETAIL_IMPL_ADDRESS_CHARS_IPP
@@ -23,6 +23,7 @@
 #include "asio/detail/socket_ops.hpp"
 #include "asio/detail/throw_error.hpp"
 #include "asio/error.hpp"
+#include "asio/ip/detail/address_chars.hpp"
 #include "asio/ip/detail/endpoint.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -175,6 +176,42 @@ bool operator<(const endpoint& e1, const endpoint& e2) ASIO_NOEXCEPT
   return e1.port() < e2.port();
 }
 
+char* endpoint::to_chars(char* first, char* last) const ASIO_NOEXCEPT
+{
+  char* p;
+  if (is_v4())
+  {
+    p = address_v4_to_chars(reinterpret_cast<const unsigned char*>(
+          &data_.v4.sin_addr), first, last);
+  }
+  else
+  {
+    if (first == last)
+      return 0;
+    *first = '[';
+    p = address_v6_to_chars(data_.v6.sin6_addr.s6_addr,
+        data_.v6.sin6_scope_id, first + 1, last);
+    if (p == 0 || p == last)
+      return 0;
+    *p++ = ']';
+  }
+
+  // Write the port number, of at most five digits.
+  if (p == 0 || p == last)
+    return 0;
+  *p++ = ':';
+  char digits[5];
+  int n = 0;
+  unsigned short port_num = port();
+  do digits[n++] = static_cast<char>('0' + port_num % 10);
+  while ((port_num /= 10) != 0);
+  if (last - p < n)
+    return 0;
+  while (n > 0)
+    *p++ = digits[--n];
+  return p;
+}
+
 #if !defined(ASIO_NO_IOSTREAM)
 std::string endpoint::to_string() const
 {
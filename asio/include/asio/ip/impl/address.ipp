@@ -128,6 +128,33 @@ address make_address(const char* str,
   return address();
 }
 
+address make_address(const char* first, const char* last)
+{
+  asio::error_code ec;
+  address addr = make_address(first, last, ec);
+  asio::detail::throw_error(ec);
+  return addr;
+}
+
+address make_address(const char* first, const char* last,
+    asio::error_code& ec) ASIO_NOEXCEPT
+{
+  // Only an IPv6 address can contain a colon.
+  for (const char* p = first; p != last; ++p)
+  {
+    if (*p == ':')
+    {
+      asio::ip::address_v6 ipv6_address =
+        asio::ip::make_address_v6(first, last, ec);
+      return ec ? address() : address(ipv6_address);
+    }
+  }
+
+  asio::ip::address_v4 ipv4_address =
+    asio::ip::make_address_v4(first, last, ec);
+  return ec ? address() : address(ipv4_address);
+}
+
 address make_address(const std::string& str)
 {
   return make_address(str.c_str());
@@ -181,6 +208,21 @@ std::string address::to_string() const
   return ipv4_address_.to_string();
 }
 
+char* address::to_chars(char* first, char* last) const
+{
+  if (type_ == ipv6)
+    return ipv6_address_.to_chars(first, last);
+  return ipv4_address_.to_chars(first, last);
+}
+
+char* address::to_chars(char* first, char* last,
+    asio::error_code& ec) const ASIO_NOEXCEPT
+{
+  if (type_ == ipv6)
+    return ipv6_address_.to_chars(first, last, ec);
+  return ipv4_address_.to_chars(first, last, ec);
+}
+
 #if !defined(ASIO_NO_DEPRECATED)
 std::string address::to_string(asio::error_code& ec) const
 {
@@ -24,6 +24,7 @@
 #include "asio/detail/throw_error.hpp"
 #include "asio/detail/throw_exception.hpp"
 #include "asio/ip/address_v4.hpp"
+#include "asio/ip/detail/address_chars.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -82,16 +83,31 @@ unsigned long address_v4::to_ulong() const
 #endif // !defined(ASIO_NO_DEPRECATED)
 
 std::string address_v4::to_string() const
+{
+  char addr_str[max_chars];
+  return std::string(addr_str, to_chars(addr_str, addr_str + max_chars));
+}
+
+char* address_v4::to_chars(char* first, char* last) const
 {
   asio::error_code ec;
-  char addr_str[asio::detail::max_addr_v4_str_len];
-  const char* addr =
-    asio::detail::socket_ops::inet_ntop(
-        ASIO_OS_DEF(AF_INET), &addr_, addr_str,
-        asio::detail::max_addr_v4_str_len, 0, ec);
-  if (addr == 0)
-    asio::detail::throw_error(ec);
-  return addr;
+  char* result = to_chars(first, last, ec);
+  asio::detail::throw_error(ec);
+  return result;
+}
+
+char* address_v4::to_chars(char* first, char* last,
+    asio::error_code& ec) const ASIO_NOEXCEPT
+{
+  char* result = asio::ip::detail::address_v4_to_chars(
+      reinterpret_cast<const unsigned char*>(&addr_.s_addr), first, last);
+  if (result == 0)
+  {
+    ec = asio::error::no_buffer_space;
+    return first;
+  }
+  ec = asio::error_code();
+  return result;
 }
 
 #if !defined(ASIO_NO_DEPRECATED)
@@ -187,6 +203,27 @@ address_v4 make_address_v4(const std::string& str,
   return make_address_v4(str.c_str(), ec);
 }
 
+address_v4 make_address_v4(const char* first, const char* last)
+{
+  asio::error_code ec;
+  address_v4 addr = make_address_v4(first, last, ec);
+  asio::detail::throw_error(ec);
+  return addr;
+}
+
+address_v4 make_address_v4(const char* first, const char* last,
+    asio::error_code& ec) ASIO_NOEXCEPT
+{
+  address_v4::bytes_type bytes;
+  if (!asio::ip::detail::address_v4_from_chars(first, last, &bytes[0]))
+  {
+    ec = asio::error::invalid_argument;
+    return address_v4();
+  }
+  ec = asio::error_code();
+  return address_v4(bytes);
+}
+
 #if defined(ASIO_HAS_STRING_VIEW)
 
 address_v4 make_address_v4(string_view str)
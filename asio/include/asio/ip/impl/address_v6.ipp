@@ -25,6 +25,7 @@
 #include "asio/error.hpp"
 #include "asio/ip/address_v6.hpp"
 #include "asio/ip/bad_address_cast.hpp"
+#include "asio/ip/detail/address_chars.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -111,6 +112,28 @@ std::string address_v6::to_string() const
   return addr;
 }
 
+char* address_v6::to_chars(char* first, char* last) const
+{
+  asio::error_code ec;
+  char* result = to_chars(first, last, ec);
+  asio::detail::throw_error(ec);
+  return result;
+}
+
+char* address_v6::to_chars(char* first, char* last,
+    asio::error_code& ec) const ASIO_NOEXCEPT
+{
+  char* result = asio::ip::detail::address_v6_to_chars(
+      addr_.s6_addr, scope_id_, first, last);
+  if (result == 0)
+  {
+    ec = asio::error::no_buffer_space;
+    return first;
+  }
+  ec = asio::error_code();
+  return result;
+}
+
 #if !defined(ASIO_NO_DEPRECATED)
 std::string address_v6::to_string(asio::error_code& ec) const
 {
@@ -303,6 +326,29 @@ address_v6 make_address_v6(const std::string& str,
   return make_address_v6(str.c_str(), ec);
 }
 
+address_v6 make_address_v6(const char* first, const char* last)
+{
+  asio::error_code ec;
+  address_v6 addr = make_address_v6(first, last, ec);
+  asio::detail::throw_error(ec);
+  return addr;
+}
+
+address_v6 make_address_v6(const char* first, const char* last,
+    asio::error_code& ec) ASIO_NOEXCEPT
+{
+  address_v6::bytes_type bytes;
+  unsigned long scope_id = 0;
+  if (!asio::ip::detail::address_v6_from_chars(
+        first, last, &bytes[0], scope_id))
+  {
+    ec = asio::error::invalid_argument;
+    return address_v6();
+  }
+  ec = asio::error_code();
+  return address_v6(bytes, scope_id);
+}
+
 #if defined(ASIO_HAS_STRING_VIEW)
 
 address_v6 make_address_v6(string_view str)
@@ -0,0 +1,255 @@
+//
+// ip/impl/basic_network_map.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IP_IMPL_BASIC_NETWORK_MAP_HPP
+#define ASIO_IP_IMPL_BASIC_NETWORK_MAP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <algorithm>
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+
+template <typename Network, typename T>
+bool basic_network_map<Network, T>::insert(
+    const network_type& net, const mapped_type& value)
+{
+  network_type canonical_net = traits_type::canonical(net);
+  std::size_t length = canonical_net.prefix_length();
+
+  if (length == 0)
+  {
+    if (default_entry_ != 0)
+    {
+      entries_[default_entry_ - 1].second = value;
+      return false;
+    }
+    entries_.push_back(value_type(canonical_net, value));
+    default_entry_ = entries_.size();
+    return true;
+  }
+
+  // The network's last bits select a block of slots in a node, as its host
+  // bits are zero.
+  bytes_type key = traits_type::key(canonical_net);
+  std::size_t last_depth = (length - 1) / stride;
+  std::size_t bits = length - last_depth * stride;
+  unsigned int first_slot = slot(key, last_depth);
+  node& last_node = nodes_[make_node(key, last_depth)];
+
+  asio::uint32_t& entry = last_node.prefix[prefix(bits, first_slot)];
+  if (entry != 0)
+  {
+    entries_[entry - 1].second = value;
+    return false;
+  }
+
+  entries_.push_back(value_type(canonical_net, value));
+  entry = static_cast<asio::uint32_t>(entries_.size());
+  update_slots(last_node, first_slot, 1u << (stride - bits));
+  return true;
+}
+
+template <typename Network, typename T>
+template <typename Iterator>
+void basic_network_map<Network, T>::insert(Iterator first, Iterator last)
+{
+  std::vector<value_type> sorted;
+  for (; first != last; ++first)
+  {
+    sorted.push_back(value_type(
+          traits_type::canonical(first->first), first->second));
+  }
+
+  // A stable sort keeps duplicates in their original order, so the last
+  // value for a network wins.
+  std::stable_sort(sorted.begin(), sorted.end(), &key_less);
+
+  entries_.reserve(entries_.size() + sorted.size());
+  for (std::size_t i = 0; i < sorted.size(); ++i)
+    insert(sorted[i].first, sorted[i].second);
+}
+
+template <typename Network, typename T>
+bool basic_network_map<Network, T>::erase(const network_type& net)
+{
+  network_type canonical_net = traits_type::canonical(net);
+  std::size_t length = canonical_net.prefix_length();
+
+  if (length == 0)
+  {
+    if (default_entry_ == 0)
+      return false;
+    std::size_t entry = default_entry_;
+    default_entry_ = 0;
+    remove_entry(entry);
+    return true;
+  }
+
+  bytes_type key = traits_type::key(canonical_net);
+  std::size_t last_depth = (length - 1) / stride;
+  std::size_t bits = length - last_depth * stride;
+  unsigned int first_slot = slot(key, last_depth);
+  std::size_t n = find_node(key, last_depth);
+  if (n == nodes_.size())
+    return false;
+
+  // Nodes that become empty are kept until the map is cleared.
+  node& last_node = nodes_[n];
+  asio::uint32_t& entry = last_node.prefix[prefix(bits, first_slot)];
+  if (entry == 0)
+    return false;
+  std::size_t removed = entry;
+  entry = 0;
+  update_slots(last_node, first_slot, 1u << (stride - bits));
+  remove_entry(removed);
+  return true;
+}
+
+template <typename Network, typename T>
+const typename basic_network_map<Network, T>::value_type*
+basic_network_map<Network, T>::find(const network_type& net) const
+{
+  std::size_t length = net.prefix_length();
+  if (length == 0)
+    return default_entry_ ? &entries_[default_entry_ - 1] : 0;
+
+  bytes_type key = traits_type::key(net);
+  std::size_t last_depth = (length - 1) / stride;
+  std::size_t n = find_node(key, last_depth);
+  if (n == nodes_.size())
+    return 0;
+
+  std::size_t entry = nodes_[n].prefix[prefix(
+      length - last_depth * stride, slot(key, last_depth))];
+  return entry ? &entries_[entry - 1] : 0;
+}
+
+template <typename Network, typename T>
+const typename basic_network_map<Network, T>::value_type*
+basic_network_map<Network, T>::lookup(const address_type& addr) const
+{
+  bytes_type key = addr.to_bytes();
+  std::size_t best = default_entry_;
+  std::size_t n = 0;
+  for (std::size_t depth = 0; depth < max_depth; ++depth)
+  {
+    const node& current = nodes_[n];
+    unsigned int s = slot(key, depth);
+    if (current.entry[s] != 0)
+      best = current.entry[s];
+    n = current.child[s];
+    if (n == 0)
+      break;
+  }
+  return best ? &entries_[best - 1] : 0;
+}
+
+template <typename Network, typename T>
+std::size_t basic_network_map<Network, T>::find_node(
+    const bytes_type& key, std::size_t depth) const
+{
+  std::size_t n = 0;
+  for (std::size_t d = 0; d < depth; ++d)
+  {
+    n = nodes_[n].child[slot(key, d)];
+    if (n == 0)
+      return nodes_.size();
+  }
+  return n;
+}
+
+template <typename Network, typename T>
+std::size_t basic_network_map<Network, T>::make_node(
+    const bytes_type& key, std::size_t depth)
+{
+  std::size_t n = 0;
+  for (std::size_t d = 0; d < depth; ++d)
+  {
+    unsigned int s = slot(key, d);
+    std::size_t child = nodes_[n].child[s];
+    if (child == 0)
+    {
+      child = nodes_.size();
+      nodes_.push_back(node());
+      nodes_[n].child[s] = static_cast<asio::uint32_t>(child);
+    }
+    n = child;
+  }
+  return n;
+}
+
+template <typename Network, typename T>
+void basic_network_map<Network, T>::update_slots(node& n,
+    unsigned int first_slot, unsigned int slot_count)
+{
+  for (unsigned int s = first_slot; s < first_slot + slot_count; ++s)
+  {
+    // The longest network on this level that covers the slot wins.
+    asio::uint32_t entry = 0;
+    for (std::size_t bits = stride; bits > 0 && entry == 0; --bits)
+      entry = n.prefix[prefix(bits, s)];
+    n.entry[s] = entry;
+  }
+}
+
+template <typename Network, typename T>
+void basic_network_map<Network, T>::remove_entry(std::size_t entry)
+{
+  std::size_t moved = entries_.size();
+  if (entry != moved)
+  {
+    entries_[entry - 1] = entries_.back();
+
+    // Point the trie at the moved entry's new position. A network's entry
+    // only appears in the node where it was recorded.
+    const network_type& net = entries_[entry - 1].first;
+    std::size_t length = net.prefix_length();
+    if (length == 0)
+    {
+      default_entry_ = entry;
+    }
+    else
+    {
+      bytes_type key = traits_type::key(net);
+      std::size_t last_depth = (length - 1) / stride;
+      node& n = nodes_[find_node(key, last_depth)];
+      n.prefix[prefix(length - last_depth * stride,
+          slot(key, last_depth))] = static_cast<asio::uint32_t>(entry);
+      for (unsigned int s = 0; s < fanout; ++s)
+        if (n.entry[s] == moved)
+          n.entry[s] = static_cast<asio::uint32_t>(entry);
+    }
+  }
+  entries_.pop_back();
+}
+
+template <typename Network, typename T>
+bool basic_network_map<Network, T>::key_less(
+    const value_type& a, const value_type& b)
+{
+  bytes_type a_key = traits_type::key(a.first);
+  bytes_type b_key = traits_type::key(b.first);
+  if (a_key != b_key)
+    return a_key < b_key;
+  return a.first.prefix_length() < b.first.prefix_length();
+}
+
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IP_IMPL_BASIC_NETWORK_MAP_HPP
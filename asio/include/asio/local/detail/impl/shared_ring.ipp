@@ -0,0 +1,465 @@
+//
+// local/detail/impl/shared_ring.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_LOCAL_DETAIL_IMPL_SHARED_RING_IPP
+#define ASIO_LOCAL_DETAIL_IMPL_SHARED_RING_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_SHARED_MEMORY_CHANNEL)
+
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__)
+# include <sys/syscall.h>
+#endif // defined(__linux__)
+#if defined(ASIO_HAS_EVENTFD)
+# include <sys/eventfd.h>
+#else // defined(ASIO_HAS_EVENTFD)
+# include <sys/socket.h>
+#endif // defined(ASIO_HAS_EVENTFD)
+#include "asio/error.hpp"
+#include "asio/local/detail/shared_ring.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace local {
+namespace detail {
+
+int shared_ring::open_anonymous_memory(asio::error_code& ec)
+{
+#if defined(__linux__) && defined(SYS_memfd_create)
+  int fd = static_cast<int>(::syscall(SYS_memfd_create,
+        "asio.shared_memory_channel", 1 /* MFD_CLOEXEC */));
+  if (fd != -1)
+    return fd;
+  if (errno != ENOSYS)
+    return asio::detail::descriptor_ops::error_wrapper(fd, ec);
+#endif // defined(__linux__) && defined(SYS_memfd_create)
+
+  // Fall back to a uniquely named POSIX shared memory object that is unlinked
+  // as soon as it has been opened.
+  static std::atomic<unsigned long> counter(0);
+  for (;;)
+  {
+    char name[64];
+    std::snprintf(name, sizeof(name), "/asio-channel-%ld-%lu",
+        static_cast<long>(::getpid()), ++counter);
+    int fd = ::shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd != -1)
+    {
+      ::shm_unlink(name);
+      ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+      return fd;
+    }
+    if (errno != EEXIST)
+      return asio::detail::descriptor_ops::error_wrapper(fd, ec);
+  }
+}
+
+shared_ring::shared_ring()
+  : header_(0),
+    data_(0),
+    capacity_(0),
+    mapped_size_(0),
+    peer_pos_(0)
+{
+}
+
+shared_ring::~shared_ring()
+{
+  unmap();
+}
+
+int shared_ring::create(std::size_t capacity, asio::error_code& ec)
+{
+  std::size_t rounded = min_capacity;
+  while (rounded < capacity && rounded <= 0x40000000)
+    rounded <<= 1;
+  if (rounded < capacity)
+  {
+    ec = asio::error::invalid_argument;
+    return -1;
+  }
+
+  int fd = open_anonymous_memory(ec);
+  if (fd == -1)
+    return -1;
+
+  if (::ftruncate(fd, static_cast<off_t>(data_offset + rounded)) != 0)
+  {
+    asio::detail::descriptor_ops::error_wrapper(-1, ec);
+    ::close(fd);
+    return -1;
+  }
+
+  // The region is zero-filled, which is the initial state of the positions
+  // and flags. Only the identifying fields need to be written.
+  void* p = ::mmap(0, data_offset, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (p == MAP_FAILED)
+  {
+    asio::detail::descriptor_ops::error_wrapper(-1, ec);
+    ::close(fd);
+    return -1;
+  }
+  header* h = static_cast<header*>(p);
+  h->capacity_ = rounded;
+  h->magic_ = magic;
+  ::munmap(p, data_offset);
+
+  ec = asio::error_code();
+  return fd;
+}
+
+asio::error_code shared_ring::create_doorbell(
+    int& wait_fd, int& notify_fd, asio::error_code& ec)
+{
+#if defined(ASIO_HAS_EVENTFD)
+  int fd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (fd == -1)
+  {
+    asio::detail::descriptor_ops::error_wrapper(-1, ec);
+    return ec;
+  }
+
+  int dup_fd = ::fcntl(fd, F_DUPFD_CLOEXEC, 0);
+  if (dup_fd == -1)
+  {
+    asio::detail::descriptor_ops::error_wrapper(-1, ec);
+    ::close(fd);
+    return ec;
+  }
+
+  wait_fd = fd;
+  notify_fd = dup_fd;
+  ec = asio::error_code();
+  return ec;
+#else // defined(ASIO_HAS_EVENTFD)
+  // A socket pair is used rather than a pipe so that ringing a doorbell whose
+  // waiting end has been closed does not raise SIGPIPE.
+  int fds[2];
+  if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+  {
+    asio::detail::descriptor_ops::error_wrapper(-1, ec);
+    return ec;
+  }
+
+  for (int i = 0; i < 2; ++i)
+  {
+    ::fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+#if defined(__MACH__) && defined(__APPLE__) || defined(__FreeBSD__)
+    int optval = 1;
+    ::setsockopt(fds[i], SOL_SOCKET, SO_NOSIGPIPE, &optval, sizeof(optval));
+#endif // defined(__MACH__) && defined(__APPLE__) || defined(__FreeBSD__)
+    if (prepare_doorbell(fds[i], ec))
+    {
+      ::close(fds[0]);
+      ::close(fds[1]);
+      return ec;
+    }
+  }
+
+  wait_fd = fds[0];
+  notify_fd = fds[1];
+  return ec;
+#endif // defined(ASIO_HAS_EVENTFD)
+}
+
+asio::error_code shared_ring::prepare_doorbell(
+    int fd, asio::error_code& ec)
+{
+  int flags = ::fcntl(fd, F_GETFL, 0);
+  if (flags == -1 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == -1)
+  {
+    asio::detail::descriptor_ops::error_wrapper(-1, ec);
+    return ec;
+  }
+  ec = asio::error_code();
+  return ec;
+}
+
+void shared_ring::ring(int notify_fd)
+{
+  // An eventfd requires an eight byte counter value. If a socket's buffer is
+  // full then a ring is already pending.
+  uint64_t value = 1;
+#if !defined(ASIO_HAS_EVENTFD) && defined(__linux__)
+  ssize_t result = ::send(notify_fd, &value, sizeof(value), MSG_NOSIGNAL);
+#else // !defined(ASIO_HAS_EVENTFD) && defined(__linux__)
+  ssize_t result = ::write(notify_fd, &value, sizeof(value));
+#endif // !defined(ASIO_HAS_EVENTFD) && defined(__linux__)
+  (void)result;
+}
+
+void shared_ring::drain(int wait_fd)
+{
+  char data[64];
+  while (::read(wait_fd, data, sizeof(data)) > 0)
+  {
+  }
+}
+
+asio::error_code shared_ring::map(int memory_fd, asio::error_code& ec)
+{
+  unmap();
+
+  struct stat st;
+  if (::fstat(memory_fd, &st) != 0)
+  {
+    asio::detail::descriptor_ops::error_wrapper(-1, ec);
+    return ec;
+  }
+
+  std::size_t size = static_cast<std::size_t>(st.st_size);
+  if (size <= data_offset)
+  {
+    ec = asio::error::invalid_argument;
+    return ec;
+  }
+
+  void* p = ::mmap(0, size, PROT_READ | PROT_WRITE,
+      MAP_SHARED, memory_fd, 0);
+  if (p == MAP_FAILED)
+  {
+    asio::detail::descriptor_ops::error_wrapper(-1, ec);
+    return ec;
+  }
+
+  header* h = static_cast<header*>(p);
+  std::size_t capacity = static_cast<std::size_t>(h->capacity_);
+  if (h->magic_ != magic
+      || capacity < min_capacity
+      || (capacity & (capacity - 1)) != 0
+      || size != data_offset + capacity)
+  {
+    ::munmap(p, size);
+    ec = asio::error::invalid_argument;
+    return ec;
+  }
+
+  // Positions that are not lock-free would be protected by a process-local
+  // lock, which the other process cannot see.
+  if (!h->write_pos_.is_lock_free() || !h->reader_parked_.is_lock_free())
+  {
+    ::munmap(p, size);
+    ec = asio::error::operation_not_supported;
+    return ec;
+  }
+
+  header_ = h;
+  data_ = static_cast<unsigned char*>(p) + data_offset;
+  capacity_ = capacity;
+  mapped_size_ = size;
+
+  // The read position is a valid lower bound for either side's view of the
+  // other: the writer's view of the read position and the reader's view of
+  // the write position.
+  peer_pos_ = h->read_pos_.load(std::memory_order_acquire);
+
+  ec = asio::error_code();
+  return ec;
+}
+
+void shared_ring::unmap()
+{
+  if (header_)
+  {
+    ::munmap(header_, mapped_size_);
+    header_ = 0;
+    data_ = 0;
+    capacity_ = 0;
+    mapped_size_ = 0;
+  }
+}
+
+bool shared_ring::try_write(const buf* bufs, std::size_t count,
+    std::size_t total_size, int notify_fd, asio::error_code& ec)
+{
+  if (header_->reader_closed_.load(std::memory_order_acquire))
+  {
+    ec = asio::error::broken_pipe;
+    return true;
+  }
+
+  if (total_size > max_message_size())
+  {
+    ec = asio::error::message_size;
+    return true;
+  }
+
+  const std::size_t frame = frame_size(total_size);
+  const uint64_t pos = header_->write_pos_.load(std::memory_order_relaxed);
+  if (pos - peer_pos_ > capacity_ - frame)
+  {
+    peer_pos_ = header_->read_pos_.load(std::memory_order_acquire);
+    if (pos - peer_pos_ > capacity_ - frame)
+      return false;
+  }
+
+  uint32_t length = static_cast<uint32_t>(total_size);
+  std::memcpy(data_ + (pos & (capacity_ - 1)), &length, sizeof(length));
+  uint64_t p = pos + sizeof(length);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    copy_in(p, bufs[i].iov_base, bufs[i].iov_len);
+    p += bufs[i].iov_len;
+  }
+
+  header_->write_pos_.store(pos + frame, std::memory_order_release);
+  notify(header_->reader_parked_, notify_fd);
+
+  ec = asio::error_code();
+  return true;
+}
+
+bool shared_ring::park_writer()
+{
+  header_->writer_parked_.store(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (header_->read_pos_.load(std::memory_order_relaxed) != peer_pos_
+      || header_->reader_closed_.load(std::memory_order_relaxed))
+  {
+    header_->writer_parked_.store(0, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+void shared_ring::close_writer(int notify_fd)
+{
+  header_->writer_closed_.store(1, std::memory_order_release);
+  ring(notify_fd);
+}
+
+bool shared_ring::try_read(buf* bufs, std::size_t count, int notify_fd,
+    std::size_t& bytes_transferred, asio::error_code& ec)
+{
+  const uint64_t pos = header_->read_pos_.load(std::memory_order_relaxed);
+  if (peer_pos_ == pos)
+  {
+    peer_pos_ = header_->write_pos_.load(std::memory_order_acquire);
+    if (peer_pos_ == pos)
+    {
+      if (!header_->writer_closed_.load(std::memory_order_acquire))
+        return false;
+
+      // Messages written before the writer closed remain readable.
+      peer_pos_ = header_->write_pos_.load(std::memory_order_acquire);
+      if (peer_pos_ == pos)
+      {
+        bytes_transferred = 0;
+        ec = asio::error::eof;
+        return true;
+      }
+    }
+  }
+
+  // The positions and the frame come from memory that the writer can modify,
+  // so the frame is checked against the published data before it is used. A
+  // frame that does not fit shows that the ring is corrupt. The read position
+  // is left where it is, so that nothing more is read from the ring.
+  const uint64_t available = peer_pos_ - pos;
+  uint32_t length = 0;
+  if (available >= sizeof(length) && available <= capacity_)
+    std::memcpy(&length, data_ + (pos & (capacity_ - 1)), sizeof(length));
+  if (available < sizeof(length) || available > capacity_
+      || ((sizeof(length) + static_cast<uint64_t>(length) + 7)
+        & ~static_cast<uint64_t>(7)) > available)
+  {
+    bytes_transferred = 0;
+    ec = asio::error::invalid_argument;
+    return true;
+  }
+
+  uint64_t p = pos + sizeof(length);
+  std::size_t remaining = length;
+  for (std::size_t i = 0; i < count && remaining > 0; ++i)
+  {
+    std::size_t n = bufs[i].iov_len < remaining ? bufs[i].iov_len : remaining;
+    copy_out(p, bufs[i].iov_base, n);
+    p += n;
+    remaining -= n;
+  }
+
+  header_->read_pos_.store(pos + frame_size(length),
+      std::memory_order_release);
+  notify(header_->writer_parked_, notify_fd);
+
+  // A message that does not fit is truncated, as for a datagram.
+  bytes_transferred = length - remaining;
+  ec = remaining > 0 ? asio::error::message_size : asio::error_code();
+  return true;
+}
+
+bool shared_ring::park_reader()
+{
+  header_->reader_parked_.store(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (header_->write_pos_.load(std::memory_order_relaxed) != peer_pos_
+      || header_->writer_closed_.load(std::memory_order_relaxed))
+  {
+    header_->reader_parked_.store(0, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+void shared_ring::close_reader(int notify_fd)
+{
+  header_->reader_closed_.store(1, std::memory_order_release);
+  ring(notify_fd);
+}
+
+void shared_ring::copy_in(uint64_t pos, const void* data, std::size_t size)
+{
+  std::size_t offset = static_cast<std::size_t>(pos & (capacity_ - 1));
+  std::size_t first = capacity_ - offset < size ? capacity_ - offset : size;
+  std::memcpy(data_ + offset, data, first);
+  std::memcpy(data_, static_cast<const unsigned char*>(data) + first,
+      size - first);
+}
+
+void shared_ring::copy_out(uint64_t pos, void* data, std::size_t size) const
+{
+  std::size_t offset = static_cast<std::size_t>(pos & (capacity_ - 1));
+  std::size_t first = capacity_ - offset < size ? capacity_ - offset : size;
+  std::memcpy(data, data_ + offset, first);
+  std::memcpy(static_cast<unsigned char*>(data) + first, data_,
+      size - first);
+}
+
+void shared_ring::notify(std::atomic<uint32_t>& parked, int notify_fd)
+{
+  // Pairs with the fence in park_reader() and park_writer(): either the
+  // parked side sees the new position, or this side sees the flag.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (parked.load(std::memory_order_relaxed)
+      && parked.exchange(0, std::memory_order_relaxed))
+    ring(notify_fd);
+}
+
+} // namespace detail
+} // namespace local
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_SHARED_MEMORY_CHANNEL)
+
+#endif // ASIO_LOCAL_DETAIL_IMPL_SHARED_RING_IPP
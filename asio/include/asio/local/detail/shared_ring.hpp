@@ -0,0 +1,186 @@
+//
+// local/detail/shared_ring.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_LOCAL_DETAIL_SHARED_RING_HPP
+#define ASIO_LOCAL_DETAIL_SHARED_RING_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_SHARED_MEMORY_CHANNEL)
+
+#include <atomic>
+#include <cstddef>
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/descriptor_ops.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/error_code.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace local {
+namespace detail {
+
+// A single-producer, single-consumer ring of length-prefixed messages held in
+// a shared memory region. Each process maps the region through its own
+// shared_ring object, and uses only the writer or only the reader operations.
+//
+// A side that finds the ring full (writer) or empty (reader) parks itself by
+// setting a flag in the shared header, then waits on a doorbell descriptor.
+// The other side rings the doorbell only if it sees that flag, so that no
+// system call is made while both sides are keeping up.
+class shared_ring
+  : private asio::detail::noncopyable
+{
+public:
+  typedef asio::detail::descriptor_ops::buf buf;
+
+  // The smallest capacity of the data area, in bytes.
+  static const std::size_t min_capacity = 1024;
+
+  // Constructor.
+  ASIO_DECL shared_ring();
+
+  // Destructor unmaps the region.
+  ASIO_DECL ~shared_ring();
+
+  // Create a new region with at least the given capacity, returning a
+  // descriptor that refers to it.
+  ASIO_DECL static int create(std::size_t capacity, asio::error_code& ec);
+
+  // Create a doorbell, returning the descriptor to wait on and the descriptor
+  // used to ring it.
+  ASIO_DECL static asio::error_code create_doorbell(
+      int& wait_fd, int& notify_fd, asio::error_code& ec);
+
+  // Make a doorbell descriptor non-blocking.
+  ASIO_DECL static asio::error_code prepare_doorbell(
+      int fd, asio::error_code& ec);
+
+  // Ring a doorbell.
+  ASIO_DECL static void ring(int notify_fd);
+
+  // Consume any pending rings on a doorbell.
+  ASIO_DECL static void drain(int wait_fd);
+
+  // Map the region referred to by the descriptor.
+  ASIO_DECL asio::error_code map(int memory_fd, asio::error_code& ec);
+
+  // Unmap the region.
+  ASIO_DECL void unmap();
+
+  // Whether the region is mapped.
+  bool is_mapped() const
+  {
+    return header_ != 0;
+  }
+
+  // The largest message that fits in the ring.
+  std::size_t max_message_size() const
+  {
+    return capacity_ - sizeof(uint32_t);
+  }
+
+  // Writer: append one message gathered from the buffers. Returns false if
+  // there is not yet enough space. Otherwise returns true and sets ec.
+  ASIO_DECL bool try_write(const buf* bufs, std::size_t count,
+      std::size_t total_size, int notify_fd, asio::error_code& ec);
+
+  // Writer: record that the writer is about to wait for space. Returns false
+  // if the reader has made progress since the last attempt to write.
+  ASIO_DECL bool park_writer();
+
+  // Writer: mark the writing end as closed and wake the reader.
+  ASIO_DECL void close_writer(int notify_fd);
+
+  // Reader: remove one message, scattering it into the buffers. Returns false
+  // if the ring is empty. Otherwise returns true and sets bytes_transferred
+  // and ec.
+  ASIO_DECL bool try_read(buf* bufs, std::size_t count, int notify_fd,
+      std::size_t& bytes_transferred, asio::error_code& ec);
+
+  // Reader: record that the reader is about to wait for data. Returns false
+  // if the writer has made progress since the last attempt to read.
+  ASIO_DECL bool park_reader();
+
+  // Reader: mark the reading end as closed and wake the writer.
+  ASIO_DECL void close_reader(int notify_fd);
+
+private:
+  // Ring positions increase monotonically and are reduced modulo the
+  // capacity when used. Each position is written by one side only, and is
+  // kept on its own cache line.
+  struct header
+  {
+    uint64_t magic_;
+    uint64_t capacity_;
+    char pad0_[48];
+    std::atomic<uint64_t> write_pos_;
+    char pad1_[56];
+    std::atomic<uint64_t> read_pos_;
+    char pad2_[56];
+    std::atomic<uint32_t> reader_parked_;
+    std::atomic<uint32_t> writer_parked_;
+    std::atomic<uint32_t> writer_closed_;
+    std::atomic<uint32_t> reader_closed_;
+  };
+
+  // The offset of the data area within the region.
+  static const std::size_t data_offset = 256;
+
+  // Identifies a region that has been initialised as a ring.
+  static const uint64_t magic = 0x61736d72696e6731ULL;
+
+  // Each message is preceded by its length and padded so that the next length
+  // is aligned, and so never wraps around the end of the data area.
+  static std::size_t frame_size(std::size_t message_size)
+  {
+    return (sizeof(uint32_t) + message_size + 7)
+      & ~static_cast<std::size_t>(7);
+  }
+
+  // Open a descriptor for a new, unnamed shared memory object.
+  ASIO_DECL static int open_anonymous_memory(asio::error_code& ec);
+
+  // Copy between the buffers and the data area, wrapping as required.
+  ASIO_DECL void copy_in(uint64_t pos, const void* data, std::size_t size);
+  ASIO_DECL void copy_out(uint64_t pos, void* data, std::size_t size) const;
+
+  // Wake the peer if it has parked.
+  ASIO_DECL static void notify(std::atomic<uint32_t>& parked, int notify_fd);
+
+  header* header_;
+  unsigned char* data_;
+  std::size_t capacity_;
+  std::size_t mapped_size_;
+
+  // The last observed position of the other side. The writer caches the read
+  // position and the reader caches the write position, so that the other
+  // side's cache line is only read when the ring appears full or empty.
+  uint64_t peer_pos_;
+};
+
+} // namespace detail
+} // namespace local
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/local/detail/impl/shared_ring.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // defined(ASIO_HAS_SHARED_MEMORY_CHANNEL)
+
+#endif // ASIO_LOCAL_DETAIL_SHARED_RING_HPP
@@ -0,0 +1,300 @@
+//
+// local/fd_passing.hpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_LOCAL_FD_PASSING_HPP
+#define ASIO_LOCAL_FD_PASSING_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include <vector>
+#include "asio/async_result.hpp"
+#include "asio/basic_socket.hpp"
+#include "asio/detail/socket_ops.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace local {
+
+/// The largest number of descriptors that may be passed in a single message.
+#if defined(GENERATING_DOCUMENTATION)
+const std::size_t max_fds_per_message = implementation_defined;
+#else // defined(GENERATING_DOCUMENTATION)
+const std::size_t max_fds_per_message
+  = asio::detail::socket_ops::max_fds_per_message;
+#endif // defined(GENERATING_DOCUMENTATION)
+
+/**
+ * @defgroup send_with_fds asio::local::send_with_fds
+ *
+ * @brief Write data to a UNIX domain socket, passing descriptors with it.
+ */
+/*@{*/
+
+/// Write all of the supplied data to a UNIX domain socket, passing a set of
+/// descriptors with it.
+/**
+ * This function is used to write data to a UNIX domain socket and to pass
+ * copies of the given descriptors to the peer in an @c SCM_RIGHTS control
+ * message. The call will block until all of the data has been written or an
+ * error occurs.
+ *
+ * The descriptors are attached to the first @c sendmsg call, and so arrive
+ * with the first byte of the data. At least one byte of data must be written
+ * when descriptors are passed. On a datagram socket all of the data is sent
+ * as a single message.
+ *
+ * @param s The socket to which the data is to be written.
+ *
+ * @param buffers One or more buffers containing the data to be written.
+ *
+ * @param fds A pointer to the descriptors to be passed. The caller retains
+ * ownership of the descriptors, which may be closed once the function returns.
+ *
+ * @param fd_count The number of descriptors to be passed. Must not exceed
+ * max_fds_per_message.
+ *
+ * @returns The number of bytes written.
+ *
+ * @throws asio::system_error Thrown on failure.
+ */
+template <typename Protocol, typename Executor, typename ConstBufferSequence>
+std::size_t send_with_fds(basic_socket<Protocol, Executor>& s,
+    const ConstBufferSequence& buffers, const int* fds, std::size_t fd_count);
+
+/// Write all of the supplied data to a UNIX domain socket, passing a set of
+/// descriptors with it.
+/**
+ * This function is used to write data to a UNIX domain socket and to pass
+ * copies of the given descriptors to the peer in an @c SCM_RIGHTS control
+ * message. The call will block until all of the data has been written or an
+ * error occurs.
+ *
+ * @param s The socket to which the data is to be written.
+ *
+ * @param buffers One or more buffers containing the data to be written.
+ *
+ * @param fds A pointer to the descriptors to be passed.
+ *
+ * @param fd_count The number of descriptors to be passed.
+ *
+ * @param ec Set to indicate what error occurred, if any.
+ *
+ * @returns The number of bytes written.
+ */
+template <typename Protocol, typename Executor, typename ConstBufferSequence>
+std::size_t send_with_fds(basic_socket<Protocol, Executor>& s,
+    const ConstBufferSequence& buffers, const int* fds, std::size_t fd_count,
+    asio::error_code& ec);
+
+/*@}*/
+
+/**
+ * @defgroup async_send_with_fds asio::local::async_send_with_fds
+ *
+ * @brief Start an asynchronous operation to write data to a UNIX domain
+ * socket, passing descriptors with it.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to write all of the supplied data to a
+/// UNIX domain socket, passing a set of descriptors with it.
+/**
+ * This function is used to asynchronously write data to a UNIX domain socket
+ * and to pass copies of the given descriptors to the peer in an @c SCM_RIGHTS
+ * control message. The function call always returns immediately. The
+ * operation continues until all of the data has been written or an error
+ * occurs.
+ *
+ * The descriptors are attached to the first @c sendmsg call, and so arrive
+ * with the first byte of the data. On a datagram socket all of the data is
+ * sent as a single message. Passing many descriptors in one call amortises
+ * the system call and wakeup costs over the whole batch. The socket does not
+ * need to be in non-blocking mode.
+ *
+ * @param s The socket to which the data is to be written.
+ *
+ * @param buffers One or more buffers containing the data to be written.
+ * Although the buffers object may be copied as necessary, ownership of the
+ * underlying memory blocks is retained by the caller, which must guarantee
+ * that they remain valid until the handler is called.
+ *
+ * @param fds A pointer to the descriptors to be passed. The caller retains
+ * ownership of the array and of the descriptors, and must guarantee that both
+ * remain valid until the handler is called.
+ *
+ * @param fd_count The number of descriptors to be passed. Must not exceed
+ * max_fds_per_message.
+ *
+ * @param handler The handler to be called when the operation completes.
+ * Copies will be made of the handler as required. The function signature of
+ * the handler must be:
+ * @code void handler(
+ *   const asio::error_code& error, // Result of operation.
+ *   std::size_t bytes_transferred           // Number of bytes written.
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. On
+ * immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::post().
+ */
+template <typename Protocol, typename Executor, typename ConstBufferSequence,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) WriteHandler
+        ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(Executor)>
+ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+    void (asio::error_code, std::size_t))
+async_send_with_fds(basic_socket<Protocol, Executor>& s,
+    const ConstBufferSequence& buffers, const int* fds, std::size_t fd_count,
+    ASIO_MOVE_ARG(WriteHandler) handler
+      ASIO_DEFAULT_COMPLETION_TOKEN(Executor));
+
+/*@}*/
+
+/**
+ * @defgroup receive_with_fds asio::local::receive_with_fds
+ *
+ * @brief Read data from a UNIX domain socket, together with any descriptors
+ * passed with it.
+ */
+/*@{*/
+
+/// Read some data from a UNIX domain socket, together with any descriptors
+/// passed with it.
+/**
+ * This function is used to read data from a UNIX domain socket. Descriptors
+ * that arrive in an @c SCM_RIGHTS control message with the data are appended
+ * to @c fds. The call will block until at least one byte has been read or an
+ * error occurs.
+ *
+ * The caller becomes responsible for closing the received descriptors. If the
+ * control message was truncated, every descriptor that arrived with it is
+ * closed, none are appended to @c fds, and the error
+ * asio::error::message_size is reported after the data has been received.
+ *
+ * @param s The socket from which the data is to be read.
+ *
+ * @param buffers One or more buffers into which the data will be read.
+ *
+ * @param fds A vector to which the received descriptors are appended.
+ *
+ * @returns The number of bytes read.
+ *
+ * @throws asio::system_error Thrown on failure. An error code of
+ * asio::error::eof indicates that the connection was closed by the
+ * peer.
+ */
+template <typename Protocol, typename Executor, typename MutableBufferSequence>
+std::size_t receive_with_fds(basic_socket<Protocol, Executor>& s,
+    const MutableBufferSequence& buffers, std::vector<int>& fds);
+
+/// Read some data from a UNIX domain socket, together with any descriptors
+/// passed with it.
+/**
+ * This function is used to read data from a UNIX domain socket. Descriptors
+ * that arrive in an @c SCM_RIGHTS control message with the data are appended
+ * to @c fds. The call will block until at least one byte has been read or an
+ * error occurs.
+ *
+ * @param s The socket from which the data is to be read.
+ *
+ * @param buffers One or more buffers into which the data will be read.
+ *
+ * @param fds A vector to which the received descriptors are appended.
+ *
+ * @param ec Set to indicate what error occurred, if any.
+ *
+ * @returns The number of bytes read.
+ */
+template <typename Protocol, typename Executor, typename MutableBufferSequence>
+std::size_t receive_with_fds(basic_socket<Protocol, Executor>& s,
+    const MutableBufferSequence& buffers, std::vector<int>& fds,
+    asio::error_code& ec);
+
+/*@}*/
+
+/**
+ * @defgroup async_receive_with_fds asio::local::async_receive_with_fds
+ *
+ * @brief Start an asynchronous operation to read data from a UNIX domain
+ * socket, together with any descriptors passed with it.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to read some data from a UNIX domain
+/// socket, together with any descriptors passed with it.
+/**
+ * This function is used to asynchronously read data from a UNIX domain socket.
+ * Descriptors that arrive in an @c SCM_RIGHTS control message with the data
+ * are appended to @c fds. The function call always returns immediately. The
+ * operation completes when at least one byte has been read or an error
+ * occurs.
+ *
+ * The caller becomes responsible for closing the received descriptors. On
+ * Linux they are created with the close-on-exec flag set. If the control
+ * message was truncated, every descriptor that arrived with it is closed and
+ * the handler is passed the error asio::error::message_size.
+ *
+ * @param s The socket from which the data is to be read.
+ *
+ * @param buffers One or more buffers into which the data will be read.
+ * Although the buffers object may be copied as necessary, ownership of the
+ * underlying memory blocks is retained by the caller, which must guarantee
+ * that they remain valid until the handler is called.
+ *
+ * @param fds A vector to which the received descriptors are appended.
+ * Ownership of the vector is retained by the caller, which must guarantee
+ * that it remains valid until the handler is called.
+ *
+ * @param handler The handler to be called when the operation completes.
+ * Copies will be made of the handler as required. The function signature of
+ * the handler must be:
+ * @code void handler(
+ *   const asio::error_code& error, // Result of operation.
+ *   std::size_t bytes_transferred           // Number of bytes read.
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. On
+ * immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::post().
+ */
+template <typename Protocol, typename Executor, typename MutableBufferSequence,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) ReadHandler
+        ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(Executor)>
+ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+    void (asio::error_code, std::size_t))
+async_receive_with_fds(basic_socket<Protocol, Executor>& s,
+    const MutableBufferSequence& buffers, std::vector<int>& fds,
+    ASIO_MOVE_ARG(ReadHandler) handler
+      ASIO_DEFAULT_COMPLETION_TOKEN(Executor));
+
+/*@}*/
+
+} // namespace local
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/local/impl/fd_passing.hpp"
+
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_LOCAL_FD_PASSING_HPP
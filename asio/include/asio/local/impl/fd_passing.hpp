@@ -0,0 +1,683 @@
+//
+// local/impl/fd_passing.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_LOCAL_IMPL_FD_PASSING_HPP
+#define ASIO_LOCAL_IMPL_FD_PASSING_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <limits>
+#include "asio/associated_allocator.hpp"
+#include "asio/associated_executor.hpp"
+#include "asio/buffer.hpp"
+#include "asio/completion_condition.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/consuming_buffers.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_cont_helpers.hpp"
+#include "asio/detail/handler_invoke_helpers.hpp"
+#include "asio/detail/handler_type_requirements.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/throw_error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace local {
+namespace detail {
+
+  // Attempt a single non-blocking sendmsg. Returns false if the operation
+  // needs to wait for the socket to become writable.
+  template <typename ConstBufferSequence>
+  bool non_blocking_send_with_fds(asio::detail::socket_type s,
+      const ConstBufferSequence& buffers, const int* fds,
+      std::size_t fd_count, asio::error_code& ec,
+      std::size_t& bytes_transferred)
+  {
+    asio::detail::buffer_sequence_adapter<asio::const_buffer,
+        ConstBufferSequence> bufs(buffers);
+
+    for (;;)
+    {
+      asio::detail::signed_size_type bytes =
+        asio::detail::socket_ops::send_with_fds(s, bufs.buffers(),
+            bufs.count(), fds, fd_count, MSG_DONTWAIT, ec);
+
+      // Retry operation if interrupted by signal.
+      if (ec == asio::error::interrupted)
+        continue;
+
+      // Check if we need to run the operation again.
+      if (ec == asio::error::would_block
+          || ec == asio::error::try_again)
+        return false;
+
+      bytes_transferred = bytes >= 0 ? bytes : 0;
+      return true;
+    }
+  }
+
+  // Stream sockets send the data in chunks, with the descriptors attached to
+  // the first. Any other socket must send the data as a single message.
+  template <typename Protocol>
+  inline std::size_t send_with_fds_chunk_size()
+  {
+    return Protocol().type() == SOCK_STREAM
+      ? asio::detail::default_max_transfer_size
+      : (std::numeric_limits<std::size_t>::max)();
+  }
+
+  // Attempt a single non-blocking recvmsg, appending any received descriptors
+  // to the vector. Returns false if the operation needs to wait for the socket
+  // to become readable.
+  template <typename Protocol, typename MutableBufferSequence>
+  bool non_blocking_receive_with_fds(asio::detail::socket_type s,
+      const MutableBufferSequence& buffers, std::vector<int>& fds,
+      asio::error_code& ec, std::size_t& bytes_transferred)
+  {
+    asio::detail::buffer_sequence_adapter<asio::mutable_buffer,
+        MutableBufferSequence> bufs(buffers);
+
+    for (;;)
+    {
+      int received_fds[asio::detail::socket_ops::max_fds_per_message];
+      std::size_t fd_count = 0;
+      asio::detail::signed_size_type bytes =
+        asio::detail::socket_ops::recv_with_fds(s, bufs.buffers(),
+            bufs.count(), received_fds, fd_count, MSG_DONTWAIT, ec);
+
+      // Retry operation if interrupted by signal.
+      if (ec == asio::error::interrupted)
+        continue;
+
+      // Check if we need to run the operation again.
+      if (ec == asio::error::would_block
+          || ec == asio::error::try_again)
+        return false;
+
+      fds.insert(fds.end(), received_fds, received_fds + fd_count);
+
+      // Check for EOF.
+      if (!ec && bytes == 0 && !bufs.all_empty()
+          && Protocol().type() == SOCK_STREAM)
+        ec = asio::error::eof;
+
+      bytes_transferred = bytes >= 0 ? bytes : 0;
+      return true;
+    }
+  }
+
+  template <typename Protocol, typename Executor, typename ConstBufferSequence,
+      typename ConstBufferIterator, typename WriteHandler>
+  class send_with_fds_op
+  {
+  public:
+    typedef basic_socket<Protocol, Executor> socket_type;
+
+    send_with_fds_op(socket_type& socket, const ConstBufferSequence& buffers,
+        const int* fds, std::size_t fd_count, WriteHandler& handler)
+      : socket_(socket),
+        buffers_(buffers),
+        fds_(fds),
+        fd_count_(fd_count),
+        start_(0),
+        handler_(ASIO_MOVE_CAST(WriteHandler)(handler))
+    {
+    }
+
+#if defined(ASIO_HAS_MOVE)
+    send_with_fds_op(const send_with_fds_op& other)
+      : socket_(other.socket_),
+        buffers_(other.buffers_),
+        fds_(other.fds_),
+        fd_count_(other.fd_count_),
+        start_(other.start_),
+        handler_(other.handler_)
+    {
+    }
+
+    send_with_fds_op(send_with_fds_op&& other)
+      : socket_(other.socket_),
+        buffers_(ASIO_MOVE_CAST(buffers_type)(other.buffers_)),
+        fds_(other.fds_),
+        fd_count_(other.fd_count_),
+        start_(other.start_),
+        handler_(ASIO_MOVE_CAST(WriteHandler)(other.handler_))
+    {
+    }
+#endif // defined(ASIO_HAS_MOVE)
+
+    void operator()(asio::error_code ec, int start = 0)
+    {
+      if ((start_ = start) == 1)
+      {
+        // Always start with a wait so that the handler is not invoked from
+        // within the initiating function.
+        socket_.async_wait(socket_type::wait_write,
+            ASIO_MOVE_CAST(send_with_fds_op)(*this));
+        return;
+      }
+
+      // Descriptors cannot be passed without at least one byte of data.
+      if (!ec && fd_count_ > 0 && buffers_.empty())
+        ec = asio::error::invalid_argument;
+
+      while (!ec && !buffers_.empty())
+      {
+        std::size_t n = 0;
+        if (!detail::non_blocking_send_with_fds(socket_.native_handle(),
+              buffers_.prepare(
+                detail::send_with_fds_chunk_size<Protocol>()), fds_,
+              fd_count_, ec, n))
+        {
+          socket_.async_wait(socket_type::wait_write,
+              ASIO_MOVE_CAST(send_with_fds_op)(*this));
+          return;
+        }
+
+        if (!ec)
+        {
+          // The descriptors travel with the first chunk of data only.
+          fd_count_ = 0;
+          buffers_.consume(n);
+        }
+
+        // A datagram is never split across several messages.
+        if (Protocol().type() != SOCK_STREAM)
+          break;
+      }
+
+      handler_(ec, buffers_.total_consumed());
+    }
+
+  //private:
+    typedef asio::detail::consuming_buffers<const_buffer,
+        ConstBufferSequence, ConstBufferIterator> buffers_type;
+
+    socket_type& socket_;
+    buffers_type buffers_;
+    const int* fds_;
+    std::size_t fd_count_;
+    int start_;
+    WriteHandler handler_;
+  };
+
+  template <typename Protocol, typename Executor, typename ConstBufferSequence,
+      typename ConstBufferIterator, typename WriteHandler>
+  inline void* asio_handler_allocate(std::size_t size,
+      send_with_fds_op<Protocol, Executor, ConstBufferSequence,
+        ConstBufferIterator, WriteHandler>* this_handler)
+  {
+    return asio_handler_alloc_helpers::allocate(
+        size, this_handler->handler_);
+  }
+
+  template <typename Protocol, typename Executor, typename ConstBufferSequence,
+      typename ConstBufferIterator, typename WriteHandler>
+  inline void asio_handler_deallocate(void* pointer, std::size_t size,
+      send_with_fds_op<Protocol, Executor, ConstBufferSequence,
+        ConstBufferIterator, WriteHandler>* this_handler)
+  {
+    asio_handler_alloc_helpers::deallocate(
+        pointer, size, this_handler->handler_);
+  }
+
+  template <typename Protocol, typename Executor, typename ConstBufferSequence,
+      typename ConstBufferIterator, typename WriteHandler>
+  inline bool asio_handler_is_continuation(
+      send_with_fds_op<Protocol, Executor, ConstBufferSequence,
+        ConstBufferIterator, WriteHandler>* this_handler)
+  {
+    return this_handler->start_ == 0 ? true
+      : asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename Function, typename Protocol, typename Executor,
+      typename ConstBufferSequence, typename ConstBufferIterator,
+      typename WriteHandler>
+  inline void asio_handler_invoke(Function& function,
+      send_with_fds_op<Protocol, Executor, ConstBufferSequence,
+        ConstBufferIterator, WriteHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename Function, typename Protocol, typename Executor,
+      typename ConstBufferSequence, typename ConstBufferIterator,
+      typename WriteHandler>
+  inline void asio_handler_invoke(const Function& function,
+      send_with_fds_op<Protocol, Executor, ConstBufferSequence,
+        ConstBufferIterator, WriteHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename Protocol, typename Executor, typename ConstBufferSequence,
+      typename ConstBufferIterator, typename WriteHandler>
+  inline void start_send_with_fds_op(basic_socket<Protocol, Executor>& socket,
+      const ConstBufferSequence& buffers, const ConstBufferIterator&,
+      const int* fds, std::size_t fd_count, WriteHandler& handler)
+  {
+    detail::send_with_fds_op<Protocol, Executor, ConstBufferSequence,
+      ConstBufferIterator, WriteHandler>(socket, buffers, fds,
+        fd_count, handler)(asio::error_code(), 1);
+  }
+
+  template <typename Protocol, typename Executor>
+  class initiate_async_send_with_fds
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_with_fds(
+        basic_socket<Protocol, Executor>& socket)
+      : socket_(socket)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return socket_.get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
+        const ConstBufferSequence& buffers,
+        const int* fds, std::size_t fd_count) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      asio::detail::non_const_lvalue<WriteHandler> handler2(handler);
+      start_send_with_fds_op(socket_, buffers,
+          asio::buffer_sequence_begin(buffers),
+          fds, fd_count, handler2.value);
+    }
+
+  private:
+    basic_socket<Protocol, Executor>& socket_;
+  };
+
+  template <typename Protocol, typename Executor,
+      typename MutableBufferSequence, typename ReadHandler>
+  class receive_with_fds_op
+  {
+  public:
+    typedef basic_socket<Protocol, Executor> socket_type;
+
+    receive_with_fds_op(socket_type& socket,
+        const MutableBufferSequence& buffers,
+        std::vector<int>& fds, ReadHandler& handler)
+      : socket_(socket),
+        buffers_(buffers),
+        fds_(fds),
+        start_(0),
+        handler_(ASIO_MOVE_CAST(ReadHandler)(handler))
+    {
+    }
+
+#if defined(ASIO_HAS_MOVE)
+    receive_with_fds_op(const receive_with_fds_op& other)
+      : socket_(other.socket_),
+        buffers_(other.buffers_),
+        fds_(other.fds_),
+        start_(other.start_),
+        handler_(other.handler_)
+    {
+    }
+
+    receive_with_fds_op(receive_with_fds_op&& other)
+      : socket_(other.socket_),
+        buffers_(other.buffers_),
+        fds_(other.fds_),
+        start_(other.start_),
+        handler_(ASIO_MOVE_CAST(ReadHandler)(other.handler_))
+    {
+    }
+#endif // defined(ASIO_HAS_MOVE)
+
+    void operator()(asio::error_code ec, int start = 0)
+    {
+      if ((start_ = start) == 1)
+      {
+        // Always start with a wait so that the handler is not invoked from
+        // within the initiating function.
+        socket_.async_wait(socket_type::wait_read,
+            ASIO_MOVE_CAST(receive_with_fds_op)(*this));
+        return;
+      }
+
+      std::size_t n = 0;
+      if (!ec && !detail::non_blocking_receive_with_fds<Protocol>(
+            socket_.native_handle(), buffers_, fds_, ec, n))
+      {
+        socket_.async_wait(socket_type::wait_read,
+            ASIO_MOVE_CAST(receive_with_fds_op)(*this));
+        return;
+      }
+
+      handler_(ec, static_cast<const std::size_t&>(n));
+    }
+
+  //private:
+    socket_type& socket_;
+    MutableBufferSequence buffers_;
+    std::vector<int>& fds_;
+    int start_;
+    ReadHandler handler_;
+  };
+
+  template <typename Protocol, typename Executor,
+      typename MutableBufferSequence, typename ReadHandler>
+  inline void* asio_handler_allocate(std::size_t size,
+      receive_with_fds_op<Protocol, Executor,
+        MutableBufferSequence, ReadHandler>* this_handler)
+  {
+    return asio_handler_alloc_helpers::allocate(
+        size, this_handler->handler_);
+  }
+
+  template <typename Protocol, typename Executor,
+      typename MutableBufferSequence, typename ReadHandler>
+  inline void asio_handler_deallocate(void* pointer, std::size_t size,
+      receive_with_fds_op<Protocol, Executor,
+        MutableBufferSequence, ReadHandler>* this_handler)
+  {
+    asio_handler_alloc_helpers::deallocate(
+        pointer, size, this_handler->handler_);
+  }
+
+  template <typename Protocol, typename Executor,
+      typename MutableBufferSequence, typename ReadHandler>
+  inline bool asio_handler_is_continuation(
+      receive_with_fds_op<Protocol, Executor,
+        MutableBufferSequence, ReadHandler>* this_handler)
+  {
+    return this_handler->start_ == 0 ? true
+      : asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename Function, typename Protocol, typename Executor,
+      typename MutableBufferSequence, typename ReadHandler>
+  inline void asio_handler_invoke(Function& function,
+      receive_with_fds_op<Protocol, Executor,
+        MutableBufferSequence, ReadHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename Function, typename Protocol, typename Executor,
+      typename MutableBufferSequence, typename ReadHandler>
+  inline void asio_handler_invoke(const Function& function,
+      receive_with_fds_op<Protocol, Executor,
+        MutableBufferSequence, ReadHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename Protocol, typename Executor>
+  class initiate_async_receive_with_fds
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_with_fds(
+        basic_socket<Protocol, Executor>& socket)
+      : socket_(socket)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return socket_.get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ASIO_MOVE_ARG(ReadHandler) handler,
+        const MutableBufferSequence& buffers, std::vector<int>* fds) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      asio::detail::non_const_lvalue<ReadHandler> handler2(handler);
+      receive_with_fds_op<Protocol, Executor, MutableBufferSequence,
+        typename decay<ReadHandler>::type>(socket_, buffers, *fds,
+          handler2.value)(asio::error_code(), 1);
+    }
+
+  private:
+    basic_socket<Protocol, Executor>& socket_;
+  };
+
+} // namespace detail
+} // namespace local
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <typename Protocol, typename Executor, typename ConstBufferSequence,
+    typename ConstBufferIterator, typename WriteHandler, typename Allocator>
+struct associated_allocator<
+    local::detail::send_with_fds_op<Protocol, Executor,
+      ConstBufferSequence, ConstBufferIterator, WriteHandler>,
+    Allocator>
+{
+  typedef typename associated_allocator<WriteHandler, Allocator>::type type;
+
+  static type get(
+      const local::detail::send_with_fds_op<Protocol, Executor,
+        ConstBufferSequence, ConstBufferIterator, WriteHandler>& h,
+      const Allocator& a = Allocator()) ASIO_NOEXCEPT
+  {
+    return associated_allocator<WriteHandler, Allocator>::get(h.handler_, a);
+  }
+};
+
+template <typename Protocol, typename Executor, typename ConstBufferSequence,
+    typename ConstBufferIterator, typename WriteHandler, typename Executor1>
+struct associated_executor<
+    local::detail::send_with_fds_op<Protocol, Executor,
+      ConstBufferSequence, ConstBufferIterator, WriteHandler>,
+    Executor1>
+{
+  typedef typename associated_executor<WriteHandler, Executor1>::type type;
+
+  static type get(
+      const local::detail::send_with_fds_op<Protocol, Executor,
+        ConstBufferSequence, ConstBufferIterator, WriteHandler>& h,
+      const Executor1& ex = Executor1()) ASIO_NOEXCEPT
+  {
+    return associated_executor<WriteHandler, Executor1>::get(h.handler_, ex);
+  }
+};
+
+template <typename Protocol, typename Executor,
+    typename MutableBufferSequence, typename ReadHandler, typename Allocator>
+struct associated_allocator<
+    local::detail::receive_with_fds_op<Protocol, Executor,
+      MutableBufferSequence, ReadHandler>,
+    Allocator>
+{
+  typedef typename associated_allocator<ReadHandler, Allocator>::type type;
+
+  static type get(
+      const local::detail::receive_with_fds_op<Protocol, Executor,
+        MutableBufferSequence, ReadHandler>& h,
+      const Allocator& a = Allocator()) ASIO_NOEXCEPT
+  {
+    return associated_allocator<ReadHandler, Allocator>::get(h.handler_, a);
+  }
+};
+
+template <typename Protocol, typename Executor,
+    typename MutableBufferSequence, typename ReadHandler, typename Executor1>
+struct associated_executor<
+    local::detail::receive_with_fds_op<Protocol, Executor,
+      MutableBufferSequence, ReadHandler>,
+    Executor1>
+{
+  typedef typename associated_executor<ReadHandler, Executor1>::type type;
+
+  static type get(
+      const local::detail::receive_with_fds_op<Protocol, Executor,
+        MutableBufferSequence, ReadHandler>& h,
+      const Executor1& ex = Executor1()) ASIO_NOEXCEPT
+  {
+    return associated_executor<ReadHandler, Executor1>::get(h.handler_, ex);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+namespace local {
+
+template <typename Protocol, typename Executor, typename ConstBufferSequence>
+inline std::size_t send_with_fds(basic_socket<Protocol, Executor>& s,
+    const ConstBufferSequence& buffers, const int* fds, std::size_t fd_count)
+{
+  asio::error_code ec;
+  std::size_t bytes_transferred = send_with_fds(s, buffers, fds, fd_count, ec);
+  asio::detail::throw_error(ec, "send_with_fds");
+  return bytes_transferred;
+}
+
+namespace detail {
+
+  template <typename Protocol, typename Executor,
+      typename ConstBufferSequence, typename ConstBufferIterator>
+  std::size_t send_with_fds_buffer_sequence(
+      basic_socket<Protocol, Executor>& s,
+      const ConstBufferSequence& buffers, const ConstBufferIterator&,
+      const int* fds, std::size_t fd_count, asio::error_code& ec)
+  {
+    asio::detail::consuming_buffers<const_buffer,
+        ConstBufferSequence, ConstBufferIterator> tmp(buffers);
+
+    ec = asio::error_code();
+    if (fd_count > 0 && tmp.empty())
+      ec = asio::error::invalid_argument;
+
+    while (!ec && !tmp.empty())
+    {
+      std::size_t n = 0;
+      if (!detail::non_blocking_send_with_fds(s.native_handle(),
+            tmp.prepare(detail::send_with_fds_chunk_size<Protocol>()),
+            fds, fd_count, ec, n))
+      {
+        // Honour a user-requested non-blocking mode. Otherwise, block until
+        // the socket is writable.
+        if (s.non_blocking())
+          break;
+        ec = asio::error_code();
+        s.wait(basic_socket<Protocol, Executor>::wait_write, ec);
+        continue;
+      }
+
+      if (!ec)
+      {
+        fd_count = 0;
+        tmp.consume(n);
+      }
+
+      // A datagram is never split across several messages.
+      if (Protocol().type() != SOCK_STREAM)
+        break;
+    }
+
+    return tmp.total_consumed();
+  }
+
+} // namespace detail
+
+template <typename Protocol, typename Executor, typename ConstBufferSequence>
+inline std::size_t send_with_fds(basic_socket<Protocol, Executor>& s,
+    const ConstBufferSequence& buffers, const int* fds, std::size_t fd_count,
+    asio::error_code& ec)
+{
+  return detail::send_with_fds_buffer_sequence(s, buffers,
+      asio::buffer_sequence_begin(buffers), fds, fd_count, ec);
+}
+
+template <typename Protocol, typename Executor,
+    typename ConstBufferSequence, typename WriteHandler>
+inline ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+    void (asio::error_code, std::size_t))
+async_send_with_fds(basic_socket<Protocol, Executor>& s,
+    const ConstBufferSequence& buffers, const int* fds, std::size_t fd_count,
+    ASIO_MOVE_ARG(WriteHandler) handler)
+{
+  return async_initiate<WriteHandler,
+    void (asio::error_code, std::size_t)>(
+      detail::initiate_async_send_with_fds<Protocol, Executor>(s),
+      handler, buffers, fds, fd_count);
+}
+
+template <typename Protocol, typename Executor, typename MutableBufferSequence>
+inline std::size_t receive_with_fds(basic_socket<Protocol, Executor>& s,
+    const MutableBufferSequence& buffers, std::vector<int>& fds)
+{
+  asio::error_code ec;
+  std::size_t bytes_transferred = receive_with_fds(s, buffers, fds, ec);
+  asio::detail::throw_error(ec, "receive_with_fds");
+  return bytes_transferred;
+}
+
+template <typename Protocol, typename Executor, typename MutableBufferSequence>
+std::size_t receive_with_fds(basic_socket<Protocol, Executor>& s,
+    const MutableBufferSequence& buffers, std::vector<int>& fds,
+    asio::error_code& ec)
+{
+  for (;;)
+  {
+    std::size_t n = 0;
+    if (detail::non_blocking_receive_with_fds<Protocol>(
+          s.native_handle(), buffers, fds, ec, n))
+      return n;
+
+    // Honour a user-requested non-blocking mode. Otherwise, block until the
+    // socket is readable.
+    if (s.non_blocking())
+      return 0;
+    ec = asio::error_code();
+    s.wait(basic_socket<Protocol, Executor>::wait_read, ec);
+    if (ec)
+      return 0;
+  }
+}
+
+template <typename Protocol, typename Executor,
+    typename MutableBufferSequence, typename ReadHandler>
+inline ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+    void (asio::error_code, std::size_t))
+async_receive_with_fds(basic_socket<Protocol, Executor>& s,
+    const MutableBufferSequence& buffers, std::vector<int>& fds,
+    ASIO_MOVE_ARG(ReadHandler) handler)
+{
+  return async_initiate<ReadHandler,
+    void (asio::error_code, std::size_t)>(
+      detail::initiate_async_receive_with_fds<Protocol, Executor>(s),
+      handler, buffers, &fds);
+}
+
+} // namespace local
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_LOCAL_IMPL_FD_PASSING_HPP
@@ -0,0 +1,1099 @@
+//
+// local/shared_memory_channel.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_LOCAL_SHARED_MEMORY_CHANNEL_HPP
+#define ASIO_LOCAL_SHARED_MEMORY_CHANNEL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_SHARED_MEMORY_CHANNEL) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include <unistd.h>
+#include "asio/associated_allocator.hpp"
+#include "asio/associated_executor.hpp"
+#include "asio/async_result.hpp"
+#include "asio/buffer.hpp"
+#include "asio/error.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/executor.hpp"
+#include "asio/post.hpp"
+#include "asio/posix/basic_stream_descriptor.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_cont_helpers.hpp"
+#include "asio/detail/handler_invoke_helpers.hpp"
+#include "asio/detail/handler_type_requirements.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/local/detail/shared_ring.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace local {
+
+template <typename Executor>
+class basic_shared_memory_channel;
+
+namespace detail {
+
+  template <typename Executor, typename ConstBufferSequence,
+      typename WriteHandler>
+  class shared_memory_write_op
+  {
+  public:
+    shared_memory_write_op(basic_shared_memory_channel<Executor>& channel,
+        const ConstBufferSequence& buffers, WriteHandler& handler)
+      : channel_(channel),
+        buffers_(buffers),
+        bytes_transferred_(0),
+        start_(0),
+        handler_(ASIO_MOVE_CAST(WriteHandler)(handler))
+    {
+    }
+
+#if defined(ASIO_HAS_MOVE)
+    shared_memory_write_op(const shared_memory_write_op& other)
+      : channel_(other.channel_),
+        buffers_(other.buffers_),
+        bytes_transferred_(other.bytes_transferred_),
+        start_(other.start_),
+        handler_(other.handler_)
+    {
+    }
+
+    shared_memory_write_op(shared_memory_write_op&& other)
+      : channel_(other.channel_),
+        buffers_(ASIO_MOVE_CAST(ConstBufferSequence)(other.buffers_)),
+        bytes_transferred_(other.bytes_transferred_),
+        start_(other.start_),
+        handler_(ASIO_MOVE_CAST(WriteHandler)(other.handler_))
+    {
+    }
+#endif // defined(ASIO_HAS_MOVE)
+
+    void operator()(asio::error_code ec, int start = 0)
+    {
+      if ((start_ = start) == 1)
+        channel_.check_end(basic_shared_memory_channel<Executor>::writer, ec);
+      else if (!ec)
+        shared_ring::drain(channel_.doorbell_.native_handle());
+
+      while (!ec)
+      {
+        if (channel_.try_write(buffers_, bytes_transferred_, ec))
+          break;
+
+        if (channel_.ring_.park_writer())
+        {
+          channel_.doorbell_.async_wait(posix::descriptor_base::wait_read,
+              ASIO_MOVE_CAST(shared_memory_write_op)(*this));
+          return;
+        }
+      }
+
+      if (start_ == 1)
+      {
+        asio::post(channel_.get_executor(), asio::detail::bind_handler(
+              ASIO_MOVE_CAST(shared_memory_write_op)(*this),
+              ec, bytes_transferred_));
+        return;
+      }
+
+      handler_(ec, static_cast<const std::size_t&>(bytes_transferred_));
+    }
+
+    void operator()(const asio::error_code& ec,
+        const std::size_t& bytes_transferred)
+    {
+      handler_(ec, bytes_transferred);
+    }
+
+  //private:
+    basic_shared_memory_channel<Executor>& channel_;
+    ConstBufferSequence buffers_;
+    std::size_t bytes_transferred_;
+    int start_;
+    WriteHandler handler_;
+  };
+
+  template <typename Executor, typename MutableBufferSequence,
+      typename ReadHandler>
+  class shared_memory_read_op
+  {
+  public:
+    shared_memory_read_op(basic_shared_memory_channel<Executor>& channel,
+        const MutableBufferSequence& buffers, ReadHandler& handler)
+      : channel_(channel),
+        buffers_(buffers),
+        bytes_transferred_(0),
+        start_(0),
+        handler_(ASIO_MOVE_CAST(ReadHandler)(handler))
+    {
+    }
+
+#if defined(ASIO_HAS_MOVE)
+    shared_memory_read_op(const shared_memory_read_op& other)
+      : channel_(other.channel_),
+        buffers_(other.buffers_),
+        bytes_transferred_(other.bytes_transferred_),
+        start_(other.start_),
+        handler_(other.handler_)
+    {
+    }
+
+    shared_memory_read_op(shared_memory_read_op&& other)
+      : channel_(other.channel_),
+        buffers_(ASIO_MOVE_CAST(MutableBufferSequence)(other.buffers_)),
+        bytes_transferred_(other.bytes_transferred_),
+        start_(other.start_),
+        handler_(ASIO_MOVE_CAST(ReadHandler)(other.handler_))
+    {
+    }
+#endif // defined(ASIO_HAS_MOVE)
+
+    void operator()(asio::error_code ec, int start = 0)
+    {
+      if ((start_ = start) == 1)
+        channel_.check_end(basic_shared_memory_channel<Executor>::reader, ec);
+      else if (!ec)
+        shared_ring::drain(channel_.doorbell_.native_handle());
+
+      while (!ec)
+      {
+        if (channel_.try_read(buffers_, bytes_transferred_, ec))
+          break;
+
+        if (channel_.ring_.park_reader())
+        {
+          channel_.doorbell_.async_wait(posix::descriptor_base::wait_read,
+              ASIO_MOVE_CAST(shared_memory_read_op)(*this));
+          return;
+        }
+      }
+
+      if (start_ == 1)
+      {
+        asio::post(channel_.get_executor(), asio::detail::bind_handler(
+              ASIO_MOVE_CAST(shared_memory_read_op)(*this),
+              ec, bytes_transferred_));
+        return;
+      }
+
+      handler_(ec, static_cast<const std::size_t&>(bytes_transferred_));
+    }
+
+    void operator()(const asio::error_code& ec,
+        const std::size_t& bytes_transferred)
+    {
+      handler_(ec, bytes_transferred);
+    }
+
+  //private:
+    basic_shared_memory_channel<Executor>& channel_;
+    MutableBufferSequence buffers_;
+    std::size_t bytes_transferred_;
+    int start_;
+    ReadHandler handler_;
+  };
+
+  template <typename Executor, typename ConstBufferSequence,
+      typename WriteHandler>
+  inline void* asio_handler_allocate(std::size_t size,
+      shared_memory_write_op<Executor,
+        ConstBufferSequence, WriteHandler>* this_handler)
+  {
+    return asio_handler_alloc_helpers::allocate(
+        size, this_handler->handler_);
+  }
+
+  template <typename Executor, typename ConstBufferSequence,
+      typename WriteHandler>
+  inline void asio_handler_deallocate(void* pointer, std::size_t size,
+      shared_memory_write_op<Executor,
+        ConstBufferSequence, WriteHandler>* this_handler)
+  {
+    asio_handler_alloc_helpers::deallocate(
+        pointer, size, this_handler->handler_);
+  }
+
+  template <typename Executor, typename ConstBufferSequence,
+      typename WriteHandler>
+  inline bool asio_handler_is_continuation(
+      shared_memory_write_op<Executor,
+        ConstBufferSequence, WriteHandler>* this_handler)
+  {
+    return this_handler->start_ == 0 ? true
+      : asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename Function, typename Executor,
+      typename ConstBufferSequence, typename WriteHandler>
+  inline void asio_handler_invoke(Function& function,
+      shared_memory_write_op<Executor,
+        ConstBufferSequence, WriteHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename Function, typename Executor,
+      typename ConstBufferSequence, typename WriteHandler>
+  inline void asio_handler_invoke(const Function& function,
+      shared_memory_write_op<Executor,
+        ConstBufferSequence, WriteHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename Executor, typename MutableBufferSequence,
+      typename ReadHandler>
+  inline void* asio_handler_allocate(std::size_t size,
+      shared_memory_read_op<Executor,
+        MutableBufferSequence, ReadHandler>* this_handler)
+  {
+    return asio_handler_alloc_helpers::allocate(
+        size, this_handler->handler_);
+  }
+
+  template <typename Executor, typename MutableBufferSequence,
+      typename ReadHandler>
+  inline void asio_handler_deallocate(void* pointer, std::size_t size,
+      shared_memory_read_op<Executor,
+        MutableBufferSequence, ReadHandler>* this_handler)
+  {
+    asio_handler_alloc_helpers::deallocate(
+        pointer, size, this_handler->handler_);
+  }
+
+  template <typename Executor, typename MutableBufferSequence,
+      typename ReadHandler>
+  inline bool asio_handler_is_continuation(
+      shared_memory_read_op<Executor,
+        MutableBufferSequence, ReadHandler>* this_handler)
+  {
+    return this_handler->start_ == 0 ? true
+      : asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename Function, typename Executor,
+      typename MutableBufferSequence, typename ReadHandler>
+  inline void asio_handler_invoke(Function& function,
+      shared_memory_read_op<Executor,
+        MutableBufferSequence, ReadHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename Function, typename Executor,
+      typename MutableBufferSequence, typename ReadHandler>
+  inline void asio_handler_invoke(const Function& function,
+      shared_memory_read_op<Executor,
+        MutableBufferSequence, ReadHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+} // namespace detail
+
+/// The shared_memory_channel_base class is used as a base for the
+/// basic_shared_memory_channel class template so that we have a common place
+/// to define the end and native handle types.
+class shared_memory_channel_base
+{
+public:
+  /// The end of the channel that an object refers to.
+  enum end_type
+  {
+    /// The end that writes messages.
+    writer,
+
+    /// The end that reads messages.
+    reader
+  };
+
+  /// The native representation of one end of a channel.
+  /**
+   * One end of a channel is made up of three descriptors. These may be passed
+   * to another process, for example using local::send_with_fds(), and adopted
+   * there using basic_shared_memory_channel::assign().
+   */
+  struct native_handle_type
+  {
+    /// The shared memory region that holds the messages.
+    int memory;
+
+    /// The doorbell on which this end waits for the peer.
+    int wait;
+
+    /// The doorbell used to wake the peer.
+    int notify;
+  };
+
+protected:
+  /// Protected destructor to prevent deletion through this type.
+  ~shared_memory_channel_base()
+  {
+  }
+};
+
+/// Provides a message channel between processes over shared memory.
+/**
+ * The basic_shared_memory_channel class template provides one end of a
+ * one-way message channel between two processes on the same host. Messages
+ * are copied into a single-producer, single-consumer ring buffer in a shared
+ * memory region, so that sending or receiving a message does not require a
+ * system call.
+ *
+ * A reader that finds the ring empty, or a writer that finds it full, parks
+ * itself and waits on a doorbell descriptor through the reactor. The peer
+ * rings the doorbell (an eventfd where available, otherwise a socket pair)
+ * only if it sees that the other end has parked.
+ *
+ * Message boundaries are preserved. A message that is larger than the buffers
+ * given to a read operation is truncated, and the operation fails with
+ * asio::error::message_size.
+ *
+ * A channel is created with local::create_shared_memory_channel(). If a
+ * process exits without closing its end, the peer is not woken.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * At most one read operation may be outstanding on the reading end, and at
+ * most one write operation on the writing end.
+ *
+ * @par Example
+ * @code asio::local::shared_memory_channel writer(io_context);
+ * asio::local::shared_memory_channel reader(io_context);
+ * asio::local::create_shared_memory_channel(writer, reader, 1 << 20);
+ * if (fork() == 0)
+ * {
+ *   io_context.notify_fork(asio::io_context::fork_child);
+ *   writer.close();
+ *   ...
+ *   reader.async_read(asio::buffer(data), handler);
+ * }
+ * else
+ * {
+ *   io_context.notify_fork(asio::io_context::fork_parent);
+ *   reader.close();
+ *   ...
+ *   writer.async_write(asio::buffer(message), handler);
+ * } @endcode
+ */
+template <typename Executor = executor>
+class basic_shared_memory_channel
+  : public shared_memory_channel_base,
+    private asio::detail::noncopyable
+{
+public:
+  /// The type of the executor associated with the object.
+  typedef Executor executor_type;
+
+  /// Construct a channel end without opening it.
+  /**
+   * @param ex The I/O executor that the channel will use, by default, to
+   * dispatch handlers for any asynchronous operations performed on the
+   * channel.
+   */
+  explicit basic_shared_memory_channel(const executor_type& ex)
+    : doorbell_(ex),
+      end_(writer),
+      memory_fd_(-1),
+      notify_fd_(-1)
+  {
+  }
+
+  /// Construct a channel end without opening it.
+  /**
+   * @param context An execution context which provides the I/O executor that
+   * the channel will use, by default, to dispatch handlers for any
+   * asynchronous operations performed on the channel.
+   */
+  template <typename ExecutionContext>
+  explicit basic_shared_memory_channel(ExecutionContext& context,
+      typename enable_if<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      >::type* = 0)
+    : doorbell_(context),
+      end_(writer),
+      memory_fd_(-1),
+      notify_fd_(-1)
+  {
+  }
+
+  /// Destructor.
+  /**
+   * Closes the channel end, waking the peer.
+   */
+  ~basic_shared_memory_channel()
+  {
+    asio::error_code ignored_ec;
+    close(ignored_ec);
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() ASIO_NOEXCEPT
+  {
+    return doorbell_.get_executor();
+  }
+
+  /// Adopt one end of an existing channel.
+  /**
+   * This function maps the shared memory region and takes ownership of the
+   * descriptors.
+   *
+   * @param end Whether the descriptors are for the writing or reading end.
+   *
+   * @param handles The descriptors that make up the end of the channel.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void assign(end_type end, const native_handle_type& handles)
+  {
+    asio::error_code ec;
+    assign(end, handles, ec);
+    asio::detail::throw_error(ec, "assign");
+  }
+
+  /// Adopt one end of an existing channel.
+  /**
+   * This function maps the shared memory region and takes ownership of the
+   * descriptors.
+   *
+   * @param end Whether the descriptors are for the writing or reading end.
+   *
+   * @param handles The descriptors that make up the end of the channel.
+   *
+   * @param ec Set to indicate what error occurred, if any. On failure the
+   * descriptors are not adopted.
+   */
+  ASIO_SYNC_OP_VOID assign(end_type end,
+      const native_handle_type& handles, asio::error_code& ec)
+  {
+    if (is_open())
+    {
+      ec = asio::error::already_open;
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    if (detail::shared_ring::prepare_doorbell(handles.wait, ec)
+        || detail::shared_ring::prepare_doorbell(handles.notify, ec)
+        || ring_.map(handles.memory, ec))
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+
+    doorbell_.assign(handles.wait, ec);
+    if (ec)
+    {
+      ring_.unmap();
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    end_ = end;
+    memory_fd_ = handles.memory;
+    notify_fd_ = handles.notify;
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Determine whether the channel end is open.
+  bool is_open() const
+  {
+    return ring_.is_mapped();
+  }
+
+  /// Get which end of the channel the object refers to.
+  end_type end() const
+  {
+    return end_;
+  }
+
+  /// Get the native representation of the channel end.
+  native_handle_type native_handle()
+  {
+    native_handle_type handles = { memory_fd_,
+      doorbell_.native_handle(), notify_fd_ };
+    return handles;
+  }
+
+  /// Get the largest message that the channel can carry.
+  std::size_t max_message_size() const
+  {
+    return ring_.max_message_size();
+  }
+
+  /// Close the channel end.
+  /**
+   * This function closes the channel end and wakes the peer. Any
+   * asynchronous operations will be cancelled immediately, and will complete
+   * with the asio::error::operation_aborted error. A reader sees
+   * asio::error::eof after consuming the messages written before the writer
+   * closed. A writer sees asio::error::broken_pipe once the reader has
+   * closed.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void close()
+  {
+    asio::error_code ec;
+    close(ec);
+    asio::detail::throw_error(ec, "close");
+  }
+
+  /// Close the channel end.
+  /**
+   * This function closes the channel end and wakes the peer. Any
+   * asynchronous operations will be cancelled immediately, and will complete
+   * with the asio::error::operation_aborted error.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_SYNC_OP_VOID close(asio::error_code& ec)
+  {
+    if (is_open())
+    {
+      if (end_ == writer)
+        ring_.close_writer(notify_fd_);
+      else
+        ring_.close_reader(notify_fd_);
+      ring_.unmap();
+      ::close(memory_fd_);
+      ::close(notify_fd_);
+      memory_fd_ = -1;
+      notify_fd_ = -1;
+    }
+    doorbell_.close(ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Release ownership of the channel end.
+  /**
+   * This function causes all outstanding asynchronous operations to finish
+   * immediately, and the handlers for cancelled operations will be passed the
+   * asio::error::operation_aborted error. Ownership of the descriptors is
+   * transferred to the caller, and the peer is not woken.
+   */
+  native_handle_type release()
+  {
+    native_handle_type handles = native_handle();
+    ring_.unmap();
+    doorbell_.release();
+    memory_fd_ = -1;
+    notify_fd_ = -1;
+    return handles;
+  }
+
+  /// Cancel all asynchronous operations associated with the channel end.
+  /**
+   * This function causes all outstanding asynchronous operations to finish
+   * immediately, and the handlers for cancelled operations will be passed the
+   * asio::error::operation_aborted error.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void cancel()
+  {
+    asio::error_code ec;
+    cancel(ec);
+    asio::detail::throw_error(ec, "cancel");
+  }
+
+  /// Cancel all asynchronous operations associated with the channel end.
+  /**
+   * This function causes all outstanding asynchronous operations to finish
+   * immediately, and the handlers for cancelled operations will be passed the
+   * asio::error::operation_aborted error.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_SYNC_OP_VOID cancel(asio::error_code& ec)
+  {
+    doorbell_.cancel(ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Write a message to the channel.
+  /**
+   * This function is used to write one message, gathered from the given
+   * buffers. The call will block until there is space for the whole message
+   * or an error occurs.
+   *
+   * @param buffers The data that makes up the message.
+   *
+   * @returns The number of bytes written.
+   *
+   * @throws asio::system_error Thrown on failure. An error code of
+   * asio::error::message_size indicates that the message is larger than
+   * max_message_size().
+   */
+  template <typename ConstBufferSequence>
+  std::size_t write(const ConstBufferSequence& buffers)
+  {
+    asio::error_code ec;
+    std::size_t n = write(buffers, ec);
+    asio::detail::throw_error(ec, "write");
+    return n;
+  }
+
+  /// Write a message to the channel.
+  /**
+   * This function is used to write one message, gathered from the given
+   * buffers. The call will block until there is space for the whole message
+   * or an error occurs.
+   *
+   * @param buffers The data that makes up the message.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of bytes written.
+   */
+  template <typename ConstBufferSequence>
+  std::size_t write(const ConstBufferSequence& buffers,
+      asio::error_code& ec)
+  {
+    std::size_t bytes_transferred = 0;
+    check_end(writer, ec);
+    while (!ec && !try_write(buffers, bytes_transferred, ec))
+      if (ring_.park_writer())
+        wait_for_peer(ec);
+    return bytes_transferred;
+  }
+
+  /// Start an asynchronous operation to write a message to the channel.
+  /**
+   * This function is used to asynchronously write one message, gathered from
+   * the given buffers. The function call always returns immediately.
+   *
+   * @param buffers The data that makes up the message. Although the buffers
+   * object may be copied as necessary, ownership of the underlying memory
+   * blocks is retained by the caller, which must guarantee that they remain
+   * valid until the handler is called.
+   *
+   * @param handler The handler to be called when the write operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes written.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_write(const ConstBufferSequence& buffers,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_write(this), handler, buffers);
+  }
+
+  /// Read a message from the channel.
+  /**
+   * This function is used to read one message into the given buffers. The
+   * call will block until a message is available or an error occurs.
+   *
+   * @param buffers The buffers into which the message will be read.
+   *
+   * @returns The number of bytes read.
+   *
+   * @throws asio::system_error Thrown on failure. An error code of
+   * asio::error::eof indicates that the writer has closed the channel. An
+   * error code of asio::error::message_size indicates that the message was
+   * truncated.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t read(const MutableBufferSequence& buffers)
+  {
+    asio::error_code ec;
+    std::size_t n = read(buffers, ec);
+    asio::detail::throw_error(ec, "read");
+    return n;
+  }
+
+  /// Read a message from the channel.
+  /**
+   * This function is used to read one message into the given buffers. The
+   * call will block until a message is available or an error occurs.
+   *
+   * @param buffers The buffers into which the message will be read.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of bytes read.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t read(const MutableBufferSequence& buffers,
+      asio::error_code& ec)
+  {
+    std::size_t bytes_transferred = 0;
+    check_end(reader, ec);
+    while (!ec && !try_read(buffers, bytes_transferred, ec))
+      if (ring_.park_reader())
+        wait_for_peer(ec);
+    return bytes_transferred;
+  }
+
+  /// Start an asynchronous operation to read a message from the channel.
+  /**
+   * This function is used to asynchronously read one message into the given
+   * buffers. The function call always returns immediately.
+   *
+   * @param buffers The buffers into which the message will be read. Although
+   * the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the handler is called.
+   *
+   * @param handler The handler to be called when the read operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes read.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_read(const MutableBufferSequence& buffers,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_read(this), handler, buffers);
+  }
+
+private:
+  template <typename, typename, typename>
+  friend class detail::shared_memory_write_op;
+
+  template <typename, typename, typename>
+  friend class detail::shared_memory_read_op;
+
+  // Check that the channel end is open and is the expected end.
+  void check_end(end_type end, asio::error_code& ec) const
+  {
+    if (!is_open())
+      ec = asio::error::bad_descriptor;
+    else if (end_ != end)
+      ec = asio::error::operation_not_supported;
+    else
+      ec = asio::error_code();
+  }
+
+  // Attempt to write a message without blocking.
+  template <typename ConstBufferSequence>
+  bool try_write(const ConstBufferSequence& buffers,
+      std::size_t& bytes_transferred, asio::error_code& ec)
+  {
+    asio::detail::buffer_sequence_adapter<const_buffer,
+        ConstBufferSequence> bufs(buffers);
+    if (!ring_.try_write(bufs.buffers(), bufs.count(),
+          bufs.total_size(), notify_fd_, ec))
+      return false;
+    bytes_transferred = ec ? 0 : bufs.total_size();
+    return true;
+  }
+
+  // Attempt to read a message without blocking.
+  template <typename MutableBufferSequence>
+  bool try_read(const MutableBufferSequence& buffers,
+      std::size_t& bytes_transferred, asio::error_code& ec)
+  {
+    asio::detail::buffer_sequence_adapter<mutable_buffer,
+        MutableBufferSequence> bufs(buffers);
+    return ring_.try_read(bufs.buffers(), bufs.count(),
+        notify_fd_, bytes_transferred, ec);
+  }
+
+  // Block until the peer rings the doorbell.
+  void wait_for_peer(asio::error_code& ec)
+  {
+    doorbell_.wait(posix::descriptor_base::wait_read, ec);
+    if (!ec)
+      detail::shared_ring::drain(doorbell_.native_handle());
+  }
+
+  class initiate_async_write
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_write(basic_shared_memory_channel* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
+        const ConstBufferSequence& buffers) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      asio::detail::non_const_lvalue<WriteHandler> handler2(handler);
+      detail::shared_memory_write_op<Executor, ConstBufferSequence,
+        typename decay<WriteHandler>::type>(*self_, buffers,
+          handler2.value)(asio::error_code(), 1);
+    }
+
+  private:
+    basic_shared_memory_channel* self_;
+  };
+
+  class initiate_async_read
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_read(basic_shared_memory_channel* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ASIO_MOVE_ARG(ReadHandler) handler,
+        const MutableBufferSequence& buffers) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      asio::detail::non_const_lvalue<ReadHandler> handler2(handler);
+      detail::shared_memory_read_op<Executor, MutableBufferSequence,
+        typename decay<ReadHandler>::type>(*self_, buffers,
+          handler2.value)(asio::error_code(), 1);
+    }
+
+  private:
+    basic_shared_memory_channel* self_;
+  };
+
+  posix::basic_stream_descriptor<Executor> doorbell_;
+  detail::shared_ring ring_;
+  end_type end_;
+  int memory_fd_;
+  int notify_fd_;
+};
+
+/// Typedef for the typical usage of a shared memory channel.
+typedef basic_shared_memory_channel<> shared_memory_channel;
+
+/// Create a shared memory channel.
+/**
+ * This function creates a new shared memory region and a pair of doorbells,
+ * and opens the two ends of a channel over them.
+ *
+ * @param writer The object to be opened as the writing end of the channel.
+ *
+ * @param reader The object to be opened as the reading end of the channel.
+ *
+ * @param capacity The minimum size of the ring buffer, in bytes. The size is
+ * rounded up to a power of two.
+ *
+ * @throws asio::system_error Thrown on failure.
+ */
+template <typename Executor>
+inline void create_shared_memory_channel(
+    basic_shared_memory_channel<Executor>& writer,
+    basic_shared_memory_channel<Executor>& reader,
+    std::size_t capacity)
+{
+  asio::error_code ec;
+  create_shared_memory_channel(writer, reader, capacity, ec);
+  asio::detail::throw_error(ec, "create_shared_memory_channel");
+}
+
+/// Create a shared memory channel.
+/**
+ * This function creates a new shared memory region and a pair of doorbells,
+ * and opens the two ends of a channel over them.
+ *
+ * @param writer The object to be opened as the writing end of the channel.
+ *
+ * @param reader The object to be opened as the reading end of the channel.
+ *
+ * @param capacity The minimum size of the ring buffer, in bytes. The size is
+ * rounded up to a power of two.
+ *
+ * @param ec Set to indicate what error occurred, if any.
+ */
+template <typename Executor>
+ASIO_SYNC_OP_VOID create_shared_memory_channel(
+    basic_shared_memory_channel<Executor>& writer,
+    basic_shared_memory_channel<Executor>& reader,
+    std::size_t capacity, asio::error_code& ec)
+{
+  typedef shared_memory_channel_base::native_handle_type handles_type;
+  handles_type w = { -1, -1, -1 };
+  handles_type r = { -1, -1, -1 };
+
+  // The writer waits for space and rings for data. The reader waits for data
+  // and rings for space.
+  w.memory = detail::shared_ring::create(capacity, ec);
+  if (!ec && (r.memory = ::dup(w.memory)) == -1)
+    asio::detail::descriptor_ops::error_wrapper(-1, ec);
+  if (!ec)
+    detail::shared_ring::create_doorbell(r.wait, w.notify, ec);
+  if (!ec)
+    detail::shared_ring::create_doorbell(w.wait, r.notify, ec);
+  if (!ec)
+    writer.assign(shared_memory_channel_base::writer, w, ec);
+  if (!ec)
+  {
+    w.memory = w.wait = w.notify = -1;
+    reader.assign(shared_memory_channel_base::reader, r, ec);
+    if (ec)
+    {
+      asio::error_code ignored_ec;
+      writer.close(ignored_ec);
+    }
+  }
+
+  if (ec)
+  {
+    const int fds[] = { w.memory, w.wait, w.notify,
+      r.memory, r.wait, r.notify };
+    for (std::size_t i = 0; i < sizeof(fds) / sizeof(fds[0]); ++i)
+      if (fds[i] != -1)
+        ::close(fds[i]);
+  }
+
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
+} // namespace local
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <typename Executor, typename ConstBufferSequence,
+    typename WriteHandler, typename Allocator>
+struct associated_allocator<
+    local::detail::shared_memory_write_op<Executor,
+      ConstBufferSequence, WriteHandler>,
+    Allocator>
+{
+  typedef typename associated_allocator<WriteHandler, Allocator>::type type;
+
+  static type get(
+      const local::detail::shared_memory_write_op<Executor,
+        ConstBufferSequence, WriteHandler>& h,
+      const Allocator& a = Allocator()) ASIO_NOEXCEPT
+  {
+    return associated_allocator<WriteHandler, Allocator>::get(h.handler_, a);
+  }
+};
+
+template <typename Executor, typename ConstBufferSequence,
+    typename WriteHandler, typename Executor1>
+struct associated_executor<
+    local::detail::shared_memory_write_op<Executor,
+      ConstBufferSequence, WriteHandler>,
+    Executor1>
+{
+  typedef typename associated_executor<WriteHandler, Executor1>::type type;
+
+  static type get(
+      const local::detail::shared_memory_write_op<Executor,
+        ConstBufferSequence, WriteHandler>& h,
+      const Executor1& ex = Executor1()) ASIO_NOEXCEPT
+  {
+    return associated_executor<WriteHandler, Executor1>::get(h.handler_, ex);
+  }
+};
+
+template <typename Executor, typename MutableBufferSequence,
+    typename ReadHandler, typename Allocator>
+struct associated_allocator<
+    local::detail::shared_memory_read_op<Executor,
+      MutableBufferSequence, ReadHandler>,
+    Allocator>
+{
+  typedef typename associated_allocator<ReadHandler, Allocator>::type type;
+
+  static type get(
+      const local::detail::shared_memory_read_op<Executor,
+        MutableBufferSequence, ReadHandler>& h,
+      const Allocator& a = Allocator()) ASIO_NOEXCEPT
+  {
+    return associated_allocator<ReadHandler, Allocator>::get(h.handler_, a);
+  }
+};
+
+template <typename Executor, typename MutableBufferSequence,
+    typename ReadHandler, typename Executor1>
+struct associated_executor<
+    local::detail::shared_memory_read_op<Executor,
+      MutableBufferSequence, ReadHandler>,
+    Executor1>
+{
+  typedef typename associated_executor<ReadHandler, Executor1>::type type;
+
+  static type get(
+      const local::detail::shared_memory_read_op<Executor,
+        MutableBufferSequence, ReadHandler>& h,
+      const Executor1& ex = Executor1()) ASIO_NOEXCEPT
+  {
+    return associated_executor<ReadHandler, Executor1>::get(h.handler_, ex);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_SHARED_MEMORY_CHANNEL)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_LOCAL_SHARED_MEMORY_CHANNEL_HPP
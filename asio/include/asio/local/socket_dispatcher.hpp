@@ -0,0 +1,475 @@
+//
+// local/socket_dispatcher.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_LOCAL_SOCKET_DISPATCHER_HPP
+#define ASIO_LOCAL_SOCKET_DISPATCHER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if (defined(ASIO_HAS_LOCAL_SOCKETS) && defined(ASIO_HAS_MOVE)) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "asio/associated_allocator.hpp"
+#include "asio/associated_executor.hpp"
+#include "asio/async_result.hpp"
+#include "asio/basic_stream_socket.hpp"
+#include "asio/buffer.hpp"
+#include "asio/error.hpp"
+#include "asio/executor.hpp"
+#include "asio/post.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_cont_helpers.hpp"
+#include "asio/detail/handler_invoke_helpers.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/local/fd_passing.hpp"
+#include "asio/local/stream_protocol.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace local {
+
+template <typename Executor>
+class basic_socket_dispatcher;
+
+namespace detail {
+
+  template <typename Executor, typename Socket, typename DispatchHandler>
+  class dispatch_op
+  {
+  public:
+    dispatch_op(basic_socket_dispatcher<Executor>& dispatcher,
+        Socket& socket, DispatchHandler& handler)
+      : dispatcher_(dispatcher),
+        socket_(ASIO_MOVE_CAST(Socket)(socket)),
+        worker_(no_worker),
+        start_(0),
+        handler_(ASIO_MOVE_CAST(DispatchHandler)(handler))
+    {
+    }
+
+    dispatch_op(dispatch_op&& other)
+      : dispatcher_(other.dispatcher_),
+        socket_(ASIO_MOVE_CAST(Socket)(other.socket_)),
+        worker_(other.worker_),
+        start_(other.start_),
+        handler_(ASIO_MOVE_CAST(DispatchHandler)(other.handler_))
+    {
+    }
+
+    void operator()(asio::error_code ec, int start = 0)
+    {
+      if ((start_ = start) == 1)
+      {
+        if (!dispatcher_.select_worker(worker_))
+        {
+          asio::post(socket_.get_executor(), asio::detail::bind_handler(
+                ASIO_MOVE_CAST(dispatch_op)(*this),
+                asio::error_code(asio::error::not_connected)));
+          return;
+        }
+
+        // Always start with a wait so that the handler is not invoked from
+        // within the initiating function.
+        dispatcher_.channel(worker_).async_wait(
+            socket_base::wait_write, ASIO_MOVE_CAST(dispatch_op)(*this));
+        return;
+      }
+
+      while (worker_ != no_worker)
+      {
+        if (!ec)
+        {
+          // A single byte carries the descriptor, so the message is never
+          // split and concurrent dispatches to one worker do not interleave.
+          int fd = socket_.native_handle();
+          std::size_t n = 0;
+          if (!detail::non_blocking_send_with_fds(
+                dispatcher_.channel(worker_).native_handle(),
+                asio::buffer("", 1), &fd, 1, ec, n))
+          {
+            dispatcher_.channel(worker_).async_wait(
+                socket_base::wait_write, ASIO_MOVE_CAST(dispatch_op)(*this));
+            return;
+          }
+        }
+
+        dispatcher_.release_worker(worker_, ec);
+        if (!ec)
+        {
+          // The worker now owns a duplicate of the descriptor.
+          asio::error_code ignored_ec;
+          socket_.close(ignored_ec);
+          break;
+        }
+
+        // Try the remaining workers, unless the operation was cancelled.
+        if (ec == asio::error::operation_aborted
+            || !dispatcher_.select_worker(worker_))
+          break;
+
+        ec = asio::error_code();
+      }
+
+      handler_(ec, static_cast<const std::size_t&>(worker_));
+    }
+
+  //private:
+    static const std::size_t no_worker = static_cast<std::size_t>(-1);
+
+    basic_socket_dispatcher<Executor>& dispatcher_;
+    Socket socket_;
+    std::size_t worker_;
+    int start_;
+    DispatchHandler handler_;
+  };
+
+  template <typename Executor, typename Socket, typename DispatchHandler>
+  inline void* asio_handler_allocate(std::size_t size,
+      dispatch_op<Executor, Socket, DispatchHandler>* this_handler)
+  {
+    return asio_handler_alloc_helpers::allocate(
+        size, this_handler->handler_);
+  }
+
+  template <typename Executor, typename Socket, typename DispatchHandler>
+  inline void asio_handler_deallocate(void* pointer, std::size_t size,
+      dispatch_op<Executor, Socket, DispatchHandler>* this_handler)
+  {
+    asio_handler_alloc_helpers::deallocate(
+        pointer, size, this_handler->handler_);
+  }
+
+  template <typename Executor, typename Socket, typename DispatchHandler>
+  inline bool asio_handler_is_continuation(
+      dispatch_op<Executor, Socket, DispatchHandler>* this_handler)
+  {
+    return this_handler->start_ == 0 ? true
+      : asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename Function, typename Executor,
+      typename Socket, typename DispatchHandler>
+  inline void asio_handler_invoke(Function& function,
+      dispatch_op<Executor, Socket, DispatchHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename Function, typename Executor,
+      typename Socket, typename DispatchHandler>
+  inline void asio_handler_invoke(const Function& function,
+      dispatch_op<Executor, Socket, DispatchHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+} // namespace detail
+
+/// Distributes connected sockets across worker processes.
+/**
+ * The basic_socket_dispatcher class template holds a set of UNIX domain
+ * stream sockets, each connected to a worker process. Each call to
+ * async_dispatch() passes a connected socket's descriptor to one of the
+ * workers using an @c SCM_RIGHTS message, and then closes the local copy.
+ *
+ * A worker is chosen by the number of dispatches that are still in progress
+ * to it, so that a worker that is slow to drain its channel receives fewer
+ * connections. Ties are broken in round-robin order. A worker whose channel
+ * fails is taken out of rotation and the dispatch is retried on another.
+ *
+ * Each dispatch is a one-byte message carrying one descriptor. The worker
+ * receives it using local::async_receive_with_fds() and adopts it with
+ * @c assign().
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * In the acceptor process:
+ * @code asio::local::socket_dispatcher dispatcher;
+ * for (int i = 0; i < num_workers; ++i)
+ *   dispatcher.add_worker(std::move(worker_channels[i]));
+ * ...
+ * acceptor.async_accept(
+ *     [&](asio::error_code ec, asio::ip::tcp::socket s)
+ *     {
+ *       if (!ec)
+ *         dispatcher.async_dispatch(std::move(s),
+ *             [](asio::error_code ec, std::size_t worker) { ... });
+ *     }); @endcode
+ * In each worker process:
+ * @code char byte;
+ * std::vector<int> fds;
+ * asio::local::async_receive_with_fds(channel, asio::buffer(&byte, 1), fds,
+ *     [&](asio::error_code ec, std::size_t)
+ *     {
+ *       for (std::size_t i = 0; i < fds.size(); ++i)
+ *       {
+ *         asio::ip::tcp::socket s(io_context);
+ *         s.assign(asio::ip::tcp::v4(), fds[i]);
+ *         ...
+ *       }
+ *     }); @endcode
+ */
+template <typename Executor = executor>
+class basic_socket_dispatcher
+  : private asio::detail::noncopyable
+{
+public:
+  /// The type of the executor associated with the worker channels.
+  typedef Executor executor_type;
+
+  /// The type of a channel to a worker process.
+  typedef basic_stream_socket<stream_protocol, Executor> channel_type;
+
+  /// Construct a dispatcher with no workers.
+  basic_socket_dispatcher()
+    : next_(0)
+  {
+  }
+
+  /// Destructor.
+  /**
+   * Closes all worker channels. The dispatcher must not be destroyed while
+   * any dispatch operations are outstanding.
+   */
+  ~basic_socket_dispatcher()
+  {
+    for (std::size_t i = 0; i < workers_.size(); ++i)
+      delete workers_[i];
+  }
+
+  /// Add a channel to a worker process.
+  /**
+   * @param channel A connected UNIX domain stream socket. Ownership of the
+   * socket is transferred to the dispatcher.
+   *
+   * @returns The index of the new worker.
+   */
+  std::size_t add_worker(channel_type&& channel)
+  {
+    workers_.reserve(workers_.size() + 1);
+    workers_.push_back(new worker(std::move(channel)));
+    return workers_.size() - 1;
+  }
+
+  /// Get the number of workers that have been added.
+  std::size_t worker_count() const
+  {
+    return workers_.size();
+  }
+
+  /// Get the channel to a worker.
+  channel_type& channel(std::size_t index)
+  {
+    return workers_[index]->channel_;
+  }
+
+  /// Determine whether a worker is still in rotation.
+  bool is_available(std::size_t index) const
+  {
+    return workers_[index]->available_;
+  }
+
+  /// Get the number of dispatches to a worker that are in progress.
+  std::size_t pending(std::size_t index) const
+  {
+    return workers_[index]->pending_;
+  }
+
+  /// Start an asynchronous operation to pass a connected socket to a worker.
+  /**
+   * This function is used to asynchronously hand a socket over to one of the
+   * worker processes. The function call always returns immediately.
+   *
+   * @param socket The socket to be dispatched. Ownership of the socket is
+   * transferred to the operation. When the operation succeeds, the socket is
+   * closed in this process.
+   *
+   * @param handler The handler to be called when the operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t worker                      // The index of the worker that
+   *                                           // received the socket.
+   * ); @endcode
+   * The error asio::error::not_connected indicates that there are no
+   * available workers. Regardless of whether the asynchronous operation
+   * completes immediately or not, the handler will not be invoked from within
+   * this function. On immediate completion, invocation of the handler will be
+   * performed in a manner equivalent to using asio::post().
+   */
+  template <typename Protocol, typename SocketExecutor,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) DispatchHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(SocketExecutor)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(DispatchHandler,
+      void (asio::error_code, std::size_t))
+  async_dispatch(basic_stream_socket<Protocol, SocketExecutor>&& socket,
+      ASIO_MOVE_ARG(DispatchHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(SocketExecutor))
+  {
+    return async_initiate<DispatchHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_dispatch<Protocol, SocketExecutor>(this, socket),
+        handler);
+  }
+
+private:
+  template <typename, typename, typename>
+  friend class detail::dispatch_op;
+
+  struct worker
+  {
+    explicit worker(channel_type&& channel)
+      : channel_(std::move(channel)),
+        pending_(0),
+        available_(true)
+    {
+    }
+
+    channel_type channel_;
+    std::size_t pending_;
+    bool available_;
+  };
+
+  // Choose the available worker with the fewest dispatches in progress.
+  bool select_worker(std::size_t& index)
+  {
+    std::size_t best = workers_.size();
+    for (std::size_t i = 0; i < workers_.size(); ++i)
+    {
+      std::size_t candidate = (next_ + i) % workers_.size();
+      if (workers_[candidate]->available_ && (best == workers_.size()
+            || workers_[candidate]->pending_ < workers_[best]->pending_))
+        best = candidate;
+    }
+
+    if (best == workers_.size())
+      return false;
+
+    next_ = best + 1;
+    ++workers_[best]->pending_;
+    index = best;
+    return true;
+  }
+
+  // Finish a dispatch to a worker, removing the worker from rotation if its
+  // channel has failed.
+  void release_worker(std::size_t index, const asio::error_code& ec)
+  {
+    --workers_[index]->pending_;
+    if (ec && ec != asio::error::operation_aborted)
+      workers_[index]->available_ = false;
+  }
+
+  template <typename Protocol, typename SocketExecutor>
+  class initiate_async_dispatch
+  {
+  public:
+    typedef SocketExecutor executor_type;
+    typedef basic_stream_socket<Protocol, SocketExecutor> socket_type;
+
+    initiate_async_dispatch(basic_socket_dispatcher* self,
+        socket_type& socket)
+      : self_(self),
+        socket_(socket)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return socket_.get_executor();
+    }
+
+    template <typename DispatchHandler>
+    void operator()(ASIO_MOVE_ARG(DispatchHandler) handler) const
+    {
+      asio::detail::non_const_lvalue<DispatchHandler> handler2(handler);
+      detail::dispatch_op<Executor, socket_type,
+        typename decay<DispatchHandler>::type>(*self_, socket_,
+          handler2.value)(asio::error_code(), 1);
+    }
+
+  private:
+    basic_socket_dispatcher* self_;
+    socket_type& socket_;
+  };
+
+  std::vector<worker*> workers_;
+  std::size_t next_;
+};
+
+/// Typedef for the typical usage of a socket dispatcher.
+typedef basic_socket_dispatcher<> socket_dispatcher;
+
+} // namespace local
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <typename Executor, typename Socket,
+    typename DispatchHandler, typename Allocator>
+struct associated_allocator<
+    local::detail::dispatch_op<Executor, Socket, DispatchHandler>,
+    Allocator>
+{
+  typedef typename associated_allocator<DispatchHandler, Allocator>::type type;
+
+  static type get(
+      const local::detail::dispatch_op<Executor, Socket, DispatchHandler>& h,
+      const Allocator& a = Allocator()) ASIO_NOEXCEPT
+  {
+    return associated_allocator<DispatchHandler, Allocator>::get(
+        h.handler_, a);
+  }
+};
+
+template <typename Executor, typename Socket,
+    typename DispatchHandler, typename Executor1>
+struct associated_executor<
+    local::detail::dispatch_op<Executor, Socket, DispatchHandler>,
+    Executor1>
+{
+  typedef typename associated_executor<DispatchHandler, Executor1>::type type;
+
+  static type get(
+      const local::detail::dispatch_op<Executor, Socket, DispatchHandler>& h,
+      const Executor1& ex = Executor1()) ASIO_NOEXCEPT
+  {
+    return associated_executor<DispatchHandler, Executor1>::get(
+        h.handler_, ex);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // (defined(ASIO_HAS_LOCAL_SOCKETS) && defined(ASIO_HAS_MOVE))
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_LOCAL_SOCKET_DISPATCHER_HPP
@@ -21,6 +21,10 @@
 #include "asio/buffer.hpp"
 #include "asio/error.hpp"
 
+#if defined(ASIO_HAS_CHRONO)
+# include "asio/detail/chrono.hpp"
+#endif // defined(ASIO_HAS_CHRONO)
+
 #if !defined(ASIO_NO_EXTENSIONS)
 # include "asio/basic_streambuf_fwd.hpp"
 #endif // !defined(ASIO_NO_EXTENSIONS)
@@ -223,6 +227,100 @@ std::size_t read(SyncReadStream& s, const MutableBufferSequence& buffers,
       is_mutable_buffer_sequence<MutableBufferSequence>::value
     >::type* = 0);
 
+#if defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
+/// Attempt to read a certain amount of data from a stream within a given
+/// duration.
+/**
+ * This function is used to read a certain number of bytes of data from a
+ * stream, giving up when a deadline is reached. The call will block until one
+ * of the following conditions is true:
+ *
+ * @li The supplied buffers are full. That is, the bytes transferred is equal to
+ * the sum of the buffer sizes.
+ *
+ * @li The timeout expired.
+ *
+ * @li An error occurred.
+ *
+ * This operation is implemented in terms of zero or more calls to the stream's
+ * read_some_for function, each of which is passed the time remaining until the
+ * deadline. Data is read in large chunks, and no I/O executor is involved.
+ *
+ * @param s The stream from which the data is to be read. The type must support
+ * the SyncReadStream concept, and must also provide a read_some_for member
+ * function, such as that of basic_stream_socket or basic_serial_port.
+ *
+ * @param buffers One or more buffers into which the data will be read. The sum
+ * of the buffer sizes indicates the maximum number of bytes to read from the
+ * stream.
+ *
+ * @param timeout The longest time for which the whole operation may block.
+ *
+ * @returns The number of bytes transferred.
+ *
+ * @throws asio::system_error Thrown on failure. An error code of
+ * asio::error::timed_out indicates that the timeout expired before the
+ * operation completed.
+ *
+ * @par Example
+ * @code asio::read_for(s, asio::buffer(data, size),
+ *     std::chrono::seconds(5)); @endcode
+ */
+template <typename SyncReadStream, typename MutableBufferSequence,
+    typename Rep, typename Period>
+std::size_t read_for(SyncReadStream& s, const MutableBufferSequence& buffers,
+    const chrono::duration<Rep, Period>& timeout,
+    typename enable_if<
+      is_mutable_buffer_sequence<MutableBufferSequence>::value
+    >::type* = 0);
+
+/// Attempt to read a certain amount of data from a stream within a given
+/// duration.
+/**
+ * This function is used to read a certain number of bytes of data from a
+ * stream, giving up when a deadline is reached. The call will block until one
+ * of the following conditions is true:
+ *
+ * @li The supplied buffers are full. That is, the bytes transferred is equal to
+ * the sum of the buffer sizes.
+ *
+ * @li The timeout expired.
+ *
+ * @li An error occurred.
+ *
+ * This operation is implemented in terms of zero or more calls to the stream's
+ * read_some_for function, each of which is passed the time remaining until the
+ * deadline. Data is read in large chunks, and no I/O executor is involved.
+ *
+ * @param s The stream from which the data is to be read. The type must support
+ * the SyncReadStream concept, and must also provide a read_some_for member
+ * function, such as that of basic_stream_socket or basic_serial_port.
+ *
+ * @param buffers One or more buffers into which the data will be read. The sum
+ * of the buffer sizes indicates the maximum number of bytes to read from the
+ * stream.
+ *
+ * @param timeout The longest time for which the whole operation may block.
+ *
+ * @param ec Set to indicate what error occurred, if any. An error code of
+ * asio::error::timed_out indicates that the timeout expired before the
+ * operation completed.
+ *
+ * @returns The number of bytes transferred. If an error occurs, or the timeout
+ * expires, returns the total number of bytes successfully transferred prior to
+ * the error.
+ */
+template <typename SyncReadStream, typename MutableBufferSequence,
+    typename Rep, typename Period>
+std::size_t read_for(SyncReadStream& s, const MutableBufferSequence& buffers,
+    const chrono::duration<Rep, Period>& timeout, asio::error_code& ec,
+    typename enable_if<
+      is_mutable_buffer_sequence<MutableBufferSequence>::value
+    >::type* = 0);
+
+#endif // defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
 #if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
 
 /// Attempt to read a certain amount of data from a stream before returning.
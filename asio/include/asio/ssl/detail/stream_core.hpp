@@ -24,6 +24,7 @@
 #endif // defined(ASIO_HAS_BOOST_DATE_TIME)
 #include "asio/ssl/detail/engine.hpp"
 #include "asio/buffer.hpp"
+#include "asio/detail/allocation_tracking.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -47,6 +48,10 @@ struct stream_core
       input_buffer_space_(max_tls_record_size),
       input_buffer_(asio::buffer(input_buffer_space_))
   {
+    // Record the allocation of the output and input buffers.
+    ASIO_HEAP_ALLOCATION(("ssl_stream_core", max_tls_record_size));
+    ASIO_HEAP_ALLOCATION(("ssl_stream_core", max_tls_record_size));
+
     pending_read_.expires_at(neg_infin());
     pending_write_.expires_at(neg_infin());
   }
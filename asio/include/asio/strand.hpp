@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include "asio/detail/executor_priority.hpp"
 #include "asio/detail/strand_executor_service.hpp"
 #include "asio/detail/type_traits.hpp"
 
@@ -298,6 +299,23 @@ make_strand(ExecutionContext& ctx,
 
 /*@}*/
 
+#if !defined(GENERATING_DOCUMENTATION)
+
+namespace detail {
+
+template <typename Executor>
+struct executor_priority<strand<Executor> >
+{
+  static int get(const strand<Executor>& ex) ASIO_NOEXCEPT
+  {
+    return executor_priority<Executor>::get(ex.get_inner_executor());
+  }
+};
+
+} // namespace detail
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
 } // namespace asio
 
 #include "asio/detail/pop_options.hpp"
@@ -0,0 +1,226 @@
+//
+// transfer.hpp
+// ~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_TRANSFER_HPP
+#define ASIO_TRANSFER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/async_result.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/**
+ * @defgroup async_transfer asio::async_transfer
+ *
+ * @brief The @c async_transfer function is a composed asynchronous operation
+ * that moves data from one stream to another.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to transfer data from one stream to
+/// another.
+/**
+ * This function is used to asynchronously move data from a source stream to a
+ * destination stream. The function call always returns immediately. The
+ * asynchronous operation will continue until one of the following conditions
+ * is true:
+ *
+ * @li The specified number of bytes has been written to the destination.
+ *
+ * @li The source stream reaches end of file, in which case the handler is
+ * passed the error code asio::error::eof.
+ *
+ * @li An error occurred.
+ *
+ * On Linux, when both streams are a basic_stream_socket or a
+ * posix::basic_stream_descriptor, the data is moved using the @c splice system
+ * call through an intermediate pipe, and is never copied into user space. Both
+ * streams are put into non-blocking mode for the duration of the operation,
+ * and are returned to their previous mode when it completes. Otherwise, the
+ * operation is implemented in terms of the source stream's async_read_some
+ * function and asio::async_write, using a single buffer for the whole
+ * transfer. The buffer is recycled through a per-thread cache, so a transfer
+ * started from a completion handler reuses the previous transfer's buffer.
+ *
+ * The program must ensure that neither stream has any other outstanding
+ * operations of the same direction until this operation completes.
+ *
+ * @param from The stream from which the data is to be read. The type must
+ * support the AsyncReadStream concept.
+ *
+ * @param to The stream to which the data is to be written. The type must
+ * support the AsyncWriteStream concept.
+ *
+ * @param max_size The maximum number of bytes to be transferred.
+ *
+ * @param handler The handler to be called when the transfer completes. Copies
+ * will be made of the handler as required. The function signature of the
+ * handler must be:
+ * @code void handler(
+ *   const asio::error_code& error, // Result of operation.
+ *
+ *   std::size_t bytes_transferred           // Number of bytes written to the
+ *                                           // destination stream.
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. On
+ * immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::post().
+ *
+ * @par Example
+ * Relaying one direction of a proxied connection:
+ * @code
+ * asio::async_transfer(client_socket, server_socket,
+ *     [](asio::error_code ec, std::size_t n)
+ *     {
+ *       if (ec == asio::error::eof)
+ *       {
+ *         // The client closed its side. Propagate the half close.
+ *       }
+ *     }); @endcode
+ */
+template <typename AsyncReadStream, typename AsyncWriteStream,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) TransferHandler
+        ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(
+          typename AsyncWriteStream::executor_type)>
+ASIO_INITFN_AUTO_RESULT_TYPE(TransferHandler,
+    void (asio::error_code, std::size_t))
+async_transfer(AsyncReadStream& from, AsyncWriteStream& to,
+    std::size_t max_size,
+    ASIO_MOVE_ARG(TransferHandler) handler
+      ASIO_DEFAULT_COMPLETION_TOKEN(
+        typename AsyncWriteStream::executor_type));
+
+/// Start an asynchronous operation to transfer all data from one stream to
+/// another.
+/**
+ * This function is used to asynchronously move data from a source stream to a
+ * destination stream until the source stream reaches end of file. The
+ * operation completes with the error code asio::error::eof when all
+ * data has been transferred.
+ *
+ * @note This overload is equivalent to calling:
+ * @code asio::async_transfer(
+ *     from, to,
+ *     std::numeric_limits<std::size_t>::max(),
+ *     handler); @endcode
+ */
+template <typename AsyncReadStream, typename AsyncWriteStream,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) TransferHandler
+        ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(
+          typename AsyncWriteStream::executor_type)>
+ASIO_INITFN_AUTO_RESULT_TYPE(TransferHandler,
+    void (asio::error_code, std::size_t))
+async_transfer(AsyncReadStream& from, AsyncWriteStream& to,
+    ASIO_MOVE_ARG(TransferHandler) handler
+      ASIO_DEFAULT_COMPLETION_TOKEN(
+        typename AsyncWriteStream::executor_type));
+
+/*@}*/
+
+#if !defined(ASIO_WINDOWS) \
+  && !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(__CYGWIN__) \
+  || defined(GENERATING_DOCUMENTATION)
+
+/**
+ * @defgroup async_sendfile asio::async_sendfile
+ *
+ * @brief The @c async_sendfile function is a composed asynchronous operation
+ * that writes a range of a file to a stream.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to write a range of a file to a stream.
+/**
+ * This function is used to asynchronously write part of a regular file to a
+ * stream. The function call always returns immediately. The asynchronous
+ * operation will continue until one of the following conditions is true:
+ *
+ * @li The specified number of bytes has been written to the stream.
+ *
+ * @li The end of the file is reached, in which case the handler is passed the
+ * error code asio::error::eof.
+ *
+ * @li An error occurred.
+ *
+ * On Linux, when the stream is a basic_stream_socket or a
+ * posix::basic_stream_descriptor, the data is written using the @c sendfile
+ * system call and is never copied into user space. The stream is put into
+ * non-blocking mode for the duration of the operation, and is returned to its
+ * previous mode when it completes. Otherwise, the file is read using @c pread
+ * into a single, recycled buffer for the whole transfer, and written using
+ * asio::async_write.
+ *
+ * The file offset of the descriptor is not changed.
+ *
+ * @param to The stream to which the data is to be written. The type must
+ * support the AsyncWriteStream concept.
+ *
+ * @param file An open file descriptor for a regular file. Ownership of the
+ * descriptor is retained by the caller, which must guarantee that it remains
+ * open until the handler is called.
+ *
+ * @param offset The position in the file at which to start reading.
+ *
+ * @param size The number of bytes to be written.
+ *
+ * @param handler The handler to be called when the operation completes.
+ * Copies will be made of the handler as required. The function signature of
+ * the handler must be:
+ * @code void handler(
+ *   const asio::error_code& error, // Result of operation.
+ *
+ *   std::size_t bytes_transferred           // Number of bytes written to the
+ *                                           // stream.
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. On
+ * immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::post().
+ */
+template <typename AsyncWriteStream,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) TransferHandler
+        ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(
+          typename AsyncWriteStream::executor_type)>
+ASIO_INITFN_AUTO_RESULT_TYPE(TransferHandler,
+    void (asio::error_code, std::size_t))
+async_sendfile(AsyncWriteStream& to, int file,
+    uint64_t offset, std::size_t size,
+    ASIO_MOVE_ARG(TransferHandler) handler
+      ASIO_DEFAULT_COMPLETION_TOKEN(
+        typename AsyncWriteStream::executor_type));
+
+/*@}*/
+
+#endif // !defined(ASIO_WINDOWS)
+       //   && !defined(ASIO_WINDOWS_RUNTIME)
+       //   && !defined(__CYGWIN__)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/impl/transfer.hpp"
+
+#endif // ASIO_TRANSFER_HPP
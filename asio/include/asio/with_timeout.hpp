@@ -0,0 +1,81 @@
+//
+// with_timeout.hpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_WITH_TIMEOUT_HPP
+#define ASIO_WITH_TIMEOUT_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Completion token type used to specify that an asynchronous operation is
+/// cancelled if it does not complete within a given duration.
+/**
+ * The with_timeout_t class is used to indicate that an asynchronous operation
+ * should be cancelled if it has not completed when the timeout expires. The
+ * cancellation is delivered through the completion handler's associated
+ * cancellation slot, so only the timed out operation is cancelled and the I/O
+ * object remains open. When the operation is cancelled due to the timeout, the
+ * error passed to the completion handler is asio::error::timed_out.
+ *
+ * Operations that do not support per-operation cancellation are unaffected by
+ * the timeout, and complete normally.
+ */
+template <typename CompletionToken>
+class with_timeout_t
+{
+public:
+  /// The type of the timeout duration.
+  typedef chrono::steady_clock::duration duration;
+
+  /// Constructor.
+  template <typename T>
+  with_timeout_t(ASIO_MOVE_ARG(T) completion_token,
+      const duration& timeout)
+    : token_(ASIO_MOVE_CAST(T)(completion_token)),
+      timeout_(timeout)
+  {
+  }
+
+//private:
+  CompletionToken token_;
+  duration timeout_;
+};
+
+/// Create a completion token that cancels an operation after a timeout.
+template <typename CompletionToken>
+inline with_timeout_t<typename decay<CompletionToken>::type> with_timeout(
+    ASIO_MOVE_ARG(CompletionToken) completion_token,
+    const chrono::steady_clock::duration& timeout)
+{
+  return with_timeout_t<typename decay<CompletionToken>::type>(
+      ASIO_MOVE_CAST(CompletionToken)(completion_token), timeout);
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/impl/with_timeout.hpp"
+
+#endif // defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_WITH_TIMEOUT_HPP
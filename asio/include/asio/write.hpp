@@ -21,6 +21,10 @@
 #include "asio/buffer.hpp"
 #include "asio/error.hpp"
 
+#if defined(ASIO_HAS_CHRONO)
+# include "asio/detail/chrono.hpp"
+#endif // defined(ASIO_HAS_CHRONO)
+
 #if !defined(ASIO_NO_EXTENSIONS)
 # include "asio/basic_streambuf_fwd.hpp"
 #endif // !defined(ASIO_NO_EXTENSIONS)
@@ -223,6 +227,100 @@ std::size_t write(SyncWriteStream& s, const ConstBufferSequence& buffers,
       is_const_buffer_sequence<ConstBufferSequence>::value
     >::type* = 0);
 
+#if defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
+/// Write a certain amount of data to a stream within a given duration.
+/**
+ * This function is used to write a certain number of bytes of data to a
+ * stream, giving up when a deadline is reached. The call will block until one
+ * of the following conditions is true:
+ *
+ * @li All of the data in the supplied buffers has been written. That is, the
+ * bytes transferred is equal to the sum of the buffer sizes.
+ *
+ * @li The timeout expired.
+ *
+ * @li An error occurred.
+ *
+ * This operation is implemented in terms of zero or more calls to the stream's
+ * write_some_for function, each of which is passed the time remaining until
+ * the deadline. Data is written in large chunks, and no I/O executor is
+ * involved.
+ *
+ * @param s The stream to which the data is to be written. The type must
+ * support the SyncWriteStream concept, and must also provide a write_some_for
+ * member function, such as that of basic_stream_socket or basic_serial_port.
+ *
+ * @param buffers One or more buffers containing the data to be written. The
+ * sum of the buffer sizes indicates the maximum number of bytes to write to
+ * the stream.
+ *
+ * @param timeout The longest time for which the whole operation may block.
+ *
+ * @returns The number of bytes transferred.
+ *
+ * @throws asio::system_error Thrown on failure. An error code of
+ * asio::error::timed_out indicates that the timeout expired before the
+ * operation completed.
+ *
+ * @par Example
+ * @code asio::write_for(s, asio::buffer(data, size),
+ *     std::chrono::seconds(5)); @endcode
+ */
+template <typename SyncWriteStream, typename ConstBufferSequence,
+    typename Rep, typename Period>
+std::size_t write_for(SyncWriteStream& s, const ConstBufferSequence& buffers,
+    const chrono::duration<Rep, Period>& timeout,
+    typename enable_if<
+      is_const_buffer_sequence<ConstBufferSequence>::value
+    >::type* = 0);
+
+/// Write a certain amount of data to a stream within a given duration.
+/**
+ * This function is used to write a certain number of bytes of data to a
+ * stream, giving up when a deadline is reached. The call will block until one
+ * of the following conditions is true:
+ *
+ * @li All of the data in the supplied buffers has been written. That is, the
+ * bytes transferred is equal to the sum of the buffer sizes.
+ *
+ * @li The timeout expired.
+ *
+ * @li An error occurred.
+ *
+ * This operation is implemented in terms of zero or more calls to the stream's
+ * write_some_for function, each of which is passed the time remaining until
+ * the deadline. Data is written in large chunks, and no I/O executor is
+ * involved.
+ *
+ * @param s The stream to which the data is to be written. The type must
+ * support the SyncWriteStream concept, and must also provide a write_some_for
+ * member function, such as that of basic_stream_socket or basic_serial_port.
+ *
+ * @param buffers One or more buffers containing the data to be written. The
+ * sum of the buffer sizes indicates the maximum number of bytes to write to
+ * the stream.
+ *
+ * @param timeout The longest time for which the whole operation may block.
+ *
+ * @param ec Set to indicate what error occurred, if any. An error code of
+ * asio::error::timed_out indicates that the timeout expired before the
+ * operation completed.
+ *
+ * @returns The number of bytes transferred. If an error occurs, or the timeout
+ * expires, returns the total number of bytes successfully transferred prior to
+ * the error.
+ */
+template <typename SyncWriteStream, typename ConstBufferSequence,
+    typename Rep, typename Period>
+std::size_t write_for(SyncWriteStream& s, const ConstBufferSequence& buffers,
+    const chrono::duration<Rep, Period>& timeout, asio::error_code& ec,
+    typename enable_if<
+      is_const_buffer_sequence<ConstBufferSequence>::value
+    >::type* = 0);
+
+#endif // defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
 #if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
 
 /// Write all of the supplied data to a stream before returning.
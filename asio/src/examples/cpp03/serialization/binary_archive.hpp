@@ -0,0 +1,465 @@
+//
+// binary_archive.hpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef SERIALIZATION_BINARY_ARCHIVE_HPP
+#define SERIALIZATION_BINARY_ARCHIVE_HPP
+
+#include <asio/buffer.hpp>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace s11n_example {
+
+/// The largest number of bytes needed to encode a 64-bit varint.
+enum { max_varint_length = 10 };
+
+/// Encode an unsigned integer as a varint: seven bits per byte, least
+/// significant group first, with the top bit set on all but the last byte.
+/// Returns the number of bytes written.
+inline std::size_t encode_varint(unsigned long long value, char* out)
+{
+  std::size_t n = 0;
+  while (value >= 0x80)
+  {
+    out[n++] = static_cast<char>((value & 0x7F) | 0x80);
+    value >>= 7;
+  }
+  out[n++] = static_cast<char>(value);
+  return n;
+}
+
+/// Decode a varint from a range of bytes. Returns the number of bytes used,
+/// or 0 if the range does not hold a complete varint. Sets error if the
+/// encoding is too long to be valid.
+inline std::size_t decode_varint(const char* begin, const char* end,
+    unsigned long long& value, bool& error)
+{
+  value = 0;
+  error = false;
+  for (std::size_t n = 0; begin + n != end; ++n)
+  {
+    if (n == max_varint_length)
+    {
+      error = true;
+      return 0;
+    }
+    unsigned long long byte = static_cast<unsigned char>(begin[n]);
+    if (n == max_varint_length - 1 && byte > 1)
+    {
+      // The value does not fit in 64 bits.
+      error = true;
+      return 0;
+    }
+    value |= (byte & 0x7F) << (7 * n);
+    if ((byte & 0x80) == 0)
+      return n + 1;
+  }
+  return 0;
+}
+
+/// Writes data structures to a string in a compact binary form.
+/**
+ * The archive is used in the same way as a Boost.Serialization output
+ * archive, so any type with a serialize() member function can be written:
+ * @li Unsigned integers are written as varints and signed integers as
+ * zigzag-encoded varints, so small values take a single byte.
+ * @li bool and character types are written as a single byte.
+ * @li float and double are written in little-endian byte order.
+ * @li Strings and buffers are written as a varint length followed by the
+ * bytes.
+ * @li Vectors are written as a varint count followed by the elements.
+ *
+ * There is no type information or versioning in the output, so the reader
+ * must read the same types in the same order.
+ */
+class binary_oarchive
+{
+public:
+  /// Construct an archive that appends to the given string.
+  explicit binary_oarchive(std::string& data)
+    : data_(data)
+  {
+  }
+
+  /// Write a value to the archive.
+  template <typename T>
+  binary_oarchive& operator<<(const T& t)
+  {
+    return *this & t;
+  }
+
+  binary_oarchive& operator&(const bool& b)
+  {
+    data_.push_back(b ? 1 : 0);
+    return *this;
+  }
+
+  binary_oarchive& operator&(const char& c)
+  {
+    data_.push_back(c);
+    return *this;
+  }
+
+  binary_oarchive& operator&(const signed char& c)
+  {
+    data_.push_back(static_cast<char>(c));
+    return *this;
+  }
+
+  binary_oarchive& operator&(const unsigned char& c)
+  {
+    data_.push_back(static_cast<char>(c));
+    return *this;
+  }
+
+  binary_oarchive& operator&(const short& i) { return save_signed(i); }
+  binary_oarchive& operator&(const int& i) { return save_signed(i); }
+  binary_oarchive& operator&(const long& i) { return save_signed(i); }
+  binary_oarchive& operator&(const long long& i) { return save_signed(i); }
+
+  binary_oarchive& operator&(const unsigned short& i)
+  {
+    return save_unsigned(i);
+  }
+
+  binary_oarchive& operator&(const unsigned int& i)
+  {
+    return save_unsigned(i);
+  }
+
+  binary_oarchive& operator&(const unsigned long& i)
+  {
+    return save_unsigned(i);
+  }
+
+  binary_oarchive& operator&(const unsigned long long& i)
+  {
+    return save_unsigned(i);
+  }
+
+  binary_oarchive& operator&(const float& f)
+  {
+    unsigned int bits = 0;
+    std::memcpy(&bits, &f, sizeof(f));
+    return save_little_endian(bits, sizeof(f));
+  }
+
+  binary_oarchive& operator&(const double& d)
+  {
+    unsigned long long bits = 0;
+    std::memcpy(&bits, &d, sizeof(d));
+    return save_little_endian(bits, sizeof(d));
+  }
+
+  binary_oarchive& operator&(const std::string& s)
+  {
+    save_unsigned(s.size());
+    data_.append(s);
+    return *this;
+  }
+
+  binary_oarchive& operator&(const asio::const_buffer& b)
+  {
+    save_unsigned(b.size());
+    data_.append(static_cast<const char*>(b.data()), b.size());
+    return *this;
+  }
+
+  template <typename T>
+  binary_oarchive& operator&(const std::vector<T>& v)
+  {
+    save_unsigned(v.size());
+    for (std::size_t i = 0; i < v.size(); ++i)
+      *this & v[i];
+    return *this;
+  }
+
+  /// Write a structure using its serialize() member function.
+  template <typename T>
+  binary_oarchive& operator&(const T& t)
+  {
+    const_cast<T&>(t).serialize(*this, 0);
+    return *this;
+  }
+
+private:
+  binary_oarchive& save_unsigned(unsigned long long value)
+  {
+    char bytes[max_varint_length];
+    data_.append(bytes, encode_varint(value, bytes));
+    return *this;
+  }
+
+  binary_oarchive& save_signed(long long value)
+  {
+    // Zigzag encoding maps 0, -1, 1, -2, ... to 0, 1, 2, 3, ...
+    unsigned long long bits = static_cast<unsigned long long>(value) << 1;
+    return save_unsigned(value < 0 ? ~bits : bits);
+  }
+
+  binary_oarchive& save_little_endian(unsigned long long bits, std::size_t n)
+  {
+    char bytes[sizeof(bits)];
+    for (std::size_t i = 0; i < n; ++i)
+      bytes[i] = static_cast<char>(bits >> (8 * i));
+    data_.append(bytes, n);
+    return *this;
+  }
+
+  std::string& data_;
+};
+
+/// Reads data structures written by a binary_oarchive.
+/**
+ * The archive reads directly from a buffer, without copying it first.
+ * Members of type asio::const_buffer are set to refer to the bytes within the
+ * buffer, so they remain valid only as long as the buffer does.
+ *
+ * Reading stops at the first error, such as running out of data or finding a
+ * value that does not fit in the type being read. Subsequent reads have no
+ * effect, and good() returns false.
+ */
+class binary_iarchive
+{
+public:
+  /// Construct an archive that reads from the given buffer.
+  explicit binary_iarchive(const asio::const_buffer& data)
+    : next_(static_cast<const char*>(data.data())),
+      end_(next_ + data.size()),
+      good_(true)
+  {
+  }
+
+  /// Whether all reads so far have succeeded.
+  bool good() const
+  {
+    return good_;
+  }
+
+  /// The number of bytes that have not been read.
+  std::size_t remaining() const
+  {
+    return end_ - next_;
+  }
+
+  /// Read a value from the archive.
+  template <typename T>
+  binary_iarchive& operator>>(T& t)
+  {
+    return *this & t;
+  }
+
+  binary_iarchive& operator&(bool& b)
+  {
+    char c = 0;
+    if (load_byte(c))
+    {
+      if (c == 0 || c == 1)
+        b = (c == 1);
+      else
+        good_ = false;
+    }
+    return *this;
+  }
+
+  binary_iarchive& operator&(char& c)
+  {
+    load_byte(c);
+    return *this;
+  }
+
+  binary_iarchive& operator&(signed char& c)
+  {
+    char byte = 0;
+    if (load_byte(byte))
+      c = static_cast<signed char>(byte);
+    return *this;
+  }
+
+  binary_iarchive& operator&(unsigned char& c)
+  {
+    char byte = 0;
+    if (load_byte(byte))
+      c = static_cast<unsigned char>(byte);
+    return *this;
+  }
+
+  binary_iarchive& operator&(short& i) { return load_signed(i); }
+  binary_iarchive& operator&(int& i) { return load_signed(i); }
+  binary_iarchive& operator&(long& i) { return load_signed(i); }
+  binary_iarchive& operator&(long long& i) { return load_signed(i); }
+  binary_iarchive& operator&(unsigned short& i) { return load_unsigned(i); }
+  binary_iarchive& operator&(unsigned int& i) { return load_unsigned(i); }
+  binary_iarchive& operator&(unsigned long& i) { return load_unsigned(i); }
+
+  binary_iarchive& operator&(unsigned long long& i)
+  {
+    return load_unsigned(i);
+  }
+
+  binary_iarchive& operator&(float& f)
+  {
+    unsigned long long bits = 0;
+    if (load_little_endian(bits, sizeof(f)))
+    {
+      unsigned int narrow = static_cast<unsigned int>(bits);
+      std::memcpy(&f, &narrow, sizeof(f));
+    }
+    return *this;
+  }
+
+  binary_iarchive& operator&(double& d)
+  {
+    unsigned long long bits = 0;
+    if (load_little_endian(bits, sizeof(d)))
+      std::memcpy(&d, &bits, sizeof(d));
+    return *this;
+  }
+
+  binary_iarchive& operator&(std::string& s)
+  {
+    asio::const_buffer b;
+    if (load_bytes(b))
+      s.assign(static_cast<const char*>(b.data()), b.size());
+    return *this;
+  }
+
+  binary_iarchive& operator&(asio::const_buffer& b)
+  {
+    load_bytes(b);
+    return *this;
+  }
+
+  template <typename T>
+  binary_iarchive& operator&(std::vector<T>& v)
+  {
+    std::size_t count = 0;
+    load_unsigned(count);
+
+    // Every element takes at least one byte, so a larger count is invalid.
+    if (good_ && count > remaining())
+      good_ = false;
+
+    if (good_)
+    {
+      v.resize(count);
+      for (std::size_t i = 0; i < count && good_; ++i)
+        *this & v[i];
+    }
+    return *this;
+  }
+
+  /// Read a structure using its serialize() member function.
+  template <typename T>
+  binary_iarchive& operator&(T& t)
+  {
+    t.serialize(*this, 0);
+    return *this;
+  }
+
+private:
+  bool load_byte(char& c)
+  {
+    if (good_ && next_ != end_)
+      c = *next_++;
+    else
+      good_ = false;
+    return good_;
+  }
+
+  bool load_varint(unsigned long long& value)
+  {
+    if (good_)
+    {
+      bool error = false;
+      std::size_t n = decode_varint(next_, end_, value, error);
+      if (n == 0)
+        good_ = false;
+      next_ += n;
+    }
+    return good_;
+  }
+
+  template <typename T>
+  binary_iarchive& load_unsigned(T& t)
+  {
+    unsigned long long value = 0;
+    if (load_varint(value))
+    {
+      if (value <= static_cast<unsigned long long>(
+            (std::numeric_limits<T>::max)()))
+        t = static_cast<T>(value);
+      else
+        good_ = false;
+    }
+    return *this;
+  }
+
+  template <typename T>
+  binary_iarchive& load_signed(T& t)
+  {
+    unsigned long long bits = 0;
+    if (load_varint(bits))
+    {
+      bits = (bits & 1) ? ~(bits >> 1) : (bits >> 1);
+      long long value = static_cast<long long>(bits);
+      if (value >= static_cast<long long>((std::numeric_limits<T>::min)())
+          && value <= static_cast<long long>((std::numeric_limits<T>::max)()))
+        t = static_cast<T>(value);
+      else
+        good_ = false;
+    }
+    return *this;
+  }
+
+  bool load_little_endian(unsigned long long& bits, std::size_t n)
+  {
+    if (good_ && remaining() >= n)
+    {
+      bits = 0;
+      for (std::size_t i = 0; i < n; ++i)
+        bits |= static_cast<unsigned long long>(
+            static_cast<unsigned char>(next_[i])) << (8 * i);
+      next_ += n;
+    }
+    else
+    {
+      good_ = false;
+    }
+    return good_;
+  }
+
+  bool load_bytes(asio::const_buffer& b)
+  {
+    std::size_t length = 0;
+    load_unsigned(length);
+    if (good_ && length <= remaining())
+    {
+      b = asio::const_buffer(next_, length);
+      next_ += length;
+    }
+    else
+    {
+      good_ = false;
+    }
+    return good_;
+  }
+
+  const char* next_;
+  const char* end_;
+  bool good_;
+};
+
+} // namespace s11n_example
+
+#endif // SERIALIZATION_BINARY_ARCHIVE_HPP
@@ -0,0 +1,245 @@
+//
+// framed_connection.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef SERIALIZATION_FRAMED_CONNECTION_HPP
+#define SERIALIZATION_FRAMED_CONNECTION_HPP
+
+#include <asio.hpp>
+#include <boost/array.hpp>
+#include <boost/bind.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "binary_archive.hpp"
+
+namespace s11n_example {
+
+/// The framed_connection class provides binary serialization primitives on
+/// top of a socket.
+/**
+ * Each message sent using this class consists of:
+ * @li A varint containing the length of the serialized data.
+ * @li The data serialized using binary_oarchive.
+ *
+ * Incoming data is read into a buffer that may hold several messages, and
+ * each message is deserialized directly from that buffer. The buffer and the
+ * outgoing data are reused, so a connection that exchanges messages of a
+ * similar size does not allocate memory once it has warmed up.
+ */
+class framed_connection
+{
+public:
+  /// The default limit on the size of an incoming message.
+  enum { default_max_message_size = 16 * 1024 * 1024 };
+
+  /// Constructor.
+  framed_connection(const asio::executor& ex,
+      std::size_t max_message_size = default_max_message_size)
+    : socket_(ex),
+      max_message_size_(max_message_size),
+      inbound_start_(0),
+      inbound_end_(0),
+      inbound_message_end_(0)
+  {
+  }
+
+  /// Get the underlying socket. Used for making a connection or for accepting
+  /// an incoming connection.
+  asio::ip::tcp::socket& socket()
+  {
+    return socket_;
+  }
+
+  /// Asynchronously write a data structure to the socket.
+  template <typename T, typename Handler>
+  void async_write(const T& t, Handler handler)
+  {
+    // Serialize the data first so we know how large it is.
+    outbound_data_.clear();
+    binary_oarchive archive(outbound_data_);
+    archive << t;
+
+    // Write the serialized data to the socket. We use "gather-write" to send
+    // both the header and the data in a single write operation.
+    boost::array<asio::const_buffer, 2> buffers =
+    {{
+      asio::buffer(outbound_header_,
+          encode_varint(outbound_data_.size(), outbound_header_)),
+      asio::buffer(outbound_data_)
+    }};
+    asio::async_write(socket_, buffers, handler);
+  }
+
+  /// Asynchronously read a data structure from the socket.
+  /**
+   * Any asio::const_buffer members of the data structure refer to the
+   * connection's inbound buffer, and remain valid until the next read.
+   */
+  template <typename T, typename Handler>
+  void async_read(T& t, Handler handler)
+  {
+    asio::error_code error;
+    if (decode_message(t, error))
+    {
+      // The message was already buffered. Inform the caller, but not from
+      // inside this function.
+      asio::post(socket_.get_executor(), boost::bind(handler, error));
+      return;
+    }
+
+    start_read(t, boost::make_tuple(handler));
+  }
+
+  /// Handle a completed read of more data. The handler is passed using a tuple
+  /// since boost::bind seems to have trouble binding a function object created
+  /// using boost::bind as a parameter.
+  template <typename T, typename Handler>
+  void handle_read(const asio::error_code& e, std::size_t bytes_transferred,
+      T& t, boost::tuple<Handler> handler)
+  {
+    if (e)
+    {
+      boost::get<0>(handler)(e);
+      return;
+    }
+
+    inbound_end_ += bytes_transferred;
+
+    asio::error_code error;
+    if (decode_message(t, error))
+      boost::get<0>(handler)(error);
+    else
+      start_read(t, handler);
+  }
+
+private:
+  /// Start an asynchronous call to receive more data, making room for the
+  /// rest of the current message.
+  template <typename T, typename Handler>
+  void start_read(T& t, boost::tuple<Handler> handler)
+  {
+    // Move the start of the current message to the front of the buffer.
+    if (inbound_start_ != 0)
+    {
+      std::memmove(&inbound_data_[0], &inbound_data_[0] + inbound_start_,
+          inbound_end_ - inbound_start_);
+      inbound_end_ -= inbound_start_;
+      inbound_start_ = 0;
+    }
+
+    std::size_t capacity = (std::max)(inbound_message_end_,
+        inbound_end_ + static_cast<std::size_t>(min_read_size));
+    if (inbound_data_.size() < capacity)
+      inbound_data_.resize(capacity);
+
+    void (framed_connection::*f)(
+        const asio::error_code&, std::size_t,
+        T&, boost::tuple<Handler>)
+      = &framed_connection::handle_read<T, Handler>;
+    socket_.async_read_some(
+        asio::buffer(&inbound_data_[0] + inbound_end_,
+          inbound_data_.size() - inbound_end_),
+        boost::bind(f, this,
+          asio::placeholders::error,
+          asio::placeholders::bytes_transferred,
+          boost::ref(t), handler));
+  }
+
+  /// Extract the data structure from the next message in the buffer. Returns
+  /// true if the message was complete or invalid, or false if more data is
+  /// needed.
+  template <typename T>
+  bool decode_message(T& t, asio::error_code& error)
+  {
+    const char* begin = inbound_data_.empty() ? 0 : &inbound_data_[0];
+
+    // Determine the length of the serialized data.
+    unsigned long long length = 0;
+    bool invalid = false;
+    std::size_t header_length = decode_varint(begin + inbound_start_,
+        begin + inbound_end_, length, invalid);
+    if (invalid || length > max_message_size_)
+    {
+      // Header doesn't seem to be valid. Inform the caller.
+      error = asio::error::invalid_argument;
+      return true;
+    }
+
+    if (header_length == 0)
+    {
+      // The header is incomplete.
+      inbound_message_end_ = 0;
+      return false;
+    }
+
+    std::size_t data_start = inbound_start_ + header_length;
+    std::size_t data_end = data_start + static_cast<std::size_t>(length);
+    if (data_end > inbound_end_)
+    {
+      // Remember how much room the whole message needs.
+      inbound_message_end_ = data_end - inbound_start_;
+      return false;
+    }
+
+    // Deserialize the data in place.
+    binary_iarchive archive(
+        asio::buffer(begin + data_start, data_end - data_start));
+    archive >> t;
+    if (!archive.good() || archive.remaining() != 0)
+    {
+      // Unable to decode data.
+      error = asio::error::invalid_argument;
+      return true;
+    }
+
+    inbound_start_ = data_end;
+    if (inbound_start_ == inbound_end_)
+      inbound_start_ = inbound_end_ = 0;
+    inbound_message_end_ = 0;
+    return true;
+  }
+
+  /// The underlying socket.
+  asio::ip::tcp::socket socket_;
+
+  /// The smallest amount of space offered to each read.
+  enum { min_read_size = 4096 };
+
+  /// The largest message that will be accepted.
+  std::size_t max_message_size_;
+
+  /// Holds an outbound header.
+  char outbound_header_[max_varint_length];
+
+  /// Holds the outbound data.
+  std::string outbound_data_;
+
+  /// Holds the inbound data, which may contain several messages.
+  std::vector<char> inbound_data_;
+
+  /// The offset of the first unread byte in the inbound data.
+  std::size_t inbound_start_;
+
+  /// The offset just past the last byte received.
+  std::size_t inbound_end_;
+
+  /// The size of the partially received message at the start of the inbound
+  /// data, if its header has been received.
+  std::size_t inbound_message_end_;
+};
+
+typedef boost::shared_ptr<framed_connection> framed_connection_ptr;
+
+} // namespace s11n_example
+
+#endif // SERIALIZATION_FRAMED_CONNECTION_HPP
@@ -0,0 +1,202 @@
+//
+// chat_room.hpp
+// ~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef CHAT_ROOM_HPP
+#define CHAT_ROOM_HPP
+
+#include <deque>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+#include "asio.hpp"
+#include "chat_message.hpp"
+
+//----------------------------------------------------------------------
+
+// A message that is shared, without copying, by every participant to which it
+// is delivered. It is a ConstBufferSequence, so it can be written directly.
+class shared_chat_message
+{
+public:
+  explicit shared_chat_message(const chat_message& msg)
+    : msg_(std::make_shared<const chat_message>(msg)),
+      buffer_(msg_->data(), msg_->length())
+  {
+  }
+
+  // Implement the ConstBufferSequence requirements.
+  typedef asio::const_buffer value_type;
+  typedef const asio::const_buffer* const_iterator;
+  const asio::const_buffer* begin() const { return &buffer_; }
+  const asio::const_buffer* end() const { return &buffer_ + 1; }
+
+private:
+  std::shared_ptr<const chat_message> msg_;
+  asio::const_buffer buffer_;
+};
+
+typedef std::deque<shared_chat_message> shared_chat_message_queue;
+
+//----------------------------------------------------------------------
+
+class chat_participant
+{
+public:
+  virtual ~chat_participant() {}
+  virtual void deliver(const shared_chat_message& msg) = 0;
+};
+
+typedef std::shared_ptr<chat_participant> chat_participant_ptr;
+
+//----------------------------------------------------------------------
+
+class chat_room
+{
+public:
+  void join(chat_participant_ptr participant)
+  {
+    participants_.insert(participant);
+    for (auto msg: recent_msgs_)
+      participant->deliver(msg);
+  }
+
+  void leave(chat_participant_ptr participant)
+  {
+    participants_.erase(participant);
+  }
+
+  void deliver(const chat_message& msg)
+  {
+    // The message is copied once, however many participants receive it.
+    shared_chat_message shared_msg(msg);
+
+    recent_msgs_.push_back(shared_msg);
+    while (recent_msgs_.size() > max_recent_msgs)
+      recent_msgs_.pop_front();
+
+    for (auto participant: participants_)
+      participant->deliver(shared_msg);
+  }
+
+private:
+  std::set<chat_participant_ptr> participants_;
+  enum { max_recent_msgs = 100 };
+  shared_chat_message_queue recent_msgs_;
+};
+
+//----------------------------------------------------------------------
+
+class chat_session
+  : public chat_participant,
+    public std::enable_shared_from_this<chat_session>
+{
+public:
+  chat_session(asio::ip::tcp::socket socket, chat_room& room)
+    : socket_(std::move(socket)),
+      room_(room)
+  {
+  }
+
+  void start()
+  {
+    room_.join(shared_from_this());
+    do_read_header();
+  }
+
+  void deliver(const shared_chat_message& msg)
+  {
+    bool write_in_progress = !write_msgs_.empty();
+    pending_msgs_.push_back(msg);
+    if (!write_in_progress)
+    {
+      do_write();
+    }
+  }
+
+private:
+  void do_read_header()
+  {
+    auto self(shared_from_this());
+    asio::async_read(socket_,
+        asio::buffer(read_msg_.data(), chat_message::header_length),
+        [this, self](std::error_code ec, std::size_t /*length*/)
+        {
+          if (!ec && read_msg_.decode_header())
+          {
+            do_read_body();
+          }
+          else
+          {
+            room_.leave(shared_from_this());
+          }
+        });
+  }
+
+  void do_read_body()
+  {
+    auto self(shared_from_this());
+    asio::async_read(socket_,
+        asio::buffer(read_msg_.body(), read_msg_.body_length()),
+        [this, self](std::error_code ec, std::size_t /*length*/)
+        {
+          if (!ec)
+          {
+            room_.deliver(read_msg_);
+            do_read_header();
+          }
+          else
+          {
+            room_.leave(shared_from_this());
+          }
+        });
+  }
+
+  void do_write()
+  {
+    // Gather all of the messages that arrived while the previous write was in
+    // progress into a single write.
+    write_msgs_.swap(pending_msgs_);
+    write_buffers_.clear();
+    for (auto& msg: write_msgs_)
+      write_buffers_.push_back(*msg.begin());
+
+    auto self(shared_from_this());
+    asio::async_write(socket_, write_buffers_,
+        [this, self](std::error_code ec, std::size_t /*length*/)
+        {
+          if (!ec)
+          {
+            write_msgs_.clear();
+            if (!pending_msgs_.empty())
+            {
+              do_write();
+            }
+          }
+          else
+          {
+            room_.leave(shared_from_this());
+          }
+        });
+  }
+
+  asio::ip::tcp::socket socket_;
+  chat_room& room_;
+  chat_message read_msg_;
+
+  // The messages being written, and those waiting for the next write. The
+  // vectors keep their capacity, so a busy session does not allocate memory
+  // for each message.
+  std::vector<shared_chat_message> write_msgs_;
+  std::vector<shared_chat_message> pending_msgs_;
+  std::vector<asio::const_buffer> write_buffers_;
+};
+
+#endif // CHAT_ROOM_HPP
@@ -12,16 +12,21 @@
 #include <utility>
 #include <vector>
 #include "connection_manager.hpp"
+#include "read_message.hpp"
 #include "request_handler.hpp"
 
 namespace http {
 namespace server {
 
+/// The largest request that will be accepted.
+const std::size_t max_request_size = 65536;
+
 connection::connection(asio::ip::tcp::socket socket,
     connection_manager& manager, request_handler& handler)
   : socket_(std::move(socket)),
     connection_manager_(manager),
-    request_handler_(handler)
+    request_handler_(handler),
+    request_length_(0)
 {
 }
 
@@ -38,29 +43,24 @@ void connection::stop()
 void connection::do_read()
 {
   auto self(shared_from_this());
-  socket_.async_read_some(asio::buffer(buffer_),
+  async_read_message(socket_,
+      asio::dynamic_buffer(buffer_, max_request_size),
+      request_parser_, request_,
       [this, self](std::error_code ec, std::size_t bytes_transferred)
       {
         if (!ec)
         {
-          request_parser::result_type result;
-          std::tie(result, std::ignore) = request_parser_.parse(
-              request_, buffer_.data(), buffer_.data() + bytes_transferred);
-
-          if (result == request_parser::good)
-          {
-            request_handler_.handle_request(request_, reply_);
-            do_write();
-          }
-          else if (result == request_parser::bad)
-          {
-            reply_ = reply::stock_reply(reply::bad_request);
-            do_write();
-          }
-          else
-          {
-            do_read();
-          }
+          request_length_ = bytes_transferred;
+          reply_.headers.clear();
+          reply_.content.clear();
+          request_handler_.handle_request(request_, reply_);
+          do_write();
+        }
+        else if (ec == std::errc::bad_message || ec == std::errc::message_size)
+        {
+          request_.keep_alive = false;
+          reply_ = reply::stock_reply(reply::bad_request);
+          do_write();
         }
         else if (ec != asio::error::operation_aborted)
         {
@@ -71,24 +71,65 @@ void connection::do_read()
 
 void connection::do_write()
 {
+  reply_.headers.push_back(header{"Connection",
+      request_.keep_alive ? "keep-alive" : "close"});
+
   auto self(shared_from_this());
   asio::async_write(socket_, reply_.to_buffers(),
       [this, self](std::error_code ec, std::size_t)
       {
-        if (!ec)
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+        if (!ec && reply_.file && reply_.status == reply::ok
+            && reply_.file->descriptor() != -1)
         {
-          // Initiate graceful connection closure.
-          asio::error_code ignored_ec;
-          socket_.shutdown(asio::ip::tcp::socket::shutdown_both,
-            ignored_ec);
+          do_send_file();
+          return;
         }
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
 
-        if (ec != asio::error::operation_aborted)
-        {
-          connection_manager_.stop(shared_from_this());
-        }
+        finish_reply(ec);
       });
 }
 
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+void connection::do_send_file()
+{
+  auto self(shared_from_this());
+  asio::async_sendfile(socket_, reply_.file->descriptor(),
+      0, reply_.file->size(),
+      [this, self](std::error_code ec, std::size_t)
+      {
+        finish_reply(ec);
+      });
+}
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+void connection::finish_reply(std::error_code ec)
+{
+  // Release the file, which may hold a descriptor or mapping.
+  reply_.file.reset();
+
+  if (!ec && request_.keep_alive)
+  {
+    // Discard the request, keeping any pipelined requests that follow.
+    buffer_.erase(0, request_length_);
+    do_read();
+    return;
+  }
+
+  if (!ec)
+  {
+    // Initiate graceful connection closure.
+    asio::error_code ignored_ec;
+    socket_.shutdown(asio::ip::tcp::socket::shutdown_both,
+      ignored_ec);
+  }
+
+  if (ec != asio::error::operation_aborted)
+  {
+    connection_manager_.stop(shared_from_this());
+  }
+}
+
 } // namespace server
 } // namespace http
@@ -11,8 +11,8 @@
 #ifndef HTTP_CONNECTION_HPP
 #define HTTP_CONNECTION_HPP
 
-#include <array>
 #include <memory>
+#include <string>
 #include <asio.hpp>
 #include "reply.hpp"
 #include "request.hpp"
@@ -49,6 +49,15 @@ private:
   /// Perform an asynchronous write operation.
   void do_write();
 
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  /// Send the reply's file from its descriptor.
+  void do_send_file();
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+  /// Continue with the next request, or close the connection, once the reply
+  /// has been sent.
+  void finish_reply(std::error_code ec);
+
   /// Socket for the connection.
   asio::ip::tcp::socket socket_;
 
@@ -58,12 +67,16 @@ private:
   /// The handler used to process the incoming request.
   request_handler& request_handler_;
 
-  /// Buffer for incoming data.
-  std::array<char, 8192> buffer_;
+  /// Buffer for incoming data. The buffer holds the current request, which
+  /// refers into it, and any pipelined requests that follow.
+  std::string buffer_;
 
   /// The incoming request.
   request request_;
 
+  /// The length of the current request within the buffer.
+  std::size_t request_length_;
+
   /// The parser for the incoming request.
   request_parser request_parser_;
 
@@ -0,0 +1,196 @@
+//
+// file_cache.cpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "file_cache.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sys/stat.h>
+
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+# define HTTP_HAS_POSIX_FILES 1
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <unistd.h>
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+namespace http {
+namespace server {
+
+namespace {
+
+// Get the modification time in nanoseconds, so that a file that is rewritten
+// within the same second is still seen to have changed.
+long long modification_time(const struct stat& st)
+{
+  long long modified = static_cast<long long>(st.st_mtime) * 1000000000LL;
+#if defined(__APPLE__)
+  modified += st.st_mtimespec.tv_nsec;
+#elif defined(HTTP_HAS_POSIX_FILES)
+  modified += st.st_mtim.tv_nsec;
+#endif // defined(HTTP_HAS_POSIX_FILES)
+  return modified;
+}
+
+} // namespace
+
+static_file::static_file()
+  : size_(0),
+    modified_(0),
+    inode_(0),
+    mapping_(0),
+    descriptor_(-1)
+{
+}
+
+static_file::~static_file()
+{
+#if defined(HTTP_HAS_POSIX_FILES)
+  if (mapping_)
+    ::munmap(mapping_, size_);
+  if (descriptor_ != -1)
+    ::close(descriptor_);
+#endif // defined(HTTP_HAS_POSIX_FILES)
+}
+
+file_cache::file_cache(send_mode mode,
+    std::size_t max_size, std::size_t max_file_size)
+  : mode_(mode),
+    max_size_(max_size),
+    max_file_size_(max_file_size),
+    size_(0)
+{
+}
+
+std::shared_ptr<const static_file> file_cache::get(
+    const std::string& path, const std::string& content_type)
+{
+  struct stat st;
+  if (::stat(path.c_str(), &st) != 0 || (st.st_mode & S_IFMT) != S_IFREG)
+    return std::shared_ptr<const static_file>();
+
+  std::size_t size = static_cast<std::size_t>(st.st_size);
+  long long modified = modification_time(st);
+  unsigned long long inode = static_cast<unsigned long long>(st.st_ino);
+
+  auto iter = index_.find(path);
+  if (iter != index_.end())
+  {
+    const static_file& cached = *iter->second->second;
+    if (cached.size_ == size && cached.modified_ == modified
+        && cached.inode_ == inode)
+    {
+      // Move the file to the front of the list.
+      lru_.splice(lru_.begin(), lru_, iter->second);
+      return iter->second->second;
+    }
+
+    // The file has changed since it was cached.
+    size_ -= cached.size_;
+    lru_.erase(iter->second);
+    index_.erase(iter);
+  }
+
+  std::shared_ptr<static_file> file =
+    open(path, content_type, size, modified, inode);
+
+  // Keep small files in memory, unless the file changed while it was read.
+  if (file && size <= max_file_size_ && file->size_ == size)
+  {
+    lru_.emplace_front(path, file);
+    index_.emplace(path, lru_.begin());
+    size_ += size;
+    evict();
+  }
+
+  return file;
+}
+
+std::shared_ptr<static_file> file_cache::open(const std::string& path,
+    const std::string& content_type, std::size_t size,
+    long long modified, unsigned long long inode)
+{
+  std::shared_ptr<static_file> file(new static_file);
+  file->modified_ = modified;
+  file->inode_ = inode;
+
+#if defined(HTTP_HAS_POSIX_FILES)
+  if (size > max_file_size_)
+  {
+    int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat st;
+    if (descriptor == -1)
+      return std::shared_ptr<static_file>();
+    if (::fstat(descriptor, &st) != 0)
+    {
+      ::close(descriptor);
+      return std::shared_ptr<static_file>();
+    }
+    file->size_ = static_cast<std::size_t>(st.st_size);
+
+    if (mode_ == use_mmap && file->size_ > 0)
+    {
+      void* mapping = ::mmap(0, file->size_,
+          PROT_READ, MAP_PRIVATE, descriptor, 0);
+      ::close(descriptor);
+      if (mapping == MAP_FAILED)
+        return std::shared_ptr<static_file>();
+      file->mapping_ = mapping;
+      file->content_ = asio::buffer(mapping, file->size_);
+    }
+    else
+    {
+      file->descriptor_ = descriptor;
+    }
+  }
+  else
+#endif // defined(HTTP_HAS_POSIX_FILES)
+  {
+    std::ifstream is(path.c_str(), std::ios::in | std::ios::binary);
+    if (!is)
+      return std::shared_ptr<static_file>();
+    file->data_.reserve(size);
+    file->data_.assign(std::istreambuf_iterator<char>(is),
+        std::istreambuf_iterator<char>());
+    file->size_ = file->data_.size();
+    file->content_ = asio::buffer(file->data_);
+  }
+
+  // The entity tag is derived from the modification time, in nanoseconds, and
+  // the size.
+  char etag[64];
+  std::snprintf(etag, sizeof(etag), "\"%llx-%llx\"",
+      static_cast<unsigned long long>(modified),
+      static_cast<unsigned long long>(file->size_));
+  file->etag_ = etag;
+
+  file->headers_ = "HTTP/1.1 200 OK\r\n";
+  file->headers_ += "Content-Length: " + std::to_string(file->size_) + "\r\n";
+  file->headers_ += "Content-Type: " + content_type + "\r\n";
+  file->headers_ += "ETag: " + file->etag_ + "\r\n";
+
+  file->not_modified_headers_ = "HTTP/1.1 304 Not Modified\r\n";
+  file->not_modified_headers_ += "ETag: " + file->etag_ + "\r\n";
+
+  return file;
+}
+
+void file_cache::evict()
+{
+  while (size_ > max_size_ && !lru_.empty())
+  {
+    size_ -= lru_.back().second->size_;
+    index_.erase(lru_.back().first);
+    lru_.pop_back();
+  }
+}
+
+} // namespace server
+} // namespace http
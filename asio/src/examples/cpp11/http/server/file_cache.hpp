@@ -0,0 +1,137 @@
+//
+// file_cache.hpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef HTTP_FILE_CACHE_HPP
+#define HTTP_FILE_CACHE_HPP
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <asio/buffer.hpp>
+
+namespace http {
+namespace server {
+
+/// A file that is ready to be sent in a reply. The status line and headers
+/// are built once, when the file is opened.
+class static_file
+{
+public:
+  static_file(const static_file&) = delete;
+  static_file& operator=(const static_file&) = delete;
+
+  /// Release the file's memory, mapping or descriptor.
+  ~static_file();
+
+  /// The size of the file's content.
+  std::size_t size() const { return size_; }
+
+  /// The entity tag that identifies this version of the file.
+  const std::string& etag() const { return etag_; }
+
+  /// The status line and headers for a reply carrying the file, without the
+  /// empty line that ends the headers.
+  const std::string& headers() const { return headers_; }
+
+  /// The status line and headers for a reply saying that the client's copy of
+  /// the file is up to date, without the empty line that ends the headers.
+  const std::string& not_modified_headers() const
+  {
+    return not_modified_headers_;
+  }
+
+  /// The content, when it is held in memory or mapped.
+  asio::const_buffer content() const { return content_; }
+
+  /// The descriptor from which to send the content, or -1 if the content is
+  /// held in memory or mapped.
+  int descriptor() const { return descriptor_; }
+
+private:
+  friend class file_cache;
+
+  static_file();
+
+  std::size_t size_;
+  long long modified_;
+  unsigned long long inode_;
+  std::string etag_;
+  std::string headers_;
+  std::string not_modified_headers_;
+  std::string data_;
+  void* mapping_;
+  asio::const_buffer content_;
+  int descriptor_;
+};
+
+/// Opens files to be sent in replies, keeping small files in memory.
+///
+/// Files no larger than the cacheable size are kept in memory, and the least
+/// recently used are discarded once the cache exceeds its maximum size. Each
+/// lookup checks the file's size and modification time, so a changed file is
+/// reloaded. Larger files are opened afresh for each request and sent using
+/// sendfile or, in mmap mode, written from a memory mapping. Where neither is
+/// available they are read into memory. The cache is not thread safe.
+class file_cache
+{
+public:
+  file_cache(const file_cache&) = delete;
+  file_cache& operator=(const file_cache&) = delete;
+
+  /// How files too large to be cached are sent.
+  enum send_mode { use_sendfile, use_mmap };
+
+  /// Construct a cache that holds up to max_size bytes of files, each no
+  /// larger than max_file_size.
+  explicit file_cache(send_mode mode = use_sendfile,
+      std::size_t max_size = 64 * 1024 * 1024,
+      std::size_t max_file_size = 256 * 1024);
+
+  /// Get a file, or null if it cannot be opened. The content type is used only
+  /// when the file is not already cached.
+  std::shared_ptr<const static_file> get(const std::string& path,
+      const std::string& content_type);
+
+  /// The number of bytes of file content held in the cache.
+  std::size_t size() const { return size_; }
+
+  /// The number of files held in the cache.
+  std::size_t count() const { return index_.size(); }
+
+private:
+  typedef std::pair<std::string, std::shared_ptr<const static_file>> entry;
+
+  /// Open a file and build its headers.
+  std::shared_ptr<static_file> open(const std::string& path,
+      const std::string& content_type, std::size_t size,
+      long long modified, unsigned long long inode);
+
+  /// Discard the least recently used files until the cache fits.
+  void evict();
+
+  send_mode mode_;
+  std::size_t max_size_;
+  std::size_t max_file_size_;
+  std::size_t size_;
+
+  /// The cached files, most recently used first.
+  std::list<entry> lru_;
+
+  /// The cached files, by path.
+  std::unordered_map<std::string, std::list<entry>::iterator> index_;
+};
+
+} // namespace server
+} // namespace http
+
+#endif // HTTP_FILE_CACHE_HPP
@@ -12,6 +12,7 @@
 #define HTTP_HEADER_HPP
 
 #include <string>
+#include "string_view.hpp"
 
 namespace http {
 namespace server {
@@ -22,6 +23,14 @@ struct header
   std::string value;
 };
 
+/// A header field parsed from an incoming message. The name and value refer
+/// to the buffer that the message was parsed from.
+struct header_field
+{
+  string_view name;
+  string_view value;
+};
+
 } // namespace server
 } // namespace http
 
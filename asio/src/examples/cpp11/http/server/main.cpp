@@ -8,6 +8,7 @@
 // file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 //
 
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <asio.hpp>
@@ -18,9 +19,9 @@ int main(int argc, char* argv[])
   try
   {
     // Check command line arguments.
-    if (argc != 4)
+    if (argc != 4 && !(argc == 5 && std::strcmp(argv[4], "mmap") == 0))
     {
-      std::cerr << "Usage: http_server <address> <port> <doc_root>\n";
+      std::cerr << "Usage: http_server <address> <port> <doc_root> [mmap]\n";
       std::cerr << "  For IPv4, try:\n";
       std::cerr << "    receiver 0.0.0.0 80 .\n";
       std::cerr << "  For IPv6, try:\n";
@@ -29,7 +30,9 @@ int main(int argc, char* argv[])
     }
 
     // Initialise the server.
-    http::server::server s(argv[1], argv[2], argv[3]);
+    http::server::server s(argv[1], argv[2], argv[3],
+        argc == 5 ? http::server::file_cache::use_mmap
+          : http::server::file_cache::use_sendfile);
 
     // Run the server until stopped.
     s.run();
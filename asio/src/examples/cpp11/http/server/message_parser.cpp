@@ -0,0 +1,589 @@
+//
+// message_parser.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "message_parser.hpp"
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) \
+  || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+# define HTTP_HAS_SSE2 1
+# include <emmintrin.h>
+# if defined(_MSC_VER)
+#  include <intrin.h>
+# endif // defined(_MSC_VER)
+#endif // defined(__SSE2__) || ...
+
+namespace http {
+namespace server {
+
+namespace {
+
+/// Character classes used by the parser, indexed by byte value.
+class char_classes
+{
+public:
+  char_classes()
+  {
+    for (int c = 0; c < 256; ++c)
+    {
+      // Token characters, as defined in RFC 7230 section 3.2.6.
+      token_[c] = (c > 32 && c < 127 && !std::strchr("\"(),/:;<=>?@[\\]{}", c));
+    }
+  }
+
+  bool is_token(char c) const
+  {
+    return token_[static_cast<unsigned char>(c)];
+  }
+
+private:
+  bool token_[256];
+};
+
+const char_classes classes;
+
+bool is_digit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+/// Compare a range of the input with a lower case string, ignoring case.
+bool iequals(const char* p, std::size_t n, const char* lower)
+{
+  for (std::size_t i = 0; i < n; ++i, ++lower)
+  {
+    char c = p[i];
+    if (c >= 'A' && c <= 'Z')
+      c = static_cast<char>(c - 'A' + 'a');
+    if (*lower == 0 || c != *lower)
+      return false;
+  }
+  return *lower == 0;
+}
+
+#if defined(HTTP_HAS_SSE2)
+int count_trailing_zeros(int mask)
+{
+# if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, static_cast<unsigned long>(mask));
+  return static_cast<int>(index);
+# else // defined(_MSC_VER)
+  return __builtin_ctz(static_cast<unsigned int>(mask));
+# endif // defined(_MSC_VER)
+}
+#endif // defined(HTTP_HAS_SSE2)
+
+/// Find the first byte that is below the given limit, or is DEL. With a limit
+/// of ' ' this finds the first control character, and with a limit of '!' it
+/// also stops at a space. Sixteen bytes are classified at a time where SSE2 is
+/// available.
+const char* find_below(const char* p, const char* end, unsigned char limit)
+{
+#if defined(HTTP_HAS_SSE2)
+  const __m128i lim = _mm_set1_epi8(static_cast<char>(limit));
+  const __m128i del = _mm_set1_epi8(0x7f);
+  while (end - p >= 16)
+  {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i at_or_above = _mm_cmpeq_epi8(_mm_max_epu8(x, lim), x);
+    int mask = (~_mm_movemask_epi8(at_or_above) & 0xffff)
+      | _mm_movemask_epi8(_mm_cmpeq_epi8(x, del));
+    if (mask != 0)
+      return p + count_trailing_zeros(mask);
+    p += 16;
+  }
+#endif // defined(HTTP_HAS_SSE2)
+
+  for (; p != end; ++p)
+  {
+    unsigned char c = static_cast<unsigned char>(*p);
+    if (c < limit || c == 0x7f)
+      return p;
+  }
+  return p;
+}
+
+/// Find the end of a field value or reason phrase, which may contain any
+/// character other than a control character, except for horizontal tab.
+const char* find_value_end(const char* p, const char* end)
+{
+  for (;;)
+  {
+    p = find_below(p, end, ' ');
+    if (p == end || *p != '\t')
+      return p;
+    ++p;
+  }
+}
+
+const char* skip_whitespace(const char* p, const char* end)
+{
+  while (p != end && (*p == ' ' || *p == '\t'))
+    ++p;
+  return p;
+}
+
+/// Parse "HTTP/x.y".
+const char* parse_version(const char* p, const char* end,
+    int& major, int& minor)
+{
+  if (end - p < 8 || std::memcmp(p, "HTTP/", 5) != 0
+      || !is_digit(p[5]) || p[6] != '.' || !is_digit(p[7]))
+    return 0;
+  major = p[5] - '0';
+  minor = p[7] - '0';
+  return p + 8;
+}
+
+/// Parse a decimal length, rejecting values that may overflow.
+bool parse_length(const char* p, std::size_t n, std::size_t& length)
+{
+  const std::size_t max_length = std::numeric_limits<std::size_t>::max();
+  if (n == 0)
+    return false;
+  length = 0;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    if (!is_digit(p[i]))
+      return false;
+    std::size_t digit = static_cast<std::size_t>(p[i] - '0');
+    if (length > (max_length - digit) / 10)
+      return false;
+    length = length * 10 + digit;
+  }
+  return true;
+}
+
+} // namespace
+
+message_parser::message_parser(message_kind kind)
+  : kind_(kind)
+{
+  reset();
+}
+
+void message_parser::reset()
+{
+  method_ = target_ = reason_ = body_ = range();
+  version_major_ = version_minor_ = 0;
+  status_ = 0;
+  keep_alive_ = false;
+  phase_ = header_phase;
+  start_ = position_ = body_end_ = remaining_ = 0;
+  fields_.clear();
+}
+
+message_parser::result_type message_parser::parse_message(
+    char* begin, char* end, bool eof, std::size_t& consumed)
+{
+  if (phase_ == done_phase)
+    reset();
+
+  const std::size_t size = end - begin;
+  result_type result = indeterminate;
+
+  if (phase_ == header_phase)
+  {
+    // Skip any empty lines that precede the start line.
+    while (position_ == start_ && position_ != size
+        && (begin[position_] == '\r' || begin[position_] == '\n'))
+      start_ = ++position_;
+
+    // Find the empty line that ends the header block. Every line must end
+    // with CRLF.
+    std::size_t header_end = 0;
+    while (header_end == 0)
+    {
+      const void* nl = std::memchr(begin + position_, '\n', size - position_);
+      if (nl == 0)
+      {
+        position_ = size;
+        return indeterminate;
+      }
+
+      std::size_t i = static_cast<const char*>(nl) - begin;
+      position_ = i + 1;
+      if (begin[i - 1] != '\r')
+      {
+        phase_ = done_phase;
+        return bad;
+      }
+      if (i >= start_ + 3 && begin[i - 2] == '\n' && begin[i - 3] == '\r')
+        header_end = position_;
+    }
+
+    if (!parse_header_block(begin, start_, header_end))
+    {
+      phase_ = done_phase;
+      return bad;
+    }
+
+    body_.offset = body_end_ = header_end;
+  }
+
+  while (result == indeterminate)
+  {
+    switch (phase_)
+    {
+    case body_phase:
+      {
+        std::size_t n = size - position_;
+        if (n > remaining_)
+          n = remaining_;
+        position_ += n;
+        body_end_ = position_;
+        remaining_ -= n;
+        if (remaining_ != 0)
+          return indeterminate;
+        phase_ = done_phase;
+        result = good;
+      }
+      break;
+    case chunk_size_phase:
+      result = parse_chunk_size(begin, size);
+      if (result == indeterminate && phase_ == chunk_size_phase)
+        return indeterminate;
+      break;
+    case chunk_data_phase:
+      {
+        std::size_t n = size - position_;
+        if (n > remaining_)
+          n = remaining_;
+        if (body_end_ != position_)
+          std::memmove(begin + body_end_, begin + position_, n);
+        body_end_ += n;
+        position_ += n;
+        remaining_ -= n;
+        if (remaining_ != 0)
+          return indeterminate;
+        phase_ = chunk_crlf_phase;
+      }
+      break;
+    case chunk_crlf_phase:
+      if (size - position_ < 2)
+        return indeterminate;
+      if (begin[position_] != '\r' || begin[position_ + 1] != '\n')
+        result = bad;
+      position_ += 2;
+      phase_ = chunk_size_phase;
+      break;
+    case trailer_phase:
+      result = parse_trailer(begin, size);
+      if (result == indeterminate)
+        return indeterminate;
+      break;
+    case eof_phase:
+      position_ = body_end_ = size;
+      if (!eof)
+        return indeterminate;
+      result = good;
+      break;
+    case done_phase:
+      result = good;
+      break;
+    default:
+      result = bad;
+      break;
+    }
+  }
+
+  phase_ = done_phase;
+  if (result == good)
+  {
+    body_.length = body_end_ - body_.offset;
+    consumed = position_;
+  }
+  return result;
+}
+
+void message_parser::get_headers(const char* begin,
+    std::vector<header_field>& headers) const
+{
+  headers.resize(fields_.size());
+  for (std::size_t i = 0; i < fields_.size(); ++i)
+  {
+    headers[i].name = view(begin, fields_[i].first);
+    headers[i].value = view(begin, fields_[i].second);
+  }
+}
+
+bool message_parser::parse_header_block(const char* begin,
+    std::size_t start, std::size_t end)
+{
+  const char* p = begin + start;
+  const char* const block_end = begin + end;
+
+  p = (kind_ == request_message)
+    ? parse_request_line(begin, p, block_end)
+    : parse_status_line(begin, p, block_end);
+  if (p == 0)
+    return false;
+
+  // The header block is known to end with an empty line, and every line is
+  // known to end with CRLF, so the fields can be scanned without further
+  // bounds checks.
+  while (*p != '\r')
+  {
+    const char* name = p;
+    while (classes.is_token(*p))
+      ++p;
+    if (p == name || *p != ':')
+      return false; // Also rejects obsolete line folding.
+    const char* name_end = p;
+
+    const char* value = skip_whitespace(p + 1, block_end);
+    const char* value_end = find_value_end(value, block_end);
+    if (value_end[0] != '\r' || value_end[1] != '\n')
+      return false;
+    p = value_end + 2;
+    while (value_end != value
+        && (value_end[-1] == ' ' || value_end[-1] == '\t'))
+      --value_end;
+
+    range name_range = { static_cast<std::size_t>(name - begin),
+      static_cast<std::size_t>(name_end - name) };
+    range value_range = { static_cast<std::size_t>(value - begin),
+      static_cast<std::size_t>(value_end - value) };
+    fields_.push_back(std::make_pair(name_range, value_range));
+  }
+
+  // The first empty line must be the one that ends the block.
+  if (p + 2 != block_end)
+    return false;
+
+  return parse_framing(begin);
+}
+
+const char* message_parser::parse_request_line(
+    const char* begin, const char* p, const char* end)
+{
+  const char* method = p;
+  while (classes.is_token(*p))
+    ++p;
+  if (p == method || *p != ' ')
+    return 0;
+  method_.offset = method - begin;
+  method_.length = p - method;
+
+  const char* target = ++p;
+  p = find_below(p, end, '!');
+  if (p == target || *p != ' ')
+    return 0;
+  target_.offset = target - begin;
+  target_.length = p - target;
+
+  p = parse_version(p + 1, end, version_major_, version_minor_);
+  if (p == 0 || p[0] != '\r' || p[1] != '\n')
+    return 0;
+  return p + 2;
+}
+
+const char* message_parser::parse_status_line(
+    const char* begin, const char* p, const char* end)
+{
+  p = parse_version(p, end, version_major_, version_minor_);
+  if (p == 0 || p[0] != ' '
+      || !is_digit(p[1]) || !is_digit(p[2]) || !is_digit(p[3]))
+    return 0;
+  status_ = (p[1] - '0') * 100 + (p[2] - '0') * 10 + (p[3] - '0');
+  p += 4;
+
+  // The reason phrase may be empty, and some servers omit the space too.
+  if (*p == ' ')
+    ++p;
+  const char* reason = p;
+  p = find_value_end(p, end);
+  if (p[0] != '\r' || p[1] != '\n')
+    return 0;
+  reason_.offset = reason - begin;
+  reason_.length = p - reason;
+  return p + 2;
+}
+
+bool message_parser::parse_framing(const char* begin)
+{
+  bool has_length = false;
+  std::size_t length = 0;
+  bool has_transfer_encoding = false;
+  bool chunked = false;
+  bool close = false;
+  bool keep_alive = false;
+
+  for (std::size_t i = 0; i < fields_.size(); ++i)
+  {
+    const char* name = begin + fields_[i].first.offset;
+    std::size_t name_length = fields_[i].first.length;
+    const char* value = begin + fields_[i].second.offset;
+    std::size_t value_length = fields_[i].second.length;
+
+    if (iequals(name, name_length, "content-length"))
+    {
+      std::size_t n = 0;
+      if (!parse_length(value, value_length, n)
+          || (has_length && n != length))
+        return false;
+      has_length = true;
+      length = n;
+    }
+    else if (iequals(name, name_length, "transfer-encoding"))
+    {
+      // Only the final transfer coding determines the framing.
+      const char* coding = value + value_length;
+      while (coding != value && coding[-1] != ',')
+        --coding;
+      coding = skip_whitespace(coding, value + value_length);
+      has_transfer_encoding = true;
+      chunked = iequals(coding, value + value_length - coding, "chunked");
+    }
+    else if (iequals(name, name_length, "connection"))
+    {
+      const char* option = value;
+      const char* const value_end = value + value_length;
+      while (option != value_end)
+      {
+        const char* option_end = option;
+        while (option_end != value_end && *option_end != ',')
+          ++option_end;
+        const char* trimmed_end = option_end;
+        while (trimmed_end != option
+            && (trimmed_end[-1] == ' ' || trimmed_end[-1] == '\t'))
+          --trimmed_end;
+        close = close || iequals(option, trimmed_end - option, "close");
+        keep_alive = keep_alive
+          || iequals(option, trimmed_end - option, "keep-alive");
+        option = option_end == value_end ? option_end
+          : skip_whitespace(option_end + 1, value_end);
+      }
+    }
+  }
+
+  // HTTP/1.1 connections are persistent unless closed explicitly, while
+  // HTTP/1.0 connections must ask to be kept alive.
+  if (version_major_ > 1 || (version_major_ == 1 && version_minor_ >= 1))
+    keep_alive_ = !close;
+  else
+    keep_alive_ = keep_alive && !close;
+
+  if (kind_ == response_message
+      && ((status_ >= 100 && status_ < 200)
+        || status_ == 204 || status_ == 304))
+  {
+    // These responses never have a body.
+    phase_ = done_phase;
+  }
+  else if (has_transfer_encoding)
+  {
+    if (chunked)
+    {
+      // A request carrying both headers may be an attempt at request
+      // smuggling, so it is rejected outright.
+      if (kind_ == request_message && has_length)
+        return false;
+      phase_ = chunk_size_phase;
+    }
+    else if (kind_ == request_message)
+    {
+      return false;
+    }
+    else
+    {
+      phase_ = eof_phase;
+      keep_alive_ = false;
+    }
+  }
+  else if (has_length)
+  {
+    remaining_ = length;
+    phase_ = length > 0 ? body_phase : done_phase;
+  }
+  else if (kind_ == request_message)
+  {
+    phase_ = done_phase;
+  }
+  else
+  {
+    // The response body is delimited by the closing of the connection.
+    phase_ = eof_phase;
+    keep_alive_ = false;
+  }
+
+  return true;
+}
+
+message_parser::result_type message_parser::parse_chunk_size(
+    char* begin, std::size_t size)
+{
+  const void* nl = std::memchr(begin + position_, '\n', size - position_);
+  if (nl == 0)
+    return indeterminate;
+
+  const char* p = begin + position_;
+  const char* line_end = static_cast<const char*>(nl);
+  if (line_end == p || line_end[-1] != '\r')
+    return bad;
+  --line_end;
+
+  const std::size_t max_length = std::numeric_limits<std::size_t>::max();
+  std::size_t length = 0;
+  const char* digits = p;
+  for (; p != line_end; ++p)
+  {
+    char c = *p;
+    std::size_t digit;
+    if (is_digit(c))
+      digit = static_cast<std::size_t>(c - '0');
+    else if (c >= 'a' && c <= 'f')
+      digit = static_cast<std::size_t>(c - 'a' + 10);
+    else if (c >= 'A' && c <= 'F')
+      digit = static_cast<std::size_t>(c - 'A' + 10);
+    else
+      break;
+    if (length > (max_length - digit) / 16)
+      return bad;
+    length = length * 16 + digit;
+  }
+  if (p == digits)
+    return bad;
+
+  // Chunk extensions are ignored, but must not contain control characters.
+  p = skip_whitespace(p, line_end);
+  if (p != line_end && (*p != ';' || find_value_end(p, line_end) != line_end))
+    return bad;
+
+  position_ = line_end + 2 - begin;
+  remaining_ = length;
+  phase_ = (length == 0) ? trailer_phase : chunk_data_phase;
+  return indeterminate;
+}
+
+message_parser::result_type message_parser::parse_trailer(
+    char* begin, std::size_t size)
+{
+  // Trailer fields are discarded. The section ends with an empty line.
+  for (;;)
+  {
+    const void* nl = std::memchr(begin + position_, '\n', size - position_);
+    if (nl == 0)
+      return indeterminate;
+
+    std::size_t i = static_cast<const char*>(nl) - begin;
+    if (i == position_ || begin[i - 1] != '\r')
+      return bad;
+    bool empty_line = (i == position_ + 1);
+    position_ = i + 1;
+    if (empty_line)
+      return good;
+  }
+}
+
+} // namespace server
+} // namespace http
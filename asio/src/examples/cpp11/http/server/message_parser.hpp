@@ -0,0 +1,155 @@
+//
+// message_parser.hpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef HTTP_MESSAGE_PARSER_HPP
+#define HTTP_MESSAGE_PARSER_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "header.hpp"
+#include "string_view.hpp"
+
+namespace http {
+namespace server {
+
+/// Incremental, zero-copy parser for HTTP/1.1 messages.
+///
+/// Each call to parse is given all of the input received so far, starting at
+/// the first byte of the message. The parser resumes scanning where the
+/// previous call stopped, and records positions as offsets so that the input
+/// may be moved between calls (for example, when a dynamic buffer grows).
+/// Once a message is complete, the parsed strings refer directly into the
+/// input. A chunked body is decoded in place, so that the body is always a
+/// single contiguous range. Any bytes after the end of the message belong to
+/// the next pipelined message.
+class message_parser
+{
+public:
+  /// Reset to initial parser state.
+  void reset();
+
+  /// Result of parse.
+  enum result_type { good, bad, indeterminate };
+
+protected:
+  /// The kind of start line to expect.
+  enum message_kind { request_message, response_message };
+
+  /// Construct ready to parse a message of the given kind.
+  explicit message_parser(message_kind kind);
+
+  /// Parse some data. Returns good when a complete message has been parsed,
+  /// bad if the data is invalid, and indeterminate when more data is required.
+  /// The eof flag indicates that no more data will arrive, and completes a
+  /// response that is delimited by the closing of the connection. On good,
+  /// consumed is set to the length of the message. A call that follows a
+  /// result of good or bad starts a new message.
+  result_type parse_message(char* begin, char* end,
+      bool eof, std::size_t& consumed);
+
+  /// A range of the input, recorded as an offset from the start.
+  struct range
+  {
+    std::size_t offset;
+    std::size_t length;
+  };
+
+  /// Get a view of a range of the input.
+  static string_view view(const char* begin, const range& r)
+  {
+    return string_view(begin + r.offset, r.length);
+  }
+
+  /// Get views of the parsed header fields.
+  void get_headers(const char* begin,
+      std::vector<header_field>& headers) const;
+
+  /// The request method.
+  range method_;
+
+  /// The request target.
+  range target_;
+
+  /// The response reason phrase.
+  range reason_;
+
+  /// The HTTP version.
+  int version_major_;
+  int version_minor_;
+
+  /// The response status code.
+  int status_;
+
+  /// The message body, after any chunked encoding has been removed.
+  range body_;
+
+  /// Whether the connection may be used for further messages.
+  bool keep_alive_;
+
+private:
+  /// Parse the start line and header fields, and determine how the body is
+  /// delimited. The header block ends with an empty line.
+  bool parse_header_block(const char* begin,
+      std::size_t start, std::size_t end);
+
+  /// Parse the request line.
+  const char* parse_request_line(const char* begin,
+      const char* p, const char* end);
+
+  /// Parse the status line.
+  const char* parse_status_line(const char* begin,
+      const char* p, const char* end);
+
+  /// Interpret the header fields that determine how the message is framed.
+  bool parse_framing(const char* begin);
+
+  /// Parse a chunk-size line.
+  result_type parse_chunk_size(char* begin, std::size_t size);
+
+  /// Parse the trailer section that follows the last chunk.
+  result_type parse_trailer(char* begin, std::size_t size);
+
+  /// The kind of message being parsed.
+  message_kind kind_;
+
+  /// The current phase of the parser.
+  enum phase
+  {
+    header_phase,
+    body_phase,
+    chunk_size_phase,
+    chunk_data_phase,
+    chunk_crlf_phase,
+    trailer_phase,
+    eof_phase,
+    done_phase
+  } phase_;
+
+  /// Offset of the start line, after any leading empty lines.
+  std::size_t start_;
+
+  /// Offset of the next byte to be examined.
+  std::size_t position_;
+
+  /// Offset one past the end of the decoded body data.
+  std::size_t body_end_;
+
+  /// Bytes remaining in the body or in the current chunk.
+  std::size_t remaining_;
+
+  /// The parsed header fields.
+  std::vector<std::pair<range, range> > fields_;
+};
+
+} // namespace server
+} // namespace http
+
+#endif // HTTP_MESSAGE_PARSER_HPP
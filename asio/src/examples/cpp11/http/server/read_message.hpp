@@ -0,0 +1,120 @@
+//
+// read_message.hpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef HTTP_READ_MESSAGE_HPP
+#define HTTP_READ_MESSAGE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <asio.hpp>
+
+namespace http {
+namespace server {
+
+/// The implementation of async_read_message, as a state machine for use with
+/// asio::async_compose.
+template <typename AsyncReadStream, typename DynamicBuffer,
+    typename Parser, typename Message>
+struct read_message_implementation
+{
+  AsyncReadStream& stream_;
+  DynamicBuffer buffers_;
+  Parser& parser_;
+  Message& message_;
+  std::size_t bytes_to_read_;
+
+  template <typename Self>
+  void operator()(Self& self,
+      const std::error_code& error = std::error_code(),
+      std::size_t bytes_transferred = 0)
+  {
+    if (bytes_to_read_ != 0)
+    {
+      // Remove the part of the buffer that the read did not fill.
+      buffers_.shrink(bytes_to_read_ - bytes_transferred);
+      bytes_to_read_ = 0;
+      if (error)
+      {
+        self.complete(error, 0);
+        return;
+      }
+    }
+
+    // The parser is given the whole of the buffer each time, but resumes
+    // scanning where it stopped after the previous read. The buffer must be
+    // contiguous, as the parsed message refers into it.
+    std::size_t size = buffers_.size();
+    asio::mutable_buffer data = buffers_.data(0, size);
+    char* begin = static_cast<char*>(data.data());
+    typename Parser::result_type result;
+    char* message_end;
+    std::tie(result, message_end) =
+      parser_.parse(message_, begin, begin + size);
+
+    if (result == Parser::good)
+    {
+      self.complete(std::error_code(), message_end - begin);
+    }
+    else if (result == Parser::bad)
+    {
+      self.complete(std::make_error_code(std::errc::bad_message), 0);
+    }
+    else if (size >= buffers_.max_size())
+    {
+      self.complete(std::make_error_code(std::errc::message_size), 0);
+    }
+    else
+    {
+      // Read as much as the buffer's existing capacity allows, within limits.
+      bytes_to_read_ = std::min<std::size_t>(
+          std::max<std::size_t>(512, buffers_.capacity() - size),
+          std::min<std::size_t>(65536, buffers_.max_size() - size));
+      buffers_.grow(bytes_to_read_);
+      stream_.async_read_some(
+          buffers_.data(size, bytes_to_read_), std::move(self));
+    }
+  }
+};
+
+/// Start an asynchronous operation to read a complete HTTP message into a
+/// dynamic buffer. The buffer must provide contiguous storage, such as that
+/// returned by asio::dynamic_buffer for a std::string or std::vector<char>.
+///
+/// The buffer may already contain data, such as a pipelined message that was
+/// received with the previous one, and the operation completes without reading
+/// if that data holds a complete message. On success, the handler receives
+/// the length of the message, which should be consumed from the buffer once
+/// the message is no longer needed. The handler receives
+/// std::errc::bad_message if the message is invalid, and
+/// std::errc::message_size if the buffer's maximum size is reached first.
+template <typename AsyncReadStream, typename DynamicBuffer,
+    typename Parser, typename Message, typename ReadHandler>
+auto async_read_message(AsyncReadStream& stream, DynamicBuffer buffers,
+    Parser& parser, Message& message, ReadHandler&& handler)
+  -> typename asio::async_result<
+    typename std::decay<ReadHandler>::type,
+    void(std::error_code, std::size_t)>::return_type
+{
+  return asio::async_compose<
+    ReadHandler, void(std::error_code, std::size_t)>(
+      read_message_implementation<AsyncReadStream,
+        DynamicBuffer, Parser, Message>{
+          stream, std::move(buffers), parser, message, 0},
+      handler, stream);
+}
+
+} // namespace server
+} // namespace http
+
+#endif // HTTP_READ_MESSAGE_HPP
@@ -11,9 +11,11 @@
 #ifndef HTTP_REPLY_HPP
 #define HTTP_REPLY_HPP
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <asio.hpp>
+#include "file_cache.hpp"
 #include "header.hpp"
 
 namespace http {
@@ -49,9 +51,16 @@ struct reply
   /// The content to be sent in the reply.
   std::string content;
 
+  /// A file to be sent in place of the content. The file provides the status
+  /// line and its own headers, and the reply's headers follow them. The status
+  /// is either ok or not_modified.
+  std::shared_ptr<const static_file> file;
+
   /// Convert the reply into a vector of buffers. The buffers do not own the
   /// underlying memory blocks, therefore the reply object must remain valid and
-  /// not be changed until the write operation has completed.
+  /// not be changed until the write operation has completed. When the file's
+  /// content is not held in memory it is not included, and must be sent after
+  /// the buffers using the file's descriptor.
   std::vector<asio::const_buffer> to_buffers();
 
   /// Get a stock reply.
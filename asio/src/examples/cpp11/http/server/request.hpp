@@ -11,21 +11,26 @@
 #ifndef HTTP_REQUEST_HPP
 #define HTTP_REQUEST_HPP
 
-#include <string>
 #include <vector>
 #include "header.hpp"
+#include "string_view.hpp"
 
 namespace http {
 namespace server {
 
-/// A request received from a client.
+/// A request received from a client. The strings refer to the buffer that the
+/// request was parsed from, and are valid only until that buffer is modified.
 struct request
 {
-  std::string method;
-  std::string uri;
+  string_view method;
+  string_view uri;
   int http_version_major;
   int http_version_minor;
-  std::vector<header> headers;
+  std::vector<header_field> headers;
+  string_view body;
+
+  /// Whether the connection may be used for further requests.
+  bool keep_alive;
 };
 
 } // namespace server
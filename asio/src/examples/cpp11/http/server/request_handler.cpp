@@ -9,8 +9,8 @@
 //
 
 #include "request_handler.hpp"
-#include <fstream>
-#include <sstream>
+#include <algorithm>
+#include <cctype>
 #include <string>
 #include "mime_types.hpp"
 #include "reply.hpp"
@@ -19,8 +19,10 @@
 namespace http {
 namespace server {
 
-request_handler::request_handler(const std::string& doc_root)
-  : doc_root_(doc_root)
+request_handler::request_handler(const std::string& doc_root,
+    file_cache::send_mode mode)
+  : doc_root_(doc_root),
+    file_cache_(mode)
 {
 }
 
@@ -57,28 +59,62 @@ void request_handler::handle_request(const request& req, reply& rep)
     extension = request_path.substr(last_dot_pos + 1);
   }
 
-  // Open the file to send back.
+  // Open the file to send back. Small files are held in memory.
   std::string full_path = doc_root_ + request_path;
-  std::ifstream is(full_path.c_str(), std::ios::in | std::ios::binary);
-  if (!is)
+  rep.file = file_cache_.get(full_path,
+      mime_types::extension_to_type(extension));
+  if (!rep.file)
   {
     rep = reply::stock_reply(reply::not_found);
     return;
   }
 
-  // Fill out the reply to be sent to the client.
-  rep.status = reply::ok;
-  char buf[512];
-  while (is.read(buf, sizeof(buf)).gcount() > 0)
-    rep.content.append(buf, is.gcount());
-  rep.headers.resize(2);
-  rep.headers[0].name = "Content-Length";
-  rep.headers[0].value = std::to_string(rep.content.size());
-  rep.headers[1].name = "Content-Type";
-  rep.headers[1].value = mime_types::extension_to_type(extension);
+  // Fill out the reply to be sent to the client. The file provides the
+  // headers, and there is no content if the client's copy is up to date.
+  if (etag_matches(req, rep.file->etag()))
+    rep.status = reply::not_modified;
+  else
+    rep.status = reply::ok;
 }
 
-bool request_handler::url_decode(const std::string& in, std::string& out)
+bool request_handler::etag_matches(const request& req,
+    const std::string& etag)
+{
+  for (const header_field& h : req.headers)
+  {
+    if (h.name.size() != 13 || !std::equal(h.name.begin(), h.name.end(),
+          "if-none-match", [](char a, char b)
+          {
+            return std::tolower(static_cast<unsigned char>(a)) == b;
+          }))
+      continue;
+
+    // The value is "*" or a list of entity tags, which are compared without
+    // regard to any weakness indicator.
+    const char* p = h.value.data();
+    const char* const end = p + h.value.size();
+    while (p != end)
+    {
+      while (p != end && (*p == ' ' || *p == '\t' || *p == ','))
+        ++p;
+      const char* tag = p;
+      while (p != end && *p != ',')
+        ++p;
+      const char* tag_end = p;
+      while (tag_end != tag && (tag_end[-1] == ' ' || tag_end[-1] == '\t'))
+        --tag_end;
+      if (tag_end - tag > 2 && tag[0] == 'W' && tag[1] == '/')
+        tag += 2;
+      std::size_t length = tag_end - tag;
+      if ((length == 1 && *tag == '*') || (length == etag.size()
+            && std::equal(tag, tag_end, etag.begin())))
+        return true;
+    }
+  }
+  return false;
+}
+
+bool request_handler::url_decode(string_view in, std::string& out)
 {
   out.clear();
   out.reserve(in.size());
@@ -86,19 +122,13 @@ bool request_handler::url_decode(const std::string& in, std::string& out)
   {
     if (in[i] == '%')
     {
-      if (i + 3 <= in.size())
+      int high, low;
+      if (i + 3 <= in.size()
+          && (high = hex_value(in[i + 1])) >= 0
+          && (low = hex_value(in[i + 2])) >= 0)
       {
-        int value = 0;
-        std::istringstream is(in.substr(i + 1, 2));
-        if (is >> std::hex >> value)
-        {
-          out += static_cast<char>(value);
-          i += 2;
-        }
-        else
-        {
-          return false;
-        }
+        out += static_cast<char>(high * 16 + low);
+        i += 2;
       }
       else
       {
@@ -117,5 +147,16 @@ bool request_handler::url_decode(const std::string& in, std::string& out)
   return true;
 }
 
+int request_handler::hex_value(char c)
+{
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F')
+    return c - 'A' + 10;
+  return -1;
+}
+
 } // namespace server
 } // namespace http
@@ -12,6 +12,8 @@
 #define HTTP_REQUEST_HANDLER_HPP
 
 #include <string>
+#include "file_cache.hpp"
+#include "string_view.hpp"
 
 namespace http {
 namespace server {
@@ -26,8 +28,10 @@ public:
   request_handler(const request_handler&) = delete;
   request_handler& operator=(const request_handler&) = delete;
 
-  /// Construct with a directory containing files to be served.
-  explicit request_handler(const std::string& doc_root);
+  /// Construct with a directory containing files to be served, and the way in
+  /// which large files are to be sent.
+  explicit request_handler(const std::string& doc_root,
+      file_cache::send_mode mode = file_cache::use_sendfile);
 
   /// Handle a request and produce a reply.
   void handle_request(const request& req, reply& rep);
@@ -36,9 +40,19 @@ private:
   /// The directory containing the files to be served.
   std::string doc_root_;
 
+  /// The files that have been served.
+  file_cache file_cache_;
+
+  /// Determine whether a request's If-None-Match header matches an entity
+  /// tag, meaning that the client already has the file.
+  static bool etag_matches(const request& req, const std::string& etag);
+
   /// Perform URL-decoding on a string. Returns false if the encoding was
   /// invalid.
-  static bool url_decode(const std::string& in, std::string& out);
+  static bool url_decode(string_view in, std::string& out);
+
+  /// Get the value of a hexadecimal digit, or -1 if it is not one.
+  static int hex_value(char c);
 };
 
 } // namespace server
@@ -0,0 +1,39 @@
+//
+// response.hpp
+// ~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef HTTP_RESPONSE_HPP
+#define HTTP_RESPONSE_HPP
+
+#include <vector>
+#include "header.hpp"
+#include "string_view.hpp"
+
+namespace http {
+namespace server {
+
+/// A response received from a server. The strings refer to the buffer that the
+/// response was parsed from, and are valid only until that buffer is modified.
+struct response
+{
+  int http_version_major;
+  int http_version_minor;
+  int status;
+  string_view reason;
+  std::vector<header_field> headers;
+  string_view body;
+
+  /// Whether the connection may be used for further requests.
+  bool keep_alive;
+};
+
+} // namespace server
+} // namespace http
+
+#endif // HTTP_RESPONSE_HPP
@@ -0,0 +1,41 @@
+//
+// response_parser.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "response_parser.hpp"
+#include "response.hpp"
+
+namespace http {
+namespace server {
+
+response_parser::response_parser()
+  : message_parser(response_message)
+{
+}
+
+std::tuple<response_parser::result_type, char*> response_parser::parse(
+    response& rep, char* begin, char* end, bool eof)
+{
+  std::size_t consumed = 0;
+  result_type result = parse_message(begin, end, eof, consumed);
+  if (result == good)
+  {
+    rep.http_version_major = version_major_;
+    rep.http_version_minor = version_minor_;
+    rep.status = status_;
+    rep.reason = view(begin, reason_);
+    get_headers(begin, rep.headers);
+    rep.body = view(begin, body_);
+    rep.keep_alive = keep_alive_;
+  }
+  return std::make_tuple(result, begin + consumed);
+}
+
+} // namespace server
+} // namespace http
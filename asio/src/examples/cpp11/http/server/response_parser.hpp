@@ -0,0 +1,48 @@
+//
+// response_parser.hpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef HTTP_RESPONSE_PARSER_HPP
+#define HTTP_RESPONSE_PARSER_HPP
+
+#include <tuple>
+#include "message_parser.hpp"
+
+namespace http {
+namespace server {
+
+struct response;
+
+/// Parser for responses received from a server, such as when relaying
+/// requests to another server.
+class response_parser
+  : public message_parser
+{
+public:
+  /// Construct ready to parse the status line.
+  response_parser();
+
+  /// Parse some data. The enum return value is good when a complete response
+  /// has been parsed, bad if the data is invalid, indeterminate when more data
+  /// is required. The pointer return value indicates how much of the input has
+  /// been consumed.
+  ///
+  /// The input must begin with the response, and must include all of the data
+  /// passed to previous calls for the same response. Set eof when the
+  /// connection has been closed, to complete a response with no length. The
+  /// body of a response to a HEAD request is not delimited by its headers, so
+  /// such responses must be parsed by other means.
+  std::tuple<result_type, char*> parse(response& rep,
+      char* begin, char* end, bool eof = false);
+};
+
+} // namespace server
+} // namespace http
+
+#endif // HTTP_RESPONSE_PARSER_HPP
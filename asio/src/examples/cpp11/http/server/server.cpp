@@ -16,12 +16,12 @@ namespace http {
 namespace server {
 
 server::server(const std::string& address, const std::string& port,
-    const std::string& doc_root)
+    const std::string& doc_root, file_cache::send_mode mode)
   : io_context_(1),
     signals_(io_context_),
     acceptor_(io_context_),
     connection_manager_(),
-    request_handler_(doc_root)
+    request_handler_(doc_root, mode)
 {
   // Register to handle the signals that indicate when the server should exit.
   // It is safe to register for the same signal multiple times in a program,
@@ -30,7 +30,8 @@ public:
   /// Construct the server to listen on the specified TCP address and port, and
   /// serve up files from the given directory.
   explicit server(const std::string& address, const std::string& port,
-      const std::string& doc_root);
+      const std::string& doc_root,
+      file_cache::send_mode mode = file_cache::use_sendfile);
 
   /// Run the server's io_context loop.
   void run();
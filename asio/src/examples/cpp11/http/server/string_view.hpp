@@ -0,0 +1,96 @@
+//
+// string_view.hpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef HTTP_STRING_VIEW_HPP
+#define HTTP_STRING_VIEW_HPP
+
+#include <asio/detail/config.hpp>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+#if defined(ASIO_HAS_STRING_VIEW)
+# include <asio/detail/string_view.hpp>
+#endif // defined(ASIO_HAS_STRING_VIEW)
+
+namespace http {
+namespace server {
+
+#if defined(ASIO_HAS_STRING_VIEW)
+
+using asio::string_view;
+
+#else // defined(ASIO_HAS_STRING_VIEW)
+
+/// A non-owning reference to a sequence of characters, for use when the
+/// standard library does not provide one.
+class string_view
+{
+public:
+  typedef const char* const_iterator;
+
+  string_view()
+    : data_(0),
+      size_(0)
+  {
+  }
+
+  string_view(const char* data, std::size_t size)
+    : data_(data),
+      size_(size)
+  {
+  }
+
+  string_view(const char* s)
+    : data_(s),
+      size_(std::strlen(s))
+  {
+  }
+
+  string_view(const std::string& s)
+    : data_(s.data()),
+      size_(s.size())
+  {
+  }
+
+  const char* data() const { return data_; }
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  const_iterator begin() const { return data_; }
+  const_iterator end() const { return data_ + size_; }
+  char operator[](std::size_t i) const { return data_[i]; }
+
+  explicit operator std::string() const
+  {
+    return std::string(data_, size_);
+  }
+
+  friend bool operator==(const string_view& a, const string_view& b)
+  {
+    return a.size_ == b.size_
+      && (a.size_ == 0 || std::memcmp(a.data_, b.data_, a.size_) == 0);
+  }
+
+  friend bool operator!=(const string_view& a, const string_view& b)
+  {
+    return !(a == b);
+  }
+
+private:
+  const char* data_;
+  std::size_t size_;
+};
+
+#endif // defined(ASIO_HAS_STRING_VIEW)
+
+} // namespace server
+} // namespace http
+
+#endif // HTTP_STRING_VIEW_HPP
@@ -0,0 +1,75 @@
+//
+// fanout_receiver.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <iostream>
+#include <string>
+#include "asio.hpp"
+#include "group_receiver.hpp"
+
+constexpr short multicast_port = 30001;
+
+int main(int argc, char* argv[])
+{
+  try
+  {
+    if (argc < 3)
+    {
+      std::cerr << "Usage: fanout_receiver <listen_address>"
+        " <multicast_address> [<multicast_address> ...]\n";
+      std::cerr << "  For IPv4, try:\n";
+      std::cerr << "    fanout_receiver 0.0.0.0 239.255.0.1 239.255.0.2\n";
+      std::cerr << "  For IPv6, try:\n";
+      std::cerr << "    fanout_receiver 0::0 ff31::8000:1234 ff31::8000:1235\n";
+      return 1;
+    }
+
+    asio::io_context io_context;
+    multicast::group_receiver receiver(io_context,
+        asio::ip::udp::endpoint(
+          asio::ip::make_address(argv[1]), multicast_port));
+
+    // Receive every group on the one socket, printing each message with the
+    // group to which it was sent.
+    for (int i = 2; i < argc; ++i)
+    {
+      std::string group = argv[i];
+      receiver.join(asio::ip::make_address(group),
+          [group](const asio::ip::udp::endpoint&, asio::const_buffer data)
+          {
+            std::cout << group << ": ";
+            std::cout.write(static_cast<const char*>(data.data()), data.size());
+            std::cout << std::endl;
+          });
+    }
+
+    receiver.start();
+
+    // Stop on Ctrl-C and show how many wakeups and receive calls the
+    // datagrams needed.
+    asio::signal_set signals(io_context, SIGINT, SIGTERM);
+    signals.async_wait(
+        [&receiver](std::error_code, int)
+        {
+          receiver.stop();
+        });
+
+    io_context.run();
+
+    std::cout << receiver.datagrams() << " datagrams, "
+      << receiver.wakeups() << " wakeups, "
+      << receiver.receive_calls() << " receive calls\n";
+  }
+  catch (std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << "\n";
+  }
+
+  return 0;
+}
@@ -0,0 +1,258 @@
+//
+// group_receiver.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "group_receiver.hpp"
+#include <cstring>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#if !defined(IPV6_RECVPKTINFO)
+# define IPV6_RECVPKTINFO IPV6_PKTINFO
+#endif // !defined(IPV6_RECVPKTINFO)
+
+namespace multicast {
+
+namespace {
+
+// A socket option that asks for the destination address of each datagram to
+// be delivered as a control message.
+class receive_destination
+{
+public:
+  explicit receive_destination(bool enabled)
+    : value_(enabled ? 1 : 0)
+  {
+  }
+
+  template <typename Protocol>
+  int level(const Protocol& protocol) const
+  {
+    return protocol.family() == AF_INET6 ? IPPROTO_IPV6 : IPPROTO_IP;
+  }
+
+  template <typename Protocol>
+  int name(const Protocol& protocol) const
+  {
+#if defined(IP_PKTINFO)
+    return protocol.family() == AF_INET6 ? IPV6_RECVPKTINFO : IP_PKTINFO;
+#else // defined(IP_PKTINFO)
+    return protocol.family() == AF_INET6 ? IPV6_RECVPKTINFO : IP_RECVDSTADDR;
+#endif // defined(IP_PKTINFO)
+  }
+
+  template <typename Protocol>
+  const int* data(const Protocol&) const
+  {
+    return &value_;
+  }
+
+  template <typename Protocol>
+  std::size_t size(const Protocol&) const
+  {
+    return sizeof(value_);
+  }
+
+private:
+  int value_;
+};
+
+// The space for the control messages of one datagram, which is enough for
+// either kind of packet information.
+const std::size_t control_size = CMSG_SPACE(sizeof(in6_pktinfo));
+
+} // namespace
+
+group_receiver::group_receiver(asio::io_context& io_context,
+    const asio::ip::udp::endpoint& listen_endpoint,
+    std::size_t batch_size, std::size_t max_datagram_size)
+  : socket_(io_context),
+    batch_size_(batch_size ? batch_size : 1),
+    max_datagram_size_(max_datagram_size),
+    data_(batch_size_ * max_datagram_size_),
+    senders_(batch_size_),
+    control_(batch_size_ * control_size),
+    messages_(batch_size_),
+    buffers_(batch_size_),
+    wakeups_(0),
+    receive_calls_(0),
+    datagrams_(0)
+{
+  // Create the socket so that multiple may be bound to the same address.
+  socket_.open(listen_endpoint.protocol());
+  socket_.set_option(asio::ip::udp::socket::reuse_address(true));
+  socket_.set_option(receive_destination(true));
+  socket_.bind(listen_endpoint);
+
+  // Datagrams are read directly from the socket until none remain.
+  socket_.non_blocking(true);
+}
+
+void group_receiver::join(const asio::ip::address& group, handler h)
+{
+  if (group.is_multicast() && handlers_.count(group) == 0)
+    socket_.set_option(asio::ip::multicast::join_group(group));
+  handlers_[group] = std::move(h);
+}
+
+void group_receiver::leave(const asio::ip::address& group)
+{
+  if (handlers_.erase(group) && group.is_multicast())
+    socket_.set_option(asio::ip::multicast::leave_group(group));
+}
+
+void group_receiver::start()
+{
+  do_wait();
+}
+
+void group_receiver::stop()
+{
+  socket_.close();
+}
+
+void group_receiver::do_wait()
+{
+  socket_.async_wait(asio::ip::udp::socket::wait_read,
+      [this](std::error_code ec)
+      {
+        if (!ec)
+        {
+          ++wakeups_;
+          do_receive();
+        }
+      });
+}
+
+void group_receiver::do_receive()
+{
+  if (receive_batch() == batch_size_)
+  {
+    // More datagrams may be waiting, but the socket will not be reported as
+    // readable again until another arrives. Carry on reading once any other
+    // ready handlers have run.
+    asio::post(socket_.get_executor(),
+        [this]
+        {
+          if (socket_.is_open())
+            do_receive();
+        });
+  }
+  else if (socket_.is_open())
+  {
+    do_wait();
+  }
+}
+
+std::size_t group_receiver::receive_batch()
+{
+#if defined(MULTICAST_HAS_RECVMMSG)
+  for (std::size_t i = 0; i < batch_size_; ++i)
+    prepare(i);
+
+  ++receive_calls_;
+  int result = ::recvmmsg(socket_.native_handle(),
+      messages_.data(), static_cast<unsigned int>(batch_size_), 0, 0);
+  if (result <= 0)
+    return 0;
+
+  std::size_t count = static_cast<std::size_t>(result);
+  for (std::size_t i = 0; i < count && socket_.is_open(); ++i)
+    dispatch(i, messages_[i].msg_len);
+  return count;
+#else // defined(MULTICAST_HAS_RECVMMSG)
+  std::size_t count = 0;
+  while (count < batch_size_ && socket_.is_open())
+  {
+    ++receive_calls_;
+    ssize_t result = ::recvmsg(socket_.native_handle(), &prepare(count), 0);
+    if (result < 0)
+      break;
+    dispatch(count++, static_cast<std::size_t>(result));
+  }
+  return count;
+#endif // defined(MULTICAST_HAS_RECVMMSG)
+}
+
+msghdr& group_receiver::prepare(std::size_t index)
+{
+#if defined(MULTICAST_HAS_RECVMMSG)
+  msghdr& msg = messages_[index].msg_hdr;
+#else // defined(MULTICAST_HAS_RECVMMSG)
+  msghdr& msg = messages_[index];
+#endif // defined(MULTICAST_HAS_RECVMMSG)
+
+  buffers_[index].iov_base = &data_[index * max_datagram_size_];
+  buffers_[index].iov_len = max_datagram_size_;
+
+  std::memset(&msg, 0, sizeof(msg));
+  msg.msg_name = senders_[index].data();
+  msg.msg_namelen = static_cast<socklen_t>(senders_[index].capacity());
+  msg.msg_iov = &buffers_[index];
+  msg.msg_iovlen = 1;
+  msg.msg_control = &control_[index * control_size];
+  msg.msg_controllen = control_size;
+  return msg;
+}
+
+void group_receiver::dispatch(std::size_t index, std::size_t length)
+{
+#if defined(MULTICAST_HAS_RECVMMSG)
+  msghdr& msg = messages_[index].msg_hdr;
+#else // defined(MULTICAST_HAS_RECVMMSG)
+  msghdr& msg = messages_[index];
+#endif // defined(MULTICAST_HAS_RECVMMSG)
+
+  ++datagrams_;
+
+  // Discard datagrams that did not fit in the buffer.
+  if (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC))
+    return;
+
+  // Find the address to which the datagram was sent.
+  asio::ip::address destination;
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg;
+      cmsg = CMSG_NXTHDR(&msg, cmsg))
+  {
+#if defined(IP_PKTINFO)
+    if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_PKTINFO)
+    {
+      in_pktinfo info;
+      std::memcpy(&info, CMSG_DATA(cmsg), sizeof(info));
+      destination = asio::ip::address_v4(ntohl(info.ipi_addr.s_addr));
+    }
+#else // defined(IP_PKTINFO)
+    if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_RECVDSTADDR)
+    {
+      in_addr addr;
+      std::memcpy(&addr, CMSG_DATA(cmsg), sizeof(addr));
+      destination = asio::ip::address_v4(ntohl(addr.s_addr));
+    }
+#endif // defined(IP_PKTINFO)
+    else if (cmsg->cmsg_level == IPPROTO_IPV6
+        && cmsg->cmsg_type == IPV6_PKTINFO)
+    {
+      in6_pktinfo info;
+      std::memcpy(&info, CMSG_DATA(cmsg), sizeof(info));
+      asio::ip::address_v6::bytes_type bytes;
+      std::memcpy(bytes.data(), &info.ipi6_addr, bytes.size());
+      destination = asio::ip::address_v6(bytes);
+    }
+  }
+
+  auto iter = handlers_.find(destination);
+  if (iter != handlers_.end())
+  {
+    senders_[index].resize(msg.msg_namelen);
+    iter->second(senders_[index],
+        asio::buffer(&data_[index * max_datagram_size_], length));
+  }
+}
+
+} // namespace multicast
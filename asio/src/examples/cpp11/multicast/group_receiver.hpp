@@ -0,0 +1,119 @@
+//
+// group_receiver.hpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MULTICAST_GROUP_RECEIVER_HPP
+#define MULTICAST_GROUP_RECEIVER_HPP
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <vector>
+#include <sys/uio.h>
+#include "asio.hpp"
+
+#if defined(__linux__)
+# define MULTICAST_HAS_RECVMMSG 1
+#endif // defined(__linux__)
+
+namespace multicast {
+
+/// Receives datagrams for many multicast groups on a single socket.
+/**
+ * The socket asks for the destination address of each datagram, using
+ * IP_PKTINFO or IPV6_PKTINFO, and passes the datagram to the handler for that
+ * group. Datagrams for groups without a handler are discarded.
+ *
+ * Rather than starting an asynchronous receive for each datagram, the
+ * receiver waits for the socket to become readable and then reads up to a
+ * batch of datagrams, using recvmmsg where it is available. The counters
+ * show how many wakeups and receive calls were needed.
+ */
+class group_receiver
+{
+public:
+  /// The handler for a group's datagrams. The data is valid only for the
+  /// duration of the call.
+  typedef std::function<void(const asio::ip::udp::endpoint& sender,
+      asio::const_buffer data)> handler;
+
+  /// Open a socket bound to the given endpoint, which is usually the wildcard
+  /// address and the groups' port.
+  group_receiver(asio::io_context& io_context,
+      const asio::ip::udp::endpoint& listen_endpoint,
+      std::size_t batch_size = 32,
+      std::size_t max_datagram_size = 1500);
+
+  group_receiver(const group_receiver&) = delete;
+  group_receiver& operator=(const group_receiver&) = delete;
+
+  /// Pass datagrams sent to the given address to a handler. If the address is
+  /// a multicast group, the socket joins it.
+  void join(const asio::ip::address& group, handler h);
+
+  /// Stop passing datagrams sent to the given address to its handler. If the
+  /// address is a multicast group, the socket leaves it. Must not be called
+  /// from within that address's handler.
+  void leave(const asio::ip::address& group);
+
+  /// Get the endpoint to which the socket is bound.
+  asio::ip::udp::endpoint local_endpoint() const
+  {
+    return socket_.local_endpoint();
+  }
+
+  /// Start receiving datagrams.
+  void start();
+
+  /// Stop receiving datagrams and close the socket.
+  void stop();
+
+  /// The number of times the socket was found to be readable.
+  std::size_t wakeups() const { return wakeups_; }
+
+  /// The number of calls made to receive datagrams.
+  std::size_t receive_calls() const { return receive_calls_; }
+
+  /// The number of datagrams received.
+  std::size_t datagrams() const { return datagrams_; }
+
+private:
+  void do_wait();
+  void do_receive();
+  std::size_t receive_batch();
+  msghdr& prepare(std::size_t index);
+  void dispatch(std::size_t index, std::size_t length);
+
+  asio::ip::udp::socket socket_;
+  std::map<asio::ip::address, handler> handlers_;
+  std::size_t batch_size_;
+  std::size_t max_datagram_size_;
+
+  /// The storage for a batch of datagrams, their senders' addresses and their
+  /// control messages.
+  std::vector<char> data_;
+  std::vector<asio::ip::udp::endpoint> senders_;
+  std::vector<char> control_;
+
+  /// The message headers for a batch.
+#if defined(MULTICAST_HAS_RECVMMSG)
+  std::vector<mmsghdr> messages_;
+#else // defined(MULTICAST_HAS_RECVMMSG)
+  std::vector<msghdr> messages_;
+#endif // defined(MULTICAST_HAS_RECVMMSG)
+  std::vector<iovec> buffers_;
+
+  std::size_t wakeups_;
+  std::size_t receive_calls_;
+  std::size_t datagrams_;
+};
+
+} // namespace multicast
+
+#endif // MULTICAST_GROUP_RECEIVER_HPP
@@ -0,0 +1,234 @@
+//
+// relay.hpp
+// ~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef RELAY_HPP
+#define RELAY_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <asio.hpp>
+
+namespace socks4 {
+
+/// Relays data in both directions between two connected stream sockets, as a
+/// proxy does once its handshake is complete.
+/**
+ * Each direction reads from one socket and writes to the other, and does not
+ * read again until the write completes, so a slow reader holds back its
+ * writer rather than causing data to be buffered. When one peer shuts down
+ * its side of the connection, the relay shuts down the sending side of the
+ * other socket and carries on relaying in the opposite direction. The relay
+ * completes once both directions have reached end of file, or as soon as
+ * either fails, in which case both sockets are closed.
+ *
+ * In copy mode, each direction reads into its own buffer. The buffer starts
+ * small and doubles whenever a read fills it, up to the maximum size, so that
+ * idle connections stay cheap while busy ones move data in large blocks. It
+ * shrinks again after a run of small reads. In zero-copy mode, each direction
+ * uses asio::async_transfer, which on Linux moves the data with splice
+ * through a pipe without copying it into user space. Elsewhere, zero-copy
+ * mode behaves as copy mode.
+ */
+template <typename Socket>
+class relay
+  : public std::enable_shared_from_this<relay<Socket>>
+{
+public:
+  /// How data is moved between the sockets.
+  enum mode_type { copy, zero_copy };
+
+  /// The handler called when the relay completes. It is passed the first
+  /// error that occurred, if any.
+  typedef std::function<void(std::error_code)> handler_type;
+
+  /// Construct a relay between two connected sockets.
+  relay(Socket first, Socket second, mode_type mode = zero_copy,
+      std::size_t min_buffer_size = 4096,
+      std::size_t max_buffer_size = 256 * 1024)
+    : first_(std::move(first)),
+      second_(std::move(second)),
+      mode_(mode),
+      min_buffer_size_(min_buffer_size),
+      max_buffer_size_(max_buffer_size),
+      upstream_(first_, second_, min_buffer_size),
+      downstream_(second_, first_, min_buffer_size)
+  {
+  }
+
+  /// Start relaying in both directions.
+  void start(handler_type handler = handler_type())
+  {
+    handler_ = std::move(handler);
+    start(upstream_);
+    start(downstream_);
+  }
+
+  /// The number of bytes relayed from the first socket to the second.
+  std::size_t bytes_upstream() const
+  {
+    return upstream_.bytes;
+  }
+
+  /// The number of bytes relayed from the second socket to the first.
+  std::size_t bytes_downstream() const
+  {
+    return downstream_.bytes;
+  }
+
+private:
+  // The state of one direction of the relay.
+  struct direction
+  {
+    direction(Socket& f, Socket& t, std::size_t buffer_size)
+      : from(f),
+        to(t),
+        buffer(buffer_size),
+        small_reads(0),
+        bytes(0),
+        done(false)
+    {
+    }
+
+    Socket& from;
+    Socket& to;
+    std::vector<char> buffer;
+    std::size_t small_reads;
+    std::size_t bytes;
+    bool done;
+  };
+
+  void start(direction& d)
+  {
+#if defined(ASIO_HAS_SPLICE)
+    if (mode_ == zero_copy)
+    {
+      do_transfer(d);
+      return;
+    }
+#endif // defined(ASIO_HAS_SPLICE)
+
+    do_read(d);
+  }
+
+  void do_transfer(direction& d)
+  {
+    auto self(this->shared_from_this());
+    asio::async_transfer(d.from, d.to,
+        [this, self, &d](std::error_code ec, std::size_t length)
+        {
+          d.bytes += length;
+          finish(d, ec);
+        });
+  }
+
+  void do_read(direction& d)
+  {
+    auto self(this->shared_from_this());
+    d.from.async_read_some(asio::buffer(d.buffer),
+        [this, self, &d](std::error_code ec, std::size_t length)
+        {
+          if (!ec)
+          {
+            do_write(d, length);
+          }
+          else
+          {
+            finish(d, ec);
+          }
+        });
+  }
+
+  void do_write(direction& d, std::size_t length)
+  {
+    auto self(this->shared_from_this());
+    asio::async_write(d.to, asio::buffer(d.buffer, length),
+        [this, self, &d](std::error_code ec, std::size_t length)
+        {
+          if (!ec)
+          {
+            d.bytes += length;
+            resize_buffer(d, length);
+            do_read(d);
+          }
+          else
+          {
+            finish(d, ec);
+          }
+        });
+  }
+
+  // Grow the buffer when a read fills it, and shrink it after a run of reads
+  // that use less than a quarter of it.
+  void resize_buffer(direction& d, std::size_t length)
+  {
+    std::size_t size = d.buffer.size();
+    if (length == size && size < max_buffer_size_)
+    {
+      d.small_reads = 0;
+      std::vector<char>((std::min)(size * 2, max_buffer_size_)).swap(d.buffer);
+    }
+    else if (length < size / 4 && size > min_buffer_size_)
+    {
+      if (++d.small_reads == 16)
+      {
+        d.small_reads = 0;
+        std::vector<char>((std::max)(size / 2, min_buffer_size_)).swap(d.buffer);
+      }
+    }
+    else
+    {
+      d.small_reads = 0;
+    }
+  }
+
+  void finish(direction& d, std::error_code ec)
+  {
+    d.done = true;
+
+    if (ec == asio::error::eof)
+    {
+      // Pass the half close on to the other peer.
+      std::error_code ignored_ec;
+      d.to.shutdown(Socket::shutdown_send, ignored_ec);
+    }
+    else if (!error_)
+    {
+      // Stop relaying in both directions.
+      error_ = ec;
+      std::error_code ignored_ec;
+      first_.close(ignored_ec);
+      second_.close(ignored_ec);
+    }
+
+    if (upstream_.done && downstream_.done && handler_)
+    {
+      handler_type handler(std::move(handler_));
+      handler(error_);
+    }
+  }
+
+  Socket first_;
+  Socket second_;
+  mode_type mode_;
+  std::size_t min_buffer_size_;
+  std::size_t max_buffer_size_;
+  direction upstream_;
+  direction downstream_;
+  std::error_code error_;
+  handler_type handler_;
+};
+
+} // namespace socks4
+
+#endif // RELAY_HPP
@@ -0,0 +1,107 @@
+//
+// relay_server.cpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <asio.hpp>
+#include "relay.hpp"
+
+using asio::ip::tcp;
+
+typedef socks4::relay<tcp::socket> tcp_relay;
+
+// Accepts connections and relays each of them to the target.
+class relay_server
+{
+public:
+  relay_server(asio::io_context& io_context, unsigned short port,
+      const tcp::resolver::results_type& target, tcp_relay::mode_type mode)
+    : acceptor_(io_context, tcp::endpoint(tcp::v4(), port)),
+      target_(target),
+      mode_(mode)
+  {
+    do_accept();
+  }
+
+private:
+  void do_accept()
+  {
+    acceptor_.async_accept(
+        [this](std::error_code ec, tcp::socket socket)
+        {
+          if (!ec)
+          {
+            do_connect(std::make_shared<tcp::socket>(std::move(socket)));
+          }
+
+          do_accept();
+        });
+  }
+
+  void do_connect(std::shared_ptr<tcp::socket> client)
+  {
+    auto server = std::make_shared<tcp::socket>(acceptor_.get_executor());
+    asio::async_connect(*server, target_,
+        [this, client, server](std::error_code ec, const tcp::endpoint&)
+        {
+          if (!ec)
+          {
+            std::make_shared<tcp_relay>(std::move(*client),
+                std::move(*server), mode_)->start(
+                  [](std::error_code ec)
+                  {
+                    if (ec)
+                      std::cerr << "Relay error: " << ec.message() << "\n";
+                  });
+          }
+        });
+  }
+
+  tcp::acceptor acceptor_;
+  tcp::resolver::results_type target_;
+  tcp_relay::mode_type mode_;
+};
+
+int main(int argc, char* argv[])
+{
+  try
+  {
+    if (argc != 4 && argc != 5)
+    {
+      std::cerr << "Usage: relay_server <port> <host> <service> [copy]\n";
+      std::cerr << "Example:\n";
+      std::cerr << "  relay_server 8080 www.boost.org http\n";
+      return 1;
+    }
+
+    asio::io_context io_context;
+
+    tcp::resolver resolver(io_context);
+    auto target = resolver.resolve(argv[2], argv[3]);
+
+    // Splice the data between the sockets unless copying was requested.
+    tcp_relay::mode_type mode = tcp_relay::zero_copy;
+    if (argc == 5 && std::strcmp(argv[4], "copy") == 0)
+      mode = tcp_relay::copy;
+
+    relay_server server(io_context, std::atoi(argv[1]), target, mode);
+
+    io_context.run();
+  }
+  catch (std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << "\n";
+  }
+
+  return 0;
+}
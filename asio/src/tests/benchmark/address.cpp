@@ -0,0 +1,208 @@
+//
+// address.cpp
+// ~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <asio/detail/socket_ops.hpp>
+#include <asio/ip/address.hpp>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "harness.hpp"
+
+namespace {
+
+// The number of distinct addresses converted in each benchmark.
+const std::size_t address_count = 1024;
+
+std::vector<asio::ip::address_v4> make_v4_addresses()
+{
+  std::vector<asio::ip::address_v4> addresses;
+  asio::ip::address_v4::uint_type value = 0x12345678;
+  for (std::size_t i = 0; i < address_count; ++i)
+  {
+    value = value * 1103515245 + 12345;
+    addresses.push_back(asio::ip::address_v4(value));
+  }
+  return addresses;
+}
+
+std::vector<asio::ip::address_v6> make_v6_addresses()
+{
+  std::vector<asio::ip::address_v6> addresses;
+  unsigned long value = 0x12345678;
+  for (std::size_t i = 0; i < address_count; ++i)
+  {
+    asio::ip::address_v6::bytes_type bytes = {{ 0x20, 0x01, 0x0d, 0xb8 }};
+    for (int j = 8; j < 16; ++j)
+    {
+      value = value * 1103515245 + 12345;
+      bytes[j] = static_cast<unsigned char>(value >> 16);
+    }
+    addresses.push_back(asio::ip::address_v6(bytes));
+  }
+  return addresses;
+}
+
+template <typename Address>
+std::vector<std::string> to_strings(const std::vector<Address>& addresses)
+{
+  std::vector<std::string> strings;
+  for (std::size_t i = 0; i < addresses.size(); ++i)
+    strings.push_back(addresses[i].to_string());
+  return strings;
+}
+
+// Prevents the compiler from discarding the results of a conversion.
+std::size_t sink;
+
+template <typename Address>
+void format_to_string(benchmark::state& s,
+    const std::vector<Address>& addresses)
+{
+  s.start();
+  for (std::size_t i = 0; i < s.iterations(); ++i)
+    sink += addresses[i % address_count].to_string().size();
+  s.stop();
+}
+
+// Formats addresses as address_v4::to_string() did before to_chars() was
+// added.
+void format_inet_ntop(benchmark::state& s,
+    const std::vector<asio::ip::address_v4>& addresses)
+{
+  char buf[asio::detail::max_addr_v4_str_len];
+  asio::error_code ec;
+  s.start();
+  for (std::size_t i = 0; i < s.iterations(); ++i)
+  {
+    asio::ip::address_v4::bytes_type bytes =
+      addresses[i % address_count].to_bytes();
+    sink += std::string(asio::detail::socket_ops::inet_ntop(
+          ASIO_OS_DEF(AF_INET), &bytes[0], buf, sizeof(buf), 0, ec)).size();
+  }
+  s.stop();
+}
+
+template <typename Address>
+void format_to_chars(benchmark::state& s,
+    const std::vector<Address>& addresses)
+{
+  char buf[Address::max_chars];
+  s.start();
+  for (std::size_t i = 0; i < s.iterations(); ++i)
+  {
+    const Address& addr = addresses[i % address_count];
+    sink += addr.to_chars(buf, buf + sizeof(buf)) - buf;
+  }
+  s.stop();
+}
+
+template <typename Parse>
+void parse_c_str(benchmark::state& s,
+    const std::vector<std::string>& strings, Parse parse)
+{
+  asio::error_code ec;
+  s.start();
+  for (std::size_t i = 0; i < s.iterations(); ++i)
+    sink += parse(strings[i % address_count].c_str(), ec).is_loopback();
+  s.stop();
+}
+
+template <typename Parse>
+void parse_range(benchmark::state& s,
+    const std::vector<std::string>& strings, Parse parse)
+{
+  asio::error_code ec;
+  s.start();
+  for (std::size_t i = 0; i < s.iterations(); ++i)
+  {
+    const std::string& str = strings[i % address_count];
+    sink += parse(str.data(), str.data() + str.size(), ec).is_loopback();
+  }
+  s.stop();
+}
+
+asio::ip::address_v4 v4_from_c_str(const char* str, asio::error_code& ec)
+{
+  return asio::ip::make_address_v4(str, ec);
+}
+
+asio::ip::address_v4 v4_from_range(const char* first,
+    const char* last, asio::error_code& ec)
+{
+  return asio::ip::make_address_v4(first, last, ec);
+}
+
+asio::ip::address_v6 v6_from_c_str(const char* str, asio::error_code& ec)
+{
+  return asio::ip::make_address_v6(str, ec);
+}
+
+asio::ip::address_v6 v6_from_range(const char* first,
+    const char* last, asio::error_code& ec)
+{
+  return asio::ip::make_address_v6(first, last, ec);
+}
+
+void address_v4_inet_ntop(benchmark::state& s)
+{
+  format_inet_ntop(s, make_v4_addresses());
+}
+
+void address_v4_to_string(benchmark::state& s)
+{
+  format_to_string(s, make_v4_addresses());
+}
+
+void address_v4_to_chars(benchmark::state& s)
+{
+  format_to_chars(s, make_v4_addresses());
+}
+
+void address_v6_to_string(benchmark::state& s)
+{
+  format_to_string(s, make_v6_addresses());
+}
+
+void address_v6_to_chars(benchmark::state& s)
+{
+  format_to_chars(s, make_v6_addresses());
+}
+
+void make_address_v4_c_str(benchmark::state& s)
+{
+  parse_c_str(s, to_strings(make_v4_addresses()), v4_from_c_str);
+}
+
+void make_address_v4_range(benchmark::state& s)
+{
+  parse_range(s, to_strings(make_v4_addresses()), v4_from_range);
+}
+
+void make_address_v6_c_str(benchmark::state& s)
+{
+  parse_c_str(s, to_strings(make_v6_addresses()), v6_from_c_str);
+}
+
+void make_address_v6_range(benchmark::state& s)
+{
+  parse_range(s, to_strings(make_v6_addresses()), v6_from_range);
+}
+
+} // namespace
+
+BENCHMARK("address_v4_inet_ntop", address_v4_inet_ntop, 2000000)
+BENCHMARK("address_v4_to_string", address_v4_to_string, 2000000)
+BENCHMARK("address_v4_to_chars", address_v4_to_chars, 2000000)
+BENCHMARK("address_v6_to_string", address_v6_to_string, 1000000)
+BENCHMARK("address_v6_to_chars", address_v6_to_chars, 1000000)
+BENCHMARK("make_address_v4_c_str", make_address_v4_c_str, 2000000)
+BENCHMARK("make_address_v4_range", make_address_v4_range, 2000000)
+BENCHMARK("make_address_v6_c_str", make_address_v6_c_str, 1000000)
+BENCHMARK("make_address_v6_range", make_address_v6_range, 1000000)
@@ -0,0 +1,216 @@
+//
+// bulk_transfer.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <asio/completion_condition.hpp>
+#include <asio/detail/thread.hpp>
+#include <asio/io_context.hpp>
+#include <asio/ip/tcp.hpp>
+#include <asio/read.hpp>
+#include <asio/write.hpp>
+#include <boost/bind.hpp>
+#include <stdexcept>
+#include <vector>
+#include "harness.hpp"
+
+using asio::ip::tcp;
+
+namespace {
+
+// The size of each buffer passed to async_write or async_read.
+const std::size_t block_size = 16 * 1024 * 1024;
+
+// Read and discard everything received.
+void sink(tcp::socket* socket)
+{
+  std::vector<char> data(block_size);
+  asio::error_code ec;
+  while (!ec)
+    socket->read_some(asio::buffer(data), ec);
+}
+
+// Write the given number of blocks and then shut down the sending side.
+void source(tcp::socket* socket, std::size_t blocks)
+{
+  std::vector<char> data(block_size, 'x');
+  asio::error_code ec;
+  for (std::size_t i = 0; i < blocks && !ec; ++i)
+    asio::write(*socket, asio::buffer(data), ec);
+  socket->shutdown(tcp::socket::shutdown_send, ec);
+}
+
+// Performs a sequence of composed operations on a socket, each transferring a
+// whole block, with a completion condition made by the given factory.
+template <typename Factory>
+class transfer_loop
+{
+public:
+  transfer_loop(tcp::socket& socket, std::size_t blocks, Factory factory)
+    : socket_(socket),
+      data_(block_size, 'x'),
+      blocks_(blocks),
+      factory_(factory),
+      bytes_transferred_(0)
+  {
+  }
+
+  void start_write()
+  {
+    if (blocks_-- > 0)
+    {
+      asio::async_write(socket_, asio::buffer(data_), factory_(socket_),
+          boost::bind(&transfer_loop::handle_write, this, _1, _2));
+    }
+    else
+    {
+      socket_.shutdown(tcp::socket::shutdown_send);
+    }
+  }
+
+  void start_read()
+  {
+    if (blocks_-- > 0)
+    {
+      asio::async_read(socket_, asio::buffer(data_), factory_(socket_),
+          boost::bind(&transfer_loop::handle_read, this, _1, _2));
+    }
+  }
+
+  std::size_t bytes_transferred() const
+  {
+    return bytes_transferred_;
+  }
+
+private:
+  void handle_write(const asio::error_code& ec, std::size_t n)
+  {
+    bytes_transferred_ += n;
+    if (!ec)
+      start_write();
+  }
+
+  void handle_read(const asio::error_code& ec, std::size_t n)
+  {
+    bytes_transferred_ += n;
+    if (!ec)
+      start_read();
+  }
+
+  tcp::socket& socket_;
+  std::vector<char> data_;
+  std::size_t blocks_;
+  Factory factory_;
+  std::size_t bytes_transferred_;
+};
+
+struct fixed_factory
+{
+  asio::detail::transfer_all_t operator()(tcp::socket&) const
+  {
+    return asio::transfer_all();
+  }
+};
+
+// Seeds the adaptive limit from the socket's send buffer size.
+struct adaptive_send_factory
+{
+  asio::detail::transfer_adaptive_t operator()(tcp::socket& socket) const
+  {
+    return asio::transfer_adaptive_send(socket);
+  }
+};
+
+// Seeds the adaptive limit from the socket's receive buffer size.
+struct adaptive_receive_factory
+{
+  asio::detail::transfer_adaptive_t operator()(tcp::socket& socket) const
+  {
+    return asio::transfer_adaptive_receive(socket);
+  }
+};
+
+// Connect two sockets over the loopback interface.
+void connect_pair(asio::io_context& io_context,
+    tcp::socket& first, tcp::socket& second)
+{
+  tcp::acceptor acceptor(io_context,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  first.connect(acceptor.local_endpoint());
+  acceptor.accept(second);
+}
+
+template <typename Factory>
+void bulk_write(benchmark::state& s)
+{
+  asio::io_context io_context;
+  tcp::socket writer(io_context), reader(io_context);
+  connect_pair(io_context, writer, reader);
+
+  transfer_loop<Factory> loop(writer, s.iterations(), Factory());
+  loop.start_write();
+
+  s.start();
+  asio::detail::thread sink_thread(boost::bind(sink, &reader));
+  io_context.run();
+  sink_thread.join();
+  s.stop();
+
+  if (loop.bytes_transferred() != s.iterations() * block_size)
+    throw std::runtime_error("write incomplete");
+  s.add_bytes(loop.bytes_transferred());
+}
+
+template <typename Factory>
+void bulk_read(benchmark::state& s)
+{
+  asio::io_context io_context;
+  tcp::socket writer(io_context), reader(io_context);
+  connect_pair(io_context, writer, reader);
+
+  transfer_loop<Factory> loop(reader, s.iterations(), Factory());
+  loop.start_read();
+
+  s.start();
+  asio::detail::thread source_thread(
+      boost::bind(source, &writer, s.iterations()));
+  io_context.run();
+  source_thread.join();
+  s.stop();
+
+  if (loop.bytes_transferred() != s.iterations() * block_size)
+    throw std::runtime_error("read incomplete");
+  s.add_bytes(loop.bytes_transferred());
+}
+
+void bulk_write_fixed(benchmark::state& s)
+{
+  bulk_write<fixed_factory>(s);
+}
+
+void bulk_write_adaptive(benchmark::state& s)
+{
+  bulk_write<adaptive_send_factory>(s);
+}
+
+void bulk_read_fixed(benchmark::state& s)
+{
+  bulk_read<fixed_factory>(s);
+}
+
+void bulk_read_adaptive(benchmark::state& s)
+{
+  bulk_read<adaptive_receive_factory>(s);
+}
+
+} // namespace
+
+BENCHMARK("bulk_write_fixed", bulk_write_fixed, 64)
+BENCHMARK("bulk_write_adaptive", bulk_write_adaptive, 64)
+BENCHMARK("bulk_read_fixed", bulk_read_fixed, 64)
+BENCHMARK("bulk_read_adaptive", bulk_read_adaptive, 64)
@@ -0,0 +1,293 @@
+//
+// chat.cpp
+// ~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// The room and sessions are taken directly from the chat server example.
+#include "../../examples/cpp11/chat/chat_room.hpp"
+
+#include <asio/io_context.hpp>
+#include <asio/ip/tcp.hpp>
+#include <asio/read.hpp>
+#include <asio/write.hpp>
+#include <boost/bind.hpp>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <vector>
+#include "harness.hpp"
+
+using asio::ip::tcp;
+
+namespace {
+
+// The room and session from earlier versions of the chat server example,
+// which copy each message into every session's queue and write the queued
+// messages one at a time.
+namespace legacy {
+
+typedef std::deque<chat_message> chat_message_queue;
+
+class chat_participant
+{
+public:
+  virtual ~chat_participant() {}
+  virtual void deliver(const chat_message& msg) = 0;
+};
+
+typedef std::shared_ptr<chat_participant> chat_participant_ptr;
+
+class chat_room
+{
+public:
+  void join(chat_participant_ptr participant)
+  {
+    participants_.insert(participant);
+    for (auto msg: recent_msgs_)
+      participant->deliver(msg);
+  }
+
+  void leave(chat_participant_ptr participant)
+  {
+    participants_.erase(participant);
+  }
+
+  void deliver(const chat_message& msg)
+  {
+    recent_msgs_.push_back(msg);
+    while (recent_msgs_.size() > max_recent_msgs)
+      recent_msgs_.pop_front();
+
+    for (auto participant: participants_)
+      participant->deliver(msg);
+  }
+
+private:
+  std::set<chat_participant_ptr> participants_;
+  enum { max_recent_msgs = 100 };
+  chat_message_queue recent_msgs_;
+};
+
+class chat_session
+  : public chat_participant,
+    public std::enable_shared_from_this<chat_session>
+{
+public:
+  chat_session(tcp::socket socket, chat_room& room)
+    : socket_(std::move(socket)),
+      room_(room)
+  {
+  }
+
+  void start()
+  {
+    room_.join(shared_from_this());
+    do_read_header();
+  }
+
+  void deliver(const chat_message& msg)
+  {
+    bool write_in_progress = !write_msgs_.empty();
+    write_msgs_.push_back(msg);
+    if (!write_in_progress)
+    {
+      do_write();
+    }
+  }
+
+private:
+  void do_read_header()
+  {
+    auto self(shared_from_this());
+    asio::async_read(socket_,
+        asio::buffer(read_msg_.data(), chat_message::header_length),
+        [this, self](std::error_code ec, std::size_t /*length*/)
+        {
+          if (!ec && read_msg_.decode_header())
+          {
+            do_read_body();
+          }
+          else
+          {
+            room_.leave(shared_from_this());
+          }
+        });
+  }
+
+  void do_read_body()
+  {
+    auto self(shared_from_this());
+    asio::async_read(socket_,
+        asio::buffer(read_msg_.body(), read_msg_.body_length()),
+        [this, self](std::error_code ec, std::size_t /*length*/)
+        {
+          if (!ec)
+          {
+            room_.deliver(read_msg_);
+            do_read_header();
+          }
+          else
+          {
+            room_.leave(shared_from_this());
+          }
+        });
+  }
+
+  void do_write()
+  {
+    auto self(shared_from_this());
+    asio::async_write(socket_,
+        asio::buffer(write_msgs_.front().data(),
+          write_msgs_.front().length()),
+        [this, self](std::error_code ec, std::size_t /*length*/)
+        {
+          if (!ec)
+          {
+            write_msgs_.pop_front();
+            if (!write_msgs_.empty())
+            {
+              do_write();
+            }
+          }
+          else
+          {
+            room_.leave(shared_from_this());
+          }
+        });
+  }
+
+  tcp::socket socket_;
+  chat_room& room_;
+  chat_message read_msg_;
+  chat_message_queue write_msgs_;
+};
+
+} // namespace legacy
+
+// A client that counts the bytes it receives.
+class counting_client
+{
+public:
+  counting_client(asio::io_context& io_context, std::size_t& received)
+    : socket_(io_context),
+      received_(received)
+  {
+  }
+
+  tcp::socket& socket()
+  {
+    return socket_;
+  }
+
+  void start()
+  {
+    socket_.async_read_some(asio::buffer(data_),
+        boost::bind(&counting_client::handle_read, this, _1, _2));
+  }
+
+private:
+  void handle_read(const asio::error_code& ec, std::size_t n)
+  {
+    if (!ec)
+    {
+      received_ += n;
+      start();
+    }
+  }
+
+  tcp::socket socket_;
+  std::size_t& received_;
+  char data_[65536];
+};
+
+// Broadcast messages to a room with the given number of participants, each
+// connected over the loopback interface. Messages are delivered in bursts,
+// and each burst must reach every participant before the next is delivered.
+template <typename Room, typename Session>
+void fan_out(benchmark::state& s, std::size_t participants)
+{
+  asio::io_context io_context;
+  tcp::acceptor acceptor(io_context,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  Room room;
+  std::size_t received = 0;
+  std::vector<std::unique_ptr<counting_client> > clients;
+  for (std::size_t i = 0; i < participants; ++i)
+  {
+    clients.emplace_back(new counting_client(io_context, received));
+    clients.back()->socket().connect(acceptor.local_endpoint());
+    tcp::socket socket(io_context);
+    acceptor.accept(socket);
+    socket.set_option(tcp::no_delay(true));
+    std::make_shared<Session>(std::move(socket), room)->start();
+    clients.back()->start();
+  }
+
+  chat_message msg;
+  msg.body_length(64);
+  std::memset(msg.body(), 'x', msg.body_length());
+  msg.encode_header();
+
+  const std::size_t burst = 16;
+  std::size_t expected = 0;
+
+  s.start();
+  for (std::size_t i = 0; i < s.iterations(); i += burst)
+  {
+    for (std::size_t j = 0; j < burst; ++j)
+      room.deliver(msg);
+    expected += burst * msg.length() * participants;
+    io_context.restart();
+    while (received < expected)
+      io_context.run_one();
+  }
+  s.stop();
+
+  s.add_bytes(expected);
+}
+
+void chat_fanout_legacy_1(benchmark::state& s)
+{
+  fan_out<legacy::chat_room, legacy::chat_session>(s, 1);
+}
+
+void chat_fanout_legacy_10(benchmark::state& s)
+{
+  fan_out<legacy::chat_room, legacy::chat_session>(s, 10);
+}
+
+void chat_fanout_legacy_100(benchmark::state& s)
+{
+  fan_out<legacy::chat_room, legacy::chat_session>(s, 100);
+}
+
+void chat_fanout_1(benchmark::state& s)
+{
+  fan_out<chat_room, chat_session>(s, 1);
+}
+
+void chat_fanout_10(benchmark::state& s)
+{
+  fan_out<chat_room, chat_session>(s, 10);
+}
+
+void chat_fanout_100(benchmark::state& s)
+{
+  fan_out<chat_room, chat_session>(s, 100);
+}
+
+} // namespace
+
+BENCHMARK("chat_fanout_legacy_1", chat_fanout_legacy_1, 200000)
+BENCHMARK("chat_fanout_legacy_10", chat_fanout_legacy_10, 20000)
+BENCHMARK("chat_fanout_legacy_100", chat_fanout_legacy_100, 2000)
+BENCHMARK("chat_fanout_1", chat_fanout_1, 200000)
+BENCHMARK("chat_fanout_10", chat_fanout_10, 20000)
+BENCHMARK("chat_fanout_100", chat_fanout_100, 2000)
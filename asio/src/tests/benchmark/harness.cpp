@@ -0,0 +1,775 @@
+//
+// harness.cpp
+// ~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "harness.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+namespace benchmark {
+
+//----------------------------------------------------------------------
+
+histogram::histogram()
+  : counts_((1 << sub_bucket_bits)
+      + (64 - sub_bucket_bits + 1) * (1 << (sub_bucket_bits - 1))),
+    count_(0),
+    min_(0),
+    max_(0),
+    total_(0.0)
+{
+}
+
+void histogram::record(boost::uint64_t value)
+{
+  ++counts_[index_of(value)];
+  if (count_ == 0 || value < min_)
+    min_ = value;
+  if (value > max_)
+    max_ = value;
+  ++count_;
+  total_ += static_cast<double>(value);
+}
+
+void histogram::merge(const histogram& other)
+{
+  if (other.count_ == 0)
+    return;
+  for (std::size_t i = 0; i < counts_.size(); ++i)
+    counts_[i] += other.counts_[i];
+  if (count_ == 0 || other.min_ < min_)
+    min_ = other.min_;
+  if (other.max_ > max_)
+    max_ = other.max_;
+  count_ += other.count_;
+  total_ += other.total_;
+}
+
+boost::uint64_t histogram::percentile(double percent) const
+{
+  if (count_ == 0)
+    return 0;
+
+  double target = std::ceil(percent / 100.0 * static_cast<double>(count_));
+  boost::uint64_t wanted = target < 1.0 ? 1
+    : static_cast<boost::uint64_t>(std::min(target,
+          static_cast<double>(count_)));
+
+  boost::uint64_t seen = 0;
+  for (std::size_t i = 0; i < counts_.size(); ++i)
+  {
+    seen += counts_[i];
+    if (seen >= wanted)
+      return std::min(highest_equivalent_value(i), max_);
+  }
+
+  return max_;
+}
+
+std::size_t histogram::index_of(boost::uint64_t value)
+{
+  const boost::uint64_t sub_bucket_count = 1 << sub_bucket_bits;
+  const boost::uint64_t half_count = sub_bucket_count / 2;
+
+  if (value < sub_bucket_count)
+    return static_cast<std::size_t>(value);
+
+  int msb = 0;
+  for (boost::uint64_t v = value; v >>= 1; )
+    ++msb;
+
+  // Shift so that the value falls in the upper half of the sub-buckets.
+  int shift = msb - (sub_bucket_bits - 1);
+  return static_cast<std::size_t>(sub_bucket_count
+      + (shift - 1) * half_count + ((value >> shift) - half_count));
+}
+
+boost::uint64_t histogram::highest_equivalent_value(std::size_t index)
+{
+  const std::size_t sub_bucket_count = 1 << sub_bucket_bits;
+  const std::size_t half_count = sub_bucket_count / 2;
+
+  if (index < sub_bucket_count)
+    return index;
+
+  std::size_t offset = index - sub_bucket_count;
+  int shift = static_cast<int>(offset / half_count) + 1;
+  boost::uint64_t sub_bucket = offset % half_count + half_count;
+  return ((sub_bucket + 1) << shift) - 1;
+}
+
+//----------------------------------------------------------------------
+
+state::state(std::size_t iterations)
+  : iterations_(iterations),
+    start_(0),
+    stop_(0),
+    bytes_(0)
+{
+}
+
+void state::start()
+{
+  start_ = now();
+}
+
+void state::stop()
+{
+  stop_ = now();
+}
+
+//----------------------------------------------------------------------
+
+namespace {
+
+struct entry
+{
+  std::string name;
+  function f;
+  std::size_t iterations;
+};
+
+std::vector<entry>& registry()
+{
+  static std::vector<entry> entries;
+  return entries;
+}
+
+struct options
+{
+  options()
+    : warmup(1),
+      repetitions(5),
+      scale(1.0),
+      list(false),
+      threshold(5.0)
+  {
+  }
+
+  int warmup;
+  int repetitions;
+  double scale;
+  std::string filter;
+  std::string json;
+  bool list;
+  std::vector<std::string> compare;
+  double threshold;
+};
+
+double median(std::vector<double> values)
+{
+  if (values.empty())
+    return 0.0;
+  std::sort(values.begin(), values.end());
+  std::size_t n = values.size();
+  return n % 2 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2.0;
+}
+
+double minimum(const std::vector<double>& values)
+{
+  return values.empty() ? 0.0
+    : *std::min_element(values.begin(), values.end());
+}
+
+double maximum(const std::vector<double>& values)
+{
+  return values.empty() ? 0.0
+    : *std::max_element(values.begin(), values.end());
+}
+
+const double reported_percentiles[] = { 50.0, 90.0, 99.0, 99.9 };
+const char* const reported_percentile_names[] =
+  { "p50", "p90", "p99", "p99.9" };
+const std::size_t num_reported_percentiles =
+  sizeof(reported_percentiles) / sizeof(reported_percentiles[0]);
+
+} // namespace
+
+struct result
+{
+  std::string name;
+  std::size_t iterations;
+  int repetitions;
+  std::vector<double> ops_per_sec;
+  std::vector<double> bytes_per_sec;
+  histogram latency;
+  std::string skipped;
+  std::string error;
+};
+
+class runner
+{
+public:
+  explicit runner(const options& opts)
+    : options_(opts)
+  {
+  }
+
+  result run(const entry& e)
+  {
+    result r;
+    r.name = e.name;
+    r.iterations = static_cast<std::size_t>(
+        std::max(1.0, std::floor(e.iterations * options_.scale)));
+    r.repetitions = 0;
+
+    for (int i = 0; i < options_.warmup + options_.repetitions; ++i)
+    {
+      state s(r.iterations);
+      try
+      {
+        s.start_ = now();
+        e.f(s);
+        if (s.stop_ == 0)
+          s.stop_ = now();
+      }
+      catch (std::exception& ex)
+      {
+        r.error = ex.what();
+        return r;
+      }
+
+      if (!s.skipped_.empty())
+      {
+        r.skipped = s.skipped_;
+        return r;
+      }
+
+      if (i < options_.warmup)
+        continue;
+
+      double seconds = std::max<boost::uint64_t>(s.stop_ - s.start_, 1) / 1e9;
+      r.ops_per_sec.push_back(r.iterations / seconds);
+      if (s.bytes_)
+        r.bytes_per_sec.push_back(s.bytes_ / seconds);
+      r.latency.merge(s.latency_);
+      ++r.repetitions;
+    }
+
+    return r;
+  }
+
+private:
+  const options& options_;
+};
+
+registration::registration(const char* name,
+    function f, std::size_t iterations)
+{
+  entry e;
+  e.name = name;
+  e.f = f;
+  e.iterations = iterations;
+  registry().push_back(e);
+}
+
+//----------------------------------------------------------------------
+
+namespace {
+
+void print_header()
+{
+  std::printf("%-24s %12s %7s %10s %9s %9s %9s %9s %9s\n",
+      "benchmark", "ops/s", "+/-%", "MB/s", "p50 us",
+      "p90 us", "p99 us", "p99.9 us", "max us");
+}
+
+void print_result(const result& r)
+{
+  if (!r.skipped.empty())
+  {
+    std::printf("%-24s skipped: %s\n", r.name.c_str(), r.skipped.c_str());
+    return;
+  }
+
+  if (!r.error.empty())
+  {
+    std::printf("%-24s failed: %s\n", r.name.c_str(), r.error.c_str());
+    return;
+  }
+
+  double ops = median(r.ops_per_sec);
+  double spread = ops > 0.0 ? 100.0 * (maximum(r.ops_per_sec)
+      - minimum(r.ops_per_sec)) / (2.0 * ops) : 0.0;
+  std::printf("%-24s %12.0f %7.1f", r.name.c_str(), ops, spread);
+
+  if (r.bytes_per_sec.empty())
+    std::printf(" %10s", "-");
+  else
+    std::printf(" %10.1f", median(r.bytes_per_sec) / 1e6);
+
+  if (r.latency.count() == 0)
+  {
+    std::printf(" %9s %9s %9s %9s %9s\n", "-", "-", "-", "-", "-");
+    return;
+  }
+
+  for (std::size_t i = 0; i < num_reported_percentiles; ++i)
+    std::printf(" %9.2f",
+        r.latency.percentile(reported_percentiles[i]) / 1e3);
+  std::printf(" %9.2f\n", r.latency.max() / 1e3);
+}
+
+std::string json_string(const std::string& s)
+{
+  std::string out = "\"";
+  for (std::size_t i = 0; i < s.size(); ++i)
+  {
+    if (s[i] == '"' || s[i] == '\\')
+      out += '\\';
+    out += s[i];
+  }
+  return out + "\"";
+}
+
+void write_json(std::ostream& os, const std::vector<result>& results)
+{
+  os.precision(17);
+  os << "{\n  \"benchmarks\": [";
+  for (std::size_t i = 0; i < results.size(); ++i)
+  {
+    const result& r = results[i];
+    os << (i ? ",\n" : "\n") << "    {\n";
+    os << "      \"name\": " << json_string(r.name) << ",\n";
+    os << "      \"iterations\": " << r.iterations << ",\n";
+    os << "      \"repetitions\": " << r.repetitions;
+
+    if (!r.skipped.empty())
+    {
+      os << ",\n      \"skipped\": " << json_string(r.skipped) << "\n    }";
+      continue;
+    }
+
+    if (!r.error.empty())
+    {
+      os << ",\n      \"error\": " << json_string(r.error) << "\n    }";
+      continue;
+    }
+
+    os << ",\n      \"ops_per_sec\": { \"median\": " << median(r.ops_per_sec)
+      << ", \"min\": " << minimum(r.ops_per_sec)
+      << ", \"max\": " << maximum(r.ops_per_sec) << " }";
+
+    if (!r.bytes_per_sec.empty())
+    {
+      os << ",\n      \"bytes_per_sec\": { \"median\": "
+        << median(r.bytes_per_sec)
+        << ", \"min\": " << minimum(r.bytes_per_sec)
+        << ", \"max\": " << maximum(r.bytes_per_sec) << " }";
+    }
+
+    if (r.latency.count())
+    {
+      os << ",\n      \"latency_ns\": { \"count\": " << r.latency.count()
+        << ", \"mean\": " << r.latency.mean()
+        << ", \"min\": " << r.latency.min();
+      for (std::size_t j = 0; j < num_reported_percentiles; ++j)
+      {
+        os << ", \"" << reported_percentile_names[j] << "\": "
+          << r.latency.percentile(reported_percentiles[j]);
+      }
+      os << ", \"max\": " << r.latency.max() << " }";
+    }
+
+    os << "\n    }";
+  }
+  os << "\n  ]\n}\n";
+}
+
+//----------------------------------------------------------------------
+
+// A minimal JSON reader, sufficient for the files written by write_json.
+// Numbers are flattened into a map keyed by a dotted path, where array
+// elements are keyed by their "name" member if they have one.
+class json_reader
+{
+public:
+  explicit json_reader(const std::string& text)
+    : text_(text),
+      pos_(0)
+  {
+  }
+
+  // Parse the text and return the flattened numbers.
+  std::map<std::string, double> parse()
+  {
+    parse_value("");
+    skip_space();
+    if (pos_ != text_.size())
+      fail("trailing characters");
+    return numbers_;
+  }
+
+  // The names of the array elements, in the order they were read.
+  const std::vector<std::string>& names() const
+  {
+    return names_;
+  }
+
+private:
+  void parse_value(const std::string& path)
+  {
+    skip_space();
+    if (pos_ >= text_.size())
+      fail("unexpected end of input");
+
+    char c = text_[pos_];
+    if (c == '{')
+      parse_object(path);
+    else if (c == '[')
+      parse_array(path);
+    else if (c == '"')
+      strings_[path] = parse_string();
+    else if (text_.compare(pos_, 4, "true") == 0)
+      pos_ += 4;
+    else if (text_.compare(pos_, 5, "false") == 0)
+      pos_ += 5;
+    else if (text_.compare(pos_, 4, "null") == 0)
+      pos_ += 4;
+    else
+      numbers_[path] = parse_number();
+  }
+
+  void parse_object(const std::string& path)
+  {
+    expect('{');
+    skip_space();
+    if (peek('}'))
+      return;
+
+    do
+    {
+      skip_space();
+      std::string key = parse_string();
+      skip_space();
+      expect(':');
+      parse_value(path.empty() ? key : path + "." + key);
+      skip_space();
+    } while (peek(','));
+
+    expect('}');
+  }
+
+  void parse_array(const std::string& path)
+  {
+    expect('[');
+    skip_space();
+    if (peek(']'))
+      return;
+
+    std::size_t index = 0;
+    do
+    {
+      std::ostringstream key;
+      key << path << "[" << index++ << "]";
+      parse_value(key.str());
+
+      // Key the element's numbers by its name, if it has one.
+      std::map<std::string, std::string>::iterator name =
+        strings_.find(key.str() + ".name");
+      if (name != strings_.end())
+      {
+        std::string prefix = key.str() + ".";
+        std::map<std::string, double>::iterator i =
+          numbers_.lower_bound(prefix);
+        while (i != numbers_.end() && i->first.compare(
+              0, prefix.size(), prefix) == 0)
+        {
+          numbers_[path + "." + name->second + "."
+            + i->first.substr(prefix.size())] = i->second;
+          numbers_.erase(i++);
+        }
+        names_.push_back(name->second);
+      }
+
+      skip_space();
+    } while (peek(','));
+
+    expect(']');
+  }
+
+  std::string parse_string()
+  {
+    expect('"');
+    std::string s;
+    while (pos_ < text_.size() && text_[pos_] != '"')
+    {
+      if (text_[pos_] == '\\' && pos_ + 1 < text_.size())
+        ++pos_;
+      s += text_[pos_++];
+    }
+    expect('"');
+    return s;
+  }
+
+  double parse_number()
+  {
+    const char* begin = text_.c_str() + pos_;
+    char* end = 0;
+    double value = std::strtod(begin, &end);
+    if (end == begin)
+      fail("expected a value");
+    pos_ += end - begin;
+    return value;
+  }
+
+  void skip_space()
+  {
+    while (pos_ < text_.size() && std::strchr(" \t\r\n", text_[pos_]))
+      ++pos_;
+  }
+
+  bool peek(char c)
+  {
+    if (pos_ < text_.size() && text_[pos_] == c)
+    {
+      ++pos_;
+      return true;
+    }
+    return false;
+  }
+
+  void expect(char c)
+  {
+    if (!peek(c))
+      fail(std::string("expected '") + c + "'");
+  }
+
+  void fail(const std::string& what)
+  {
+    std::ostringstream msg;
+    msg << what << " at offset " << pos_;
+    throw std::runtime_error(msg.str());
+  }
+
+  const std::string& text_;
+  std::size_t pos_;
+  std::map<std::string, double> numbers_;
+  std::map<std::string, std::string> strings_;
+  std::vector<std::string> names_;
+};
+
+struct run_summary
+{
+  std::map<std::string, double> numbers;
+  std::vector<std::string> names;
+};
+
+run_summary read_results(const std::string& path)
+{
+  std::ifstream in(path.c_str());
+  if (!in)
+    throw std::runtime_error("cannot open " + path);
+  std::ostringstream text;
+  text << in.rdbuf();
+
+  std::string s = text.str();
+  json_reader reader(s);
+  run_summary summary;
+  summary.numbers = reader.parse();
+  summary.names = reader.names();
+  return summary;
+}
+
+bool lookup(const run_summary& s, const std::string& key, double& value)
+{
+  std::map<std::string, double>::const_iterator i = s.numbers.find(key);
+  if (i == s.numbers.end())
+    return false;
+  value = i->second;
+  return true;
+}
+
+// Compare two runs. Returns the number of regressions found.
+int compare(const std::string& base_path,
+    const std::string& new_path, double threshold)
+{
+  run_summary base = read_results(base_path);
+  run_summary next = read_results(new_path);
+
+  std::printf("%-24s %12s %12s %8s %10s %10s %8s\n", "benchmark",
+      "base ops/s", "new ops/s", "change", "base p99", "new p99", "change");
+
+  int regressions = 0;
+  for (std::size_t i = 0; i < base.names.size(); ++i)
+  {
+    const std::string& name = base.names[i];
+    std::string prefix = "benchmarks." + name + ".";
+
+    double base_ops = 0.0, new_ops = 0.0;
+    if (!lookup(base, prefix + "ops_per_sec.median", base_ops))
+      continue;
+    if (!lookup(next, prefix + "ops_per_sec.median", new_ops))
+    {
+      std::printf("%-24s missing from %s\n", name.c_str(), new_path.c_str());
+      continue;
+    }
+
+    bool regressed = false;
+    double ops_change = base_ops > 0.0
+      ? 100.0 * (new_ops - base_ops) / base_ops : 0.0;
+    if (ops_change < -threshold)
+      regressed = true;
+
+    std::printf("%-24s %12.0f %12.0f %+7.1f%%",
+        name.c_str(), base_ops, new_ops, ops_change);
+
+    double base_p99 = 0.0, new_p99 = 0.0;
+    if (lookup(base, prefix + "latency_ns.p99", base_p99)
+        && lookup(next, prefix + "latency_ns.p99", new_p99))
+    {
+      double p99_change = base_p99 > 0.0
+        ? 100.0 * (new_p99 - base_p99) / base_p99 : 0.0;
+      if (p99_change > threshold)
+        regressed = true;
+      std::printf(" %10.2f %10.2f %+7.1f%%",
+          base_p99 / 1e3, new_p99 / 1e3, p99_change);
+    }
+    else
+    {
+      std::printf(" %10s %10s %8s", "-", "-", "-");
+    }
+
+    if (regressed)
+      ++regressions;
+    std::printf("%s\n", regressed ? "  REGRESSION" : "");
+  }
+
+  std::printf("\n%d regression(s) beyond %.1f%%\n", regressions, threshold);
+  return regressions;
+}
+
+//----------------------------------------------------------------------
+
+void usage()
+{
+  std::fprintf(stderr,
+      "Usage: benchmark [options]\n"
+      "       benchmark --compare <base.json> <new.json> [--threshold=<pct>]\n"
+      "\n"
+      "Options:\n"
+      "  --list              List the available benchmarks.\n"
+      "  --filter=<text>     Run only benchmarks whose name contains text.\n"
+      "  --warmup=<n>        Unmeasured repetitions (default 1).\n"
+      "  --repetitions=<n>   Measured repetitions (default 5).\n"
+      "  --scale=<x>         Multiply the default iteration counts by x.\n"
+      "  --json=<file>       Also write the results to file as JSON.\n"
+      "  --threshold=<pct>   Change treated as a regression (default 5).\n");
+}
+
+bool parse_option(const char* arg, const char* name, std::string& value)
+{
+  std::size_t length = std::strlen(name);
+  if (std::strncmp(arg, name, length) != 0 || arg[length] != '=')
+    return false;
+  value = arg + length + 1;
+  return true;
+}
+
+bool parse_options(int argc, char* argv[], options& opts)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string value;
+    if (std::strcmp(argv[i], "--list") == 0)
+      opts.list = true;
+    else if (std::strcmp(argv[i], "--compare") == 0 && i + 2 < argc)
+    {
+      opts.compare.push_back(argv[++i]);
+      opts.compare.push_back(argv[++i]);
+    }
+    else if (parse_option(argv[i], "--filter", value))
+      opts.filter = value;
+    else if (parse_option(argv[i], "--warmup", value))
+      opts.warmup = std::atoi(value.c_str());
+    else if (parse_option(argv[i], "--repetitions", value))
+      opts.repetitions = std::atoi(value.c_str());
+    else if (parse_option(argv[i], "--scale", value))
+      opts.scale = std::atof(value.c_str());
+    else if (parse_option(argv[i], "--json", value))
+      opts.json = value;
+    else if (parse_option(argv[i], "--threshold", value))
+      opts.threshold = std::atof(value.c_str());
+    else
+      return false;
+  }
+
+  return opts.warmup >= 0 && opts.repetitions > 0 && opts.scale > 0.0;
+}
+
+} // namespace
+} // namespace benchmark
+
+int main(int argc, char* argv[])
+{
+  using namespace benchmark;
+
+  options opts;
+  if (!parse_options(argc, argv, opts))
+  {
+    usage();
+    return 1;
+  }
+
+  try
+  {
+    if (!opts.compare.empty())
+      return compare(opts.compare[0], opts.compare[1], opts.threshold) ? 1 : 0;
+
+    std::vector<entry> entries;
+    for (std::size_t i = 0; i < registry().size(); ++i)
+      if (registry()[i].name.find(opts.filter) != std::string::npos)
+        entries.push_back(registry()[i]);
+
+    if (opts.list)
+    {
+      for (std::size_t i = 0; i < entries.size(); ++i)
+        std::printf("%s\n", entries[i].name.c_str());
+      return 0;
+    }
+
+    runner r(opts);
+    std::vector<result> results;
+    int failures = 0;
+    print_header();
+    for (std::size_t i = 0; i < entries.size(); ++i)
+    {
+      results.push_back(r.run(entries[i]));
+      print_result(results.back());
+      std::fflush(stdout);
+      if (!results.back().error.empty())
+        ++failures;
+    }
+
+    if (!opts.json.empty())
+    {
+      std::ofstream out(opts.json.c_str());
+      write_json(out, results);
+      if (!out)
+        throw std::runtime_error("cannot write " + opts.json);
+    }
+
+    return failures ? 1 : 0;
+  }
+  catch (std::exception& e)
+  {
+    std::fprintf(stderr, "Exception: %s\n", e.what());
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,131 @@
+//
+// harness.hpp
+// ~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BENCHMARK_HARNESS_HPP
+#define BENCHMARK_HARNESS_HPP
+
+#include <asio/detail/chrono.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace benchmark {
+
+// Returns a monotonic time in nanoseconds.
+inline boost::uint64_t now()
+{
+  return asio::chrono::duration_cast<asio::chrono::nanoseconds>(
+      asio::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// A histogram of non-negative values with a bounded relative error, in the
+// manner of HdrHistogram. Values below 2^sub_bucket_bits are recorded
+// exactly. Larger values are grouped by their most significant bit, and each
+// group is divided into 2^(sub_bucket_bits - 1) linear sub-buckets, so that a
+// recorded value is accurate to better than 1 part in 64.
+class histogram
+{
+public:
+  enum { sub_bucket_bits = 7 };
+
+  histogram();
+
+  // Record a single value.
+  void record(boost::uint64_t value);
+
+  // Add all values recorded in another histogram.
+  void merge(const histogram& other);
+
+  // The number of recorded values.
+  boost::uint64_t count() const { return count_; }
+
+  // The smallest recorded value, or 0 if there are none.
+  boost::uint64_t min() const { return count_ ? min_ : 0; }
+
+  // The largest recorded value.
+  boost::uint64_t max() const { return max_; }
+
+  // The mean of the recorded values.
+  double mean() const { return count_ ? total_ / count_ : 0.0; }
+
+  // The value below which the given percentage of recorded values fall.
+  boost::uint64_t percentile(double percent) const;
+
+private:
+  static std::size_t index_of(boost::uint64_t value);
+  static boost::uint64_t highest_equivalent_value(std::size_t index);
+
+  std::vector<boost::uint64_t> counts_;
+  boost::uint64_t count_;
+  boost::uint64_t min_;
+  boost::uint64_t max_;
+  double total_;
+};
+
+// The state passed to a benchmark for a single repetition.
+class state
+{
+public:
+  explicit state(std::size_t iterations);
+
+  // The number of operations the benchmark should perform.
+  std::size_t iterations() const { return iterations_; }
+
+  // Start the measured interval. If not called, the interval starts when the
+  // benchmark function is entered.
+  void start();
+
+  // Stop the measured interval. If not called, the interval stops when the
+  // benchmark function returns.
+  void stop();
+
+  // Record the latency of one operation, in nanoseconds.
+  void record(boost::uint64_t nanoseconds) { latency_.record(nanoseconds); }
+
+  // Add to the number of bytes transferred by the benchmark.
+  void add_bytes(boost::uint64_t n) { bytes_ += n; }
+
+  // Mark the benchmark as unable to run in this environment.
+  void skip(const std::string& reason) { skipped_ = reason; }
+
+private:
+  friend class runner;
+
+  std::size_t iterations_;
+  boost::uint64_t start_;
+  boost::uint64_t stop_;
+  boost::uint64_t bytes_;
+  histogram latency_;
+  std::string skipped_;
+};
+
+// The signature of a benchmark function.
+typedef void (*function)(state&);
+
+// Registers a benchmark at static initialisation time.
+class registration
+{
+public:
+  registration(const char* name, function f, std::size_t iterations);
+};
+
+} // namespace benchmark
+
+#define BENCHMARK_JOIN_2(a, b) a##b
+#define BENCHMARK_JOIN(a, b) BENCHMARK_JOIN_2(a, b)
+
+// Register a benchmark function with the default number of iterations to be
+// performed in each repetition.
+#define BENCHMARK(name, f, iterations) \
+  static ::benchmark::registration \
+    BENCHMARK_JOIN(benchmark_registration_, __LINE__)(name, f, iterations);
+
+#endif // BENCHMARK_HARNESS_HPP
@@ -0,0 +1,263 @@
+//
+// http_file.cpp
+// ~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <asio/detail/config.hpp>
+
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+// The file cache and request handler are compiled directly from the HTTP
+// server example's sources.
+#include "../../examples/cpp11/http/server/file_cache.cpp"
+#include "../../examples/cpp11/http/server/mime_types.cpp"
+#include "../../examples/cpp11/http/server/reply.cpp"
+#include "../../examples/cpp11/http/server/request_handler.cpp"
+
+#include <asio/io_context.hpp>
+#include <asio/ip/tcp.hpp>
+#include <asio/read.hpp>
+#include <asio/transfer.hpp>
+#include <asio/write.hpp>
+#include <boost/bind.hpp>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include "harness.hpp"
+
+namespace {
+
+using asio::ip::tcp;
+
+// A directory holding the files to be served, removed on exit.
+class doc_root
+{
+public:
+  doc_root()
+  {
+    char path[] = "/tmp/asio_benchmark_XXXXXX";
+    if (::mkdtemp(path) == 0)
+      throw std::runtime_error("cannot create directory");
+    path_ = path;
+    write("small.html", 4096);
+    write("large.bin", 1024 * 1024);
+  }
+
+  ~doc_root()
+  {
+    ::unlink((path_ + "/small.html").c_str());
+    ::unlink((path_ + "/large.bin").c_str());
+    ::rmdir(path_.c_str());
+  }
+
+  const std::string& path() const
+  {
+    return path_;
+  }
+
+private:
+  void write(const char* name, std::size_t size)
+  {
+    std::ofstream os((path_ + "/" + name).c_str(), std::ios::binary);
+    std::string data(size, 'x');
+    os.write(data.data(), data.size());
+  }
+
+  std::string path_;
+};
+
+const doc_root& get_doc_root()
+{
+  static doc_root root;
+  return root;
+}
+
+// The reply produced by earlier versions of the HTTP server example, which
+// read the whole file into the reply's content for every request.
+void legacy_handle_request(const std::string& full_path,
+    http::server::reply& rep)
+{
+  std::ifstream is(full_path.c_str(), std::ios::in | std::ios::binary);
+  if (!is)
+    throw std::runtime_error("cannot open file");
+
+  rep.status = http::server::reply::ok;
+  char buf[512];
+  while (is.read(buf, sizeof(buf)).gcount() > 0)
+    rep.content.append(buf, is.gcount());
+  rep.headers.resize(2);
+  rep.headers[0].name = "Content-Length";
+  rep.headers[0].value = std::to_string(rep.content.size());
+  rep.headers[1].name = "Content-Type";
+  rep.headers[1].value = "text/html";
+}
+
+// Produce replies for a small file as earlier versions of the example did.
+void http_file_legacy(benchmark::state& s)
+{
+  std::string full_path = get_doc_root().path() + "/small.html";
+  std::size_t buffers = 0;
+
+  s.start();
+  for (std::size_t i = 0; i < s.iterations(); ++i)
+  {
+    http::server::reply rep;
+    legacy_handle_request(full_path, rep);
+    buffers += rep.to_buffers().size();
+  }
+  s.stop();
+
+  s.add_bytes(s.iterations() * 4096);
+  if (buffers == 0)
+    throw std::runtime_error("no reply");
+}
+
+// Produce replies for a small file, which is held in the cache.
+void http_file_cached(benchmark::state& s)
+{
+  http::server::request_handler handler(get_doc_root().path());
+  http::server::request req = http::server::request();
+  req.uri = "/small.html";
+  std::size_t buffers = 0;
+
+  s.start();
+  for (std::size_t i = 0; i < s.iterations(); ++i)
+  {
+    http::server::reply rep;
+    handler.handle_request(req, rep);
+    if (rep.status != http::server::reply::ok)
+      throw std::runtime_error("request failed");
+    buffers += rep.to_buffers().size();
+  }
+  s.stop();
+
+  s.add_bytes(s.iterations() * 4096);
+  if (buffers == 0)
+    throw std::runtime_error("no reply");
+}
+
+// Produce replies for a small file that the client already has.
+void http_file_not_modified(benchmark::state& s)
+{
+  http::server::request_handler handler(get_doc_root().path());
+  http::server::request req = http::server::request();
+  req.uri = "/small.html";
+  http::server::reply first;
+  handler.handle_request(req, first);
+  std::string etag = first.file->etag();
+  http::server::header_field h = { "If-None-Match", etag };
+  req.headers.push_back(h);
+  std::size_t buffers = 0;
+
+  s.start();
+  for (std::size_t i = 0; i < s.iterations(); ++i)
+  {
+    http::server::reply rep;
+    handler.handle_request(req, rep);
+    if (rep.status != http::server::reply::not_modified)
+      throw std::runtime_error("request failed");
+    buffers += rep.to_buffers().size();
+  }
+  s.stop();
+
+  if (buffers == 0)
+    throw std::runtime_error("no reply");
+}
+
+// Read and discard everything received on a socket.
+void drain(tcp::socket* socket)
+{
+  static char data[65536];
+  asio::error_code ec;
+  while (!ec)
+    socket->read_some(asio::buffer(data), ec);
+}
+
+// Send a large file to a peer on the loopback interface, either by reading it
+// into memory and writing it as earlier versions of the example did, or from
+// the cache's descriptor using sendfile.
+void send_large_file(benchmark::state& s, bool use_sendfile)
+{
+  asio::io_context io_context;
+  tcp::acceptor acceptor(io_context, tcp::endpoint(tcp::v4(), 0));
+  tcp::endpoint endpoint = acceptor.local_endpoint();
+  endpoint.address(asio::ip::address_v4::loopback());
+  tcp::socket client(io_context), server(io_context);
+  client.connect(endpoint);
+  acceptor.accept(server);
+  asio::detail::thread drainer(boost::bind(drain, &client));
+
+  std::string full_path = get_doc_root().path() + "/large.bin";
+  http::server::file_cache cache;
+  std::size_t failures = 0;
+
+  s.start();
+  for (std::size_t i = 0; i < s.iterations(); ++i)
+  {
+    asio::error_code ec;
+    std::size_t n = 0;
+    std::shared_ptr<const http::server::static_file> file;
+    std::string content;
+    if (use_sendfile)
+    {
+      file = cache.get(full_path, "application/octet-stream");
+      asio::async_sendfile(server, file->descriptor(), 0, file->size(),
+          [&](const asio::error_code& e, std::size_t bytes)
+          {
+            ec = e;
+            n = bytes;
+          });
+    }
+    else
+    {
+      http::server::reply rep;
+      legacy_handle_request(full_path, rep);
+      content.swap(rep.content);
+      asio::async_write(server, asio::buffer(content),
+          [&](const asio::error_code& e, std::size_t bytes)
+          {
+            ec = e;
+            n = bytes;
+          });
+    }
+    io_context.run();
+    io_context.restart();
+    if (ec || n != 1024 * 1024)
+      ++failures;
+  }
+  s.stop();
+
+  server.close();
+  drainer.join();
+
+  s.add_bytes(s.iterations() * 1024 * 1024);
+  if (failures)
+    throw std::runtime_error("send failed");
+}
+
+void http_file_large_legacy(benchmark::state& s)
+{
+  send_large_file(s, false);
+}
+
+void http_file_large_sendfile(benchmark::state& s)
+{
+  send_large_file(s, true);
+}
+
+} // namespace
+
+BENCHMARK("http_file_legacy", http_file_legacy, 100000)
+BENCHMARK("http_file_cached", http_file_cached, 100000)
+BENCHMARK("http_file_not_modified", http_file_not_modified, 100000)
+BENCHMARK("http_file_large_legacy", http_file_large_legacy, 500)
+BENCHMARK("http_file_large_sendfile", http_file_large_sendfile, 500)
+
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
@@ -0,0 +1,348 @@
+//
+// http_parser.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// The parser is compiled directly from the HTTP server example's sources.
+#include "../../examples/cpp11/http/server/message_parser.cpp"
+#include "../../examples/cpp11/http/server/request_parser.cpp"
+#include "../../examples/cpp11/http/server/request.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "harness.hpp"
+
+namespace {
+
+// A request of the size typically sent by a browser.
+const char browser_request[] =
+  "GET /images/logo.png?v=20190412 HTTP/1.1\r\n"
+  "Host: www.example.com\r\n"
+  "User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:66.0) "
+    "Gecko/20100101 Firefox/66.0\r\n"
+  "Accept: image/webp,*/*\r\n"
+  "Accept-Language: en-GB,en;q=0.5\r\n"
+  "Accept-Encoding: gzip, deflate, br\r\n"
+  "Referer: https://www.example.com/index.html\r\n"
+  "Connection: keep-alive\r\n"
+  "Cookie: session=4f2a9c1e7b3d48a6a1f0c2d9e8b7a6f5; theme=dark\r\n"
+  "Cache-Control: max-age=0\r\n"
+  "\r\n";
+
+// A request with a chunked body.
+const char chunked_request[] =
+  "POST /upload HTTP/1.1\r\n"
+  "Host: www.example.com\r\n"
+  "Content-Type: application/octet-stream\r\n"
+  "Transfer-Encoding: chunked\r\n"
+  "\r\n"
+  "40\r\n"
+  "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef\r\n"
+  "40\r\n"
+  "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef\r\n"
+  "0\r\n"
+  "\r\n";
+
+// The request and parser from earlier versions of the HTTP server example,
+// which handle one character at a time and copy each into a std::string.
+struct legacy_header
+{
+  std::string name;
+  std::string value;
+};
+
+struct legacy_request
+{
+  std::string method;
+  std::string uri;
+  int http_version_major;
+  int http_version_minor;
+  std::vector<legacy_header> headers;
+};
+
+class legacy_parser
+{
+public:
+  enum result_type { good, bad, indeterminate };
+
+  legacy_parser() : state_(method_start) {}
+
+  result_type parse(legacy_request& req, const char* begin, const char* end)
+  {
+    while (begin != end)
+    {
+      result_type result = consume(req, *begin++);
+      if (result != indeterminate)
+        return result;
+    }
+    return indeterminate;
+  }
+
+private:
+  static bool is_char(int c) { return c >= 0 && c <= 127; }
+  static bool is_ctl(int c) { return (c >= 0 && c <= 31) || (c == 127); }
+  static bool is_digit(int c) { return c >= '0' && c <= '9'; }
+
+  static bool is_tspecial(int c)
+  {
+    return std::strchr("()<>@,;:\\\"/[]?={} \t", c) != 0;
+  }
+
+  static bool is_token(int c)
+  {
+    return is_char(c) && !is_ctl(c) && !is_tspecial(c);
+  }
+
+  result_type expect(char input, char expected, int next)
+  {
+    if (input != expected)
+      return bad;
+    state_ = static_cast<state>(next);
+    return indeterminate;
+  }
+
+  result_type consume(legacy_request& req, char input)
+  {
+    switch (state_)
+    {
+    case method_start:
+      if (!is_token(input))
+        return bad;
+      state_ = method;
+      req.method.push_back(input);
+      return indeterminate;
+    case method:
+      if (input == ' ')
+        state_ = uri;
+      else if (!is_token(input))
+        return bad;
+      else
+        req.method.push_back(input);
+      return indeterminate;
+    case uri:
+      if (input == ' ')
+        state_ = http_version_h;
+      else if (is_ctl(input))
+        return bad;
+      else
+        req.uri.push_back(input);
+      return indeterminate;
+    case http_version_h:
+      return expect(input, 'H', http_version_t_1);
+    case http_version_t_1:
+      return expect(input, 'T', http_version_t_2);
+    case http_version_t_2:
+      return expect(input, 'T', http_version_p);
+    case http_version_p:
+      return expect(input, 'P', http_version_slash);
+    case http_version_slash:
+      req.http_version_major = 0;
+      req.http_version_minor = 0;
+      return expect(input, '/', http_version_major_start);
+    case http_version_major_start:
+    case http_version_major:
+      if (state_ == http_version_major && input == '.')
+        state_ = http_version_minor_start;
+      else if (!is_digit(input))
+        return bad;
+      else
+      {
+        req.http_version_major = req.http_version_major * 10 + input - '0';
+        state_ = http_version_major;
+      }
+      return indeterminate;
+    case http_version_minor_start:
+    case http_version_minor:
+      if (state_ == http_version_minor && input == '\r')
+        state_ = expecting_newline_1;
+      else if (!is_digit(input))
+        return bad;
+      else
+      {
+        req.http_version_minor = req.http_version_minor * 10 + input - '0';
+        state_ = http_version_minor;
+      }
+      return indeterminate;
+    case expecting_newline_1:
+      return expect(input, '\n', header_line_start);
+    case header_line_start:
+      if (input == '\r')
+        state_ = expecting_newline_3;
+      else if (!req.headers.empty() && (input == ' ' || input == '\t'))
+        state_ = header_lws;
+      else if (!is_token(input))
+        return bad;
+      else
+      {
+        req.headers.push_back(legacy_header());
+        req.headers.back().name.push_back(input);
+        state_ = header_name;
+      }
+      return indeterminate;
+    case header_lws:
+      if (input == '\r')
+        state_ = expecting_newline_2;
+      else if (input == ' ' || input == '\t')
+        ;
+      else if (is_ctl(input))
+        return bad;
+      else
+      {
+        state_ = header_value;
+        req.headers.back().value.push_back(input);
+      }
+      return indeterminate;
+    case header_name:
+      if (input == ':')
+        state_ = space_before_header_value;
+      else if (!is_token(input))
+        return bad;
+      else
+        req.headers.back().name.push_back(input);
+      return indeterminate;
+    case space_before_header_value:
+      return expect(input, ' ', header_value);
+    case header_value:
+      if (input == '\r')
+        state_ = expecting_newline_2;
+      else if (is_ctl(input))
+        return bad;
+      else
+        req.headers.back().value.push_back(input);
+      return indeterminate;
+    case expecting_newline_2:
+      return expect(input, '\n', header_line_start);
+    case expecting_newline_3:
+      return (input == '\n') ? good : bad;
+    default:
+      return bad;
+    }
+  }
+
+  enum state
+  {
+    method_start, method, uri, http_version_h, http_version_t_1,
+    http_version_t_2, http_version_p, http_version_slash,
+    http_version_major_start, http_version_major, http_version_minor_start,
+    http_version_minor, expecting_newline_1, header_line_start, header_lws,
+    header_name, space_before_header_value, header_value,
+    expecting_newline_2, expecting_newline_3
+  } state_;
+};
+
+// Parse each request with the legacy parser. As in the example, the request
+// and parser are constructed afresh for each request.
+void http_request_legacy(benchmark::state& s)
+{
+  const char* end = browser_request + sizeof(browser_request) - 1;
+  std::size_t failures = 0;
+
+  s.start();
+  for (std::size_t i = 0; i < s.iterations(); ++i)
+  {
+    legacy_request req;
+    legacy_parser parser;
+    if (parser.parse(req, browser_request, end) != legacy_parser::good)
+      ++failures;
+  }
+  s.stop();
+
+  s.add_bytes(s.iterations() * (sizeof(browser_request) - 1));
+  if (failures)
+    throw std::runtime_error("legacy parser failed");
+}
+
+// Parse a sequence of requests from a buffer using the same request object
+// and parser, as on a persistent connection. Each request is first delivered
+// in pieces of the given size, which only matters when it is smaller than
+// the request.
+void parse_requests(benchmark::state& s,
+    const char* text, std::size_t length, std::size_t pipelined,
+    std::size_t piece_size)
+{
+  std::string input;
+  for (std::size_t i = 0; i < pipelined; ++i)
+    input.append(text, length);
+  std::string buffer(input);
+
+  http::server::request_parser parser;
+  http::server::request req;
+  std::size_t failures = 0;
+
+  s.start();
+  for (std::size_t i = 0; i < s.iterations(); i += pipelined)
+  {
+    // Chunked bodies are decoded in place, so restore the input each time.
+    if (text == chunked_request)
+      buffer.assign(input);
+
+    char* begin = &buffer[0];
+    char* const end = begin + buffer.size();
+    for (std::size_t j = 0; j < pipelined && begin != end; ++j)
+    {
+      http::server::request_parser::result_type result;
+      char* next = begin;
+      std::size_t available = 0;
+      do
+      {
+        available = (std::min)(available + piece_size,
+            static_cast<std::size_t>(end - begin));
+        std::tie(result, next) = parser.parse(req, begin, begin + available);
+      } while (result == http::server::request_parser::indeterminate
+          && begin + available != end);
+      if (result != http::server::request_parser::good)
+        ++failures;
+      begin = next;
+    }
+  }
+  s.stop();
+
+  s.add_bytes(s.iterations() * length);
+  if (failures)
+    throw std::runtime_error("parser failed");
+}
+
+// Parse each request with the zero-copy parser.
+void http_request(benchmark::state& s)
+{
+  parse_requests(s, browser_request,
+      sizeof(browser_request) - 1, 1, sizeof(browser_request));
+}
+
+// Parse sixteen pipelined requests at a time.
+void http_request_pipelined(benchmark::state& s)
+{
+  parse_requests(s, browser_request,
+      sizeof(browser_request) - 1, 16, sizeof(browser_request));
+}
+
+// Parse each request as it arrives in 64-byte pieces.
+void http_request_incremental(benchmark::state& s)
+{
+  parse_requests(s, browser_request,
+      sizeof(browser_request) - 1, 1, 64);
+}
+
+// Parse requests with chunked bodies, which are decoded in place.
+void http_request_chunked(benchmark::state& s)
+{
+  parse_requests(s, chunked_request,
+      sizeof(chunked_request) - 1, 16, sizeof(chunked_request));
+}
+
+} // namespace
+
+BENCHMARK("http_request_legacy", http_request_legacy, 200000)
+BENCHMARK("http_request", http_request, 1000000)
+BENCHMARK("http_request_pipelined", http_request_pipelined, 1000000)
+BENCHMARK("http_request_incremental", http_request_incremental, 1000000)
+BENCHMARK("http_request_chunked", http_request_chunked, 1000000)
@@ -0,0 +1,190 @@
+//
+// multicast.cpp
+// ~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <asio/detail/config.hpp>
+
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+// The receiver is compiled directly from the multicast example's sources.
+#include "../../examples/cpp11/multicast/group_receiver.cpp"
+
+#include <asio/io_context.hpp>
+#include <asio/ip/multicast.hpp>
+#include <asio/ip/udp.hpp>
+#include <boost/bind.hpp>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "harness.hpp"
+
+using asio::ip::udp;
+
+namespace {
+
+// The number of groups, and the number of datagrams sent to each group before
+// waiting for them all to be received.
+const std::size_t group_count = 16;
+const std::size_t burst_per_group = 4;
+
+asio::ip::address group_address(std::size_t index)
+{
+  return asio::ip::address_v4(0xEFFF0100 + 1 + index); // 239.255.1.x
+}
+
+// Sends bursts of datagrams to each group in turn, running the io_context
+// until every datagram in a burst has been received. The time taken to
+// receive each burst is recorded. Returns false if the datagrams cannot be
+// sent or received, e.g. when there is no multicast route.
+bool send_bursts(benchmark::state& s, asio::io_context& io_context,
+    unsigned short port, const std::size_t& received)
+{
+  udp::socket sender(io_context, udp::v4());
+  sender.set_option(asio::ip::multicast::hops(0));
+  sender.set_option(asio::ip::multicast::enable_loopback(true));
+
+  char data[64] = "";
+  std::size_t sent = 0;
+  while (sent < s.iterations())
+  {
+    for (std::size_t i = 0; i < burst_per_group; ++i)
+    {
+      for (std::size_t j = 0; j < group_count; ++j)
+      {
+        asio::error_code ec;
+        sender.send_to(asio::buffer(data),
+            udp::endpoint(group_address(j), port), 0, ec);
+        if (ec)
+          return false;
+        ++sent;
+      }
+    }
+
+    // Give up if a burst is not delivered, as the datagrams may be lost.
+    boost::uint64_t start = benchmark::now();
+    io_context.restart();
+    while (received < sent)
+      if (io_context.run_one_for(asio::chrono::seconds(1)) == 0)
+        return false;
+    s.record(benchmark::now() - start);
+  }
+
+  return true;
+}
+
+// One socket per group, each bound to its group's address and with its own
+// asynchronous receive, as in the multicast receiver example.
+class socket_per_group
+{
+public:
+  socket_per_group(udp::socket& socket, std::size_t& received)
+    : socket_(socket),
+      received_(received)
+  {
+    start_receive();
+  }
+
+private:
+  void start_receive()
+  {
+    socket_.async_receive_from(asio::buffer(data_), sender_,
+        boost::bind(&socket_per_group::handle_receive, this, _1));
+  }
+
+  void handle_receive(const asio::error_code& ec)
+  {
+    if (!ec)
+    {
+      ++received_;
+      start_receive();
+    }
+  }
+
+  udp::socket& socket_;
+  udp::endpoint sender_;
+  char data_[1500];
+  std::size_t& received_;
+};
+
+void multicast_socket_per_group(benchmark::state& s)
+{
+  asio::io_context io_context;
+  std::vector<std::unique_ptr<udp::socket> > sockets;
+  std::vector<std::unique_ptr<socket_per_group> > receivers;
+  std::size_t received = 0;
+  unsigned short port = 0;
+
+  try
+  {
+    for (std::size_t i = 0; i < group_count; ++i)
+    {
+      sockets.emplace_back(new udp::socket(io_context, udp::v4()));
+      sockets.back()->set_option(udp::socket::reuse_address(true));
+      sockets.back()->bind(udp::endpoint(group_address(i), port));
+      sockets.back()->set_option(
+          asio::ip::multicast::join_group(group_address(i)));
+      port = sockets.back()->local_endpoint().port();
+      receivers.emplace_back(
+          new socket_per_group(*sockets.back(), received));
+    }
+  }
+  catch (asio::system_error& e)
+  {
+    s.skip(e.what());
+    return;
+  }
+
+  s.start();
+  if (!send_bursts(s, io_context, port, received))
+    s.skip("multicast datagrams not delivered");
+  s.stop();
+}
+
+// All groups received on one socket, with batched reads.
+void multicast_group_receiver(benchmark::state& s)
+{
+  asio::io_context io_context;
+  std::unique_ptr<multicast::group_receiver> receiver;
+  std::size_t received = 0;
+
+  try
+  {
+    receiver.reset(new multicast::group_receiver(io_context,
+          udp::endpoint(asio::ip::address_v4::any(), 0)));
+    for (std::size_t i = 0; i < group_count; ++i)
+    {
+      receiver->join(group_address(i),
+          [&received](const udp::endpoint&, asio::const_buffer)
+          {
+            ++received;
+          });
+    }
+  }
+  catch (asio::system_error& e)
+  {
+    s.skip(e.what());
+    return;
+  }
+
+  // The wildcard bind chose the port.
+  unsigned short port = receiver->local_endpoint().port();
+
+  receiver->start();
+  s.start();
+  if (!send_bursts(s, io_context, port, received))
+    s.skip("multicast datagrams not delivered");
+  s.stop();
+}
+
+} // namespace
+
+BENCHMARK("multicast_socket_per_group", multicast_socket_per_group, 200000)
+BENCHMARK("multicast_group_receiver", multicast_group_receiver, 200000)
+
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
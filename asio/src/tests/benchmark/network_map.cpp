@@ -0,0 +1,174 @@
+//
+// network_map.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <asio/ip/basic_network_map.hpp>
+#include <utility>
+#include <vector>
+#include "harness.hpp"
+
+namespace {
+
+// The number of networks in each table, about the size of a large access
+// control list.
+const std::size_t network_count = 10000;
+
+// The number of distinct addresses looked up in each benchmark.
+const std::size_t address_count = 4096;
+
+unsigned long next_random(unsigned long& state)
+{
+  state = state * 1103515245 + 12345;
+  return (state >> 8) & 0xFFFFFF;
+}
+
+asio::ip::address_v4 random_v4(unsigned long& state)
+{
+  return asio::ip::address_v4(static_cast<asio::ip::address_v4::uint_type>(
+        (next_random(state) << 8) | (next_random(state) & 0xFF)));
+}
+
+asio::ip::address_v6 random_v6(unsigned long& state)
+{
+  asio::ip::address_v6::bytes_type bytes = {{ 0x20, 0x01, 0x0d, 0xb8 }};
+  for (int i = 4; i < 16; ++i)
+    bytes[i] = static_cast<unsigned char>(next_random(state));
+  return asio::ip::address_v6(bytes);
+}
+
+std::vector<std::pair<asio::ip::network_v4, int> > make_v4_networks()
+{
+  std::vector<std::pair<asio::ip::network_v4, int> > networks;
+  unsigned long state = 1;
+  for (std::size_t i = 0; i < network_count; ++i)
+  {
+    unsigned short length = static_cast<unsigned short>(
+        8 + next_random(state) % 25);
+    networks.push_back(std::make_pair(asio::ip::network_v4(
+            random_v4(state), length).canonical(), static_cast<int>(i)));
+  }
+  return networks;
+}
+
+std::vector<std::pair<asio::ip::network_v6, int> > make_v6_networks()
+{
+  std::vector<std::pair<asio::ip::network_v6, int> > networks;
+  unsigned long state = 1;
+  for (std::size_t i = 0; i < network_count; ++i)
+  {
+    unsigned short length = static_cast<unsigned short>(
+        40 + next_random(state) % 25);
+    networks.push_back(std::make_pair(asio::ip::network_v6(
+            random_v6(state), length).canonical(), static_cast<int>(i)));
+  }
+  return networks;
+}
+
+// Look up addresses that fall inside the networks, so that most lookups
+// find a match.
+template <typename Network, typename Address>
+std::vector<Address> make_addresses(
+    const std::vector<std::pair<Network, int> >& networks,
+    Address (*random)(unsigned long&))
+{
+  std::vector<Address> addresses;
+  unsigned long state = 2;
+  for (std::size_t i = 0; i < address_count; ++i)
+  {
+    const Network& net = networks[next_random(state) % networks.size()].first;
+    typename Address::bytes_type net_bytes = net.network().to_bytes();
+    typename Address::bytes_type bytes = random(state).to_bytes();
+    for (int b = 0; b < net.prefix_length() / 8; ++b)
+      bytes[b] = net_bytes[b];
+    addresses.push_back(Address(bytes));
+  }
+  return addresses;
+}
+
+// Prevents the compiler from discarding the results of a lookup.
+long sink;
+
+// Finds the longest matching network by checking every network in turn.
+template <typename Network, typename Address>
+void lookup_linear(benchmark::state& s,
+    const std::vector<std::pair<Network, int> >& networks,
+    const std::vector<Address>& addresses)
+{
+  s.start();
+  for (std::size_t i = 0; i < s.iterations(); ++i)
+  {
+    const Address& addr = addresses[i % address_count];
+    int best = -1;
+    unsigned short best_length = 0;
+    for (std::size_t j = 0; j < networks.size(); ++j)
+    {
+      const Network& net = networks[j].first;
+      if (net.prefix_length() >= best_length
+          && Network(addr, net.prefix_length()).canonical() == net)
+      {
+        best = networks[j].second;
+        best_length = net.prefix_length();
+      }
+    }
+    sink += best;
+  }
+  s.stop();
+}
+
+template <typename Network, typename Address>
+void lookup_map(benchmark::state& s,
+    const std::vector<std::pair<Network, int> >& networks,
+    const std::vector<Address>& addresses)
+{
+  asio::ip::basic_network_map<Network, int> map(
+      networks.begin(), networks.end());
+  s.start();
+  for (std::size_t i = 0; i < s.iterations(); ++i)
+  {
+    const typename asio::ip::basic_network_map<Network, int>::value_type*
+      match = map.lookup(addresses[i % address_count]);
+    sink += match ? match->second : -1;
+  }
+  s.stop();
+}
+
+void network_map_v4_linear(benchmark::state& s)
+{
+  std::vector<std::pair<asio::ip::network_v4, int> > networks
+    = make_v4_networks();
+  lookup_linear(s, networks, make_addresses(networks, random_v4));
+}
+
+void network_map_v4_lookup(benchmark::state& s)
+{
+  std::vector<std::pair<asio::ip::network_v4, int> > networks
+    = make_v4_networks();
+  lookup_map(s, networks, make_addresses(networks, random_v4));
+}
+
+void network_map_v6_linear(benchmark::state& s)
+{
+  std::vector<std::pair<asio::ip::network_v6, int> > networks
+    = make_v6_networks();
+  lookup_linear(s, networks, make_addresses(networks, random_v6));
+}
+
+void network_map_v6_lookup(benchmark::state& s)
+{
+  std::vector<std::pair<asio::ip::network_v6, int> > networks
+    = make_v6_networks();
+  lookup_map(s, networks, make_addresses(networks, random_v6));
+}
+
+} // namespace
+
+BENCHMARK("network_map_v4_linear", network_map_v4_linear, 2000)
+BENCHMARK("network_map_v4_lookup", network_map_v4_lookup, 5000000)
+BENCHMARK("network_map_v6_linear", network_map_v6_linear, 1000)
+BENCHMARK("network_map_v6_lookup", network_map_v6_lookup, 2000000)
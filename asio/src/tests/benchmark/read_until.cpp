@@ -0,0 +1,118 @@
+//
+// read_until.cpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <asio/buffer.hpp>
+#include <asio/error.hpp>
+#include <asio/read_until.hpp>
+#include <asio/streambuf.hpp>
+#include <algorithm>
+#include <string>
+#include "harness.hpp"
+
+namespace {
+
+// A synchronous stream that returns data from memory in fixed size chunks.
+class memory_stream
+{
+public:
+  memory_stream(const std::string& data, std::size_t chunk_size)
+    : data_(data),
+      position_(0),
+      chunk_size_(chunk_size)
+  {
+  }
+
+  template <typename MutableBufferSequence>
+  std::size_t read_some(const MutableBufferSequence& buffers)
+  {
+    asio::error_code ec;
+    std::size_t n = read_some(buffers, ec);
+    asio::detail::throw_error(ec);
+    return n;
+  }
+
+  template <typename MutableBufferSequence>
+  std::size_t read_some(const MutableBufferSequence& buffers,
+      asio::error_code& ec)
+  {
+    if (position_ == data_.size())
+    {
+      ec = asio::error::eof;
+      return 0;
+    }
+
+    std::size_t n = asio::buffer_copy(buffers,
+        asio::buffer(data_.data() + position_,
+          (std::min)(chunk_size_, data_.size() - position_)));
+    position_ += n;
+    ec = asio::error_code();
+    return n;
+  }
+
+private:
+  const std::string& data_;
+  std::size_t position_;
+  std::size_t chunk_size_;
+};
+
+// Build a sequence of HTTP-style header lines of varying lengths.
+std::string make_lines(std::size_t count)
+{
+  static const char* const lines[] =
+  {
+    "GET /index.html HTTP/1.1\r\n",
+    "Host: www.example.com\r\n",
+    "User-Agent: benchmark/1.0 (compatible; asio)\r\n",
+    "Accept: text/html,application/xhtml+xml,application/xml;q=0.9\r\n",
+    "Connection: keep-alive\r\n",
+    "\r\n"
+  };
+  const std::size_t num_lines = sizeof(lines) / sizeof(lines[0]);
+
+  std::string data;
+  for (std::size_t i = 0; i < count; ++i)
+    data += lines[i % num_lines];
+  return data;
+}
+
+template <typename Delimiter>
+void read_lines(benchmark::state& s, Delimiter delimiter)
+{
+  std::string data = make_lines(s.iterations());
+  memory_stream stream(data, 4096);
+  asio::streambuf buffer;
+
+  s.start();
+  for (std::size_t i = 0; i < s.iterations(); ++i)
+  {
+    std::size_t n = asio::read_until(stream, buffer, delimiter);
+    buffer.consume(n);
+  }
+  s.stop();
+
+  s.add_bytes(data.size());
+}
+
+// Read CRLF-terminated lines using a string delimiter.
+void read_until_string(benchmark::state& s)
+{
+  read_lines(s, std::string("\r\n"));
+}
+
+// Read LF-terminated lines using a character delimiter.
+void read_until_char(benchmark::state& s)
+{
+  read_lines(s, '\n');
+}
+
+} // namespace
+
+BENCHMARK("read_until_string", read_until_string, 1000000)
+BENCHMARK("read_until_char", read_until_char, 1000000)
@@ -0,0 +1,191 @@
+//
+// relay.cpp
+// ~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// The relay is taken directly from the SOCKS 4 example.
+#include "../../examples/cpp11/socks4/relay.hpp"
+
+#include <asio/detail/thread.hpp>
+#include <asio/io_context.hpp>
+#include <asio/ip/tcp.hpp>
+#include <asio/write.hpp>
+#include <boost/bind.hpp>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "harness.hpp"
+
+using asio::ip::tcp;
+
+namespace {
+
+// The size of each block written by the source.
+const std::size_t block_size = 65536;
+
+// A relay written as a ping-pong of reads and writes through a fixed 1KB
+// buffer in each direction, closing both sockets when either direction ends.
+namespace legacy {
+
+class relay
+  : public std::enable_shared_from_this<relay>
+{
+public:
+  relay(tcp::socket first, tcp::socket second)
+    : first_(std::move(first)),
+      second_(std::move(second))
+  {
+  }
+
+  void start()
+  {
+    do_read(first_, second_, upstream_data_);
+    do_read(second_, first_, downstream_data_);
+  }
+
+  std::size_t bytes_upstream() const
+  {
+    return bytes_upstream_;
+  }
+
+private:
+  void do_read(tcp::socket& from, tcp::socket& to, char* data)
+  {
+    auto self(shared_from_this());
+    from.async_read_some(asio::buffer(data, 1024),
+        [this, self, &from, &to, data](std::error_code ec, std::size_t length)
+        {
+          if (!ec)
+          {
+            do_write(from, to, data, length);
+          }
+          else
+          {
+            close();
+          }
+        });
+  }
+
+  void do_write(tcp::socket& from, tcp::socket& to,
+      char* data, std::size_t length)
+  {
+    auto self(shared_from_this());
+    asio::async_write(to, asio::buffer(data, length),
+        [this, self, &from, &to, data](std::error_code ec, std::size_t length)
+        {
+          if (!ec)
+          {
+            if (&from == &first_)
+              bytes_upstream_ += length;
+            do_read(from, to, data);
+          }
+          else
+          {
+            close();
+          }
+        });
+  }
+
+  void close()
+  {
+    std::error_code ignored_ec;
+    first_.close(ignored_ec);
+    second_.close(ignored_ec);
+  }
+
+  tcp::socket first_;
+  tcp::socket second_;
+  char upstream_data_[1024];
+  char downstream_data_[1024];
+  std::size_t bytes_upstream_ = 0;
+};
+
+} // namespace legacy
+
+// Write the given number of blocks, shut down the sending side, and then read
+// until the relay closes the connection.
+void source(tcp::socket* socket, std::size_t blocks)
+{
+  std::vector<char> data(block_size, 'x');
+  asio::error_code ec;
+  for (std::size_t i = 0; i < blocks && !ec; ++i)
+    asio::write(*socket, asio::buffer(data), ec);
+  socket->shutdown(tcp::socket::shutdown_send, ec);
+  while (!ec)
+    socket->read_some(asio::buffer(data), ec);
+}
+
+// Read and discard everything received, and then shut down the sending side.
+void sink(tcp::socket* socket)
+{
+  static char data[65536];
+  asio::error_code ec;
+  while (!ec)
+    socket->read_some(asio::buffer(data), ec);
+  socket->shutdown(tcp::socket::shutdown_send, ec);
+}
+
+// Relay data from a source to a sink over the loopback interface. The relay's
+// sockets are the server ends of the two connections.
+template <typename Relay, typename... Args>
+void relay_data(benchmark::state& s, Args... args)
+{
+  asio::io_context io_context;
+  tcp::acceptor acceptor(io_context,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  tcp::socket source_socket(io_context), first(io_context);
+  source_socket.connect(acceptor.local_endpoint());
+  acceptor.accept(first);
+  tcp::socket sink_socket(io_context), second(io_context);
+  sink_socket.connect(acceptor.local_endpoint());
+  acceptor.accept(second);
+
+  std::shared_ptr<Relay> r = std::make_shared<Relay>(
+      std::move(first), std::move(second), args...);
+  r->start();
+
+  s.start();
+  asio::detail::thread sink_thread(boost::bind(sink, &sink_socket));
+  asio::detail::thread source_thread(
+      boost::bind(source, &source_socket, s.iterations()));
+  io_context.run();
+  source_thread.join();
+  sink_thread.join();
+  s.stop();
+
+  if (r->bytes_upstream() != s.iterations() * block_size)
+    throw std::runtime_error("relay incomplete");
+  s.add_bytes(r->bytes_upstream());
+}
+
+typedef socks4::relay<tcp::socket> tcp_relay;
+
+void relay_legacy_1k(benchmark::state& s)
+{
+  relay_data<legacy::relay>(s);
+}
+
+void relay_copy(benchmark::state& s)
+{
+  relay_data<tcp_relay>(s, tcp_relay::copy);
+}
+
+void relay_zero_copy(benchmark::state& s)
+{
+#if defined(ASIO_HAS_SPLICE)
+  relay_data<tcp_relay>(s, tcp_relay::zero_copy);
+#else // defined(ASIO_HAS_SPLICE)
+  s.skip("splice not supported");
+#endif // defined(ASIO_HAS_SPLICE)
+}
+
+} // namespace
+
+BENCHMARK("relay_legacy_1k", relay_legacy_1k, 8192)
+BENCHMARK("relay_copy", relay_copy, 8192)
+BENCHMARK("relay_zero_copy", relay_zero_copy, 8192)
@@ -0,0 +1,98 @@
+//
+// resolver.cpp
+// ~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <asio/ip/tcp.hpp>
+#include <cstring>
+#include <string>
+#include "harness.hpp"
+
+namespace {
+
+// The number of addresses returned for each name, as for a name with
+// several IPv4 and IPv6 addresses.
+const int address_count = 8;
+
+// An addrinfo list as returned by getaddrinfo, built without calling into the
+// operating system so that only the construction of the results is measured.
+class address_info_list
+{
+public:
+  address_info_list()
+  {
+    std::memset(addresses_, 0, sizeof(addresses_));
+    std::memset(infos_, 0, sizeof(infos_));
+    for (int i = 0; i < address_count; ++i)
+    {
+      asio::ip::tcp::endpoint endpoint(
+          asio::ip::address_v4(0x0A000001 + i), 443);
+      std::memcpy(&addresses_[i], endpoint.data(), endpoint.size());
+      infos_[i].ai_family = ASIO_OS_DEF(AF_INET);
+      infos_[i].ai_addr = &addresses_[i].base;
+      infos_[i].ai_addrlen = static_cast<int>(endpoint.size());
+      infos_[i].ai_next = i + 1 < address_count ? &infos_[i + 1] : 0;
+    }
+  }
+
+  asio::detail::addrinfo_type* get()
+  {
+    return &infos_[0];
+  }
+
+private:
+  union address_storage
+  {
+    asio::detail::socket_addr_type base;
+    asio::detail::sockaddr_storage_type storage;
+  } addresses_[address_count];
+  asio::detail::addrinfo_type infos_[address_count];
+};
+
+// Prevents the compiler from discarding the results.
+std::size_t sink;
+
+void resolver_results_create(benchmark::state& s)
+{
+  address_info_list list;
+  std::string host_name = "www.example-service-name.com";
+  std::string service_name = "https";
+  s.start();
+  for (std::size_t i = 0; i < s.iterations(); ++i)
+  {
+    asio::ip::tcp::resolver::results_type results =
+      asio::ip::tcp::resolver::results_type::create(
+          list.get(), host_name, service_name);
+    sink += results.size();
+  }
+  s.stop();
+}
+
+void resolver_entry_copy(benchmark::state& s)
+{
+  address_info_list list;
+  asio::ip::tcp::resolver::results_type results =
+    asio::ip::tcp::resolver::results_type::create(list.get(),
+        "www.example-service-name.com", "https");
+  s.start();
+  for (std::size_t i = 0; i < s.iterations(); ++i)
+  {
+    asio::ip::tcp::resolver::results_type::const_iterator iter;
+    for (iter = results.begin(); iter != results.end(); ++iter)
+    {
+      asio::ip::tcp::resolver::results_type::value_type entry = *iter;
+      sink += entry.endpoint().port();
+    }
+  }
+  s.stop();
+}
+
+} // namespace
+
+BENCHMARK("resolver_results_create", resolver_results_create, 1000000)
+BENCHMARK("resolver_entry_copy", resolver_entry_copy, 1000000)
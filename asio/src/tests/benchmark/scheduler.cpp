@@ -0,0 +1,158 @@
+//
+// scheduler.cpp
+// ~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <asio/dispatch.hpp>
+#include <asio/io_context.hpp>
+#include <asio/post.hpp>
+#include <asio/steady_timer.hpp>
+#include <asio/strand.hpp>
+#include <asio/thread_pool.hpp>
+#include <boost/bind.hpp>
+#include "harness.hpp"
+
+namespace {
+
+typedef asio::strand<asio::io_context::executor_type> io_strand;
+typedef asio::strand<asio::thread_pool::executor_type> pool_strand;
+
+struct increment
+{
+  std::size_t* count;
+
+  void operator()()
+  {
+    ++*count;
+  }
+};
+
+// A handler that posts itself until its count is exhausted.
+template <typename Executor>
+struct chain
+{
+  Executor ex;
+  std::size_t remaining;
+
+  void operator()()
+  {
+    if (--remaining > 0)
+      asio::post(ex, *this);
+  }
+};
+
+// Post handlers from outside the io_context, then run them all.
+void post(benchmark::state& s)
+{
+  asio::io_context io_context;
+  std::size_t count = 0;
+  increment h = { &count };
+
+  for (std::size_t i = 0; i < s.iterations(); ++i)
+    asio::post(io_context, h);
+  io_context.run();
+}
+
+// Post each handler from within the previous one.
+void post_chain(benchmark::state& s)
+{
+  asio::io_context io_context;
+  chain<asio::io_context::executor_type> h =
+    { io_context.get_executor(), s.iterations() };
+
+  asio::post(io_context, h);
+  io_context.run();
+}
+
+void dispatch_loop(asio::io_context* io_context, std::size_t iterations)
+{
+  std::size_t count = 0;
+  increment h = { &count };
+  for (std::size_t i = 0; i < iterations; ++i)
+    asio::dispatch(*io_context, h);
+}
+
+// Dispatch handlers from within the io_context, so that they run inline.
+void dispatch(benchmark::state& s)
+{
+  asio::io_context io_context;
+  asio::post(io_context,
+      boost::bind(dispatch_loop, &io_context, s.iterations()));
+  io_context.run();
+}
+
+// Post handlers through a strand on a single threaded io_context.
+void strand_post(benchmark::state& s)
+{
+  asio::io_context io_context;
+  io_strand strand(io_context.get_executor());
+  std::size_t count = 0;
+  increment h = { &count };
+
+  for (std::size_t i = 0; i < s.iterations(); ++i)
+    asio::post(strand, h);
+  io_context.run();
+}
+
+// Run chains of handlers on several strands sharing a pool of threads.
+void strand_pool(benchmark::state& s)
+{
+  const std::size_t num_threads = 4;
+  const std::size_t num_strands = 16;
+
+  asio::thread_pool pool(num_threads);
+  for (std::size_t i = 0; i < num_strands; ++i)
+  {
+    chain<pool_strand> h =
+      { pool_strand(pool.get_executor()), s.iterations() / num_strands + 1 };
+    asio::post(h.ex, h);
+  }
+  pool.join();
+}
+
+struct wait_handler
+{
+  void operator()(const asio::error_code&)
+  {
+  }
+};
+
+// Arm a timer and cancel it, recording the time taken by each pair.
+void timer_arm_cancel(benchmark::state& s)
+{
+  asio::io_context io_context;
+  asio::steady_timer timer(io_context);
+
+  for (std::size_t i = 0; i < s.iterations(); ++i)
+  {
+    boost::uint64_t start = benchmark::now();
+    timer.expires_after(asio::chrono::hours(1));
+    timer.async_wait(wait_handler());
+    timer.cancel();
+    s.record(benchmark::now() - start);
+
+    // Periodically run the cancelled handlers so they do not accumulate.
+    if (i % 1024 == 1023)
+    {
+      io_context.restart();
+      io_context.poll();
+    }
+  }
+
+  io_context.restart();
+  io_context.run();
+}
+
+} // namespace
+
+BENCHMARK("post", post, 1000000)
+BENCHMARK("post_chain", post_chain, 1000000)
+BENCHMARK("dispatch", dispatch, 1000000)
+BENCHMARK("strand_post", strand_post, 1000000)
+BENCHMARK("strand_pool", strand_pool, 1000000)
+BENCHMARK("timer_arm_cancel", timer_arm_cancel, 200000)
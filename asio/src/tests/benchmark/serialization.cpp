@@ -0,0 +1,199 @@
+//
+// serialization.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// The connection is taken directly from the serialization example. The text
+// archive connection is not measured, as it would require linking against
+// Boost.Serialization.
+#include "../../examples/cpp03/serialization/framed_connection.hpp"
+#include "../../examples/cpp03/serialization/stock.hpp"
+
+#include <asio/io_context.hpp>
+#include <asio/ip/tcp.hpp>
+#include <boost/bind.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "harness.hpp"
+
+using asio::ip::tcp;
+using s11n_example::stock;
+
+namespace {
+
+// The stocks sent by the example's server.
+std::vector<stock> make_stocks()
+{
+  std::vector<stock> stocks;
+  stock s;
+  s.code = "ABC";
+  s.name = "A Big Company";
+  s.open_price = 4.56;
+  s.high_price = 5.12;
+  s.low_price = 4.33;
+  s.last_price = 4.98;
+  s.buy_price = 4.96;
+  s.buy_quantity = 1000;
+  s.sell_price = 4.99;
+  s.sell_quantity = 2000;
+  stocks.push_back(s);
+  s.code = "DEF";
+  s.name = "Developer Entertainment Firm";
+  s.open_price = 20.24;
+  s.high_price = 22.88;
+  s.low_price = 19.50;
+  s.last_price = 19.76;
+  s.buy_price = 19.72;
+  s.buy_quantity = 34000;
+  s.sell_price = 19.85;
+  s.sell_quantity = 45000;
+  stocks.push_back(s);
+  return stocks;
+}
+
+bool equal(const std::vector<stock>& a, const std::vector<stock>& b)
+{
+  if (a.size() != b.size())
+    return false;
+  for (std::size_t i = 0; i < a.size(); ++i)
+  {
+    if (a[i].code != b[i].code || a[i].name != b[i].name
+        || a[i].last_price != b[i].last_price
+        || a[i].sell_quantity != b[i].sell_quantity)
+      return false;
+  }
+  return true;
+}
+
+// Encode and decode a message in memory using the binary archives, reusing
+// the output string as the framed connection does.
+void serialization_binary(benchmark::state& s)
+{
+  std::vector<stock> stocks = make_stocks();
+  std::vector<stock> result;
+  std::string data;
+  std::size_t failures = 0;
+
+  s.start();
+  for (std::size_t i = 0; i < s.iterations(); ++i)
+  {
+    data.clear();
+    s11n_example::binary_oarchive oarchive(data);
+    oarchive << stocks;
+
+    s11n_example::binary_iarchive iarchive(asio::buffer(data));
+    iarchive >> result;
+    if (!iarchive.good() || !equal(result, stocks))
+      ++failures;
+  }
+  s.stop();
+
+  if (failures)
+    throw std::runtime_error("decoding failed");
+}
+
+// Sends a stream of messages from one connection to another on the loopback
+// interface, with one write and one read outstanding at a time.
+template <typename Connection>
+class message_stream
+{
+public:
+  message_stream(asio::io_context& io_context, std::size_t count)
+    : sender_(io_context.get_executor()),
+      receiver_(io_context.get_executor()),
+      stocks_(make_stocks()),
+      count_(count),
+      sent_(0),
+      received_(0),
+      failed_(false)
+  {
+    tcp::acceptor acceptor(io_context,
+        tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+    sender_.socket().connect(acceptor.local_endpoint());
+    sender_.socket().set_option(tcp::no_delay(true));
+    acceptor.accept(receiver_.socket());
+  }
+
+  void start()
+  {
+    start_write();
+    start_read();
+  }
+
+  bool failed() const
+  {
+    return failed_ || received_ != count_ || !equal(result_, stocks_);
+  }
+
+private:
+  void start_write()
+  {
+    sender_.async_write(stocks_,
+        boost::bind(&message_stream::handle_write, this,
+          asio::placeholders::error));
+  }
+
+  void handle_write(const asio::error_code& e)
+  {
+    if (e)
+      failed_ = true;
+    else if (++sent_ < count_)
+      start_write();
+  }
+
+  void start_read()
+  {
+    receiver_.async_read(result_,
+        boost::bind(&message_stream::handle_read, this,
+          asio::placeholders::error));
+  }
+
+  void handle_read(const asio::error_code& e)
+  {
+    if (e)
+      failed_ = true;
+    else if (++received_ < count_)
+      start_read();
+  }
+
+  Connection sender_;
+  Connection receiver_;
+  std::vector<stock> stocks_;
+  std::vector<stock> result_;
+  std::size_t count_;
+  std::size_t sent_;
+  std::size_t received_;
+  bool failed_;
+};
+
+template <typename Connection>
+void stream_messages(benchmark::state& s)
+{
+  asio::io_context io_context;
+  message_stream<Connection> stream(io_context, s.iterations());
+
+  s.start();
+  stream.start();
+  io_context.run();
+  s.stop();
+
+  if (stream.failed())
+    throw std::runtime_error("stream failed");
+}
+
+void serialization_binary_connection(benchmark::state& s)
+{
+  stream_messages<s11n_example::framed_connection>(s);
+}
+
+} // namespace
+
+BENCHMARK("serialization_binary", serialization_binary, 1000000)
+BENCHMARK("serialization_binary_connection",
+    serialization_binary_connection, 200000)
@@ -0,0 +1,315 @@
+//
+// socket.cpp
+// ~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <asio/io_context.hpp>
+#include <asio/ip/tcp.hpp>
+#include <asio/ip/udp.hpp>
+#include <asio/read.hpp>
+#include <asio/steady_timer.hpp>
+#include <asio/thread.hpp>
+#include <asio/write.hpp>
+#include <boost/bind.hpp>
+#include <vector>
+#include "harness.hpp"
+
+using asio::ip::tcp;
+using asio::ip::udp;
+
+namespace {
+
+// Accepts a single connection on the loopback interface and echoes back
+// everything it receives.
+class tcp_echo_server
+{
+public:
+  typedef tcp::endpoint endpoint_type;
+
+  explicit tcp_echo_server(asio::io_context& io_context)
+    : acceptor_(io_context,
+        tcp::endpoint(asio::ip::address_v4::loopback(), 0)),
+      socket_(io_context),
+      data_(65536)
+  {
+    acceptor_.async_accept(socket_,
+        boost::bind(&tcp_echo_server::handle_accept, this, _1));
+  }
+
+  tcp::endpoint local_endpoint() const
+  {
+    return acceptor_.local_endpoint();
+  }
+
+private:
+  void handle_accept(const asio::error_code& ec)
+  {
+    if (!ec)
+    {
+      socket_.set_option(tcp::no_delay(true));
+      start_read();
+    }
+  }
+
+  void start_read()
+  {
+    socket_.async_read_some(asio::buffer(data_),
+        boost::bind(&tcp_echo_server::handle_read, this, _1, _2));
+  }
+
+  void handle_read(const asio::error_code& ec, std::size_t n)
+  {
+    if (!ec)
+    {
+      asio::async_write(socket_, asio::buffer(data_, n),
+          boost::bind(&tcp_echo_server::handle_write, this, _1));
+    }
+  }
+
+  void handle_write(const asio::error_code& ec)
+  {
+    if (!ec)
+      start_read();
+  }
+
+  tcp::acceptor acceptor_;
+  tcp::socket socket_;
+  std::vector<unsigned char> data_;
+};
+
+// Echoes back every datagram it receives on the loopback interface.
+class udp_echo_server
+{
+public:
+  typedef udp::endpoint endpoint_type;
+
+  explicit udp_echo_server(asio::io_context& io_context)
+    : socket_(io_context, udp::endpoint(asio::ip::address_v4::loopback(), 0)),
+      data_(65536)
+  {
+    start_receive();
+  }
+
+  udp::endpoint local_endpoint() const
+  {
+    return socket_.local_endpoint();
+  }
+
+private:
+  void start_receive()
+  {
+    socket_.async_receive_from(asio::buffer(data_), sender_,
+        boost::bind(&udp_echo_server::handle_receive, this, _1, _2));
+  }
+
+  void handle_receive(const asio::error_code& ec, std::size_t n)
+  {
+    if (!ec)
+    {
+      socket_.async_send_to(asio::buffer(data_, n), sender_,
+          boost::bind(&udp_echo_server::handle_send, this, _1));
+    }
+  }
+
+  void handle_send(const asio::error_code& ec)
+  {
+    if (!ec)
+      start_receive();
+  }
+
+  udp::socket socket_;
+  udp::endpoint sender_;
+  std::vector<unsigned char> data_;
+};
+
+// Runs an echo server on its own thread for the lifetime of the object.
+template <typename Server>
+class echo_server_thread
+{
+public:
+  echo_server_thread()
+    : server_(io_context_),
+      work_(asio::make_work_guard(io_context_)),
+      thread_(boost::bind(&asio::io_context::run, &io_context_))
+  {
+  }
+
+  ~echo_server_thread()
+  {
+    io_context_.stop();
+    thread_.join();
+  }
+
+  typename Server::endpoint_type local_endpoint() const
+  {
+    return server_.local_endpoint();
+  }
+
+private:
+  asio::io_context io_context_;
+  Server server_;
+  asio::executor_work_guard<asio::io_context::executor_type> work_;
+  asio::thread thread_;
+};
+
+// Send each block over TCP and wait for it to be echoed back.
+void tcp_round_trips(benchmark::state& s, std::size_t block_size)
+{
+  echo_server_thread<tcp_echo_server> server;
+
+  asio::io_context io_context;
+  tcp::socket socket(io_context);
+  socket.connect(server.local_endpoint());
+  socket.set_option(tcp::no_delay(true));
+
+  std::vector<unsigned char> write_buf(block_size);
+  std::vector<unsigned char> read_buf(block_size);
+
+  s.start();
+  for (std::size_t i = 0; i < s.iterations(); ++i)
+  {
+    boost::uint64_t start = benchmark::now();
+    asio::write(socket, asio::buffer(write_buf));
+    asio::read(socket, asio::buffer(read_buf));
+    s.record(benchmark::now() - start);
+  }
+  s.stop();
+
+  s.add_bytes(2 * block_size * s.iterations());
+}
+
+void tcp_echo_latency(benchmark::state& s)
+{
+  tcp_round_trips(s, 64);
+}
+
+void tcp_echo_throughput(benchmark::state& s)
+{
+  tcp_round_trips(s, 16384);
+}
+
+// Handlers for a read that is abandoned when a timer expires.
+void handle_timed_read(const asio::error_code& ec,
+    asio::steady_timer* timer, asio::error_code* result)
+{
+  *result = ec;
+  timer->cancel();
+}
+
+void handle_read_timeout(const asio::error_code& ec, tcp::socket* socket)
+{
+  if (!ec)
+    socket->cancel();
+}
+
+// Send each block over TCP and wait for it to be echoed back, giving up if
+// the echo takes longer than a timeout. The timeout is implemented with an
+// asynchronous read and a timer, as is needed without read_for.
+void tcp_timed_echo_async(benchmark::state& s)
+{
+  echo_server_thread<tcp_echo_server> server;
+
+  asio::io_context io_context;
+  tcp::socket socket(io_context);
+  socket.connect(server.local_endpoint());
+  socket.set_option(tcp::no_delay(true));
+  asio::steady_timer timer(io_context);
+
+  std::vector<unsigned char> write_buf(64);
+  std::vector<unsigned char> read_buf(64);
+
+  s.start();
+  for (std::size_t i = 0; i < s.iterations(); ++i)
+  {
+    boost::uint64_t start = benchmark::now();
+    asio::write(socket, asio::buffer(write_buf));
+    asio::error_code ec;
+    asio::async_read(socket, asio::buffer(read_buf),
+        boost::bind(handle_timed_read, _1, &timer, &ec));
+    timer.expires_after(asio::chrono::seconds(5));
+    timer.async_wait(boost::bind(handle_read_timeout, _1, &socket));
+    io_context.restart();
+    io_context.run();
+    if (ec)
+      break;
+    s.record(benchmark::now() - start);
+  }
+  s.stop();
+
+  s.add_bytes(2 * 64 * s.iterations());
+}
+
+// The same exchange, with the timeout implemented by read_for.
+void tcp_timed_echo_read_for(benchmark::state& s)
+{
+  echo_server_thread<tcp_echo_server> server;
+
+  asio::io_context io_context;
+  tcp::socket socket(io_context);
+  socket.connect(server.local_endpoint());
+  socket.set_option(tcp::no_delay(true));
+
+  std::vector<unsigned char> write_buf(64);
+  std::vector<unsigned char> read_buf(64);
+
+  s.start();
+  for (std::size_t i = 0; i < s.iterations(); ++i)
+  {
+    boost::uint64_t start = benchmark::now();
+    asio::write(socket, asio::buffer(write_buf));
+    asio::read_for(socket, asio::buffer(read_buf), asio::chrono::seconds(5));
+    s.record(benchmark::now() - start);
+  }
+  s.stop();
+
+  s.add_bytes(2 * 64 * s.iterations());
+}
+
+// Send each datagram over UDP and wait for it to be echoed back.
+void udp_round_trips(benchmark::state& s, std::size_t datagram_size)
+{
+  echo_server_thread<udp_echo_server> server;
+
+  asio::io_context io_context;
+  udp::socket socket(io_context);
+  socket.connect(server.local_endpoint());
+
+  std::vector<unsigned char> write_buf(datagram_size);
+  std::vector<unsigned char> read_buf(datagram_size);
+
+  s.start();
+  for (std::size_t i = 0; i < s.iterations(); ++i)
+  {
+    boost::uint64_t start = benchmark::now();
+    socket.send(asio::buffer(write_buf));
+    socket.receive(asio::buffer(read_buf));
+    s.record(benchmark::now() - start);
+  }
+  s.stop();
+
+  s.add_bytes(2 * datagram_size * s.iterations());
+}
+
+void udp_echo_latency(benchmark::state& s)
+{
+  udp_round_trips(s, 64);
+}
+
+void udp_echo_throughput(benchmark::state& s)
+{
+  udp_round_trips(s, 8192);
+}
+
+} // namespace
+
+BENCHMARK("tcp_echo_latency", tcp_echo_latency, 20000)
+BENCHMARK("tcp_timed_echo_async", tcp_timed_echo_async, 20000)
+BENCHMARK("tcp_timed_echo_read_for", tcp_timed_echo_read_for, 20000)
+BENCHMARK("tcp_echo_throughput", tcp_echo_throughput, 10000)
+BENCHMARK("udp_echo_latency", udp_echo_latency, 20000)
+BENCHMARK("udp_echo_throughput", udp_echo_throughput, 10000)
@@ -0,0 +1,222 @@
+//
+// local_channel.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <asio/io_context.hpp>
+#include <asio/read.hpp>
+#include <asio/write.hpp>
+#include <asio/local/connect_pair.hpp>
+#include <asio/local/shared_memory_channel.hpp>
+#include <asio/local/stream_protocol.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "high_res_clock.hpp"
+
+using asio::local::shared_memory_channel;
+using asio::local::stream_protocol;
+using boost::posix_time::ptime;
+using boost::posix_time::microsec_clock;
+
+const int num_samples = 100000;
+const int num_messages = 1000000;
+
+// Each transport provides a blocking message exchange between a parent and a
+// forked child. Messages over the socket are fixed length, so that they can
+// be framed with asio::read().
+
+struct shm_transport
+{
+  shm_transport(asio::io_context& ioc)
+    : to_child_writer(ioc), to_child_reader(ioc),
+      to_parent_writer(ioc), to_parent_reader(ioc)
+  {
+    asio::local::create_shared_memory_channel(
+        to_child_writer, to_child_reader, 1 << 20);
+    asio::local::create_shared_memory_channel(
+        to_parent_writer, to_parent_reader, 1 << 20);
+  }
+
+  void become_parent()
+  {
+    to_child_reader.release();
+    to_parent_writer.release();
+  }
+
+  void become_child()
+  {
+    to_child_writer.release();
+    to_parent_reader.release();
+  }
+
+  void send(const std::vector<char>& buf, bool to_child)
+  {
+    (to_child ? to_child_writer : to_parent_writer).write(asio::buffer(buf));
+  }
+
+  bool receive(std::vector<char>& buf, bool in_child)
+  {
+    asio::error_code ec;
+    (in_child ? to_child_reader : to_parent_reader).read(
+        asio::buffer(buf), ec);
+    return !ec;
+  }
+
+  void close(bool in_child)
+  {
+    (in_child ? to_parent_writer : to_child_writer).close();
+  }
+
+  shared_memory_channel to_child_writer, to_child_reader;
+  shared_memory_channel to_parent_writer, to_parent_reader;
+};
+
+struct socket_transport
+{
+  socket_transport(asio::io_context& ioc)
+    : parent_socket(ioc), child_socket(ioc)
+  {
+    asio::local::connect_pair(parent_socket, child_socket);
+  }
+
+  void become_parent()
+  {
+    child_socket.close();
+  }
+
+  void become_child()
+  {
+    parent_socket.close();
+  }
+
+  void send(const std::vector<char>& buf, bool to_child)
+  {
+    asio::write(to_child ? parent_socket : child_socket, asio::buffer(buf));
+  }
+
+  bool receive(std::vector<char>& buf, bool in_child)
+  {
+    asio::error_code ec;
+    asio::read(in_child ? child_socket : parent_socket,
+        asio::buffer(buf), ec);
+    return !ec;
+  }
+
+  void close(bool in_child)
+  {
+    (in_child ? child_socket : parent_socket).shutdown(
+        stream_protocol::socket::shutdown_send);
+  }
+
+  stream_protocol::socket parent_socket, child_socket;
+};
+
+template <typename Transport>
+void run_child(Transport& t, std::size_t buf_size)
+{
+  t.become_child();
+  std::vector<char> buf(buf_size);
+
+  // Echo each latency sample.
+  for (int i = 0; i < num_samples; ++i)
+  {
+    t.receive(buf, true);
+    t.send(buf, false);
+  }
+
+  // Then send a stream of messages as fast as possible.
+  for (int i = 0; i < num_messages; ++i)
+    t.send(buf, false);
+  t.close(true);
+}
+
+template <typename Transport>
+void run_parent(Transport& t, std::size_t buf_size)
+{
+  t.become_parent();
+  std::vector<char> buf(buf_size);
+
+  ptime start = microsec_clock::universal_time();
+  boost::uint64_t start_hr = high_res_clock();
+
+  std::vector<boost::uint64_t> samples(num_samples);
+  for (int i = 0; i < num_samples; ++i)
+  {
+    boost::uint64_t t0 = high_res_clock();
+    t.send(buf, true);
+    t.receive(buf, false);
+    samples[i] = high_res_clock() - t0;
+  }
+
+  ptime stop = microsec_clock::universal_time();
+  boost::uint64_t stop_hr = high_res_clock();
+  boost::uint64_t elapsed_usec = (stop - start).total_microseconds();
+  boost::uint64_t elapsed_hr = stop_hr - start_hr;
+  double scale = 1.0 * elapsed_usec / elapsed_hr;
+
+  std::sort(samples.begin(), samples.end());
+  std::printf("round trip latency (usec)\n");
+  std::printf("  0.0%%\t%f\n", samples[0] * scale);
+  std::printf(" 10.0%%\t%f\n", samples[num_samples / 10 - 1] * scale);
+  std::printf(" 50.0%%\t%f\n", samples[num_samples * 5 / 10 - 1] * scale);
+  std::printf(" 90.0%%\t%f\n", samples[num_samples * 9 / 10 - 1] * scale);
+  std::printf(" 99.0%%\t%f\n", samples[num_samples * 99 / 100 - 1] * scale);
+  std::printf(" 99.9%%\t%f\n", samples[num_samples * 999 / 1000 - 1] * scale);
+  std::printf("100.0%%\t%f\n", samples[num_samples - 1] * scale);
+
+  start = microsec_clock::universal_time();
+  int received = 0;
+  while (t.receive(buf, false))
+    ++received;
+  stop = microsec_clock::universal_time();
+  elapsed_usec = (stop - start).total_microseconds();
+
+  std::printf("throughput\n");
+  std::printf("  messages/sec\t%f\n", received * 1e6 / elapsed_usec);
+  std::printf("  MB/sec\t%f\n", received * 1.0 * buf_size / elapsed_usec);
+}
+
+template <typename Transport>
+void run(std::size_t buf_size)
+{
+  asio::io_context io_context;
+  Transport t(io_context);
+
+  pid_t pid = ::fork();
+  if (pid == 0)
+  {
+    io_context.notify_fork(asio::io_context::fork_child);
+    run_child(t, buf_size);
+    ::_exit(0);
+  }
+
+  run_parent(t, buf_size);
+  ::waitpid(pid, 0, 0);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 3)
+  {
+    std::fprintf(stderr, "Usage: local_channel <bufsize> {shm|socket}\n");
+    return 1;
+  }
+
+  std::size_t buf_size = static_cast<std::size_t>(std::atoi(argv[1]));
+
+  if (std::strcmp(argv[2], "shm") == 0)
+    run<shm_transport>(buf_size);
+  else
+    run<socket_transport>(buf_size);
+}
@@ -0,0 +1,183 @@
+//
+// channel.cpp
+// ~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "asio.hpp"
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using boost::posix_time::ptime;
+using boost::posix_time::microsec_clock;
+
+typedef asio::strand<asio::thread_pool::executor_type> strand_type;
+typedef asio::basic_channel<int,
+    asio::thread_pool::executor_type> channel_type;
+
+// Each pair consists of a producer and a consumer running on separate strands.
+// The messages are passed either through a channel or by posting a function
+// object for each message to the consumer's strand.
+
+class channel_pair
+{
+public:
+  channel_pair(asio::thread_pool& pool, std::size_t buffer_size, int count)
+    : producer_strand_(pool.get_executor()),
+      consumer_strand_(pool.get_executor()),
+      channel_(pool.get_executor(), buffer_size),
+      remaining_(count),
+      received_(0)
+  {
+  }
+
+  void start()
+  {
+    asio::post(producer_strand_,
+        boost::bind(&channel_pair::handle_send, this, asio::error_code()));
+    channel_.async_receive(asio::bind_executor(consumer_strand_,
+          boost::bind(&channel_pair::handle_receive, this, _1, _2)));
+  }
+
+  int received() const
+  {
+    return received_;
+  }
+
+private:
+  void handle_send(const asio::error_code& ec)
+  {
+    if (ec)
+      return;
+
+    if (remaining_ == 0)
+    {
+      channel_.close();
+      return;
+    }
+
+    int value = remaining_--;
+    channel_.async_send(value, asio::bind_executor(producer_strand_,
+          boost::bind(&channel_pair::handle_send, this, _1)));
+  }
+
+  void handle_receive(const asio::error_code& ec, int)
+  {
+    if (ec)
+      return;
+
+    ++received_;
+    channel_.async_receive(asio::bind_executor(consumer_strand_,
+          boost::bind(&channel_pair::handle_receive, this, _1, _2)));
+  }
+
+  strand_type producer_strand_;
+  strand_type consumer_strand_;
+  channel_type channel_;
+  int remaining_;
+  int received_;
+};
+
+class post_pair
+{
+public:
+  post_pair(asio::thread_pool& pool, std::size_t, int count)
+    : producer_strand_(pool.get_executor()),
+      consumer_strand_(pool.get_executor()),
+      remaining_(count),
+      received_(0)
+  {
+  }
+
+  void start()
+  {
+    asio::post(producer_strand_,
+        boost::bind(&post_pair::handle_send, this));
+  }
+
+  int received() const
+  {
+    return received_;
+  }
+
+private:
+  void handle_send()
+  {
+    if (remaining_ == 0)
+      return;
+
+    int value = remaining_--;
+    asio::post(consumer_strand_,
+        boost::bind(&post_pair::handle_receive, this, value));
+    asio::post(producer_strand_,
+        boost::bind(&post_pair::handle_send, this));
+  }
+
+  void handle_receive(int)
+  {
+    ++received_;
+  }
+
+  strand_type producer_strand_;
+  strand_type consumer_strand_;
+  int remaining_;
+  int received_;
+};
+
+template <typename Pair>
+void run(int num_threads, int num_pairs,
+    std::size_t buffer_size, int num_messages)
+{
+  asio::thread_pool pool(num_threads);
+
+  std::vector<Pair*> pairs;
+  for (int i = 0; i < num_pairs; ++i)
+    pairs.push_back(new Pair(pool, buffer_size, num_messages));
+
+  ptime start = microsec_clock::universal_time();
+
+  for (int i = 0; i < num_pairs; ++i)
+    pairs[i]->start();
+  pool.join();
+
+  ptime stop = microsec_clock::universal_time();
+  boost::uint64_t elapsed_usec = (stop - start).total_microseconds();
+
+  boost::uint64_t total = 0;
+  for (int i = 0; i < num_pairs; ++i)
+  {
+    total += pairs[i]->received();
+    delete pairs[i];
+  }
+
+  std::printf("%d threads, %d pairs: %f messages/sec\n",
+      num_threads, num_pairs, total * 1e6 / elapsed_usec);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 6)
+  {
+    std::fprintf(stderr, "Usage: channel <threads> <pairs> "
+        "<bufsize> <messages> {channel|post}\n");
+    return 1;
+  }
+
+  int num_threads = std::atoi(argv[1]);
+  int num_pairs = std::atoi(argv[2]);
+  std::size_t buffer_size = static_cast<std::size_t>(std::atoi(argv[3]));
+  int num_messages = std::atoi(argv[4]);
+
+  if (std::strcmp(argv[5], "channel") == 0)
+    run<channel_pair>(num_threads, num_pairs, buffer_size, num_messages);
+  else
+    run<post_pair>(num_threads, num_pairs, buffer_size, num_messages);
+}
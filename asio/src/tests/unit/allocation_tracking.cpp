@@ -0,0 +1,288 @@
+//
+// allocation_tracking.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Allocation tracking must be enabled consistently across the program, so it
+// cannot be tested against a separately compiled library.
+#if !defined(ASIO_SEPARATE_COMPILATION)
+# define ASIO_ENABLE_ALLOCATION_TRACKING 1
+#endif // !defined(ASIO_SEPARATE_COMPILATION)
+
+// Test that header file is self-contained.
+#include "asio/detail/allocation_tracking.hpp"
+
+#include <vector>
+#include "asio/detail/recycling_allocator.hpp"
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/post.hpp"
+#include "asio/steady_timer.hpp"
+#include "asio/strand.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_ENABLE_ALLOCATION_TRACKING) \
+  && !defined(ASIO_CUSTOM_ALLOCATION_TRACKING)
+
+using asio::detail::allocation_tracking;
+
+// The number of cycles run before counting starts, so that caches and
+// containers have reached their steady state size.
+const int warmup_cycles = 16;
+
+// The number of cycles over which allocations are counted.
+const int counted_cycles = 256;
+
+// Counts completed cycles, and resets the allocation counts once the warmup
+// cycles have completed.
+struct cycle_counter
+{
+  int completed;
+
+  bool next()
+  {
+    if (++completed == warmup_cycles)
+      allocation_tracking::reset();
+    return completed < warmup_cycles + counted_cycles;
+  }
+};
+
+// Base class for handlers that use a recycling allocator as their associated
+// allocator.
+struct recycling_handler
+{
+  typedef asio::detail::recycling_allocator<void> allocator_type;
+
+  allocator_type get_allocator() const ASIO_NOEXCEPT
+  {
+    return allocator_type();
+  }
+};
+
+class socket_cycle
+{
+public:
+  socket_cycle(asio::ip::tcp::socket& writer, asio::ip::tcp::socket& reader)
+    : writer_(writer),
+      reader_(reader)
+  {
+    counter_.completed = 0;
+    std::memset(write_data_, 'x', sizeof(write_data_));
+  }
+
+  void start()
+  {
+    asio::async_write(writer_, asio::buffer(write_data_), write_handler(this));
+  }
+
+  int completed() const
+  {
+    return counter_.completed;
+  }
+
+private:
+  struct write_handler : recycling_handler
+  {
+    explicit write_handler(socket_cycle* s) : self(s) {}
+
+    socket_cycle* self;
+
+    void operator()(const asio::error_code& ec, std::size_t)
+    {
+      ASIO_CHECK(!ec);
+      self->reader_.async_read_some(
+          asio::buffer(self->read_data_), read_handler(self));
+    }
+  };
+
+  struct read_handler : recycling_handler
+  {
+    explicit read_handler(socket_cycle* s) : self(s) {}
+
+    socket_cycle* self;
+
+    void operator()(const asio::error_code& ec, std::size_t n)
+    {
+      ASIO_CHECK(!ec);
+      ASIO_CHECK(n == sizeof(self->read_data_));
+      if (self->counter_.next())
+        self->start();
+    }
+  };
+
+  asio::ip::tcp::socket& writer_;
+  asio::ip::tcp::socket& reader_;
+  char write_data_[64];
+  char read_data_[64];
+  cycle_counter counter_;
+};
+
+void socket_test()
+{
+  using asio::ip::tcp;
+
+  asio::io_context ioc;
+  tcp::acceptor acceptor(ioc, tcp::endpoint(tcp::v4(), 0));
+  tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(asio::ip::address_v4::loopback());
+
+  tcp::socket client(ioc), server(ioc);
+  client.connect(server_endpoint);
+  acceptor.accept(server);
+
+  socket_cycle cycle(client, server);
+  cycle.start();
+  ioc.run();
+
+  ASIO_CHECK(cycle.completed() == warmup_cycles + counted_cycles);
+  ASIO_CHECK(allocation_tracking::count() == 0);
+  if (allocation_tracking::count() != 0)
+    allocation_tracking::report();
+}
+
+struct timer_handler : recycling_handler
+{
+  timer_handler(asio::steady_timer* t, cycle_counter* c)
+    : timer(t),
+      counter(c)
+  {
+  }
+
+  asio::steady_timer* timer;
+  cycle_counter* counter;
+
+  void operator()(const asio::error_code& ec)
+  {
+    ASIO_CHECK(!ec);
+    if (counter->next())
+    {
+      timer->expires_after(asio::chrono::microseconds(1));
+      timer->async_wait(*this);
+    }
+  }
+};
+
+void timer_test()
+{
+  asio::io_context ioc;
+  asio::steady_timer timer(ioc, asio::chrono::microseconds(1));
+  cycle_counter counter = { 0 };
+
+  timer.async_wait(timer_handler(&timer, &counter));
+  ioc.run();
+
+  ASIO_CHECK(counter.completed == warmup_cycles + counted_cycles);
+  ASIO_CHECK(allocation_tracking::count() == 0);
+  if (allocation_tracking::count() != 0)
+    allocation_tracking::report();
+}
+
+typedef asio::strand<asio::io_context::executor_type> strand_type;
+
+struct strand_handler
+{
+  strand_type* strand;
+  cycle_counter* counter;
+
+  void operator()()
+  {
+    if (counter->next())
+      asio::post(*strand, *this);
+  }
+};
+
+void strand_test()
+{
+  asio::io_context ioc;
+  strand_type strand(ioc.get_executor());
+  cycle_counter counter = { 0 };
+
+  strand_handler h = { &strand, &counter };
+  asio::post(strand, h);
+  ioc.run();
+
+  ASIO_CHECK(counter.completed == warmup_cycles + counted_cycles);
+  ASIO_CHECK(allocation_tracking::count() == 0);
+  if (allocation_tracking::count() != 0)
+    allocation_tracking::report();
+}
+
+void resolver_results_test()
+{
+  using asio::ip::tcp;
+
+  std::vector<tcp::endpoint> endpoints;
+  for (unsigned short port = 1; port <= 8; ++port)
+    endpoints.push_back(tcp::endpoint(tcp::v4(), port));
+
+  // The entries are allocated together, and share one copy of the names.
+  allocation_tracking::reset();
+  tcp::resolver::results_type results = tcp::resolver::results_type::create(
+      endpoints.begin(), endpoints.end(), "host", "service");
+  ASIO_CHECK(results.size() == 8);
+  ASIO_CHECK(allocation_tracking::count("resolver_results") == 1);
+  ASIO_CHECK(allocation_tracking::count("resolver_entry") == 1);
+  ASIO_CHECK(allocation_tracking::count() == 2);
+}
+
+void counting_test()
+{
+  allocation_tracking::reset();
+  ASIO_CHECK(allocation_tracking::count() == 0);
+
+  // Creating a strand implementation is a tracked heap allocation.
+  asio::io_context ioc;
+  strand_type strand(ioc.get_executor());
+  ASIO_CHECK(allocation_tracking::count("strand") >= 1);
+  ASIO_CHECK(allocation_tracking::count() >= 1);
+
+  allocation_tracking::reset();
+  ASIO_CHECK(allocation_tracking::count("strand") == 0);
+}
+
+#else // defined(ASIO_ENABLE_ALLOCATION_TRACKING)
+      //   && !defined(ASIO_CUSTOM_ALLOCATION_TRACKING)
+
+void socket_test()
+{
+}
+
+void timer_test()
+{
+}
+
+void strand_test()
+{
+}
+
+void resolver_results_test()
+{
+}
+
+void counting_test()
+{
+}
+
+#endif // defined(ASIO_ENABLE_ALLOCATION_TRACKING)
+       //   && !defined(ASIO_CUSTOM_ALLOCATION_TRACKING)
+
+ASIO_TEST_SUITE
+(
+  "allocation_tracking",
+  ASIO_TEST_CASE(counting_test)
+  ASIO_TEST_CASE(socket_test)
+  ASIO_TEST_CASE(timer_test)
+  ASIO_TEST_CASE(strand_test)
+  ASIO_TEST_CASE(resolver_results_test)
+)
@@ -0,0 +1,444 @@
+//
+// basic_channel.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/basic_channel.hpp"
+
+#include <string>
+#include <vector>
+#include "asio/bind_executor.hpp"
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
+#include "asio/strand.hpp"
+#include "asio/thread_pool.hpp"
+#include "asio/use_future.hpp"
+#include "archetypes/async_result.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+#if defined(ASIO_HAS_STD_UNIQUE_PTR)
+# include <memory>
+#endif // defined(ASIO_HAS_STD_UNIQUE_PTR)
+
+//------------------------------------------------------------------------------
+
+// basic_channel_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// basic_channel compile and link correctly. Runtime failures are ignored.
+
+namespace basic_channel_compile {
+
+void send_handler(const asio::error_code&)
+{
+}
+
+void receive_handler(const asio::error_code&, std::string)
+{
+}
+
+void test()
+{
+#if defined(ASIO_HAS_MOVE)
+  using namespace asio;
+
+  try
+  {
+    io_context ioc;
+    const io_context::executor_type ioc_ex = ioc.get_executor();
+    archetypes::lazy_handler lazy;
+    std::string s;
+
+    // basic_channel constructors.
+
+    basic_channel<std::string> channel1(ioc);
+    basic_channel<std::string> channel2(ioc, 16);
+    basic_channel<std::string> channel3(ioc_ex);
+    basic_channel<std::string, io_context::executor_type> channel4(ioc_ex,
+        basic_channel<std::string, io_context::executor_type>::unbounded);
+
+    // basic_channel functions.
+
+    basic_channel<std::string>::executor_type ex = channel1.get_executor();
+    (void)ex;
+
+    std::size_t size = channel2.max_buffer_size();
+    (void)size;
+
+    bool b1 = channel1.is_open();
+    (void)b1;
+
+    bool b2 = channel1.ready();
+    (void)b2;
+
+    bool b3 = channel1.try_send(s);
+    (void)b3;
+
+    bool b4 = channel1.try_send(std::string("message"));
+    (void)b4;
+
+    bool b5 = channel1.try_receive(s);
+    (void)b5;
+
+    channel1.async_send(s, &send_handler);
+    channel1.async_send(std::string("message"), &send_handler);
+    int i1 = channel1.async_send(s, lazy);
+    (void)i1;
+
+    channel1.async_receive(&receive_handler);
+    int i2 = channel1.async_receive(lazy);
+    (void)i2;
+
+    channel1.cancel();
+    channel1.close();
+  }
+  catch (std::exception&)
+  {
+  }
+#endif // defined(ASIO_HAS_MOVE)
+}
+
+} // namespace basic_channel_compile
+
+//------------------------------------------------------------------------------
+
+// basic_channel_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the basic_channel class.
+
+namespace basic_channel_runtime {
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+using std::placeholders::_1;
+using std::placeholders::_2;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+void send_handler(const asio::error_code& e,
+    std::vector<asio::error_code>* results)
+{
+  results->push_back(e);
+}
+
+void receive_handler(const asio::error_code& e, int value,
+    std::vector<asio::error_code>* results, std::vector<int>* values)
+{
+  results->push_back(e);
+  values->push_back(value);
+}
+
+void test_buffered()
+{
+#if defined(ASIO_HAS_MOVE)
+  asio::io_context ioc;
+  asio::basic_channel<int> channel(ioc, 2);
+  std::vector<asio::error_code> sent, received;
+  std::vector<int> values;
+
+  // Sends complete until the buffer is full.
+  for (int i = 0; i < 3; ++i)
+    channel.async_send(i, bindns::bind(send_handler, _1, &sent));
+
+  // The handlers are not invoked from within the initiating functions.
+  ASIO_CHECK(sent.empty());
+  ioc.poll();
+  ASIO_CHECK(sent.size() == 2);
+  ASIO_CHECK(channel.ready());
+
+  // Receiving makes room for the waiting sender, and messages arrive in order.
+  for (int i = 0; i < 3; ++i)
+    channel.async_receive(bindns::bind(receive_handler,
+          _1, _2, &received, &values));
+  ASIO_CHECK(received.empty());
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(sent.size() == 3);
+  ASIO_CHECK(received.size() == 3);
+  ASIO_CHECK(values.size() == 3);
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    ASIO_CHECK(!received[i]);
+    ASIO_CHECK(values[i] == static_cast<int>(i));
+  }
+  ASIO_CHECK(!channel.ready());
+
+  // Non-waiting operations.
+  int value = 10;
+  ASIO_CHECK(channel.try_send(value));
+  ASIO_CHECK(channel.try_send(11));
+  ASIO_CHECK(!channel.try_send(12));
+  ASIO_CHECK(channel.try_receive(value));
+  ASIO_CHECK(value == 10);
+  ASIO_CHECK(channel.try_receive(value));
+  ASIO_CHECK(value == 11);
+  ASIO_CHECK(!channel.try_receive(value));
+#endif // defined(ASIO_HAS_MOVE)
+}
+
+void test_unbuffered()
+{
+#if defined(ASIO_HAS_MOVE)
+  asio::io_context ioc;
+  asio::basic_channel<int> channel(ioc);
+  std::vector<asio::error_code> sent, received;
+  std::vector<int> values;
+
+  // A send waits for a receiver.
+  channel.async_send(42, bindns::bind(send_handler, _1, &sent));
+  ioc.poll();
+  ASIO_CHECK(sent.empty());
+  ASIO_CHECK(channel.ready());
+
+  int value = 0;
+  ASIO_CHECK(channel.try_receive(value));
+  ASIO_CHECK(value == 42);
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(sent.size() == 1);
+  ASIO_CHECK(!sent[0]);
+
+  // A receive waits for a sender.
+  channel.async_receive(bindns::bind(receive_handler,
+        _1, _2, &received, &values));
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(received.empty());
+  ASIO_CHECK(!channel.try_receive(value));
+
+  ASIO_CHECK(channel.try_send(43));
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(received.size() == 1);
+  ASIO_CHECK(values.size() == 1 && values[0] == 43);
+#endif // defined(ASIO_HAS_MOVE)
+}
+
+void test_unbounded()
+{
+#if defined(ASIO_HAS_MOVE)
+  asio::io_context ioc;
+  asio::basic_channel<int> channel(ioc, asio::basic_channel<int>::unbounded);
+
+  // The buffer grows as required while preserving the order of messages.
+  const int num_messages = 1000;
+  for (int i = 0; i < num_messages; ++i)
+    ASIO_CHECK(channel.try_send(i));
+
+  bool in_order = true;
+  for (int i = 0; i < num_messages; ++i)
+  {
+    int value = -1;
+    in_order = in_order && channel.try_receive(value) && value == i;
+  }
+  ASIO_CHECK(in_order);
+#endif // defined(ASIO_HAS_MOVE)
+}
+
+void test_close_and_cancel()
+{
+#if defined(ASIO_HAS_MOVE)
+  asio::io_context ioc;
+  std::vector<asio::error_code> sent, received;
+  std::vector<int> values;
+
+  // Buffered messages may still be received after the channel is closed.
+  asio::basic_channel<int> channel1(ioc, 1);
+  channel1.async_send(1, bindns::bind(send_handler, _1, &sent));
+  channel1.async_send(2, bindns::bind(send_handler, _1, &sent));
+  channel1.close();
+  ASIO_CHECK(!channel1.is_open());
+  channel1.async_send(3, bindns::bind(send_handler, _1, &sent));
+  channel1.async_receive(bindns::bind(receive_handler,
+        _1, _2, &received, &values));
+  channel1.async_receive(bindns::bind(receive_handler,
+        _1, _2, &received, &values));
+  ioc.poll();
+  ASIO_CHECK(sent.size() == 3);
+  ASIO_CHECK(!sent[0]);
+  ASIO_CHECK(sent[1] == asio::error::broken_pipe);
+  ASIO_CHECK(sent[2] == asio::error::broken_pipe);
+  ASIO_CHECK(received.size() == 2);
+  ASIO_CHECK(!received[0] && values[0] == 1);
+  ASIO_CHECK(received[1] == asio::error::eof);
+
+  // Closing wakes waiting receivers.
+  sent.clear();
+  received.clear();
+  values.clear();
+  asio::basic_channel<int> channel2(ioc);
+  channel2.async_receive(bindns::bind(receive_handler,
+        _1, _2, &received, &values));
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(received.empty());
+  channel2.close();
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(received.size() == 1);
+  ASIO_CHECK(received[0] == asio::error::eof);
+
+  // Cancellation completes waiting operations.
+  received.clear();
+  asio::basic_channel<int> channel3(ioc);
+  channel3.async_send(1, bindns::bind(send_handler, _1, &sent));
+  channel3.cancel();
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(sent.size() == 1);
+  ASIO_CHECK(sent[0] == asio::error::operation_aborted);
+  ASIO_CHECK(!channel3.ready());
+  ASIO_CHECK(channel3.is_open());
+#endif // defined(ASIO_HAS_MOVE)
+}
+
+void test_move_only()
+{
+#if defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_STD_UNIQUE_PTR)
+  asio::io_context ioc;
+  asio::basic_channel<std::unique_ptr<int> > channel(ioc);
+
+  std::unique_ptr<int> p(new int(7));
+  int* raw = p.get();
+  channel.async_send(std::move(p), [](asio::error_code) {});
+
+  std::unique_ptr<int> result;
+  channel.async_receive(
+      [&](asio::error_code, std::unique_ptr<int> value)
+      {
+        result = std::move(value);
+      });
+
+  ioc.poll();
+  ASIO_CHECK(result.get() == raw);
+#endif // defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_STD_UNIQUE_PTR)
+}
+
+void test_use_future()
+{
+#if defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_STD_FUTURE)
+  asio::thread_pool pool(1);
+  asio::basic_channel<int> channel(pool, 1);
+
+  std::future<void> f1 = channel.async_send(5, asio::use_future);
+  f1.get();
+
+  std::future<int> f2 = channel.async_receive(asio::use_future);
+  ASIO_CHECK(f2.get() == 5);
+
+  channel.close();
+  std::future<int> f3 = channel.async_receive(asio::use_future);
+  try
+  {
+    f3.get();
+    ASIO_ERROR("Expected an exception");
+  }
+  catch (asio::system_error& e)
+  {
+    ASIO_CHECK(e.code() == asio::error::eof);
+  }
+
+  pool.join();
+#endif // defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_STD_FUTURE)
+}
+
+#if defined(ASIO_HAS_MOVE)
+
+// Passes every message from a producer on one strand to a consumer on
+// another, using many threads.
+struct consumer
+{
+  asio::basic_channel<int>* channel;
+  asio::strand<asio::thread_pool::executor_type>* strand;
+  int* expected;
+  bool* in_order;
+
+  void operator()(const asio::error_code& e, int value)
+  {
+    if (e)
+      return;
+    *in_order = *in_order && value == *expected;
+    ++*expected;
+    channel->async_receive(asio::bind_executor(*strand, *this));
+  }
+};
+
+struct producer
+{
+  asio::basic_channel<int>* channel;
+  asio::strand<asio::thread_pool::executor_type>* strand;
+  int next;
+  int last;
+
+  void operator()(const asio::error_code& e)
+  {
+    if (e)
+      return;
+    if (next == last)
+    {
+      channel->close();
+      return;
+    }
+    int value = next++;
+    channel->async_send(value, asio::bind_executor(*strand, *this));
+  }
+};
+
+#endif // defined(ASIO_HAS_MOVE)
+
+void test_threads()
+{
+#if defined(ASIO_HAS_MOVE)
+  asio::thread_pool pool(4);
+  asio::basic_channel<int> channel(pool, 8);
+  asio::strand<asio::thread_pool::executor_type> s1(pool.get_executor());
+  asio::strand<asio::thread_pool::executor_type> s2(pool.get_executor());
+
+  int expected = 0;
+  bool in_order = true;
+  consumer c = { &channel, &s2, &expected, &in_order };
+  channel.async_receive(asio::bind_executor(s2, c));
+
+  producer p = { &channel, &s1, 0, 10000 };
+  asio::post(s1, bindns::bind(p, asio::error_code()));
+
+  pool.join();
+  ASIO_CHECK(in_order);
+  ASIO_CHECK(expected == 10000);
+#endif // defined(ASIO_HAS_MOVE)
+}
+
+} // namespace basic_channel_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "basic_channel",
+  ASIO_TEST_CASE(basic_channel_compile::test)
+  ASIO_TEST_CASE(basic_channel_runtime::test_buffered)
+  ASIO_TEST_CASE(basic_channel_runtime::test_unbuffered)
+  ASIO_TEST_CASE(basic_channel_runtime::test_unbounded)
+  ASIO_TEST_CASE(basic_channel_runtime::test_close_and_cancel)
+  ASIO_TEST_CASE(basic_channel_runtime::test_move_only)
+  ASIO_TEST_CASE(basic_channel_runtime::test_use_future)
+  ASIO_TEST_CASE(basic_channel_runtime::test_threads)
+)
@@ -0,0 +1,223 @@
+//
+// cancellation_signal.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/cancellation_signal.hpp"
+
+#include "asio/bind_cancellation_slot.hpp"
+#include "asio/buffer.hpp"
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/steady_timer.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+//------------------------------------------------------------------------------
+
+// cancellation_signal_slot test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the installation and invocation of cancellation
+// handlers through a signal's slot.
+
+namespace cancellation_signal_slot {
+
+struct counting_handler
+{
+  counting_handler(int* count)
+    : count_(count)
+  {
+  }
+
+  void operator()()
+  {
+    ++*count_;
+  }
+
+  int* count_;
+};
+
+void test()
+{
+  asio::cancellation_slot unconnected;
+  ASIO_CHECK(!unconnected.is_connected());
+  ASIO_CHECK(!unconnected.has_handler());
+
+  asio::cancellation_signal sig;
+  asio::cancellation_slot slot = sig.slot();
+  ASIO_CHECK(slot.is_connected());
+  ASIO_CHECK(!slot.has_handler());
+  ASIO_CHECK(slot == sig.slot());
+  ASIO_CHECK(slot != unconnected);
+
+  // Emitting without a handler has no effect.
+  sig.emit();
+
+  int count1 = 0, count2 = 0;
+  slot.assign(counting_handler(&count1));
+  ASIO_CHECK(slot.has_handler());
+  sig.emit();
+  sig.emit();
+  ASIO_CHECK(count1 == 2);
+
+  // Installing a new handler replaces the previous one.
+  slot.emplace<counting_handler>(&count2);
+  sig.emit();
+  ASIO_CHECK(count1 == 2);
+  ASIO_CHECK(count2 == 1);
+
+  slot.clear();
+  ASIO_CHECK(!slot.has_handler());
+  sig.emit();
+  ASIO_CHECK(count2 == 1);
+}
+
+} // namespace cancellation_signal_slot
+
+//------------------------------------------------------------------------------
+
+// cancellation_signal_operations test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a signal cancels only the operation
+// associated with its slot.
+
+namespace cancellation_signal_operations {
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+using std::placeholders::_1;
+using std::placeholders::_2;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+void io_handler(const asio::error_code& e, std::size_t,
+    asio::error_code* result, int* count)
+{
+  *result = e;
+  ++*count;
+}
+
+void wait_handler(const asio::error_code& e,
+    asio::error_code* result, int* count)
+{
+  *result = e;
+  ++*count;
+}
+
+void test_socket()
+{
+  using asio::ip::tcp;
+
+  asio::io_context ioc;
+  tcp::acceptor acceptor(ioc, tcp::endpoint(tcp::v4(), 0));
+  tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(asio::ip::address_v4::loopback());
+
+  tcp::socket client_side_socket(ioc);
+  tcp::socket server_side_socket(ioc);
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+
+  asio::cancellation_signal sig;
+  char read_data[16];
+  const char write_data[] = "data";
+  asio::error_code read_result, write_result;
+  int read_count = 0, write_count = 0;
+
+  client_side_socket.async_read_some(asio::buffer(read_data),
+      asio::bind_cancellation_slot(sig.slot(),
+        bindns::bind(io_handler, _1, _2, &read_result, &read_count)));
+  client_side_socket.async_write_some(asio::buffer(write_data),
+      bindns::bind(io_handler, _1, _2, &write_result, &write_count));
+
+  ioc.poll();
+  ASIO_CHECK(read_count == 0);
+  ASIO_CHECK(write_count == 1);
+  ASIO_CHECK(!write_result);
+
+  // Only the receive is cancelled, and the socket remains open.
+  sig.emit();
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(read_count == 1);
+  ASIO_CHECK(read_result == asio::error::operation_aborted);
+  ASIO_CHECK(client_side_socket.is_open());
+
+  // The socket is still usable, and a stale emit has no effect.
+  sig.emit();
+  client_side_socket.async_read_some(asio::buffer(read_data),
+      asio::bind_cancellation_slot(sig.slot(),
+        bindns::bind(io_handler, _1, _2, &read_result, &read_count)));
+  asio::write(server_side_socket, asio::buffer(write_data));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(read_count == 2);
+  ASIO_CHECK(!read_result);
+  sig.emit();
+}
+
+void test_timer()
+{
+#if defined(ASIO_HAS_CHRONO)
+  asio::io_context ioc;
+  asio::steady_timer t1(ioc, asio::chrono::hours(1));
+  asio::steady_timer t2(ioc, asio::chrono::hours(1));
+
+  asio::cancellation_signal sig;
+  asio::error_code result1, result2;
+  int count1 = 0, count2 = 0;
+
+  t1.async_wait(asio::bind_cancellation_slot(sig.slot(),
+        bindns::bind(wait_handler, _1, &result1, &count1)));
+  t1.async_wait(bindns::bind(wait_handler, _1, &result2, &count2));
+  t2.async_wait(bindns::bind(wait_handler, _1, &result2, &count2));
+
+  ioc.poll();
+  ASIO_CHECK(count1 == 0);
+
+  // Only the associated wait is cancelled. The other wait on the same timer
+  // remains pending.
+  sig.emit();
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(count1 == 1);
+  ASIO_CHECK(result1 == asio::error::operation_aborted);
+  ASIO_CHECK(count2 == 0);
+
+  t1.cancel();
+  t2.cancel();
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(count2 == 2);
+#endif // defined(ASIO_HAS_CHRONO)
+}
+
+} // namespace cancellation_signal_operations
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "cancellation_signal",
+  ASIO_TEST_CASE(cancellation_signal_slot::test)
+  ASIO_TEST_CASE(cancellation_signal_operations::test_socket)
+  ASIO_TEST_CASE(cancellation_signal_operations::test_timer)
+)
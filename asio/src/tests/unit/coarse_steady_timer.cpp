@@ -0,0 +1,86 @@
+//
+// coarse_steady_timer.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Prevent link dependency on the Boost.System library.
+#if !defined(BOOST_SYSTEM_NO_DEPRECATED)
+#define BOOST_SYSTEM_NO_DEPRECATED
+#endif // !defined(BOOST_SYSTEM_NO_DEPRECATED)
+
+// Test that header file is self-contained.
+#include "asio/coarse_steady_timer.hpp"
+
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_CHRONO)
+
+#include "asio/io_context.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+void increment_if_not_cancelled(int* count,
+    const asio::error_code& ec)
+{
+  if (!ec)
+    ++(*count);
+}
+
+void coarse_steady_timer_test()
+{
+  using asio::chrono::milliseconds;
+#if !defined(ASIO_HAS_BOOST_BIND)
+  using std::placeholders::_1;
+#endif // !defined(ASIO_HAS_BOOST_BIND)
+
+  typedef asio::coarse_steady_timer::clock_type clock_type;
+
+  clock_type::time_point t1 = clock_type::now();
+  clock_type::time_point t2 = clock_type::now();
+  ASIO_CHECK(!(t2 < t1));
+
+  asio::io_context ioc;
+  int count = 0;
+
+  asio::coarse_steady_timer t(ioc);
+  t.expires_after(milliseconds(20));
+  t.async_wait(bindns::bind(increment_if_not_cancelled, &count, _1));
+
+  ioc.run();
+
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(!(clock_type::now() < t.expiry()));
+}
+
+ASIO_TEST_SUITE
+(
+  "coarse_steady_timer",
+  ASIO_TEST_CASE(coarse_steady_timer_test)
+)
+#else // defined(ASIO_HAS_CHRONO)
+ASIO_TEST_SUITE
+(
+  "coarse_steady_timer",
+  ASIO_TEST_CASE(null_test)
+)
+#endif // defined(ASIO_HAS_CHRONO)
@@ -16,10 +16,124 @@
 // Test that header file is self-contained.
 #include "asio/completion_condition.hpp"
 
+#include "asio/error.hpp"
 #include "unit_test.hpp"
 
+//------------------------------------------------------------------------------
+
+// completion_condition_transfer_adaptive_test test case
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the transfer_adaptive completion condition
+// grows and shrinks the limit according to the bytes transferred.
+
+// Provides the buffer size options of a socket.
+class socket_stub
+{
+public:
+  struct send_buffer_size
+  {
+    int value() const { return value_; }
+    int value_;
+  };
+
+  typedef send_buffer_size receive_buffer_size;
+
+  socket_stub(int size, int error)
+    : size_(size),
+      error_(error)
+  {
+  }
+
+  void get_option(send_buffer_size& option, asio::error_code& ec) const
+  {
+    option.value_ = size_;
+    ec = asio::error_code(error_, asio::error::get_system_category());
+  }
+
+private:
+  int size_;
+  int error_;
+};
+
+void transfer_adaptive_test()
+{
+  asio::error_code ec;
+
+  // Full transfers double the limit, up to the maximum.
+  asio::detail::transfer_adaptive_t c1 = asio::transfer_adaptive(100, 350);
+  ASIO_CHECK(c1(ec, 0) == 100);
+  ASIO_CHECK(c1(ec, 100) == 200);
+  ASIO_CHECK(c1(ec, 300) == 350);
+  ASIO_CHECK(c1(ec, 650) == 350);
+
+  // A single transfer of less than half the limit leaves it unchanged. Two in
+  // a row reduce it to the larger of the two, and a transfer of at least half
+  // resets the count.
+  asio::detail::transfer_adaptive_t c2 = asio::transfer_adaptive(1000, 8000);
+  ASIO_CHECK(c2(ec, 0) == 1000);
+  ASIO_CHECK(c2(ec, 1000) == 2000);
+  ASIO_CHECK(c2(ec, 3000) == 4000);
+  ASIO_CHECK(c2(ec, 4500) == 4000);
+  ASIO_CHECK(c2(ec, 7000) == 4000);
+  ASIO_CHECK(c2(ec, 8500) == 4000);
+  ASIO_CHECK(c2(ec, 10000) == 1500);
+
+  // No progress leaves the limit unchanged.
+  ASIO_CHECK(c2(ec, 10000) == 1500);
+
+  // The limit never drops below the initial size.
+  ASIO_CHECK(c2(ec, 10100) == 1500);
+  ASIO_CHECK(c2(ec, 10200) == 1000);
+  ASIO_CHECK(c2(ec, 10300) == 1000);
+  ASIO_CHECK(c2(ec, 10400) == 1000);
+  ASIO_CHECK(c2(ec, 10500) == 1000);
+
+  // An error completes the operation.
+  ec = asio::error::eof;
+  ASIO_CHECK(c2(ec, 10500) == 0);
+
+  // The initial size is capped by the maximum.
+  asio::detail::transfer_adaptive_t c3 = asio::transfer_adaptive(500, 200);
+  ASIO_CHECK(c3(asio::error_code(), 0) == 200);
+
+  // The default limits.
+  asio::detail::transfer_adaptive_t c4 = asio::transfer_adaptive();
+  ASIO_CHECK(c4(asio::error_code(), 0)
+      == asio::detail::default_max_transfer_size);
+
+  // The initial size is taken from the socket's buffer size, or the default
+  // if the option cannot be read.
+  socket_stub good(4096, 0);
+  asio::detail::transfer_adaptive_t c5 = asio::transfer_adaptive_send(good);
+  ASIO_CHECK(c5(asio::error_code(), 0) == 4096);
+  asio::detail::transfer_adaptive_t c6 =
+    asio::transfer_adaptive_receive(good, 1000);
+  ASIO_CHECK(c6(asio::error_code(), 0) == 1000);
+  socket_stub bad(4096, asio::error::bad_descriptor);
+  asio::detail::transfer_adaptive_t c7 = asio::transfer_adaptive_send(bad);
+  ASIO_CHECK(c7(asio::error_code(), 0)
+      == asio::detail::default_max_transfer_size);
+
+  // A full transfer forgets any earlier short transfer, so the limit drops to
+  // the size of the later short transfers only.
+  ec = asio::error_code();
+  asio::detail::transfer_adaptive_t c8 = asio::transfer_adaptive(100, 8000);
+  ASIO_CHECK(c8(ec, 0) == 100);
+  ASIO_CHECK(c8(ec, 100) == 200);
+  ASIO_CHECK(c8(ec, 300) == 400);
+  ASIO_CHECK(c8(ec, 700) == 800);
+  ASIO_CHECK(c8(ec, 1500) == 1600);
+  ASIO_CHECK(c8(ec, 3100) == 3200);
+  ASIO_CHECK(c8(ec, 4000) == 3200);
+  ASIO_CHECK(c8(ec, 7200) == 6400);
+  ASIO_CHECK(c8(ec, 7300) == 6400);
+  ASIO_CHECK(c8(ec, 7400) == 100);
+}
+
+//------------------------------------------------------------------------------
+
 ASIO_TEST_SUITE
 (
   "completion_condition",
-  ASIO_TEST_CASE(null_test)
+  ASIO_TEST_CASE(transfer_adaptive_test)
 )
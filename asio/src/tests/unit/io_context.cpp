@@ -17,12 +17,22 @@
 #include "asio/io_context.hpp"
 
 #include <sstream>
+#include <vector>
 #include "asio/bind_executor.hpp"
 #include "asio/dispatch.hpp"
 #include "asio/post.hpp"
+#include "asio/strand.hpp"
 #include "asio/thread.hpp"
+#include "asio/write.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/stream_protocol.hpp"
 #include "unit_test.hpp"
 
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+# include <sys/wait.h>
+# include <unistd.h>
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
 #if defined(ASIO_HAS_BOOST_DATE_TIME)
 # include "asio/deadline_timer.hpp"
 #else // defined(ASIO_HAS_BOOST_DATE_TIME)
@@ -41,6 +51,8 @@ using namespace asio;
 namespace bindns = boost;
 #else // defined(ASIO_HAS_BOOST_BIND)
 namespace bindns = std;
+using std::placeholders::_1;
+using std::placeholders::_2;
 #endif
 
 #if defined(ASIO_HAS_BOOST_DATE_TIME)
@@ -354,9 +366,238 @@ void io_context_service_test()
   ASIO_CHECK(!asio::has_service<test_service>(ioc3));
 }
 
+void record(std::vector<int>* order, int id)
+{
+  order->push_back(id);
+}
+
+void record_wait(std::vector<int>* order, int id, const asio::error_code&)
+{
+  order->push_back(id);
+}
+
+void record_read(std::vector<int>* order, int id,
+    const asio::error_code&, std::size_t)
+{
+  order->push_back(id);
+}
+
+void io_context_priority_test()
+{
+  io_context ioc;
+
+  io_context::executor_type low = ioc.get_executor(io_context::low_priority);
+  io_context::executor_type normal = ioc.get_executor();
+  io_context::executor_type high = ioc.get_executor(io_context::high_priority);
+
+  ASIO_CHECK(low.priority() == io_context::low_priority);
+  ASIO_CHECK(normal.priority() == io_context::normal_priority);
+  ASIO_CHECK(high.priority() == io_context::high_priority);
+  ASIO_CHECK(normal == ioc.get_executor(io_context::normal_priority));
+  ASIO_CHECK(low != normal);
+  ASIO_CHECK(normal != high);
+
+  // Ready handlers are taken from the highest non-empty priority class.
+  std::vector<int> order;
+  asio::post(low, bindns::bind(record, &order, 1));
+  asio::post(normal, bindns::bind(record, &order, 2));
+  asio::post(high, bindns::bind(record, &order, 3));
+  asio::post(normal, bindns::bind(record, &order, 4));
+  asio::post(high, bindns::bind(record, &order, 5));
+  ioc.poll();
+
+  ASIO_CHECK(order.size() == 5);
+  if (order.size() == 5)
+  {
+    ASIO_CHECK(order[0] == 3);
+    ASIO_CHECK(order[1] == 5);
+    ASIO_CHECK(order[2] == 2);
+    ASIO_CHECK(order[3] == 4);
+    ASIO_CHECK(order[4] == 1);
+  }
+
+  // A low priority handler is not starved by a steady supply of high priority
+  // handlers.
+  ioc.restart();
+  order.clear();
+  asio::post(low, bindns::bind(record, &order, -1));
+  for (int i = 0; i < 32; ++i)
+    asio::post(high, bindns::bind(record, &order, i));
+  ioc.poll();
+
+  ASIO_CHECK(order.size() == 33);
+  if (order.size() == 33)
+  {
+    ASIO_CHECK(order[16] == -1);
+    ASIO_CHECK(order[32] == 31);
+  }
+
+  // Strands queue their handlers in the priority class of the inner executor.
+  ioc.restart();
+  order.clear();
+  strand<io_context::executor_type> high_strand(high);
+  asio::post(normal, bindns::bind(record, &order, 1));
+  asio::post(high_strand, bindns::bind(record, &order, 2));
+  ioc.poll();
+
+  ASIO_CHECK(order.size() == 2);
+  if (order.size() == 2)
+  {
+    ASIO_CHECK(order[0] == 2);
+    ASIO_CHECK(order[1] == 1);
+  }
+
+  // The completion of an asynchronous operation is queued in the priority
+  // class of the handler's associated executor.
+  ioc.restart();
+  order.clear();
+  timer t(ioc, chronons::seconds(0));
+  asio::post(normal, bindns::bind(record, &order, 1));
+  asio::post(normal, bindns::bind(record, &order, 2));
+  t.async_wait(asio::bind_executor(high,
+        bindns::bind(record_wait, &order, 3, _1)));
+  asio::post(normal, bindns::bind(record, &order, 4));
+  ioc.run();
+
+  ASIO_CHECK(order.size() == 4);
+  if (order.size() == 4)
+  {
+    ASIO_CHECK(order[0] == 3);
+    ASIO_CHECK(order[1] == 1);
+    ASIO_CHECK(order[2] == 2);
+    ASIO_CHECK(order[3] == 4);
+  }
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  // The same applies to the completion of a socket operation, which must not
+  // wait behind the normal handlers that were queued before it became ready.
+  ioc.restart();
+  order.clear();
+  asio::local::stream_protocol::socket s1(ioc), s2(ioc);
+  asio::local::connect_pair(s1, s2);
+  char data[1] = { 0 };
+  s2.async_read_some(asio::buffer(data), asio::bind_executor(high,
+        bindns::bind(record_read, &order, 3, _1, _2)));
+  asio::write(s1, asio::buffer(data));
+  asio::post(normal, bindns::bind(record, &order, 1));
+  asio::post(normal, bindns::bind(record, &order, 2));
+  asio::post(normal, bindns::bind(record, &order, 4));
+  ioc.run();
+
+  ASIO_CHECK(order.size() == 4);
+  if (order.size() == 4)
+  {
+    ASIO_CHECK(order[0] == 3);
+    ASIO_CHECK(order[1] == 1);
+    ASIO_CHECK(order[2] == 2);
+    ASIO_CHECK(order[3] == 4);
+  }
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS) \
+  && !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+void fork_read_handler(const asio::error_code& e,
+    asio::error_code* out_ec, bool* called)
+{
+  *out_ec = e;
+  *called = true;
+}
+
+// Runs in the child process. Returns true if the inherited descriptors
+// behave as expected for the selected fork mode.
+bool fork_child_test(io_context& ioc, io_context::fork_mode mode,
+    local::stream_protocol::socket& pending_peer,
+    const char* pending_buf, asio::error_code* pending_ec,
+    bool* pending_called, local::stream_protocol::socket& idle,
+    local::stream_protocol::socket& idle_peer)
+{
+  try
+  {
+    ioc.notify_fork(io_context::fork_child);
+
+    // Start a read that must wait on a descriptor that had no pending
+    // operations at the time of the fork.
+    char idle_buf[1] = { 0 };
+    asio::error_code idle_ec;
+    bool idle_called = false;
+    idle.async_read_some(asio::buffer(idle_buf),
+        bindns::bind(fork_read_handler, _1, &idle_ec, &idle_called));
+
+    asio::write(pending_peer, asio::buffer("a", 1));
+    asio::write(idle_peer, asio::buffer("b", 1));
+
+    ioc.run();
+
+    if (!idle_called || idle_ec || idle_buf[0] != 'b' || !*pending_called)
+      return false;
+
+    if (mode == io_context::fork_drop_registrations)
+      return *pending_ec == asio::error::operation_aborted;
+
+    return !*pending_ec && pending_buf[0] == 'a';
+  }
+  catch (std::exception&)
+  {
+    return false;
+  }
+}
+
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+       //   && !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+void io_context_fork_test()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS) \
+  && !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  const io_context::fork_mode modes[] =
+  {
+    io_context::fork_reregister_eagerly,
+    io_context::fork_reregister_lazily,
+    io_context::fork_drop_registrations
+  };
+
+  for (std::size_t i = 0; i < sizeof(modes) / sizeof(modes[0]); ++i)
+  {
+    io_context ioc;
+    ioc.set_fork_mode(modes[i]);
+
+    local::stream_protocol::socket s1(ioc), s2(ioc), s3(ioc), s4(ioc);
+    local::connect_pair(s1, s2);
+    local::connect_pair(s3, s4);
+
+    // Leave a read pending across the fork.
+    char pending_buf[1] = { 0 };
+    asio::error_code pending_ec;
+    bool pending_called = false;
+    s1.async_read_some(asio::buffer(pending_buf),
+        bindns::bind(fork_read_handler, _1, &pending_ec, &pending_called));
+
+    ioc.notify_fork(io_context::fork_prepare);
+    pid_t pid = ::fork();
+    if (pid == 0)
+    {
+      bool result = fork_child_test(ioc, modes[i], s2, pending_buf,
+          &pending_ec, &pending_called, s3, s4);
+      ::_exit(result ? 0 : 1);
+    }
+    ioc.notify_fork(io_context::fork_parent);
+
+    ASIO_CHECK(pid != -1);
+    int status = 0;
+    ASIO_CHECK(::waitpid(pid, &status, 0) == pid);
+    ASIO_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  }
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+       //   && !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+}
+
 ASIO_TEST_SUITE
 (
   "io_context",
   ASIO_TEST_CASE(io_context_test)
   ASIO_TEST_CASE(io_context_service_test)
+  ASIO_TEST_CASE(io_context_priority_test)
+  ASIO_TEST_CASE(io_context_fork_test)
 )
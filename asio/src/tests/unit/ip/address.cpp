@@ -16,8 +16,11 @@
 // Test that header file is self-contained.
 #include "asio/ip/address.hpp"
 
-#include "../unit_test.hpp"
+#include <cstdio>
+#include <cstring>
 #include <sstream>
+#include <string>
+#include "../unit_test.hpp"
 
 //------------------------------------------------------------------------------
 
@@ -73,6 +76,12 @@ void test()
     string_value = addr1.to_string(ec);
 #endif // !defined(ASIO_NO_DEPRECATED)
 
+    char chars_value[ip::address::max_chars];
+    char* chars_end = addr1.to_chars(chars_value,
+        chars_value + sizeof(chars_value));
+    chars_end = addr1.to_chars(chars_value,
+        chars_value + sizeof(chars_value), ec);
+
     // address static functions.
 
 #if !defined(ASIO_NO_DEPRECATED)
@@ -106,6 +115,8 @@ void test()
 
     addr1 = ip::make_address("127.0.0.1");
     addr1 = ip::make_address("127.0.0.1", ec);
+    addr1 = ip::make_address(chars_value, chars_end);
+    addr1 = ip::make_address(chars_value, chars_end, ec);
     addr1 = ip::make_address(string_value);
     addr1 = ip::make_address(string_value, ec);
 #if defined(ASIO_HAS_STRING_VIEW)
@@ -137,8 +148,172 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// ip_address_chars test
+// ~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the allocation-free conversions agree with
+// the conversions performed by the operating system.
+
+namespace ip_address_chars {
+
+void test_v4()
+{
+  using asio::ip::address_v4;
+  using namespace std; // For sprintf and strlen.
+
+  char buf[address_v4::max_chars];
+  char expected[32];
+  asio::error_code ec;
+
+  // Formatting agrees with printf, and parsing recovers the address.
+  address_v4::uint_type value = 0x12345678;
+  for (int i = 0; i < 1000; ++i)
+  {
+    value = value * 1103515245 + 12345;
+    address_v4 addr(value & (i % 4 == 0 ? 0xFF00FF00 : 0xFFFFFFFF));
+    address_v4::bytes_type bytes = addr.to_bytes();
+    sprintf(expected, "%u.%u.%u.%u", bytes[0], bytes[1], bytes[2], bytes[3]);
+
+    char* end = addr.to_chars(buf, buf + sizeof(buf), ec);
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(std::string(buf, end) == expected);
+    ASIO_CHECK(addr.to_string() == expected);
+    ASIO_CHECK(asio::ip::make_address_v4(buf, end, ec) == addr);
+    ASIO_CHECK(!ec);
+  }
+
+  // A range that is too small.
+  address_v4 addr(0xFFFFFFFF);
+  char* end = addr.to_chars(buf, buf + 14, ec);
+  ASIO_CHECK(ec == asio::error::no_buffer_space);
+  ASIO_CHECK(end == buf);
+  end = addr.to_chars(buf, buf + 15, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(end == buf + 15);
+
+  // Parsing accepts and rejects the same strings as inet_pton.
+  const char* strings[] = { "0.0.0.0", "255.255.255.255", "1.2.3.4",
+    "256.1.1.1", "1.2.3", "1.2.3.4.5", "01.2.3.4", "1.2.3.04", "1..3.4",
+    "1.2.3.", ".1.2.3", "1.2.3.4 ", "a.b.c.d", "1000.1.1.1", "" };
+  for (std::size_t i = 0; i < sizeof(strings) / sizeof(strings[0]); ++i)
+  {
+    asio::error_code expected_ec;
+    address_v4 expected_addr =
+      asio::ip::make_address_v4(strings[i], expected_ec);
+    address_v4 parsed_addr = asio::ip::make_address_v4(
+        strings[i], strings[i] + strlen(strings[i]), ec);
+    ASIO_CHECK(!ec == !expected_ec);
+    ASIO_CHECK(parsed_addr == expected_addr);
+  }
+}
+
+void test_v6()
+{
+  using asio::ip::address_v6;
+  using namespace std; // For strlen.
+
+  char buf[address_v6::max_chars];
+  asio::error_code ec;
+
+  // Formatting agrees with inet_ntop, and parsing recovers the address. The
+  // words are chosen to give runs of zeros of different lengths.
+  unsigned long value = 0x12345678;
+  for (int i = 0; i < 2000; ++i)
+  {
+    address_v6::bytes_type bytes;
+    for (int j = 0; j < 16; j += 2)
+    {
+      value = value * 1103515245 + 12345;
+      bool zero = ((value >> 16) & 3) != 0;
+      bytes[j] = zero ? 0 : static_cast<unsigned char>(value >> 8);
+      bytes[j + 1] = zero ? 0 : static_cast<unsigned char>(value >> 24);
+    }
+    if (i % 3 == 0)
+    {
+      for (int j = 0; j < 10; ++j)
+        bytes[j] = 0;
+      bytes[10] = bytes[11] = (i % 2) ? 0xFF : 0;
+    }
+    address_v6 addr(bytes);
+
+    char* end = addr.to_chars(buf, buf + sizeof(buf), ec);
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(std::string(buf, end) == addr.to_string());
+    ASIO_CHECK(asio::ip::make_address_v6(buf, end, ec) == addr);
+    ASIO_CHECK(!ec);
+  }
+
+  // A numeric scope ID.
+  address_v6::bytes_type site_bytes = {{ 0x20, 0x01, 0x0d, 0xb8 }};
+  address_v6 scoped_addr(site_bytes, 42);
+  char* end = scoped_addr.to_chars(buf, buf + sizeof(buf), ec);
+  ASIO_CHECK(std::string(buf, end) == "2001:db8::%42");
+  ASIO_CHECK(asio::ip::make_address_v6(buf, end, ec) == scoped_addr);
+
+  // A range that is too small.
+  end = scoped_addr.to_chars(buf, buf + 12, ec);
+  ASIO_CHECK(ec == asio::error::no_buffer_space);
+  ASIO_CHECK(end == buf);
+  end = scoped_addr.to_chars(buf, buf + 13, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(end == buf + 13);
+
+  // Parsing accepts and rejects the same strings as inet_pton.
+  const char* strings[] = { "::", "::1", "1::", "1::2", "1:2:3:4:5:6:7:8",
+    "1:2:3:4:5:6:7::", "::2:3:4:5:6:7:8", "1:2:3:4:5:6:7:8:9",
+    "1:2:3:4:5:6:7", "1:2:3:4::5:6:7:8", "1::2::3", ":1::2", "1::2:",
+    ":::", "12345::", "abcd:EF01::", "::ffff:1.2.3.4", "::1.2.3.4",
+    "1:2:3:4:5:6:1.2.3.4", "1:2:3:4:5:6:7:1.2.3.4", "::1.2.3", "::1.2.3.4:5",
+    "::256.1.1.1", "g::", "::%1", "" };
+  for (std::size_t i = 0; i < sizeof(strings) / sizeof(strings[0]); ++i)
+  {
+    asio::error_code expected_ec;
+    address_v6 expected_addr =
+      asio::ip::make_address_v6(strings[i], expected_ec);
+    address_v6 parsed_addr = asio::ip::make_address_v6(
+        strings[i], strings[i] + strlen(strings[i]), ec);
+    ASIO_CHECK(!ec == !expected_ec);
+    ASIO_CHECK(parsed_addr == expected_addr);
+  }
+}
+
+void test()
+{
+  test_v4();
+  test_v6();
+
+  using asio::ip::address;
+  char buf[address::max_chars];
+  asio::error_code ec;
+
+  // The version is chosen by the presence of a colon.
+  const char* v4_string = "192.168.0.1";
+  address addr = asio::ip::make_address(v4_string, v4_string + 11, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(addr.is_v4());
+  char* end = addr.to_chars(buf, buf + sizeof(buf), ec);
+  ASIO_CHECK(std::string(buf, end) == v4_string);
+
+  const char* v6_string = "fe80::1%3";
+  addr = asio::ip::make_address(v6_string, v6_string + 9, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(addr.is_v6());
+  ASIO_CHECK(addr.to_v6().scope_id() == 3);
+  end = addr.to_chars(buf, buf + sizeof(buf), ec);
+  ASIO_CHECK(std::string(buf, end) == v6_string);
+
+  // Failure leaves a default-constructed address.
+  addr = asio::ip::make_address(v6_string, v6_string + 5, ec);
+  ASIO_CHECK(ec == asio::error::invalid_argument);
+  ASIO_CHECK(addr == address());
+}
+
+} // namespace ip_address_chars
+
+//------------------------------------------------------------------------------
+
 ASIO_TEST_SUITE
 (
   "ip/address",
   ASIO_TEST_CASE(ip_address_compile::test)
+  ASIO_TEST_CASE(ip_address_chars::test)
 )
@@ -0,0 +1,221 @@
+//
+// basic_network_map.cpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/ip/basic_network_map.hpp"
+
+#include <utility>
+#include <vector>
+#include "../unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// ip_basic_network_map_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the basic_network_map class template finds
+// the same networks as a linear search.
+
+namespace ip_basic_network_map_runtime {
+
+using asio::ip::address_v4;
+using asio::ip::address_v6;
+using asio::ip::network_v4;
+using asio::ip::network_v6;
+
+typedef asio::ip::basic_network_map<network_v4, int> map_v4;
+typedef asio::ip::basic_network_map<network_v6, int> map_v6;
+
+// A simple pseudo-random number generator, so that the test is repeatable.
+unsigned long next_random(unsigned long& state)
+{
+  state = state * 1103515245 + 12345;
+  return (state >> 8) & 0xFFFFFF;
+}
+
+address_v4 random_v4(unsigned long& state)
+{
+  // Use few distinct leading bytes, so that networks overlap.
+  return address_v4(static_cast<address_v4::uint_type>(
+        ((next_random(state) & 3) << 30) | (next_random(state) << 6)
+        | (next_random(state) & 0x3F)));
+}
+
+address_v6 random_v6(unsigned long& state)
+{
+  address_v6::bytes_type bytes = {{ 0x20, 0x01 }};
+  bytes[2] = static_cast<unsigned char>(next_random(state) & 1);
+  for (int i = 3; i < 16; ++i)
+    bytes[i] = static_cast<unsigned char>(next_random(state));
+  return address_v6(bytes);
+}
+
+template <typename Map>
+const typename Map::value_type* linear_lookup(const Map& m,
+    const typename Map::address_type& addr)
+{
+  const typename Map::value_type* best = 0;
+  for (typename Map::const_iterator i = m.begin(); i != m.end(); ++i)
+  {
+    typename Map::network_type host(addr, i->first.prefix_length());
+    if (host.canonical() == i->first
+        && (!best || i->first.prefix_length() > best->first.prefix_length()))
+      best = &*i;
+  }
+  return best;
+}
+
+void test_v4()
+{
+  map_v4 m;
+  ASIO_CHECK(m.empty());
+  ASIO_CHECK(m.lookup(address_v4::loopback()) == 0);
+
+  // Host bits are ignored.
+  ASIO_CHECK(m.insert(network_v4(address_v4(0x0A010203), 8), 1));
+  ASIO_CHECK(m.insert(network_v4(address_v4(0x0A010000), 16), 2));
+  ASIO_CHECK(m.insert(network_v4(address_v4(0x0A010200), 23), 3));
+  ASIO_CHECK(m.size() == 3);
+  ASIO_CHECK(m.find(network_v4(address_v4(0x0A000000), 8))->second == 1);
+  ASIO_CHECK(m.find(network_v4(address_v4(0x0A000000), 9)) == 0);
+
+  ASIO_CHECK(m.lookup(address_v4(0x0A020304))->second == 1);
+  ASIO_CHECK(m.lookup(address_v4(0x0A01FF01))->second == 2);
+  ASIO_CHECK(m.lookup(address_v4(0x0A010304))->second == 3);
+  ASIO_CHECK(m.lookup(address_v4(0x0A010104))->second == 2);
+  ASIO_CHECK(m.lookup(address_v4(0x0B000000)) == 0);
+
+  // A shorter network inserted later does not hide a longer one.
+  ASIO_CHECK(m.insert(network_v4(address_v4(0x0A010000), 20), 4));
+  ASIO_CHECK(m.lookup(address_v4(0x0A010304))->second == 3);
+  ASIO_CHECK(m.lookup(address_v4(0x0A010404))->second == 4);
+
+  // Replacing a value.
+  ASIO_CHECK(!m.insert(network_v4(address_v4(0x0A010200), 23), 5));
+  ASIO_CHECK(m.size() == 4);
+  ASIO_CHECK(m.lookup(address_v4(0x0A010304))->second == 5);
+
+  // The default route and host routes.
+  ASIO_CHECK(m.insert(network_v4(address_v4(0), 0), 6));
+  ASIO_CHECK(m.lookup(address_v4(0x0B000000))->second == 6);
+  ASIO_CHECK(m.insert(network_v4(address_v4(0x0A010203), 32), 7));
+  ASIO_CHECK(m.lookup(address_v4(0x0A010203))->second == 7);
+  ASIO_CHECK(m.lookup(address_v4(0x0A010202))->second == 5);
+
+  // Removing a network uncovers the shorter networks beneath it.
+  ASIO_CHECK(m.erase(network_v4(address_v4(0x0A010200), 23)));
+  ASIO_CHECK(!m.erase(network_v4(address_v4(0x0A010200), 23)));
+  ASIO_CHECK(m.size() == 5);
+  ASIO_CHECK(m.find(network_v4(address_v4(0x0A010200), 23)) == 0);
+  ASIO_CHECK(m.lookup(address_v4(0x0A010304))->second == 4);
+  ASIO_CHECK(m.lookup(address_v4(0x0A010203))->second == 7);
+  ASIO_CHECK(m.erase(network_v4(address_v4(0), 0)));
+  ASIO_CHECK(m.lookup(address_v4(0x0B000000)) == 0);
+  ASIO_CHECK(m.find(network_v4(address_v4(0x0A010203), 32))->second == 7);
+
+  m.clear();
+  ASIO_CHECK(m.empty());
+  ASIO_CHECK(m.lookup(address_v4(0x0A010203)) == 0);
+
+  // Compare with a linear search, building the map in bulk.
+  unsigned long state = 1;
+  std::vector<std::pair<network_v4, int> > networks;
+  for (int i = 0; i < 500; ++i)
+  {
+    unsigned short length = static_cast<unsigned short>(
+        next_random(state) % 33);
+    networks.push_back(std::make_pair(
+          network_v4(random_v4(state), length), i));
+  }
+  map_v4 bulk(networks.begin(), networks.end());
+  for (int i = 0; i < 20000; ++i)
+  {
+    address_v4 addr = random_v4(state);
+    const map_v4::value_type* expected = linear_lookup(bulk, addr);
+    const map_v4::value_type* actual = bulk.lookup(addr);
+    ASIO_CHECK(expected == actual);
+  }
+
+  // Duplicates in a bulk insert keep the last value.
+  for (std::size_t i = 0; i < networks.size(); ++i)
+  {
+    const map_v4::value_type* entry = bulk.find(networks[i].first);
+    ASIO_CHECK(entry != 0);
+    for (std::size_t j = i + 1; j < networks.size(); ++j)
+      if (networks[j].first.canonical() == networks[i].first.canonical())
+        ASIO_CHECK(entry->second != networks[i].second);
+  }
+
+  // Compare again after removing every other network.
+  for (std::size_t i = 0; i < networks.size(); i += 2)
+    bulk.erase(networks[i].first);
+  for (std::size_t i = 0; i < networks.size(); i += 2)
+    ASIO_CHECK(bulk.find(networks[i].first) == 0);
+  for (int i = 0; i < 20000; ++i)
+  {
+    address_v4 addr = random_v4(state);
+    const map_v4::value_type* expected = linear_lookup(bulk, addr);
+    const map_v4::value_type* actual = bulk.lookup(addr);
+    ASIO_CHECK(expected == actual);
+  }
+}
+
+void test_v6()
+{
+  unsigned long state = 2;
+  map_v6 m;
+  for (int i = 0; i < 500; ++i)
+  {
+    unsigned short length = static_cast<unsigned short>(
+        16 + next_random(state) % 113);
+    m.insert(network_v6(random_v6(state), length), i);
+  }
+  m.insert(network_v6(address_v6(), 0), -1);
+
+  for (int i = 0; i < 20000; ++i)
+  {
+    address_v6 addr = random_v6(state);
+
+    // Also look up addresses inside each network.
+    if (i % 2 == 0)
+    {
+      const network_v6& net = (m.begin() + i / 2 % m.size())->first;
+      address_v6::bytes_type net_bytes = net.network().to_bytes();
+      address_v6::bytes_type addr_bytes = addr.to_bytes();
+      for (int b = 0; b < net.prefix_length() / 8; ++b)
+        addr_bytes[b] = net_bytes[b];
+      addr = address_v6(addr_bytes);
+    }
+
+    const map_v6::value_type* expected = linear_lookup(m, addr);
+    const map_v6::value_type* actual = m.lookup(addr);
+    ASIO_CHECK(expected == actual);
+  }
+}
+
+void test()
+{
+  test_v4();
+  test_v6();
+}
+
+} // namespace ip_basic_network_map_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "ip/basic_network_map",
+  ASIO_TEST_CASE(ip_basic_network_map_runtime::test)
+)
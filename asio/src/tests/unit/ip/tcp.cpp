@@ -20,6 +20,7 @@
 #include "asio/ip/tcp.hpp"
 
 #include <cstring>
+#include <vector>
 #include "asio/io_context.hpp"
 #include "asio/read.hpp"
 #include "asio/write.hpp"
@@ -124,6 +125,26 @@ void test()
   ASIO_CHECK(!no_delay4.value());
   ASIO_CHECK(!static_cast<bool>(no_delay4));
   ASIO_CHECK(!no_delay4);
+
+  // endpoint formatting.
+
+  char buf[ip::tcp::endpoint::max_chars];
+  ip::tcp::endpoint ep1(ip::make_address_v4("10.0.0.1"), 8080);
+  char* end = ep1.to_chars(buf, buf + sizeof(buf), ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(std::string(buf, end) == "10.0.0.1:8080");
+
+  ip::tcp::endpoint ep2(ip::make_address_v6("2001:db8::1"), 443);
+  end = ep2.to_chars(buf, buf + sizeof(buf), ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(std::string(buf, end) == "[2001:db8::1]:443");
+
+  end = ep2.to_chars(buf, buf + 16, ec);
+  ASIO_CHECK(ec == asio::error::no_buffer_space);
+  ASIO_CHECK(end == buf);
+  end = ep2.to_chars(buf, buf + 17, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(end == buf + 17);
 }
 
 } // namespace ip_tcp_runtime
@@ -484,6 +505,15 @@ void test()
     socket1.write_some(const_buffers, ec);
     socket1.write_some(null_buffers(), ec);
 
+#if defined(ASIO_HAS_CHRONO)
+    socket1.write_some_for(buffer(mutable_char_buffer),
+        asio::chrono::seconds(1));
+    socket1.write_some_for(const_buffers, asio::chrono::seconds(1));
+    socket1.write_some_for(buffer(const_char_buffer),
+        asio::chrono::milliseconds(10), ec);
+    socket1.write_some_for(mutable_buffers, asio::chrono::seconds(1), ec);
+#endif // defined(ASIO_HAS_CHRONO)
+
     socket1.async_write_some(buffer(mutable_char_buffer), write_some_handler());
     socket1.async_write_some(buffer(const_char_buffer), write_some_handler());
     socket1.async_write_some(mutable_buffers, write_some_handler());
@@ -507,6 +537,15 @@ void test()
     socket1.read_some(mutable_buffers, ec);
     socket1.read_some(null_buffers(), ec);
 
+#if defined(ASIO_HAS_CHRONO)
+    socket1.read_some_for(buffer(mutable_char_buffer),
+        asio::chrono::seconds(1));
+    socket1.read_some_for(mutable_buffers, asio::chrono::seconds(1));
+    socket1.read_some_for(buffer(mutable_char_buffer),
+        asio::chrono::milliseconds(10), ec);
+    socket1.read_some_for(mutable_buffers, asio::chrono::seconds(1), ec);
+#endif // defined(ASIO_HAS_CHRONO)
+
     socket1.async_read_some(buffer(mutable_char_buffer), read_some_handler());
     socket1.async_read_some(mutable_buffers, read_some_handler());
     socket1.async_read_some(null_buffers(), read_some_handler());
@@ -690,6 +729,120 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// ip_tcp_socket_timeout_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the synchronous operations with timeouts on
+// ip::tcp::socket, and the read_for and write_for functions.
+
+namespace ip_tcp_socket_timeout_runtime {
+
+void test()
+{
+#if defined(ASIO_HAS_CHRONO)
+  using namespace std; // For memcmp.
+  using namespace asio;
+  namespace ip = asio::ip;
+  namespace chrono = asio::chrono;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  ip::tcp::socket client_side_socket(ioc);
+  ip::tcp::socket server_side_socket(ioc);
+
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+
+  // A read with no data available times out.
+
+  char read_buffer[1024];
+  asio::error_code ec;
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  size_t length = client_side_socket.read_some_for(
+      buffer(read_buffer), chrono::milliseconds(50), ec);
+  chrono::steady_clock::duration elapsed = chrono::steady_clock::now() - start;
+  ASIO_CHECK(ec == asio::error::timed_out);
+  ASIO_CHECK(length == 0);
+  ASIO_CHECK(elapsed >= chrono::milliseconds(40));
+
+  // A zero timeout only checks for data that is already available.
+
+  length = client_side_socket.read_some_for(
+      buffer(read_buffer), chrono::milliseconds(0), ec);
+  ASIO_CHECK(ec == asio::error::timed_out);
+  ASIO_CHECK(length == 0);
+
+  // Data that is available is read.
+
+  const char data[] = "0123456789";
+  length = server_side_socket.write_some_for(
+      buffer(data, 10), chrono::seconds(5), ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(length == 10);
+
+  length = asio::read_for(client_side_socket,
+      buffer(read_buffer, 10), chrono::seconds(5), ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(length == 10);
+  ASIO_CHECK(memcmp(read_buffer, data, 10) == 0);
+
+  // A composed read returns the data read before the timeout.
+
+  asio::write(server_side_socket, buffer(data, 4));
+  length = asio::read_for(client_side_socket,
+      buffer(read_buffer, 10), chrono::milliseconds(50), ec);
+  ASIO_CHECK(ec == asio::error::timed_out);
+  ASIO_CHECK(length == 4);
+
+  // A composed write times out once the peer stops reading, and the data
+  // written before then can be read back.
+
+  vector<char> write_data(16 * 1024 * 1024);
+  for (size_t i = 0; i < write_data.size(); ++i)
+    write_data[i] = static_cast<char>(i % 251);
+  size_t written = asio::write_for(server_side_socket,
+      buffer(write_data), chrono::milliseconds(50), ec);
+  ASIO_CHECK(ec == asio::error::timed_out);
+  ASIO_CHECK(written > 0);
+  ASIO_CHECK(written < write_data.size());
+
+  vector<char> read_data(written);
+  length = asio::read_for(client_side_socket,
+      buffer(read_data), chrono::seconds(5), ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(length == written);
+  ASIO_CHECK(memcmp(&read_data[0], &write_data[0], written) == 0);
+
+  // The timeouts do not depend on the socket being in blocking mode.
+
+  client_side_socket.non_blocking(true);
+  length = client_side_socket.read_some_for(
+      buffer(read_buffer), chrono::milliseconds(10), ec);
+  ASIO_CHECK(ec == asio::error::timed_out);
+  ASIO_CHECK(length == 0);
+  asio::write(server_side_socket, buffer(data, 10));
+  length = asio::read_for(client_side_socket,
+      buffer(read_buffer, 10), chrono::seconds(5), ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(length == 10);
+
+  // A read when the peer closes the socket fails with eof.
+
+  server_side_socket.close();
+  length = client_side_socket.read_some_for(
+      buffer(read_buffer), chrono::seconds(5), ec);
+  ASIO_CHECK(ec == asio::error::eof);
+  ASIO_CHECK(length == 0);
+#endif // defined(ASIO_HAS_CHRONO)
+}
+
+} // namespace ip_tcp_socket_timeout_runtime
+
+//------------------------------------------------------------------------------
+
 // ip_tcp_acceptor_compile test
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // The following test checks that all public member functions on the class
@@ -1252,6 +1405,67 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// ip_tcp_resolver_entry_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the ip::tcp::resolver
+// entry and results types.
+
+namespace ip_tcp_resolver_entry_runtime {
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+  const std::allocator<char> alloc;
+
+  const ip::tcp::resolver::results_type::value_type entry1;
+  ASIO_CHECK(entry1.host_name().empty());
+  ASIO_CHECK(entry1.service_name(alloc).empty());
+
+  ip::tcp::endpoint endpoint(ip::address_v4::loopback(), 80);
+  const ip::tcp::resolver::results_type::value_type entry2(
+      endpoint, "", "http");
+  ASIO_CHECK(entry2.endpoint() == endpoint);
+  ASIO_CHECK(entry2.host_name().empty());
+  ASIO_CHECK(entry2.service_name() == "http");
+
+  std::vector<ip::tcp::endpoint> endpoints;
+  for (unsigned short i = 0; i < 8; ++i)
+    endpoints.push_back(ip::tcp::endpoint(
+          ip::make_address_v4("10.0.0.1"), static_cast<unsigned short>(i)));
+
+  ip::tcp::resolver::results_type::value_type entry3;
+  {
+    ip::tcp::resolver::results_type results =
+      ip::tcp::resolver::results_type::create(endpoints.begin(),
+          endpoints.end(), "a-rather-long-host-name.example.com", "https");
+    ASIO_CHECK(results.size() == endpoints.size());
+
+    unsigned short port = 0;
+    ip::tcp::resolver::results_type::const_iterator iter = results.begin();
+    for (; iter != results.end(); ++iter, ++port)
+    {
+      ASIO_CHECK(iter->endpoint().port() == port);
+      ASIO_CHECK(iter->host_name() == "a-rather-long-host-name.example.com");
+      ASIO_CHECK(iter->host_name(alloc)
+          == "a-rather-long-host-name.example.com");
+      ASIO_CHECK(iter->service_name() == "https");
+      ASIO_CHECK(iter->service_name(alloc) == "https");
+    }
+    ASIO_CHECK(port == endpoints.size());
+
+    // An entry copied from the results outlives them.
+    entry3 = *results.begin();
+  }
+  ASIO_CHECK(entry3.endpoint() == endpoints[0]);
+  ASIO_CHECK(entry3.host_name() == "a-rather-long-host-name.example.com");
+  ASIO_CHECK(entry3.service_name() == "https");
+}
+
+} // namespace ip_tcp_resolver_entry_runtime
+
+//------------------------------------------------------------------------------
+
 // ip_tcp_iostream_compile test
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // The following test checks that all public types and member functions on the
@@ -1337,10 +1551,12 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(ip_tcp_runtime::test)
   ASIO_TEST_CASE(ip_tcp_socket_compile::test)
   ASIO_TEST_CASE(ip_tcp_socket_runtime::test)
+  ASIO_TEST_CASE(ip_tcp_socket_timeout_runtime::test)
   ASIO_TEST_CASE(ip_tcp_acceptor_compile::test)
   ASIO_TEST_CASE(ip_tcp_acceptor_runtime::test)
   ASIO_TEST_CASE(ip_tcp_resolver_compile::test)
   ASIO_TEST_CASE(ip_tcp_resolver_entry_compile::test)
   ASIO_TEST_CASE(ip_tcp_resolver_entry_compile::test)
+  ASIO_TEST_CASE(ip_tcp_resolver_entry_runtime::test)
   ASIO_COMPILE_TEST_CASE(ip_tcp_iostream_compile::test)
 )
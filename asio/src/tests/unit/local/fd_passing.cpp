@@ -0,0 +1,325 @@
+//
+// fd_passing.cpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/local/fd_passing.hpp"
+
+#include <cstring>
+#include <vector>
+#include "asio/io_context.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/datagram_protocol.hpp"
+#include "asio/local/stream_protocol.hpp"
+#include "../archetypes/async_result.hpp"
+#include "../unit_test.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+# include <fcntl.h>
+# include <unistd.h>
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+
+//------------------------------------------------------------------------------
+
+// local_fd_passing_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all fd passing functions compile and link
+// correctly. Runtime failures are ignored.
+
+namespace local_fd_passing_compile {
+
+void handler(const asio::error_code&, std::size_t)
+{
+}
+
+void test()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  using namespace asio;
+  namespace local = asio::local;
+  typedef local::stream_protocol sp;
+
+  try
+  {
+    io_context ioc;
+    char mutable_char_buffer[128] = "";
+    const char const_char_buffer[128] = "";
+    int fds[2] = { -1, -1 };
+    std::vector<int> received_fds;
+    archetypes::lazy_handler lazy;
+    asio::error_code ec;
+
+    sp::socket s1(ioc);
+
+    local::send_with_fds(s1, buffer(mutable_char_buffer), fds, 2);
+    local::send_with_fds(s1, buffer(const_char_buffer), fds, 2);
+    local::send_with_fds(s1, buffer(mutable_char_buffer), fds, 2, ec);
+    local::send_with_fds(s1, buffer(const_char_buffer), fds, 2, ec);
+
+    local::async_send_with_fds(s1, buffer(mutable_char_buffer),
+        fds, 2, &handler);
+    local::async_send_with_fds(s1, buffer(const_char_buffer),
+        fds, 2, &handler);
+    int i1 = local::async_send_with_fds(s1, buffer(mutable_char_buffer),
+        fds, 2, lazy);
+    (void)i1;
+
+    local::receive_with_fds(s1, buffer(mutable_char_buffer), received_fds);
+    local::receive_with_fds(s1, buffer(mutable_char_buffer),
+        received_fds, ec);
+
+    local::async_receive_with_fds(s1, buffer(mutable_char_buffer),
+        received_fds, &handler);
+    int i2 = local::async_receive_with_fds(s1, buffer(mutable_char_buffer),
+        received_fds, lazy);
+    (void)i2;
+  }
+  catch (std::exception&)
+  {
+  }
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
+} // namespace local_fd_passing_compile
+
+//------------------------------------------------------------------------------
+
+// local_fd_passing_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the fd passing functions.
+
+namespace local_fd_passing_runtime {
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+using std::placeholders::_1;
+using std::placeholders::_2;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+void io_handler(const asio::error_code& e, std::size_t n,
+    asio::error_code* out_ec, std::size_t* out_n, bool* called)
+{
+  *out_ec = e;
+  *out_n = n;
+  *called = true;
+}
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+
+// Check that a descriptor received from the peer refers to the same pipe.
+bool same_pipe(int write_end, int received_read_end, char c)
+{
+  if (::write(write_end, &c, 1) != 1)
+    return false;
+  char r = 0;
+  return ::read(received_read_end, &r, 1) == 1 && r == c;
+}
+
+// Count the descriptors that are currently open in this process.
+int count_open_fds()
+{
+  int count = 0;
+  for (int fd = 0; fd < 4096; ++fd)
+    if (::fcntl(fd, F_GETFD) != -1)
+      ++count;
+  return count;
+}
+
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+
+void test()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  using namespace asio;
+  namespace local = asio::local;
+  typedef local::stream_protocol sp;
+
+  io_context ioc;
+  sp::socket s1(ioc);
+  sp::socket s2(ioc);
+  local::connect_pair(s1, s2);
+
+  // Pass the read ends of several pipes in one message.
+  const int num_pipes = 4;
+  int pipes[num_pipes][2];
+  int read_ends[num_pipes];
+  for (int i = 0; i < num_pipes; ++i)
+  {
+    ASIO_CHECK(::pipe(pipes[i]) == 0);
+    read_ends[i] = pipes[i][0];
+  }
+
+  const char message[] = "descriptors";
+  asio::error_code send_ec;
+  std::size_t send_n = 0;
+  bool send_called = false;
+  local::async_send_with_fds(s1, asio::buffer(message, sizeof(message)),
+      read_ends, num_pipes, bindns::bind(io_handler,
+        _1, _2, &send_ec, &send_n, &send_called));
+
+  char data[64] = "";
+  std::vector<int> received;
+  asio::error_code receive_ec;
+  std::size_t receive_n = 0;
+  bool receive_called = false;
+  local::async_receive_with_fds(s2, asio::buffer(data), received,
+      bindns::bind(io_handler, _1, _2,
+        &receive_ec, &receive_n, &receive_called));
+
+  // The handlers must not be invoked from within the initiating functions.
+  ASIO_CHECK(!send_called);
+  ASIO_CHECK(!receive_called);
+
+  ioc.run();
+
+  ASIO_CHECK(send_called);
+  ASIO_CHECK(!send_ec);
+  ASIO_CHECK(send_n == sizeof(message));
+  ASIO_CHECK(receive_called);
+  ASIO_CHECK(!receive_ec);
+  ASIO_CHECK(receive_n == sizeof(message));
+  ASIO_CHECK(std::memcmp(data, message, sizeof(message)) == 0);
+  ASIO_CHECK(received.size() == static_cast<std::size_t>(num_pipes));
+
+  for (std::size_t i = 0; i < received.size(); ++i)
+  {
+    ASIO_CHECK(received[i] != read_ends[i]);
+    ASIO_CHECK(same_pipe(pipes[i][1], received[i], static_cast<char>('a' + i)));
+    ::close(received[i]);
+  }
+
+  // Synchronous operations.
+  std::size_t n = local::send_with_fds(s1,
+      asio::buffer(message, 1), read_ends, 1);
+  ASIO_CHECK(n == 1);
+
+  received.clear();
+  n = local::receive_with_fds(s2, asio::buffer(data), received);
+  ASIO_CHECK(n == 1);
+  ASIO_CHECK(received.size() == 1);
+  if (received.size() == 1)
+  {
+    ASIO_CHECK(same_pipe(pipes[0][1], received[0], 'z'));
+    ::close(received[0]);
+  }
+
+  // Descriptors cannot be passed without data.
+  asio::error_code ec;
+  local::send_with_fds(s1, asio::const_buffer(), read_ends, 1, ec);
+  ASIO_CHECK(ec == asio::error::invalid_argument);
+
+  // Plain data without descriptors.
+  n = local::send_with_fds(s1, asio::buffer(message, 3), 0, 0);
+  ASIO_CHECK(n == 3);
+  received.clear();
+  n = local::receive_with_fds(s2, asio::buffer(data), received);
+  ASIO_CHECK(n == 3);
+  ASIO_CHECK(received.empty());
+
+#if defined(__linux__) && defined(SO_PASSCRED)
+  // Credentials take up part of the control buffer, so a full set of
+  // descriptors is truncated. None of them may be leaked.
+  int passcred = 1;
+  ASIO_CHECK(::setsockopt(s2.native_handle(), SOL_SOCKET,
+        SO_PASSCRED, &passcred, sizeof(passcred)) == 0);
+  std::vector<int> many(local::max_fds_per_message, read_ends[0]);
+  n = local::send_with_fds(s1, asio::buffer(message, 1),
+      &many[0], many.size());
+  ASIO_CHECK(n == 1);
+  int open_fds = count_open_fds();
+  received.clear();
+  n = local::receive_with_fds(s2, asio::buffer(data), received, ec);
+  ASIO_CHECK(ec == asio::error::message_size);
+  ASIO_CHECK(n == 1);
+  ASIO_CHECK(received.empty());
+  ASIO_CHECK(count_open_fds() == open_fds);
+  passcred = 0;
+  ::setsockopt(s2.native_handle(), SOL_SOCKET,
+      SO_PASSCRED, &passcred, sizeof(passcred));
+#endif // defined(__linux__) && defined(SO_PASSCRED)
+
+  // A datagram larger than the chunk size used for streams is still sent as a
+  // single message, together with its descriptors.
+  typedef local::datagram_protocol dp;
+  dp::socket d1(ioc);
+  dp::socket d2(ioc);
+  local::connect_pair(d1, d2);
+  d1.set_option(socket_base::send_buffer_size(256 * 1024));
+  d2.set_option(socket_base::receive_buffer_size(256 * 1024));
+  std::vector<char> datagram(70000, 'd');
+  std::vector<char> datagram_data(datagram.size() + 1);
+  n = local::send_with_fds(d1, asio::buffer(datagram), read_ends, 1);
+  ASIO_CHECK(n == datagram.size());
+  received.clear();
+  n = local::receive_with_fds(d2, asio::buffer(datagram_data), received);
+  ASIO_CHECK(n == datagram.size());
+  ASIO_CHECK(received.size() == 1);
+  for (std::size_t i = 0; i < received.size(); ++i)
+    ::close(received[i]);
+
+  send_called = false;
+  local::async_send_with_fds(d1, asio::buffer(datagram), read_ends, 1,
+      bindns::bind(io_handler, _1, _2, &send_ec, &send_n, &send_called));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(send_called);
+  ASIO_CHECK(!send_ec);
+  ASIO_CHECK(send_n == datagram.size());
+  received.clear();
+  n = local::receive_with_fds(d2, asio::buffer(datagram_data), received);
+  ASIO_CHECK(n == datagram.size());
+  ASIO_CHECK(received.size() == 1);
+  for (std::size_t i = 0; i < received.size(); ++i)
+    ::close(received[i]);
+
+  // End of file.
+  s1.close();
+  receive_called = false;
+  local::async_receive_with_fds(s2, asio::buffer(data), received,
+      bindns::bind(io_handler, _1, _2,
+        &receive_ec, &receive_n, &receive_called));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(receive_called);
+  ASIO_CHECK(receive_ec == asio::error::eof);
+  ASIO_CHECK(receive_n == 0);
+
+  for (int i = 0; i < num_pipes; ++i)
+  {
+    ::close(pipes[i][0]);
+    ::close(pipes[i][1]);
+  }
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
+} // namespace local_fd_passing_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "local/fd_passing",
+  ASIO_TEST_CASE(local_fd_passing_compile::test)
+  ASIO_TEST_CASE(local_fd_passing_runtime::test)
+)
@@ -0,0 +1,425 @@
+//
+// shared_memory_channel.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/local/shared_memory_channel.hpp"
+
+#include <cstring>
+#include <vector>
+#include "asio/io_context.hpp"
+#include "../archetypes/async_result.hpp"
+#include "../unit_test.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+#if defined(ASIO_HAS_SHARED_MEMORY_CHANNEL)
+# include <sys/mman.h>
+# include <sys/types.h>
+# include <sys/wait.h>
+# include <unistd.h>
+#endif // defined(ASIO_HAS_SHARED_MEMORY_CHANNEL)
+
+//------------------------------------------------------------------------------
+
+// local_shared_memory_channel_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// local::shared_memory_channel compile and link correctly. Runtime failures
+// are ignored.
+
+namespace local_shared_memory_channel_compile {
+
+void io_handler(const asio::error_code&, std::size_t)
+{
+}
+
+void test()
+{
+#if defined(ASIO_HAS_SHARED_MEMORY_CHANNEL)
+  using namespace asio;
+  namespace local = asio::local;
+
+  try
+  {
+    io_context ioc;
+    const io_context::executor_type ioc_ex = ioc.get_executor();
+    char mutable_char_buffer[128] = "";
+    const char const_char_buffer[128] = "";
+    archetypes::lazy_handler lazy;
+    asio::error_code ec;
+
+    // basic_shared_memory_channel constructors.
+
+    local::shared_memory_channel channel1(ioc);
+    local::shared_memory_channel channel2(ioc_ex);
+
+    // Creation and assignment.
+
+    local::create_shared_memory_channel(channel1, channel2, 4096);
+    local::create_shared_memory_channel(channel1, channel2, 4096, ec);
+
+    local::shared_memory_channel::native_handle_type h1
+      = channel1.native_handle();
+    channel1.assign(local::shared_memory_channel::writer, h1);
+    channel1.assign(local::shared_memory_channel::reader, h1, ec);
+
+    local::shared_memory_channel::native_handle_type h2 = channel2.release();
+    (void)h2;
+
+    // basic_shared_memory_channel functions.
+
+    local::shared_memory_channel::executor_type ex = channel1.get_executor();
+    (void)ex;
+
+    bool is_open = channel1.is_open();
+    (void)is_open;
+
+    local::shared_memory_channel::end_type end = channel1.end();
+    (void)end;
+
+    std::size_t max_size = channel1.max_message_size();
+    (void)max_size;
+
+    channel1.cancel();
+    channel1.cancel(ec);
+
+    channel1.close();
+    channel1.close(ec);
+
+    channel1.write(buffer(mutable_char_buffer));
+    channel1.write(buffer(const_char_buffer));
+    channel1.write(buffer(mutable_char_buffer), ec);
+    channel1.write(buffer(const_char_buffer), ec);
+
+    channel1.async_write(buffer(mutable_char_buffer), &io_handler);
+    channel1.async_write(buffer(const_char_buffer), &io_handler);
+    int i1 = channel1.async_write(buffer(mutable_char_buffer), lazy);
+    (void)i1;
+
+    channel1.read(buffer(mutable_char_buffer));
+    channel1.read(buffer(mutable_char_buffer), ec);
+
+    channel1.async_read(buffer(mutable_char_buffer), &io_handler);
+    int i2 = channel1.async_read(buffer(mutable_char_buffer), lazy);
+    (void)i2;
+  }
+  catch (std::exception&)
+  {
+  }
+#endif // defined(ASIO_HAS_SHARED_MEMORY_CHANNEL)
+}
+
+} // namespace local_shared_memory_channel_compile
+
+//------------------------------------------------------------------------------
+
+// local_shared_memory_channel_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the shared memory
+// channel within a single process.
+
+namespace local_shared_memory_channel_runtime {
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+using std::placeholders::_1;
+using std::placeholders::_2;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+void io_handler(const asio::error_code& e, std::size_t n,
+    asio::error_code* out_ec, std::size_t* out_n, int* count)
+{
+  *out_ec = e;
+  *out_n = n;
+  ++*count;
+}
+
+void test()
+{
+#if defined(ASIO_HAS_SHARED_MEMORY_CHANNEL)
+  using namespace asio;
+  namespace local = asio::local;
+  typedef local::shared_memory_channel channel_type;
+
+  io_context ioc;
+  channel_type writer(ioc);
+  channel_type reader(ioc);
+  local::create_shared_memory_channel(writer, reader, 1000);
+
+  ASIO_CHECK(writer.is_open());
+  ASIO_CHECK(reader.is_open());
+  ASIO_CHECK(writer.end() == channel_type::writer);
+  ASIO_CHECK(reader.end() == channel_type::reader);
+  ASIO_CHECK(writer.max_message_size() == 1024 - 4);
+
+  // Each end supports only its own direction.
+  char data[256] = "";
+  asio::error_code ec;
+  reader.write(asio::buffer(data, 1), ec);
+  ASIO_CHECK(ec == asio::error::operation_not_supported);
+  writer.read(asio::buffer(data), ec);
+  ASIO_CHECK(ec == asio::error::operation_not_supported);
+
+  // A message gathered from several buffers is read as one.
+  const char part1[] = "hello, ";
+  const char part2[] = "world";
+  std::vector<asio::const_buffer> parts;
+  parts.push_back(asio::buffer(part1, std::strlen(part1)));
+  parts.push_back(asio::buffer(part2, std::strlen(part2)));
+  std::size_t n = writer.write(parts);
+  ASIO_CHECK(n == 12);
+  n = reader.read(asio::buffer(data));
+  ASIO_CHECK(n == 12);
+  ASIO_CHECK(std::memcmp(data, "hello, world", 12) == 0);
+
+  // An asynchronous read waits for the writer. Neither handler is invoked
+  // from within its initiating function.
+  asio::error_code read_ec, write_ec;
+  std::size_t read_n = 0, write_n = 0;
+  int read_count = 0, write_count = 0;
+  reader.async_read(asio::buffer(data), bindns::bind(io_handler,
+        _1, _2, &read_ec, &read_n, &read_count));
+  ioc.poll();
+  ASIO_CHECK(read_count == 0);
+
+  writer.async_write(asio::buffer("abc", 3), bindns::bind(io_handler,
+        _1, _2, &write_ec, &write_n, &write_count));
+  ASIO_CHECK(write_count == 0);
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(write_count == 1);
+  ASIO_CHECK(!write_ec);
+  ASIO_CHECK(write_n == 3);
+  ASIO_CHECK(read_count == 1);
+  ASIO_CHECK(!read_ec);
+  ASIO_CHECK(read_n == 3);
+  ASIO_CHECK(std::memcmp(data, "abc", 3) == 0);
+
+  // A writer that finds the ring full waits for the reader. Messages of 200
+  // bytes occupy 208 bytes of the ring, so only four fit.
+  char message[200];
+  for (int i = 0; i < 5; ++i)
+  {
+    std::memset(message, 'a' + i, sizeof(message));
+    write_count = 0;
+    writer.async_write(asio::buffer(message), bindns::bind(io_handler,
+          _1, _2, &write_ec, &write_n, &write_count));
+    ioc.restart();
+    ioc.run_for(asio::chrono::milliseconds(i < 4 ? 1000 : 50));
+    ASIO_CHECK(write_count == (i < 4 ? 1 : 0));
+  }
+
+  n = reader.read(asio::buffer(data));
+  ASIO_CHECK(n == 200);
+  ASIO_CHECK(data[0] == 'a' && data[199] == 'a');
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(write_count == 1);
+  ASIO_CHECK(!write_ec);
+
+  for (int i = 1; i < 5; ++i)
+  {
+    n = reader.read(asio::buffer(data));
+    ASIO_CHECK(n == 200);
+    ASIO_CHECK(data[0] == 'a' + i && data[199] == 'a' + i);
+  }
+
+  // A message larger than the buffer is truncated.
+  writer.write(asio::buffer(message, 100));
+  n = reader.read(asio::buffer(data, 10), ec);
+  ASIO_CHECK(ec == asio::error::message_size);
+  ASIO_CHECK(n == 10);
+
+  // A message larger than the ring is rejected.
+  std::vector<char> too_large(writer.max_message_size() + 1);
+  writer.write(asio::buffer(too_large), ec);
+  ASIO_CHECK(ec == asio::error::message_size);
+
+  // A reader sees the messages written before the writer closed, followed by
+  // end of file.
+  writer.write(asio::buffer("xyz", 3));
+  read_count = 0;
+  reader.async_read(asio::buffer(data), bindns::bind(io_handler,
+        _1, _2, &read_ec, &read_n, &read_count));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(read_count == 1);
+  ASIO_CHECK(read_n == 3);
+
+  read_count = 0;
+  reader.async_read(asio::buffer(data), bindns::bind(io_handler,
+        _1, _2, &read_ec, &read_n, &read_count));
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(read_count == 0);
+
+  writer.close();
+  ASIO_CHECK(!writer.is_open());
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(read_count == 1);
+  ASIO_CHECK(read_ec == asio::error::eof);
+  ASIO_CHECK(read_n == 0);
+
+  // A writer sees a broken pipe once the reader has closed.
+  channel_type writer2(ioc);
+  channel_type reader2(ioc);
+  local::create_shared_memory_channel(writer2, reader2, 4096);
+  reader2.close();
+  writer2.write(asio::buffer("x", 1), ec);
+  ASIO_CHECK(ec == asio::error::broken_pipe);
+
+  // Cancellation.
+  channel_type writer3(ioc);
+  channel_type reader3(ioc);
+  local::create_shared_memory_channel(writer3, reader3, 4096);
+  read_count = 0;
+  reader3.async_read(asio::buffer(data), bindns::bind(io_handler,
+        _1, _2, &read_ec, &read_n, &read_count));
+  ioc.restart();
+  ioc.poll();
+  reader3.cancel();
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(read_count == 1);
+  ASIO_CHECK(read_ec == asio::error::operation_aborted);
+
+  // A frame that claims more data than the writer has published is rejected
+  // without being copied, and the reader does not move past it. The region
+  // holds the header, with the write position at offset 64, and then the
+  // data area at offset 256.
+  channel_type writer4(ioc);
+  channel_type reader4(ioc);
+  local::create_shared_memory_channel(writer4, reader4, 4096);
+  writer4.write(asio::buffer("abc", 3));
+  void* region = ::mmap(0, 256 + 4096, PROT_READ | PROT_WRITE,
+      MAP_SHARED, reader4.native_handle().memory, 0);
+  ASIO_CHECK(region != MAP_FAILED);
+  if (region != MAP_FAILED)
+  {
+    unsigned char* bytes = static_cast<unsigned char*>(region);
+    asio::uint32_t length = 2000;
+    std::memcpy(bytes + 256, &length, sizeof(length));
+    n = reader4.read(asio::buffer(data), ec);
+    ASIO_CHECK(ec == asio::error::invalid_argument);
+    ASIO_CHECK(n == 0);
+    n = reader4.read(asio::buffer(data), ec);
+    ASIO_CHECK(ec == asio::error::invalid_argument);
+
+    // A write position beyond the capacity of the ring is also rejected.
+    length = 3;
+    std::memcpy(bytes + 256, &length, sizeof(length));
+    asio::uint64_t write_pos = 8 + 8192;
+    std::memcpy(bytes + 64, &write_pos, sizeof(write_pos));
+    channel_type reader5(ioc);
+    channel_type::native_handle_type handles = reader4.release();
+    reader5.assign(channel_type::reader, handles);
+    n = reader5.read(asio::buffer(data), ec);
+    ASIO_CHECK(ec == asio::error::invalid_argument);
+    ASIO_CHECK(n == 0);
+
+    ::munmap(region, 256 + 4096);
+  }
+#endif // defined(ASIO_HAS_SHARED_MEMORY_CHANNEL)
+}
+
+} // namespace local_shared_memory_channel_runtime
+
+//------------------------------------------------------------------------------
+
+// local_shared_memory_channel_fork test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that messages pass between processes, with the
+// reader parking and being woken by the writer.
+
+namespace local_shared_memory_channel_fork {
+
+void test()
+{
+#if defined(ASIO_HAS_SHARED_MEMORY_CHANNEL)
+  using namespace asio;
+  namespace local = asio::local;
+  typedef local::shared_memory_channel channel_type;
+
+  io_context ioc;
+  channel_type writer(ioc);
+  channel_type reader(ioc);
+  local::create_shared_memory_channel(writer, reader, 4096);
+
+  const int num_messages = 10000;
+
+  pid_t pid = ::fork();
+  ASIO_CHECK(pid != -1);
+  if (pid == 0)
+  {
+    ioc.notify_fork(io_context::fork_child);
+    reader.release();
+    for (int i = 0; i < num_messages; ++i)
+    {
+      asio::error_code ec;
+      writer.write(asio::buffer(&i, sizeof(i)), ec);
+      if (ec)
+        ::_exit(1);
+    }
+    writer.close();
+    ::_exit(0);
+  }
+
+  writer.release();
+
+  int expected = 0;
+  bool in_order = true;
+  for (;;)
+  {
+    int value = -1;
+    asio::error_code ec;
+    std::size_t n = reader.read(asio::buffer(&value, sizeof(value)), ec);
+    if (ec)
+    {
+      ASIO_CHECK(ec == asio::error::eof);
+      break;
+    }
+    in_order = in_order && n == sizeof(value) && value == expected;
+    ++expected;
+  }
+
+  ASIO_CHECK(in_order);
+  ASIO_CHECK(expected == num_messages);
+
+  int status = 0;
+  ::waitpid(pid, &status, 0);
+  ASIO_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+#endif // defined(ASIO_HAS_SHARED_MEMORY_CHANNEL)
+}
+
+} // namespace local_shared_memory_channel_fork
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "local/shared_memory_channel",
+  ASIO_TEST_CASE(local_shared_memory_channel_compile::test)
+  ASIO_TEST_CASE(local_shared_memory_channel_runtime::test)
+  ASIO_TEST_CASE(local_shared_memory_channel_fork::test)
+)
@@ -0,0 +1,245 @@
+//
+// socket_dispatcher.cpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/local/socket_dispatcher.hpp"
+
+#include <vector>
+#include "asio/io_context.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/fd_passing.hpp"
+#include "asio/local/stream_protocol.hpp"
+#include "asio/read.hpp"
+#include "asio/write.hpp"
+#include "../archetypes/async_result.hpp"
+#include "../unit_test.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+# include <unistd.h>
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+
+//------------------------------------------------------------------------------
+
+// local_socket_dispatcher_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// local::socket_dispatcher compile and link correctly. Runtime failures are
+// ignored.
+
+namespace local_socket_dispatcher_compile {
+
+void dispatch_handler(const asio::error_code&, std::size_t)
+{
+}
+
+void test()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS) && defined(ASIO_HAS_MOVE)
+  using namespace asio;
+  namespace local = asio::local;
+  typedef local::stream_protocol sp;
+
+  try
+  {
+    io_context ioc;
+    archetypes::lazy_handler lazy;
+
+    local::socket_dispatcher dispatcher;
+
+    std::size_t i1 = dispatcher.add_worker(sp::socket(ioc));
+    (void)i1;
+
+    std::size_t i2 = dispatcher.worker_count();
+    (void)i2;
+
+    sp::socket& s1 = dispatcher.channel(0);
+    (void)s1;
+
+    bool b1 = dispatcher.is_available(0);
+    (void)b1;
+
+    std::size_t i3 = dispatcher.pending(0);
+    (void)i3;
+
+    dispatcher.async_dispatch(sp::socket(ioc), &dispatch_handler);
+    int i4 = dispatcher.async_dispatch(sp::socket(ioc), lazy);
+    (void)i4;
+  }
+  catch (std::exception&)
+  {
+  }
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS) && defined(ASIO_HAS_MOVE)
+}
+
+} // namespace local_socket_dispatcher_compile
+
+//------------------------------------------------------------------------------
+
+// local_socket_dispatcher_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the socket dispatcher.
+
+namespace local_socket_dispatcher_runtime {
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+using std::placeholders::_1;
+using std::placeholders::_2;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+void dispatch_handler(const asio::error_code& e, std::size_t worker,
+    asio::error_code* out_ec, std::size_t* out_worker, int* count)
+{
+  *out_ec = e;
+  *out_worker = worker;
+  ++*count;
+}
+
+void test()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS) && defined(ASIO_HAS_MOVE)
+  using namespace asio;
+  namespace local = asio::local;
+  typedef local::stream_protocol sp;
+
+  io_context ioc;
+  local::socket_dispatcher dispatcher;
+  asio::error_code ec;
+  std::size_t worker = 0;
+  int count = 0;
+
+  // With no workers, the dispatch fails without invoking the handler from
+  // within the initiating function.
+  sp::socket orphan(ioc), orphan_peer(ioc);
+  local::connect_pair(orphan, orphan_peer);
+  dispatcher.async_dispatch(std::move(orphan),
+      bindns::bind(dispatch_handler, _1, _2, &ec, &worker, &count));
+  ASIO_CHECK(count == 0);
+  ioc.run();
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(ec == asio::error::not_connected);
+
+  // Two workers, each reached over its own channel.
+  sp::socket worker_ends[2] = { sp::socket(ioc), sp::socket(ioc) };
+  for (int i = 0; i < 2; ++i)
+  {
+    sp::socket channel(ioc);
+    local::connect_pair(channel, worker_ends[i]);
+    ASIO_CHECK(dispatcher.add_worker(std::move(channel))
+        == static_cast<std::size_t>(i));
+  }
+  ASIO_CHECK(dispatcher.worker_count() == 2);
+
+  // Dispatch four connected sockets, keeping their peers in this process.
+  const int num_sockets = 4;
+  std::vector<sp::socket> peers;
+  std::size_t dispatched_to[num_sockets] = { 0 };
+  asio::error_code dispatch_ec[num_sockets];
+  count = 0;
+  for (int i = 0; i < num_sockets; ++i)
+  {
+    sp::socket s(ioc), peer(ioc);
+    local::connect_pair(s, peer);
+    peers.push_back(std::move(peer));
+    dispatcher.async_dispatch(std::move(s),
+        bindns::bind(dispatch_handler, _1, _2,
+          &dispatch_ec[i], &dispatched_to[i], &count));
+  }
+
+  // Dispatches in progress are spread across the workers.
+  ASIO_CHECK(dispatcher.pending(0) == 2);
+  ASIO_CHECK(dispatcher.pending(1) == 2);
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(count == num_sockets);
+  int per_worker[2] = { 0, 0 };
+  for (int i = 0; i < num_sockets; ++i)
+  {
+    ASIO_CHECK(!dispatch_ec[i]);
+    ASIO_CHECK(dispatched_to[i] < 2);
+    if (dispatched_to[i] < 2)
+      ++per_worker[dispatched_to[i]];
+  }
+  ASIO_CHECK(per_worker[0] == 2);
+  ASIO_CHECK(per_worker[1] == 2);
+  ASIO_CHECK(dispatcher.pending(0) == 0);
+  ASIO_CHECK(dispatcher.pending(1) == 0);
+
+  // Each worker adopts its descriptors, and they remain connected to the
+  // peers.
+  for (int i = 0; i < num_sockets; ++i)
+  {
+    std::size_t w = dispatched_to[i] < 2 ? dispatched_to[i] : 0;
+    char byte = 0;
+    std::vector<int> fds;
+    std::size_t n = local::receive_with_fds(
+        worker_ends[w], asio::buffer(&byte, 1), fds);
+    ASIO_CHECK(n == 1);
+    ASIO_CHECK(fds.size() == 1);
+    if (fds.size() != 1)
+      continue;
+
+    sp::socket adopted(ioc);
+    adopted.assign(sp(), fds[0]);
+    char c = static_cast<char>('a' + i);
+    asio::write(adopted, asio::buffer(&c, 1));
+  }
+
+  // Reading from every peer confirms that each received its byte.
+  for (int i = 0; i < num_sockets; ++i)
+  {
+    char c = 0;
+    asio::read(peers[i], asio::buffer(&c, 1), ec);
+    ASIO_CHECK(!ec);
+  }
+
+  // A worker whose channel has failed is taken out of rotation, and the
+  // dispatch is retried on the remaining worker.
+  worker_ends[0].close();
+  sp::socket s(ioc), peer(ioc);
+  local::connect_pair(s, peer);
+  count = 0;
+  dispatcher.async_dispatch(std::move(s),
+      bindns::bind(dispatch_handler, _1, _2, &ec, &worker, &count));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(worker == 1);
+  ASIO_CHECK(!dispatcher.is_available(0));
+  ASIO_CHECK(dispatcher.is_available(1));
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS) && defined(ASIO_HAS_MOVE)
+}
+
+} // namespace local_socket_dispatcher_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "local/socket_dispatcher",
+  ASIO_TEST_CASE(local_socket_dispatcher_compile::test)
+  ASIO_TEST_CASE(local_socket_dispatcher_runtime::test)
+)
@@ -0,0 +1,307 @@
+//
+// random_access_file.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/random_access_file.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "asio/io_context.hpp"
+#include "asio/read_at.hpp"
+#include "asio/write_at.hpp"
+#include "archetypes/async_result.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+//------------------------------------------------------------------------------
+
+// random_access_file_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// random_access_file compile and link correctly. Runtime failures are ignored.
+
+namespace random_access_file_compile {
+
+void write_some_handler(const asio::error_code&, std::size_t)
+{
+}
+
+void read_some_handler(const asio::error_code&, std::size_t)
+{
+}
+
+void test()
+{
+#if defined(ASIO_HAS_FILE)
+  using namespace asio;
+
+  try
+  {
+    io_context ioc;
+    const io_context::executor_type ioc_ex = ioc.get_executor();
+    char mutable_char_buffer[128] = "";
+    const char const_char_buffer[128] = "";
+    asio::uint64_t offset = 0;
+    archetypes::lazy_handler lazy;
+    asio::error_code ec;
+
+    // basic_random_access_file constructors.
+
+    random_access_file file1(ioc);
+    random_access_file file2(ioc, "", random_access_file::read_only);
+    random_access_file::native_handle_type native_file1 = -1;
+    random_access_file file3(ioc, native_file1);
+
+    random_access_file file4(ioc_ex);
+    random_access_file file5(ioc_ex, "", random_access_file::read_only);
+    random_access_file::native_handle_type native_file2 = -1;
+    random_access_file file6(ioc_ex, native_file2);
+
+#if defined(ASIO_HAS_MOVE)
+    random_access_file file7(std::move(file4));
+#endif // defined(ASIO_HAS_MOVE)
+
+    // basic_random_access_file operators.
+
+#if defined(ASIO_HAS_MOVE)
+    file1 = random_access_file(ioc);
+    file1 = std::move(file4);
+#endif // defined(ASIO_HAS_MOVE)
+
+    // basic_file functions.
+
+    random_access_file::executor_type ex = file1.get_executor();
+    (void)ex;
+
+    file1.open("", random_access_file::read_only);
+    file1.open("", random_access_file::read_only, ec);
+
+    file1.open(std::string(""), random_access_file::read_only);
+    file1.open(std::string(""), random_access_file::read_only, ec);
+
+    random_access_file::native_handle_type native_file3 = -1;
+    file1.assign(native_file3);
+    random_access_file::native_handle_type native_file4 = -1;
+    file1.assign(native_file4, ec);
+
+    bool is_open = file1.is_open();
+    (void)is_open;
+
+    file1.close();
+    file1.close(ec);
+
+    random_access_file::native_handle_type native_file5 = file1.release();
+    (void)native_file5;
+    random_access_file::native_handle_type native_file6 = file1.release(ec);
+    (void)native_file6;
+
+    random_access_file::native_handle_type native_file7
+      = file1.native_handle();
+    (void)native_file7;
+
+    file1.cancel();
+    file1.cancel(ec);
+
+    asio::uint64_t s1 = file1.size();
+    (void)s1;
+    asio::uint64_t s2 = file1.size(ec);
+    (void)s2;
+
+    file1.resize(asio::uint64_t(0));
+    file1.resize(asio::uint64_t(0), ec);
+
+    file1.sync_all();
+    file1.sync_all(ec);
+
+    file1.sync_data();
+    file1.sync_data(ec);
+
+    // basic_random_access_file functions.
+
+    file1.write_some_at(offset, buffer(mutable_char_buffer));
+    file1.write_some_at(offset, buffer(const_char_buffer));
+    file1.write_some_at(offset, buffer(mutable_char_buffer), ec);
+    file1.write_some_at(offset, buffer(const_char_buffer), ec);
+
+    file1.async_write_some_at(offset,
+        buffer(mutable_char_buffer), &write_some_handler);
+    file1.async_write_some_at(offset,
+        buffer(const_char_buffer), &write_some_handler);
+    int i1 = file1.async_write_some_at(offset,
+        buffer(mutable_char_buffer), lazy);
+    (void)i1;
+    int i2 = file1.async_write_some_at(offset,
+        buffer(const_char_buffer), lazy);
+    (void)i2;
+
+    file1.read_some_at(offset, buffer(mutable_char_buffer));
+    file1.read_some_at(offset, buffer(mutable_char_buffer), ec);
+
+    file1.async_read_some_at(offset,
+        buffer(mutable_char_buffer), &read_some_handler);
+    int i3 = file1.async_read_some_at(offset,
+        buffer(mutable_char_buffer), lazy);
+    (void)i3;
+  }
+  catch (std::exception&)
+  {
+  }
+#endif // defined(ASIO_HAS_FILE)
+}
+
+} // namespace random_access_file_compile
+
+//------------------------------------------------------------------------------
+
+// random_access_file_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the random_access_file
+// class.
+
+namespace random_access_file_runtime {
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+using std::placeholders::_1;
+using std::placeholders::_2;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+void io_handler(const asio::error_code& e, std::size_t n,
+    asio::error_code* out_ec, std::size_t* out_n, int* count)
+{
+  *out_ec = e;
+  *out_n = n;
+  ++*count;
+}
+
+void test()
+{
+#if defined(ASIO_HAS_FILE)
+  using namespace asio;
+
+  char path[] = "/tmp/asio_random_access_file_XXXXXX";
+  int fd = ::mkstemp(path);
+  ASIO_CHECK(fd != -1);
+  if (fd == -1)
+    return;
+  ::close(fd);
+
+  io_context ioc;
+  random_access_file file(ioc, path,
+      random_access_file::read_write | random_access_file::truncate);
+  ASIO_CHECK(file.is_open());
+
+  // Queue many adjacent writes at once, so that they may be combined.
+  const std::size_t chunk = 1000;
+  const std::size_t chunks = 64;
+  std::vector<char> data(chunk * chunks);
+  for (std::size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i % 251);
+
+  std::vector<asio::error_code> ecs(chunks);
+  std::vector<std::size_t> lengths(chunks);
+  int count = 0;
+  for (std::size_t i = 0; i < chunks; ++i)
+  {
+    asio::async_write_at(file, i * chunk,
+        asio::buffer(&data[i * chunk], chunk),
+        bindns::bind(io_handler, _1, _2, &ecs[i], &lengths[i], &count));
+  }
+
+  // The handlers must not be invoked from within the initiating functions.
+  ASIO_CHECK(count == 0);
+
+  ioc.run();
+
+  ASIO_CHECK(count == static_cast<int>(chunks));
+  for (std::size_t i = 0; i < chunks; ++i)
+  {
+    ASIO_CHECK(!ecs[i]);
+    ASIO_CHECK(lengths[i] == chunk);
+  }
+  ASIO_CHECK(file.size() == data.size());
+
+  // Read it back in adjacent pieces.
+  std::vector<char> received(data.size());
+  count = 0;
+  for (std::size_t i = 0; i < chunks; ++i)
+  {
+    asio::async_read_at(file, i * chunk,
+        asio::buffer(&received[i * chunk], chunk),
+        bindns::bind(io_handler, _1, _2, &ecs[i], &lengths[i], &count));
+  }
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(count == static_cast<int>(chunks));
+  for (std::size_t i = 0; i < chunks; ++i)
+  {
+    ASIO_CHECK(!ecs[i]);
+    ASIO_CHECK(lengths[i] == chunk);
+  }
+  ASIO_CHECK(std::memcmp(&data[0], &received[0], data.size()) == 0);
+
+  // Reads that straddle or start beyond the end of the file.
+  char buf[2 * chunk];
+  asio::error_code ec1, ec2;
+  std::size_t n1 = 0, n2 = 0;
+  count = 0;
+  file.async_read_some_at(data.size() - chunk, asio::buffer(buf),
+      bindns::bind(io_handler, _1, _2, &ec1, &n1, &count));
+  file.async_read_some_at(data.size() + chunk, asio::buffer(buf),
+      bindns::bind(io_handler, _1, _2, &ec2, &n2, &count));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(count == 2);
+  ASIO_CHECK(!ec1);
+  ASIO_CHECK(n1 == chunk);
+  ASIO_CHECK(ec2 == asio::error::eof);
+  ASIO_CHECK(n2 == 0);
+
+  // Synchronous operations.
+  ASIO_CHECK(file.write_some_at(0, asio::buffer("xyz", 3)) == 3);
+  ASIO_CHECK(file.read_some_at(0, asio::buffer(buf, 3)) == 3);
+  ASIO_CHECK(std::memcmp(buf, "xyz", 3) == 0);
+
+  file.resize(10);
+  ASIO_CHECK(file.size() == 10);
+
+  file.close();
+  ASIO_CHECK(!file.is_open());
+  ::unlink(path);
+#endif // defined(ASIO_HAS_FILE)
+}
+
+} // namespace random_access_file_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "random_access_file",
+  ASIO_TEST_CASE(random_access_file_compile::test)
+  ASIO_TEST_CASE(random_access_file_runtime::test)
+)
@@ -17,10 +17,16 @@
 // Test that header file is self-contained.
 #include "asio/serial_port.hpp"
 
+#include <vector>
 #include "archetypes/async_result.hpp"
 #include "asio/io_context.hpp"
 #include "unit_test.hpp"
 
+#if defined(ASIO_HAS_SERIAL_PORT) && !defined(ASIO_WINDOWS)
+# include <fcntl.h>
+# include <unistd.h>
+#endif // defined(ASIO_HAS_SERIAL_PORT) && !defined(ASIO_WINDOWS)
+
 //------------------------------------------------------------------------------
 
 // serial_port_compile test
@@ -142,6 +148,13 @@ void test()
     port1.write_some(buffer(mutable_char_buffer), ec);
     port1.write_some(buffer(const_char_buffer), ec);
 
+#if defined(ASIO_HAS_CHRONO)
+    port1.write_some_for(buffer(mutable_char_buffer),
+        asio::chrono::seconds(1));
+    port1.write_some_for(buffer(const_char_buffer),
+        asio::chrono::milliseconds(10), ec);
+#endif // defined(ASIO_HAS_CHRONO)
+
     port1.async_write_some(buffer(mutable_char_buffer), write_some_handler());
     port1.async_write_some(buffer(const_char_buffer), write_some_handler());
     int i1 = port1.async_write_some(buffer(mutable_char_buffer), lazy);
@@ -152,6 +165,13 @@ void test()
     port1.read_some(buffer(mutable_char_buffer));
     port1.read_some(buffer(mutable_char_buffer), ec);
 
+#if defined(ASIO_HAS_CHRONO)
+    port1.read_some_for(buffer(mutable_char_buffer),
+        asio::chrono::seconds(1));
+    port1.read_some_for(buffer(mutable_char_buffer),
+        asio::chrono::milliseconds(10), ec);
+#endif // defined(ASIO_HAS_CHRONO)
+
     port1.async_read_some(buffer(mutable_char_buffer), read_some_handler());
     int i3 = port1.async_read_some(buffer(mutable_char_buffer), lazy);
     (void)i3;
@@ -166,8 +186,79 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// serial_port_timeout_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the synchronous operations with timeouts on
+// serial_port return when the timeout expires, even when the descriptor is in
+// blocking mode. A pipe stands in for the serial device.
+
+namespace serial_port_timeout_runtime {
+
+void test()
+{
+#if defined(ASIO_HAS_SERIAL_PORT) && defined(ASIO_HAS_CHRONO) \
+  && !defined(ASIO_WINDOWS)
+  using namespace asio;
+  namespace chrono = asio::chrono;
+
+  int fds[2];
+  ASIO_CHECK(::pipe(fds) == 0);
+
+  io_context ioc;
+  serial_port reader(ioc);
+  serial_port writer(ioc);
+  reader.assign(fds[0]);
+  writer.assign(fds[1]);
+
+  // A write larger than the pipe's buffer fills it and then times out.
+  std::vector<char> data(1024 * 1024);
+  asio::error_code ec;
+  std::size_t total = 0;
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for (;;)
+  {
+    std::size_t n = writer.write_some_for(buffer(data),
+        chrono::milliseconds(100), ec);
+    total += n;
+    if (ec)
+      break;
+  }
+  chrono::steady_clock::duration elapsed = chrono::steady_clock::now() - start;
+  ASIO_CHECK(ec == asio::error::timed_out);
+  ASIO_CHECK(total > 0);
+  ASIO_CHECK(elapsed < chrono::seconds(5));
+
+  // The descriptor is left in blocking mode.
+  ASIO_CHECK((::fcntl(fds[1], F_GETFL, 0) & O_NONBLOCK) == 0);
+
+  // The data that was written can be read, and then a read times out.
+  std::vector<char> received(data.size());
+  std::size_t read_total = 0;
+  while (read_total < total)
+  {
+    read_total += reader.read_some_for(buffer(received),
+        chrono::seconds(5), ec);
+    if (ec)
+      break;
+  }
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(read_total == total);
+  std::size_t n = reader.read_some_for(buffer(received),
+      chrono::milliseconds(10), ec);
+  ASIO_CHECK(ec == asio::error::timed_out);
+  ASIO_CHECK(n == 0);
+  ASIO_CHECK((::fcntl(fds[0], F_GETFL, 0) & O_NONBLOCK) == 0);
+#endif // defined(ASIO_HAS_SERIAL_PORT) && defined(ASIO_HAS_CHRONO)
+       //   && !defined(ASIO_WINDOWS)
+}
+
+} // namespace serial_port_timeout_runtime
+
+//------------------------------------------------------------------------------
+
 ASIO_TEST_SUITE
 (
   "serial_port",
   ASIO_TEST_CASE(serial_port_compile::test)
+  ASIO_TEST_CASE(serial_port_timeout_runtime::test)
 )
@@ -0,0 +1,279 @@
+//
+// stream_file.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/stream_file.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "asio/io_context.hpp"
+#include "asio/read.hpp"
+#include "asio/write.hpp"
+#include "archetypes/async_result.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+//------------------------------------------------------------------------------
+
+// stream_file_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// stream_file compile and link correctly. Runtime failures are ignored.
+
+namespace stream_file_compile {
+
+void write_some_handler(const asio::error_code&, std::size_t)
+{
+}
+
+void read_some_handler(const asio::error_code&, std::size_t)
+{
+}
+
+void test()
+{
+#if defined(ASIO_HAS_FILE)
+  using namespace asio;
+
+  try
+  {
+    io_context ioc;
+    const io_context::executor_type ioc_ex = ioc.get_executor();
+    char mutable_char_buffer[128] = "";
+    const char const_char_buffer[128] = "";
+    archetypes::lazy_handler lazy;
+    asio::error_code ec;
+
+    // basic_stream_file constructors.
+
+    stream_file file1(ioc);
+    stream_file file2(ioc, "", stream_file::read_only);
+    stream_file::native_handle_type native_file1 = -1;
+    stream_file file3(ioc, native_file1);
+
+    stream_file file4(ioc_ex);
+    stream_file file5(ioc_ex, "", stream_file::read_only);
+    stream_file::native_handle_type native_file2 = -1;
+    stream_file file6(ioc_ex, native_file2);
+
+#if defined(ASIO_HAS_MOVE)
+    stream_file file7(std::move(file4));
+#endif // defined(ASIO_HAS_MOVE)
+
+    // basic_stream_file operators.
+
+#if defined(ASIO_HAS_MOVE)
+    file1 = stream_file(ioc);
+    file1 = std::move(file4);
+#endif // defined(ASIO_HAS_MOVE)
+
+    // basic_file functions.
+
+    stream_file::executor_type ex = file1.get_executor();
+    (void)ex;
+
+    file1.open("", stream_file::read_only);
+    file1.open("", stream_file::read_only, ec);
+
+    stream_file::native_handle_type native_file3 = -1;
+    file1.assign(native_file3);
+    stream_file::native_handle_type native_file4 = -1;
+    file1.assign(native_file4, ec);
+
+    bool is_open = file1.is_open();
+    (void)is_open;
+
+    file1.close();
+    file1.close(ec);
+
+    stream_file::native_handle_type native_file5 = file1.native_handle();
+    (void)native_file5;
+
+    file1.cancel();
+    file1.cancel(ec);
+
+    asio::uint64_t s1 = file1.size();
+    (void)s1;
+
+    file1.resize(asio::uint64_t(0));
+    file1.resize(asio::uint64_t(0), ec);
+
+    file1.sync_all();
+    file1.sync_data(ec);
+
+    // basic_stream_file functions.
+
+    asio::uint64_t s2 = file1.seek(0, stream_file::seek_set);
+    (void)s2;
+    asio::uint64_t s3 = file1.seek(0, stream_file::seek_cur, ec);
+    (void)s3;
+
+    file1.write_some(buffer(mutable_char_buffer));
+    file1.write_some(buffer(const_char_buffer));
+    file1.write_some(buffer(mutable_char_buffer), ec);
+    file1.write_some(buffer(const_char_buffer), ec);
+
+    file1.async_write_some(buffer(mutable_char_buffer), &write_some_handler);
+    file1.async_write_some(buffer(const_char_buffer), &write_some_handler);
+    int i1 = file1.async_write_some(buffer(mutable_char_buffer), lazy);
+    (void)i1;
+    int i2 = file1.async_write_some(buffer(const_char_buffer), lazy);
+    (void)i2;
+
+    file1.read_some(buffer(mutable_char_buffer));
+    file1.read_some(buffer(mutable_char_buffer), ec);
+
+    file1.async_read_some(buffer(mutable_char_buffer), &read_some_handler);
+    int i3 = file1.async_read_some(buffer(mutable_char_buffer), lazy);
+    (void)i3;
+  }
+  catch (std::exception&)
+  {
+  }
+#endif // defined(ASIO_HAS_FILE)
+}
+
+} // namespace stream_file_compile
+
+//------------------------------------------------------------------------------
+
+// stream_file_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the stream_file class.
+
+namespace stream_file_runtime {
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+using std::placeholders::_1;
+using std::placeholders::_2;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+void io_handler(const asio::error_code& e, std::size_t n,
+    asio::error_code* out_ec, std::size_t* out_n, bool* called)
+{
+  *out_ec = e;
+  *out_n = n;
+  *called = true;
+}
+
+void test()
+{
+#if defined(ASIO_HAS_FILE)
+  using namespace asio;
+
+  char path[] = "/tmp/asio_stream_file_XXXXXX";
+  int fd = ::mkstemp(path);
+  ASIO_CHECK(fd != -1);
+  if (fd == -1)
+    return;
+  ::close(fd);
+
+  io_context ioc;
+  stream_file file(ioc, path,
+      stream_file::read_write | stream_file::truncate);
+  ASIO_CHECK(file.is_open());
+
+  std::vector<char> data(300000);
+  for (std::size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i % 251);
+
+  asio::error_code ec;
+  std::size_t length = 0;
+  bool called = false;
+  asio::async_write(file, asio::buffer(data),
+      bindns::bind(io_handler, _1, _2, &ec, &length, &called));
+
+  // The handler must not be invoked from within the initiating function.
+  ASIO_CHECK(!called);
+
+  ioc.run();
+
+  ASIO_CHECK(called);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(length == data.size());
+  ASIO_CHECK(file.size() == data.size());
+  ASIO_CHECK(file.seek(0, stream_file::seek_cur) == data.size());
+
+  // Read the whole file back sequentially.
+  ASIO_CHECK(file.seek(0, stream_file::seek_set) == 0);
+  std::vector<char> received(data.size() + 100);
+  called = false;
+  asio::async_read(file, asio::buffer(received),
+      bindns::bind(io_handler, _1, _2, &ec, &length, &called));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(called);
+  ASIO_CHECK(ec == asio::error::eof);
+  ASIO_CHECK(length == data.size());
+  ASIO_CHECK(std::memcmp(&data[0], &received[0], data.size()) == 0);
+
+  // Seek relative to the end and read the tail synchronously.
+  ASIO_CHECK(file.seek(-10, stream_file::seek_end) == data.size() - 10);
+  char tail[10];
+  ASIO_CHECK(asio::read(file, asio::buffer(tail)) == 10);
+  ASIO_CHECK(std::memcmp(tail, &data[data.size() - 10], 10) == 0);
+
+  // Writes that are started together are performed in order.
+  file.resize(0);
+  ASIO_CHECK(file.seek(0, stream_file::seek_set) == 0);
+  const std::size_t block_count = 64;
+  const std::size_t block_size = 4096;
+  std::size_t completed = 0;
+  for (std::size_t i = 0; i < block_count; ++i)
+  {
+    file.async_write_some(
+        asio::buffer(&data[i * block_size], block_size),
+        bindns::bind(io_handler, _1, _2, &ec, &length, &called));
+  }
+
+  ioc.restart();
+  completed = ioc.run();
+
+  ASIO_CHECK(completed == block_count);
+  ASIO_CHECK(file.size() == block_count * block_size);
+  ASIO_CHECK(file.seek(0, stream_file::seek_set) == 0);
+  ASIO_CHECK(asio::read(file, asio::buffer(received),
+        asio::transfer_exactly(block_count * block_size), ec)
+      == block_count * block_size);
+  ASIO_CHECK(std::memcmp(&data[0], &received[0],
+        block_count * block_size) == 0);
+
+  file.close();
+  ASIO_CHECK(!file.is_open());
+  ::unlink(path);
+#endif // defined(ASIO_HAS_FILE)
+}
+
+} // namespace stream_file_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "stream_file",
+  ASIO_TEST_CASE(stream_file_compile::test)
+  ASIO_TEST_CASE(stream_file_runtime::test)
+)
@@ -350,6 +350,119 @@ void system_timer_thread_test()
   ASIO_CHECK(count == 1);
 }
 
+void record_completion_time(asio::system_timer::time_point* t)
+{
+  *t = now();
+}
+
+void record_completion_order(int* next, int* position)
+{
+  *position = (*next)++;
+}
+
+void system_timer_slack_test()
+{
+  using asio::chrono::milliseconds;
+
+  asio::io_context ioc;
+  asio::system_timer t1(ioc);
+  asio::system_timer t2(ioc);
+
+  ASIO_CHECK(t1.slack() == asio::system_timer::duration());
+
+  t1.slack(milliseconds(100));
+  t2.slack(milliseconds(100));
+  ASIO_CHECK(t1.slack() == milliseconds(100));
+
+  // Both timers expire within the same 100ms bucket.
+  asio::system_timer::time_point start = now();
+  asio::system_timer::time_point bucket_start = start
+    - start.time_since_epoch() % milliseconds(100) + milliseconds(200);
+  t1.expires_at(bucket_start + milliseconds(10));
+  t2.expires_at(bucket_start + milliseconds(60));
+
+  asio::system_timer::time_point t1_completed;
+  asio::system_timer::time_point t2_completed;
+  t1.async_wait(bindns::bind(record_completion_time, &t1_completed));
+  t2.async_wait(bindns::bind(record_completion_time, &t2_completed));
+
+  ioc.run();
+
+  // The slack does not change the reported expiry time.
+  ASIO_CHECK(t1.expiry() == bucket_start + milliseconds(10));
+  ASIO_CHECK(t2.expiry() == bucket_start + milliseconds(60));
+
+  // Both waits were delayed to the end of the bucket.
+  ASIO_CHECK(t1_completed >= bucket_start + milliseconds(100));
+  ASIO_CHECK(t2_completed >= bucket_start + milliseconds(100));
+
+  // A timer already on a bucket boundary is not delayed further, and so
+  // completes before a timer without slack that expires later in the bucket.
+  t2.slack(asio::system_timer::duration());
+  t1.expires_at(bucket_start + milliseconds(300));
+  t2.expires_at(bucket_start + milliseconds(350));
+  int next = 0;
+  int t1_position = -1;
+  int t2_position = -1;
+  t1.async_wait(bindns::bind(record_completion_time, &t1_completed));
+  t1.async_wait(bindns::bind(record_completion_order, &next, &t1_position));
+  t2.async_wait(bindns::bind(record_completion_order, &next, &t2_position));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(t1_completed >= bucket_start + milliseconds(300));
+  ASIO_CHECK(t1_position == 0);
+  ASIO_CHECK(t2_position == 1);
+}
+
+void system_timer_reschedule_test()
+{
+  using asio::chrono::milliseconds;
+#if !defined(ASIO_HAS_BOOST_BIND)
+  using std::placeholders::_1;
+#endif // !defined(ASIO_HAS_BOOST_BIND)
+
+  asio::io_context ioc;
+  asio::system_timer t1(ioc);
+  asio::system_timer t2(ioc);
+  int count1 = 0;
+  int count2 = 0;
+
+  // Rescheduling a timer with no pending waits only changes its expiry.
+  asio::system_timer::time_point start = now();
+  ASIO_CHECK(t1.reschedule_at(start + milliseconds(100)) == 0);
+  ASIO_CHECK(t1.expiry() == start + milliseconds(100));
+
+  // Pending waits are moved to a later time without being cancelled.
+  t1.async_wait(bindns::bind(increment_if_not_cancelled, &count1, _1));
+  ASIO_CHECK(t1.reschedule_at(start + milliseconds(300)) == 1);
+  ASIO_CHECK(t1.expiry() == start + milliseconds(300));
+  t2.expires_at(start + milliseconds(200));
+  t2.async_wait(bindns::bind(increment_if_not_cancelled, &count2, _1));
+
+  ioc.run_one();
+  ASIO_CHECK(count1 == 0);
+  ASIO_CHECK(count2 == 1);
+
+  ioc.run();
+  ASIO_CHECK(count1 == 1);
+  ASIO_CHECK(now() >= start + milliseconds(300));
+
+  // Once the wait has completed there is nothing left to reschedule.
+  ASIO_CHECK(t1.reschedule_after(milliseconds(100)) == 0);
+
+  // Pending waits may also be moved to an earlier time.
+  t1.expires_at((asio::system_timer::time_point::max)());
+  t1.async_wait(bindns::bind(increment_if_not_cancelled, &count1, _1));
+  t1.async_wait(bindns::bind(increment_if_not_cancelled, &count1, _1));
+  ASIO_CHECK(t1.reschedule_after(milliseconds(0)) == 2);
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(count1 == 3);
+}
+
 #if defined(ASIO_HAS_MOVE)
 asio::system_timer make_timer(asio::io_context& ioc, int* count)
 {
@@ -390,6 +503,8 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(system_timer_cancel_test)
   ASIO_TEST_CASE(system_timer_custom_allocation_test)
   ASIO_TEST_CASE(system_timer_thread_test)
+  ASIO_TEST_CASE(system_timer_slack_test)
+  ASIO_TEST_CASE(system_timer_reschedule_test)
   ASIO_TEST_CASE(system_timer_move_test)
 )
 #else // defined(ASIO_HAS_STD_CHRONO)
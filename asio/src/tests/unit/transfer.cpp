@@ -0,0 +1,320 @@
+//
+// transfer.cpp
+// ~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/transfer.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "asio/io_context.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/stream_protocol.hpp"
+#include "asio/read.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+#if !defined(ASIO_WINDOWS)
+# include <unistd.h>
+#endif // !defined(ASIO_WINDOWS)
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+using std::placeholders::_1;
+using std::placeholders::_2;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+
+typedef asio::local::stream_protocol::socket socket_type;
+
+// Wraps a socket so that the transfer cannot use the native descriptor, and
+// must fall back to copying the data through a buffer.
+class wrapped_stream
+{
+public:
+  typedef socket_type::executor_type executor_type;
+
+  explicit wrapped_stream(socket_type& s)
+    : socket_(s)
+  {
+  }
+
+  executor_type get_executor() ASIO_NOEXCEPT
+  {
+    return socket_.get_executor();
+  }
+
+  template <typename MutableBufferSequence, typename Handler>
+  void async_read_some(const MutableBufferSequence& buffers,
+      ASIO_MOVE_ARG(Handler) handler)
+  {
+    socket_.async_read_some(buffers, ASIO_MOVE_CAST(Handler)(handler));
+  }
+
+  template <typename ConstBufferSequence, typename Handler>
+  void async_write_some(const ConstBufferSequence& buffers,
+      ASIO_MOVE_ARG(Handler) handler)
+  {
+    socket_.async_write_some(buffers, ASIO_MOVE_CAST(Handler)(handler));
+  }
+
+private:
+  socket_type& socket_;
+};
+
+void shutdown_handler(const asio::error_code&, std::size_t,
+    socket_type* s)
+{
+  asio::error_code ignored_ec;
+  s->shutdown(socket_type::shutdown_send, ignored_ec);
+}
+
+void transfer_handler(const asio::error_code& e, std::size_t n,
+    asio::error_code* out_ec, std::size_t* out_n,
+    socket_type* from, socket_type* to)
+{
+  *out_ec = e;
+  *out_n = n;
+  asio::error_code ignored_ec;
+  if (from)
+    from->close(ignored_ec);
+  to->shutdown(socket_type::shutdown_send, ignored_ec);
+}
+
+void read_handler(const asio::error_code& e, std::size_t n,
+    asio::error_code* out_ec, std::size_t* out_n)
+{
+  *out_ec = e;
+  *out_n = n;
+}
+
+std::vector<char> make_data(std::size_t size)
+{
+  std::vector<char> data(size);
+  for (std::size_t i = 0; i < size; ++i)
+    data[i] = static_cast<char>(i % 251);
+  return data;
+}
+
+template <typename Source, typename Destination>
+void run_transfer(std::size_t size, std::size_t max_size, bool all)
+{
+  asio::io_context ioc;
+  socket_type a1(ioc), a2(ioc), b1(ioc), b2(ioc);
+  asio::local::connect_pair(a1, a2);
+  asio::local::connect_pair(b1, b2);
+
+  std::vector<char> data = make_data(size);
+  std::vector<char> received(size + 1);
+
+  // Closing the source when the transfer completes makes this write fail if
+  // the transfer stops early.
+  asio::async_write(a1, asio::buffer(data),
+      bindns::bind(shutdown_handler, _1, _2, &a1));
+
+  Source from(a2);
+  Destination to(b1);
+  asio::error_code transfer_ec;
+  std::size_t transferred = 0;
+  if (all)
+  {
+    asio::async_transfer(from, to,
+        bindns::bind(transfer_handler, _1, _2,
+          &transfer_ec, &transferred, &a2, &b1));
+  }
+  else
+  {
+    asio::async_transfer(from, to, max_size,
+        bindns::bind(transfer_handler, _1, _2,
+          &transfer_ec, &transferred, &a2, &b1));
+  }
+
+  asio::error_code read_ec;
+  std::size_t read_length = 0;
+  asio::async_read(b2, asio::buffer(received),
+      bindns::bind(read_handler, _1, _2, &read_ec, &read_length));
+
+  // Neither handler may be invoked from within the initiating functions.
+  ASIO_CHECK(transferred == 0);
+  ASIO_CHECK(read_length == 0);
+
+  ioc.run();
+
+  std::size_t expected = all ? size : max_size;
+  if (all)
+    ASIO_CHECK(transfer_ec == asio::error::eof);
+  else
+    ASIO_CHECK(!transfer_ec);
+  ASIO_CHECK(transferred == expected);
+  ASIO_CHECK(read_ec == asio::error::eof);
+  ASIO_CHECK(read_length == expected);
+  ASIO_CHECK(expected == 0
+      || std::memcmp(&data[0], &received[0], expected) == 0);
+}
+
+template <typename Destination>
+void run_sendfile(std::size_t size, std::size_t offset, std::size_t length)
+{
+  char name[] = "/tmp/asio_transfer_XXXXXX";
+  int fd = ::mkstemp(name);
+  ASIO_CHECK(fd != -1);
+  if (fd == -1)
+    return;
+  ::unlink(name);
+
+  std::vector<char> data = make_data(size);
+  ASIO_CHECK(::write(fd, &data[0], size) == static_cast<ssize_t>(size));
+
+  asio::io_context ioc;
+  socket_type b1(ioc), b2(ioc);
+  asio::local::connect_pair(b1, b2);
+
+  std::vector<char> received(length + 1);
+
+  Destination to(b1);
+  asio::error_code transfer_ec;
+  std::size_t transferred = 0;
+  asio::async_sendfile(to, fd, offset, length,
+      bindns::bind(transfer_handler, _1, _2,
+        &transfer_ec, &transferred,
+        static_cast<socket_type*>(0), &b1));
+
+  asio::error_code read_ec;
+  std::size_t read_length = 0;
+  asio::async_read(b2, asio::buffer(received),
+      bindns::bind(read_handler, _1, _2, &read_ec, &read_length));
+
+  ASIO_CHECK(transferred == 0);
+
+  ioc.run();
+
+  std::size_t expected = offset + length > size ? size - offset : length;
+  if (expected < length)
+    ASIO_CHECK(transfer_ec == asio::error::eof);
+  else
+    ASIO_CHECK(!transfer_ec);
+  ASIO_CHECK(transferred == expected);
+  ASIO_CHECK(read_length == expected);
+  ASIO_CHECK(std::memcmp(&data[offset], &received[0], expected) == 0);
+
+  // The file offset must not have been changed.
+  ASIO_CHECK(::lseek(fd, 0, SEEK_CUR) == static_cast<off_t>(size));
+
+  ::close(fd);
+}
+
+void run_mode_restore()
+{
+  char name[] = "/tmp/asio_transfer_XXXXXX";
+  int fd = ::mkstemp(name);
+  ASIO_CHECK(fd != -1);
+  if (fd == -1)
+    return;
+  ::unlink(name);
+
+  std::vector<char> data = make_data(1000);
+  ASIO_CHECK(::write(fd, &data[0], data.size()) == 1000);
+
+  asio::io_context ioc;
+  socket_type a1(ioc), a2(ioc), b1(ioc), b2(ioc);
+  asio::local::connect_pair(a1, a2);
+  asio::local::connect_pair(b1, b2);
+  asio::write(a1, asio::buffer(data));
+
+  // The destination was put into non-blocking mode by the caller, and must
+  // stay that way. The source must be returned to blocking mode.
+  b1.native_non_blocking(true);
+
+  asio::error_code ec;
+  std::size_t length = 0;
+  asio::async_transfer(a2, b1, data.size(),
+      bindns::bind(read_handler, _1, _2, &ec, &length));
+  ioc.run();
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(length == data.size());
+  ASIO_CHECK(!a2.native_non_blocking());
+  ASIO_CHECK(b1.native_non_blocking());
+
+  b1.native_non_blocking(false);
+  ioc.restart();
+  asio::async_sendfile(b1, fd, 0, data.size(),
+      bindns::bind(read_handler, _1, _2, &ec, &length));
+  ioc.run();
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(length == data.size());
+  ASIO_CHECK(!b1.native_non_blocking());
+
+  ::close(fd);
+}
+
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+
+void test_native_transfer()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  // Transfers large enough to need several passes through the pipe.
+  run_transfer<socket_type&, socket_type&>(1024 * 1024, 0, true);
+  run_transfer<socket_type&, socket_type&>(1024 * 1024, 100000, false);
+  run_transfer<socket_type&, socket_type&>(0, 0, true);
+  run_mode_restore();
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
+void test_buffered_transfer()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  run_transfer<wrapped_stream, wrapped_stream>(1024 * 1024, 0, true);
+  run_transfer<wrapped_stream, socket_type&>(1024 * 1024, 100000, false);
+  run_transfer<socket_type&, wrapped_stream>(0, 0, true);
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
+void test_native_sendfile()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  run_sendfile<socket_type&>(1024 * 1024, 0, 1024 * 1024);
+  run_sendfile<socket_type&>(1024 * 1024, 1000, 50000);
+  run_sendfile<socket_type&>(1024 * 1024, 1000, 2 * 1024 * 1024);
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
+void test_buffered_sendfile()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  run_sendfile<wrapped_stream>(1024 * 1024, 0, 1024 * 1024);
+  run_sendfile<wrapped_stream>(1024 * 1024, 1000, 50000);
+  run_sendfile<wrapped_stream>(1024 * 1024, 1000, 2 * 1024 * 1024);
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
+ASIO_TEST_SUITE
+(
+  "transfer",
+  ASIO_TEST_CASE(test_native_transfer)
+  ASIO_TEST_CASE(test_buffered_transfer)
+  ASIO_TEST_CASE(test_native_sendfile)
+  ASIO_TEST_CASE(test_buffered_sendfile)
+)
@@ -0,0 +1,210 @@
+//
+// with_timeout.cpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/with_timeout.hpp"
+
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/read.hpp"
+#include "asio/steady_timer.hpp"
+#include "asio/use_future.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+using std::placeholders::_1;
+using std::placeholders::_2;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+#if defined(ASIO_HAS_CHRONO)
+
+void io_handler(const asio::error_code& e, std::size_t n,
+    asio::error_code* result, std::size_t* bytes, int* count)
+{
+  *result = e;
+  *bytes = n;
+  ++*count;
+}
+
+void wait_handler(const asio::error_code& e,
+    asio::error_code* result, int* count)
+{
+  *result = e;
+  ++*count;
+}
+
+struct connected_sockets
+{
+  connected_sockets(asio::io_context& ioc)
+    : client(ioc),
+      server(ioc)
+  {
+    using asio::ip::tcp;
+    tcp::acceptor acceptor(ioc, tcp::endpoint(tcp::v4(), 0));
+    tcp::endpoint server_endpoint = acceptor.local_endpoint();
+    server_endpoint.address(asio::ip::address_v4::loopback());
+    client.connect(server_endpoint);
+    acceptor.accept(server);
+  }
+
+  asio::ip::tcp::socket client;
+  asio::ip::tcp::socket server;
+};
+
+void test_timeout()
+{
+  asio::io_context ioc;
+  connected_sockets s(ioc);
+
+  char read_data[16];
+  const char write_data[] = "data";
+  asio::error_code read_result, write_result;
+  std::size_t read_bytes = 1, write_bytes = 0;
+  int read_count = 0, write_count = 0;
+
+  s.client.async_read_some(asio::buffer(read_data),
+      asio::with_timeout(
+        bindns::bind(io_handler, _1, _2,
+          &read_result, &read_bytes, &read_count),
+        asio::chrono::milliseconds(50)));
+  s.client.async_write_some(asio::buffer(write_data),
+      bindns::bind(io_handler, _1, _2,
+        &write_result, &write_bytes, &write_count));
+
+  ioc.run();
+  ASIO_CHECK(read_count == 1);
+  ASIO_CHECK(read_result == asio::error::timed_out);
+  ASIO_CHECK(read_bytes == 0);
+  ASIO_CHECK(write_count == 1);
+  ASIO_CHECK(!write_result);
+  ASIO_CHECK(s.client.is_open());
+
+  // The socket remains usable after the timeout.
+  s.client.async_read_some(asio::buffer(read_data),
+      asio::with_timeout(
+        bindns::bind(io_handler, _1, _2,
+          &read_result, &read_bytes, &read_count),
+        asio::chrono::seconds(30)));
+  asio::write(s.server, asio::buffer(write_data));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(read_count == 2);
+  ASIO_CHECK(!read_result);
+  ASIO_CHECK(read_bytes > 0);
+}
+
+void test_composed()
+{
+  asio::io_context ioc;
+  connected_sockets s(ioc);
+
+  char read_data[8];
+  const char write_data[] = "data";
+  asio::error_code result;
+  std::size_t bytes = 0;
+  int count = 0;
+
+  // The composed operation completes with the bytes read before the timeout.
+  asio::write(s.server, asio::buffer(write_data, 4));
+  asio::async_read(s.client, asio::buffer(read_data),
+      asio::with_timeout(
+        bindns::bind(io_handler, _1, _2, &result, &bytes, &count),
+        asio::chrono::milliseconds(50)));
+
+  ioc.run();
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(result == asio::error::timed_out);
+  ASIO_CHECK(bytes == 4);
+
+  // An operation that completes before the timeout is unaffected.
+  asio::write(s.server, asio::buffer(write_data, 4));
+  asio::async_read(s.client, asio::buffer(read_data, 4),
+      asio::with_timeout(
+        bindns::bind(io_handler, _1, _2, &result, &bytes, &count),
+        asio::chrono::seconds(30)));
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(count == 2);
+  ASIO_CHECK(!result);
+  ASIO_CHECK(bytes == 4);
+}
+
+void test_timer()
+{
+  asio::io_context ioc;
+  asio::steady_timer t(ioc, asio::chrono::hours(1));
+  asio::error_code result;
+  int count = 0;
+
+  t.async_wait(asio::with_timeout(
+        bindns::bind(wait_handler, _1, &result, &count),
+        asio::chrono::milliseconds(10)));
+
+  ioc.run();
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(result == asio::error::timed_out);
+}
+
+void test_use_future()
+{
+#if defined(ASIO_HAS_STD_FUTURE)
+  asio::io_context ioc;
+  connected_sockets s(ioc);
+
+  char read_data[16];
+  std::future<std::size_t> f = s.client.async_read_some(
+      asio::buffer(read_data),
+      asio::with_timeout(asio::use_future, asio::chrono::milliseconds(10)));
+
+  ioc.run();
+  try
+  {
+    f.get();
+    ASIO_CHECK(false);
+  }
+  catch (asio::system_error& e)
+  {
+    ASIO_CHECK(e.code() == asio::error::timed_out);
+  }
+#endif // defined(ASIO_HAS_STD_FUTURE)
+}
+
+#endif // defined(ASIO_HAS_CHRONO)
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "with_timeout",
+#if defined(ASIO_HAS_CHRONO)
+  ASIO_TEST_CASE(test_timeout)
+  ASIO_TEST_CASE(test_composed)
+  ASIO_TEST_CASE(test_timer)
+  ASIO_TEST_CASE(test_use_future)
+#else // defined(ASIO_HAS_CHRONO)
+  ASIO_TEST_CASE(null_test)
+#endif // defined(ASIO_HAS_CHRONO)
+)
@@ -603,6 +603,34 @@ void test_3_arg_const_buffer_write()
   ASIO_CHECK(s.check_buffers(buffers, sizeof(write_data)));
 }
 
+void test_3_arg_adaptive_const_buffer_write()
+{
+  asio::io_context ioc;
+  test_stream s(ioc);
+  asio::const_buffer buffers
+    = asio::buffer(write_data, sizeof(write_data));
+
+  s.reset();
+  size_t bytes_transferred = asio::write(s, buffers,
+      asio::transfer_adaptive(1));
+  ASIO_CHECK(bytes_transferred == sizeof(write_data));
+  ASIO_CHECK(s.check_buffers(buffers, sizeof(write_data)));
+
+  s.reset();
+  s.next_write_length(1);
+  bytes_transferred = asio::write(s, buffers,
+      asio::transfer_adaptive(10));
+  ASIO_CHECK(bytes_transferred == sizeof(write_data));
+  ASIO_CHECK(s.check_buffers(buffers, sizeof(write_data)));
+
+  s.reset();
+  s.next_write_length(10);
+  bytes_transferred = asio::write(s, buffers,
+      asio::transfer_adaptive(1, 4));
+  ASIO_CHECK(bytes_transferred == sizeof(write_data));
+  ASIO_CHECK(s.check_buffers(buffers, sizeof(write_data)));
+}
+
 void test_3_arg_mutable_buffer_write()
 {
   asio::io_context ioc;
@@ -4880,6 +4908,7 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(test_3_arg_nothrow_vector_buffers_write)
   ASIO_TEST_CASE(test_3_arg_nothrow_dynamic_string_write)
   ASIO_TEST_CASE(test_3_arg_const_buffer_write)
+  ASIO_TEST_CASE(test_3_arg_adaptive_const_buffer_write)
   ASIO_TEST_CASE(test_3_arg_mutable_buffer_write)
   ASIO_TEST_CASE(test_3_arg_vector_buffers_write)
   ASIO_TEST_CASE(test_3_arg_dynamic_string_write)